@@ -0,0 +1,182 @@
+/**
+ * Benchmark variasi siklus loop pemberi data FIFO PIO.
+ *
+ * Loop yang sama dijalankan dua kali: satu versi berjalan dari flash (XIP)
+ * dan satu versi ditandai __not_in_flash_func. Sebelum setiap putaran, cache
+ * XIP di-flush agar cache miss terlihat. Target ini di-build dua kali oleh
+ * CMake: sebagai binary default dan sebagai binary copy_to_ram.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+#include "hardware/clocks.h"
+#include "hardware/structs/systick.h"
+#include "hardware/structs/xip_ctrl.h"
+#include "signal_generator.pio.h"
+
+// -- Konfigurasi Benchmark --
+const uint PIN_CH1_BASE = 6;
+const float PIO_CLK_DIV = 1.0f;
+const uint32_t EVENT_DELAY = 60;   // Siklus PIO per event (di luar overhead)
+#define ITERATIONS 2000u           // Jumlah periode yang diukur per putaran
+
+static uint32_t samples[ITERATIONS];
+
+typedef struct
+{
+    double mean;
+    double stddev;
+    uint32_t min;
+    uint32_t max;
+    uint32_t tx_stalls;
+} bench_result;
+
+// Perbandingan flash/SRAM hanya bermakna jika cache benar-benar dikosongkan;
+// register FLUSH di bawah khusus RP2040 (RP2350 memakai operasi maintenance)
+#if !PICO_RP2040
+#error "feed_loop_bench: flush cache XIP hanya diimplementasikan untuk RP2040"
+#endif
+
+/**
+ * @brief Mengosongkan cache XIP agar putaran berikutnya mulai dari kondisi cache miss.
+ */
+static void flush_xip_cache(void)
+{
+    xip_ctrl_hw->flush = 1;
+    (void)xip_ctrl_hw->flush; // Tunggu flush selesai
+}
+
+/**
+ * @brief Loop pemberi data yang berjalan dari flash (XIP).
+ *
+ * Pada build copy_to_ram fungsi ini ikut disalin ke SRAM, sehingga kedua
+ * putaran seharusnya menghasilkan variasi yang sama.
+ */
+static void __attribute__((noinline)) feed_loop_flash(PIO pio, uint sm, uint32_t delay)
+{
+    uint32_t last = systick_hw->cvr;
+    for (uint i = 0; i < ITERATIONS; ++i)
+    {
+        pio_sm_put_blocking(pio, sm, delay);
+        pio_sm_put_blocking(pio, sm, delay);
+        pio_sm_put_blocking(pio, sm, delay);
+        pio_sm_put_blocking(pio, sm, delay);
+        uint32_t now = systick_hw->cvr;
+        samples[i] = (last - now) & 0x00ffffffu; // SysTick menghitung mundur
+        last = now;
+    }
+}
+
+/**
+ * @brief Loop pemberi data yang sama, ditempatkan di SRAM.
+ */
+static void __no_inline_not_in_flash_func(feed_loop_ram)(PIO pio, uint sm, uint32_t delay)
+{
+    uint32_t last = systick_hw->cvr;
+    for (uint i = 0; i < ITERATIONS; ++i)
+    {
+        pio_sm_put_blocking(pio, sm, delay);
+        pio_sm_put_blocking(pio, sm, delay);
+        pio_sm_put_blocking(pio, sm, delay);
+        pio_sm_put_blocking(pio, sm, delay);
+        uint32_t now = systick_hw->cvr;
+        samples[i] = (last - now) & 0x00ffffffu;
+        last = now;
+    }
+}
+
+/**
+ * @brief Menjalankan satu putaran benchmark dan menghitung statistik siklus per periode.
+ *
+ * @param pio Instance PIO yang digunakan
+ * @param sm Nomor state machine
+ * @param offset Offset program PIO
+ * @param loop Fungsi loop yang diukur
+ * @return Statistik hasil pengukuran
+ */
+static bench_result run_bench(PIO pio, uint sm, uint offset,
+                              void (*loop)(PIO, uint, uint32_t))
+{
+    bench_result r = {0};
+
+    pio_sm_set_enabled(pio, sm, false);
+    pio_sm_clear_fifos(pio, sm);
+    pio_sm_restart(pio, sm);
+    pio_sm_exec(pio, sm, pio_encode_jmp(offset));
+    pio->fdebug = 1u << (PIO_FDEBUG_TXSTALL_LSB + sm);
+
+    flush_xip_cache();
+    pio_sm_set_enabled(pio, sm, true);
+    loop(pio, sm, EVENT_DELAY);
+    pio_sm_set_enabled(pio, sm, false);
+
+    // Sampel pertama mengandung waktu start, abaikan
+    double sum = 0, sum_sq = 0;
+    r.min = UINT32_MAX;
+    for (uint i = 1; i < ITERATIONS; ++i)
+    {
+        uint32_t s = samples[i];
+        sum += s;
+        sum_sq += (double)s * s;
+        if (s < r.min)
+            r.min = s;
+        if (s > r.max)
+            r.max = s;
+    }
+    uint n = ITERATIONS - 1;
+    r.mean = sum / n;
+    r.stddev = sqrt(sum_sq / n - r.mean * r.mean);
+    r.tx_stalls = (pio->fdebug >> (PIO_FDEBUG_TXSTALL_LSB + sm)) & 1u;
+    return r;
+}
+
+static void print_result(const char *name, bench_result r)
+{
+    printf("%-6s mean=%.2f stddev=%.3f min=%lu max=%lu (siklus sys/periode) txstall=%lu\n",
+           name, r.mean, r.stddev, (unsigned long)r.min, (unsigned long)r.max,
+           (unsigned long)r.tx_stalls);
+}
+
+int main()
+{
+    stdio_init_all();
+    sleep_ms(2000); // Beri waktu enumerasi USB
+
+    PIO pio = pio0;
+    uint offset = pio_add_program(pio, &signal_generator_program);
+    uint sm = pio_claim_unused_sm(pio, true);
+    pio_sm_config c = signal_generator_program_get_default_config(offset);
+    sm_config_set_set_pins(&c, PIN_CH1_BASE, 4);
+    for (uint i = 0; i < 4; ++i)
+    {
+        pio_gpio_init(pio, PIN_CH1_BASE + i);
+    }
+    pio_sm_set_consecutive_pindirs(pio, sm, PIN_CH1_BASE, 4, true);
+    sm_config_set_clkdiv(&c, PIO_CLK_DIV);
+    pio_sm_init(pio, sm, offset, &c);
+
+    // SysTick sebagai penghitung siklus clk_sys (24-bit, hitung mundur)
+    systick_hw->rvr = 0x00ffffffu;
+    systick_hw->cvr = 0;
+    systick_hw->csr = 0x5; // Enable, sumber clock = prosesor
+
+#if PICO_COPY_TO_RAM
+    const char *variant = "copy_to_ram";
+#else
+    const char *variant = "default";
+#endif
+    printf("feed_loop_bench (%s), sysclk=%lu Hz, ideal=%lu siklus/periode\n", variant,
+           (unsigned long)clock_get_hz(clk_sys),
+           (unsigned long)((4 * (EVENT_DELAY + 4) + 1) * PIO_CLK_DIV)); // +1: token periode di event D
+
+    while (true)
+    {
+        print_result("flash", run_bench(pio, sm, offset, feed_loop_flash));
+        print_result("sram", run_bench(pio, sm, offset, feed_loop_ram));
+        sleep_ms(1000);
+    }
+}
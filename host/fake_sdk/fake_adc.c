@@ -0,0 +1,335 @@
+/**
+ * Fake Pico SDK: ADC simulasi (hardware_adc).
+ *
+ * Konversi free-running dijadwalkan seperti event eksternal lain di
+ * fake_hw_run_until(): sampel ke-k selesai pada waktu adc_run(true) ditambah
+ * 96 siklus ADC ditambah k kali interval. Tegangan diambil dari sumber host
+ * pada waktu sampel selesai, jadi sinyal yang berubah (ramp, sinus) terbaca
+ * sesuai saat konversinya.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include "fake_hw_internal.h"
+#include "hardware/adc.h"
+#include "hardware/gpio.h"
+
+#define ADC_CLOCK_HZ 48000000u
+#define ADC_CONVERSION_CYCLES 96u
+#define FS_PER_ADC_CYCLE (1000000000000000.0 / ADC_CLOCK_HZ)
+#define ADC_FIFO_DEPTH 4
+#define ADC_VREF 3.3f
+#define TEMP_SENSOR_VOLTS 0.706f // Sensor suhu pada 27 C
+
+adc_hw_t fake_adc_hw;
+
+static struct
+{
+    uint input;
+    uint rrobin_mask;
+    bool temp_sensor;
+    float clkdiv;
+    bool running;
+    uint64_t next_fs; // Selesainya konversi free-running berikutnya
+
+    bool fifo_en;
+    bool dreq_en;
+    uint thresh;
+    bool byte_shift;
+    uint16_t fifo[ADC_FIFO_DEPTH];
+    uint head;
+    uint level;
+} adc;
+
+// Sisi analog yang diatur host; tidak disentuh adc_init()
+static struct
+{
+    fake_hw_adc_source source[NUM_ADC_CHANNELS];
+    void *source_ctx[NUM_ADC_CHANNELS];
+    float volts[NUM_ADC_CHANNELS];
+    uint64_t samples;
+    uint64_t overflows;
+} analog;
+
+static void reset_controller(void)
+{
+    memset(&adc, 0, sizeof(adc));
+    memset(&fake_adc_hw, 0, sizeof(fake_adc_hw));
+    adc.thresh = 1;
+}
+
+// -- Antarmuka ke fake_hw.c --
+
+void fake_adc_reset(void)
+{
+    reset_controller();
+    memset(&analog, 0, sizeof(analog));
+    analog.volts[ADC_TEMPERATURE_CHANNEL_NUM] = TEMP_SENSOR_VOLTS;
+}
+
+static uint64_t interval_fs(void)
+{
+    float cycles = 1.0f + adc.clkdiv;
+    if (cycles < ADC_CONVERSION_CYCLES)
+    {
+        cycles = ADC_CONVERSION_CYCLES;
+    }
+    return (uint64_t)(cycles * FS_PER_ADC_CYCLE + 0.5);
+}
+
+static void update_fcs(void)
+{
+    fake_adc_hw.fcs = (adc.level << 16) | (adc.level == 0 ? 1u << 8 : 0) | (adc.level == ADC_FIFO_DEPTH ? 1u << 9 : 0) |
+                      (fake_adc_hw.fcs & (1u << 11));
+}
+
+/**
+ * @brief Menyelesaikan satu konversi input terpilih pada time_ps.
+ *
+ * @return Kode 12 bit hasil konversi
+ */
+static uint16_t convert(uint64_t time_ps)
+{
+    uint input = adc.input;
+    float v = analog.source[input] ? analog.source[input](analog.source_ctx[input], time_ps) : analog.volts[input];
+    if (input == ADC_TEMPERATURE_CHANNEL_NUM && !adc.temp_sensor)
+    {
+        v = 0.0f;
+    }
+    long code = lroundf(v * 4096.0f / ADC_VREF);
+    uint16_t result = (uint16_t)(code < 0 ? 0 : code > 4095 ? 4095 : code);
+    fake_adc_hw.result = result;
+    analog.samples++;
+
+    if (adc.fifo_en)
+    {
+        if (adc.level == ADC_FIFO_DEPTH)
+        {
+            // FIFO penuh: sampel dibuang, FCS.OVER di-set
+            fake_adc_hw.fcs |= 1u << 11;
+            analog.overflows++;
+        }
+        else
+        {
+            adc.fifo[(adc.head + adc.level) % ADC_FIFO_DEPTH] = adc.byte_shift ? result >> 4 : result;
+            adc.level++;
+        }
+        update_fcs();
+    }
+
+    // Round robin: pindah ke input berikutnya di mask
+    if (adc.rrobin_mask)
+    {
+        for (uint i = 1; i <= NUM_ADC_CHANNELS; ++i)
+        {
+            uint next = (input + i) % NUM_ADC_CHANNELS;
+            if (adc.rrobin_mask & (1u << next))
+            {
+                adc.input = next;
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+uint64_t fake_adc_next_event_ps(void)
+{
+    return adc.running ? adc.next_fs / 1000u : UINT64_MAX;
+}
+
+void fake_adc_service(uint64_t cycle)
+{
+    (void)cycle;
+    while (adc.running && adc.next_fs / 1000u <= fake_hw_now_ps())
+    {
+        convert(adc.next_fs / 1000u);
+        adc.next_fs += interval_fs();
+    }
+}
+
+bool fake_adc_dreq(void)
+{
+    return adc.dreq_en && adc.level >= adc.thresh;
+}
+
+static uint16_t fifo_pop(void)
+{
+    uint16_t value = 0;
+    if (adc.level > 0)
+    {
+        value = adc.fifo[adc.head];
+        adc.head = (adc.head + 1) % ADC_FIFO_DEPTH;
+        adc.level--;
+    }
+    update_fcs();
+    return value;
+}
+
+bool fake_adc_dma_read(const volatile void *addr, uint32_t *value)
+{
+    if (addr != (const volatile void *)&fake_adc_hw.fifo)
+    {
+        return false;
+    }
+    *value = fifo_pop();
+    return true;
+}
+
+// -- SDK --
+
+void adc_init(void)
+{
+    fake_hw_cpu_call();
+    reset_controller();
+    fake_hw_log(FAKE_HW_LOG_REG_WRITE, -1, -1, "ADC_CS", 1u);
+}
+
+void adc_gpio_init(uint gpio)
+{
+    if (gpio < ADC_BASE_PIN || gpio >= ADC_BASE_PIN + NUM_ADC_CHANNELS - 1)
+    {
+        panic("fake_adc: GPIO %u bukan input ADC", gpio);
+    }
+    gpio_set_function(gpio, GPIO_FUNC_NULL);
+    gpio_disable_pulls(gpio);
+}
+
+void adc_select_input(uint input)
+{
+    if (input >= NUM_ADC_CHANNELS)
+    {
+        panic("fake_adc: input %u tidak valid", input);
+    }
+    fake_hw_cpu_call();
+    adc.input = input;
+}
+
+uint adc_get_selected_input(void)
+{
+    return adc.input;
+}
+
+void adc_set_round_robin(uint input_mask)
+{
+    fake_hw_cpu_call();
+    adc.rrobin_mask = input_mask & ((1u << NUM_ADC_CHANNELS) - 1u);
+}
+
+void adc_set_temp_sensor_enabled(bool enable)
+{
+    fake_hw_cpu_call();
+    adc.temp_sensor = enable;
+}
+
+uint16_t adc_read(void)
+{
+    fake_hw_cpu_call();
+    fake_hw_run_until(fake_hw_ps_to_cycle(fake_hw_now_ps() + ADC_CONVERSION_CYCLES * 1000000000000ull / ADC_CLOCK_HZ),
+                      NULL, NULL);
+    return convert(fake_hw_now_ps());
+}
+
+void adc_run(bool run)
+{
+    fake_hw_cpu_call();
+    if (run && !adc.running)
+    {
+        adc.next_fs = fake_hw_now_ps() * 1000u + (uint64_t)(ADC_CONVERSION_CYCLES * FS_PER_ADC_CYCLE + 0.5);
+    }
+    adc.running = run;
+    fake_hw_log(FAKE_HW_LOG_REG_WRITE, -1, -1, "ADC_CS", run ? 1u << 3 | 1u : 1u);
+}
+
+void adc_set_clkdiv(float clkdiv)
+{
+    fake_hw_cpu_call();
+    // DIV fixed point 16.8
+    adc.clkdiv = floorf(clkdiv * 256.0f) / 256.0f;
+    fake_adc_hw.div = (uint32_t)(adc.clkdiv * 256.0f);
+}
+
+void adc_fifo_setup(bool en, bool dreq_en, uint16_t dreq_thresh, bool err_in_fifo, bool byte_shift)
+{
+    (void)err_in_fifo;
+    fake_hw_cpu_call();
+    adc.fifo_en = en;
+    adc.dreq_en = dreq_en;
+    adc.thresh = dreq_thresh > 0 ? dreq_thresh : 1;
+    adc.byte_shift = byte_shift;
+    update_fcs();
+}
+
+bool adc_fifo_is_empty(void)
+{
+    fake_hw_cpu_call();
+    return adc.level == 0;
+}
+
+uint8_t adc_fifo_get_level(void)
+{
+    fake_hw_cpu_call();
+    return (uint8_t)adc.level;
+}
+
+uint16_t adc_fifo_get(void)
+{
+    fake_hw_cpu_call();
+    return fifo_pop();
+}
+
+static bool fifo_not_empty(void *ctx)
+{
+    (void)ctx;
+    return adc.level > 0;
+}
+
+uint16_t adc_fifo_get_blocking(void)
+{
+    fake_hw_cpu_call();
+    if (adc.level == 0)
+    {
+        if (!adc.running)
+        {
+            panic("fake_adc: adc_fifo_get_blocking() tanpa konversi berjalan");
+        }
+        fake_hw_run_until(UINT64_MAX, fifo_not_empty, NULL);
+    }
+    return fifo_pop();
+}
+
+void adc_fifo_drain(void)
+{
+    fake_hw_cpu_call();
+    while (adc.level > 0)
+    {
+        fifo_pop();
+    }
+}
+
+// -- API Host (fake_hw.h) --
+
+void fake_hw_adc_set_source(uint input, fake_hw_adc_source source, void *ctx)
+{
+    analog.source[input] = source;
+    analog.source_ctx[input] = ctx;
+}
+
+void fake_hw_adc_set_voltage(uint input, float volts)
+{
+    analog.source[input] = NULL;
+    analog.volts[input] = volts;
+}
+
+uint64_t fake_hw_adc_samples(void)
+{
+    return analog.samples;
+}
+
+uint64_t fake_hw_adc_overflows(void)
+{
+    return analog.overflows;
+}
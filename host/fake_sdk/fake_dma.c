@@ -0,0 +1,466 @@
+/**
+ * Fake Pico SDK: API hardware/dma.h dan model controller DMA.
+ *
+ * Setiap channel menyimpan alamat baca/tulis, sisa transfer dan word CTRL
+ * dengan semantik RP2040: TRANS_COUNT dimuat ulang setiap trigger, alamat
+ * yang di-increment tidak direset (kecuali dibungkus ring), dan channel yang
+ * selesai memicu channel CHAIN_TO serta DMA_IRQ_0 jika status IRQ-nya
+ * diteruskan lewat INTE0. Channel yang menulis AL3_READ_ADDR_TRIG channel
+ * lain (control block) memuat alamat baca channel itu lalu memicunya; yang
+ * menulis WRITE_ADDR hanya mengganti alamat tulis transfer berikutnya.
+ * fake_dma_service() dipanggil penjadwal
+ * setiap kali waktu maju sehingga transfer ber-DREQ PIO mengisi FIFO tepat
+ * setelah state machine menariknya; DREQ_XIP_STREAM aktif selama FIFO stream
+ * XIP (dibaca di XIP_AUX_BASE) berisi, DREQ_ADC selama FIFO ADC mencapai
+ * ambangnya.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <string.h>
+
+#include "fake_hw_internal.h"
+#include "hardware/dma.h"
+
+// Batas transfer dalam satu pemanggilan service; channel tanpa DREQ yang saling
+// chain tanpa henti akan mengunci simulasi
+#define MAX_TRANSFERS_PER_SERVICE (1u << 26)
+
+typedef struct
+{
+    dma_channel_hw_t hw;  // Register yang terlihat lewat dma_channel_hw_addr()
+    uint32_t trans_count; // Nilai reload TRANS_COUNT
+    uint64_t transfers;
+} fake_dma_channel;
+
+static struct
+{
+    fake_dma_channel ch[NUM_DMA_CHANNELS];
+    uint32_t claimed;
+    uint32_t intr;  // Status IRQ mentah per channel
+    uint32_t inte0; // Channel yang diteruskan ke DMA_IRQ_0
+} dma;
+
+// -- Helper Internal --
+
+static void check_channel(uint channel)
+{
+    if (channel >= NUM_DMA_CHANNELS)
+    {
+        panic("fake_dma: channel %u tidak valid", channel);
+    }
+}
+
+static uint ctrl_field(uint32_t ctrl, uint32_t bits, uint lsb)
+{
+    return (ctrl & bits) >> lsb;
+}
+
+static void trigger(uint channel)
+{
+    fake_dma_channel *c = &dma.ch[channel];
+    if (!(c->hw.ctrl_trig & DMA_CH0_CTRL_TRIG_EN_BITS))
+    {
+        return;
+    }
+    c->hw.transfer_count = c->trans_count;
+    c->hw.ctrl_trig |= DMA_CH0_CTRL_TRIG_BUSY_BITS;
+}
+
+static bool channel_busy(const fake_dma_channel *c)
+{
+    return (c->hw.ctrl_trig & DMA_CH0_CTRL_TRIG_BUSY_BITS) != 0;
+}
+
+/**
+ * @brief Menandai channel selesai: status IRQ disetel (kecuali IRQ_QUIET)
+ *        lalu channel CHAIN_TO dipicu.
+ */
+static void finish(uint channel)
+{
+    fake_dma_channel *c = &dma.ch[channel];
+    c->hw.ctrl_trig &= ~DMA_CH0_CTRL_TRIG_BUSY_BITS;
+    if (!(c->hw.ctrl_trig & DMA_CH0_CTRL_TRIG_IRQ_QUIET_BITS))
+    {
+        dma.intr |= 1u << channel;
+    }
+    uint chain = ctrl_field(c->hw.ctrl_trig, DMA_CH0_CTRL_TRIG_CHAIN_TO_BITS, DMA_CH0_CTRL_TRIG_CHAIN_TO_LSB);
+    if (chain != channel)
+    {
+        trigger(chain);
+    }
+    if (dma.intr & dma.inte0 & (1u << channel))
+    {
+        fake_hw_raise_irq(FAKE_IRQ_DMA_IRQ_0);
+    }
+}
+
+static bool dreq_active(uint32_t ctrl)
+{
+    uint treq = ctrl_field(ctrl, DMA_CH0_CTRL_TRIG_TREQ_SEL_BITS, DMA_CH0_CTRL_TRIG_TREQ_SEL_LSB);
+    if (treq == DREQ_FORCE)
+    {
+        return true;
+    }
+    if (treq == DREQ_XIP_STREAM)
+    {
+        return fake_flash_stream_dreq();
+    }
+    if (treq == DREQ_ADC)
+    {
+        return fake_adc_dreq();
+    }
+    return fake_pio_dreq_active(treq);
+}
+
+static uintptr_t advance_addr(uintptr_t addr, uint size, uint ring_bits, bool in_ring)
+{
+    if (!in_ring || ring_bits == 0)
+    {
+        return addr + size;
+    }
+    uintptr_t mask = ((uintptr_t)1 << ring_bits) - 1;
+    return (addr & ~mask) | ((addr + size) & mask);
+}
+
+/**
+ * @brief Menulis register channel lain lewat DMA (control block):
+ *        AL3_READ_ADDR_TRIG atau WRITE_ADDR.
+ *
+ * Alamat yang dipindahkan selebar pointer host, bukan word 32 bit.
+ *
+ * @return false jika addr bukan salah satu register tersebut
+ */
+static bool write_channel_register(uintptr_t addr, uintptr_t read_addr)
+{
+    for (uint i = 0; i < NUM_DMA_CHANNELS; ++i)
+    {
+        fake_dma_channel *target = &dma.ch[i];
+        if (addr == (uintptr_t)&target->hw.al3_read_addr_trig || addr == (uintptr_t)&target->hw.write_addr)
+        {
+            uintptr_t value;
+            memcpy(&value, (const void *)read_addr, sizeof(value));
+            if (addr == (uintptr_t)&target->hw.write_addr)
+            {
+                target->hw.write_addr = value;
+                return true;
+            }
+            target->hw.read_addr = value;
+            trigger(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Menjalankan satu transfer channel c.
+ */
+static void transfer_one(fake_dma_channel *c)
+{
+    uint size = 1u << ctrl_field(c->hw.ctrl_trig, DMA_CH0_CTRL_TRIG_DATA_SIZE_BITS, DMA_CH0_CTRL_TRIG_DATA_SIZE_LSB);
+    if (!write_channel_register(c->hw.write_addr, c->hw.read_addr))
+    {
+        uint32_t value = 0;
+        if (!fake_pio_dma_read((const volatile void *)c->hw.read_addr, &value) &&
+            !fake_flash_dma_read((const volatile void *)c->hw.read_addr, &value) &&
+            !fake_adc_dma_read((const volatile void *)c->hw.read_addr, &value))
+        {
+            memcpy(&value, (const void *)c->hw.read_addr, size);
+        }
+        if (c->hw.ctrl_trig & DMA_CH0_CTRL_TRIG_BSWAP_BITS)
+        {
+            value = size == 4 ? __builtin_bswap32(value) : size == 2 ? __builtin_bswap16((uint16_t)value) : value;
+        }
+        if (!fake_pio_dma_write((volatile void *)c->hw.write_addr, value))
+        {
+            memcpy((void *)c->hw.write_addr, &value, size);
+        }
+    }
+
+    uint ring_bits = ctrl_field(c->hw.ctrl_trig, DMA_CH0_CTRL_TRIG_RING_SIZE_BITS, DMA_CH0_CTRL_TRIG_RING_SIZE_LSB);
+    bool ring_write = (c->hw.ctrl_trig & DMA_CH0_CTRL_TRIG_RING_SEL_BITS) != 0;
+    if (c->hw.ctrl_trig & DMA_CH0_CTRL_TRIG_INCR_READ_BITS)
+    {
+        c->hw.read_addr = advance_addr(c->hw.read_addr, size, ring_bits, !ring_write);
+    }
+    if (c->hw.ctrl_trig & DMA_CH0_CTRL_TRIG_INCR_WRITE_BITS)
+    {
+        c->hw.write_addr = advance_addr(c->hw.write_addr, size, ring_bits, ring_write);
+    }
+    c->hw.transfer_count--;
+    c->transfers++;
+}
+
+// -- Antarmuka ke Penjadwal (fake_hw.c) --
+
+void fake_dma_reset(void)
+{
+    memset(&dma, 0, sizeof(dma));
+}
+
+/**
+ * @brief Menjalankan semua transfer yang DREQ-nya aktif pada siklus saat ini.
+ */
+void fake_dma_service(void)
+{
+    uint32_t budget = MAX_TRANSFERS_PER_SERVICE;
+    bool progress = true;
+    while (progress)
+    {
+        progress = false;
+        for (uint i = 0; i < NUM_DMA_CHANNELS; ++i)
+        {
+            fake_dma_channel *c = &dma.ch[i];
+            while (channel_busy(c) && (c->hw.transfer_count == 0 || dreq_active(c->hw.ctrl_trig)))
+            {
+                if (c->hw.transfer_count > 0)
+                {
+                    if (budget-- == 0)
+                    {
+                        panic("fake_dma: transfer tanpa DREQ tidak pernah selesai");
+                    }
+                    transfer_one(c);
+                }
+                progress = true;
+                if (c->hw.transfer_count == 0)
+                {
+                    finish(i);
+                }
+            }
+        }
+    }
+}
+
+uint64_t fake_hw_dma_transfers(uint channel)
+{
+    check_channel(channel);
+    return dma.ch[channel].transfers;
+}
+
+// -- Alokasi Channel --
+
+void dma_channel_claim(uint channel)
+{
+    check_channel(channel);
+    if (dma.claimed & (1u << channel))
+    {
+        panic("DMA channel %u sudah di-claim", channel);
+    }
+    dma.claimed |= 1u << channel;
+}
+
+void dma_claim_mask(uint32_t channel_mask)
+{
+    for (uint i = 0; i < NUM_DMA_CHANNELS; ++i)
+    {
+        if (channel_mask & (1u << i))
+        {
+            dma_channel_claim(i);
+        }
+    }
+}
+
+void dma_channel_unclaim(uint channel)
+{
+    check_channel(channel);
+    dma.claimed &= ~(1u << channel);
+}
+
+int dma_claim_unused_channel(bool required)
+{
+    for (uint i = 0; i < NUM_DMA_CHANNELS; ++i)
+    {
+        if (!(dma.claimed & (1u << i)))
+        {
+            dma.claimed |= 1u << i;
+            return (int)i;
+        }
+    }
+    if (required)
+    {
+        panic("Tidak ada DMA channel yang bebas");
+    }
+    return -1;
+}
+
+bool dma_channel_is_claimed(uint channel)
+{
+    check_channel(channel);
+    return (dma.claimed & (1u << channel)) != 0;
+}
+
+// -- Konfigurasi --
+
+dma_channel_config dma_channel_get_default_config(uint channel)
+{
+    dma_channel_config c = {0};
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, DREQ_FORCE);
+    channel_config_set_chain_to(&c, channel);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_ring(&c, false, 0);
+    channel_config_set_enable(&c, true);
+    return c;
+}
+
+dma_channel_config dma_get_channel_config(uint channel)
+{
+    check_channel(channel);
+    dma_channel_config c = {dma.ch[channel].hw.ctrl_trig & ~DMA_CH0_CTRL_TRIG_BUSY_BITS};
+    return c;
+}
+
+// -- Kontrol Channel --
+
+void dma_channel_set_config(uint channel, const dma_channel_config *config, bool trigger_now)
+{
+    fake_hw_cpu_call();
+    check_channel(channel);
+    uint32_t busy = dma.ch[channel].hw.ctrl_trig & DMA_CH0_CTRL_TRIG_BUSY_BITS;
+    dma.ch[channel].hw.ctrl_trig = (config->ctrl & ~DMA_CH0_CTRL_TRIG_BUSY_BITS) | busy;
+    fake_hw_log(FAKE_HW_LOG_REG_WRITE, -1, (int)channel, trigger_now ? "DMA_CTRL_TRIG" : "DMA_AL1_CTRL",
+                config->ctrl);
+    if (trigger_now)
+    {
+        trigger(channel);
+        fake_dma_service();
+    }
+}
+
+void dma_channel_set_read_addr(uint channel, const volatile void *read_addr, bool trigger_now)
+{
+    fake_hw_cpu_call();
+    check_channel(channel);
+    dma.ch[channel].hw.read_addr = (uintptr_t)read_addr;
+    fake_hw_log(FAKE_HW_LOG_REG_WRITE, -1, (int)channel, trigger_now ? "DMA_AL3_READ_ADDR_TRIG" : "DMA_READ_ADDR",
+                (uint32_t)(uintptr_t)read_addr);
+    if (trigger_now)
+    {
+        trigger(channel);
+        fake_dma_service();
+    }
+}
+
+void dma_channel_set_write_addr(uint channel, volatile void *write_addr, bool trigger_now)
+{
+    fake_hw_cpu_call();
+    check_channel(channel);
+    dma.ch[channel].hw.write_addr = (uintptr_t)write_addr;
+    fake_hw_log(FAKE_HW_LOG_REG_WRITE, -1, (int)channel, trigger_now ? "DMA_AL2_WRITE_ADDR_TRIG" : "DMA_WRITE_ADDR",
+                (uint32_t)(uintptr_t)write_addr);
+    if (trigger_now)
+    {
+        trigger(channel);
+        fake_dma_service();
+    }
+}
+
+void dma_channel_set_trans_count(uint channel, uint32_t trans_count, bool trigger_now)
+{
+    fake_hw_cpu_call();
+    check_channel(channel);
+    dma.ch[channel].trans_count = trans_count;
+    fake_hw_log(FAKE_HW_LOG_REG_WRITE, -1, (int)channel,
+                trigger_now ? "DMA_AL1_TRANS_COUNT_TRIG" : "DMA_TRANS_COUNT", trans_count);
+    if (trigger_now)
+    {
+        trigger(channel);
+        fake_dma_service();
+    }
+}
+
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint transfer_count, bool trigger_now)
+{
+    dma_channel_set_read_addr(channel, read_addr, false);
+    dma_channel_set_write_addr(channel, write_addr, false);
+    dma_channel_set_trans_count(channel, transfer_count, false);
+    dma_channel_set_config(channel, config, trigger_now);
+}
+
+void dma_start_channel_mask(uint32_t chan_mask)
+{
+    fake_hw_cpu_call();
+    fake_hw_log(FAKE_HW_LOG_REG_WRITE, -1, -1, "DMA_MULTI_CHAN_TRIGGER", chan_mask);
+    for (uint i = 0; i < NUM_DMA_CHANNELS; ++i)
+    {
+        if (chan_mask & (1u << i))
+        {
+            trigger(i);
+        }
+    }
+    fake_dma_service();
+}
+
+void dma_channel_start(uint channel)
+{
+    check_channel(channel);
+    dma_start_channel_mask(1u << channel);
+}
+
+void dma_channel_abort(uint channel)
+{
+    fake_hw_cpu_call();
+    check_channel(channel);
+    fake_hw_log(FAKE_HW_LOG_REG_WRITE, -1, -1, "DMA_CHAN_ABORT", 1u << channel);
+    // Abort tidak memicu CHAIN_TO (errata RP2040-E13 diabaikan oleh model ini)
+    dma.ch[channel].hw.ctrl_trig &= ~DMA_CH0_CTRL_TRIG_BUSY_BITS;
+    dma.ch[channel].hw.transfer_count = 0;
+}
+
+bool dma_channel_is_busy(uint channel)
+{
+    fake_hw_cpu_call();
+    check_channel(channel);
+    return channel_busy(&dma.ch[channel]);
+}
+
+static bool channel_idle(void *ctx)
+{
+    return !channel_busy(&dma.ch[*(const uint *)ctx]);
+}
+
+void dma_channel_wait_for_finish_blocking(uint channel)
+{
+    check_channel(channel);
+    fake_hw_run_until(UINT64_MAX, channel_idle, &channel);
+}
+
+dma_channel_hw_t *dma_channel_hw_addr(uint channel)
+{
+    check_channel(channel);
+    return &dma.ch[channel].hw;
+}
+
+// -- Interrupt --
+
+void dma_channel_set_irq0_enabled(uint channel, bool enabled)
+{
+    check_channel(channel);
+    dma_set_irq0_channel_mask_enabled(1u << channel, enabled);
+}
+
+void dma_set_irq0_channel_mask_enabled(uint32_t channel_mask, bool enabled)
+{
+    fake_hw_cpu_call();
+    dma.inte0 = enabled ? (dma.inte0 | channel_mask) : (dma.inte0 & ~channel_mask);
+    fake_hw_log(FAKE_HW_LOG_REG_WRITE, -1, -1, "DMA_INTE0", dma.inte0);
+    if (dma.intr & dma.inte0)
+    {
+        fake_hw_raise_irq(FAKE_IRQ_DMA_IRQ_0);
+    }
+}
+
+bool dma_channel_get_irq0_status(uint channel)
+{
+    check_channel(channel);
+    return (dma.intr & dma.inte0 & (1u << channel)) != 0;
+}
+
+void dma_channel_acknowledge_irq0(uint channel)
+{
+    check_channel(channel);
+    dma.intr &= ~(1u << channel);
+}
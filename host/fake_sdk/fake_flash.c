@@ -0,0 +1,298 @@
+/**
+ * Fake Pico SDK: flash QSPI simulasi (hardware_flash, pico_flash) dan stream
+ * XIP (XIP_CTRL STREAM_ADDR/STREAM_CTR, FIFO di XIP_AUX_BASE).
+ *
+ * Waktu erase dan program mengikuti nilai tipikal W25Q16JV (chip flash board
+ * Pico) dan dibebankan ke waktu simulasi; PIO dan DMA tetap berjalan selama
+ * itu, CPU tidak. Untuk pengujian ketahanan, fake_hw_flash_power_loss_after()
+ * memutus "listrik" setelah sejumlah byte: operasi yang sedang berjalan
+ * terpotong di byte itu dan operasi berikutnya diabaikan sampai
+ * fake_hw_flash_power_restore().
+ *
+ * Stream XIP membaca satu word per STREAM_WORD_NS selama FIFO stream (dua
+ * entry) belum penuh: satu akses continuous read quad (alamat 6 + mode 2 +
+ * dummy 4 + data 8 SCK) plus jeda CS pada SCK 62,5 MHz (clk_sys/2 dari boot2
+ * bawaan pada 125 MHz).
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <string.h>
+
+#include "fake_hw_internal.h"
+#include "hardware/flash.h"
+#include "hardware/structs/xip_ctrl.h"
+#include "hardware/sync.h"
+#include "pico/flash.h"
+
+#define SECTOR_ERASE_MS 45 // tSE tipikal
+#define PAGE_PROGRAM_US 400 // tPP tipikal
+#define NUM_SECTORS (PICO_FLASH_SIZE_BYTES / FLASH_SECTOR_SIZE)
+#define STREAM_WORD_NS 352 // 22 SCK pada 62,5 MHz
+#define STREAM_FIFO_DEPTH 2
+
+uint8_t fake_flash_image[PICO_FLASH_SIZE_BYTES];
+xip_ctrl_hw_t fake_xip_ctrl;
+volatile uint32_t fake_xip_aux;
+
+static struct
+{
+    bool initialized;
+    bool in_safe_execute;
+    uint32_t unsafe_ops;
+    uint32_t erase_count[NUM_SECTORS];
+    uint32_t program_count;
+    bool power_loss_armed;
+    uint32_t power_budget; // Byte yang masih ditulis sebelum listrik padam
+    bool powered_off;
+} flash;
+
+static struct
+{
+    uint32_t fifo[STREAM_FIFO_DEPTH];
+    uint head;
+    uint level;
+    bool reading;       // Satu akses flash sedang berjalan
+    uintptr_t read_addr; // Alamat akses yang sedang berjalan
+    uint64_t ready_ps;  // Word akses itu masuk FIFO
+    uint64_t words;
+} stream;
+
+// -- Antarmuka ke fake_hw.c --
+
+/**
+ * @brief Mengosongkan flash hanya pada reset pertama; isi bertahan setelahnya.
+ */
+void fake_flash_reset(void)
+{
+    if (!flash.initialized)
+    {
+        fake_hw_flash_erase_all();
+    }
+    flash.in_safe_execute = false;
+    memset(&stream, 0, sizeof(stream));
+    memset(&fake_xip_ctrl, 0, sizeof(fake_xip_ctrl));
+    fake_xip_ctrl.stat = XIP_STAT_FLUSH_READY_BITS | XIP_STAT_FIFO_EMPTY_BITS;
+}
+
+static void update_stream_stat(void)
+{
+    fake_xip_ctrl.stat = XIP_STAT_FLUSH_READY_BITS | (stream.level == 0 ? XIP_STAT_FIFO_EMPTY_BITS : 0) |
+                         (stream.level == STREAM_FIFO_DEPTH ? XIP_STAT_FIFO_FULL_BITS : 0);
+}
+
+/**
+ * @brief Memulai akses word berikutnya jika STREAM_CTR > 0 dan FIFO masih
+ *        punya tempat untuk hasilnya.
+ */
+static void start_stream_read(void)
+{
+    if (stream.reading || (fake_xip_ctrl.stream_ctr & XIP_STREAM_CTR_BITS) == 0 ||
+        stream.level == STREAM_FIFO_DEPTH)
+    {
+        return;
+    }
+    stream.read_addr = fake_xip_ctrl.stream_addr;
+    fake_xip_ctrl.stream_addr += sizeof(uint32_t);
+    fake_xip_ctrl.stream_ctr = (fake_xip_ctrl.stream_ctr & XIP_STREAM_CTR_BITS) - 1u;
+    stream.reading = true;
+    stream.ready_ps = fake_hw_now_ps() + STREAM_WORD_NS * 1000ull;
+}
+
+uint64_t fake_flash_next_event_ps(void)
+{
+    if (stream.reading)
+    {
+        return stream.ready_ps;
+    }
+    // STREAM_CTR baru ditulis firmware: mulai pada langkah berikutnya
+    if ((fake_xip_ctrl.stream_ctr & XIP_STREAM_CTR_BITS) != 0 && stream.level < STREAM_FIFO_DEPTH)
+    {
+        return fake_hw_now_ps();
+    }
+    return UINT64_MAX;
+}
+
+void fake_flash_service(uint64_t cycle)
+{
+    (void)cycle;
+    if (stream.reading && stream.ready_ps <= fake_hw_now_ps())
+    {
+        uintptr_t offs = stream.read_addr - XIP_BASE;
+        uint32_t word = UINT32_MAX;
+        if (offs + sizeof(word) <= PICO_FLASH_SIZE_BYTES)
+        {
+            memcpy(&word, &fake_flash_image[offs], sizeof(word));
+        }
+        stream.fifo[(stream.head + stream.level) % STREAM_FIFO_DEPTH] = word;
+        stream.level++;
+        stream.reading = false;
+        stream.words++;
+    }
+    start_stream_read();
+    update_stream_stat();
+}
+
+bool fake_flash_stream_dreq(void)
+{
+    return stream.level > 0;
+}
+
+bool fake_flash_dma_read(const volatile void *addr, uint32_t *value)
+{
+    if (addr != (const volatile void *)&fake_xip_aux)
+    {
+        return false;
+    }
+    *value = 0;
+    if (stream.level > 0)
+    {
+        *value = stream.fifo[stream.head];
+        stream.head = (stream.head + 1) % STREAM_FIFO_DEPTH;
+        stream.level--;
+    }
+    start_stream_read();
+    update_stream_stat();
+    return true;
+}
+
+/**
+ * @brief Mengurangi anggaran byte sebelum listrik padam.
+ *
+ * @return Jumlah byte dari len yang masih benar-benar ditulis
+ */
+static size_t powered_bytes(size_t len)
+{
+    if (flash.powered_off)
+    {
+        return 0;
+    }
+    if (!flash.power_loss_armed || flash.power_budget >= len)
+    {
+        if (flash.power_loss_armed)
+        {
+            flash.power_budget -= (uint32_t)len;
+        }
+        return len;
+    }
+    size_t n = flash.power_budget;
+    flash.power_budget = 0;
+    flash.powered_off = true;
+    return n;
+}
+
+static void check_op(uint32_t offs, size_t count, size_t align)
+{
+    if (offs % align || count % align || offs + count > PICO_FLASH_SIZE_BYTES)
+    {
+        panic("fake_flash: offset 0x%x / panjang %zu tidak sejajar %zu", offs, count, align);
+    }
+    if (!flash.in_safe_execute)
+    {
+        flash.unsafe_ops++;
+    }
+}
+
+// -- SDK --
+
+void flash_range_erase(uint32_t flash_offs, size_t count)
+{
+    check_op(flash_offs, count, FLASH_SECTOR_SIZE);
+    for (uint32_t offs = flash_offs; offs < flash_offs + count; offs += FLASH_SECTOR_SIZE)
+    {
+        size_t n = powered_bytes(FLASH_SECTOR_SIZE);
+        memset(&fake_flash_image[offs], 0xFF, n);
+        if (n > 0)
+        {
+            flash.erase_count[offs / FLASH_SECTOR_SIZE]++;
+        }
+        fake_hw_advance_us(SECTOR_ERASE_MS * 1000u);
+    }
+}
+
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count)
+{
+    check_op(flash_offs, count, FLASH_PAGE_SIZE);
+    for (size_t page = 0; page < count; page += FLASH_PAGE_SIZE)
+    {
+        size_t n = powered_bytes(FLASH_PAGE_SIZE);
+        for (size_t i = 0; i < n; ++i)
+        {
+            // Program hanya menurunkan bit 1 -> 0
+            fake_flash_image[flash_offs + page + i] &= data[page + i];
+        }
+        flash.program_count++;
+        fake_hw_advance_us(PAGE_PROGRAM_US);
+    }
+}
+
+int flash_safe_execute(void (*func)(void *), void *param, uint32_t enter_exit_timeout_ms)
+{
+    (void)enter_exit_timeout_ms;
+    fake_hw_cpu_call();
+    uint32_t status = save_and_disable_interrupts();
+    flash.in_safe_execute = true;
+    func(param);
+    flash.in_safe_execute = false;
+    restore_interrupts(status);
+    return PICO_OK;
+}
+
+bool flash_safe_execute_core_init(void)
+{
+    return true;
+}
+
+bool flash_safe_execute_core_deinit(void)
+{
+    return true;
+}
+
+// -- API Host (fake_hw.h) --
+
+void fake_hw_flash_erase_all(void)
+{
+    memset(fake_flash_image, 0xFF, sizeof(fake_flash_image));
+    memset(flash.erase_count, 0, sizeof(flash.erase_count));
+    flash.program_count = 0;
+    flash.unsafe_ops = 0;
+    flash.initialized = true;
+}
+
+uint32_t fake_hw_flash_erase_count(uint32_t flash_offs)
+{
+    return flash.erase_count[flash_offs / FLASH_SECTOR_SIZE];
+}
+
+uint32_t fake_hw_flash_program_count(void)
+{
+    return flash.program_count;
+}
+
+uint32_t fake_hw_flash_unsafe_ops(void)
+{
+    return flash.unsafe_ops;
+}
+
+uint64_t fake_hw_flash_stream_words(void)
+{
+    return stream.words;
+}
+
+void fake_hw_flash_power_loss_after(uint32_t bytes)
+{
+    flash.power_loss_armed = true;
+    flash.power_budget = bytes;
+    flash.powered_off = false;
+}
+
+bool fake_hw_flash_power_lost(void)
+{
+    return flash.powered_off;
+}
+
+void fake_hw_flash_power_restore(void)
+{
+    flash.power_loss_armed = false;
+    flash.powered_off = false;
+}
@@ -0,0 +1,1231 @@
+/**
+ * Fake Pico SDK: penjadwal waktu simulasi, GPIO, clock, interrupt dan log.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fake_hw_internal.h"
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "hardware/timer.h"
+
+#define PS_PER_S 1000000000000ull
+#define MAX_SCHEDULED_GPIO 256
+#define DEFAULT_CPU_CALL_CYCLES 4
+#define DEFAULT_LOG_CAPACITY (1u << 20)
+#define MAX_SHARED_IRQ_HANDLERS 4
+
+// -- Model GPIO --
+typedef struct
+{
+    enum gpio_function function;
+    bool sio_oe;
+    bool sio_out;
+    bool pull_up;
+    bool pull_down;
+    int8_t external; // -1 = tidak di-drive dari luar, 0/1 = level input
+    uint8_t inover;  // enum gpio_override untuk input ke SIO/PIO/interrupt
+    uint32_t irq_mask;
+    uint32_t irq_status;
+    bool level;
+} fake_gpio;
+
+typedef struct
+{
+    uint64_t time_ps;
+    uint gpio;
+    bool level;
+    uint64_t period_fs; // > 0: sumber clock, event berikutnya dijadwalkan ulang
+    uint64_t high_fs;
+    uint64_t time_fs;   // Waktu tepat event sumber clock (fs)
+} scheduled_gpio;
+
+static struct
+{
+    // Waktu
+    uint64_t cycles;
+    uint32_t sys_clk_hz;
+    uint64_t base_cycles;
+    uint64_t base_ps;
+    uint32_t cpu_call_cycles;
+    int scheduler_depth;
+
+    // GPIO
+    fake_gpio gpio[FAKE_NUM_GPIOS];
+    uint32_t levels; // Level pad
+    uint32_t inputs; // Level input setelah override INOVER
+    gpio_irq_callback_t gpio_callback;
+    scheduled_gpio schedule[MAX_SCHEDULED_GPIO];
+    uint schedule_count;
+    fake_hw_pin_listener pin_listener;
+    void *pin_listener_ctx;
+
+    // Interrupt
+    void (*irq_handler[FAKE_NUM_IRQS])(void);
+    irq_handler_t irq_shared[FAKE_NUM_IRQS][MAX_SHARED_IRQ_HANDLERS];
+    uint32_t irq_enabled;
+    uint32_t irq_pending;
+    bool interrupts_disabled;
+    int isr_depth;
+    bool event_flag;
+
+    // Timer alarm
+    struct
+    {
+        bool claimed;
+        bool armed;
+        uint64_t target_us;
+        hardware_alarm_callback_t callback;
+    } alarm[NUM_ALARMS];
+    uint32_t alarm_fired; // Alarm yang sudah berbunyi, menunggu handler
+
+    // Batas waktu eksekusi firmware
+    uint64_t deadline_ps;
+    jmp_buf *deadline_jmp;
+
+    // Log
+    bool log_enabled;
+    fake_hw_log_entry *log;
+    size_t log_count;
+    size_t log_capacity;
+} hw;
+
+static void gpio_bank0_irq_handler(void);
+static void alarm_irq_handler(void);
+
+/**
+ * @brief Menyisipkan event GPIO ke antrian yang terurut waktu.
+ */
+static void schedule_event(scheduled_gpio ev)
+{
+    if (hw.schedule_count == MAX_SCHEDULED_GPIO)
+    {
+        panic("fake_hw: antrian event GPIO penuh");
+    }
+    uint i = hw.schedule_count;
+    while (i > 0 && hw.schedule[i - 1].time_ps > ev.time_ps)
+    {
+        hw.schedule[i] = hw.schedule[i - 1];
+        i--;
+    }
+    hw.schedule[i] = ev;
+    hw.schedule_count++;
+}
+
+// -- Konversi Waktu --
+
+static uint64_t cycles_to_ps(uint64_t cycle)
+{
+    return hw.base_ps + (uint64_t)((unsigned __int128)(cycle - hw.base_cycles) * PS_PER_S / hw.sys_clk_hz);
+}
+
+static uint64_t ps_to_cycle(uint64_t ps)
+{
+    if (ps <= hw.base_ps)
+    {
+        return hw.base_cycles;
+    }
+    unsigned __int128 delta = (unsigned __int128)(ps - hw.base_ps) * hw.sys_clk_hz;
+    return hw.base_cycles + (uint64_t)((delta + PS_PER_S - 1) / PS_PER_S);
+}
+
+static void set_sys_clk_hz(uint32_t hz)
+{
+    hw.base_ps = cycles_to_ps(hw.cycles);
+    hw.base_cycles = hw.cycles;
+    hw.sys_clk_hz = hz;
+    fake_hw_log(FAKE_HW_LOG_REG_WRITE, -1, -1, "CLK_SYS_HZ", hz);
+}
+
+// -- Siklus Hidup --
+
+void fake_hw_reset(void)
+{
+    free(hw.log);
+    memset(&hw, 0, sizeof(hw));
+    hw.sys_clk_hz = SYS_CLK_HZ;
+    hw.cpu_call_cycles = DEFAULT_CPU_CALL_CYCLES;
+    hw.deadline_ps = UINT64_MAX;
+    hw.log_enabled = true;
+    for (uint i = 0; i < FAKE_NUM_GPIOS; ++i)
+    {
+        hw.gpio[i].function = GPIO_FUNC_NULL;
+        hw.gpio[i].pull_down = true; // Default reset pad bank 0
+        hw.gpio[i].external = -1;
+    }
+    hw.irq_handler[FAKE_IRQ_IO_BANK0] = gpio_bank0_irq_handler;
+    for (uint i = 0; i < NUM_ALARMS; ++i)
+    {
+        hw.irq_handler[TIMER_IRQ_0 + i] = alarm_irq_handler;
+    }
+    fake_pio_reset();
+    fake_dma_reset();
+    fake_i2c_reset();
+    fake_spi_reset();
+    fake_stdio_reset();
+    fake_flash_reset();
+    fake_adc_reset();
+}
+
+/**
+ * @brief Menjalankan entry firmware sampai kembali atau sampai waktu simulasi
+ *        mencapai until_us.
+ *
+ * @return true jika batas waktu tercapai, false jika entry kembali sendiri
+ */
+bool fake_hw_run_firmware(int (*entry)(void), uint64_t until_us)
+{
+    jmp_buf jmp;
+    hw.deadline_ps = until_us * 1000000ull;
+    hw.deadline_jmp = &jmp;
+    bool reached = false;
+    if (setjmp(jmp) == 0)
+    {
+        entry();
+    }
+    else
+    {
+        reached = true;
+    }
+    hw.deadline_jmp = NULL;
+    hw.deadline_ps = UINT64_MAX;
+    hw.scheduler_depth = 0;
+    hw.isr_depth = 0;
+    hw.interrupts_disabled = false;
+    return reached;
+}
+
+// -- Penjadwal --
+
+/**
+ * @brief Memajukan waktu simulasi sampai target_cycle atau sampai stop() bernilai true.
+ *
+ * @return true jika berhenti karena stop()
+ */
+bool fake_hw_run_until(uint64_t target_cycle, bool (*stop)(void *ctx), void *ctx)
+{
+    hw.scheduler_depth++;
+    bool stopped = false;
+    while (true)
+    {
+        // Flag IRQ yang di-force CPU (IRQ_FORCE), flag FDEBUG yang dihapus CPU
+        // dan DMA ber-DREQ bereaksi pada siklus yang sama dengan perubahannya
+        fake_pio_apply_cpu_writes();
+        fake_dma_service();
+        if (stop && stop(ctx))
+        {
+            stopped = true;
+            break;
+        }
+
+        // Cari event eksternal terdekat (bukan tick PIO)
+        uint64_t ext_next = target_cycle;
+        uint64_t deadline_cycle = hw.deadline_ps == UINT64_MAX ? UINT64_MAX : ps_to_cycle(hw.deadline_ps);
+        if (deadline_cycle < ext_next)
+        {
+            ext_next = deadline_cycle;
+        }
+        if (hw.schedule_count > 0)
+        {
+            uint64_t c = ps_to_cycle(hw.schedule[0].time_ps);
+            if (c < ext_next)
+            {
+                ext_next = c;
+            }
+        }
+        for (uint i = 0; i < NUM_ALARMS; ++i)
+        {
+            uint64_t c = hw.alarm[i].armed ? ps_to_cycle(hw.alarm[i].target_us * 1000000ull) : UINT64_MAX;
+            if (c < ext_next)
+            {
+                ext_next = c;
+            }
+        }
+        uint64_t i2c_ps = fake_i2c_next_event_ps();
+        if (i2c_ps != UINT64_MAX && ps_to_cycle(i2c_ps) < ext_next)
+        {
+            ext_next = ps_to_cycle(i2c_ps);
+        }
+        uint64_t spi_ps = fake_spi_next_event_ps();
+        if (spi_ps != UINT64_MAX && ps_to_cycle(spi_ps) < ext_next)
+        {
+            ext_next = ps_to_cycle(spi_ps);
+        }
+        uint64_t stdio_ps = fake_stdio_next_event_ps();
+        if (stdio_ps != UINT64_MAX && ps_to_cycle(stdio_ps) < ext_next)
+        {
+            ext_next = ps_to_cycle(stdio_ps);
+        }
+        uint64_t flash_ps = fake_flash_next_event_ps();
+        if (flash_ps != UINT64_MAX && ps_to_cycle(flash_ps) < ext_next)
+        {
+            ext_next = ps_to_cycle(flash_ps);
+        }
+        uint64_t adc_ps = fake_adc_next_event_ps();
+        if (adc_ps != UINT64_MAX && ps_to_cycle(adc_ps) < ext_next)
+        {
+            ext_next = ps_to_cycle(adc_ps);
+        }
+        if (ext_next < hw.cycles)
+        {
+            ext_next = hw.cycles;
+        }
+
+        uint64_t next = ext_next;
+        uint64_t tick;
+        bool all_stalled = fake_pio_all_stalled();
+        if (!all_stalled && fake_pio_next_tick(&tick) && tick < next)
+        {
+            next = tick;
+        }
+
+        if (next == UINT64_MAX)
+        {
+            panic("fake_hw: simulasi macet, tidak ada event yang bisa terjadi");
+        }
+        if (all_stalled)
+        {
+            fake_pio_skip_to(next);
+        }
+
+        if (next >= deadline_cycle && hw.deadline_jmp)
+        {
+            hw.cycles = deadline_cycle;
+            longjmp(*hw.deadline_jmp, 1);
+        }
+        if (next >= target_cycle)
+        {
+            hw.cycles = target_cycle;
+            break;
+        }
+        hw.cycles = next;
+
+        // Event GPIO terjadwal yang jatuh tempo
+        while (hw.schedule_count > 0 && ps_to_cycle(hw.schedule[0].time_ps) <= hw.cycles)
+        {
+            scheduled_gpio ev = hw.schedule[0];
+            memmove(&hw.schedule[0], &hw.schedule[1], (hw.schedule_count - 1) * sizeof(ev));
+            hw.schedule_count--;
+            fake_hw_gpio_set_input(ev.gpio, ev.level);
+            if (ev.period_fs > 0)
+            {
+                ev.time_fs += ev.level ? ev.high_fs : ev.period_fs - ev.high_fs;
+                ev.time_ps = ev.time_fs / 1000u;
+                ev.level = !ev.level;
+                schedule_event(ev);
+            }
+        }
+
+        // Alarm timer yang jatuh tempo
+        for (uint i = 0; i < NUM_ALARMS; ++i)
+        {
+            if (hw.alarm[i].armed && ps_to_cycle(hw.alarm[i].target_us * 1000000ull) <= hw.cycles)
+            {
+                hw.alarm[i].armed = false;
+                hw.alarm_fired |= 1u << i;
+                fake_hw_raise_irq(TIMER_IRQ_0 + i);
+            }
+        }
+
+        // Langkah master I2C yang jatuh tempo
+        fake_i2c_service(hw.cycles);
+
+        // Edge master SPI yang jatuh tempo
+        fake_spi_service(hw.cycles);
+
+        // Polling fd stdin yang jatuh tempo
+        fake_stdio_service(hw.cycles);
+
+        // Word stream XIP yang jatuh tempo
+        fake_flash_service(hw.cycles);
+
+        // Konversi ADC free-running yang jatuh tempo
+        fake_adc_service(hw.cycles);
+
+        // Tick PIO yang jatuh tempo
+        if (fake_pio_next_tick(&tick) && tick <= hw.cycles)
+        {
+            fake_pio_run_ticks(hw.cycles, ext_next);
+        }
+    }
+    hw.scheduler_depth--;
+    return stopped;
+}
+
+uint64_t fake_hw_ps_to_cycle(uint64_t ps)
+{
+    return ps_to_cycle(ps);
+}
+
+/**
+ * @brief Membebankan biaya satu pemanggilan fungsi SDK ke waktu CPU.
+ *
+ * Tidak memajukan waktu bila dipanggil dari handler interrupt.
+ */
+void fake_hw_cpu_call(void)
+{
+    if (hw.isr_depth > 0 || hw.scheduler_depth > 0)
+    {
+        return;
+    }
+    fake_hw_run_until(hw.cycles + hw.cpu_call_cycles, NULL, NULL);
+}
+
+uint64_t fake_hw_sys_cycles(void)
+{
+    return hw.cycles;
+}
+
+uint64_t fake_hw_now_ps(void)
+{
+    return cycles_to_ps(hw.cycles);
+}
+
+void fake_hw_advance_cycles(uint64_t cycles)
+{
+    fake_hw_run_until(hw.cycles + cycles, NULL, NULL);
+}
+
+void fake_hw_advance_us(uint64_t us)
+{
+    fake_hw_run_until(ps_to_cycle(fake_hw_now_ps() + us * 1000000ull), NULL, NULL);
+}
+
+void fake_hw_set_cpu_call_cycles(uint32_t cycles)
+{
+    hw.cpu_call_cycles = cycles;
+}
+
+// -- Log --
+
+void fake_hw_log(fake_hw_log_kind kind, int pio, int sm, const char *reg, uint32_t value)
+{
+    if (!hw.log_enabled)
+    {
+        return;
+    }
+    if (hw.log_count == hw.log_capacity)
+    {
+        if (hw.log_capacity >= DEFAULT_LOG_CAPACITY)
+        {
+            return; // Log penuh, entri baru dibuang
+        }
+        hw.log_capacity = hw.log_capacity ? hw.log_capacity * 2 : 1024;
+        hw.log = realloc(hw.log, hw.log_capacity * sizeof(*hw.log));
+    }
+    fake_hw_log_entry *e = &hw.log[hw.log_count++];
+    e->time_ps = cycles_to_ps(hw.cycles);
+    e->kind = kind;
+    e->pio = (int8_t)pio;
+    e->sm = (int8_t)sm;
+    e->reg = reg;
+    e->value = value;
+}
+
+void fake_hw_log_set_enabled(bool enabled)
+{
+    hw.log_enabled = enabled;
+}
+
+size_t fake_hw_log_count(void)
+{
+    return hw.log_count;
+}
+
+const fake_hw_log_entry *fake_hw_log_get(size_t index)
+{
+    return index < hw.log_count ? &hw.log[index] : NULL;
+}
+
+size_t fake_hw_log_count_matching(fake_hw_log_kind kind, const char *reg)
+{
+    size_t n = 0;
+    for (size_t i = 0; i < hw.log_count; ++i)
+    {
+        if (hw.log[i].kind == kind && (!reg || strcmp(hw.log[i].reg, reg) == 0))
+        {
+            n++;
+        }
+    }
+    return n;
+}
+
+void fake_hw_log_clear(void)
+{
+    hw.log_count = 0;
+}
+
+// -- Interrupt --
+
+static void dispatch_irqs(void)
+{
+    if (hw.interrupts_disabled || hw.isr_depth > 0)
+    {
+        return;
+    }
+    while (hw.irq_pending & hw.irq_enabled)
+    {
+        uint irq = (uint)__builtin_ctz(hw.irq_pending & hw.irq_enabled);
+        hw.irq_pending &= ~(1u << irq);
+        hw.isr_depth++;
+        if (hw.irq_handler[irq])
+        {
+            hw.irq_handler[irq]();
+        }
+        for (uint i = 0; i < MAX_SHARED_IRQ_HANDLERS; ++i)
+        {
+            if (hw.irq_shared[irq][i])
+            {
+                hw.irq_shared[irq][i]();
+            }
+        }
+        hw.isr_depth--;
+    }
+}
+
+void fake_hw_raise_irq(uint irq)
+{
+    hw.irq_pending |= 1u << irq;
+    hw.event_flag = true;
+    dispatch_irqs();
+}
+
+void fake_hw_set_irq_handler(uint irq, void (*handler)(void))
+{
+    hw.irq_handler[irq] = handler;
+}
+
+void fake_hw_set_irq_enabled(uint irq, bool enabled)
+{
+    if (enabled)
+    {
+        hw.irq_enabled |= 1u << irq;
+        dispatch_irqs();
+    }
+    else
+    {
+        hw.irq_enabled &= ~(1u << irq);
+    }
+}
+
+// -- API hardware/irq.h --
+
+static void check_irq(uint num)
+{
+    if (num >= FAKE_NUM_IRQS)
+    {
+        panic("fake_hw: interrupt %u tidak valid", num);
+    }
+}
+
+void irq_set_exclusive_handler(uint num, irq_handler_t handler)
+{
+    check_irq(num);
+    if (hw.irq_handler[num] && hw.irq_handler[num] != handler)
+    {
+        panic("fake_hw: interrupt %u sudah punya handler", num);
+    }
+    hw.irq_handler[num] = handler;
+}
+
+void irq_add_shared_handler(uint num, irq_handler_t handler, uint8_t order_priority)
+{
+    (void)order_priority;
+    check_irq(num);
+    if (hw.irq_handler[num])
+    {
+        panic("fake_hw: interrupt %u sudah punya handler exclusive", num);
+    }
+    for (uint i = 0; i < MAX_SHARED_IRQ_HANDLERS; ++i)
+    {
+        if (!hw.irq_shared[num][i])
+        {
+            hw.irq_shared[num][i] = handler;
+            return;
+        }
+    }
+    panic("fake_hw: slot handler shared interrupt %u habis", num);
+}
+
+void irq_remove_handler(uint num, irq_handler_t handler)
+{
+    check_irq(num);
+    if (hw.irq_handler[num] == handler)
+    {
+        hw.irq_handler[num] = NULL;
+    }
+    for (uint i = 0; i < MAX_SHARED_IRQ_HANDLERS; ++i)
+    {
+        if (hw.irq_shared[num][i] == handler)
+        {
+            hw.irq_shared[num][i] = NULL;
+        }
+    }
+}
+
+void irq_set_enabled(uint num, bool enabled)
+{
+    check_irq(num);
+    fake_hw_set_irq_enabled(num, enabled);
+}
+
+bool irq_is_enabled(uint num)
+{
+    check_irq(num);
+    return (hw.irq_enabled & (1u << num)) != 0;
+}
+
+void irq_clear(uint int_num)
+{
+    check_irq(int_num);
+    hw.irq_pending &= ~(1u << int_num);
+}
+
+static bool irq_is_pending(void *ctx)
+{
+    (void)ctx;
+    return (hw.irq_pending & hw.irq_enabled) != 0;
+}
+
+static bool event_is_set(void *ctx)
+{
+    (void)ctx;
+    return hw.event_flag;
+}
+
+uint32_t save_and_disable_interrupts(void)
+{
+    uint32_t status = hw.interrupts_disabled ? 1u : 0u;
+    hw.interrupts_disabled = true;
+    return status;
+}
+
+void restore_interrupts(uint32_t status)
+{
+    hw.interrupts_disabled = status != 0;
+    dispatch_irqs();
+}
+
+void restore_interrupts_from_disabled(uint32_t status)
+{
+    restore_interrupts(status);
+}
+
+void __wfi(void)
+{
+    // Bangun oleh interrupt yang pending walaupun interrupt sedang dimatikan
+    fake_hw_run_until(UINT64_MAX, irq_is_pending, NULL);
+    dispatch_irqs();
+}
+
+void __wfe(void)
+{
+    fake_hw_run_until(UINT64_MAX, event_is_set, NULL);
+    hw.event_flag = false;
+    dispatch_irqs();
+}
+
+void __sev(void)
+{
+    hw.event_flag = true;
+}
+
+// -- GPIO --
+
+static bool compute_level(uint gpio)
+{
+    const fake_gpio *g = &hw.gpio[gpio];
+    if (g->function == GPIO_FUNC_PIO0 || g->function == GPIO_FUNC_PIO1)
+    {
+        struct fake_pio_block *block = fake_hw_pio(g->function == GPIO_FUNC_PIO0 ? 0 : 1);
+        if (block->pad_oe & (1u << gpio))
+        {
+            return (block->pad_out >> gpio) & 1u;
+        }
+    }
+    else if (g->function == GPIO_FUNC_SIO && g->sio_oe)
+    {
+        return g->sio_out;
+    }
+    if (g->external >= 0)
+    {
+        return g->external != 0;
+    }
+    if (g->pull_up)
+    {
+        return true;
+    }
+    return false;
+}
+
+static bool apply_inover(uint gpio, bool level)
+{
+    switch (hw.gpio[gpio].inover)
+    {
+    case GPIO_OVERRIDE_INVERT:
+        return !level;
+    case GPIO_OVERRIDE_LOW:
+        return false;
+    case GPIO_OVERRIDE_HIGH:
+        return true;
+    default:
+        return level;
+    }
+}
+
+/**
+ * @brief Menghitung ulang level semua pin, memicu interrupt edge GPIO dan
+ *        memberi tahu listener pin.
+ */
+void fake_hw_pins_changed(void)
+{
+    uint32_t levels = 0;
+    uint32_t inputs = 0;
+    for (uint i = 0; i < FAKE_NUM_GPIOS; ++i)
+    {
+        bool level = compute_level(i);
+        if (level)
+        {
+            levels |= 1u << i;
+        }
+        if (apply_inover(i, level))
+        {
+            inputs |= 1u << i;
+        }
+    }
+    uint32_t changed = levels ^ hw.levels;
+    uint32_t input_changed = inputs ^ hw.inputs;
+    if (!changed && !input_changed)
+    {
+        return;
+    }
+    hw.levels = levels;
+    hw.inputs = inputs;
+    fake_pio_kick(); // State machine yang menunggu pin harus mengevaluasi ulang
+
+    bool raise = false;
+    for (uint i = 0; i < FAKE_NUM_GPIOS; ++i)
+    {
+        if (!(input_changed & (1u << i)))
+        {
+            continue;
+        }
+        fake_gpio *g = &hw.gpio[i];
+        g->level = (inputs >> i) & 1u;
+        uint32_t events = g->level ? GPIO_IRQ_EDGE_RISE : GPIO_IRQ_EDGE_FALL;
+        if (g->irq_mask & events)
+        {
+            g->irq_status |= events;
+            raise = true;
+        }
+    }
+    if (changed && hw.pin_listener)
+    {
+        hw.pin_listener(hw.pin_listener_ctx, cycles_to_ps(hw.cycles), levels, changed);
+    }
+    if (raise)
+    {
+        fake_hw_raise_irq(FAKE_IRQ_IO_BANK0);
+    }
+}
+
+bool fake_hw_gpio_level(uint gpio)
+{
+    return (hw.inputs >> gpio) & 1u;
+}
+
+uint32_t fake_hw_gpio_inputs(void)
+{
+    return hw.inputs;
+}
+
+static void gpio_bank0_irq_handler(void)
+{
+    for (uint i = 0; i < FAKE_NUM_GPIOS; ++i)
+    {
+        uint32_t events = hw.gpio[i].irq_status;
+        if (events)
+        {
+            hw.gpio[i].irq_status = 0;
+            if (hw.gpio_callback)
+            {
+                hw.gpio_callback(i, events);
+            }
+        }
+    }
+}
+
+void fake_hw_gpio_set_input(uint gpio, bool level)
+{
+    hw.gpio[gpio].external = level ? 1 : 0;
+    fake_hw_pins_changed();
+}
+
+void fake_hw_gpio_release_input(uint gpio)
+{
+    hw.gpio[gpio].external = -1;
+    fake_hw_pins_changed();
+}
+
+void fake_hw_gpio_schedule(uint gpio, bool level, uint64_t at_us)
+{
+    schedule_event((scheduled_gpio){.time_ps = at_us * 1000000ull, .gpio = gpio, .level = level});
+}
+
+void fake_hw_gpio_drive_clock(uint gpio, uint64_t start_ps, uint64_t period_fs, uint64_t high_fs)
+{
+    if (period_fs == 0 || high_fs == 0 || high_fs >= period_fs)
+    {
+        panic("fake_hw: parameter clock GPIO tidak valid");
+    }
+    fake_hw_gpio_stop_clock(gpio);
+    schedule_event((scheduled_gpio){.time_ps = start_ps,
+                                    .gpio = gpio,
+                                    .level = true,
+                                    .period_fs = period_fs,
+                                    .high_fs = high_fs,
+                                    .time_fs = start_ps * 1000u});
+}
+
+void fake_hw_gpio_stop_clock(uint gpio)
+{
+    uint kept = 0;
+    for (uint i = 0; i < hw.schedule_count; ++i)
+    {
+        if (hw.schedule[i].gpio != gpio || hw.schedule[i].period_fs == 0)
+        {
+            hw.schedule[kept++] = hw.schedule[i];
+        }
+    }
+    hw.schedule_count = kept;
+}
+
+uint32_t fake_hw_gpio_levels(void)
+{
+    return hw.levels;
+}
+
+void fake_hw_set_pin_listener(fake_hw_pin_listener listener, void *ctx)
+{
+    hw.pin_listener = listener;
+    hw.pin_listener_ctx = ctx;
+}
+
+void gpio_init(uint gpio)
+{
+    fake_hw_cpu_call();
+    hw.gpio[gpio].sio_oe = false;
+    hw.gpio[gpio].sio_out = false;
+    hw.gpio[gpio].function = GPIO_FUNC_SIO;
+    fake_hw_log(FAKE_HW_LOG_REG_WRITE, -1, -1, "GPIO_FUNCSEL", gpio << 8 | GPIO_FUNC_SIO);
+    fake_hw_pins_changed();
+}
+
+void gpio_deinit(uint gpio)
+{
+    gpio_set_function(gpio, GPIO_FUNC_NULL);
+}
+
+void gpio_set_function(uint gpio, enum gpio_function fn)
+{
+    fake_hw_cpu_call();
+    hw.gpio[gpio].function = fn;
+    fake_hw_log(FAKE_HW_LOG_REG_WRITE, -1, -1, "GPIO_FUNCSEL", gpio << 8 | fn);
+    fake_hw_pins_changed();
+}
+
+enum gpio_function gpio_get_function(uint gpio)
+{
+    return hw.gpio[gpio].function;
+}
+
+void gpio_set_dir(uint gpio, bool out)
+{
+    fake_hw_cpu_call();
+    hw.gpio[gpio].sio_oe = out;
+    fake_hw_pins_changed();
+}
+
+bool gpio_get_dir(uint gpio)
+{
+    return hw.gpio[gpio].sio_oe;
+}
+
+void gpio_put(uint gpio, bool value)
+{
+    fake_hw_cpu_call();
+    hw.gpio[gpio].sio_out = value;
+    fake_hw_pins_changed();
+}
+
+bool gpio_get(uint gpio)
+{
+    fake_hw_cpu_call();
+    return (hw.inputs >> gpio) & 1u;
+}
+
+uint32_t gpio_get_all(void)
+{
+    fake_hw_cpu_call();
+    return hw.inputs;
+}
+
+void gpio_set_inover(uint gpio, uint value)
+{
+    fake_hw_cpu_call();
+    hw.gpio[gpio].inover = (uint8_t)value;
+    fake_hw_log(FAKE_HW_LOG_REG_WRITE, -1, -1, "GPIO_INOVER", gpio << 8 | value);
+    fake_hw_pins_changed();
+}
+
+void gpio_set_pulls(uint gpio, bool up, bool down)
+{
+    fake_hw_cpu_call();
+    hw.gpio[gpio].pull_up = up;
+    hw.gpio[gpio].pull_down = down;
+    fake_hw_pins_changed();
+}
+
+void gpio_pull_up(uint gpio)
+{
+    gpio_set_pulls(gpio, true, false);
+}
+
+void gpio_pull_down(uint gpio)
+{
+    gpio_set_pulls(gpio, false, true);
+}
+
+void gpio_disable_pulls(uint gpio)
+{
+    gpio_set_pulls(gpio, false, false);
+}
+
+void gpio_set_irq_enabled(uint gpio, uint32_t event_mask, bool enabled)
+{
+    fake_hw_cpu_call();
+    if (enabled)
+    {
+        hw.gpio[gpio].irq_mask |= event_mask;
+    }
+    else
+    {
+        hw.gpio[gpio].irq_mask &= ~event_mask;
+    }
+}
+
+void gpio_set_irq_callback(gpio_irq_callback_t callback)
+{
+    hw.gpio_callback = callback;
+}
+
+void gpio_set_irq_enabled_with_callback(uint gpio, uint32_t event_mask, bool enabled,
+                                        gpio_irq_callback_t callback)
+{
+    gpio_set_irq_enabled(gpio, event_mask, enabled);
+    gpio_set_irq_callback(callback);
+    if (enabled)
+    {
+        fake_hw_set_irq_enabled(FAKE_IRQ_IO_BANK0, true);
+    }
+}
+
+void gpio_acknowledge_irq(uint gpio, uint32_t event_mask)
+{
+    hw.gpio[gpio].irq_status &= ~event_mask;
+}
+
+// -- Waktu --
+
+uint64_t time_us_64(void)
+{
+    fake_hw_cpu_call();
+    return fake_hw_now_ps() / 1000000ull;
+}
+
+uint32_t time_us_32(void)
+{
+    return (uint32_t)time_us_64();
+}
+
+// -- Timer Alarm --
+
+static void check_alarm(uint alarm_num)
+{
+    if (alarm_num >= NUM_ALARMS)
+    {
+        panic("fake_hw: alarm %u tidak valid", alarm_num);
+    }
+}
+
+static void alarm_irq_handler(void)
+{
+    for (uint i = 0; i < NUM_ALARMS; ++i)
+    {
+        if (hw.alarm_fired & (1u << i))
+        {
+            hw.alarm_fired &= ~(1u << i);
+            if (hw.alarm[i].callback)
+            {
+                hw.alarm[i].callback(i);
+                // IRQ_FORCE adalah register tulis-1-set: tulisan tiap callback
+                // berlaku segera, pada siklus alarm itu sendiri
+                fake_pio_apply_cpu_writes();
+            }
+        }
+    }
+}
+
+void hardware_alarm_claim(uint alarm_num)
+{
+    check_alarm(alarm_num);
+    if (hw.alarm[alarm_num].claimed)
+    {
+        panic("fake_hw: alarm %u sudah diklaim", alarm_num);
+    }
+    hw.alarm[alarm_num].claimed = true;
+}
+
+int hardware_alarm_claim_unused(bool required)
+{
+    // Alarm 3 dipakai pool alarm default pico_time seperti di SDK
+    for (uint i = 0; i < NUM_ALARMS - 1; ++i)
+    {
+        if (!hw.alarm[i].claimed)
+        {
+            hw.alarm[i].claimed = true;
+            return (int)i;
+        }
+    }
+    if (required)
+    {
+        panic("fake_hw: tidak ada alarm bebas");
+    }
+    return -1;
+}
+
+void hardware_alarm_unclaim(uint alarm_num)
+{
+    check_alarm(alarm_num);
+    hw.alarm[alarm_num].claimed = false;
+}
+
+bool hardware_alarm_is_claimed(uint alarm_num)
+{
+    check_alarm(alarm_num);
+    return hw.alarm[alarm_num].claimed;
+}
+
+void hardware_alarm_set_callback(uint alarm_num, hardware_alarm_callback_t callback)
+{
+    check_alarm(alarm_num);
+    fake_hw_cpu_call();
+    hw.alarm[alarm_num].callback = callback;
+    if (!callback)
+    {
+        hw.alarm[alarm_num].armed = false;
+    }
+    fake_hw_set_irq_enabled(TIMER_IRQ_0 + alarm_num, callback != NULL);
+}
+
+bool hardware_alarm_set_target(uint alarm_num, absolute_time_t t)
+{
+    check_alarm(alarm_num);
+    uint64_t now_us = time_us_64();
+    fake_hw_log(FAKE_HW_LOG_REG_WRITE, -1, -1, "TIMER_ALARM", (uint32_t)to_us_since_boot(t));
+    if (to_us_since_boot(t) <= now_us)
+    {
+        hw.alarm[alarm_num].armed = false;
+        return true; // Target terlewat, alarm tidak dipasang
+    }
+    hw.alarm[alarm_num].target_us = to_us_since_boot(t);
+    hw.alarm[alarm_num].armed = true;
+    return false;
+}
+
+void hardware_alarm_cancel(uint alarm_num)
+{
+    check_alarm(alarm_num);
+    fake_hw_cpu_call();
+    hw.alarm[alarm_num].armed = false;
+    hw.alarm_fired &= ~(1u << alarm_num);
+}
+
+void busy_wait_us(uint64_t us)
+{
+    fake_hw_advance_us(us);
+}
+
+void busy_wait_us_32(uint32_t us)
+{
+    fake_hw_advance_us(us);
+}
+
+void busy_wait_at_least_cycles(uint32_t cycles)
+{
+    fake_hw_advance_cycles(cycles);
+}
+
+void sleep_us(uint64_t us)
+{
+    fake_hw_advance_us(us);
+}
+
+void sleep_ms(uint32_t ms)
+{
+    fake_hw_advance_us((uint64_t)ms * 1000);
+}
+
+void sleep_until(absolute_time_t target)
+{
+    uint64_t now = fake_hw_now_ps() / 1000000ull;
+    if (target > now)
+    {
+        fake_hw_advance_us(target - now);
+    }
+}
+
+// -- Clock --
+
+uint32_t clock_get_hz(enum clock_index clk_index)
+{
+    fake_hw_cpu_call();
+    switch (clk_index)
+    {
+    case clk_sys:
+        return hw.sys_clk_hz;
+    case clk_usb:
+    case clk_adc:
+        return USB_CLK_HZ;
+    case clk_peri:
+        return hw.sys_clk_hz;
+    default:
+        return 12000000u;
+    }
+}
+
+uint32_t frequency_count_khz(uint src)
+{
+    (void)src;
+    return hw.sys_clk_hz / 1000;
+}
+
+bool check_sys_clock_khz(uint32_t freq_khz, uint *vco_freq_out, uint *post_div1_out, uint *post_div2_out)
+{
+    // Cari kombinasi VCO/post divider seperti SDK (referensi 12 MHz)
+    for (uint fbdiv = 320; fbdiv >= 16; fbdiv--)
+    {
+        uint vco = fbdiv * 12000;
+        if (vco < 750000 || vco > 1600000)
+        {
+            continue;
+        }
+        for (uint pd1 = 7; pd1 >= 1; pd1--)
+        {
+            for (uint pd2 = pd1; pd2 >= 1; pd2--)
+            {
+                if (vco / (pd1 * pd2) == freq_khz && vco % (pd1 * pd2) == 0)
+                {
+                    if (vco_freq_out)
+                        *vco_freq_out = vco * 1000;
+                    if (post_div1_out)
+                        *post_div1_out = pd1;
+                    if (post_div2_out)
+                        *post_div2_out = pd2;
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+bool set_sys_clock_khz(uint32_t freq_khz, bool required)
+{
+    fake_hw_cpu_call();
+    if (!check_sys_clock_khz(freq_khz, NULL, NULL, NULL))
+    {
+        if (required)
+        {
+            panic("System clock of %u kHz cannot be exactly achieved", freq_khz);
+        }
+        return false;
+    }
+    set_sys_clk_hz(freq_khz * 1000);
+    return true;
+}
+
+void set_sys_clock_48mhz(void)
+{
+    fake_hw_cpu_call();
+    set_sys_clk_hz(USB_CLK_HZ);
+}
+
+/**
+ * @brief Mengeluarkan clock ke pin GPOUT. Clock tidak disimulasikan per
+ *        edge; hanya register dan fungsi pin yang dicatat.
+ */
+void clock_gpio_init(uint gpio, uint src, float div)
+{
+    uint gpout;
+    switch (gpio)
+    {
+    case 21:
+        gpout = 0;
+        break;
+    case 23:
+        gpout = 1;
+        break;
+    case 24:
+        gpout = 2;
+        break;
+    case 25:
+        gpout = 3;
+        break;
+    default:
+        panic("fake_hw: GPIO %u bukan pin GPOUT", gpio);
+    }
+    fake_hw_cpu_call();
+    fake_hw_log(FAKE_HW_LOG_REG_WRITE, -1, -1, "CLK_GPOUT_DIV", gpout << 28 | (uint32_t)(div * 256.0f));
+    fake_hw_log(FAKE_HW_LOG_REG_WRITE, -1, -1, "CLK_GPOUT_CTRL", gpout << 28 | src << 5);
+    gpio_set_function(gpio, GPIO_FUNC_GPCK);
+}
+
+// -- Lain-lain --
+
+void panic(const char *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    fputs("\n*** PANIC ***\n", stderr);
+    vfprintf(stderr, fmt, args);
+    fputc('\n', stderr);
+    va_end(args);
+    exit(1);
+}
+
+void panic_unsupported(void)
+{
+    panic("not supported");
+}
+
+void tight_loop_contents(void)
+{
+    fake_hw_cpu_call();
+}
+
+void hard_assert(bool condition)
+{
+    if (!condition)
+    {
+        panic("hard_assert");
+    }
+}
@@ -0,0 +1,75 @@
+/**
+ * Fake Pico SDK: fungsi internal yang dipakai bersama antar modul fake.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _FAKE_HW_INTERNAL_H
+#define _FAKE_HW_INTERNAL_H
+
+#include "fake_hw.h"
+
+// Nomor interrupt NVIC yang dimodelkan (sama dengan RP2040)
+#define FAKE_IRQ_PIO0_IRQ_0 7
+#define FAKE_IRQ_DMA_IRQ_0 11
+#define FAKE_IRQ_IO_BANK0 13
+#define FAKE_NUM_IRQS 32
+
+// -- Disediakan oleh fake_hw.c --
+void fake_hw_cpu_call(void);
+uint64_t fake_hw_ps_to_cycle(uint64_t ps);
+bool fake_hw_run_until(uint64_t target_cycle, bool (*stop)(void *ctx), void *ctx);
+void fake_hw_log(fake_hw_log_kind kind, int pio, int sm, const char *reg, uint32_t value);
+void fake_hw_pins_changed(void);
+void fake_hw_raise_irq(uint irq);
+void fake_hw_set_irq_handler(uint irq, void (*handler)(void));
+void fake_hw_set_irq_enabled(uint irq, bool enabled);
+bool fake_hw_gpio_level(uint gpio);
+uint32_t fake_hw_gpio_inputs(void);
+
+// -- Disediakan oleh fake_pio.c --
+void fake_pio_reset(void);
+void fake_pio_kick(void);
+void fake_pio_apply_cpu_writes(void);
+bool fake_pio_next_tick(uint64_t *cycle);
+void fake_pio_run_ticks(uint64_t cycle, uint64_t horizon);
+bool fake_pio_all_stalled(void);
+void fake_pio_skip_to(uint64_t cycle);
+bool fake_pio_dreq_active(uint dreq);
+bool fake_pio_dma_write(volatile void *addr, uint32_t value);
+bool fake_pio_dma_read(const volatile void *addr, uint32_t *value);
+
+// -- Disediakan oleh fake_dma.c --
+void fake_dma_reset(void);
+void fake_dma_service(void);
+
+// -- Disediakan oleh fake_i2c.c --
+void fake_i2c_reset(void);
+uint64_t fake_i2c_next_event_ps(void);
+void fake_i2c_service(uint64_t cycle);
+
+// -- Disediakan oleh fake_spi.c --
+void fake_spi_reset(void);
+uint64_t fake_spi_next_event_ps(void);
+void fake_spi_service(uint64_t cycle);
+
+// -- Disediakan oleh fake_stdio.c --
+void fake_stdio_reset(void);
+uint64_t fake_stdio_next_event_ps(void);
+void fake_stdio_service(uint64_t cycle);
+
+// -- Disediakan oleh fake_flash.c --
+void fake_flash_reset(void);
+uint64_t fake_flash_next_event_ps(void);
+void fake_flash_service(uint64_t cycle);
+bool fake_flash_stream_dreq(void);
+bool fake_flash_dma_read(const volatile void *addr, uint32_t *value);
+
+// -- Disediakan oleh fake_adc.c --
+void fake_adc_reset(void);
+uint64_t fake_adc_next_event_ps(void);
+void fake_adc_service(uint64_t cycle);
+bool fake_adc_dreq(void);
+bool fake_adc_dma_read(const volatile void *addr, uint32_t *value);
+
+#endif
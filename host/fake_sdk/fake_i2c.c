@@ -0,0 +1,425 @@
+/**
+ * Fake Pico SDK: controller I2C mode target, library pico_i2c_slave dan
+ * master bus simulasi.
+ *
+ * Master berjalan sebagai event eksternal penjadwal: setiap byte (8 bit data
+ * + ACK) memakan 9 periode bit, START/STOP satu periode bit. Event bus
+ * diteruskan ke controller target pada akhir byte yang bersangkutan:
+ *   START        START_DET
+ *   alamat W     ACK jika alamat cocok, lalu byte data masuk FIFO RX
+ *   alamat R     RD_REQ; master menahan clock sampai slot TX terisi
+ *   byte baca    diambil dari slot TX; RD_REQ lagi jika master meng-ACK
+ *   STOP         STOP_DET
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <string.h>
+
+#include "fake_hw_internal.h"
+#include "hardware/i2c.h"
+#include "pico/i2c_slave.h"
+
+#define DEFAULT_MASTER_BAUDRATE 400000u
+
+i2c_inst_t fake_i2c_inst[NUM_I2CS];
+
+// -- Library pico_i2c_slave --
+static struct
+{
+    i2c_slave_handler_t handler;
+    bool transfer_in_progress;
+} slaves[NUM_I2CS];
+
+// -- Master Simulasi --
+typedef enum
+{
+    MASTER_IDLE = 0,
+    MASTER_START,    // START / repeated START pada time_ps
+    MASTER_ADDRESS,  // Byte alamat selesai pada time_ps
+    MASTER_WRITE,    // Byte tulis selesai pada time_ps
+    MASTER_READ_REQ, // Menunggu slot TX target (clock stretching)
+    MASTER_READ,     // Byte baca selesai pada time_ps
+    MASTER_STOP,     // STOP pada time_ps
+} master_phase;
+
+static struct
+{
+    master_phase phase;
+    uint64_t time_ps;
+    uint32_t baudrate;
+    i2c_inst_t *bus;
+    uint8_t address;
+    const uint8_t *write;
+    size_t write_len;
+    size_t write_pos;
+    uint8_t *read;
+    size_t read_len;
+    size_t read_pos;
+    bool reading; // Arah fase alamat yang sedang berjalan
+    bool acked;
+    uint8_t read_byte;
+} master;
+
+// -- Helper Internal --
+
+static i2c_inst_t *check_i2c(i2c_inst_t *i2c)
+{
+    if (i2c < &fake_i2c_inst[0] || i2c >= &fake_i2c_inst[NUM_I2CS])
+    {
+        panic("fake_i2c: instance tidak valid");
+    }
+    return i2c;
+}
+
+static uint64_t bit_ps(void)
+{
+    return 1000000000000ull / master.baudrate;
+}
+
+/**
+ * @brief Meneruskan status interrupt yang aktif dan tidak di-mask ke NVIC.
+ */
+static void update_irq(i2c_inst_t *i2c)
+{
+    uint32_t status = i2c->raw_intr | (i2c->rx_count > 0 ? I2C_IC_INTR_STAT_R_RX_FULL_BITS : 0u);
+    if (status & i2c->intr_mask)
+    {
+        fake_hw_raise_irq(I2C0_IRQ + i2c->index);
+    }
+}
+
+static bool target_present(void)
+{
+    i2c_inst_t *bus = master.bus;
+    return bus->enabled && bus->slave && bus->address == master.address;
+}
+
+/**
+ * @brief Memproses satu langkah master yang jatuh tempo.
+ */
+static void master_step(void)
+{
+    i2c_inst_t *bus = master.bus;
+    switch (master.phase)
+    {
+    case MASTER_START:
+        if (bus->enabled && bus->slave)
+        {
+            bus->raw_intr |= I2C_IC_INTR_STAT_R_START_DET_BITS;
+            update_irq(bus);
+        }
+        master.phase = MASTER_ADDRESS;
+        master.time_ps += 9 * bit_ps();
+        break;
+
+    case MASTER_ADDRESS:
+        master.acked = target_present();
+        if (!master.acked)
+        {
+            master.phase = MASTER_STOP;
+            master.time_ps += bit_ps();
+        }
+        else if (master.reading)
+        {
+            bus->raw_intr |= I2C_IC_INTR_STAT_R_RD_REQ_BITS;
+            master.phase = MASTER_READ_REQ;
+            update_irq(bus);
+        }
+        else if (master.write_len > 0)
+        {
+            master.phase = MASTER_WRITE;
+            master.time_ps += 9 * bit_ps();
+        }
+        else
+        {
+            master.phase = MASTER_STOP;
+            master.time_ps += bit_ps();
+        }
+        break;
+
+    case MASTER_WRITE:
+        if (bus->rx_count < FAKE_I2C_RX_FIFO_DEPTH)
+        {
+            bus->rx_fifo[(bus->rx_head + bus->rx_count) % FAKE_I2C_RX_FIFO_DEPTH] = master.write[master.write_pos];
+            bus->rx_count++;
+        }
+        else
+        {
+            bus->rx_overflows++;
+        }
+        master.write_pos++;
+        if (master.write_pos < master.write_len)
+        {
+            master.time_ps += 9 * bit_ps();
+        }
+        else if (master.read_len > 0)
+        {
+            master.reading = true;
+            master.phase = MASTER_START;
+            master.time_ps += bit_ps();
+        }
+        else
+        {
+            master.phase = MASTER_STOP;
+            master.time_ps += bit_ps();
+        }
+        update_irq(bus);
+        break;
+
+    case MASTER_READ_REQ:
+        // Clock ditahan target sampai byte tersedia, dicek setiap periode bit
+        if (bus->tx_byte < 0)
+        {
+            master.time_ps += bit_ps();
+            break;
+        }
+        master.read_byte = (uint8_t)bus->tx_byte;
+        bus->tx_byte = -1;
+        master.phase = MASTER_READ;
+        master.time_ps += 9 * bit_ps();
+        break;
+
+    case MASTER_READ:
+        master.read[master.read_pos++] = master.read_byte;
+        if (master.read_pos < master.read_len)
+        {
+            bus->raw_intr |= I2C_IC_INTR_STAT_R_RD_REQ_BITS;
+            master.phase = MASTER_READ_REQ;
+            update_irq(bus);
+        }
+        else
+        {
+            master.phase = MASTER_STOP;
+            master.time_ps += bit_ps();
+        }
+        break;
+
+    case MASTER_STOP:
+        if (bus->enabled && bus->slave)
+        {
+            bus->raw_intr |= I2C_IC_INTR_STAT_R_STOP_DET_BITS;
+            update_irq(bus);
+        }
+        master.phase = MASTER_IDLE;
+        break;
+
+    case MASTER_IDLE:
+        break;
+    }
+}
+
+// -- Antarmuka ke Penjadwal (fake_hw.c) --
+
+static void i2c0_irq_handler(void);
+static void i2c1_irq_handler(void);
+
+void fake_i2c_reset(void)
+{
+    memset(fake_i2c_inst, 0, sizeof(fake_i2c_inst));
+    memset(slaves, 0, sizeof(slaves));
+    memset(&master, 0, sizeof(master));
+    master.baudrate = DEFAULT_MASTER_BAUDRATE;
+    for (uint i = 0; i < NUM_I2CS; ++i)
+    {
+        fake_i2c_inst[i].index = i;
+        fake_i2c_inst[i].tx_byte = -1;
+    }
+    fake_hw_set_irq_handler(I2C0_IRQ, i2c0_irq_handler);
+    fake_hw_set_irq_handler(I2C1_IRQ, i2c1_irq_handler);
+}
+
+uint64_t fake_i2c_next_event_ps(void)
+{
+    return master.phase == MASTER_IDLE ? UINT64_MAX : master.time_ps;
+}
+
+void fake_i2c_service(uint64_t cycle)
+{
+    while (master.phase != MASTER_IDLE && fake_hw_ps_to_cycle(master.time_ps) <= cycle)
+    {
+        master_step();
+    }
+}
+
+// -- API Master (fake_hw.h) --
+
+void fake_hw_i2c_set_master_baudrate(uint32_t hz)
+{
+    if (hz == 0)
+    {
+        panic("fake_i2c: baudrate master nol");
+    }
+    master.baudrate = hz;
+}
+
+bool fake_hw_i2c_master_start(uint i2c_index, uint8_t address, const uint8_t *write, size_t write_len,
+                              uint8_t *read, size_t read_len)
+{
+    if (i2c_index >= NUM_I2CS)
+    {
+        panic("fake_i2c: bus %u tidak valid", i2c_index);
+    }
+    if (master.phase != MASTER_IDLE)
+    {
+        return false;
+    }
+    master.bus = &fake_i2c_inst[i2c_index];
+    master.address = address;
+    master.write = write;
+    master.write_len = write_len;
+    master.write_pos = 0;
+    master.read = read;
+    master.read_len = read_len;
+    master.read_pos = 0;
+    master.reading = write_len == 0 && read_len > 0;
+    master.acked = false;
+    master.phase = MASTER_START;
+    master.time_ps = fake_hw_now_ps();
+    return true;
+}
+
+bool fake_hw_i2c_master_busy(void)
+{
+    return master.phase != MASTER_IDLE;
+}
+
+bool fake_hw_i2c_master_acked(void)
+{
+    return master.acked;
+}
+
+// -- API hardware/i2c.h --
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate)
+{
+    check_i2c(i2c);
+    fake_hw_cpu_call();
+    i2c->enabled = true;
+    i2c->slave = false;
+    i2c->baudrate = baudrate;
+    i2c->rx_head = 0;
+    i2c->rx_count = 0;
+    i2c->tx_byte = -1;
+    i2c->raw_intr = 0;
+    fake_hw_log(FAKE_HW_LOG_REG_WRITE, -1, (int)i2c->index, "I2C_ENABLE", 1);
+    return baudrate;
+}
+
+void i2c_deinit(i2c_inst_t *i2c)
+{
+    check_i2c(i2c);
+    fake_hw_cpu_call();
+    i2c->enabled = false;
+    i2c->slave = false;
+    fake_hw_log(FAKE_HW_LOG_REG_WRITE, -1, (int)i2c->index, "I2C_ENABLE", 0);
+}
+
+void i2c_set_slave_mode(i2c_inst_t *i2c, bool slave, uint8_t addr)
+{
+    check_i2c(i2c);
+    fake_hw_cpu_call();
+    i2c->slave = slave;
+    i2c->address = addr;
+    fake_hw_log(FAKE_HW_LOG_REG_WRITE, -1, (int)i2c->index, "I2C_SAR", addr);
+}
+
+uint i2c_get_index(i2c_inst_t *i2c)
+{
+    return check_i2c(i2c)->index;
+}
+
+size_t i2c_get_read_available(i2c_inst_t *i2c)
+{
+    return check_i2c(i2c)->rx_count;
+}
+
+uint8_t i2c_read_byte_raw(i2c_inst_t *i2c)
+{
+    check_i2c(i2c);
+    if (i2c->rx_count == 0)
+    {
+        return 0;
+    }
+    uint8_t value = i2c->rx_fifo[i2c->rx_head];
+    i2c->rx_head = (i2c->rx_head + 1) % FAKE_I2C_RX_FIFO_DEPTH;
+    i2c->rx_count--;
+    return value;
+}
+
+void i2c_write_byte_raw(i2c_inst_t *i2c, uint8_t value)
+{
+    check_i2c(i2c)->tx_byte = value;
+}
+
+// -- API pico/i2c_slave.h --
+
+static void slave_irq_handler(uint index)
+{
+    i2c_inst_t *i2c = &fake_i2c_inst[index];
+    i2c_slave_handler_t handler = slaves[index].handler;
+    uint32_t status = i2c->raw_intr & i2c->intr_mask;
+    if (!handler)
+    {
+        return;
+    }
+
+    if (status & (I2C_IC_INTR_STAT_R_START_DET_BITS | I2C_IC_INTR_STAT_R_STOP_DET_BITS))
+    {
+        i2c->raw_intr &= ~(I2C_IC_INTR_STAT_R_START_DET_BITS | I2C_IC_INTR_STAT_R_STOP_DET_BITS);
+        if (slaves[index].transfer_in_progress)
+        {
+            handler(i2c, I2C_SLAVE_FINISH);
+            slaves[index].transfer_in_progress = false;
+        }
+    }
+    // RX_FULL mengikuti isi FIFO: handler dipanggil lagi selama masih ada byte
+    while (i2c->rx_count > 0)
+    {
+        uint before = i2c->rx_count;
+        slaves[index].transfer_in_progress = true;
+        handler(i2c, I2C_SLAVE_RECEIVE);
+        if (i2c->rx_count == before)
+        {
+            break;
+        }
+    }
+    if (status & I2C_IC_INTR_STAT_R_RD_REQ_BITS)
+    {
+        i2c->raw_intr &= ~I2C_IC_INTR_STAT_R_RD_REQ_BITS;
+        slaves[index].transfer_in_progress = true;
+        handler(i2c, I2C_SLAVE_REQUEST);
+    }
+}
+
+static void i2c0_irq_handler(void)
+{
+    slave_irq_handler(0);
+}
+
+static void i2c1_irq_handler(void)
+{
+    slave_irq_handler(1);
+}
+
+void i2c_slave_init(i2c_inst_t *i2c, uint8_t address, i2c_slave_handler_t handler)
+{
+    uint index = i2c_get_index(i2c);
+    slaves[index].handler = handler;
+    slaves[index].transfer_in_progress = false;
+    i2c_set_slave_mode(i2c, true, address);
+    i2c->intr_mask = I2C_IC_INTR_STAT_R_RX_FULL_BITS | I2C_IC_INTR_STAT_R_RD_REQ_BITS |
+                     I2C_IC_INTR_STAT_R_TX_ABRT_BITS | I2C_IC_INTR_STAT_R_STOP_DET_BITS |
+                     I2C_IC_INTR_STAT_R_START_DET_BITS;
+    fake_hw_set_irq_enabled(I2C0_IRQ + index, true);
+}
+
+void i2c_slave_deinit(i2c_inst_t *i2c)
+{
+    uint index = i2c_get_index(i2c);
+    fake_hw_set_irq_enabled(I2C0_IRQ + index, false);
+    slaves[index].handler = NULL;
+    slaves[index].transfer_in_progress = false;
+    i2c->intr_mask = 0;
+    i2c_set_slave_mode(i2c, false, 0);
+}
@@ -0,0 +1,1555 @@
+/**
+ * Fake Pico SDK: API hardware/pio.h dan simulator instruksi PIO.
+ *
+ * Setiap state machine mengeksekusi satu instruksi per tick clock divider-nya
+ * dengan semantik RP2040 (stall, delay, side-set, wrap, autopush/autopull,
+ * flag IRQ). Pin output ditulis ke register pad blok PIO lalu diteruskan ke
+ * model GPIO di fake_hw.c.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <string.h>
+
+#include "fake_hw_internal.h"
+#include "hardware/gpio.h"
+
+struct fake_pio_block fake_pio0;
+struct fake_pio_block fake_pio1;
+
+static struct fake_pio_block *const blocks[NUM_PIOS] = {&fake_pio0, &fake_pio1};
+static bool fast_forward = true;
+static fake_hw_sm_listener sm_listener;
+static void *sm_listener_ctx;
+
+// Selama satu siklus PIO diproses, perubahan pin dan jalur IRQ baru
+// diterapkan setelah semua state machine dieksekusi. Seperti hardware, jika
+// beberapa SM menulis pin yang sama pada siklus yang sama, SM bernomor
+// tertinggi yang terlihat, dan handler interrupt melihat pin siklus itu.
+static bool pins_batched;
+static bool pins_dirty;
+static bool irq_lines_dirty;
+
+// -- Helper Internal --
+
+static struct fake_pio_sm *get_sm(PIO pio, uint sm)
+{
+    return &pio->sm[sm];
+}
+
+static uint64_t div_fp(const struct fake_pio_sm *s)
+{
+    uint64_t div_int = s->config.clkdiv_int ? s->config.clkdiv_int : 65536;
+    return (div_int << 8) | s->config.clkdiv_frac;
+}
+
+static uint tx_depth(const struct fake_pio_sm *s)
+{
+    return s->config.fifo_join == PIO_FIFO_JOIN_TX ? 2 * FAKE_PIO_FIFO_DEPTH
+           : s->config.fifo_join == PIO_FIFO_JOIN_RX ? 0
+                                                     : FAKE_PIO_FIFO_DEPTH;
+}
+
+static uint rx_depth(const struct fake_pio_sm *s)
+{
+    return s->config.fifo_join == PIO_FIFO_JOIN_RX ? 2 * FAKE_PIO_FIFO_DEPTH
+           : s->config.fifo_join == PIO_FIFO_JOIN_TX ? 0
+                                                     : FAKE_PIO_FIFO_DEPTH;
+}
+
+static uint32_t tx_pop(struct fake_pio_sm *s)
+{
+    uint32_t v = s->tx_fifo[s->tx_head];
+    s->tx_head = (s->tx_head + 1) % (2 * FAKE_PIO_FIFO_DEPTH);
+    s->tx_level--;
+    return v;
+}
+
+static void rx_push(struct fake_pio_sm *s, uint32_t v)
+{
+    s->rx_fifo[(s->rx_head + s->rx_level) % (2 * FAKE_PIO_FIFO_DEPTH)] = v;
+    s->rx_level++;
+}
+
+#define FDEBUG_RESERVED_BIT (1u << 31)
+
+/**
+ * @brief Menulis flag TXSTALL semua state machine ke register FDEBUG blok.
+ */
+static void publish_fdebug(struct fake_pio_block *b)
+{
+    uint32_t value = FDEBUG_RESERVED_BIT;
+    for (uint i = 0; i < NUM_PIO_STATE_MACHINES; ++i)
+    {
+        if (b->sm[i].tx_stall)
+        {
+            value |= 1u << (PIO_FDEBUG_TXSTALL_LSB + i);
+        }
+    }
+    b->fdebug = value;
+}
+
+/**
+ * @brief Membangunkan semua state machine yang stall agar kondisinya dievaluasi ulang.
+ */
+static void kick_all(void)
+{
+    for (uint p = 0; p < NUM_PIOS; ++p)
+    {
+        for (uint i = 0; i < NUM_PIO_STATE_MACHINES; ++i)
+        {
+            blocks[p]->sm[i].stalled = false;
+        }
+    }
+}
+
+/**
+ * @brief Memberi tahu listener state machine setelah state SM berubah.
+ */
+static void notify_sm(struct fake_pio_block *b, uint smi)
+{
+    if (sm_listener)
+    {
+        sm_listener(sm_listener_ctx, fake_hw_now_ps(), b->index, smi, &b->sm[smi]);
+    }
+}
+
+static void update_irq_lines(struct fake_pio_block *b)
+{
+    if (pins_batched)
+    {
+        irq_lines_dirty = true;
+        return;
+    }
+    for (uint n = 0; n < NUM_PIO_IRQS; ++n)
+    {
+        uint32_t status = (uint32_t)(b->irq_flags & 0xfu) << pis_interrupt0;
+        if (status & b->inte[n])
+        {
+            fake_hw_raise_irq(FAKE_IRQ_PIO0_IRQ_0 + b->index * 2 + n);
+        }
+    }
+}
+
+static void write_pins(struct fake_pio_block *b, uint base, uint count, uint32_t value, bool dirs)
+{
+    for (uint i = 0; i < count; ++i)
+    {
+        uint pin = (base + i) % 32;
+        uint32_t *reg = dirs ? &b->pad_oe : &b->pad_out;
+        if ((value >> i) & 1u)
+        {
+            *reg |= 1u << pin;
+        }
+        else
+        {
+            *reg &= ~(1u << pin);
+        }
+    }
+    if (pins_batched)
+    {
+        pins_dirty = true;
+        return;
+    }
+    fake_hw_pins_changed();
+}
+
+static uint32_t read_pins(uint base)
+{
+    uint32_t levels = fake_hw_gpio_inputs();
+    return (levels >> base) | (base ? levels << (32 - base) : 0);
+}
+
+static uint irq_index(uint sm, uint idx)
+{
+    if (idx & 0x10u)
+    {
+        return (idx & 0x4u) | ((idx + sm) & 0x3u);
+    }
+    return idx & 0x7u;
+}
+
+static uint32_t bit_reverse(uint32_t v)
+{
+    uint32_t r = 0;
+    for (uint i = 0; i < 32; ++i)
+    {
+        r = (r << 1) | ((v >> i) & 1u);
+    }
+    return r;
+}
+
+// -- Eksekusi Instruksi --
+
+typedef enum
+{
+    EXEC_DONE,   // Instruksi selesai, PC maju (dengan wrap)
+    EXEC_JUMPED, // Instruksi selesai, PC sudah diatur
+    EXEC_STALL,  // Instruksi menunggu, diulang pada tick berikutnya
+} exec_result;
+
+static exec_result execute(struct fake_pio_block *b, uint smi, uint16_t instr, bool from_exec, bool *irq_wait_started);
+
+static void apply_sideset(struct fake_pio_block *b, struct fake_pio_sm *s, uint16_t instr)
+{
+    uint bits = s->config.sideset_bits;
+    if (bits == 0)
+    {
+        return;
+    }
+    uint field = (instr >> 8) & 0x1fu;
+    uint value_bits = bits;
+    if (s->config.sideset_optional)
+    {
+        if (!(field & 0x10u))
+        {
+            return;
+        }
+        value_bits = bits - 1;
+    }
+    uint value = (field >> (5 - bits)) & ((1u << value_bits) - 1u);
+    write_pins(b, s->config.sideset_base, value_bits, value, s->config.sideset_pindirs);
+}
+
+static uint delay_of(const struct fake_pio_sm *s, uint16_t instr)
+{
+    uint field = (instr >> 8) & 0x1fu;
+    return field & ((1u << (5 - s->config.sideset_bits)) - 1u);
+}
+
+static uint32_t read_source(struct fake_pio_block *b, struct fake_pio_sm *s, uint src, bool is_mov)
+{
+    (void)b;
+    switch (src)
+    {
+    case 0:
+        return read_pins(s->config.in_base);
+    case 1:
+        return s->x;
+    case 2:
+        return s->y;
+    case 3:
+        return 0;
+    case 5:
+        if (is_mov)
+        {
+            uint level = s->config.mov_status_sel == STATUS_RX_LESSTHAN ? s->rx_level : s->tx_level;
+            return level < s->config.mov_status_n ? 0xffffffffu : 0;
+        }
+        return 0;
+    case 6:
+        return s->isr;
+    case 7:
+        return s->osr;
+    default:
+        return 0;
+    }
+}
+
+static exec_result execute(struct fake_pio_block *b, uint smi, uint16_t instr, bool from_exec, bool *irq_wait_started)
+{
+    struct fake_pio_sm *s = &b->sm[smi];
+    uint op = instr >> 13;
+    uint arg1 = (instr >> 5) & 0x7u;
+    uint arg2 = instr & 0x1fu;
+    (void)from_exec;
+
+    switch (op)
+    {
+    case 0: // JMP
+    {
+        bool take = false;
+        switch (arg1)
+        {
+        case 0:
+            take = true;
+            break;
+        case 1:
+            take = s->x == 0;
+            break;
+        case 2:
+            take = s->x != 0;
+            s->x--;
+            break;
+        case 3:
+            take = s->y == 0;
+            break;
+        case 4:
+            take = s->y != 0;
+            s->y--;
+            break;
+        case 5:
+            take = s->x != s->y;
+            break;
+        case 6:
+            take = fake_hw_gpio_level(s->config.jmp_pin);
+            break;
+        case 7:
+            take = s->osr_count < s->config.pull_threshold;
+            break;
+        }
+        if (take)
+        {
+            s->pc = (uint8_t)arg2;
+            return EXEC_JUMPED;
+        }
+        return EXEC_DONE;
+    }
+    case 1: // WAIT
+    {
+        bool polarity = arg1 & 0x4u;
+        uint source = arg1 & 0x3u;
+        bool level = false;
+        if (source == 0)
+        {
+            level = fake_hw_gpio_level(arg2);
+        }
+        else if (source == 1)
+        {
+            level = fake_hw_gpio_level((s->config.in_base + arg2) % 32);
+        }
+        else if (source == 2)
+        {
+            uint irq = irq_index(smi, arg2);
+            level = (b->irq_seen >> irq) & 1u;
+            if (polarity && level)
+            {
+                b->irq_flags &= ~(1u << irq);
+                kick_all();
+                return EXEC_DONE;
+            }
+        }
+        return level == polarity ? EXEC_DONE : EXEC_STALL;
+    }
+    case 2: // IN
+    {
+        uint n = arg2 ? arg2 : 32;
+        if (s->config.autopush && s->isr_count + n >= s->config.push_threshold &&
+            s->rx_level >= rx_depth(s))
+        {
+            return EXEC_STALL;
+        }
+        uint32_t data = read_source(b, s, arg1, false);
+        uint32_t mask = n == 32 ? 0xffffffffu : ((1u << n) - 1u);
+        data &= mask;
+        if (s->config.in_shift_right)
+        {
+            s->isr = n == 32 ? data : (s->isr >> n) | (data << (32 - n));
+        }
+        else
+        {
+            s->isr = n == 32 ? data : (s->isr << n) | data;
+        }
+        s->isr_count = s->isr_count + n > 32 ? 32 : s->isr_count + n;
+        if (s->config.autopush && s->isr_count >= s->config.push_threshold)
+        {
+            rx_push(s, s->isr);
+            s->isr = 0;
+            s->isr_count = 0;
+        }
+        return EXEC_DONE;
+    }
+    case 3: // OUT
+    {
+        uint n = arg2 ? arg2 : 32;
+        if (s->config.autopull && s->osr_count >= s->config.pull_threshold)
+        {
+            if (s->tx_level == 0)
+            {
+                s->tx_stall = true;
+                publish_fdebug(b);
+                return EXEC_STALL;
+            }
+            s->osr = tx_pop(s);
+            s->osr_count = 0;
+        }
+        uint32_t data;
+        if (s->config.out_shift_right)
+        {
+            data = n == 32 ? s->osr : s->osr & ((1u << n) - 1u);
+            s->osr = n == 32 ? 0 : s->osr >> n;
+        }
+        else
+        {
+            data = n == 32 ? s->osr : s->osr >> (32 - n);
+            s->osr = n == 32 ? 0 : s->osr << n;
+        }
+        s->osr_count = s->osr_count + n > 32 ? 32 : s->osr_count + n;
+        switch (arg1)
+        {
+        case 0:
+            write_pins(b, s->config.out_base, s->config.out_count, data, false);
+            break;
+        case 1:
+            s->x = data;
+            break;
+        case 2:
+            s->y = data;
+            break;
+        case 4:
+            write_pins(b, s->config.out_base, s->config.out_count, data, true);
+            break;
+        case 5:
+            s->pc = (uint8_t)(data & 0x1fu);
+            return EXEC_JUMPED;
+        case 6:
+            s->isr = data;
+            s->isr_count = n;
+            break;
+        case 7:
+            s->has_pending_exec = true;
+            s->pending_exec = (uint16_t)data;
+            break;
+        default:
+            break;
+        }
+        // Autopull mengisi ulang OSR di latar belakang jika data tersedia
+        if (s->config.autopull && s->osr_count >= s->config.pull_threshold && s->tx_level > 0)
+        {
+            s->osr = tx_pop(s);
+            s->osr_count = 0;
+        }
+        return EXEC_DONE;
+    }
+    case 4: // PUSH / PULL
+    {
+        bool if_flag = instr & 0x40u;
+        bool block = instr & 0x20u;
+        if (!(instr & 0x80u))
+        {
+            // PUSH
+            if (if_flag && s->isr_count < s->config.push_threshold)
+            {
+                return EXEC_DONE;
+            }
+            if (s->rx_level >= rx_depth(s))
+            {
+                return block ? EXEC_STALL : EXEC_DONE;
+            }
+            rx_push(s, s->isr);
+            s->isr = 0;
+            s->isr_count = 0;
+            return EXEC_DONE;
+        }
+        // PULL
+        if (if_flag && s->osr_count < s->config.pull_threshold)
+        {
+            return EXEC_DONE;
+        }
+        if (s->tx_level == 0)
+        {
+            if (block)
+            {
+                s->tx_stall = true;
+                publish_fdebug(b);
+                return EXEC_STALL;
+            }
+            s->osr = s->x;
+            s->osr_count = 0;
+            return EXEC_DONE;
+        }
+        s->osr = tx_pop(s);
+        s->osr_count = 0;
+        return EXEC_DONE;
+    }
+    case 5: // MOV
+    {
+        uint mov_op = (instr >> 3) & 0x3u;
+        uint32_t data = read_source(b, s, instr & 0x7u, true);
+        if (mov_op == 1)
+        {
+            data = ~data;
+        }
+        else if (mov_op == 2)
+        {
+            data = bit_reverse(data);
+        }
+        switch (arg1)
+        {
+        case 0:
+            write_pins(b, s->config.out_base, s->config.out_count, data, false);
+            break;
+        case 1:
+            s->x = data;
+            break;
+        case 2:
+            s->y = data;
+            break;
+        case 4:
+            s->has_pending_exec = true;
+            s->pending_exec = (uint16_t)data;
+            break;
+        case 5:
+            s->pc = (uint8_t)(data & 0x1fu);
+            return EXEC_JUMPED;
+        case 6:
+            s->isr = data;
+            s->isr_count = 0;
+            break;
+        case 7:
+            s->osr = data;
+            s->osr_count = 0;
+            break;
+        default:
+            break;
+        }
+        return EXEC_DONE;
+    }
+    case 6: // IRQ
+    {
+        bool clear = instr & 0x40u;
+        bool wait = instr & 0x20u;
+        uint irq = irq_index(smi, arg2);
+        if (clear)
+        {
+            b->irq_flags &= ~(1u << irq);
+            kick_all();
+            return EXEC_DONE;
+        }
+        if (*irq_wait_started)
+        {
+            // Fase kedua `irq wait`: tunggu flag dibersihkan
+            if ((b->irq_seen >> irq) & 1u)
+            {
+                return EXEC_STALL;
+            }
+            *irq_wait_started = false;
+            return EXEC_DONE;
+        }
+        b->irq_flags |= 1u << irq;
+        kick_all();
+        update_irq_lines(b);
+        if (wait)
+        {
+            *irq_wait_started = true;
+            return EXEC_STALL;
+        }
+        return EXEC_DONE;
+    }
+    case 7: // SET
+        switch (arg1)
+        {
+        case 0:
+            write_pins(b, s->config.set_base, s->config.set_count, arg2, false);
+            break;
+        case 1:
+            s->x = arg2;
+            break;
+        case 2:
+            s->y = arg2;
+            break;
+        case 4:
+            write_pins(b, s->config.set_base, s->config.set_count, arg2, true);
+            break;
+        default:
+            break;
+        }
+        return EXEC_DONE;
+    }
+    return EXEC_DONE;
+}
+
+static bool irq_wait_state[NUM_PIOS][NUM_PIO_STATE_MACHINES];
+
+static void advance_pc(struct fake_pio_sm *s)
+{
+    if (s->pc == s->config.wrap)
+    {
+        s->pc = (uint8_t)s->config.wrap_target;
+    }
+    else
+    {
+        s->pc = (uint8_t)((s->pc + 1) % PIO_INSTRUCTION_COUNT);
+    }
+}
+
+/**
+ * @brief Menghitung jumlah tick state machine yang jatuh sebelum siklus horizon.
+ */
+static uint64_t ticks_before(const struct fake_pio_sm *s, uint64_t horizon)
+{
+    const uint64_t max_horizon = UINT64_MAX >> 9;
+    if (horizon > max_horizon)
+    {
+        horizon = max_horizon;
+    }
+    uint64_t horizon_fp = horizon << 8;
+    if (s->next_tick_fp >= horizon_fp)
+    {
+        return 0;
+    }
+    return (horizon_fp - 1 - s->next_tick_fp) / div_fp(s) + 1;
+}
+
+static void sm_tick(struct fake_pio_block *b, uint smi, uint64_t horizon)
+{
+    struct fake_pio_sm *s = &b->sm[smi];
+    s->next_tick_fp += div_fp(s);
+
+    if (s->delay_left > 0)
+    {
+        s->delay_left--;
+        return;
+    }
+
+    bool from_exec = s->has_pending_exec;
+    uint16_t instr = from_exec ? s->pending_exec : b->instr_mem[s->pc];
+    uint instr_pc = s->pc;
+    bool *irq_wait = &irq_wait_state[b->index][smi];
+
+    apply_sideset(b, s, instr);
+    exec_result r = execute(b, smi, instr, from_exec, irq_wait);
+    if (r == EXEC_STALL)
+    {
+        s->stalled = true;
+        return;
+    }
+    s->stalled = false;
+    s->instructions++;
+    if (from_exec && s->pending_exec == instr)
+    {
+        s->has_pending_exec = false;
+    }
+    s->delay_left = delay_of(s, instr);
+    if (r == EXEC_DONE && !from_exec)
+    {
+        advance_pc(s);
+    }
+
+    // Loop `jmp x--`/`jmp y--` ke dirinya sendiri tidak bergantung pada apa pun
+    // di luar state machine, sehingga iterasinya bisa dilompati sekaligus
+    uint cond = (instr >> 5) & 0x7u;
+    if (fast_forward && r == EXEC_JUMPED && !from_exec && (instr >> 13) == 0 &&
+        (cond == 2 || cond == 4) && (instr & 0x1fu) == instr_pc && ((instr >> 8) & 0x1fu) == 0)
+    {
+        uint32_t *reg = cond == 2 ? &s->x : &s->y;
+        uint64_t k = ticks_before(s, horizon);
+        if (k > *reg)
+        {
+            k = *reg;
+        }
+        *reg -= (uint32_t)k;
+        s->next_tick_fp += k * div_fp(s);
+        s->instructions += k;
+    }
+    notify_sm(b, smi);
+}
+
+// -- Antarmuka ke Penjadwal (fake_hw.c) --
+
+void fake_pio_kick(void)
+{
+    kick_all();
+}
+
+void fake_pio_apply_cpu_writes(void)
+{
+    for (uint p = 0; p < NUM_PIOS; ++p)
+    {
+        struct fake_pio_block *b = blocks[p];
+        if (b->irq_force)
+        {
+            fake_hw_log(FAKE_HW_LOG_REG_WRITE, (int)p, -1, "IRQ_FORCE", b->irq_force);
+            b->irq_flags |= (uint8_t)b->irq_force;
+            b->irq_force = 0;
+            kick_all();
+            update_irq_lines(b);
+        }
+        if (!(b->fdebug & FDEBUG_RESERVED_BIT))
+        {
+            // FDEBUG ditulis CPU. State machine yang masih stall pada pull
+            // mengeset TXSTALL lagi saat dievaluasi ulang, seperti hardware
+            fake_hw_log(FAKE_HW_LOG_REG_WRITE, (int)p, -1, "FDEBUG", b->fdebug);
+            for (uint i = 0; i < NUM_PIO_STATE_MACHINES; ++i)
+            {
+                if (b->fdebug & (1u << (PIO_FDEBUG_TXSTALL_LSB + i)))
+                {
+                    b->sm[i].tx_stall = false;
+                }
+            }
+            publish_fdebug(b);
+            kick_all();
+        }
+    }
+}
+
+void fake_pio_reset(void)
+{
+    for (uint p = 0; p < NUM_PIOS; ++p)
+    {
+        memset(blocks[p], 0, sizeof(*blocks[p]));
+        blocks[p]->index = p;
+        for (uint i = 0; i < NUM_PIO_STATE_MACHINES; ++i)
+        {
+            blocks[p]->sm[i].config = pio_get_default_sm_config();
+            blocks[p]->sm[i].osr_count = 32;
+            irq_wait_state[p][i] = false;
+        }
+        publish_fdebug(blocks[p]);
+    }
+    fast_forward = true;
+    pins_batched = false;
+    pins_dirty = false;
+    irq_lines_dirty = false;
+    sm_listener = NULL;
+    sm_listener_ctx = NULL;
+}
+
+bool fake_pio_next_tick(uint64_t *cycle)
+{
+    bool found = false;
+    uint64_t best = UINT64_MAX;
+    for (uint p = 0; p < NUM_PIOS; ++p)
+    {
+        for (uint i = 0; i < NUM_PIO_STATE_MACHINES; ++i)
+        {
+            const struct fake_pio_sm *s = &blocks[p]->sm[i];
+            if (s->enabled && (s->next_tick_fp >> 8) < best)
+            {
+                best = s->next_tick_fp >> 8;
+                found = true;
+            }
+        }
+    }
+    *cycle = best;
+    return found;
+}
+
+void fake_pio_run_ticks(uint64_t cycle, uint64_t horizon)
+{
+    pins_batched = true;
+    for (uint p = 0; p < NUM_PIOS; ++p)
+    {
+        // Seperti hardware, flag IRQ yang diubah satu state machine baru
+        // terlihat oleh state machine lain pada siklus berikutnya
+        struct fake_pio_block *b = blocks[p];
+        b->irq_seen = b->irq_flags;
+        for (uint i = 0; i < NUM_PIO_STATE_MACHINES; ++i)
+        {
+            struct fake_pio_sm *s = &b->sm[i];
+            while (s->enabled && (s->next_tick_fp >> 8) <= cycle)
+            {
+                sm_tick(b, i, horizon);
+            }
+        }
+        if (b->irq_flags != b->irq_seen)
+        {
+            kick_all();
+        }
+    }
+    pins_batched = false;
+    if (pins_dirty)
+    {
+        pins_dirty = false;
+        fake_hw_pins_changed();
+    }
+    if (irq_lines_dirty)
+    {
+        irq_lines_dirty = false;
+        for (uint p = 0; p < NUM_PIOS; ++p)
+        {
+            update_irq_lines(blocks[p]);
+        }
+    }
+}
+
+bool fake_pio_all_stalled(void)
+{
+    for (uint p = 0; p < NUM_PIOS; ++p)
+    {
+        for (uint i = 0; i < NUM_PIO_STATE_MACHINES; ++i)
+        {
+            const struct fake_pio_sm *s = &blocks[p]->sm[i];
+            if (s->enabled && (!s->stalled || s->delay_left > 0))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void fake_pio_skip_to(uint64_t cycle)
+{
+    uint64_t target_fp = (cycle > (UINT64_MAX >> 9) ? (UINT64_MAX >> 9) : cycle) << 8;
+    for (uint p = 0; p < NUM_PIOS; ++p)
+    {
+        for (uint i = 0; i < NUM_PIO_STATE_MACHINES; ++i)
+        {
+            struct fake_pio_sm *s = &blocks[p]->sm[i];
+            if (s->enabled && s->next_tick_fp < target_fp)
+            {
+                uint64_t d = div_fp(s);
+                s->next_tick_fp += (target_fp - s->next_tick_fp + d - 1) / d * d;
+            }
+        }
+    }
+}
+
+// -- Antarmuka ke DMA (fake_dma.c) --
+
+/**
+ * @brief Status DREQ PIO: TX aktif selama FIFO TX belum penuh, RX aktif
+ *        selama FIFO RX tidak kosong.
+ */
+bool fake_pio_dreq_active(uint dreq)
+{
+    uint p = dreq / 8;
+    uint smi = dreq % 8;
+    if (p >= NUM_PIOS)
+    {
+        return false;
+    }
+    if (smi < NUM_PIO_STATE_MACHINES)
+    {
+        const struct fake_pio_sm *s = &blocks[p]->sm[smi];
+        return s->tx_level < tx_depth(s);
+    }
+    return blocks[p]->sm[smi - NUM_PIO_STATE_MACHINES].rx_level > 0;
+}
+
+/**
+ * @brief Menulis word DMA ke register TXF.
+ *
+ * @return false jika addr bukan alamat TXF salah satu blok PIO
+ */
+bool fake_pio_dma_write(volatile void *addr, uint32_t value)
+{
+    for (uint p = 0; p < NUM_PIOS; ++p)
+    {
+        struct fake_pio_block *b = blocks[p];
+        if ((volatile uint32_t *)addr >= b->txf && (volatile uint32_t *)addr < b->txf + NUM_PIO_STATE_MACHINES)
+        {
+            uint smi = (uint)((volatile uint32_t *)addr - b->txf);
+            struct fake_pio_sm *s = &b->sm[smi];
+            if (s->tx_level < tx_depth(s))
+            {
+                s->tx_fifo[(s->tx_head + s->tx_level) % (2 * FAKE_PIO_FIFO_DEPTH)] = value;
+                s->tx_level++;
+                s->stalled = false;
+                notify_sm(b, smi);
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Membaca word DMA dari register RXF.
+ *
+ * @return false jika addr bukan alamat RXF salah satu blok PIO
+ */
+bool fake_pio_dma_read(const volatile void *addr, uint32_t *value)
+{
+    for (uint p = 0; p < NUM_PIOS; ++p)
+    {
+        struct fake_pio_block *b = blocks[p];
+        if ((const volatile uint32_t *)addr >= b->rxf &&
+            (const volatile uint32_t *)addr < b->rxf + NUM_PIO_STATE_MACHINES)
+        {
+            uint smi = (uint)((const volatile uint32_t *)addr - b->rxf);
+            struct fake_pio_sm *s = &b->sm[smi];
+            *value = 0;
+            if (s->rx_level > 0)
+            {
+                *value = s->rx_fifo[s->rx_head];
+                s->rx_head = (s->rx_head + 1) % (2 * FAKE_PIO_FIFO_DEPTH);
+                s->rx_level--;
+                s->stalled = false;
+                notify_sm(b, smi);
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+struct fake_pio_block *fake_hw_pio(uint index)
+{
+    return blocks[index];
+}
+
+void fake_hw_set_fast_forward(bool enabled)
+{
+    fast_forward = enabled;
+}
+
+void fake_hw_set_sm_listener(fake_hw_sm_listener listener, void *ctx)
+{
+    sm_listener = listener;
+    sm_listener_ctx = ctx;
+}
+
+// -- Konfigurasi State Machine --
+
+pio_sm_config pio_get_default_sm_config(void)
+{
+    pio_sm_config c;
+    memset(&c, 0, sizeof(c));
+    c.clkdiv_int = 1;
+    c.wrap_target = 0;
+    c.wrap = 31;
+    c.in_shift_right = true;
+    c.push_threshold = 32;
+    c.out_shift_right = true;
+    c.pull_threshold = 32;
+    return c;
+}
+
+void sm_config_set_out_pins(pio_sm_config *c, uint out_base, uint out_count)
+{
+    c->out_base = out_base;
+    c->out_count = out_count;
+}
+
+void sm_config_set_set_pins(pio_sm_config *c, uint set_base, uint set_count)
+{
+    c->set_base = set_base;
+    c->set_count = set_count;
+}
+
+void sm_config_set_in_pins(pio_sm_config *c, uint in_base)
+{
+    c->in_base = in_base;
+}
+
+void sm_config_set_sideset_pins(pio_sm_config *c, uint sideset_base)
+{
+    c->sideset_base = sideset_base;
+}
+
+void sm_config_set_sideset(pio_sm_config *c, uint bit_count, bool optional, bool pindirs)
+{
+    c->sideset_bits = bit_count;
+    c->sideset_optional = optional;
+    c->sideset_pindirs = pindirs;
+}
+
+void sm_config_set_clkdiv_int_frac8(pio_sm_config *c, uint32_t div_int, uint8_t div_frac8)
+{
+    c->clkdiv_int = div_int;
+    c->clkdiv_frac = div_int == 0 ? 0 : div_frac8;
+}
+
+void sm_config_set_clkdiv_int_frac(pio_sm_config *c, uint16_t div_int, uint8_t div_frac)
+{
+    sm_config_set_clkdiv_int_frac8(c, div_int, div_frac);
+}
+
+void sm_config_set_clkdiv(pio_sm_config *c, float div)
+{
+    // Pembulatan sama dengan pio_calculate_clkdiv_from_float() di SDK
+    uint32_t div_int = (uint32_t)div;
+    uint8_t div_frac = div_int == 0 ? 0 : (uint8_t)((div - (float)div_int) * 256.0f);
+    sm_config_set_clkdiv_int_frac8(c, div_int, div_frac);
+}
+
+void sm_config_set_wrap(pio_sm_config *c, uint wrap_target, uint wrap)
+{
+    c->wrap_target = wrap_target;
+    c->wrap = wrap;
+}
+
+void sm_config_set_jmp_pin(pio_sm_config *c, uint pin)
+{
+    c->jmp_pin = pin;
+}
+
+void sm_config_set_in_shift(pio_sm_config *c, bool shift_right, bool autopush, uint push_threshold)
+{
+    c->in_shift_right = shift_right;
+    c->autopush = autopush;
+    c->push_threshold = push_threshold ? push_threshold : 32;
+}
+
+void sm_config_set_out_shift(pio_sm_config *c, bool shift_right, bool autopull, uint pull_threshold)
+{
+    c->out_shift_right = shift_right;
+    c->autopull = autopull;
+    c->pull_threshold = pull_threshold ? pull_threshold : 32;
+}
+
+void sm_config_set_fifo_join(pio_sm_config *c, enum pio_fifo_join join)
+{
+    c->fifo_join = join;
+}
+
+void sm_config_set_out_special(pio_sm_config *c, bool sticky, bool has_enable_pin, uint enable_pin_index)
+{
+    c->out_sticky = sticky;
+    c->inline_out_en = has_enable_pin;
+    c->out_en_sel = enable_pin_index;
+}
+
+void sm_config_set_mov_status(pio_sm_config *c, enum pio_mov_status_type status_sel, uint status_n)
+{
+    c->mov_status_sel = status_sel;
+    c->mov_status_n = status_n;
+}
+
+// -- Program dan State Machine --
+
+uint pio_get_index(PIO pio)
+{
+    return pio->index;
+}
+
+uint pio_get_dreq(PIO pio, uint sm, bool is_tx)
+{
+    return pio->index * 8 + (is_tx ? sm : sm + 4);
+}
+
+static int find_offset_for_program(PIO pio, const pio_program_t *program)
+{
+    uint32_t program_mask = (1u << program->length) - 1;
+    if (program->origin >= 0)
+    {
+        if (program->origin > 32 - program->length)
+        {
+            return -1;
+        }
+        return (pio->used_instruction_mask & (program_mask << program->origin)) ? -1 : program->origin;
+    }
+    for (int i = 32 - program->length; i >= 0; i--)
+    {
+        if (!(pio->used_instruction_mask & (program_mask << (uint)i)))
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool pio_can_add_program(PIO pio, const pio_program_t *program)
+{
+    return find_offset_for_program(pio, program) >= 0;
+}
+
+bool pio_can_add_program_at_offset(PIO pio, const pio_program_t *program, uint offset)
+{
+    uint32_t program_mask = (1u << program->length) - 1;
+    if (program->origin >= 0 && (uint)program->origin != offset)
+    {
+        return false;
+    }
+    return offset + program->length <= 32 && !(pio->used_instruction_mask & (program_mask << offset));
+}
+
+int pio_add_program_at_offset(PIO pio, const pio_program_t *program, uint offset)
+{
+    fake_hw_cpu_call();
+    if (!pio_can_add_program_at_offset(pio, program, offset))
+    {
+        return -1;
+    }
+    for (uint i = 0; i < program->length; ++i)
+    {
+        uint16_t instr = program->instructions[i];
+        // Alamat jmp direlokasi sesuai offset
+        pio->instr_mem[offset + i] = _pio_major_instr_bits(instr) ? instr : (uint16_t)(instr + offset);
+        fake_hw_log(FAKE_HW_LOG_REG_WRITE, (int)pio->index, -1, "INSTR_MEM", pio->instr_mem[offset + i]);
+    }
+    pio->used_instruction_mask |= ((1u << program->length) - 1) << offset;
+    return (int)offset;
+}
+
+int pio_add_program(PIO pio, const pio_program_t *program)
+{
+    int offset = find_offset_for_program(pio, program);
+    if (offset < 0)
+    {
+        return -1;
+    }
+    return pio_add_program_at_offset(pio, program, (uint)offset);
+}
+
+void pio_remove_program(PIO pio, const pio_program_t *program, uint loaded_offset)
+{
+    pio->used_instruction_mask &= ~(((1u << program->length) - 1) << loaded_offset);
+}
+
+void pio_clear_instruction_memory(PIO pio)
+{
+    memset(pio->instr_mem, 0, sizeof(pio->instr_mem));
+    pio->used_instruction_mask = 0;
+}
+
+void pio_sm_claim(PIO pio, uint sm)
+{
+    if (pio->claimed_sm_mask & (1u << sm))
+    {
+        panic("PIO %u SM %u already claimed", pio->index, sm);
+    }
+    pio->claimed_sm_mask |= 1u << sm;
+}
+
+void pio_claim_sm_mask(PIO pio, uint sm_mask)
+{
+    for (uint i = 0; i < NUM_PIO_STATE_MACHINES; ++i)
+    {
+        if (sm_mask & (1u << i))
+        {
+            pio_sm_claim(pio, i);
+        }
+    }
+}
+
+void pio_sm_unclaim(PIO pio, uint sm)
+{
+    pio->claimed_sm_mask &= ~(1u << sm);
+}
+
+int pio_claim_unused_sm(PIO pio, bool required)
+{
+    for (uint i = 0; i < NUM_PIO_STATE_MACHINES; ++i)
+    {
+        if (!(pio->claimed_sm_mask & (1u << i)))
+        {
+            pio->claimed_sm_mask |= 1u << i;
+            return (int)i;
+        }
+    }
+    if (required)
+    {
+        panic("No PIO state machines are available");
+    }
+    return -1;
+}
+
+bool pio_sm_is_claimed(PIO pio, uint sm)
+{
+    return (pio->claimed_sm_mask >> sm) & 1u;
+}
+
+int pio_sm_set_config(PIO pio, uint sm, const pio_sm_config *config)
+{
+    fake_hw_cpu_call();
+    get_sm(pio, sm)->config = *config;
+    fake_hw_log(FAKE_HW_LOG_REG_WRITE, (int)pio->index, (int)sm, "SM_CLKDIV",
+                config->clkdiv_int << 16 | (uint32_t)config->clkdiv_frac << 8);
+    fake_hw_log(FAKE_HW_LOG_REG_WRITE, (int)pio->index, (int)sm, "SM_EXECCTRL",
+                config->wrap << 12 | config->wrap_target << 7 | config->jmp_pin << 24);
+    fake_hw_log(FAKE_HW_LOG_REG_WRITE, (int)pio->index, (int)sm, "SM_PINCTRL",
+                config->set_count << 26 | config->out_count << 20 | config->in_base << 15 |
+                    config->sideset_base << 10 | config->set_base << 5 | config->out_base);
+    return 0;
+}
+
+int pio_sm_init(PIO pio, uint sm, uint initial_pc, const pio_sm_config *config)
+{
+    pio_sm_set_enabled(pio, sm, false);
+    pio_sm_set_config(pio, sm, config);
+    pio_sm_clear_fifos(pio, sm);
+    get_sm(pio, sm)->tx_stall = false;
+    publish_fdebug(pio);
+    pio_sm_restart(pio, sm);
+    pio_sm_clkdiv_restart(pio, sm);
+    pio_sm_exec(pio, sm, pio_encode_jmp(initial_pc));
+    return 0;
+}
+
+void pio_gpio_init(PIO pio, uint pin)
+{
+    gpio_set_function(pin, pio->index == 0 ? GPIO_FUNC_PIO0 : GPIO_FUNC_PIO1);
+}
+
+int pio_sm_set_consecutive_pindirs(PIO pio, uint sm, uint pins_base, uint pin_count, bool is_out)
+{
+    (void)sm;
+    fake_hw_cpu_call();
+    write_pins(pio, pins_base, pin_count, is_out ? 0xffffffffu : 0, true);
+    fake_hw_log(FAKE_HW_LOG_REG_WRITE, (int)pio->index, (int)sm, "PINDIRS", pio->pad_oe);
+    return 0;
+}
+
+void pio_sm_set_pins(PIO pio, uint sm, uint32_t pin_values)
+{
+    (void)sm;
+    fake_hw_cpu_call();
+    write_pins(pio, 0, 32, pin_values, false);
+}
+
+void pio_sm_set_pins_with_mask(PIO pio, uint sm, uint32_t pin_values, uint32_t pin_mask)
+{
+    (void)sm;
+    fake_hw_cpu_call();
+    pio->pad_out = (pio->pad_out & ~pin_mask) | (pin_values & pin_mask);
+    fake_hw_pins_changed();
+}
+
+void pio_sm_set_pindirs_with_mask(PIO pio, uint sm, uint32_t pin_dirs, uint32_t pin_mask)
+{
+    (void)sm;
+    fake_hw_cpu_call();
+    pio->pad_oe = (pio->pad_oe & ~pin_mask) | (pin_dirs & pin_mask);
+    fake_hw_pins_changed();
+}
+
+static void set_enabled(PIO pio, uint sm, bool enabled)
+{
+    struct fake_pio_sm *s = get_sm(pio, sm);
+    if (enabled && !s->enabled)
+    {
+        // Clock divider berjalan terus walaupun SM berhenti: pertahankan fasenya
+        uint64_t first_fp = (fake_hw_sys_cycles() + 1) << 8;
+        if (s->next_tick_fp < first_fp)
+        {
+            uint64_t d = div_fp(s);
+            s->next_tick_fp += (first_fp - s->next_tick_fp + d - 1) / d * d;
+        }
+    }
+    s->enabled = enabled;
+    s->stalled = false;
+}
+
+static uint32_t enabled_mask(PIO pio)
+{
+    uint32_t mask = 0;
+    for (uint i = 0; i < NUM_PIO_STATE_MACHINES; ++i)
+    {
+        if (pio->sm[i].enabled)
+        {
+            mask |= 1u << i;
+        }
+    }
+    return mask;
+}
+
+void pio_sm_set_enabled(PIO pio, uint sm, bool enabled)
+{
+    fake_hw_cpu_call();
+    set_enabled(pio, sm, enabled);
+    fake_hw_log(FAKE_HW_LOG_REG_WRITE, (int)pio->index, -1, "CTRL", enabled_mask(pio));
+}
+
+void pio_set_sm_mask_enabled(PIO pio, uint32_t mask, bool enabled)
+{
+    fake_hw_cpu_call();
+    for (uint i = 0; i < NUM_PIO_STATE_MACHINES; ++i)
+    {
+        if (mask & (1u << i))
+        {
+            set_enabled(pio, i, enabled);
+        }
+    }
+    fake_hw_log(FAKE_HW_LOG_REG_WRITE, (int)pio->index, -1, "CTRL", enabled_mask(pio));
+}
+
+void pio_sm_restart(PIO pio, uint sm)
+{
+    fake_hw_cpu_call();
+    struct fake_pio_sm *s = get_sm(pio, sm);
+    s->isr = 0;
+    s->isr_count = 0;
+    s->osr_count = 32;
+    s->delay_left = 0;
+    s->has_pending_exec = false;
+    s->stalled = false;
+    irq_wait_state[pio->index][sm] = false;
+    fake_hw_log(FAKE_HW_LOG_REG_WRITE, (int)pio->index, (int)sm, "CTRL_SM_RESTART", 1u << sm);
+}
+
+void pio_restart_sm_mask(PIO pio, uint32_t mask)
+{
+    for (uint i = 0; i < NUM_PIO_STATE_MACHINES; ++i)
+    {
+        if (mask & (1u << i))
+        {
+            pio_sm_restart(pio, i);
+        }
+    }
+}
+
+void pio_clkdiv_restart_sm_mask(PIO pio, uint32_t mask)
+{
+    fake_hw_cpu_call();
+    for (uint i = 0; i < NUM_PIO_STATE_MACHINES; ++i)
+    {
+        if (mask & (1u << i))
+        {
+            pio->sm[i].next_tick_fp = (fake_hw_sys_cycles() + 1) << 8;
+        }
+    }
+    fake_hw_log(FAKE_HW_LOG_REG_WRITE, (int)pio->index, -1, "CTRL_CLKDIV_RESTART", mask);
+}
+
+void pio_sm_clkdiv_restart(PIO pio, uint sm)
+{
+    pio_clkdiv_restart_sm_mask(pio, 1u << sm);
+}
+
+void pio_enable_sm_mask_in_sync(PIO pio, uint32_t mask)
+{
+    pio_clkdiv_restart_sm_mask(pio, mask);
+    for (uint i = 0; i < NUM_PIO_STATE_MACHINES; ++i)
+    {
+        if (mask & (1u << i))
+        {
+            set_enabled(pio, i, true);
+        }
+    }
+    fake_hw_log(FAKE_HW_LOG_REG_WRITE, (int)pio->index, -1, "CTRL", enabled_mask(pio));
+}
+
+uint8_t pio_sm_get_pc(PIO pio, uint sm)
+{
+    fake_hw_cpu_call();
+    return get_sm(pio, sm)->pc;
+}
+
+void pio_sm_exec(PIO pio, uint sm, uint instr)
+{
+    fake_hw_cpu_call();
+    fake_hw_log(FAKE_HW_LOG_REG_WRITE, (int)pio->index, (int)sm, "SM_INSTR", instr);
+    struct fake_pio_sm *s = get_sm(pio, sm);
+    bool *irq_wait = &irq_wait_state[pio->index][sm];
+    // Instruksi dari SMx_INSTR langsung dieksekusi; delay diabaikan
+    apply_sideset(pio, s, (uint16_t)instr);
+    pio->irq_seen = pio->irq_flags;
+    exec_result r = execute(pio, sm, (uint16_t)instr, true, irq_wait);
+    if (r == EXEC_STALL)
+    {
+        s->has_pending_exec = true;
+        s->pending_exec = (uint16_t)instr;
+    }
+    kick_all();
+    notify_sm(pio, sm);
+}
+
+bool pio_sm_is_exec_stalled(PIO pio, uint sm)
+{
+    return get_sm(pio, sm)->has_pending_exec;
+}
+
+static bool exec_not_stalled(void *ctx)
+{
+    return !((struct fake_pio_sm *)ctx)->has_pending_exec;
+}
+
+void pio_sm_exec_wait_blocking(PIO pio, uint sm, uint instr)
+{
+    pio_sm_exec(pio, sm, instr);
+    fake_hw_run_until(UINT64_MAX, exec_not_stalled, get_sm(pio, sm));
+}
+
+void pio_sm_set_wrap(PIO pio, uint sm, uint wrap_target, uint wrap)
+{
+    fake_hw_cpu_call();
+    sm_config_set_wrap(&get_sm(pio, sm)->config, wrap_target, wrap);
+    fake_hw_log(FAKE_HW_LOG_REG_WRITE, (int)pio->index, (int)sm, "SM_EXECCTRL", wrap << 12 | wrap_target << 7);
+}
+
+void pio_sm_set_out_pins(PIO pio, uint sm, uint out_base, uint out_count)
+{
+    fake_hw_cpu_call();
+    sm_config_set_out_pins(&get_sm(pio, sm)->config, out_base, out_count);
+}
+
+void pio_sm_set_set_pins(PIO pio, uint sm, uint set_base, uint set_count)
+{
+    fake_hw_cpu_call();
+    sm_config_set_set_pins(&get_sm(pio, sm)->config, set_base, set_count);
+}
+
+void pio_sm_set_in_pins(PIO pio, uint sm, uint in_base)
+{
+    fake_hw_cpu_call();
+    sm_config_set_in_pins(&get_sm(pio, sm)->config, in_base);
+}
+
+void pio_sm_set_sideset_pins(PIO pio, uint sm, uint sideset_base)
+{
+    fake_hw_cpu_call();
+    sm_config_set_sideset_pins(&get_sm(pio, sm)->config, sideset_base);
+}
+
+void pio_sm_set_jmp_pin(PIO pio, uint sm, uint pin)
+{
+    fake_hw_cpu_call();
+    sm_config_set_jmp_pin(&get_sm(pio, sm)->config, pin);
+}
+
+void pio_sm_set_clkdiv_int_frac8(PIO pio, uint sm, uint32_t div_int, uint8_t div_frac8)
+{
+    fake_hw_cpu_call();
+    sm_config_set_clkdiv_int_frac8(&get_sm(pio, sm)->config, div_int, div_frac8);
+    fake_hw_log(FAKE_HW_LOG_REG_WRITE, (int)pio->index, (int)sm, "SM_CLKDIV",
+                div_int << 16 | (uint32_t)div_frac8 << 8);
+}
+
+void pio_sm_set_clkdiv_int_frac(PIO pio, uint sm, uint16_t div_int, uint8_t div_frac)
+{
+    pio_sm_set_clkdiv_int_frac8(pio, sm, div_int, div_frac);
+}
+
+void pio_sm_set_clkdiv(PIO pio, uint sm, float div)
+{
+    pio_sm_config c = pio_get_default_sm_config();
+    sm_config_set_clkdiv(&c, div);
+    pio_sm_set_clkdiv_int_frac8(pio, sm, c.clkdiv_int, c.clkdiv_frac);
+}
+
+// -- FIFO --
+
+void pio_sm_put(PIO pio, uint sm, uint32_t data)
+{
+    fake_hw_cpu_call();
+    struct fake_pio_sm *s = get_sm(pio, sm);
+    fake_hw_log(FAKE_HW_LOG_FIFO_PUSH, (int)pio->index, (int)sm, "TXF", data);
+    if (s->tx_level >= tx_depth(s))
+    {
+        return; // Menulis ke FIFO penuh tidak berpengaruh (hardware men-set TXOVER)
+    }
+    s->tx_fifo[(s->tx_head + s->tx_level) % (2 * FAKE_PIO_FIFO_DEPTH)] = data;
+    s->tx_level++;
+    s->stalled = false;
+    notify_sm(pio, sm);
+}
+
+uint32_t pio_sm_get(PIO pio, uint sm)
+{
+    fake_hw_cpu_call();
+    struct fake_pio_sm *s = get_sm(pio, sm);
+    if (s->rx_level == 0)
+    {
+        return 0;
+    }
+    uint32_t v = s->rx_fifo[s->rx_head];
+    s->rx_head = (s->rx_head + 1) % (2 * FAKE_PIO_FIFO_DEPTH);
+    s->rx_level--;
+    s->stalled = false;
+    fake_hw_log(FAKE_HW_LOG_FIFO_PULL, (int)pio->index, (int)sm, "RXF", v);
+    notify_sm(pio, sm);
+    return v;
+}
+
+static bool tx_not_full(void *ctx)
+{
+    struct fake_pio_sm *s = ctx;
+    return s->tx_level < tx_depth(s);
+}
+
+static bool rx_not_empty(void *ctx)
+{
+    return ((struct fake_pio_sm *)ctx)->rx_level > 0;
+}
+
+void pio_sm_put_blocking(PIO pio, uint sm, uint32_t data)
+{
+    fake_hw_run_until(UINT64_MAX, tx_not_full, get_sm(pio, sm));
+    pio_sm_put(pio, sm, data);
+}
+
+uint32_t pio_sm_get_blocking(PIO pio, uint sm)
+{
+    fake_hw_run_until(UINT64_MAX, rx_not_empty, get_sm(pio, sm));
+    return pio_sm_get(pio, sm);
+}
+
+bool pio_sm_is_rx_fifo_full(PIO pio, uint sm)
+{
+    fake_hw_cpu_call();
+    return get_sm(pio, sm)->rx_level >= rx_depth(get_sm(pio, sm));
+}
+
+bool pio_sm_is_rx_fifo_empty(PIO pio, uint sm)
+{
+    fake_hw_cpu_call();
+    return get_sm(pio, sm)->rx_level == 0;
+}
+
+uint pio_sm_get_rx_fifo_level(PIO pio, uint sm)
+{
+    fake_hw_cpu_call();
+    return get_sm(pio, sm)->rx_level;
+}
+
+bool pio_sm_is_tx_fifo_full(PIO pio, uint sm)
+{
+    fake_hw_cpu_call();
+    return get_sm(pio, sm)->tx_level >= tx_depth(get_sm(pio, sm));
+}
+
+bool pio_sm_is_tx_fifo_empty(PIO pio, uint sm)
+{
+    fake_hw_cpu_call();
+    return get_sm(pio, sm)->tx_level == 0;
+}
+
+uint pio_sm_get_tx_fifo_level(PIO pio, uint sm)
+{
+    fake_hw_cpu_call();
+    return get_sm(pio, sm)->tx_level;
+}
+
+void pio_sm_drain_tx_fifo(PIO pio, uint sm)
+{
+    fake_hw_cpu_call();
+    struct fake_pio_sm *s = get_sm(pio, sm);
+    while (s->tx_level > 0)
+    {
+        s->osr = tx_pop(s);
+        s->osr_count = 0;
+    }
+    notify_sm(pio, sm);
+}
+
+void pio_sm_clear_fifos(PIO pio, uint sm)
+{
+    fake_hw_cpu_call();
+    struct fake_pio_sm *s = get_sm(pio, sm);
+    s->tx_level = 0;
+    s->tx_head = 0;
+    s->rx_level = 0;
+    s->rx_head = 0;
+    fake_hw_log(FAKE_HW_LOG_REG_WRITE, (int)pio->index, (int)sm, "SM_SHIFTCTRL_FJOIN_TOGGLE", 0);
+    notify_sm(pio, sm);
+}
+
+// -- IRQ --
+
+bool pio_interrupt_get(PIO pio, uint pio_interrupt_num)
+{
+    fake_hw_cpu_call();
+    return (pio->irq_flags >> pio_interrupt_num) & 1u;
+}
+
+void pio_interrupt_clear(PIO pio, uint pio_interrupt_num)
+{
+    fake_hw_cpu_call();
+    pio->irq_flags &= ~(1u << pio_interrupt_num);
+    fake_hw_log(FAKE_HW_LOG_REG_WRITE, (int)pio->index, -1, "IRQ", 1u << pio_interrupt_num);
+    kick_all();
+}
+
+void pio_set_irqn_source_enabled(PIO pio, uint irq_index, enum pio_interrupt_source source, bool enabled)
+{
+    fake_hw_cpu_call();
+    if (enabled)
+    {
+        pio->inte[irq_index] |= 1u << source;
+    }
+    else
+    {
+        pio->inte[irq_index] &= ~(1u << source);
+    }
+    fake_hw_log(FAKE_HW_LOG_REG_WRITE, (int)pio->index, -1, irq_index ? "IRQ1_INTE" : "IRQ0_INTE",
+                pio->inte[irq_index]);
+    update_irq_lines(pio);
+}
+
+void pio_set_irq0_source_enabled(PIO pio, enum pio_interrupt_source source, bool enabled)
+{
+    pio_set_irqn_source_enabled(pio, 0, source, enabled);
+}
+
+void pio_set_irq1_source_enabled(PIO pio, enum pio_interrupt_source source, bool enabled)
+{
+    pio_set_irqn_source_enabled(pio, 1, source, enabled);
+}
+
+uint pio_get_irq_num(PIO pio, uint irqn)
+{
+    return FAKE_IRQ_PIO0_IRQ_0 + pio->index * 2 + irqn;
+}
@@ -0,0 +1,133 @@
+/**
+ * Fake Pico SDK: master SPI simulasi di level pin (mode 0, MSB dulu).
+ *
+ * Master menggerakkan CS, SCK dan MOSI sebagai input eksternal sehingga
+ * target yang diimplementasikan di PIO melihat setiap edge dengan resolusi
+ * ps. CS turun bersama bit pertama di MOSI; setiap bit memakan satu periode
+ * SCK (naik di tengah, turun di akhir, MOSI berganti saat SCK turun), dan CS
+ * naik setengah periode setelah edge turun terakhir.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "fake_hw_internal.h"
+
+static struct
+{
+    bool attached;
+    bool busy;
+    uint sck_pin;
+    uint mosi_pin;
+    uint cs_pin;
+    uint64_t half_ps; // Setengah periode SCK
+    const uint8_t *data;
+    size_t bits;
+    size_t step;      // 0 = CS turun, 2i+1 = SCK naik bit i, 2i+2 = SCK turun
+    uint64_t start_ps;
+} master;
+
+static bool bit_value(size_t bit)
+{
+    return (master.data[bit / 8] >> (7 - bit % 8)) & 1u;
+}
+
+static uint64_t step_ps(size_t step)
+{
+    return master.start_ps + step * master.half_ps;
+}
+
+/**
+ * @brief Memproses satu edge master yang jatuh tempo.
+ */
+static void master_step(void)
+{
+    size_t step = master.step++;
+    if (step == 0)
+    {
+        fake_hw_gpio_set_input(master.mosi_pin, bit_value(0));
+        fake_hw_gpio_set_input(master.cs_pin, false);
+    }
+    else if (step <= 2 * master.bits)
+    {
+        bool rising = step & 1u;
+        fake_hw_gpio_set_input(master.sck_pin, rising);
+        size_t next_bit = step / 2;
+        if (!rising && next_bit < master.bits)
+        {
+            fake_hw_gpio_set_input(master.mosi_pin, bit_value(next_bit));
+        }
+    }
+    else
+    {
+        fake_hw_gpio_set_input(master.cs_pin, true);
+        master.busy = false;
+    }
+}
+
+// -- Antarmuka ke Penjadwal (fake_hw.c) --
+
+void fake_spi_reset(void)
+{
+    master.attached = false;
+    master.busy = false;
+}
+
+uint64_t fake_spi_next_event_ps(void)
+{
+    return master.busy ? step_ps(master.step) : UINT64_MAX;
+}
+
+void fake_spi_service(uint64_t cycle)
+{
+    while (master.busy && fake_hw_ps_to_cycle(step_ps(master.step)) <= cycle)
+    {
+        master_step();
+    }
+}
+
+// -- API Master (fake_hw.h) --
+
+void fake_hw_spi_master_init(uint sck_pin, uint mosi_pin, uint cs_pin, uint32_t hz)
+{
+    if (hz == 0)
+    {
+        panic("fake_spi: frekuensi SCK nol");
+    }
+    master.attached = true;
+    master.busy = false;
+    master.sck_pin = sck_pin;
+    master.mosi_pin = mosi_pin;
+    master.cs_pin = cs_pin;
+    master.half_ps = 1000000000000ull / (2ull * hz);
+    fake_hw_gpio_set_input(sck_pin, false);
+    fake_hw_gpio_set_input(mosi_pin, false);
+    fake_hw_gpio_set_input(cs_pin, true);
+}
+
+bool fake_hw_spi_master_write(const uint8_t *data, size_t len)
+{
+    if (!master.attached)
+    {
+        panic("fake_spi: master belum di-init");
+    }
+    if (master.busy || len == 0)
+    {
+        return false;
+    }
+    master.data = data;
+    master.bits = len * 8;
+    master.step = 0;
+    master.start_ps = fake_hw_now_ps();
+    master.busy = true;
+    return true;
+}
+
+bool fake_hw_spi_master_busy(void)
+{
+    return master.busy;
+}
+
+uint64_t fake_hw_spi_master_frame_ps(size_t len)
+{
+    return (2 * len * 8 + 1) * master.half_ps;
+}
@@ -0,0 +1,193 @@
+/**
+ * Fake Pico SDK: input stdio (konsol USB CDC) dari host.
+ *
+ * Byte yang ditulis fake_hw_stdin_write() diantrekan dan dibaca firmware
+ * lewat getchar_timeout_us(). Callback stdio_set_chars_available_callback()
+ * dipanggil langsung setelah byte masuk, seperti interrupt USB di hardware.
+ * getchar_timeout_us() tidak pernah menunggu: waktu simulasi hanya maju
+ * lewat penjadwal.
+ *
+ * fake_hw_stdin_attach_fd() menghubungkan antrean ke file descriptor (pty
+ * dari sg_simdev): penjadwal membaca fd yang siap (poll tanpa timeout, fd
+ * tetap blocking untuk stdout yang berbagi master pty) setiap FD_POLL_US waktu
+ * simulasi, seperti polling USB. Dengan realtime, simulasi ditahan (nanosleep)
+ * agar tidak mendahului jam dinding sehingga timeout dan laju di sisi host
+ * bermakna.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <errno.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "fake_hw_internal.h"
+#include "pico/stdlib.h"
+
+#define STDIN_SIZE 65536 // Pangkat dua
+#define FD_POLL_US 100
+
+static struct
+{
+    uint8_t data[STDIN_SIZE];
+    size_t head;
+    size_t tail;
+    void (*chars_available)(void *);
+    void *param;
+    uint64_t init_ps;      // Waktu stdio_init_all() pertama, UINT64_MAX = belum
+    int fd;                // -1 = tidak ada fd terhubung
+    bool realtime;
+    uint64_t next_poll_ps;
+    uint64_t start_ps;     // Waktu simulasi saat fd dihubungkan
+    uint64_t start_wall_ns;
+} input = {.init_ps = UINT64_MAX, .fd = -1};
+
+static uint64_t wall_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// -- Antarmuka ke fake_hw.c --
+
+void fake_stdio_reset(void)
+{
+    input.head = 0;
+    input.tail = 0;
+    input.chars_available = NULL;
+    input.param = NULL;
+    input.fd = -1;
+    input.init_ps = UINT64_MAX;
+}
+
+uint64_t fake_stdio_next_event_ps(void)
+{
+    return input.fd < 0 ? UINT64_MAX : input.next_poll_ps;
+}
+
+void fake_stdio_service(uint64_t cycle)
+{
+    if (input.fd < 0)
+    {
+        return;
+    }
+    uint64_t now_ps = fake_hw_now_ps();
+    if (fake_hw_ps_to_cycle(input.next_poll_ps) > cycle)
+    {
+        return;
+    }
+    input.next_poll_ps = now_ps + FD_POLL_US * 1000000ull;
+
+    if (input.realtime)
+    {
+        uint64_t sim_ns = (now_ps - input.start_ps) / 1000u;
+        uint64_t elapsed_ns = wall_ns() - input.start_wall_ns;
+        if (sim_ns > elapsed_ns)
+        {
+            uint64_t ahead = sim_ns - elapsed_ns;
+            struct timespec ts = {.tv_sec = (time_t)(ahead / 1000000000ull), .tv_nsec = (long)(ahead % 1000000000ull)};
+            nanosleep(&ts, NULL);
+        }
+    }
+
+    uint8_t buf[4096];
+    size_t room = STDIN_SIZE - (input.head - input.tail);
+    if (room == 0)
+    {
+        return;
+    }
+    struct pollfd pfd = {.fd = input.fd, .events = POLLIN};
+    if (poll(&pfd, 1, 0) <= 0)
+    {
+        return;
+    }
+    ssize_t n = read(input.fd, buf, room < sizeof(buf) ? room : sizeof(buf));
+    if (n > 0)
+    {
+        fake_hw_stdin_write(buf, (size_t)n);
+    }
+    else if (n == 0)
+    {
+        // EOF (mis. pipe ditutup penulis): tidak ada input lagi
+        input.fd = -1;
+    }
+    else if (errno != EAGAIN && errno != EINTR)
+    {
+        panic("fake_stdio: read stdin gagal");
+    }
+}
+
+// -- API Host (fake_hw.h) --
+
+void fake_hw_stdin_write(const void *data, size_t len)
+{
+    const uint8_t *bytes = data;
+    for (size_t i = 0; i < len; ++i)
+    {
+        if (input.head - input.tail == STDIN_SIZE)
+        {
+            panic("fake_stdio: antrean stdin penuh");
+        }
+        input.data[input.head++ & (STDIN_SIZE - 1)] = bytes[i];
+    }
+    if (len > 0 && input.chars_available)
+    {
+        input.chars_available(input.param);
+    }
+}
+
+/**
+ * @brief Menghubungkan stdin firmware ke fd (misalnya master pty).
+ *
+ * @param fd File descriptor yang dibaca saat poll() melaporkan data
+ * @param realtime Tahan simulasi agar tidak mendahului jam dinding
+ */
+void fake_hw_stdin_attach_fd(int fd, bool realtime)
+{
+    input.fd = fd;
+    input.realtime = realtime;
+    input.start_ps = fake_hw_now_ps();
+    input.start_wall_ns = wall_ns();
+    input.next_poll_ps = input.start_ps;
+}
+
+size_t fake_hw_stdin_pending(void)
+{
+    return input.head - input.tail;
+}
+
+uint64_t fake_hw_stdio_init_ps(void)
+{
+    return input.init_ps;
+}
+
+// -- SDK --
+
+bool stdio_init_all(void)
+{
+    fake_hw_cpu_call();
+    if (input.init_ps == UINT64_MAX)
+    {
+        input.init_ps = fake_hw_now_ps();
+    }
+    return true;
+}
+
+int getchar_timeout_us(uint32_t timeout_us)
+{
+    (void)timeout_us;
+    fake_hw_cpu_call();
+    if (input.head == input.tail)
+    {
+        return PICO_ERROR_TIMEOUT;
+    }
+    return input.data[input.tail++ & (STDIN_SIZE - 1)];
+}
+
+void stdio_set_chars_available_callback(void (*fn)(void *), void *param)
+{
+    input.chars_available = fn;
+    input.param = param;
+}
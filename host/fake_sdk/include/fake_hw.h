@@ -0,0 +1,158 @@
+/**
+ * Fake Pico SDK: antarmuka sisi host untuk mengendalikan dan memeriksa
+ * hardware simulasi.
+ *
+ * Model waktu: seluruh simulasi digerakkan oleh penghitung siklus clk_sys.
+ * Kode firmware memajukan waktu lewat pemanggilan fungsi SDK (setiap panggilan
+ * dikenai biaya beberapa siklus CPU), sleep, busy-wait, __wfi() dan pemanggilan
+ * blocking seperti pio_sm_put_blocking(). State machine PIO dieksekusi per
+ * instruksi sesuai clock divider masing-masing, dengan loop `jmp x--` ke
+ * dirinya sendiri dilompati sekaligus agar burst panjang tetap cepat. Channel
+ * DMA dilayani setiap kali waktu maju.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _FAKE_HW_H
+#define _FAKE_HW_H
+
+#include "pico.h"
+#include "hardware/pio.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FAKE_NUM_GPIOS 32
+
+// -- Log Register --
+typedef enum
+{
+    FAKE_HW_LOG_REG_WRITE, // Penulisan register (nama di field reg)
+    FAKE_HW_LOG_FIFO_PUSH, // Data didorong CPU ke FIFO TX
+    FAKE_HW_LOG_FIFO_PULL, // Data dibaca CPU dari FIFO RX
+} fake_hw_log_kind;
+
+typedef struct
+{
+    uint64_t time_ps;
+    fake_hw_log_kind kind;
+    int8_t pio; // -1 jika bukan register PIO
+    int8_t sm;  // -1 jika bukan register per-SM
+    const char *reg;
+    uint32_t value;
+} fake_hw_log_entry;
+
+typedef void (*fake_hw_pin_listener)(void *ctx, uint64_t time_ps, uint32_t levels, uint32_t changed);
+
+// Dipanggil setelah state machine mengeksekusi instruksi atau FIFO-nya diakses
+// CPU. Dengan fast-forward aktif, iterasi loop `jmp x--` yang dilompati tidak
+// dilaporkan satu per satu.
+typedef void (*fake_hw_sm_listener)(void *ctx, uint64_t time_ps, uint pio, uint sm, const struct fake_pio_sm *s);
+
+// Tegangan input ADC (volt) pada time_ps; dipanggil saat konversi selesai
+typedef float (*fake_hw_adc_source)(void *ctx, uint64_t time_ps);
+
+// -- Siklus Hidup --
+void fake_hw_reset(void);
+bool fake_hw_run_firmware(int (*entry)(void), uint64_t until_us);
+
+// -- Waktu --
+uint64_t fake_hw_sys_cycles(void);
+uint64_t fake_hw_now_ps(void);
+void fake_hw_advance_cycles(uint64_t cycles);
+void fake_hw_advance_us(uint64_t us);
+void fake_hw_set_cpu_call_cycles(uint32_t cycles);
+
+// -- GPIO --
+void fake_hw_gpio_set_input(uint gpio, bool level);
+void fake_hw_gpio_release_input(uint gpio);
+void fake_hw_gpio_schedule(uint gpio, bool level, uint64_t at_us);
+// Sumber clock eksternal (mis. referensi PPS/10 MHz): edge naik pertama di
+// start_ps, HIGH selama high_fs setiap period_fs. Periode dalam fs agar
+// frekuensi 10 MHz dapat digeser per ppb; edge diterapkan pada siklus clk_sys
+// terdekat tanpa galat yang terakumulasi.
+void fake_hw_gpio_drive_clock(uint gpio, uint64_t start_ps, uint64_t period_fs, uint64_t high_fs);
+void fake_hw_gpio_stop_clock(uint gpio);
+uint32_t fake_hw_gpio_levels(void);
+void fake_hw_set_pin_listener(fake_hw_pin_listener listener, void *ctx);
+
+// -- Master I2C --
+// Transaksi asinkron master simulasi ke bus i2c_index, dimulai sekarang:
+// START, alamat + tulis write_len byte, lalu (jika read_len > 0) repeated
+// START, alamat + baca read_len byte ke `read`, lalu STOP. Kedua buffer
+// harus tetap hidup sampai fake_hw_i2c_master_busy() false. Baudrate default
+// 400 kHz; setiap byte 9 bit.
+void fake_hw_i2c_set_master_baudrate(uint32_t hz);
+bool fake_hw_i2c_master_start(uint i2c_index, uint8_t address, const uint8_t *write, size_t write_len,
+                              uint8_t *read, size_t read_len);
+bool fake_hw_i2c_master_busy(void);
+bool fake_hw_i2c_master_acked(void);
+
+// -- Master SPI --
+// Master pin-level (mode 0, MSB dulu) yang menggerakkan SCK, MOSI dan CS
+// (aktif-low) sebagai input eksternal. init menahan pin di level idle;
+// write mengirim len byte secara asinkron mulai sekarang, buffer harus tetap
+// hidup sampai busy false. frame_ps = durasi CS turun -> CS naik.
+void fake_hw_spi_master_init(uint sck_pin, uint mosi_pin, uint cs_pin, uint32_t hz);
+bool fake_hw_spi_master_write(const uint8_t *data, size_t len);
+bool fake_hw_spi_master_busy(void);
+uint64_t fake_hw_spi_master_frame_ps(size_t len);
+
+// -- Konsol stdio --
+// Byte untuk getchar_timeout_us() firmware; callback chars available
+// dipanggil langsung dari dalam fungsi ini. attach_fd membaca fd non-blocking
+// dari penjadwal setiap 100 us simulasi sampai EOF; realtime menahan simulasi
+// agar tidak mendahului jam dinding.
+void fake_hw_stdin_write(const void *data, size_t len);
+void fake_hw_stdin_attach_fd(int fd, bool realtime);
+size_t fake_hw_stdin_pending(void);
+// Waktu stdio_init_all() pertama sejak reset, UINT64_MAX jika belum dipanggil
+uint64_t fake_hw_stdio_init_ps(void);
+
+// -- Flash --
+// Isi flash bertahan melewati fake_hw_reset(); erase_all mengosongkannya.
+// erase_count per sektor (offset mana pun di sektor itu). unsafe_ops = erase
+// atau program di luar flash_safe_execute(). power_loss_after memutus listrik
+// setelah `bytes` byte erase/program berikutnya (operasi terpotong, sisanya
+// diabaikan) sampai power_restore. stream_words = word yang dibaca stream XIP
+// sejak reset.
+void fake_hw_flash_erase_all(void);
+uint32_t fake_hw_flash_erase_count(uint32_t flash_offs);
+uint32_t fake_hw_flash_program_count(void);
+uint32_t fake_hw_flash_unsafe_ops(void);
+void fake_hw_flash_power_loss_after(uint32_t bytes);
+bool fake_hw_flash_power_lost(void);
+void fake_hw_flash_power_restore(void);
+uint64_t fake_hw_flash_stream_words(void);
+
+// -- ADC --
+// Input 0..3 = GPIO 26..29, 4 = sensor suhu (default 0,706 V). Tegangan di
+// luar 0..3,3 V dipotong ke kode 0/4095. set_voltage mengganti sumber dengan
+// tegangan tetap. samples = konversi sejak reset, overflows = sampel yang
+// dibuang karena FIFO penuh.
+void fake_hw_adc_set_source(uint input, fake_hw_adc_source source, void *ctx);
+void fake_hw_adc_set_voltage(uint input, float volts);
+uint64_t fake_hw_adc_samples(void);
+uint64_t fake_hw_adc_overflows(void);
+
+// -- PIO --
+struct fake_pio_block *fake_hw_pio(uint index);
+void fake_hw_set_fast_forward(bool enabled);
+void fake_hw_set_sm_listener(fake_hw_sm_listener listener, void *ctx);
+
+// -- DMA --
+uint64_t fake_hw_dma_transfers(uint channel);
+
+// -- Log --
+void fake_hw_log_set_enabled(bool enabled);
+size_t fake_hw_log_count(void);
+const fake_hw_log_entry *fake_hw_log_get(size_t index);
+size_t fake_hw_log_count_matching(fake_hw_log_kind kind, const char *reg);
+void fake_hw_log_clear(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
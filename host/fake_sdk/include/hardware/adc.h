@@ -0,0 +1,51 @@
+/**
+ * Fake Pico SDK: hardware_adc untuk build host.
+ *
+ * ADC 12 bit (VREF 3,3 V) dengan lima input: AIN0..3 di GPIO 26..29 dan
+ * sensor suhu di AIN4. Tegangan setiap input diberikan host lewat
+ * fake_hw_adc_set_voltage() atau fake_hw_adc_set_source(). Konversi memakan
+ * 96 siklus clock ADC 48 MHz (2 us); dalam mode free-running (adc_run)
+ * konversi berikutnya dimulai setiap max(96, 1 + clkdiv) siklus, tegangan
+ * diambil di akhir konversi, dan round robin pindah ke input berikutnya di
+ * mask setelah setiap sampel. FIFO empat entri; sampel yang datang saat
+ * FIFO penuh dibuang (FCS.OVER). DREQ_ADC aktif selama isi FIFO mencapai
+ * ambang dreq_thresh.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _FAKE_HARDWARE_ADC_H
+#define _FAKE_HARDWARE_ADC_H
+
+#include "pico.h"
+#include "hardware/structs/adc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NUM_ADC_CHANNELS 5
+#define ADC_BASE_PIN 26
+#define ADC_TEMPERATURE_CHANNEL_NUM (NUM_ADC_CHANNELS - 1)
+
+void adc_init(void);
+void adc_gpio_init(uint gpio);
+void adc_select_input(uint input);
+uint adc_get_selected_input(void);
+void adc_set_round_robin(uint input_mask);
+void adc_set_temp_sensor_enabled(bool enable);
+uint16_t adc_read(void);
+void adc_run(bool run);
+void adc_set_clkdiv(float clkdiv);
+void adc_fifo_setup(bool en, bool dreq_en, uint16_t dreq_thresh, bool err_in_fifo, bool byte_shift);
+bool adc_fifo_is_empty(void);
+uint8_t adc_fifo_get_level(void);
+uint16_t adc_fifo_get(void);
+uint16_t adc_fifo_get_blocking(void);
+void adc_fifo_drain(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,49 @@
+/**
+ * Fake Pico SDK: clock sistem.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _FAKE_HARDWARE_CLOCKS_H
+#define _FAKE_HARDWARE_CLOCKS_H
+
+#include "pico.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum clock_index
+{
+    clk_gpout0 = 0,
+    clk_gpout1,
+    clk_gpout2,
+    clk_gpout3,
+    clk_ref,
+    clk_sys,
+    clk_peri,
+    clk_usb,
+    clk_adc,
+    clk_rtc,
+    CLK_COUNT
+};
+
+#define USB_CLK_HZ 48000000u
+#define SYS_CLK_HZ 125000000u
+
+// Sumber AUXSRC yang sama untuk CLK_GPOUT0..3
+#define CLOCKS_CLK_GPOUT0_CTRL_AUXSRC_VALUE_CLK_SYS 0x6u
+#define CLOCKS_CLK_GPOUT0_CTRL_AUXSRC_VALUE_CLK_REF 0xau
+
+uint32_t clock_get_hz(enum clock_index clk_index);
+uint32_t frequency_count_khz(uint src);
+bool set_sys_clock_khz(uint32_t freq_khz, bool required);
+bool check_sys_clock_khz(uint32_t freq_khz, uint *vco_freq_out, uint *post_div1_out, uint *post_div2_out);
+void set_sys_clock_48mhz(void);
+void clock_gpio_init(uint gpio, uint src, float div);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
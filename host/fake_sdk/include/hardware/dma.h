@@ -0,0 +1,168 @@
+/**
+ * Fake Pico SDK: controller DMA yang dieksekusi oleh penjadwal host.
+ *
+ * Signature mengikuti hardware/dma.h Pico SDK 2.x dan word konfigurasi
+ * memakai tata letak register CTRL RP2040. Transfer dimodelkan instan: setiap
+ * kali penjadwal maju, channel yang aktif memindahkan data selama DREQ-nya
+ * aktif. Tujuan/sumber yang dikenali adalah memori biasa serta register
+ * &pio->txf[sm] / &pio->rxf[sm]. Dari penulisan register DMA oleh DMA lain
+ * (control block) hanya alias al3_read_addr_trig dan write_addr yang
+ * dimodelkan: nilainya selebar pointer host, dan al3_read_addr_trig langsung
+ * memicu channel tersebut. Register channel
+ * dapat dibaca lewat dma_channel_hw_addr() (misalnya sisa transfer_count
+ * channel yang sedang berjalan), tetapi penulisan CPU harus lewat fungsi di
+ * bawah. Channel yang
+ * selesai tanpa IRQ_QUIET menyetel status IRQ dan memicu DMA_IRQ_0 jika
+ * diaktifkan dengan dma_channel_set_irq0_enabled().
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _FAKE_HARDWARE_DMA_H
+#define _FAKE_HARDWARE_DMA_H
+
+#include "pico.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NUM_DMA_CHANNELS 12
+#define DREQ_ADC 36
+#define DREQ_XIP_STREAM 37
+#define DREQ_FORCE 0x3f
+
+// -- Field Register CTRL --
+#define DMA_CH0_CTRL_TRIG_EN_BITS 0x00000001u
+#define DMA_CH0_CTRL_TRIG_HIGH_PRIORITY_BITS 0x00000002u
+#define DMA_CH0_CTRL_TRIG_DATA_SIZE_LSB 2
+#define DMA_CH0_CTRL_TRIG_DATA_SIZE_BITS 0x0000000cu
+#define DMA_CH0_CTRL_TRIG_INCR_READ_BITS 0x00000010u
+#define DMA_CH0_CTRL_TRIG_INCR_WRITE_BITS 0x00000020u
+#define DMA_CH0_CTRL_TRIG_RING_SIZE_LSB 6
+#define DMA_CH0_CTRL_TRIG_RING_SIZE_BITS 0x000003c0u
+#define DMA_CH0_CTRL_TRIG_RING_SEL_BITS 0x00000400u
+#define DMA_CH0_CTRL_TRIG_CHAIN_TO_LSB 11
+#define DMA_CH0_CTRL_TRIG_CHAIN_TO_BITS 0x00007800u
+#define DMA_CH0_CTRL_TRIG_TREQ_SEL_LSB 15
+#define DMA_CH0_CTRL_TRIG_TREQ_SEL_BITS 0x001f8000u
+#define DMA_CH0_CTRL_TRIG_IRQ_QUIET_BITS 0x00200000u
+#define DMA_CH0_CTRL_TRIG_BSWAP_BITS 0x00400000u
+#define DMA_CH0_CTRL_TRIG_SNIFF_EN_BITS 0x00800000u
+#define DMA_CH0_CTRL_TRIG_BUSY_BITS 0x01000000u
+
+enum dma_channel_transfer_size
+{
+    DMA_SIZE_8 = 0,
+    DMA_SIZE_16 = 1,
+    DMA_SIZE_32 = 2,
+};
+
+typedef struct
+{
+    uint32_t ctrl;
+} dma_channel_config;
+
+// Cermin register channel (hanya dibaca); alamat selebar pointer host
+typedef struct
+{
+    volatile uintptr_t read_addr;
+    volatile uintptr_t write_addr;
+    volatile uint32_t transfer_count; // Sisa transfer
+    volatile uint32_t ctrl_trig;
+    volatile uintptr_t al3_read_addr_trig; // Tujuan control block: READ_ADDR + trigger
+} dma_channel_hw_t;
+
+// -- Alokasi Channel --
+void dma_channel_claim(uint channel);
+void dma_claim_mask(uint32_t channel_mask);
+void dma_channel_unclaim(uint channel);
+int dma_claim_unused_channel(bool required);
+bool dma_channel_is_claimed(uint channel);
+
+// -- Konfigurasi --
+static inline void channel_config_set_read_increment(dma_channel_config *c, bool incr)
+{
+    c->ctrl = incr ? (c->ctrl | DMA_CH0_CTRL_TRIG_INCR_READ_BITS) : (c->ctrl & ~DMA_CH0_CTRL_TRIG_INCR_READ_BITS);
+}
+
+static inline void channel_config_set_write_increment(dma_channel_config *c, bool incr)
+{
+    c->ctrl = incr ? (c->ctrl | DMA_CH0_CTRL_TRIG_INCR_WRITE_BITS) : (c->ctrl & ~DMA_CH0_CTRL_TRIG_INCR_WRITE_BITS);
+}
+
+static inline void channel_config_set_dreq(dma_channel_config *c, uint dreq)
+{
+    c->ctrl = (c->ctrl & ~DMA_CH0_CTRL_TRIG_TREQ_SEL_BITS) | (dreq << DMA_CH0_CTRL_TRIG_TREQ_SEL_LSB);
+}
+
+static inline void channel_config_set_chain_to(dma_channel_config *c, uint chain_to)
+{
+    c->ctrl = (c->ctrl & ~DMA_CH0_CTRL_TRIG_CHAIN_TO_BITS) | (chain_to << DMA_CH0_CTRL_TRIG_CHAIN_TO_LSB);
+}
+
+static inline void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size)
+{
+    c->ctrl = (c->ctrl & ~DMA_CH0_CTRL_TRIG_DATA_SIZE_BITS) | ((uint)size << DMA_CH0_CTRL_TRIG_DATA_SIZE_LSB);
+}
+
+static inline void channel_config_set_ring(dma_channel_config *c, bool write, uint size_bits)
+{
+    c->ctrl = (c->ctrl & ~(DMA_CH0_CTRL_TRIG_RING_SIZE_BITS | DMA_CH0_CTRL_TRIG_RING_SEL_BITS)) |
+              (size_bits << DMA_CH0_CTRL_TRIG_RING_SIZE_LSB) | (write ? DMA_CH0_CTRL_TRIG_RING_SEL_BITS : 0);
+}
+
+static inline void channel_config_set_bswap(dma_channel_config *c, bool bswap)
+{
+    c->ctrl = bswap ? (c->ctrl | DMA_CH0_CTRL_TRIG_BSWAP_BITS) : (c->ctrl & ~DMA_CH0_CTRL_TRIG_BSWAP_BITS);
+}
+
+static inline void channel_config_set_irq_quiet(dma_channel_config *c, bool irq_quiet)
+{
+    c->ctrl = irq_quiet ? (c->ctrl | DMA_CH0_CTRL_TRIG_IRQ_QUIET_BITS) : (c->ctrl & ~DMA_CH0_CTRL_TRIG_IRQ_QUIET_BITS);
+}
+
+static inline void channel_config_set_high_priority(dma_channel_config *c, bool high_priority)
+{
+    c->ctrl = high_priority ? (c->ctrl | DMA_CH0_CTRL_TRIG_HIGH_PRIORITY_BITS)
+                            : (c->ctrl & ~DMA_CH0_CTRL_TRIG_HIGH_PRIORITY_BITS);
+}
+
+static inline void channel_config_set_enable(dma_channel_config *c, bool enable)
+{
+    c->ctrl = enable ? (c->ctrl | DMA_CH0_CTRL_TRIG_EN_BITS) : (c->ctrl & ~DMA_CH0_CTRL_TRIG_EN_BITS);
+}
+
+static inline uint32_t channel_config_get_ctrl_value(const dma_channel_config *c)
+{
+    return c->ctrl;
+}
+
+dma_channel_config dma_channel_get_default_config(uint channel);
+dma_channel_config dma_get_channel_config(uint channel);
+
+// -- Kontrol Channel --
+void dma_channel_set_config(uint channel, const dma_channel_config *config, bool trigger);
+void dma_channel_set_read_addr(uint channel, const volatile void *read_addr, bool trigger);
+void dma_channel_set_write_addr(uint channel, volatile void *write_addr, bool trigger);
+void dma_channel_set_trans_count(uint channel, uint32_t trans_count, bool trigger);
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint transfer_count, bool trigger);
+void dma_start_channel_mask(uint32_t chan_mask);
+void dma_channel_start(uint channel);
+void dma_channel_abort(uint channel);
+bool dma_channel_is_busy(uint channel);
+void dma_channel_wait_for_finish_blocking(uint channel);
+dma_channel_hw_t *dma_channel_hw_addr(uint channel);
+
+// -- Interrupt --
+void dma_channel_set_irq0_enabled(uint channel, bool enabled);
+void dma_set_irq0_channel_mask_enabled(uint32_t channel_mask, bool enabled);
+bool dma_channel_get_irq0_status(uint channel);
+void dma_channel_acknowledge_irq0(uint channel);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
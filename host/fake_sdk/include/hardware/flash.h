@@ -0,0 +1,36 @@
+/**
+ * Fake Pico SDK: hardware_flash untuk build host.
+ *
+ * Flash disimulasikan sebagai array PICO_FLASH_SIZE_BYTES byte yang terlihat
+ * di XIP_BASE. Erase mengisi 0xFF, program hanya bisa mengubah bit 1 -> 0,
+ * dan keduanya memajukan waktu simulasi sebesar waktu tipikal chip flash
+ * (lihat fake_flash.c). Isi flash bertahan melewati fake_hw_reset(), seperti
+ * power cycle.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _FAKE_HARDWARE_FLASH_H
+#define _FAKE_HARDWARE_FLASH_H
+
+#include "pico.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FLASH_PAGE_SIZE (1u << 8)
+#define FLASH_SECTOR_SIZE (1u << 12)
+#define FLASH_BLOCK_SIZE (1u << 16)
+
+extern uint8_t fake_flash_image[PICO_FLASH_SIZE_BYTES];
+#define XIP_BASE ((uintptr_t)fake_flash_image)
+
+void flash_range_erase(uint32_t flash_offs, size_t count);
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,66 @@
+/**
+ * Fake Pico SDK: controller I2C (DW_apb_i2c) pada level byte.
+ *
+ * Hanya mode target (slave) yang dimodelkan; master bus adalah host lewat
+ * fake_hw_i2c_master_start(). Byte yang ditulis master masuk FIFO RX
+ * (16 entry) dan byte untuk master diambil dari satu slot TX saat master
+ * membacanya; selama slot kosong master menahan clock (clock stretching).
+ * Status interrupt mentah memakai bit IC_INTR_STAT RP2040 dan diteruskan ke
+ * I2C0_IRQ / I2C1_IRQ sesuai intr_mask.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _FAKE_HARDWARE_I2C_H
+#define _FAKE_HARDWARE_I2C_H
+
+#include "pico.h"
+#include "hardware/irq.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NUM_I2CS 2
+#define FAKE_I2C_RX_FIFO_DEPTH 16
+
+// -- Bit IC_INTR_STAT / IC_INTR_MASK --
+#define I2C_IC_INTR_STAT_R_RX_FULL_BITS 0x00000004u
+#define I2C_IC_INTR_STAT_R_RD_REQ_BITS 0x00000020u
+#define I2C_IC_INTR_STAT_R_TX_ABRT_BITS 0x00000040u
+#define I2C_IC_INTR_STAT_R_STOP_DET_BITS 0x00000200u
+#define I2C_IC_INTR_STAT_R_START_DET_BITS 0x00000400u
+
+typedef struct i2c_inst
+{
+    uint index;
+    bool enabled;
+    bool slave;
+    uint8_t address;
+    uint baudrate;
+    uint8_t rx_fifo[FAKE_I2C_RX_FIFO_DEPTH];
+    uint rx_head;
+    uint rx_count;
+    int tx_byte;         // Byte untuk master berikutnya, -1 jika kosong
+    uint32_t raw_intr;   // Status interrupt mentah (tanpa RX_FULL, yang mengikuti FIFO)
+    uint32_t intr_mask;
+    uint32_t rx_overflows;
+} i2c_inst_t;
+
+extern i2c_inst_t fake_i2c_inst[NUM_I2CS];
+#define i2c0 (&fake_i2c_inst[0])
+#define i2c1 (&fake_i2c_inst[1])
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate);
+void i2c_deinit(i2c_inst_t *i2c);
+void i2c_set_slave_mode(i2c_inst_t *i2c, bool slave, uint8_t addr);
+uint i2c_get_index(i2c_inst_t *i2c);
+size_t i2c_get_read_available(i2c_inst_t *i2c);
+uint8_t i2c_read_byte_raw(i2c_inst_t *i2c);
+void i2c_write_byte_raw(i2c_inst_t *i2c, uint8_t value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
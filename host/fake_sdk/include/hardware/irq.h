@@ -0,0 +1,49 @@
+/**
+ * Fake Pico SDK: handler interrupt NVIC.
+ *
+ * Signature mengikuti hardware/irq.h Pico SDK 2.x. Handler dipanggil oleh
+ * penjadwal host saat interrupt pending dan enable, dengan memperhatikan
+ * save_and_disable_interrupts(). Handler shared dipanggil sesuai urutan
+ * pendaftaran; order_priority diabaikan. Prioritas NVIC tidak dimodelkan.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _FAKE_HARDWARE_IRQ_H
+#define _FAKE_HARDWARE_IRQ_H
+
+#include "pico.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Nomor interrupt RP2040
+#define PIO0_IRQ_0 7
+#define PIO0_IRQ_1 8
+#define PIO1_IRQ_0 9
+#define PIO1_IRQ_1 10
+#define DMA_IRQ_0 11
+#define DMA_IRQ_1 12
+#define IO_IRQ_BANK0 13
+#define I2C0_IRQ 23
+#define I2C1_IRQ 24
+
+#define PICO_SHARED_IRQ_HANDLER_HIGHEST_ORDER_PRIORITY 0xff
+#define PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY 0x80
+#define PICO_SHARED_IRQ_HANDLER_LOWEST_ORDER_PRIORITY 0x00
+
+typedef void (*irq_handler_t)(void);
+
+void irq_set_exclusive_handler(uint num, irq_handler_t handler);
+void irq_add_shared_handler(uint num, irq_handler_t handler, uint8_t order_priority);
+void irq_remove_handler(uint num, irq_handler_t handler);
+void irq_set_enabled(uint num, bool enabled);
+bool irq_is_enabled(uint num);
+void irq_clear(uint int_num);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
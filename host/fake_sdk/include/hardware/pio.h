@@ -0,0 +1,256 @@
+/**
+ * Fake Pico SDK: blok PIO yang dieksekusi oleh simulator instruksi host.
+ *
+ * Signature mengikuti hardware/pio.h Pico SDK 2.x. Semua fungsi yang di SDK
+ * bersifat inline diimplementasikan di fake_pio.c agar setiap akses register
+ * dan push FIFO dapat direkam (lihat fake_hw.h). Struktur blok PIO simulasi
+ * didefinisikan di sini agar firmware dapat memakai &pio->txf[sm] sebagai
+ * alamat tujuan DMA seperti pada SDK asli.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _FAKE_HARDWARE_PIO_H
+#define _FAKE_HARDWARE_PIO_H
+
+#include "pico.h"
+#include "hardware/pio_instructions.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NUM_PIOS 2
+#define NUM_PIO_STATE_MACHINES 4
+#define PIO_INSTRUCTION_COUNT 32
+#define NUM_PIO_IRQS 2
+#define PIO_FDEBUG_TXSTALL_LSB 24
+
+struct fake_pio_block;
+typedef struct fake_pio_block *PIO;
+
+extern struct fake_pio_block fake_pio0;
+extern struct fake_pio_block fake_pio1;
+
+#define pio0 (&fake_pio0)
+#define pio1 (&fake_pio1)
+#define PIO_NUM(pio) pio_get_index(pio)
+#define PIO_INSTANCE(instance) ((instance) ? pio1 : pio0)
+
+typedef struct pio_program
+{
+    const uint16_t *instructions;
+    uint8_t length;
+    int8_t origin; // Offset wajib, atau -1 jika bebas
+    uint8_t pio_version;
+} pio_program_t;
+
+/**
+ * @brief Konfigurasi state machine (field sudah di-decode, bukan nilai register).
+ */
+typedef struct
+{
+    uint32_t clkdiv_int;
+    uint8_t clkdiv_frac;
+    uint wrap_target;
+    uint wrap;
+    uint jmp_pin;
+    uint sideset_bits; // Termasuk bit opsional
+    bool sideset_optional;
+    bool sideset_pindirs;
+    bool out_sticky;
+    bool inline_out_en;
+    uint out_en_sel;
+    uint mov_status_sel;
+    uint mov_status_n;
+    bool in_shift_right;
+    bool autopush;
+    uint push_threshold;
+    bool out_shift_right;
+    bool autopull;
+    uint pull_threshold;
+    uint fifo_join;
+    uint out_base;
+    uint out_count;
+    uint set_base;
+    uint set_count;
+    uint in_base;
+    uint sideset_base;
+} pio_sm_config;
+
+enum pio_fifo_join
+{
+    PIO_FIFO_JOIN_NONE = 0,
+    PIO_FIFO_JOIN_TX = 1,
+    PIO_FIFO_JOIN_RX = 2,
+};
+
+enum pio_mov_status_type
+{
+    STATUS_TX_LESSTHAN = 0,
+    STATUS_RX_LESSTHAN = 1,
+};
+
+enum pio_interrupt_source
+{
+    pis_sm0_rx_fifo_not_empty = 0,
+    pis_sm1_rx_fifo_not_empty,
+    pis_sm2_rx_fifo_not_empty,
+    pis_sm3_rx_fifo_not_empty,
+    pis_sm0_tx_fifo_not_full,
+    pis_sm1_tx_fifo_not_full,
+    pis_sm2_tx_fifo_not_full,
+    pis_sm3_tx_fifo_not_full,
+    pis_interrupt0,
+    pis_interrupt1,
+    pis_interrupt2,
+    pis_interrupt3,
+};
+
+// -- State Simulasi --
+#define FAKE_PIO_FIFO_DEPTH 4
+
+/**
+ * @brief State satu state machine PIO simulasi.
+ */
+struct fake_pio_sm
+{
+    pio_sm_config config;
+    bool enabled;
+    uint8_t pc;
+    uint32_t x;
+    uint32_t y;
+    uint32_t osr;
+    uint32_t isr;
+    uint osr_count; // Jumlah bit yang sudah digeser keluar dari OSR
+    uint isr_count; // Jumlah bit yang sudah digeser masuk ke ISR
+    uint32_t tx_fifo[2 * FAKE_PIO_FIFO_DEPTH];
+    uint tx_head;
+    uint tx_level;
+    uint32_t rx_fifo[2 * FAKE_PIO_FIFO_DEPTH];
+    uint rx_head;
+    uint rx_level;
+    uint delay_left;       // Sisa siklus delay instruksi sebelumnya
+    bool stalled;          // Instruksi saat ini sedang menunggu
+    bool has_pending_exec; // Instruksi dari `out exec`/`mov exec`/pio_sm_exec yang stall
+    uint16_t pending_exec;
+    bool tx_stall;          // Flag FDEBUG TXSTALL (pull blocking pada FIFO kosong)
+    uint64_t next_tick_fp; // Siklus clk_sys tick berikutnya, fixed point 24.8
+    uint64_t instructions; // Jumlah instruksi yang dieksekusi (termasuk yang dilompati)
+};
+
+/**
+ * @brief State satu blok PIO simulasi.
+ */
+struct fake_pio_block
+{
+    uint index;
+    uint16_t instr_mem[PIO_INSTRUCTION_COUNT];
+    uint32_t used_instruction_mask;
+    uint claimed_sm_mask;
+    uint8_t irq_flags;
+    uint8_t irq_seen; // irq_flags di awal siklus, yang dilihat instruksi state machine
+    // Register IRQ_FORCE: bit yang ditulis CPU diterapkan ke irq_flags oleh
+    // penjadwal pada siklus yang sama lalu kembali 0
+    volatile uint32_t irq_force;
+    // Register FDEBUG (hanya TXSTALL yang dimodelkan). Tulis-1-hapus: tulisan
+    // CPU diproses penjadwal pada siklus berikutnya, lalu nilai flag ditulis
+    // ulang bersama bit cadangan 31 agar tulisan berikutnya selalu terdeteksi
+    volatile uint32_t fdebug;
+    uint32_t inte[NUM_PIO_IRQS];
+    uint32_t pad_out;
+    uint32_t pad_oe;
+    struct fake_pio_sm sm[NUM_PIO_STATE_MACHINES];
+    // Alamat FIFO untuk DMA (&pio->txf[sm], &pio->rxf[sm]); nilainya tidak
+    // dipakai, akses DMA ke alamat ini diteruskan ke FIFO state machine
+    uint32_t txf[NUM_PIO_STATE_MACHINES];
+    uint32_t rxf[NUM_PIO_STATE_MACHINES];
+};
+
+// -- Konfigurasi State Machine --
+pio_sm_config pio_get_default_sm_config(void);
+void sm_config_set_out_pins(pio_sm_config *c, uint out_base, uint out_count);
+void sm_config_set_set_pins(pio_sm_config *c, uint set_base, uint set_count);
+void sm_config_set_in_pins(pio_sm_config *c, uint in_base);
+void sm_config_set_sideset_pins(pio_sm_config *c, uint sideset_base);
+void sm_config_set_sideset(pio_sm_config *c, uint bit_count, bool optional, bool pindirs);
+void sm_config_set_clkdiv(pio_sm_config *c, float div);
+void sm_config_set_clkdiv_int_frac8(pio_sm_config *c, uint32_t div_int, uint8_t div_frac8);
+void sm_config_set_clkdiv_int_frac(pio_sm_config *c, uint16_t div_int, uint8_t div_frac);
+void sm_config_set_wrap(pio_sm_config *c, uint wrap_target, uint wrap);
+void sm_config_set_jmp_pin(pio_sm_config *c, uint pin);
+void sm_config_set_in_shift(pio_sm_config *c, bool shift_right, bool autopush, uint push_threshold);
+void sm_config_set_out_shift(pio_sm_config *c, bool shift_right, bool autopull, uint pull_threshold);
+void sm_config_set_fifo_join(pio_sm_config *c, enum pio_fifo_join join);
+void sm_config_set_out_special(pio_sm_config *c, bool sticky, bool has_enable_pin, uint enable_pin_index);
+void sm_config_set_mov_status(pio_sm_config *c, enum pio_mov_status_type status_sel, uint status_n);
+
+// -- Program dan State Machine --
+uint pio_get_index(PIO pio);
+uint pio_get_dreq(PIO pio, uint sm, bool is_tx);
+bool pio_can_add_program(PIO pio, const pio_program_t *program);
+bool pio_can_add_program_at_offset(PIO pio, const pio_program_t *program, uint offset);
+int pio_add_program(PIO pio, const pio_program_t *program);
+int pio_add_program_at_offset(PIO pio, const pio_program_t *program, uint offset);
+void pio_remove_program(PIO pio, const pio_program_t *program, uint loaded_offset);
+void pio_clear_instruction_memory(PIO pio);
+void pio_sm_claim(PIO pio, uint sm);
+void pio_claim_sm_mask(PIO pio, uint sm_mask);
+void pio_sm_unclaim(PIO pio, uint sm);
+int pio_claim_unused_sm(PIO pio, bool required);
+bool pio_sm_is_claimed(PIO pio, uint sm);
+int pio_sm_init(PIO pio, uint sm, uint initial_pc, const pio_sm_config *config);
+int pio_sm_set_config(PIO pio, uint sm, const pio_sm_config *config);
+void pio_gpio_init(PIO pio, uint pin);
+int pio_sm_set_consecutive_pindirs(PIO pio, uint sm, uint pins_base, uint pin_count, bool is_out);
+void pio_sm_set_pins(PIO pio, uint sm, uint32_t pin_values);
+void pio_sm_set_pins_with_mask(PIO pio, uint sm, uint32_t pin_values, uint32_t pin_mask);
+void pio_sm_set_pindirs_with_mask(PIO pio, uint sm, uint32_t pin_dirs, uint32_t pin_mask);
+void pio_sm_set_enabled(PIO pio, uint sm, bool enabled);
+void pio_set_sm_mask_enabled(PIO pio, uint32_t mask, bool enabled);
+void pio_enable_sm_mask_in_sync(PIO pio, uint32_t mask);
+void pio_sm_restart(PIO pio, uint sm);
+void pio_restart_sm_mask(PIO pio, uint32_t mask);
+void pio_sm_clkdiv_restart(PIO pio, uint sm);
+void pio_clkdiv_restart_sm_mask(PIO pio, uint32_t mask);
+uint8_t pio_sm_get_pc(PIO pio, uint sm);
+void pio_sm_exec(PIO pio, uint sm, uint instr);
+bool pio_sm_is_exec_stalled(PIO pio, uint sm);
+void pio_sm_exec_wait_blocking(PIO pio, uint sm, uint instr);
+void pio_sm_set_wrap(PIO pio, uint sm, uint wrap_target, uint wrap);
+void pio_sm_set_out_pins(PIO pio, uint sm, uint out_base, uint out_count);
+void pio_sm_set_set_pins(PIO pio, uint sm, uint set_base, uint set_count);
+void pio_sm_set_in_pins(PIO pio, uint sm, uint in_base);
+void pio_sm_set_sideset_pins(PIO pio, uint sm, uint sideset_base);
+void pio_sm_set_jmp_pin(PIO pio, uint sm, uint pin);
+void pio_sm_set_clkdiv(PIO pio, uint sm, float div);
+void pio_sm_set_clkdiv_int_frac8(PIO pio, uint sm, uint32_t div_int, uint8_t div_frac8);
+void pio_sm_set_clkdiv_int_frac(PIO pio, uint sm, uint16_t div_int, uint8_t div_frac);
+
+// -- FIFO --
+void pio_sm_put(PIO pio, uint sm, uint32_t data);
+uint32_t pio_sm_get(PIO pio, uint sm);
+void pio_sm_put_blocking(PIO pio, uint sm, uint32_t data);
+uint32_t pio_sm_get_blocking(PIO pio, uint sm);
+bool pio_sm_is_rx_fifo_full(PIO pio, uint sm);
+bool pio_sm_is_rx_fifo_empty(PIO pio, uint sm);
+uint pio_sm_get_rx_fifo_level(PIO pio, uint sm);
+bool pio_sm_is_tx_fifo_full(PIO pio, uint sm);
+bool pio_sm_is_tx_fifo_empty(PIO pio, uint sm);
+uint pio_sm_get_tx_fifo_level(PIO pio, uint sm);
+void pio_sm_drain_tx_fifo(PIO pio, uint sm);
+void pio_sm_clear_fifos(PIO pio, uint sm);
+
+// -- IRQ --
+bool pio_interrupt_get(PIO pio, uint pio_interrupt_num);
+void pio_interrupt_clear(PIO pio, uint pio_interrupt_num);
+void pio_set_irq0_source_enabled(PIO pio, enum pio_interrupt_source source, bool enabled);
+void pio_set_irq1_source_enabled(PIO pio, enum pio_interrupt_source source, bool enabled);
+void pio_set_irqn_source_enabled(PIO pio, uint irq_index, enum pio_interrupt_source source, bool enabled);
+uint pio_get_irq_num(PIO pio, uint irqn);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
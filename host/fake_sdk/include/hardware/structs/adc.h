@@ -0,0 +1,42 @@
+/**
+ * Fake Pico SDK: register blok ADC.
+ *
+ * Hanya alamat FIFO yang bermakna: DMA yang membaca &adc_hw->fifo
+ * mengambil sampel dari FIFO simulasi (lihat fake_adc.c). Register lain
+ * ada agar kode yang memakai adc_hw tetap bisa dikompilasi; status ADC
+ * dibaca lewat fungsi hardware/adc.h.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _FAKE_HARDWARE_STRUCTS_ADC_H
+#define _FAKE_HARDWARE_STRUCTS_ADC_H
+
+#include "pico.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct
+{
+    volatile uint32_t cs;
+    volatile uint32_t result;
+    volatile uint32_t fcs;
+    volatile uint32_t fifo;
+    volatile uint32_t div;
+    volatile uint32_t intr;
+    volatile uint32_t inte;
+    volatile uint32_t intf;
+    volatile uint32_t ints;
+} adc_hw_t;
+
+extern adc_hw_t fake_adc_hw;
+
+#define adc_hw (&fake_adc_hw)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,51 @@
+/**
+ * Fake Pico SDK: register XIP_CTRL (hanya bagian stream) dan alias XIP.
+ *
+ * Stream XIP membaca STREAM_CTR word mulai STREAM_ADDR dari flash di latar
+ * belakang, tanpa lewat cache, ke FIFO stream dua entry yang dibaca DMA di
+ * XIP_AUX_BASE dengan DREQ_XIP_STREAM. Penulisan STREAM_CTR oleh firmware
+ * langsung ke struct ini; fake_flash.c memulai stream pada langkah
+ * penjadwal berikutnya. STREAM_ADDR selebar pointer host. Membaca
+ * stream_fifo oleh CPU tidak dimodelkan (hanya DMA yang mengambil FIFO).
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _FAKE_HARDWARE_STRUCTS_XIP_CTRL_H
+#define _FAKE_HARDWARE_STRUCTS_XIP_CTRL_H
+
+#include "hardware/flash.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define XIP_STAT_FLUSH_READY_BITS 0x00000001u
+#define XIP_STAT_FIFO_EMPTY_BITS 0x00000002u
+#define XIP_STAT_FIFO_FULL_BITS 0x00000004u
+#define XIP_STREAM_CTR_BITS 0x003fffffu
+
+typedef struct
+{
+    volatile uint32_t ctrl;
+    volatile uint32_t flush;
+    volatile uint32_t stat; // Diperbarui fake_flash.c
+    volatile uint32_t ctr_hit;
+    volatile uint32_t ctr_acc;
+    volatile uintptr_t stream_addr;
+    volatile uint32_t stream_ctr;
+    volatile uint32_t stream_fifo;
+} xip_ctrl_hw_t;
+
+extern xip_ctrl_hw_t fake_xip_ctrl;
+extern volatile uint32_t fake_xip_aux;
+
+#define xip_ctrl_hw (&fake_xip_ctrl)
+#define XIP_NOCACHE_NOALLOC_BASE XIP_BASE
+#define XIP_AUX_BASE ((uintptr_t)&fake_xip_aux)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,43 @@
+/**
+ * Fake Pico SDK: primitif sinkronisasi dan interrupt core.
+ *
+ * save_and_disable_interrupts() menunda callback interrupt simulasi sampai
+ * restore_interrupts(). __wfi() memajukan waktu simulasi sampai ada interrupt
+ * yang pending.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _FAKE_HARDWARE_SYNC_H
+#define _FAKE_HARDWARE_SYNC_H
+
+#include "pico.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+uint32_t save_and_disable_interrupts(void);
+void restore_interrupts(uint32_t status);
+void restore_interrupts_from_disabled(uint32_t status);
+void __wfi(void);
+void __wfe(void);
+void __sev(void);
+
+static inline void __dmb(void)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+static inline void __dsb(void)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+static inline void __nop(void) {}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
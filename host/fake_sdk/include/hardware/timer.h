@@ -0,0 +1,43 @@
+/**
+ * Fake Pico SDK: hardware alarm timer mikrodetik.
+ *
+ * Alarm berbunyi tepat pada tick mikrodetik target dan memanggil callback
+ * dari handler TIMER_IRQ_n. Seperti interrupt lain di fake, handler berjalan
+ * tanpa memajukan waktu simulasi, jadi latensi entry interrupt nol.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _FAKE_HARDWARE_TIMER_H
+#define _FAKE_HARDWARE_TIMER_H
+
+#include "pico.h"
+#include "pico/time.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NUM_ALARMS 4u
+
+// Nomor interrupt RP2040
+#define TIMER_IRQ_0 0
+#define TIMER_IRQ_1 1
+#define TIMER_IRQ_2 2
+#define TIMER_IRQ_3 3
+
+typedef void (*hardware_alarm_callback_t)(uint alarm_num);
+
+void hardware_alarm_claim(uint alarm_num);
+int hardware_alarm_claim_unused(bool required);
+void hardware_alarm_unclaim(uint alarm_num);
+bool hardware_alarm_is_claimed(uint alarm_num);
+void hardware_alarm_set_callback(uint alarm_num, hardware_alarm_callback_t callback);
+bool hardware_alarm_set_target(uint alarm_num, absolute_time_t t);
+void hardware_alarm_cancel(uint alarm_num);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,69 @@
+/**
+ * Fake Pico SDK: definisi dasar (tipe, atribut penempatan kode, panic).
+ *
+ * Hanya dipakai oleh build host (SG_HOST_BUILD). Nama dan signature mengikuti
+ * Pico SDK 2.x agar kode firmware dapat dikompilasi tanpa perubahan.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _FAKE_PICO_H
+#define _FAKE_PICO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef unsigned int uint;
+
+#define PICO_ON_DEVICE 0
+#define PICO_NO_HARDWARE 0
+#define PICO_RP2040 1
+#define PICO_COPY_TO_RAM 0
+#define PICO_PIO_VERSION 0
+#define PICO_FLASH_SIZE_BYTES (2 * 1024 * 1024) // Board Pico
+
+// Penempatan kode di SRAM tidak berarti apa-apa di host
+#define __not_in_flash(group)
+#define __not_in_flash_func(func_name) func_name
+#define __no_inline_not_in_flash_func(func_name) __attribute__((noinline)) func_name
+#define __time_critical_func(func_name) func_name
+#define __scratch_x(group)
+#define __scratch_y(group)
+#define __uninitialized_ram(var) var
+#define __in_flash(group)
+#define __isr
+#define __packed __attribute__((packed))
+#define __unused __attribute__((unused))
+#define __force_inline inline __attribute__((always_inline))
+
+// Kode error SDK (pico/error.h)
+enum pico_error_codes
+{
+    PICO_OK = 0,
+    PICO_ERROR_NONE = 0,
+    PICO_ERROR_TIMEOUT = -1,
+    PICO_ERROR_GENERIC = -2,
+};
+
+#define count_of(a) (sizeof(a) / sizeof((a)[0]))
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+#define MIN(a, b) ((b) > (a) ? (a) : (b))
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void panic(const char *fmt, ...) __attribute__((noreturn));
+void panic_unsupported(void) __attribute__((noreturn));
+void hard_assert(bool condition);
+
+// Tidak melakukan apa pun di hardware; di sini memajukan waktu satu
+// pemanggilan SDK agar loop polling tanpa pemanggilan SDK lain tidak macet
+void tight_loop_contents(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,29 @@
+/**
+ * Fake Pico SDK: library pico_flash.
+ *
+ * flash_safe_execute() menjalankan fungsi dengan interrupt dimatikan; build
+ * host hanya punya satu core, jadi tidak ada lockout core lain. Operasi
+ * hardware_flash di luar flash_safe_execute() dihitung sebagai tidak aman
+ * (fake_hw_flash_unsafe_ops()).
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _FAKE_PICO_FLASH_H
+#define _FAKE_PICO_FLASH_H
+
+#include "pico.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int flash_safe_execute(void (*func)(void *), void *param, uint32_t enter_exit_timeout_ms);
+bool flash_safe_execute_core_init(void);
+bool flash_safe_execute_core_deinit(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,37 @@
+/**
+ * Fake Pico SDK: library pico_i2c_slave.
+ *
+ * Urutan event sama dengan handler SDK: START atau STOP mengakhiri transfer
+ * yang sedang berlangsung (I2C_SLAVE_FINISH), lalu I2C_SLAVE_RECEIVE selama
+ * FIFO RX berisi, lalu I2C_SLAVE_REQUEST saat master meminta satu byte.
+ * Handler dipanggil dari handler interrupt I2Cx_IRQ.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _FAKE_PICO_I2C_SLAVE_H
+#define _FAKE_PICO_I2C_SLAVE_H
+
+#include "hardware/i2c.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum i2c_slave_event_t
+{
+    I2C_SLAVE_RECEIVE, // Master menulis; baca dengan i2c_read_byte_raw()
+    I2C_SLAVE_REQUEST, // Master membaca; tulis satu byte dengan i2c_write_byte_raw()
+    I2C_SLAVE_FINISH,  // START atau STOP setelah transfer
+} i2c_slave_event_t;
+
+typedef void (*i2c_slave_handler_t)(i2c_inst_t *i2c, i2c_slave_event_t event);
+
+void i2c_slave_init(i2c_inst_t *i2c, uint8_t address, i2c_slave_handler_t handler);
+void i2c_slave_deinit(i2c_inst_t *i2c);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
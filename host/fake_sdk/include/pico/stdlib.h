@@ -0,0 +1,30 @@
+/**
+ * Fake Pico SDK: pico/stdlib.h untuk build host.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _FAKE_PICO_STDLIB_H
+#define _FAKE_PICO_STDLIB_H
+
+#include "pico.h"
+#include "pico/time.h"
+#include "hardware/gpio.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+bool stdio_init_all(void);
+int getchar_timeout_us(uint32_t timeout_us);
+void stdio_set_chars_available_callback(void (*fn)(void *), void *param);
+
+// Fungsi clock sistem yang di SDK diekspor lewat pico/stdlib.h
+bool set_sys_clock_khz(uint32_t freq_khz, bool required);
+void set_sys_clock_48mhz(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,88 @@
+/**
+ * Fake Pico SDK: waktu absolut dan timer mikrodetik.
+ *
+ * Waktu diturunkan dari penghitung siklus clk_sys simulasi (lihat fake_hw.h).
+ * Setiap pembacaan waktu dan setiap sleep memajukan waktu simulasi.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _FAKE_PICO_TIME_H
+#define _FAKE_PICO_TIME_H
+
+#include "pico.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef uint64_t absolute_time_t;
+
+// Penanda "tidak ada waktu" (0 us sejak boot)
+static const absolute_time_t nil_time = 0;
+
+static inline bool is_nil_time(absolute_time_t t)
+{
+    return t == nil_time;
+}
+
+uint64_t time_us_64(void);
+uint32_t time_us_32(void);
+
+static inline absolute_time_t get_absolute_time(void)
+{
+    return time_us_64();
+}
+
+static inline uint64_t to_us_since_boot(absolute_time_t t)
+{
+    return t;
+}
+
+static inline absolute_time_t from_us_since_boot(uint64_t us)
+{
+    return us;
+}
+
+static inline uint32_t to_ms_since_boot(absolute_time_t t)
+{
+    return (uint32_t)(t / 1000);
+}
+
+static inline int64_t absolute_time_diff_us(absolute_time_t from, absolute_time_t to)
+{
+    return (int64_t)(to - from);
+}
+
+static inline absolute_time_t delayed_by_us(absolute_time_t t, uint64_t us)
+{
+    return t + us;
+}
+
+static inline absolute_time_t make_timeout_time_us(uint64_t us)
+{
+    return time_us_64() + us;
+}
+
+static inline absolute_time_t make_timeout_time_ms(uint32_t ms)
+{
+    return time_us_64() + (uint64_t)ms * 1000;
+}
+
+static inline bool time_reached(absolute_time_t t)
+{
+    return time_us_64() >= t;
+}
+
+void sleep_us(uint64_t us);
+void sleep_ms(uint32_t ms);
+void sleep_until(absolute_time_t target);
+void busy_wait_us(uint64_t us);
+void busy_wait_us_32(uint32_t us);
+void busy_wait_at_least_cycles(uint32_t cycles);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
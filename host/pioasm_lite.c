@@ -0,0 +1,768 @@
+/**
+ * pioasm_lite: assembler PIO minimal untuk build host.
+ *
+ * Build host tidak memiliki pioasm dari Pico SDK, sehingga tool kecil ini
+ * merakit file .pio proyek menjadi header dengan format yang sama seperti
+ * output `pioasm -o c-sdk` (array instruksi, definisi wrap, offset label
+ * public, fungsi *_program_get_default_config dan blok `% c-sdk {}`).
+ * Yang didukung hanya subset sintaks PIO versi 0 yang dipakai proyek ini.
+ *
+ * Pemakaian: pioasm_lite <input.pio> <output.pio.h>
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <ctype.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_PROGRAMS 8
+#define MAX_INSTR 32
+#define MAX_SYMBOLS 64
+#define MAX_LINE 512
+#define MAX_CODE 16384
+
+typedef struct
+{
+    char name[64];
+    int value;
+    bool is_public;
+    bool is_label;
+} symbol;
+
+typedef struct
+{
+    char text[MAX_LINE]; // Teks instruksi (tanpa label) untuk dirakit di pass kedua
+    int line;
+} pending_instr;
+
+typedef struct
+{
+    char name[64];
+    pending_instr instr[MAX_INSTR];
+    uint16_t code[MAX_INSTR];
+    int length;
+    int origin;
+    int wrap_target;
+    int wrap;
+    int sideset_bits; // Termasuk bit opsional
+    bool sideset_opt;
+    bool sideset_pindirs;
+    symbol symbols[MAX_SYMBOLS];
+    int symbol_count;
+    char c_sdk[MAX_CODE];
+} program;
+
+static program programs[MAX_PROGRAMS];
+static int program_count;
+static const char *input_path;
+static int current_line;
+
+static void fail(const char *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    fprintf(stderr, "%s:%d: error: ", input_path, current_line);
+    vfprintf(stderr, fmt, args);
+    fputc('\n', stderr);
+    va_end(args);
+    exit(1);
+}
+
+static char *trim(char *s)
+{
+    while (isspace((unsigned char)*s))
+    {
+        s++;
+    }
+    char *end = s + strlen(s);
+    while (end > s && isspace((unsigned char)end[-1]))
+    {
+        *--end = '\0';
+    }
+    return s;
+}
+
+static void strip_comment(char *s)
+{
+    for (char *p = s; *p; ++p)
+    {
+        if (*p == ';' || (p[0] == '/' && p[1] == '/'))
+        {
+            *p = '\0';
+            return;
+        }
+    }
+}
+
+static symbol *find_symbol(program *p, const char *name)
+{
+    for (int i = 0; i < p->symbol_count; ++i)
+    {
+        if (strcmp(p->symbols[i].name, name) == 0)
+        {
+            return &p->symbols[i];
+        }
+    }
+    return NULL;
+}
+
+static void add_symbol(program *p, const char *name, int value, bool is_public, bool is_label)
+{
+    if (find_symbol(p, name))
+    {
+        fail("simbol '%s' sudah didefinisikan", name);
+    }
+    if (p->symbol_count == MAX_SYMBOLS)
+    {
+        fail("terlalu banyak simbol");
+    }
+    symbol *s = &p->symbols[p->symbol_count++];
+    snprintf(s->name, sizeof(s->name), "%s", name);
+    s->value = value;
+    s->is_public = is_public;
+    s->is_label = is_label;
+}
+
+// -- Tokenizer Sederhana --
+
+typedef struct
+{
+    char tok[16][64];
+    int count;
+} tokens;
+
+static void tokenize(const char *text, tokens *t)
+{
+    t->count = 0;
+    const char *p = text;
+    while (*p)
+    {
+        if (isspace((unsigned char)*p) || *p == ',')
+        {
+            p++;
+            continue;
+        }
+        if (t->count == 16)
+        {
+            fail("baris terlalu panjang");
+        }
+        char *out = t->tok[t->count++];
+        int n = 0;
+        if (*p == '[' || *p == ']')
+        {
+            out[n++] = *p++;
+        }
+        else if (p[0] == ':' && p[1] == ':')
+        {
+            out[n++] = *p++;
+            out[n++] = *p++;
+        }
+        else if (*p == '!' || *p == '~')
+        {
+            // Operator invert boleh menempel pada operand (mis. `!x`, `~osr`)
+            out[n++] = *p++;
+            while (*p && !isspace((unsigned char)*p) && *p != ',' && *p != '[' && n < 63)
+            {
+                out[n++] = *p++;
+            }
+        }
+        else
+        {
+            while (*p && !isspace((unsigned char)*p) && *p != ',' && *p != '[' && *p != ']' && n < 63)
+            {
+                out[n++] = *p++;
+            }
+        }
+        out[n] = '\0';
+    }
+}
+
+static bool parse_int(const char *s, int *out)
+{
+    char *end;
+    long v;
+    if (s[0] == '0' && (s[1] == 'b' || s[1] == 'B'))
+    {
+        v = strtol(s + 2, &end, 2);
+    }
+    else
+    {
+        v = strtol(s, &end, 0);
+    }
+    if (*s == '\0' || *end != '\0')
+    {
+        return false;
+    }
+    *out = (int)v;
+    return true;
+}
+
+static int eval_value(program *p, const char *s)
+{
+    int v;
+    if (parse_int(s, &v))
+    {
+        return v;
+    }
+    if (s[0] == '-' && parse_int(s + 1, &v))
+    {
+        return -v;
+    }
+    symbol *sym = find_symbol(p, s);
+    if (!sym)
+    {
+        fail("simbol '%s' tidak dikenal", s);
+    }
+    return sym->value;
+}
+
+// -- Perakitan Satu Instruksi --
+
+static int index_of(const char *const *names, int count, const char *s)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        if (names[i] && strcmp(names[i], s) == 0)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static uint16_t assemble(program *p, const char *text)
+{
+    tokens t;
+    tokenize(text, &t);
+    if (t.count == 0)
+    {
+        fail("instruksi kosong");
+    }
+
+    // Pisahkan `side N` dan `[delay]` di akhir
+    int delay = 0;
+    int side = -1;
+    int n = t.count;
+    if (n >= 3 && strcmp(t.tok[n - 1], "]") == 0 && strcmp(t.tok[n - 3], "[") == 0)
+    {
+        delay = eval_value(p, t.tok[n - 2]);
+        n -= 3;
+    }
+    if (n >= 2 && (strcmp(t.tok[n - 2], "side") == 0 || strcmp(t.tok[n - 2], "sideset") == 0))
+    {
+        side = eval_value(p, t.tok[n - 1]);
+        n -= 2;
+    }
+
+    const char *op = t.tok[0];
+    uint16_t instr = 0;
+
+    if (strcmp(op, "nop") == 0)
+    {
+        instr = 0xa042; // mov y, y
+    }
+    else if (strcmp(op, "jmp") == 0)
+    {
+        static const char *const conds[] = {NULL, "!x", "x--", "!y", "y--", "x!=y", "pin", "!osre"};
+        int cond = 0;
+        int arg = 1;
+        if (n == 3)
+        {
+            cond = index_of(conds, 8, t.tok[1]);
+            if (cond < 0)
+            {
+                fail("kondisi jmp '%s' tidak dikenal", t.tok[1]);
+            }
+            arg = 2;
+        }
+        else if (n != 2)
+        {
+            fail("sintaks jmp salah");
+        }
+        int addr = eval_value(p, t.tok[arg]);
+        instr = (uint16_t)(0x0000 | cond << 5 | (addr & 0x1f));
+    }
+    else if (strcmp(op, "wait") == 0)
+    {
+        if (n < 4)
+        {
+            fail("sintaks wait salah");
+        }
+        int polarity = eval_value(p, t.tok[1]) ? 1 : 0;
+        static const char *const sources[] = {"gpio", "pin", "irq"};
+        int source = index_of(sources, 3, t.tok[2]);
+        if (source < 0)
+        {
+            fail("sumber wait '%s' tidak dikenal", t.tok[2]);
+        }
+        int index = eval_value(p, t.tok[3]);
+        if (source == 2 && n >= 5 && strcmp(t.tok[4], "rel") == 0)
+        {
+            index |= 0x10;
+        }
+        instr = (uint16_t)(0x2000 | polarity << 7 | source << 5 | (index & 0x1f));
+    }
+    else if (strcmp(op, "in") == 0 || strcmp(op, "out") == 0)
+    {
+        bool is_in = op[0] == 'i';
+        if (n != 3)
+        {
+            fail("sintaks %s salah", op);
+        }
+        static const char *const in_src[] = {"pins", "x", "y", "null", NULL, NULL, "isr", "osr"};
+        static const char *const out_dst[] = {"pins", "x", "y", "null", "pindirs", "pc", "isr", "exec"};
+        int sd = index_of(is_in ? in_src : out_dst, 8, t.tok[1]);
+        if (sd < 0)
+        {
+            fail("operand %s '%s' tidak dikenal", op, t.tok[1]);
+        }
+        int bits = eval_value(p, t.tok[2]);
+        if (bits < 1 || bits > 32)
+        {
+            fail("jumlah bit harus 1..32");
+        }
+        instr = (uint16_t)((is_in ? 0x4000 : 0x6000) | sd << 5 | (bits & 0x1f));
+    }
+    else if (strcmp(op, "push") == 0 || strcmp(op, "pull") == 0)
+    {
+        bool is_pull = op[1] == 'u' && op[2] == 'l';
+        bool if_flag = false;
+        bool block = true;
+        for (int i = 1; i < n; ++i)
+        {
+            if (strcmp(t.tok[i], is_pull ? "ifempty" : "iffull") == 0)
+            {
+                if_flag = true;
+            }
+            else if (strcmp(t.tok[i], "block") == 0)
+            {
+                block = true;
+            }
+            else if (strcmp(t.tok[i], "noblock") == 0)
+            {
+                block = false;
+            }
+            else
+            {
+                fail("operand %s '%s' tidak dikenal", op, t.tok[i]);
+            }
+        }
+        instr = (uint16_t)(0x8000 | (is_pull ? 0x80 : 0) | (if_flag ? 0x40 : 0) | (block ? 0x20 : 0));
+    }
+    else if (strcmp(op, "mov") == 0)
+    {
+        if (n < 3)
+        {
+            fail("sintaks mov salah");
+        }
+        static const char *const mov_dst[] = {"pins", "x", "y", NULL, "exec", "pc", "isr", "osr"};
+        static const char *const mov_src[] = {"pins", "x", "y", "null", NULL, "status", "isr", "osr"};
+        int dst = index_of(mov_dst, 8, t.tok[1]);
+        if (dst < 0)
+        {
+            fail("tujuan mov '%s' tidak dikenal", t.tok[1]);
+        }
+        int mov_op = 0;
+        const char *src_tok = t.tok[2];
+        if (strcmp(src_tok, "::") == 0)
+        {
+            mov_op = 2;
+            src_tok = t.tok[3];
+        }
+        else if (src_tok[0] == '!' || src_tok[0] == '~')
+        {
+            mov_op = 1;
+            src_tok++;
+            if (*src_tok == '\0')
+            {
+                src_tok = t.tok[3];
+            }
+        }
+        int src = index_of(mov_src, 8, src_tok);
+        if (src < 0)
+        {
+            fail("sumber mov '%s' tidak dikenal", src_tok);
+        }
+        instr = (uint16_t)(0xa000 | dst << 5 | mov_op << 3 | src);
+    }
+    else if (strcmp(op, "irq") == 0)
+    {
+        int mode = 0; // 0 set, 1 wait, 2 clear
+        int i = 1;
+        if (i < n && (strcmp(t.tok[i], "set") == 0 || strcmp(t.tok[i], "nowait") == 0))
+        {
+            i++;
+        }
+        else if (i < n && strcmp(t.tok[i], "wait") == 0)
+        {
+            mode = 1;
+            i++;
+        }
+        else if (i < n && strcmp(t.tok[i], "clear") == 0)
+        {
+            mode = 2;
+            i++;
+        }
+        if (i >= n)
+        {
+            fail("nomor irq tidak ada");
+        }
+        int index = eval_value(p, t.tok[i++]);
+        if (i < n && strcmp(t.tok[i], "rel") == 0)
+        {
+            index |= 0x10;
+        }
+        instr = (uint16_t)(0xc000 | (mode == 2 ? 0x40 : 0) | (mode == 1 ? 0x20 : 0) | (index & 0x1f));
+    }
+    else if (strcmp(op, "set") == 0)
+    {
+        if (n != 3)
+        {
+            fail("sintaks set salah");
+        }
+        static const char *const set_dst[] = {"pins", "x", "y", NULL, "pindirs"};
+        int dst = index_of(set_dst, 5, t.tok[1]);
+        if (dst < 0)
+        {
+            fail("tujuan set '%s' tidak dikenal", t.tok[1]);
+        }
+        int value = eval_value(p, t.tok[2]);
+        if (value < 0 || value > 31)
+        {
+            fail("nilai set harus 0..31");
+        }
+        instr = (uint16_t)(0xe000 | dst << 5 | value);
+    }
+    else
+    {
+        fail("instruksi '%s' tidak dikenal", op);
+    }
+
+    // Field delay/side-set (5 bit)
+    int delay_bits = 5 - p->sideset_bits;
+    if (delay < 0 || delay >= (1 << delay_bits))
+    {
+        fail("delay %d melebihi %d bit", delay, delay_bits);
+    }
+    int field = delay;
+    if (side >= 0)
+    {
+        if (p->sideset_bits == 0)
+        {
+            fail("side-set dipakai tanpa .side_set");
+        }
+        int value_bits = p->sideset_bits - (p->sideset_opt ? 1 : 0);
+        if (side >= (1 << value_bits))
+        {
+            fail("nilai side-set terlalu besar");
+        }
+        field |= side << delay_bits;
+        if (p->sideset_opt)
+        {
+            field |= 0x10;
+        }
+    }
+    else if (p->sideset_bits > 0 && !p->sideset_opt)
+    {
+        fail("side-set wajib pada setiap instruksi");
+    }
+    return (uint16_t)(instr | field << 8);
+}
+
+// -- Parser File --
+
+static void parse_file(FILE *in)
+{
+    char buf[MAX_LINE];
+    program *p = NULL;
+    bool in_code_block = false;
+    bool code_block_is_c_sdk = false;
+
+    current_line = 0;
+    while (fgets(buf, sizeof(buf), in))
+    {
+        current_line++;
+        if (in_code_block)
+        {
+            if (strncmp(trim(buf), "%}", 2) == 0)
+            {
+                in_code_block = false;
+                continue;
+            }
+            if (code_block_is_c_sdk && p)
+            {
+                strncat(p->c_sdk, buf, sizeof(p->c_sdk) - strlen(p->c_sdk) - 1);
+            }
+            continue;
+        }
+
+        char *line = trim(buf);
+        if (line[0] == '%')
+        {
+            in_code_block = true;
+            code_block_is_c_sdk = strstr(line, "c-sdk") != NULL;
+            continue;
+        }
+        strip_comment(line);
+        line = trim(line);
+        if (*line == '\0')
+        {
+            continue;
+        }
+
+        if (line[0] == '.')
+        {
+            tokens t;
+            tokenize(line, &t);
+            const char *d = t.tok[0];
+            if (strcmp(d, ".program") == 0)
+            {
+                if (program_count == MAX_PROGRAMS)
+                {
+                    fail("terlalu banyak program");
+                }
+                p = &programs[program_count++];
+                memset(p, 0, sizeof(*p));
+                snprintf(p->name, sizeof(p->name), "%s", t.tok[1]);
+                p->origin = -1;
+                p->wrap_target = -1;
+                p->wrap = -1;
+                continue;
+            }
+            if (!p)
+            {
+                fail("direktif sebelum .program");
+            }
+            if (strcmp(d, ".wrap_target") == 0)
+            {
+                p->wrap_target = p->length;
+            }
+            else if (strcmp(d, ".wrap") == 0)
+            {
+                p->wrap = p->length - 1;
+            }
+            else if (strcmp(d, ".origin") == 0)
+            {
+                p->origin = eval_value(p, t.tok[1]);
+            }
+            else if (strcmp(d, ".side_set") == 0)
+            {
+                p->sideset_bits = eval_value(p, t.tok[1]);
+                for (int i = 2; i < t.count; ++i)
+                {
+                    if (strcmp(t.tok[i], "opt") == 0)
+                    {
+                        p->sideset_opt = true;
+                    }
+                    else if (strcmp(t.tok[i], "pindirs") == 0)
+                    {
+                        p->sideset_pindirs = true;
+                    }
+                }
+                if (p->sideset_opt)
+                {
+                    p->sideset_bits++;
+                }
+                if (p->sideset_bits > 5)
+                {
+                    fail("side-set terlalu lebar");
+                }
+            }
+            else if (strcmp(d, ".define") == 0)
+            {
+                int i = 1;
+                bool is_public = false;
+                if (strcmp(t.tok[1], "public") == 0 || strcmp(t.tok[1], "PUBLIC") == 0)
+                {
+                    is_public = true;
+                    i++;
+                }
+                add_symbol(p, t.tok[i], eval_value(p, t.tok[i + 1]), is_public, false);
+            }
+            else if (strcmp(d, ".pio_version") == 0 || strcmp(d, ".lang_opt") == 0)
+            {
+                // Diabaikan: hanya PIO versi 0 yang didukung
+            }
+            else
+            {
+                fail("direktif '%s' tidak didukung", d);
+            }
+            continue;
+        }
+
+        if (!p)
+        {
+            fail("instruksi sebelum .program");
+        }
+
+        // Label (boleh diawali `public`), boleh diikuti instruksi di baris yang sama
+        char *colon = strchr(line, ':');
+        if (colon && !(colon[1] == ':'))
+        {
+            *colon = '\0';
+            char *label = trim(line);
+            bool is_public = false;
+            if (strncmp(label, "public ", 7) == 0)
+            {
+                is_public = true;
+                label = trim(label + 7);
+            }
+            add_symbol(p, label, p->length, is_public, true);
+            line = trim(colon + 1);
+            if (*line == '\0')
+            {
+                continue;
+            }
+        }
+        if (p->length == MAX_INSTR)
+        {
+            fail("program '%s' melebihi 32 instruksi", p->name);
+        }
+        snprintf(p->instr[p->length].text, MAX_LINE, "%s", line);
+        p->instr[p->length].line = current_line;
+        p->length++;
+    }
+}
+
+static void assemble_all(void)
+{
+    for (int i = 0; i < program_count; ++i)
+    {
+        program *p = &programs[i];
+        if (p->length == 0)
+        {
+            fail("program '%s' kosong", p->name);
+        }
+        for (int j = 0; j < p->length; ++j)
+        {
+            current_line = p->instr[j].line;
+            p->code[j] = assemble(p, p->instr[j].text);
+        }
+        if (p->wrap_target < 0)
+        {
+            p->wrap_target = 0;
+        }
+        if (p->wrap < 0)
+        {
+            p->wrap = p->length - 1;
+        }
+    }
+}
+
+// -- Penulisan Header --
+
+static void write_header(FILE *out)
+{
+    fprintf(out, "// -------------------------------------------------- //\n");
+    fprintf(out, "// This file is autogenerated by pioasm; do not edit! //\n");
+    fprintf(out, "// -------------------------------------------------- //\n\n");
+    fprintf(out, "#pragma once\n\n");
+    fprintf(out, "#if !PICO_NO_HARDWARE\n#include \"hardware/pio.h\"\n#endif\n\n");
+
+    for (int i = 0; i < program_count; ++i)
+    {
+        program *p = &programs[i];
+        size_t len = strlen(p->name);
+        char rule[80];
+        memset(rule, '-', len);
+        rule[len] = '\0';
+        fprintf(out, "// %s //\n// %s //\n// %s //\n\n", rule, p->name, rule);
+
+        fprintf(out, "#define %s_wrap_target %d\n", p->name, p->wrap_target);
+        fprintf(out, "#define %s_wrap %d\n", p->name, p->wrap);
+        fprintf(out, "#define %s_pio_version 0\n\n", p->name);
+        bool any_public = false;
+        for (int s = 0; s < p->symbol_count; ++s)
+        {
+            symbol *sym = &p->symbols[s];
+            if (!sym->is_public)
+            {
+                continue;
+            }
+            any_public = true;
+            if (sym->is_label)
+            {
+                fprintf(out, "#define %s_offset_%s %du\n", p->name, sym->name, sym->value);
+            }
+            else
+            {
+                fprintf(out, "#define %s_%s %d\n", p->name, sym->name, sym->value);
+            }
+        }
+        if (any_public)
+        {
+            fprintf(out, "\n");
+        }
+
+        fprintf(out, "static const uint16_t %s_program_instructions[] = {\n", p->name);
+        for (int j = 0; j < p->length; ++j)
+        {
+            if (j == p->wrap_target)
+            {
+                fprintf(out, "            //     .wrap_target\n");
+            }
+            fprintf(out, "    0x%04x, // %2d: %s\n", p->code[j], j, p->instr[j].text);
+            if (j == p->wrap)
+            {
+                fprintf(out, "            //     .wrap\n");
+            }
+        }
+        fprintf(out, "};\n\n");
+
+        fprintf(out, "#if !PICO_NO_HARDWARE\n");
+        fprintf(out, "static const struct pio_program %s_program = {\n", p->name);
+        fprintf(out, "    .instructions = %s_program_instructions,\n", p->name);
+        fprintf(out, "    .length = %d,\n", p->length);
+        fprintf(out, "    .origin = %d,\n", p->origin);
+        fprintf(out, "    .pio_version = %s_pio_version,\n", p->name);
+        fprintf(out, "};\n\n");
+        fprintf(out, "static inline pio_sm_config %s_program_get_default_config(uint offset) {\n", p->name);
+        fprintf(out, "    pio_sm_config c = pio_get_default_sm_config();\n");
+        fprintf(out, "    sm_config_set_wrap(&c, offset + %s_wrap_target, offset + %s_wrap);\n", p->name, p->name);
+        if (p->sideset_bits > 0)
+        {
+            fprintf(out, "    sm_config_set_sideset(&c, %d, %s, %s);\n", p->sideset_bits,
+                    p->sideset_opt ? "true" : "false", p->sideset_pindirs ? "true" : "false");
+        }
+        fprintf(out, "    return c;\n}\n");
+        if (p->c_sdk[0])
+        {
+            fprintf(out, "\n%s", p->c_sdk);
+        }
+        fprintf(out, "#endif\n\n");
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 3)
+    {
+        fprintf(stderr, "pemakaian: %s <input.pio> <output.pio.h>\n", argv[0]);
+        return 2;
+    }
+    input_path = argv[1];
+    FILE *in = fopen(argv[1], "r");
+    if (!in)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+    parse_file(in);
+    fclose(in);
+    assemble_all();
+
+    FILE *out = fopen(argv[2], "w");
+    if (!out)
+    {
+        perror(argv[2]);
+        return 1;
+    }
+    write_header(out);
+    fclose(out);
+    return 0;
+}
@@ -0,0 +1,317 @@
+/**
+ * sg_3phase: pemeriksaan PWM tiga fasa yang diputar DMA di simulasi.
+ *
+ * Tabel SPWM dan SVPWM dibangun dengan sg_3ph_build(), diputar lewat DMA
+ * selama beberapa periode fundamental, lalu setiap edge pin diperiksa:
+ * - high dan low satu leg tidak pernah aktif bersamaan dan jarak turn-off ke
+ *   turn-on pasangannya tidak pernah lebih pendek dari dead time;
+ * - waktu aktif high/low di setiap periode carrier sesuai duty ideal dikurangi
+ *   dead time (toleransi kuantisasi grid event);
+ * - CPU tidak mendorong satu word pun ke FIFO setelah start;
+ * - setelah stop semua pin kembali LOW.
+ *
+ * Pemakaian: sg_3phase [--periods <n>]
+ * Exit 1 jika ada pelanggaran.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fake_hw.h"
+#include "hardware/clocks.h"
+#include "signal_3phase.h"
+
+#define PIN_BASE 6
+#define PIN_MASK (((1u << SG_3PH_NUM_PINS) - 1u) << PIN_BASE)
+#define PS_PER_S 1000000000000.0
+
+// Toleransi waktu aktif per periode carrier: pembulatan edge ke grid (+-2 di
+// kedua sisi pulsa) dan pembulatan dead time ke atas
+#define DUTY_TOLERANCE_CYCLES (2 * SG_EVENT_OVERHEAD_CYCLES)
+
+typedef struct
+{
+    uint64_t time_ps;
+    uint32_t levels; // Relatif terhadap PIN_BASE
+} edge;
+
+static struct
+{
+    edge *edges;
+    size_t count;
+    size_t capacity;
+} capture;
+
+static uint32_t __attribute__((aligned(SG_3PH_TABLE_ALIGN))) table_buffer[SG_SEQ_DMA_MAX_WORDS];
+
+static void on_pins(void *ctx, uint64_t time_ps, uint32_t levels, uint32_t changed)
+{
+    (void)ctx;
+    if (!(changed & PIN_MASK))
+    {
+        return;
+    }
+    if (capture.count == capture.capacity)
+    {
+        capture.capacity = capture.capacity ? 2 * capture.capacity : 4096;
+        capture.edges = realloc(capture.edges, capture.capacity * sizeof(edge));
+        if (!capture.edges)
+        {
+            fprintf(stderr, "sg_3phase: memori habis\n");
+            exit(2);
+        }
+    }
+    capture.edges[capture.count].time_ps = time_ps;
+    capture.edges[capture.count].levels = (levels & PIN_MASK) >> PIN_BASE;
+    capture.count++;
+}
+
+/**
+ * @brief Memeriksa interlock per leg pada seluruh edge yang terekam.
+ *
+ * @return Jumlah pelanggaran
+ */
+static uint check_interlock(uint64_t deadtime_ps, uint64_t *min_gap_ps)
+{
+    uint violations = 0;
+    uint64_t last_off[SG_3PH_NUM_PINS];
+    bool seen_off[SG_3PH_NUM_PINS] = {false};
+    uint32_t prev = 0;
+    for (size_t i = 0; i < capture.count; ++i)
+    {
+        const edge *e = &capture.edges[i];
+        uint32_t fall = prev & ~e->levels;
+        uint32_t rise = e->levels & ~prev;
+        for (uint pin = 0; pin < SG_3PH_NUM_PINS; ++pin)
+        {
+            if (fall & (1u << pin))
+            {
+                last_off[pin] = e->time_ps;
+                seen_off[pin] = true;
+            }
+        }
+        for (uint pin = 0; pin < SG_3PH_NUM_PINS; ++pin)
+        {
+            uint partner = pin ^ 1u;
+            if ((e->levels & (1u << pin)) && (e->levels & (1u << partner)) && pin < partner)
+            {
+                printf("  shoot-through fasa %c pada %.3f us\n", "UVW"[pin / 2], (double)e->time_ps / 1e6);
+                violations++;
+            }
+            if ((rise & (1u << pin)) && seen_off[partner])
+            {
+                uint64_t gap = e->time_ps - last_off[partner];
+                if (gap < *min_gap_ps)
+                {
+                    *min_gap_ps = gap;
+                }
+                if (gap < deadtime_ps)
+                {
+                    printf("  dead time fasa %c: %.1f ns pada %.3f us\n", "UVW"[pin / 2], (double)gap / 1e3,
+                           (double)e->time_ps / 1e6);
+                    violations++;
+                }
+            }
+        }
+        prev = e->levels;
+    }
+    return violations;
+}
+
+/**
+ * @brief Menghitung waktu aktif setiap pin di dalam jendela [from, to) (ps).
+ */
+static void active_time(uint64_t from, uint64_t to, size_t *cursor, uint64_t out[SG_3PH_NUM_PINS])
+{
+    memset(out, 0, SG_3PH_NUM_PINS * sizeof(out[0]));
+    // Mundurkan kursor ke edge terakhir sebelum jendela
+    while (*cursor > 0 && capture.edges[*cursor].time_ps > from)
+    {
+        (*cursor)--;
+    }
+    for (size_t i = *cursor; i < capture.count && capture.edges[i].time_ps < to; ++i)
+    {
+        uint64_t start = capture.edges[i].time_ps < from ? from : capture.edges[i].time_ps;
+        uint64_t end = i + 1 < capture.count && capture.edges[i + 1].time_ps < to ? capture.edges[i + 1].time_ps : to;
+        if (end <= start)
+        {
+            continue;
+        }
+        for (uint pin = 0; pin < SG_3PH_NUM_PINS; ++pin)
+        {
+            if (capture.edges[i].levels & (1u << pin))
+            {
+                out[pin] += end - start;
+            }
+        }
+        *cursor = i;
+    }
+}
+
+/**
+ * @brief Waktu aktif ideal (tanpa kuantisasi) high dan low satu fasa di
+ *        periode carrier k, dalam siklus PIO.
+ *
+ * Pulsa low yang sempit bisa tergeser melintasi batas periode oleh dead time
+ * turn-on, sehingga low dihitung dari akhir pulsa high periode sebelumnya.
+ */
+static void ideal_on_time(const sg_3ph_config *config, const sg_3ph_table *table, uint phase, uint k,
+                          double deadtime, double out[2])
+{
+    double T = table->carrier_cycles;
+    uint n = table->carrier_periods;
+    double d = sg_3ph_duty(config, phase, 6.28318530718f * ((float)(k % n) + 0.5f) / (float)n);
+    double d_prev = sg_3ph_duty(config, phase, 6.28318530718f * ((float)((k + n - 1) % n) + 0.5f) / (float)n);
+    double start = T * (1.0 - d) / 2.0;
+    double end = T - start;
+    double spill = d_prev > 0.0 ? T * (1.0 + d_prev) / 2.0 + deadtime - T : 0.0;
+    if (spill < 0.0)
+    {
+        spill = 0.0;
+    }
+    if (d <= 0.0)
+    {
+        out[0] = 0.0;
+        out[1] = T - spill;
+        return;
+    }
+    out[0] = d * T - deadtime > 0.0 ? d * T - deadtime : 0.0;
+    out[1] = (start > spill ? start - spill : 0.0) + (T - end - deadtime > 0.0 ? T - end - deadtime : 0.0);
+}
+
+static bool run_case(const char *name, const sg_3ph_config *config, uint periods)
+{
+    fake_hw_reset();
+    memset(&capture, 0, sizeof(capture));
+    fake_hw_set_pin_listener(on_pins, NULL);
+
+    float sys_clk_hz = (float)clock_get_hz(clk_sys);
+    sg_3ph_table table;
+    sg_seq_instance inst;
+    if (!sg_seq_init(&inst, pio0, PIN_BASE, SG_3PH_NUM_PINS) ||
+        !sg_3ph_build(sys_clk_hz, config, table_buffer, count_of(table_buffer), &table))
+    {
+        printf("%s: tabel ditolak\n", name);
+        return false;
+    }
+
+    fake_hw_log_clear();
+    if (!sg_3ph_start(&inst, &table))
+    {
+        printf("%s: start DMA gagal\n", name);
+        return false;
+    }
+    uint64_t run_us = (uint64_t)((double)periods * 1e6 / table.fundamental_hz);
+    fake_hw_advance_us(run_us);
+    size_t cpu_pushes = fake_hw_log_count_matching(FAKE_HW_LOG_FIFO_PUSH, NULL);
+    uint64_t dma_words = fake_hw_dma_transfers((uint)inst.dma_chan[0]) + fake_hw_dma_transfers((uint)inst.dma_chan[1]);
+    sg_seq_stop(&inst);
+    bool stuck = (fake_hw_gpio_levels() & PIN_MASK) != 0;
+    sg_seq_deinit(&inst);
+
+    // Interlock terhadap dead time yang diminta (dibulatkan ke bawah ke siklus clk_sys)
+    double cycle_ps = PS_PER_S * (double)table.pio_clk_div / (double)sys_clk_hz;
+    uint64_t deadtime_ps = (uint64_t)(config->deadtime_us * 1e6 / cycle_ps) * (uint64_t)cycle_ps;
+    uint64_t min_gap_ps = UINT64_MAX;
+    uint violations = check_interlock(deadtime_ps, &min_gap_ps);
+
+    // Waktu aktif per periode carrier, diukur dari edge pertama (awal tabel)
+    uint duty_errors = 0;
+    double max_error = 0.0;
+    uint carriers_checked = 0;
+    if (capture.count > 0)
+    {
+        uint64_t t0 = capture.edges[0].time_ps;
+        double period_ps = (double)table.carrier_cycles * cycle_ps;
+        double deadtime_cycles = config->deadtime_us * 1e-6 * (double)sys_clk_hz / (double)table.pio_clk_div;
+        uint64_t end_ps = capture.edges[capture.count - 1].time_ps;
+        size_t cursor = 0;
+        for (uint k = 0; t0 + (uint64_t)((k + 1) * period_ps) < end_ps; ++k)
+        {
+            uint64_t on[SG_3PH_NUM_PINS];
+            active_time(t0 + (uint64_t)(k * period_ps), t0 + (uint64_t)((k + 1) * period_ps), &cursor, on);
+            for (uint phase = 0; phase < 3; ++phase)
+            {
+                double expected[2];
+                ideal_on_time(config, &table, phase, k, deadtime_cycles, expected);
+                for (uint side = 0; side < 2; ++side)
+                {
+                    double want = expected[side];
+                    double got = (double)on[2 * phase + side] / cycle_ps;
+                    double err = got > want ? got - want : want - got;
+                    if (err > max_error)
+                    {
+                        max_error = err;
+                    }
+                    if (err > DUTY_TOLERANCE_CYCLES)
+                    {
+                        if (duty_errors < 10)
+                        {
+                            printf("  carrier %u fasa %c %s: %.1f siklus, seharusnya %.1f\n", k, "UVW"[phase],
+                                   side ? "low" : "high", got, want);
+                        }
+                        duty_errors++;
+                    }
+                }
+            }
+            carriers_checked++;
+        }
+    }
+
+    bool ok = violations == 0 && duty_errors == 0 && cpu_pushes == 0 && !stuck && carriers_checked > 0;
+    printf("%s: fundamental %.3f Hz, carrier %.1f Hz (%u per periode), m %.3f\n", name, table.fundamental_hz,
+           table.carrier_hz, table.carrier_periods, config->modulation_index);
+    printf("  tabel %u word (%u event, maks %u event per carrier, %u byte)\n", table.count, table.events,
+           table.max_events_per_carrier, table.count * 4u);
+    printf("  %llu word dari DMA, %zu word dari CPU setelah start\n", (unsigned long long)dma_words, cpu_pushes);
+    printf("  interlock: %u pelanggaran, dead time terpendek %.1f ns (batas %.1f ns)\n", violations,
+           min_gap_ps == UINT64_MAX ? 0.0 : (double)min_gap_ps / 1e3, (double)deadtime_ps / 1e3);
+    printf("  duty: %u carrier diperiksa, galat maks %.1f siklus (toleransi %d), %u di luar toleransi\n",
+           carriers_checked, max_error, DUTY_TOLERANCE_CYCLES, duty_errors);
+    if (stuck)
+    {
+        printf("  pin tidak LOW setelah stop\n");
+    }
+    printf("  %s\n", ok ? "OK" : "GAGAL");
+    free(capture.edges);
+    capture.edges = NULL;
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    uint periods = 2;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--periods") == 0 && i + 1 < argc)
+        {
+            periods = (uint)strtoul(argv[++i], NULL, 0);
+        }
+        else
+        {
+            fprintf(stderr, "pemakaian: %s [--periods <n>]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    static const struct
+    {
+        const char *name;
+        sg_3ph_config config;
+    } cases[] = {
+        {"spwm_50hz_20khz", {50.0f, 20000.0f, 0.9f, 0.5f, 1.0f, SG_3PH_SPWM}},
+        {"svpwm_50hz_20khz", {50.0f, 20000.0f, 1.15f, 0.5f, 1.0f, SG_3PH_SVPWM}},
+        {"spwm_400hz_16khz_div2", {400.0f, 16000.0f, 1.0f, 1.0f, 2.0f, SG_3PH_SPWM}},
+    };
+
+    bool ok = true;
+    for (uint i = 0; i < count_of(cases); ++i)
+    {
+        ok &= run_case(cases[i].name, &cases[i].config, periods);
+    }
+    printf("%s\n", ok ? "OK" : "GAGAL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,319 @@
+/**
+ * sg_burst: pemeriksaan mode burst yang diputuskan PIO (signal_burst).
+ *
+ * Setiap kasus menjalankan sg_burst_start() lalu membiarkan CPU diam dengan
+ * interrupt mati sementara pola trigger dijadwalkan pada pin. Edge naik CH1
+ * (awal periode) direkam dan dibandingkan dengan model referensi mode:
+ *   - periode di dalam burst tepat sama dengan periode generator klasik
+ *     (overhead batas periode sudah dikompensasi),
+ *   - jumlah periode per burst sesuai semantik gated/N-siklus/retrigger,
+ *   - edge pertama setelah trigger tepat SG_BURST_*_LATENCY_CYCLES siklus PIO
+ *     (ditambah kuantisasi < 1 siklus karena trigger asinkron),
+ *   - setiap burst berakhir dengan periode utuh dan output LOW,
+ *   - penghitung periode (sg_count_start_sm) sama dengan jumlah edge.
+ *
+ * Pemakaian: sg_burst
+ * Exit 1 jika ada perbedaan.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "fake_hw.h"
+#include "hardware/clocks.h"
+#include "hardware/gpio.h"
+#include "hardware/sync.h"
+#include "signal_burst.h"
+#include "signal_count.h"
+
+#define PIN_BASE 6
+#define PIN_MASK (0xfu << PIN_BASE)
+#define EXTERNAL_TRIGGER_PIN 2
+#define BUTTON_PIN 13
+#define MAX_RISES 256
+#define MAX_EDGES 8
+
+// -- Edge Naik CH1 --
+static struct
+{
+    uint64_t time_ps[MAX_RISES];
+    uint count;
+    bool level;
+} ch1;
+
+static void on_pins(void *ctx, uint64_t time_ps, uint32_t levels, uint32_t changed)
+{
+    (void)ctx;
+    if (!(changed & (1u << PIN_BASE)))
+    {
+        return;
+    }
+    bool level = (levels >> PIN_BASE) & 1u;
+    if (level && !ch1.level && ch1.count < MAX_RISES)
+    {
+        ch1.time_ps[ch1.count++] = time_ps;
+    }
+    ch1.level = level;
+}
+
+// -- Kasus Uji --
+
+typedef struct
+{
+    const char *name;
+    sg_burst_mode mode;
+    uint32_t periods;         // N untuk NCYCLE/RETRIGGER
+    uint trigger_pin;
+    bool active_high;         // false = tombol ke ground dengan pull-up
+    float pio_clk_div;
+    uint edge_count;
+    uint64_t edge_us[MAX_EDGES]; // Waktu pergantian level trigger; dimulai dari aktif
+    uint64_t run_us;
+} burst_case;
+
+static const uint latency_cycles[SG_BURST_NUM_MODES] = {
+    [SG_BURST_CONTINUOUS] = SG_START_LATENCY_CYCLES,
+    [SG_BURST_GATED] = SG_BURST_GATED_LATENCY_CYCLES,
+    [SG_BURST_NCYCLE] = SG_BURST_NCYCLE_LATENCY_CYCLES,
+    [SG_BURST_RETRIGGER] = SG_BURST_RETRIGGER_LATENCY_CYCLES,
+};
+
+/**
+ * @brief Level trigger aktif pada waktu t (ps) sesuai jadwal kasus.
+ */
+static bool trigger_active(const burst_case *c, uint64_t start_ps, uint64_t t_ps)
+{
+    bool active = false;
+    for (uint i = 0; i < c->edge_count; ++i)
+    {
+        if (t_ps >= start_ps + c->edge_us[i] * 1000000ull)
+        {
+            active = !active;
+        }
+    }
+    return active;
+}
+
+/**
+ * @brief Waktu edge aktif pertama setelah t (ps), atau UINT64_MAX.
+ */
+static uint64_t next_activation(const burst_case *c, uint64_t start_ps, uint64_t t_ps)
+{
+    for (uint i = 0; i < c->edge_count; i += 2)
+    {
+        uint64_t at = start_ps + c->edge_us[i] * 1000000ull;
+        if (at > t_ps)
+        {
+            return at;
+        }
+    }
+    return UINT64_MAX;
+}
+
+/**
+ * @brief Model referensi: waktu awal periode (ps) yang seharusnya keluar.
+ *
+ * Level trigger di-sampling di awal setiap periode. Burst berikutnya dimulai
+ * oleh edge aktif setelah awal periode terakhir (N-siklus/retrigger) atau
+ * setelah batas periode yang menutup gate, tetapi tidak sebelum periode
+ * terakhir selesai.
+ */
+static uint expected_starts(const burst_case *c, uint64_t start_ps, double cycle_ps, uint64_t period_cycles,
+                            uint64_t end_ps, uint64_t *starts)
+{
+    uint64_t period_ps = (uint64_t)llround((double)period_cycles * cycle_ps);
+    uint64_t lat_ps = (uint64_t)llround(latency_cycles[c->mode] * cycle_ps);
+    uint n = 0;
+    uint64_t after = 0;
+    uint64_t earliest = 0;
+    while (n < MAX_RISES)
+    {
+        uint64_t trig = next_activation(c, start_ps, after);
+        if (trig == UINT64_MAX)
+        {
+            break;
+        }
+        uint64_t s = trig + lat_ps > earliest ? trig + lat_ps : earliest;
+        uint32_t remaining = c->periods - 1;
+        while (s < end_ps && n < MAX_RISES)
+        {
+            starts[n++] = s;
+            s += period_ps;
+            if (c->mode == SG_BURST_GATED)
+            {
+                if (!trigger_active(c, start_ps, s))
+                {
+                    break;
+                }
+                continue;
+            }
+            if (c->mode == SG_BURST_RETRIGGER && trigger_active(c, start_ps, starts[n - 1]))
+            {
+                remaining = c->periods - 1;
+            }
+            else if (remaining-- == 0)
+            {
+                break;
+            }
+        }
+        if (s >= end_ps)
+        {
+            break;
+        }
+        after = c->mode == SG_BURST_GATED ? s : starts[n - 1];
+        earliest = s;
+    }
+    return n;
+}
+
+static bool run_case(const burst_case *c)
+{
+    fake_hw_reset();
+    fake_hw_log_set_enabled(false);
+    memset(&ch1, 0, sizeof(ch1));
+    fake_hw_set_pin_listener(on_pins, NULL);
+
+    gpio_init(c->trigger_pin);
+    gpio_set_dir(c->trigger_pin, GPIO_IN);
+    if (c->active_high)
+    {
+        fake_hw_gpio_set_input(c->trigger_pin, false);
+    }
+    else
+    {
+        gpio_pull_up(c->trigger_pin);
+    }
+
+    sg_burst_instance b;
+    const sg_timing_config timing = {
+        .frequency_hz = 10000.0f,
+        .pulse_width_us = 2.0f,
+        .phase_shift_us = 1.0f,
+        .pio_clk_div = c->pio_clk_div,
+    };
+    if (!sg_burst_init(&b, pio0, PIN_BASE, c->trigger_pin, c->active_high) ||
+        !sg_burst_configure(&b, &timing, c->mode, c->periods))
+    {
+        printf("%s: konfigurasi ditolak\n", c->name);
+        return false;
+    }
+    sg_count_instance counter;
+    sg_count_init(&counter);
+    if (!sg_count_start_sm(&counter, b.pio, b.sm, SG_COUNT_DEFAULT_INTERVAL, NULL, NULL))
+    {
+        printf("%s: penghitung gagal\n", c->name);
+        return false;
+    }
+
+    // Jadwal trigger relatif terhadap start_us; CPU diam dengan interrupt
+    // mati sejak sg_burst_start() sehingga seluruh keputusan diambil PIO
+    uint64_t start_us = fake_hw_now_ps() / 1000000ull + 1;
+    for (uint i = 0; i < c->edge_count; ++i)
+    {
+        bool active = (i % 2) == 0;
+        fake_hw_gpio_schedule(c->trigger_pin, active == c->active_high, start_us + c->edge_us[i]);
+    }
+    uint32_t status = save_and_disable_interrupts();
+    sg_burst_start(&b);
+    fake_hw_advance_us(start_us + c->run_us - fake_hw_now_ps() / 1000000ull);
+    restore_interrupts(status);
+    uint64_t start_ps = start_us * 1000000ull;
+    uint64_t end_ps = fake_hw_now_ps();
+    bool outputs_low = c->mode == SG_BURST_CONTINUOUS || (fake_hw_gpio_levels() & PIN_MASK) == 0;
+    uint64_t counted = sg_count_periods(&counter);
+    sg_count_stop(&counter);
+    sg_burst_stop(&b);
+    bool stopped_low = (fake_hw_gpio_levels() & PIN_MASK) == 0;
+    fake_hw_set_pin_listener(NULL, NULL);
+    sg_burst_deinit(&b);
+    bool inover_restored = gpio_get(c->trigger_pin) == !c->active_high;
+
+    double pio_clk_hz = (double)clock_get_hz(clk_sys) / c->pio_clk_div;
+    double cycle_ps = 1e12 / pio_clk_hz;
+    uint64_t period_cycles = (uint64_t)floor(pio_clk_hz / timing.frequency_hz);
+    uint64_t starts[MAX_RISES];
+    uint expected;
+    if (c->mode == SG_BURST_CONTINUOUS)
+    {
+        // Tanpa trigger: hanya jarak antar periode yang diperiksa
+        uint64_t first = ch1.count ? ch1.time_ps[0] : end_ps;
+        uint64_t period_ps = (uint64_t)llround((double)period_cycles * cycle_ps);
+        expected = 0;
+        for (uint64_t t = first; t < end_ps && expected < MAX_RISES; t += period_ps)
+        {
+            starts[expected++] = t;
+        }
+    }
+    else
+    {
+        expected = expected_starts(c, start_ps, cycle_ps, period_cycles, end_ps, starts);
+    }
+
+    // Bandingkan setiap awal periode dalam siklus PIO; trigger asinkron
+    // terhadap clock PIO sehingga selisihnya di [0, 1)
+    bool match = ch1.count == expected;
+    double worst = 0.0;
+    for (uint i = 0; i < ch1.count && i < expected; ++i)
+    {
+        double diff = ((double)ch1.time_ps[i] - (double)starts[i]) / cycle_ps;
+        if (fabs(diff - 0.5) > fabs(worst - 0.5))
+        {
+            worst = diff;
+        }
+        if (diff < -1e-6 || diff >= 1.0)
+        {
+            match = false;
+        }
+    }
+    // Token didorong di awal event D, jadi periode yang sedang berjalan di
+    // akhir mode kontinu boleh belum terhitung
+    bool counted_ok = counted == ch1.count || (c->mode == SG_BURST_CONTINUOUS && counted + 1 == ch1.count);
+
+    bool ok = match && outputs_low && stopped_low && counted_ok && inover_restored;
+    printf("%s: %u periode (model %u), selisih terburuk %.3f siklus PIO, token %llu%s%s%s\n", c->name, ch1.count,
+           expected, worst, (unsigned long long)counted, outputs_low ? "" : ", output tidak LOW di akhir burst",
+           stopped_low ? "" : ", output tidak LOW setelah stop", inover_restored ? "" : ", INOVER tidak dipulihkan");
+    if (!match)
+    {
+        for (uint i = 0; i < ch1.count || i < expected; ++i)
+        {
+            printf("  #%u terukur %.3f us, model %.3f us\n", i, i < ch1.count ? (double)(ch1.time_ps[i] - start_ps) * 1e-6 : -1.0,
+                   i < expected ? (double)(starts[i] - start_ps) * 1e-6 : -1.0);
+        }
+    }
+    printf("  %s\n", ok ? "OK" : "GAGAL");
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 1)
+    {
+        fprintf(stderr, "pemakaian: %s\n", argv[0]);
+        return 2;
+    }
+
+    // Edge trigger sengaja tidak sejajar dengan batas periode (100 us)
+    const burst_case cases[] = {
+        {"continuous", SG_BURST_CONTINUOUS, 0, EXTERNAL_TRIGGER_PIN, true, 1.0f, 0, {0}, 1050},
+        {"gated_ext", SG_BURST_GATED, 0, EXTERNAL_TRIGGER_PIN, true, 1.0f, 4, {37, 453, 811, 1029}, 1500},
+        {"gated_button", SG_BURST_GATED, 0, BUTTON_PIN, false, 12.5f, 2, {121, 387}, 800},
+        {"ncycle_ext", SG_BURST_NCYCLE, 5, EXTERNAL_TRIGGER_PIN, true, 1.0f, 6, {23, 61, 250, 310, 901, 933}, 2000},
+        {"ncycle_button_held", SG_BURST_NCYCLE, 3, BUTTON_PIN, false, 12.5f, 4, {41, 777, 1013, 1047}, 1800},
+        {"retrigger_ext", SG_BURST_RETRIGGER, 4, EXTERNAL_TRIGGER_PIN, true, 1.0f, 6, {17, 29, 243, 371, 1237, 1241},
+         2300},
+        {"retrigger_button", SG_BURST_RETRIGGER, 3, BUTTON_PIN, false, 12.5f, 4, {59, 481, 557, 611}, 1500},
+    };
+
+    bool ok = true;
+    for (uint i = 0; i < count_of(cases); ++i)
+    {
+        ok &= run_case(&cases[i]);
+    }
+
+    printf("%s\n", ok ? "OK" : "GAGAL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,442 @@
+/**
+ * sg_count: pemeriksaan penghitung periode generator di simulasi.
+ *
+ * Generator klasik dijalankan lewat sg_service() dengan penghitung DMA
+ * terpasang. Setiap awal event D (CH2/CH3 turun) dicatat dari pin, lalu:
+ *
+ *   - sg_count_periods() yang dibaca di titik acak harus sama dengan jumlah
+ *     token yang sudah didorong, termasuk saat interrupt sedang dimatikan
+ *     lebih lama dari satu interval (batch yang belum dilayani handler);
+ *   - callback dan interrupt hanya terjadi sekali per interval, tanpa
+ *     pembacaan FIFO RX oleh CPU;
+ *   - latch waktu tidak mendahului token ke-N dan tertinggal paling banyak
+ *     MAX_LATCH_LAG_US di luar jendela interrupt mati;
+ *   - penghitungan 64 bit melewati batas 2^32 dan berlanjut setelah
+ *     sg_count_stop()/sg_count_start() tanpa menghitung periode di antaranya;
+ *   - channel compare dari sg_count_set_compare() menyalin tepat setelah
+ *     token ke-N, penghitungan berlanjut tanpa celah, dan
+ *     sg_count_clear_compare() mengembalikan ping-pong biasa.
+ *
+ * Pemakaian: sg_count
+ * Exit 1 jika ada perbedaan.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fake_hw.h"
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "hardware/sync.h"
+#include "signal_count.h"
+
+#define PIN_BASE 6
+#define PIN_MASK (((1u << SG_NUM_PINS) - 1u) << PIN_BASE)
+#define PIO_CLK_DIV 1.0f
+#define MAX_LATCH_LAG_US 2
+#define MAX_CALLBACKS 4096
+
+// -- Rekaman Awal Event D --
+static struct
+{
+    uint64_t *cycles; // Siklus clk_sys saat CH2/CH3 turun
+    size_t count;
+    size_t capacity;
+    uint32_t levels;
+} d_starts;
+
+static void on_pins(void *ctx, uint64_t time_ps, uint32_t levels, uint32_t changed)
+{
+    (void)ctx;
+    (void)time_ps;
+    if (!(changed & PIN_MASK))
+    {
+        return;
+    }
+    uint32_t now = (levels & PIN_MASK) >> PIN_BASE;
+    if (d_starts.levels == 0x6 && now == 0)
+    {
+        if (d_starts.count == d_starts.capacity)
+        {
+            d_starts.capacity = d_starts.capacity ? 2 * d_starts.capacity : 4096;
+            d_starts.cycles = realloc(d_starts.cycles, d_starts.capacity * sizeof(uint64_t));
+            if (!d_starts.cycles)
+            {
+                fprintf(stderr, "sg_count: memori habis\n");
+                exit(2);
+            }
+        }
+        d_starts.cycles[d_starts.count++] = fake_hw_sys_cycles();
+    }
+    d_starts.levels = now;
+}
+
+/**
+ * @brief Jumlah token yang sudah didorong sampai siklus `cycle`: `push`
+ *        dieksekusi satu siklus PIO setelah `set pins, 0` event D.
+ */
+static uint64_t tokens_at(uint64_t cycle, size_t first)
+{
+    uint64_t n = 0;
+    for (size_t i = first; i < d_starts.count && d_starts.cycles[i] + (uint64_t)PIO_CLK_DIV <= cycle; ++i)
+    {
+        n++;
+    }
+    return n;
+}
+
+// -- Rekaman Callback --
+typedef struct
+{
+    uint64_t periods;
+    uint64_t time_us;
+} callback_record;
+
+static struct
+{
+    callback_record items[MAX_CALLBACKS];
+    uint count;
+} callbacks;
+
+static void on_count(void *ctx, uint64_t periods, uint64_t time_us)
+{
+    (void)ctx;
+    if (callbacks.count < MAX_CALLBACKS)
+    {
+        callbacks.items[callbacks.count++] = (callback_record){periods, time_us};
+    }
+}
+
+// -- Kasus Uji --
+
+typedef struct
+{
+    const char *name;
+    uint32_t interval;      // Periode per callback
+    uint64_t base;          // Jumlah periode awal (uji batas 32 bit)
+    uint64_t run_us;        // Lama generator berjalan per sesi hitung
+    uint64_t blocked_us;    // Lama interrupt dimatikan di tengah sesi pertama
+} count_case;
+
+typedef struct
+{
+    uint samples;
+    uint sample_errors;
+    uint64_t blocked_from_us;
+    uint64_t blocked_to_us;
+} run_stats;
+
+static uint32_t lcg_state = 12345u;
+
+static uint32_t lcg_next(void)
+{
+    lcg_state = lcg_state * 1664525u + 1013904223u;
+    return lcg_state >> 8;
+}
+
+/**
+ * @brief Membandingkan sg_count_periods() dengan token dari pin.
+ */
+static void sample(const sg_count_instance *cnt, uint64_t expected_base, size_t first, run_stats *st)
+{
+    uint64_t before = fake_hw_sys_cycles();
+    uint64_t got = sg_count_periods(cnt);
+    uint64_t after = fake_hw_sys_cycles();
+    uint64_t lo = expected_base + tokens_at(before, first);
+    uint64_t hi = expected_base + tokens_at(after, first);
+    st->samples++;
+    if (got < lo || got > hi)
+    {
+        if (st->sample_errors < 5)
+        {
+            printf("  sampel siklus %llu: %llu periode, seharusnya %llu..%llu\n", (unsigned long long)before,
+                   (unsigned long long)got, (unsigned long long)lo, (unsigned long long)hi);
+        }
+        st->sample_errors++;
+    }
+}
+
+/**
+ * @brief Menjalankan generator selama run_us sambil mengambil sampel acak.
+ *
+ * Jika blocked_us != 0, interrupt dimatikan selama blocked_us di tengah run.
+ */
+static void run_generator(sg_instance *gen, const sg_count_instance *cnt, uint64_t run_us, uint64_t blocked_us,
+                          uint64_t expected_base, size_t first, run_stats *st)
+{
+    uint64_t start_ps = fake_hw_now_ps();
+    uint64_t stop_ps = start_ps + run_us * 1000000ull;
+    uint64_t block_at_ps = blocked_us ? start_ps + (run_us - blocked_us) / 2 * 1000000ull : UINT64_MAX;
+    uint64_t next_sample_ps = start_ps;
+    bool blocked = false;
+    uint32_t status = 0;
+    while (fake_hw_now_ps() < stop_ps)
+    {
+        sg_service(gen);
+        uint64_t now_ps = fake_hw_now_ps();
+        if (!blocked && now_ps >= block_at_ps)
+        {
+            status = save_and_disable_interrupts();
+            blocked = true;
+            st->blocked_from_us = now_ps / 1000000ull;
+        }
+        else if (blocked && block_at_ps != UINT64_MAX && now_ps >= block_at_ps + blocked_us * 1000000ull)
+        {
+            sample(cnt, expected_base, first, st);
+            restore_interrupts(status);
+            blocked = false;
+            block_at_ps = UINT64_MAX;
+            st->blocked_to_us = fake_hw_now_ps() / 1000000ull + 1;
+        }
+        if (now_ps >= next_sample_ps && sg_count_is_running(cnt))
+        {
+            sample(cnt, expected_base, first, st);
+            next_sample_ps = now_ps + (lcg_next() % 40000u) * 1000ull; // 0..40 us
+        }
+    }
+}
+
+static bool run_case(const count_case *c)
+{
+    fake_hw_reset();
+    fake_hw_log_set_enabled(false);
+    memset(&d_starts, 0, sizeof(d_starts));
+    callbacks.count = 0;
+    fake_hw_set_pin_listener(on_pins, NULL);
+
+    sg_instance gen;
+    const sg_timing_config timing = {
+        .frequency_hz = 100000.0f,
+        .pulse_width_us = 2.0f,
+        .phase_shift_us = 1.0f,
+        .pio_clk_div = PIO_CLK_DIV,
+    };
+    sg_count_instance cnt;
+    sg_count_init(&cnt);
+    cnt.base = c->base;
+    if (!sg_init(&gen, pio0, PIN_BASE) || !sg_configure(&gen, &timing) ||
+        !sg_count_start(&cnt, &gen, c->interval, on_count, NULL))
+    {
+        printf("%s: inisialisasi gagal\n", c->name);
+        return false;
+    }
+    uint32_t cycles_per_us = clock_get_hz(clk_sys) / 1000000u;
+
+    // Sesi 1: hitung dari awal, dengan jendela interrupt mati
+    run_stats st = {0};
+    fake_hw_log_set_enabled(true);
+    fake_hw_log_clear();
+    sg_start(&gen);
+    run_generator(&gen, &cnt, c->run_us, c->blocked_us, c->base, 0, &st);
+    sg_stop(&gen);
+    fake_hw_advance_us(20); // Token periode terakhir sudah pasti didorong atau tidak
+    uint64_t session1 = d_starts.count;
+    sample(&cnt, c->base, 0, &st);
+    size_t cpu_pulls = fake_hw_log_count_matching(FAKE_HW_LOG_FIFO_PULL, NULL);
+    fake_hw_log_set_enabled(false);
+    uint32_t interrupts = cnt.interrupts;
+    uint callbacks_session1 = callbacks.count;
+    sg_count_stop(&cnt);
+    uint64_t after_stop = sg_count_periods(&cnt);
+
+    // Periode tanpa penghitung tidak boleh ikut terhitung
+    sg_start(&gen);
+    run_generator(&gen, &cnt, c->run_us / 4, 0, after_stop, d_starts.count, &(run_stats){0});
+    sg_stop(&gen);
+    bool stopped_ok = sg_count_periods(&cnt) == after_stop;
+
+    // Sesi 2: lanjut dari jumlah sebelumnya
+    fake_hw_advance_us(20);
+    size_t first2 = d_starts.count;
+    sg_count_start(&cnt, &gen, c->interval, on_count, NULL);
+    sg_start(&gen);
+    run_generator(&gen, &cnt, c->run_us / 2, 0, after_stop, first2, &st);
+    sg_stop(&gen);
+    fake_hw_advance_us(20);
+    sample(&cnt, after_stop, first2, &st);
+    uint64_t final = sg_count_periods(&cnt);
+    sg_count_stop(&cnt);
+    sg_deinit(&gen);
+    fake_hw_set_pin_listener(NULL, NULL);
+
+    // Callback: satu per interval, jumlah periode kelipatan interval dari
+    // basis sesi, latch tidak mendahului token ke-N
+    uint expected_callbacks_1 = (uint)(session1 / c->interval);
+    uint64_t session2 = d_starts.count - first2;
+    uint expected_callbacks_2 = (uint)(session2 / c->interval);
+    uint callback_errors = 0;
+    uint64_t max_lag_us = 0;
+    for (uint i = 0; i < callbacks.count; ++i)
+    {
+        bool second = i >= callbacks_session1;
+        uint k = second ? i - callbacks_session1 : i;
+        uint64_t base = second ? after_stop : c->base;
+        size_t first = second ? first2 : 0;
+        uint64_t want = base + (uint64_t)(k + 1) * c->interval;
+        size_t token_index = first + (size_t)(k + 1) * c->interval - 1;
+        uint64_t token_us = (d_starts.cycles[token_index] + (uint64_t)PIO_CLK_DIV) / cycles_per_us;
+        const callback_record *r = &callbacks.items[i];
+        bool in_block = !second && r->time_us >= st.blocked_from_us && r->time_us <= st.blocked_to_us;
+        uint64_t lag = r->time_us >= token_us ? r->time_us - token_us : UINT64_MAX;
+        if (!in_block && lag != UINT64_MAX && lag > max_lag_us)
+        {
+            max_lag_us = lag;
+        }
+        if (r->periods != want || lag == UINT64_MAX || (!in_block && lag > MAX_LATCH_LAG_US))
+        {
+            if (callback_errors < 5)
+            {
+                printf("  callback %u: %llu periode @ %llu us, seharusnya %llu periode, token @ %llu us\n", i,
+                       (unsigned long long)r->periods, (unsigned long long)r->time_us, (unsigned long long)want,
+                       (unsigned long long)token_us);
+            }
+            callback_errors++;
+        }
+    }
+    uint64_t latch_periods = 0;
+    sg_count_last_latch(&cnt, &latch_periods, NULL);
+    bool latch_ok = callbacks.count > 0 && latch_periods == callbacks.items[callbacks.count - 1].periods;
+
+    bool counts_ok = final == after_stop + session2 && after_stop == c->base + session1;
+    bool wakeups_ok = interrupts == expected_callbacks_1 && callbacks_session1 == expected_callbacks_1 &&
+                      callbacks.count == expected_callbacks_1 + expected_callbacks_2 && cpu_pulls == 0;
+    bool ok = counts_ok && stopped_ok && wakeups_ok && latch_ok && callback_errors == 0 && st.sample_errors == 0;
+
+    printf("%s: interval %u, basis %llu\n", c->name, c->interval, (unsigned long long)c->base);
+    printf("  periode: sesi 1 %llu, sesi 2 %llu, total %llu (seharusnya %llu)%s\n", (unsigned long long)session1,
+           (unsigned long long)session2, (unsigned long long)final,
+           (unsigned long long)(c->base + session1 + session2), stopped_ok ? "" : ", terhitung saat berhenti");
+    printf("  %u sampel, %u berbeda; %u interrupt, %u callback, %zu baca FIFO RX oleh CPU\n", st.samples,
+           st.sample_errors, interrupts, callbacks.count, cpu_pulls);
+    printf("  latch %llu periode, lag maksimal %llu us, %u callback salah\n", (unsigned long long)latch_periods,
+           (unsigned long long)max_lag_us, callback_errors);
+    printf("  %s\n", ok ? "OK" : "GAGAL");
+    free(d_starts.cycles);
+    return ok;
+}
+
+/**
+ * @brief Compare N periode dipasang saat generator berhenti, lalu diamati
+ *        dari token pin; compare kedua dibatalkan sebelum tercapai.
+ */
+static bool run_compare_case(void)
+{
+    const uint32_t interval = 16;
+    const uint32_t n = 37;
+    fake_hw_reset();
+    fake_hw_log_set_enabled(false);
+    memset(&d_starts, 0, sizeof(d_starts));
+    callbacks.count = 0;
+    fake_hw_set_pin_listener(on_pins, NULL);
+
+    sg_instance gen;
+    const sg_timing_config timing = {
+        .frequency_hz = 100000.0f,
+        .pulse_width_us = 2.0f,
+        .phase_shift_us = 1.0f,
+        .pio_clk_div = PIO_CLK_DIV,
+    };
+    sg_count_instance cnt;
+    sg_count_init(&cnt);
+    if (!sg_init(&gen, pio0, PIN_BASE) || !sg_configure(&gen, &timing) ||
+        !sg_count_start(&cnt, &gen, interval, on_count, NULL))
+    {
+        printf("compare: inisialisasi gagal\n");
+        return false;
+    }
+    uint chan = (uint)dma_claim_unused_channel(true);
+    static const uint32_t source = 0x5a5a5a5au;
+    static volatile uint32_t target;
+    run_stats st = {0};
+
+    // Beberapa batch biasa dulu agar compare dipasang di tengah hitungan
+    sg_start(&gen);
+    run_generator(&gen, &cnt, 500, 0, 0, 0, &st);
+    sg_stop(&gen);
+    fake_hw_advance_us(20);
+
+    // Compare: salinan harus muncul tepat saat token ke-N sejak dipasang
+    target = 0;
+    size_t armed_at = d_starts.count;
+    bool set_ok = sg_count_set_compare(&cnt, n, chan, &target, &source);
+    sg_start(&gen);
+    uint64_t prev_cycle = fake_hw_sys_cycles();
+    uint64_t seen_cycle = 0;
+    uint64_t stop_ps = fake_hw_now_ps() + 1000ull * 1000000ull;
+    while (fake_hw_now_ps() < stop_ps)
+    {
+        sg_service(&gen);
+        if (seen_cycle == 0 && target == source)
+        {
+            seen_cycle = fake_hw_sys_cycles();
+        }
+        else if (seen_cycle == 0)
+        {
+            prev_cycle = fake_hw_sys_cycles();
+        }
+        sample(&cnt, 0, 0, &st);
+    }
+    sg_stop(&gen);
+    fake_hw_advance_us(20);
+    bool fired_ok = seen_cycle != 0 && tokens_at(prev_cycle, armed_at) < n && tokens_at(seen_cycle, armed_at) >= n;
+
+    // Compare yang dibatalkan tidak boleh menyalin, hitungan tetap utuh
+    target = 0;
+    bool clear_set_ok = sg_count_set_compare(&cnt, 1000, chan, &target, &source);
+    sg_count_clear_compare(&cnt);
+    uint callbacks_before = callbacks.count;
+    size_t first_clear = d_starts.count;
+    sg_start(&gen);
+    run_generator(&gen, &cnt, 2000, 0, 0, 0, &st);
+    sg_stop(&gen);
+    fake_hw_advance_us(20);
+    sample(&cnt, 0, 0, &st);
+    uint64_t final = sg_count_periods(&cnt);
+    uint64_t cleared_tokens = d_starts.count - first_clear;
+    bool cleared_ok = target == 0 && callbacks.count - callbacks_before >= cleared_tokens / interval;
+
+    sg_count_stop(&cnt);
+    dma_channel_unclaim(chan);
+    sg_deinit(&gen);
+    fake_hw_set_pin_listener(NULL, NULL);
+
+    bool counts_ok = final == d_starts.count;
+    bool ok = set_ok && clear_set_ok && fired_ok && cleared_ok && counts_ok && st.sample_errors == 0;
+    printf("compare: interval %u, compare %u periode\n", interval, n);
+    printf("  salinan %s setelah %llu..%llu token%s\n", seen_cycle ? "muncul" : "tidak muncul",
+           (unsigned long long)tokens_at(prev_cycle, armed_at), (unsigned long long)tokens_at(seen_cycle, armed_at),
+           cleared_ok ? "" : ", compare yang dibatalkan masih aktif");
+    printf("  periode %llu (seharusnya %llu), %u sampel, %u berbeda\n", (unsigned long long)final,
+           (unsigned long long)d_starts.count, st.samples, st.sample_errors);
+    printf("  %s\n", ok ? "OK" : "GAGAL");
+    free(d_starts.cycles);
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 1)
+    {
+        fprintf(stderr, "pemakaian: %s\n", argv[0]);
+        return 2;
+    }
+
+    // 100 kHz: interrupt dimatikan lebih lama dari satu interval tetapi
+    // kurang dari dua, sehingga satu batch menunggu handler
+    const count_case cases[] = {
+        {"interval_64", 64, 0, 40000, 1000},
+        {"wrap_32bit", 1000, (1ull << 32) - 1500, 60000, 15000},
+    };
+
+    bool ok = true;
+    for (uint i = 0; i < count_of(cases); ++i)
+    {
+        ok &= run_case(&cases[i]);
+    }
+    ok &= run_compare_case();
+    printf("%s\n", ok ? "OK" : "GAGAL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,269 @@
+/**
+ * sg_discipline: pemeriksaan disiplin frekuensi terhadap referensi eksternal
+ * (signal_discipline + sg_trim_clock) di simulasi.
+ *
+ * Kesalahan kristal disimulasikan dengan menggeser periode referensi: jika
+ * clk_sys lebih cepat `ppm`, satu detik referensi memakan (1 + ppm) detik
+ * simulasi. Diperiksa:
+ *   - dither event D: frekuensi rata-rata output mengikuti sg_trim_clock()
+ *     sampai beberapa ppb, termasuk dengan clock divider pecahan dan saat
+ *     stage sg_stage() yang belum diterapkan ikut dikoreksi,
+ *   - estimasi ppm dari referensi 1 kHz (PPS yang dipercepat) dan 10 MHz
+ *     mencapai LOCKED dan cocok dengan kesalahan yang disimulasikan,
+ *   - frekuensi output dalam waktu referensi tepat setelah trim diterapkan,
+ *   - referensi hilang -> HOLDOVER dengan estimasi tetap, lalu kembali
+ *     terkunci setelah gerbang yang terpotong ditolak.
+ *
+ * Pemakaian: sg_discipline
+ * Exit 1 jika ada perbedaan.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "fake_hw.h"
+#include "hardware/gpio.h"
+#include "signal_discipline.h"
+
+#define PIN_CH1_BASE 6
+#define REF_PIN 20
+#define LOOP_STEP_US 20
+
+// -- Edge Naik CH1 dalam Jendela Pengukuran --
+static struct
+{
+    bool level;
+    bool measuring;
+    uint64_t first_ps;
+    uint64_t last_ps;
+    uint32_t rises;
+} ch1;
+
+static void on_pins(void *ctx, uint64_t time_ps, uint32_t levels, uint32_t changed)
+{
+    (void)ctx;
+    if (!(changed & (1u << PIN_CH1_BASE)))
+    {
+        return;
+    }
+    bool level = (levels >> PIN_CH1_BASE) & 1u;
+    if (level && !ch1.level && ch1.measuring)
+    {
+        if (ch1.rises == 0)
+        {
+            ch1.first_ps = time_ps;
+        }
+        ch1.last_ps = time_ps;
+        ch1.rises++;
+    }
+    ch1.level = level;
+}
+
+/**
+ * @brief Loop firmware: layani FIFO generator, poll disiplin, terapkan trim.
+ */
+static void run_loop(sg_instance *gen, sg_discipline_instance *d, uint64_t duration_us)
+{
+    for (uint64_t t = 0; t < duration_us; t += LOOP_STEP_US)
+    {
+        fake_hw_advance_us(LOOP_STEP_US);
+        sg_service(gen);
+        if (d && sg_discipline_poll(d) && d->state != SG_DISCIPLINE_NO_REF)
+        {
+            sg_trim_clock(gen, d->ppm);
+        }
+    }
+}
+
+/**
+ * @brief Mengukur periode rata-rata CH1 (detik simulasi) selama duration_us.
+ */
+static double measure_period_s(sg_instance *gen, sg_discipline_instance *d, uint64_t duration_us)
+{
+    ch1.measuring = true;
+    ch1.rises = 0;
+    run_loop(gen, d, duration_us);
+    ch1.measuring = false;
+    if (ch1.rises < 2)
+    {
+        return 0.0;
+    }
+    return (double)(ch1.last_ps - ch1.first_ps) * 1e-12 / (double)(ch1.rises - 1);
+}
+
+static bool start_generator(sg_instance *gen, float frequency_hz, float pio_clk_div)
+{
+    const sg_timing_config timing = {
+        .frequency_hz = frequency_hz,
+        .pulse_width_us = 2.0f,
+        .phase_shift_us = 1.0f,
+        .pio_clk_div = pio_clk_div,
+    };
+    memset(&ch1, 0, sizeof(ch1));
+    fake_hw_set_pin_listener(on_pins, NULL);
+    if (!sg_init(gen, pio0, PIN_CH1_BASE) || !sg_configure(gen, &timing))
+    {
+        return false;
+    }
+    sg_start(gen);
+    return true;
+}
+
+// -- Dither Periode --
+
+/**
+ * @brief Mengukur galat periode setelah trim; jika staged_hz != 0, trim
+ *        dipanggil saat sg_stage() ke staged_hz belum diterapkan.
+ */
+static bool run_dither(const char *name, float frequency_hz, float staged_hz, float pio_clk_div, double ppm)
+{
+    fake_hw_reset();
+    fake_hw_log_set_enabled(false);
+    sg_instance gen;
+    bool ok = start_generator(&gen, frequency_hz, pio_clk_div);
+    if (ok && staged_hz != 0.0f)
+    {
+        sg_timing_config timing = gen.timing;
+        timing.frequency_hz = staged_hz;
+        ok = sg_stage(&gen, &timing);
+        frequency_hz = staged_hz;
+    }
+    if (!ok || !sg_trim_clock(&gen, ppm))
+    {
+        printf("%s: konfigurasi ditolak\n", name);
+        return false;
+    }
+    run_loop(&gen, NULL, 1000);
+    double period_s = measure_period_s(&gen, NULL, 2000000);
+    sg_deinit(&gen);
+    fake_hw_set_pin_listener(NULL, NULL);
+
+    // Trim +ppm berarti clk_sys dianggap lebih cepat, jadi periode simulasi
+    // memanjang. Fase dither menyimpang paling banyak satu siklus PIO dan edge
+    // terukur pada siklus clk_sys, jadi batasnya dua siklus PIO per rentang ukur.
+    double span_s = period_s * (ch1.rises - 1);
+    double limit_ppb = 2.0 * pio_clk_div / 125e6 / span_s * 1e9;
+    double error_ppb = (period_s * frequency_hz / (1.0 + ppm * 1e-6) - 1.0) * 1e9;
+    ok = fabs(error_ppb) < limit_ppb;
+    printf("%s: %.0f Hz, div %.1f, trim %+.3f ppm -> galat periode %+.2f ppb (%u periode)\n  %s\n", name,
+           frequency_hz, pio_clk_div, ppm, error_ppb, ch1.rises - 1, ok ? "OK" : "GAGAL");
+    return ok;
+}
+
+// -- Disiplin Terhadap Referensi --
+
+typedef struct
+{
+    const char *name;
+    double ref_hz;
+    uint32_t edges_per_gate;
+    double crystal_ppm; // Kesalahan clk_sys yang disimulasikan
+    bool dropout;       // Referensi dilepas setelah terkunci
+} discipline_case;
+
+static void drive_reference(const discipline_case *c, uint64_t start_us)
+{
+    uint64_t period_fs = (uint64_t)llround(1e15 / c->ref_hz * (1.0 + c->crystal_ppm * 1e-6));
+    fake_hw_gpio_drive_clock(REF_PIN, start_us * 1000000ull, period_fs, period_fs / 2);
+}
+
+static bool run_discipline(const discipline_case *c)
+{
+    fake_hw_reset();
+    fake_hw_log_set_enabled(false);
+    gpio_init(REF_PIN);
+    gpio_set_dir(REF_PIN, GPIO_IN);
+
+    sg_instance gen;
+    sg_discipline_instance d;
+    if (!start_generator(&gen, 10000.0f, 1.0f) ||
+        !sg_discipline_init(&d, pio1, REF_PIN, (float)c->ref_hz, c->edges_per_gate))
+    {
+        printf("%s: konfigurasi ditolak\n", c->name);
+        return false;
+    }
+    drive_reference(c, 13);
+    sg_discipline_start(&d);
+
+    // Trim diterapkan di setiap estimasi, jadi output langsung diukur setelah terkunci
+    double gate_us = 1e6 * c->edges_per_gate / c->ref_hz;
+    uint64_t lock_limit_us = (uint64_t)(gate_us * (SG_DISCIPLINE_WINDOW + 4));
+    uint64_t waited_us = 0;
+    while (d.state != SG_DISCIPLINE_LOCKED && waited_us < lock_limit_us)
+    {
+        run_loop(&gen, &d, 1000);
+        waited_us += 1000;
+    }
+    bool locked = d.state == SG_DISCIPLINE_LOCKED;
+
+    // Periode output dalam waktu referensi = periode simulasi / (1 + ppm).
+    // Resolusi jendela 16 x 5 ms pada 125 MHz = 200 ppb.
+    double period_s = measure_period_s(&gen, &d, 100000);
+    double output_ppm = (period_s * 10000.0 / (1.0 + c->crystal_ppm * 1e-6) - 1.0) * 1e6;
+    double estimate_error_ppm = d.ppm - c->crystal_ppm;
+    bool ok = locked && fabs(estimate_error_ppm) < 0.3 && fabs(output_ppm) < 0.3;
+    printf("%s: referensi %.0f Hz, %u edge/gerbang, kristal %+.3f ppm\n", c->name, c->ref_hz, c->edges_per_gate,
+           c->crystal_ppm);
+    printf("  %s setelah %llu us, estimasi %+.4f ppm (resolusi %.0f ppb), output %+.4f ppm dari referensi\n",
+           sg_discipline_state_name(d.state), (unsigned long long)waited_us, d.ppm, d.resolution_ppb, output_ppm);
+
+    if (c->dropout)
+    {
+        double held_ppm = d.ppm;
+        fake_hw_gpio_stop_clock(REF_PIN);
+        run_loop(&gen, &d, (uint64_t)(3 * gate_us));
+        bool holdover = d.state == SG_DISCIPLINE_HOLDOVER && d.ppm == held_ppm && gen.clock_ppm == held_ppm;
+
+        uint32_t rejected = d.rejected;
+        drive_reference(c, fake_hw_now_ps() / 1000000u + 7);
+        waited_us = 0;
+        while (d.state != SG_DISCIPLINE_LOCKED && waited_us < lock_limit_us)
+        {
+            run_loop(&gen, &d, 1000);
+            waited_us += 1000;
+        }
+        bool relocked = d.state == SG_DISCIPLINE_LOCKED && d.rejected > rejected &&
+                        fabs(d.ppm - c->crystal_ppm) < 0.3;
+        printf("  referensi hilang: %s, kembali %s setelah %llu us (%u gerbang ditolak), estimasi %+.4f ppm\n",
+               holdover ? "HOLDOVER" : "status salah", sg_discipline_state_name(d.state),
+               (unsigned long long)waited_us, d.rejected, d.ppm);
+        ok &= holdover && relocked;
+    }
+
+    sg_discipline_deinit(&d);
+    sg_deinit(&gen);
+    fake_hw_gpio_stop_clock(REF_PIN);
+    fake_hw_set_pin_listener(NULL, NULL);
+    printf("  %s\n", ok ? "OK" : "GAGAL");
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 1)
+    {
+        fprintf(stderr, "pemakaian: %s\n", argv[0]);
+        return 2;
+    }
+
+    bool ok = true;
+    ok &= run_dither("dither_div1", 10000.0f, 0.0f, 1.0f, 37.123);
+    ok &= run_dither("dither_div12p5", 1000.0f, 0.0f, 12.5f, -58.9071);
+    ok &= run_dither("dither_pending_stage", 10000.0f, 12500.0f, 1.0f, 37.123);
+
+    const discipline_case cases[] = {
+        {"ref_1khz_fast", 1000.0, 5, 42.3, false},
+        {"ref_1khz_slow_dropout", 1000.0, 5, -87.6, true},
+        {"ref_10mhz", 10e6, 50000, 12.5, false},
+    };
+    for (uint i = 0; i < count_of(cases); ++i)
+    {
+        ok &= run_discipline(&cases[i]);
+    }
+
+    printf("%s\n", ok ? "OK" : "GAGAL");
+    return ok ? 0 : 1;
+}
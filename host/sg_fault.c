@@ -0,0 +1,329 @@
+/**
+ * sg_fault: pemeriksaan input fault hardware (signal_fault) di simulasi.
+ *
+ * Generator dijalankan dengan pulsa lebar, lalu fault dijadwalkan saat CH1
+ * sedang HIGH. Untuk setiap kasus diperiksa:
+ *   - keempat output LOW dalam SG_FAULT_REACTION_CYCLES siklus clk_sys
+ *     setelah edge fault, walaupun generator tetap berjalan,
+ *   - tidak ada output yang naik lagi selama fault ter-latch, juga setelah
+ *     input fault kembali tidak aktif,
+ *   - firmware menerima tepat satu laporan (callback), dan latch terbaca
+ *     lewat sg_fault_is_latched() walaupun interrupt sedang mati,
+ *   - sg_fault_clear() ditolak selama fault masih aktif, dan setelah clear
+ *     generator kembali mengeluarkan pulsa,
+ *   - INOVER pin fault aktif-low dipulihkan setelah deinit.
+ * Generator klasik diberi data oleh CPU (sg_run_burst), sedangkan generator
+ * signal_burst kontinu berjalan dengan CPU diam dan interrupt mati.
+ *
+ * Pemakaian: sg_fault
+ * Exit 1 jika ada perbedaan.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "fake_hw.h"
+#include "hardware/clocks.h"
+#include "hardware/gpio.h"
+#include "hardware/sync.h"
+#include "signal_burst.h"
+#include "signal_fault.h"
+
+#define PIN_BASE 6
+#define PIN_MASK (0xfu << PIN_BASE)
+#define EXTERNAL_FAULT_PIN 2
+#define BUTTON_PIN 13
+#define BURST_TRIGGER_PIN 3
+#define FAULT_AT_US 2203  // Di tengah pulsa CH1 periode ketiga
+#define RUN_US 5000
+
+// -- Rekaman Output --
+static struct
+{
+    uint64_t fault_ps;     // Waktu edge fault
+    uint32_t levels;       // Level output terakhir
+    uint32_t before_fault; // Level output sesaat sebelum fault
+    uint64_t low_ps;       // Waktu pertama semua output LOW setelah fault
+    uint rises_after;      // Edge naik output setelah fault
+    uint rises;            // Edge naik CH1 sejak reset rekaman
+} out;
+
+static void on_pins(void *ctx, uint64_t time_ps, uint32_t levels, uint32_t changed)
+{
+    (void)ctx;
+    if (!(changed & PIN_MASK))
+    {
+        return;
+    }
+    uint32_t rising = levels & ~out.levels & PIN_MASK;
+    if (time_ps < out.fault_ps)
+    {
+        out.before_fault = levels & PIN_MASK;
+    }
+    else
+    {
+        if (!out.low_ps && !(levels & PIN_MASK))
+        {
+            out.low_ps = time_ps;
+        }
+        if (rising)
+        {
+            out.rises_after++;
+        }
+    }
+    if (rising & (1u << PIN_BASE))
+    {
+        out.rises++;
+    }
+    out.levels = levels;
+}
+
+// -- Laporan Firmware --
+static struct
+{
+    uint calls;
+    bool outputs_low;
+} report;
+
+static void on_fault(void *ctx, uint64_t time_us)
+{
+    (void)ctx;
+    (void)time_us;
+    report.calls++;
+    report.outputs_low = !(fake_hw_gpio_levels() & PIN_MASK);
+}
+
+static void set_fault(uint pin, bool active_high, bool active)
+{
+    if (active_high || active)
+    {
+        fake_hw_gpio_set_input(pin, active == active_high);
+    }
+    else
+    {
+        fake_hw_gpio_release_input(pin);
+    }
+}
+
+// -- Kasus Uji --
+
+typedef struct
+{
+    const char *name;
+    uint fault_pin;
+    bool active_high; // false = kontak ke ground dengan pull-up
+    bool use_burst;   // true = signal_burst kontinu dengan CPU diam
+} fault_case;
+
+static const sg_timing_config timing = {
+    .frequency_hz = 1000.0f,
+    .pulse_width_us = 400.0f,
+    .phase_shift_us = 50.0f,
+    .pio_clk_div = 12.5f,
+};
+
+static bool run_case(const fault_case *c)
+{
+    fake_hw_reset();
+    fake_hw_log_set_enabled(false);
+    memset(&out, 0, sizeof(out));
+    memset(&report, 0, sizeof(report));
+    out.fault_ps = UINT64_MAX;
+    fake_hw_set_pin_listener(on_pins, NULL);
+
+    gpio_init(c->fault_pin);
+    gpio_set_dir(c->fault_pin, GPIO_IN);
+    if (!c->active_high)
+    {
+        gpio_pull_up(c->fault_pin);
+    }
+    set_fault(c->fault_pin, c->active_high, false);
+
+    sg_instance gen;
+    sg_burst_instance burst;
+    uint gen_sm;
+    if (c->use_burst)
+    {
+        fake_hw_gpio_set_input(BURST_TRIGGER_PIN, false);
+        if (!sg_burst_init(&burst, pio0, PIN_BASE, BURST_TRIGGER_PIN, true) ||
+            !sg_burst_configure(&burst, &timing, SG_BURST_CONTINUOUS, 0))
+        {
+            printf("%s: konfigurasi burst ditolak\n", c->name);
+            return false;
+        }
+        gen_sm = burst.sm;
+    }
+    else
+    {
+        if (!sg_init(&gen, pio0, PIN_BASE) || !sg_configure(&gen, &timing))
+        {
+            printf("%s: konfigurasi ditolak\n", c->name);
+            return false;
+        }
+        gen_sm = gen.sm;
+    }
+
+    sg_fault_instance fault;
+    if (!sg_fault_init(&fault, pio0, PIN_BASE, c->fault_pin, c->active_high, 1u << gen_sm, on_fault, NULL))
+    {
+        printf("%s: sg_fault_init gagal\n", c->name);
+        if (c->use_burst)
+        {
+            sg_burst_deinit(&burst);
+        }
+        else
+        {
+            sg_deinit(&gen);
+        }
+        return false;
+    }
+
+    uint64_t fault_us = fake_hw_now_ps() / 1000000ull + FAULT_AT_US;
+    out.fault_ps = fault_us * 1000000ull;
+    fake_hw_gpio_schedule(c->fault_pin, c->active_high, fault_us);
+
+    bool latched_without_cpu = true;
+    if (c->use_burst)
+    {
+        // Interrupt mati: output dan latch sepenuhnya ditentukan PIO
+        sg_burst_start(&burst);
+        uint32_t status = save_and_disable_interrupts();
+        fake_hw_advance_us(RUN_US);
+        latched_without_cpu = sg_fault_is_latched(&fault) && report.calls == 0;
+        restore_interrupts(status);
+    }
+    else
+    {
+        sg_run_burst(&gen, RUN_US);
+    }
+    bool latched = sg_fault_is_latched(&fault);
+    bool clear_rejected = !sg_fault_clear(&fault);
+
+    // Fault hilang: latch tetap menahan output sampai sg_fault_clear()
+    set_fault(c->fault_pin, c->active_high, false);
+    fake_hw_advance_us(100);
+    bool held = sg_fault_is_latched(&fault) && !(fake_hw_gpio_levels() & PIN_MASK) && out.rises_after == 0;
+    uint rises_during_fault = out.rises_after;
+
+    // Setelah clear generator kembali mengeluarkan pulsa tanpa laporan baru
+    bool cleared = sg_fault_clear(&fault) && !sg_fault_is_latched(&fault);
+    uint rises_before_resume = out.rises;
+    if (c->use_burst)
+    {
+        fake_hw_advance_us(3000);
+        sg_burst_stop(&burst);
+        sg_burst_deinit(&burst);
+    }
+    else
+    {
+        sg_run_burst(&gen, 3000);
+        sg_deinit(&gen);
+    }
+    bool resumed = out.rises > rises_before_resume && report.calls == 1;
+    sg_fault_deinit(&fault);
+    fake_hw_set_pin_listener(NULL, NULL);
+
+    // Pin aktif-low dengan pull-up terbaca HIGH lagi tanpa INOVER
+    bool inover_ok = c->active_high || gpio_get(c->fault_pin);
+
+    uint64_t cycle_ps = 1000000000000ull / clock_get_hz(clk_sys);
+    double reaction = out.low_ps ? (double)(out.low_ps - out.fault_ps) / (double)cycle_ps : -1.0;
+    bool was_high = (out.before_fault >> PIN_BASE) & 1u;
+    // Edge fault jatuh tepat di batas siklus, jadi hasilnya di [reaksi - 1, reaksi]
+    bool reaction_ok = out.low_ps && reaction >= SG_FAULT_REACTION_CYCLES - 1 && reaction <= SG_FAULT_REACTION_CYCLES;
+
+    bool ok = was_high && reaction_ok && rises_during_fault == 0 && latched && latched_without_cpu &&
+              report.calls == 1 && report.outputs_low && clear_rejected && held && cleared && resumed && inover_ok;
+    printf("%s: pin %u %s, %s\n", c->name, c->fault_pin, c->active_high ? "aktif-high" : "aktif-low",
+           c->use_burst ? "signal_burst kontinu, CPU diam" : "generator klasik, feed CPU");
+    printf("  output sebelum fault 0x%lx, reaksi %.1f siklus clk_sys (%.1f ns), %u edge naik selama latch\n",
+           (unsigned long)(out.before_fault >> PIN_BASE), reaction, reaction * (double)cycle_ps * 1e-3,
+           rises_during_fault);
+    printf("  laporan %u%s%s%s%s%s%s%s\n", report.calls, report.outputs_low ? "" : ", output belum LOW saat laporan",
+           latched_without_cpu ? "" : ", latch tanpa CPU salah",
+           clear_rejected ? "" : ", clear diterima saat fault aktif", held ? "" : ", latch lepas sendiri",
+           cleared ? "" : ", clear gagal", resumed ? "" : ", generator tidak lanjut",
+           inover_ok ? "" : ", INOVER tidak dipulihkan");
+    printf("  %s\n", ok ? "OK" : "GAGAL");
+    return ok;
+}
+
+/**
+ * @brief Fault yang sudah aktif saat init langsung menahan output LOW.
+ */
+static bool run_active_at_init(void)
+{
+    fake_hw_reset();
+    fake_hw_log_set_enabled(false);
+    memset(&report, 0, sizeof(report));
+
+    gpio_init(EXTERNAL_FAULT_PIN);
+    gpio_set_dir(EXTERNAL_FAULT_PIN, GPIO_IN);
+    fake_hw_gpio_set_input(EXTERNAL_FAULT_PIN, true);
+
+    sg_instance gen;
+    sg_fault_instance fault;
+    bool ok = sg_init(&gen, pio0, PIN_BASE) && sg_configure(&gen, &timing) &&
+              sg_fault_init(&fault, pio0, PIN_BASE, EXTERNAL_FAULT_PIN, true, 1u << gen.sm, on_fault, NULL);
+    if (ok)
+    {
+        sg_run_burst(&gen, 2000);
+        ok = sg_fault_is_latched(&fault) && report.calls == 1 && !(fake_hw_gpio_levels() & PIN_MASK);
+        sg_fault_deinit(&fault);
+        sg_deinit(&gen);
+    }
+    printf("fault aktif saat init: %s\n", ok ? "OK" : "GAGAL");
+    return ok;
+}
+
+/**
+ * @brief Watchdog yang bernomor lebih rendah dari generator harus ditolak.
+ */
+static bool run_guard_order(void)
+{
+    fake_hw_reset();
+    fake_hw_log_set_enabled(false);
+
+    // Generator di SM 3, SM bebas hanya 0..2
+    pio_claim_sm_mask(pio0, 0x7u);
+    sg_instance gen;
+    bool ok = sg_init(&gen, pio0, PIN_BASE) && gen.sm == 3;
+    for (uint i = 0; i < 3; ++i)
+    {
+        pio_sm_unclaim(pio0, i);
+    }
+    sg_fault_instance fault;
+    ok = ok && !sg_fault_init(&fault, pio0, PIN_BASE, EXTERNAL_FAULT_PIN, true, 1u << gen.sm, NULL, NULL);
+    sg_deinit(&gen);
+    printf("watchdog di bawah SM generator ditolak: %s\n", ok ? "OK" : "GAGAL");
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 1)
+    {
+        fprintf(stderr, "pemakaian: %s\n", argv[0]);
+        return 2;
+    }
+
+    const fault_case cases[] = {
+        {"ext_classic", EXTERNAL_FAULT_PIN, true, false},
+        {"button_classic", BUTTON_PIN, false, false},
+        {"ext_burst", EXTERNAL_FAULT_PIN, true, true},
+        {"button_burst", BUTTON_PIN, false, true},
+    };
+
+    bool ok = true;
+    for (uint i = 0; i < count_of(cases); ++i)
+    {
+        ok &= run_case(&cases[i]);
+    }
+    ok &= run_active_at_init();
+    ok &= run_guard_order();
+
+    printf("%s\n", ok ? "OK" : "GAGAL");
+    return ok ? 0 : 1;
+}
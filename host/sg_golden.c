@@ -0,0 +1,375 @@
+/**
+ * sg_golden: regresi bentuk gelombang terhadap file golden.
+ *
+ * Setiap kasus dalam matriks frekuensi/lebar pulsa/fase/clock divider
+ * dijalankan lewat library signal_gen (atau sequencer signal_seq untuk kasus
+ * seq_*) di atas simulasi PIO. Daftar edge pin output (siklus clk_sys relatif
+ * terhadap enable state machine) dibandingkan persis per siklus dengan file
+ * golden di host/golden.
+ *
+ * Pemakaian:
+ *   sg_golden --check <dir>   bandingkan semua kasus, exit 1 jika ada selisih
+ *   sg_golden --write <dir>   tulis ulang file golden
+ *   sg_golden --print <kasus> cetak daftar edge satu kasus
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fake_hw.h"
+#include "hardware/clocks.h"
+#include "signal_gen.h"
+#include "signal_seq.h"
+
+#define PIN_BASE 6
+#define PIN_COUNT SG_SEQ_MAX_CHANNELS
+#define PERIODS 3
+#define MAX_EDGES 256
+
+typedef struct
+{
+    const char *name;
+    sg_timing_config timing;
+    const sg_seq_config *seq; // Jika tidak NULL, kasus dijalankan lewat sequencer
+} golden_case;
+
+// Pola klasik A/B/C/D yang dinyatakan per kanal; hasilnya harus identik
+// dengan base_1khz_div12p5
+static const sg_seq_config seq_classic = {
+    .frequency_hz = 1000.0f,
+    .pio_clk_div = 12.5f,
+    .num_channels = 4,
+    .channels = {
+        {.delay_us = 0.0f, .width_us = 5.0f},
+        {.delay_us = 10.0f, .width_us = 5.0f},
+        {.delay_us = 10.0f, .width_us = 5.0f},
+        {.delay_us = 0.0f, .width_us = 5.0f},
+    },
+};
+
+// Kanal independen: polaritas terbalik, periode kanal setengah frame, dan
+// pulsa yang membungkus batas frame
+static const sg_seq_config seq_independent = {
+    .frequency_hz = 10000.0f,
+    .pio_clk_div = 1.0f,
+    .num_channels = 4,
+    .channels = {
+        {.delay_us = 0.0f, .width_us = 20.0f},
+        {.delay_us = 10.0f, .width_us = 30.0f, .inverted = true},
+        {.period_us = 50.0f, .delay_us = 5.0f, .width_us = 10.0f},
+        {.delay_us = 90.0f, .width_us = 20.0f},
+    },
+};
+
+// Delapan kanal bertingkat dengan edge bersamaan yang digabung
+static const sg_seq_config seq_8ch = {
+    .frequency_hz = 20000.0f,
+    .pio_clk_div = 2.0f,
+    .num_channels = 8,
+    .channels = {
+        {.delay_us = 1.0f, .width_us = 4.0f},
+        {.delay_us = 5.0f, .width_us = 4.0f},
+        {.delay_us = 9.0f, .width_us = 4.0f},
+        {.delay_us = 13.0f, .width_us = 4.0f},
+        {.delay_us = 17.0f, .width_us = 4.0f},
+        {.delay_us = 21.0f, .width_us = 4.0f},
+        {.delay_us = 25.0f, .width_us = 4.0f},
+        {.delay_us = 29.0f, .width_us = 4.0f},
+    },
+};
+
+// Matriks kasus: konfigurasi produksi, divider pecahan, dan kasus tepi
+// (event lebih pendek dari overhead 4 siklus, fase nol)
+static const golden_case cases[] = {
+    {"base_1khz_div12p5", .timing = {.frequency_hz = 1000.0f, .pulse_width_us = 5.0f, .phase_shift_us = 5.0f, .pio_clk_div = 12.5f}},
+    {"10khz_div1", .timing = {.frequency_hz = 10000.0f, .pulse_width_us = 2.0f, .phase_shift_us = 1.0f, .pio_clk_div = 1.0f}},
+    {"50khz_div1", .timing = {.frequency_hz = 50000.0f, .pulse_width_us = 1.0f, .phase_shift_us = 0.5f, .pio_clk_div = 1.0f}},
+    {"100khz_div2", .timing = {.frequency_hz = 100000.0f, .pulse_width_us = 1.0f, .phase_shift_us = 0.5f, .pio_clk_div = 2.0f}},
+    {"20khz_div2p5", .timing = {.frequency_hz = 20000.0f, .pulse_width_us = 3.0f, .phase_shift_us = 1.0f, .pio_clk_div = 2.5f}},
+    {"min_event_div1", .timing = {.frequency_hz = 200000.0f, .pulse_width_us = 0.04f, .phase_shift_us = 0.04f, .pio_clk_div = 1.0f}},
+    {"sub_overhead_div1", .timing = {.frequency_hz = 100000.0f, .pulse_width_us = 0.016f, .phase_shift_us = 0.016f, .pio_clk_div = 1.0f}},
+    {"zero_phase_div4", .timing = {.frequency_hz = 5000.0f, .pulse_width_us = 10.0f, .phase_shift_us = 0.0f, .pio_clk_div = 4.0f}},
+    {"seq_classic_1khz", .seq = &seq_classic},
+    {"seq_independent_10khz", .seq = &seq_independent},
+    {"seq_8ch_20khz", .seq = &seq_8ch},
+};
+
+typedef struct
+{
+    uint64_t cycle;
+    uint32_t levels;
+} edge;
+
+typedef struct
+{
+    edge edges[MAX_EDGES];
+    uint count;
+    uint64_t start_cycle;
+    uint32_t delays[SG_NUM_EVENTS];
+} run_result;
+
+static void on_pins(void *ctx, uint64_t time_ps, uint32_t levels, uint32_t changed)
+{
+    (void)time_ps;
+    run_result *r = ctx;
+    uint32_t mask = ((1u << PIN_COUNT) - 1u) << PIN_BASE;
+    if (!(changed & mask) || r->count == MAX_EDGES)
+    {
+        return;
+    }
+    r->edges[r->count++] = (edge){.cycle = fake_hw_sys_cycles(), .levels = (levels & mask) >> PIN_BASE};
+}
+
+/**
+ * @brief Menjalankan satu kasus sequencer: lead-in, PERIODS periode penuh lalu stop.
+ */
+static bool run_seq_case(const sg_seq_config *config, run_result *r)
+{
+    sg_seq_instance seq;
+    if (!sg_seq_init(&seq, pio0, PIN_BASE, config->num_channels) || !sg_seq_configure(&seq, config))
+    {
+        return false;
+    }
+    // Kolom delay berisi jumlah event (lead-in, steady-state) dan periode frame
+    const sg_event_list *list = sg_seq_active_list(&seq);
+    r->delays[0] = list->has_lead_in;
+    r->delays[1] = list->count;
+    r->delays[2] = list->period_cycles;
+
+    fake_hw_set_pin_listener(on_pins, r);
+    sg_seq_start(&seq);
+    r->start_cycle = fake_hw_sys_cycles();
+
+    // sg_seq_start() mengisi FIFO yang kosong sampai penuh, termasuk lead-in
+    uint remaining = PERIODS * list->count - (FAKE_PIO_FIFO_DEPTH - (list->has_lead_in ? 1 : 0));
+    for (uint i = 0; i < remaining; ++i)
+    {
+        pio_sm_put_blocking(seq.pio, seq.sm, list->events[seq.next_event]);
+        seq.next_event = (seq.next_event + 1) % list->count;
+    }
+
+    uint64_t frame_cycles = (uint64_t)((double)list->period_cycles * config->pio_clk_div) + 64;
+    fake_hw_advance_cycles(frame_cycles * 2);
+    sg_seq_stop(&seq);
+    fake_hw_set_pin_listener(NULL, NULL);
+    sg_seq_deinit(&seq);
+    return true;
+}
+
+/**
+ * @brief Menjalankan satu kasus: PERIODS periode penuh lalu stop.
+ */
+static bool run_case(const golden_case *c, run_result *r)
+{
+    memset(r, 0, sizeof(*r));
+    fake_hw_reset();
+    fake_hw_log_set_enabled(false);
+    if (c->seq)
+    {
+        return run_seq_case(c->seq, r);
+    }
+
+    sg_instance gen;
+    if (!sg_init(&gen, pio0, PIN_BASE) || !sg_configure(&gen, &c->timing))
+    {
+        return false;
+    }
+    for (uint i = 0; i < SG_NUM_EVENTS; ++i)
+    {
+        r->delays[i] = gen.delays[i];
+    }
+
+    fake_hw_set_pin_listener(on_pins, r);
+    sg_start(&gen);
+    r->start_cycle = fake_hw_sys_cycles();
+
+    // sg_start() sudah mengisi satu periode
+    for (uint p = 1; p < PERIODS; ++p)
+    {
+        for (uint i = 0; i < SG_NUM_EVENTS; ++i)
+        {
+            pio_sm_put_blocking(gen.pio, gen.sm, gen.delays[i]);
+        }
+    }
+
+    // Biarkan periode terakhir selesai, lalu hentikan
+    uint64_t period_cycles = 0;
+    for (uint i = 0; i < SG_NUM_EVENTS; ++i)
+    {
+        period_cycles += gen.delays[i] + (i == SG_NUM_EVENTS - 1 ? SG_EVENT_D_OVERHEAD_CYCLES : SG_EVENT_OVERHEAD_CYCLES);
+    }
+    period_cycles = (uint64_t)((double)period_cycles * c->timing.pio_clk_div) + 64;
+    fake_hw_advance_cycles(period_cycles * 2);
+    sg_stop(&gen);
+    fake_hw_set_pin_listener(NULL, NULL);
+    sg_deinit(&gen);
+    return true;
+}
+
+static void write_edges(FILE *f, const golden_case *c, const run_result *r)
+{
+    if (c->seq)
+    {
+        fprintf(f, "# %s: sequencer %u kanal, %.3f Hz, clkdiv %.4f, sysclk %u Hz\n", c->name, c->seq->num_channels,
+                c->seq->frequency_hz, c->seq->pio_clk_div, SYS_CLK_HZ);
+        fprintf(f, "# lead-in %u, %u event per periode, periode %u siklus PIO; kolom: siklus clk_sys sejak enable, "
+                   "level CH8..CH1\n",
+                r->delays[0], r->delays[1], r->delays[2]);
+    }
+    else
+    {
+        fprintf(f, "# %s: %.3f Hz, pulsa %.3f us, fase %.3f us, clkdiv %.4f, sysclk %u Hz\n", c->name,
+                c->timing.frequency_hz, c->timing.pulse_width_us, c->timing.phase_shift_us, c->timing.pio_clk_div,
+                SYS_CLK_HZ);
+        fprintf(f, "# delay A..D = %u %u %u %u; kolom: siklus clk_sys sejak enable, level CH4..CH1\n",
+                r->delays[0], r->delays[1], r->delays[2], r->delays[3]);
+    }
+    for (uint i = 0; i < r->count; ++i)
+    {
+        fprintf(f, "%llu %x\n", (unsigned long long)(r->edges[i].cycle - r->start_cycle), r->edges[i].levels);
+    }
+}
+
+static char *golden_path(const char *dir, const char *name)
+{
+    static char path[1024];
+    snprintf(path, sizeof(path), "%s/%s.edges", dir, name);
+    return path;
+}
+
+/**
+ * @brief Membandingkan hasil satu kasus dengan file golden.
+ *
+ * @return true jika semua edge sama persis
+ */
+static bool check_case(const char *dir, const golden_case *c, const run_result *r)
+{
+    const char *path = golden_path(dir, c->name);
+    FILE *f = fopen(path, "r");
+    if (!f)
+    {
+        printf("GAGAL %-20s file golden %s tidak ada\n", c->name, path);
+        return false;
+    }
+
+    char line[256];
+    uint index = 0;
+    bool ok = true;
+    while (ok && fgets(line, sizeof(line), f))
+    {
+        if (line[0] == '#' || line[0] == '\n')
+        {
+            continue;
+        }
+        unsigned long long cycle;
+        unsigned levels;
+        if (sscanf(line, "%llu %x", &cycle, &levels) != 2)
+        {
+            printf("GAGAL %-20s baris golden tidak valid: %s", c->name, line);
+            ok = false;
+            break;
+        }
+        if (index >= r->count)
+        {
+            printf("GAGAL %-20s edge #%u hilang (golden: siklus %llu level %x)\n", c->name, index, cycle, levels);
+            ok = false;
+            break;
+        }
+        uint64_t got_cycle = r->edges[index].cycle - r->start_cycle;
+        if (got_cycle != cycle || r->edges[index].levels != levels)
+        {
+            printf("GAGAL %-20s edge #%u: golden siklus %llu level %x, hasil siklus %llu level %x\n", c->name,
+                   index, cycle, levels, (unsigned long long)got_cycle, r->edges[index].levels);
+            ok = false;
+            break;
+        }
+        index++;
+    }
+    if (ok && index != r->count)
+    {
+        printf("GAGAL %-20s %u edge tambahan setelah edge golden terakhir\n", c->name, r->count - index);
+        ok = false;
+    }
+    fclose(f);
+    if (ok)
+    {
+        printf("OK    %-20s %u edge\n", c->name, r->count);
+    }
+    return ok;
+}
+
+static int usage(const char *argv0)
+{
+    fprintf(stderr, "pemakaian: %s --check <dir> | --write <dir> | --print <kasus>\n", argv0);
+    return 2;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 3)
+    {
+        return usage(argv[0]);
+    }
+    const char *mode = argv[1];
+    const char *arg = argv[2];
+    uint failures = 0;
+    bool matched = false;
+
+    for (uint i = 0; i < count_of(cases); ++i)
+    {
+        const golden_case *c = &cases[i];
+        if (strcmp(mode, "--print") == 0 && strcmp(arg, c->name) != 0)
+        {
+            continue;
+        }
+        matched = true;
+
+        run_result r;
+        if (!run_case(c, &r))
+        {
+            printf("GAGAL %-20s konfigurasi ditolak oleh sg_configure()\n", c->name);
+            failures++;
+            continue;
+        }
+
+        if (strcmp(mode, "--check") == 0)
+        {
+            failures += check_case(arg, c, &r) ? 0 : 1;
+        }
+        else if (strcmp(mode, "--write") == 0)
+        {
+            FILE *f = fopen(golden_path(arg, c->name), "w");
+            if (!f)
+            {
+                perror(golden_path(arg, c->name));
+                return 1;
+            }
+            write_edges(f, c, &r);
+            fclose(f);
+            printf("tulis %s\n", golden_path(arg, c->name));
+        }
+        else if (strcmp(mode, "--print") == 0)
+        {
+            write_edges(stdout, c, &r);
+        }
+        else
+        {
+            return usage(argv[0]);
+        }
+    }
+
+    if (!matched)
+    {
+        fprintf(stderr, "kasus '%s' tidak dikenal\n", arg);
+        return 2;
+    }
+    if (failures)
+    {
+        printf("%u kasus gagal\n", failures);
+        return 1;
+    }
+    return 0;
+}
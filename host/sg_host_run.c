@@ -0,0 +1,223 @@
+/**
+ * sg_host_run: menjalankan firmware main.c di atas hardware simulasi.
+ *
+ * Penekanan tombol dijadwalkan pada pin BUTTON_PIN, firmware dijalankan
+ * sampai batas waktu simulasi, lalu edge pada keempat pin output dirangkum
+ * per burst (jumlah periode, periode, lebar pulsa, dead time) bersama
+ * statistik penulisan register dan push FIFO.
+ *
+ * Dengan --expect-bursts, program menjadi pemeriksaan (ctest): exit 1 jika
+ * jumlah burst berbeda atau ada burst yang tidak berakhir dengan semua
+ * output LOW.
+ *
+ * Pemakaian: sg_host_run [--press <ms>]... [--hold <ms>] [--until <ms>] [--expect-bursts <n>]
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fake_hw.h"
+#include "signal_gen.h"
+
+// Konstanta dan entry firmware dari main.c (main di-rename menjadi firmware_main)
+extern const uint PIN_CH1_BASE;
+extern const uint BUTTON_PIN;
+int firmware_main(void);
+
+#define MAX_PRESSES 32
+
+typedef struct
+{
+    uint64_t time_ps;
+    uint32_t levels; // Level keempat pin output (bit 0 = CH1)
+} edge;
+
+static edge *edges;
+static size_t edge_count;
+static size_t edge_capacity;
+
+static void on_pins(void *ctx, uint64_t time_ps, uint32_t levels, uint32_t changed)
+{
+    (void)ctx;
+    uint32_t mask = ((1u << SG_NUM_PINS) - 1u) << PIN_CH1_BASE;
+    if (!(changed & mask))
+    {
+        return;
+    }
+    if (edge_count == edge_capacity)
+    {
+        edge_capacity = edge_capacity ? edge_capacity * 2 : 4096;
+        edges = realloc(edges, edge_capacity * sizeof(*edges));
+    }
+    edges[edge_count++] = (edge){.time_ps = time_ps, .levels = (levels & mask) >> PIN_CH1_BASE};
+}
+
+static double ps_to_us(uint64_t ps)
+{
+    return (double)ps / 1e6;
+}
+
+/**
+ * @brief Merangkum satu burst: edge [first, last).
+ *
+ * @return true jika burst berakhir dengan semua output LOW
+ */
+static bool report_burst(uint index, size_t first, size_t last)
+{
+    uint periods = 0;
+    uint64_t first_rise = 0, last_rise = 0;
+    uint64_t ch1_high = 0, deadtime = 0, ch2_high = 0;
+    uint64_t ch1_fall = 0;
+    bool have_ch1_width = false, have_deadtime = false, have_ch2_width = false;
+    uint64_t ch2_rise = 0;
+
+    for (size_t i = first; i < last; ++i)
+    {
+        uint32_t prev = i > 0 ? edges[i - 1].levels : 0;
+        uint32_t now = edges[i].levels;
+        uint32_t rise = now & ~prev;
+        uint32_t fall = prev & ~now;
+        if (rise & 0x1u)
+        {
+            if (periods == 0)
+            {
+                first_rise = edges[i].time_ps;
+            }
+            last_rise = edges[i].time_ps;
+            periods++;
+        }
+        if ((fall & 0x1u) && periods == 1)
+        {
+            ch1_fall = edges[i].time_ps;
+            ch1_high = ch1_fall - first_rise;
+            have_ch1_width = true;
+        }
+        if ((rise & 0x2u) && periods == 1 && have_ch1_width)
+        {
+            ch2_rise = edges[i].time_ps;
+            deadtime = ch2_rise - ch1_fall;
+            have_deadtime = true;
+        }
+        if ((fall & 0x2u) && periods == 1 && have_deadtime)
+        {
+            ch2_high = edges[i].time_ps - ch2_rise;
+            have_ch2_width = true;
+        }
+    }
+
+    double period_us = periods > 1 ? ps_to_us(last_rise - first_rise) / (periods - 1) : 0.0;
+    printf("  burst %u: mulai %.3f ms, durasi %.3f ms, %u periode, periode %.4f us\n", index,
+           ps_to_us(edges[first].time_ps) / 1000.0,
+           ps_to_us(edges[last - 1].time_ps - edges[first].time_ps) / 1000.0, periods, period_us);
+    printf("           CH1/CH4 high %.3f us, dead time %.3f us, CH2/CH3 high %.3f us, output akhir 0x%x\n",
+           have_ch1_width ? ps_to_us(ch1_high) : 0.0, have_deadtime ? ps_to_us(deadtime) : 0.0,
+           have_ch2_width ? ps_to_us(ch2_high) : 0.0, edges[last - 1].levels);
+    return edges[last - 1].levels == 0;
+}
+
+/**
+ * @brief Merangkum semua burst.
+ *
+ * @param all_idle Diisi false jika ada burst yang tidak berakhir LOW
+ * @return Jumlah burst
+ */
+static uint report(bool *all_idle)
+{
+    *all_idle = true;
+    printf("\nedge output: %zu\n", edge_count);
+    if (edge_count == 0)
+    {
+        return 0;
+    }
+
+    // Burst dipisahkan oleh jeda tanpa edge lebih dari 100 ms
+    const uint64_t gap_ps = 100ull * 1000000000ull;
+    size_t first = 0;
+    uint index = 0;
+    for (size_t i = 1; i <= edge_count; ++i)
+    {
+        if (i == edge_count || edges[i].time_ps - edges[i - 1].time_ps > gap_ps)
+        {
+            *all_idle &= report_burst(index++, first, i);
+            first = i;
+        }
+    }
+
+    printf("log: %zu push FIFO, %zu penulisan register (CTRL %zu, SM_CLKDIV %zu, CLK_SYS_HZ %zu)\n",
+           fake_hw_log_count_matching(FAKE_HW_LOG_FIFO_PUSH, NULL),
+           fake_hw_log_count_matching(FAKE_HW_LOG_REG_WRITE, NULL),
+           fake_hw_log_count_matching(FAKE_HW_LOG_REG_WRITE, "CTRL"),
+           fake_hw_log_count_matching(FAKE_HW_LOG_REG_WRITE, "SM_CLKDIV"),
+           fake_hw_log_count_matching(FAKE_HW_LOG_REG_WRITE, "CLK_SYS_HZ"));
+    return index;
+}
+
+int main(int argc, char **argv)
+{
+    uint64_t presses_ms[MAX_PRESSES];
+    uint press_count = 0;
+    uint64_t hold_ms = 50;
+    uint64_t until_ms = 0;
+    long expect_bursts = -1;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--press") == 0 && i + 1 < argc && press_count < MAX_PRESSES)
+        {
+            presses_ms[press_count++] = strtoull(argv[++i], NULL, 0);
+        }
+        else if (strcmp(argv[i], "--hold") == 0 && i + 1 < argc)
+        {
+            hold_ms = strtoull(argv[++i], NULL, 0);
+        }
+        else if (strcmp(argv[i], "--until") == 0 && i + 1 < argc)
+        {
+            until_ms = strtoull(argv[++i], NULL, 0);
+        }
+        else if (strcmp(argv[i], "--expect-bursts") == 0 && i + 1 < argc)
+        {
+            expect_bursts = strtol(argv[++i], NULL, 0);
+        }
+        else
+        {
+            fprintf(stderr, "pemakaian: %s [--press <ms>]... [--hold <ms>] [--until <ms>] [--expect-bursts <n>]\n",
+                    argv[0]);
+            return 2;
+        }
+    }
+    if (press_count == 0)
+    {
+        // Skenario bawaan: dua burst terpisah
+        presses_ms[press_count++] = 100;
+        presses_ms[press_count++] = 6000;
+    }
+    if (until_ms == 0)
+    {
+        until_ms = presses_ms[press_count - 1] + 5500;
+    }
+
+    fake_hw_reset();
+    fake_hw_set_pin_listener(on_pins, NULL);
+    for (uint i = 0; i < press_count; ++i)
+    {
+        fake_hw_gpio_schedule(BUTTON_PIN, false, presses_ms[i] * 1000);
+        fake_hw_gpio_schedule(BUTTON_PIN, true, (presses_ms[i] + hold_ms) * 1000);
+    }
+
+    printf("sg_host_run: %u penekanan tombol, simulasi %llu ms\n", press_count, (unsigned long long)until_ms);
+    fake_hw_run_firmware(firmware_main, until_ms * 1000);
+    bool all_idle;
+    uint bursts = report(&all_idle);
+    free(edges);
+    if (expect_bursts < 0)
+    {
+        return 0;
+    }
+    bool ok = bursts == (uint)expect_bursts && all_idle;
+    printf("%u burst (diharapkan %ld), %s\n%s\n", bursts, expect_bursts,
+           all_idle ? "semua berakhir LOW" : "ada output yang tidak kembali LOW", ok ? "OK" : "GAGAL");
+    return ok ? 0 : 1;
+}
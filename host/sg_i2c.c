@@ -0,0 +1,365 @@
+/**
+ * sg_i2c: pemeriksaan register map I2C target (signal_i2c) terhadap master
+ * bus simulasi.
+ *
+ * Generator 10 kHz dilayani sg_i2c_poll() dari loop firmware simulasi
+ * sementara master 400 kHz membaca dan menulis register. Diperiksa:
+ *   - ID, VERSION dan register konfigurasi awal; alamat lain tidak di-ACK,
+ *   - START/STOP/ARM lewat CONTROL dan bit STATUS yang sesuai,
+ *   - tulisan konfigurasi tanpa COMMIT tidak mengubah output; setelah
+ *     COMMIT setiap periode utuh lama atau utuh baru (tidak ada periode
+ *     campuran) dan konfigurasi baru keluar paling lambat periode kedua,
+ *   - commit yang tidak valid ditolak (STATUS.ERROR) tanpa mengubah output,
+ *   - PERIOD_COUNT sama dengan jumlah periode yang terlihat di pin,
+ *   - rentetan pembacaan tidak menggeser satu edge pun.
+ *
+ * Pemakaian: sg_i2c
+ * Exit 1 jika ada perbedaan.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "fake_hw.h"
+#include "hardware/clocks.h"
+#include "hardware/gpio.h"
+#include "signal_i2c.h"
+
+#define PIN_CH1_BASE 6
+#define TRIGGER_PIN 2
+#define SDA_PIN 4
+#define SCL_PIN 5
+#define ADDRESS 0x42
+#define LOOP_STEP_US 5
+#define MAX_PERIODS 4096
+
+// -- Edge CH1: periode (naik ke naik) dan lebar pulsa --
+static struct
+{
+    bool level;
+    uint64_t rise_ps[MAX_PERIODS];
+    uint64_t width_ps[MAX_PERIODS];
+    uint count;
+} ch1;
+
+static void on_pins(void *ctx, uint64_t time_ps, uint32_t levels, uint32_t changed)
+{
+    (void)ctx;
+    if (!(changed & (1u << PIN_CH1_BASE)))
+    {
+        return;
+    }
+    bool level = (levels >> PIN_CH1_BASE) & 1u;
+    if (level && !ch1.level && ch1.count < MAX_PERIODS)
+    {
+        ch1.rise_ps[ch1.count++] = time_ps;
+    }
+    else if (!level && ch1.level && ch1.count > 0)
+    {
+        ch1.width_ps[ch1.count - 1] = time_ps - ch1.rise_ps[ch1.count - 1];
+    }
+    ch1.level = level;
+}
+
+static sg_instance gen;
+static sg_count_instance counter;
+static sg_i2c_instance target;
+
+/**
+ * @brief Loop firmware: hanya sg_i2c_poll(), seperti run_i2c_mode() di main.c.
+ */
+static void run_loop(uint64_t duration_us)
+{
+    for (uint64_t t = 0; t < duration_us; t += LOOP_STEP_US)
+    {
+        fake_hw_advance_us(LOOP_STEP_US);
+        sg_i2c_poll(&target);
+    }
+}
+
+/**
+ * @brief Satu transaksi master sampai selesai sambil loop firmware berjalan.
+ *
+ * @return true jika alamat di-ACK
+ */
+static bool transfer(uint8_t address, const uint8_t *write, size_t write_len, uint8_t *read, size_t read_len)
+{
+    if (!fake_hw_i2c_master_start(0, address, write, write_len, read, read_len))
+    {
+        return false;
+    }
+    while (fake_hw_i2c_master_busy())
+    {
+        run_loop(LOOP_STEP_US);
+    }
+    run_loop(LOOP_STEP_US);
+    return fake_hw_i2c_master_acked();
+}
+
+static bool read_regs(uint8_t reg, uint8_t *data, size_t len)
+{
+    return transfer(ADDRESS, &reg, 1, data, len);
+}
+
+static uint8_t read_status(void)
+{
+    uint8_t status = 0xff;
+    read_regs(SG_I2C_REG_STATUS, &status, 1);
+    return status;
+}
+
+static bool write_control(uint8_t control)
+{
+    uint8_t data[2] = {SG_I2C_REG_CONTROL, control};
+    return transfer(ADDRESS, data, sizeof(data), NULL, 0);
+}
+
+static uint32_t le32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void put_le32(uint8_t *p, uint32_t value)
+{
+    for (uint i = 0; i < 4; ++i)
+    {
+        p[i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+/**
+ * @brief Menulis keempat register konfigurasi, opsional dengan COMMIT di
+ *        transaksi yang sama (CONTROL ditulis dulu, diterapkan saat STOP).
+ */
+static bool write_config(uint32_t freq_mhz, uint32_t width_ns, uint32_t phase_ns, bool commit)
+{
+    uint8_t data[2 + 16];
+    uint8_t *p = data;
+    *p++ = SG_I2C_REG_CONTROL;
+    *p++ = commit ? SG_I2C_CTRL_COMMIT : 0;
+    put_le32(p, freq_mhz);
+    put_le32(p + 4, width_ns);
+    put_le32(p + 8, phase_ns);
+    put_le32(p + 12, 0);
+    return transfer(ADDRESS, data, sizeof(data), NULL, 0);
+}
+
+/**
+ * @brief Periode dan lebar CH1 (siklus clk_sys) dari delay hasil konfigurasi.
+ */
+static void expected_shape(float freq_hz, float width_us, float phase_us, uint64_t *period, uint64_t *width)
+{
+    const sg_timing_config timing = {
+        .frequency_hz = freq_hz,
+        .pulse_width_us = width_us,
+        .phase_shift_us = phase_us,
+        .pio_clk_div = 1.0f,
+    };
+    uint32_t delays[SG_NUM_EVENTS];
+    sg_calculate_delays((float)clock_get_hz(clk_sys), &timing, delays);
+    *width = delays[0] + SG_EVENT_OVERHEAD_CYCLES;
+    *period = 0;
+    for (uint i = 0; i < SG_NUM_EVENTS; ++i)
+    {
+        *period += delays[i] + SG_EVENT_OVERHEAD_CYCLES;
+    }
+    *period += SG_EVENT_D_OVERHEAD_CYCLES - SG_EVENT_OVERHEAD_CYCLES;
+}
+
+static uint64_t ps_to_cycles(uint64_t ps)
+{
+    return ps * (clock_get_hz(clk_sys) / 1000000u) / 1000000u;
+}
+
+/**
+ * @brief Memeriksa periode [first, last) satu per satu terhadap satu atau dua
+ *        bentuk; mengembalikan indeks periode pertama berbentuk kedua.
+ *
+ * @return -1 jika ada periode yang bukan salah satu bentuk atau kembali ke
+ *         bentuk pertama setelah berganti
+ */
+static int check_periods(uint first, uint last, uint64_t period_a, uint64_t width_a, uint64_t period_b,
+                         uint64_t width_b, uint *switch_index)
+{
+    *switch_index = last;
+    for (uint i = first; i + 1 < last; ++i)
+    {
+        uint64_t period = ps_to_cycles(ch1.rise_ps[i + 1] - ch1.rise_ps[i]);
+        uint64_t width = ps_to_cycles(ch1.width_ps[i]);
+        bool is_a = period == period_a && width == width_a;
+        bool is_b = period == period_b && width == width_b;
+        if (is_b && *switch_index == last)
+        {
+            *switch_index = i;
+        }
+        if (!(is_a && *switch_index == last) && !is_b)
+        {
+            printf("  periode %u: %llu siklus, lebar %llu siklus tidak cocok\n", i, (unsigned long long)period,
+                   (unsigned long long)width);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 1)
+    {
+        fprintf(stderr, "pemakaian: %s\n", argv[0]);
+        return 2;
+    }
+
+    fake_hw_reset();
+    fake_hw_log_set_enabled(false);
+    memset(&ch1, 0, sizeof(ch1));
+    fake_hw_set_pin_listener(on_pins, NULL);
+    gpio_init(TRIGGER_PIN);
+    gpio_set_dir(TRIGGER_PIN, GPIO_IN);
+    fake_hw_gpio_set_input(TRIGGER_PIN, false);
+
+    const sg_timing_config timing = {
+        .frequency_hz = 10000.0f,
+        .pulse_width_us = 2.0f,
+        .phase_shift_us = 1.0f,
+        .pio_clk_div = 1.0f,
+    };
+    sg_count_init(&counter);
+    if (!sg_init(&gen, pio0, PIN_CH1_BASE) || !sg_configure(&gen, &timing) ||
+        !sg_count_start(&counter, &gen, SG_COUNT_DEFAULT_INTERVAL, NULL, NULL) ||
+        !sg_i2c_init(&target, i2c0, ADDRESS, SDA_PIN, SCL_PIN, &gen, &counter, TRIGGER_PIN, true))
+    {
+        printf("konfigurasi ditolak\nGAGAL\n");
+        return 1;
+    }
+    bool ok = true;
+
+    // -- Identitas dan register awal --
+    uint8_t regs[SG_I2C_NUM_REGS];
+    memset(regs, 0xee, sizeof(regs));
+    bool acked = read_regs(SG_I2C_REG_ID, regs, sizeof(regs));
+    uint8_t dummy;
+    bool nacked = !transfer(ADDRESS + 1, &dummy, 1, &dummy, 1);
+    bool id_ok = acked && nacked && regs[SG_I2C_REG_ID] == SG_I2C_ID && regs[SG_I2C_REG_VERSION] == SG_I2C_VERSION &&
+                 regs[SG_I2C_REG_STATUS] == 0 && le32(&regs[SG_I2C_REG_FREQUENCY_MILLIHZ]) == 10000000u &&
+                 le32(&regs[SG_I2C_REG_PULSE_WIDTH_NS]) == 2000u && le32(&regs[SG_I2C_REG_PHASE_SHIFT_NS]) == 1000u;
+    printf("identitas: ID 0x%02x, versi %u, status 0x%02x, frekuensi %lu mHz, alamat lain %s\n  %s\n",
+           regs[SG_I2C_REG_ID], regs[SG_I2C_REG_VERSION], regs[SG_I2C_REG_STATUS],
+           (unsigned long)le32(&regs[SG_I2C_REG_FREQUENCY_MILLIHZ]), nacked ? "NACK" : "ACK", id_ok ? "OK" : "GAGAL");
+    ok &= id_ok;
+
+    // -- START --
+    write_control(SG_I2C_CTRL_START);
+    run_loop(1000);
+    uint8_t status = read_status();
+    bool start_ok = status == SG_I2C_STATUS_RUNNING && ch1.count >= 9;
+    printf("start: status 0x%02x, %u periode\n  %s\n", status, ch1.count, start_ok ? "OK" : "GAGAL");
+    ok &= start_ok;
+
+    // -- Rentetan pembacaan tidak mengganggu output --
+    uint64_t period_old, width_old;
+    expected_shape(10000.0f, 2.0f, 1.0f, &period_old, &width_old);
+    uint first = ch1.count;
+    for (uint i = 0; i < 40; ++i)
+    {
+        read_regs(SG_I2C_REG_ID, regs, sizeof(regs));
+    }
+    uint switch_index;
+    bool reads_ok = check_periods(first, ch1.count, period_old, width_old, period_old, width_old, &switch_index) == 0 &&
+                    ch1.count - first > 20;
+    printf("40 pembacaan penuh: %u periode %llu siklus tanpa penyimpangan\n  %s\n", ch1.count - first,
+           (unsigned long long)period_old, reads_ok ? "OK" : "GAGAL");
+    ok &= reads_ok;
+
+    // -- PERIOD_COUNT --
+    // Snapshot diambil di tengah transaksi: nilainya di antara jumlah periode
+    // di pin sebelum dan sesudah transaksi (periode dihitung di event D)
+    uint8_t count_bytes[8];
+    uint count_before = ch1.count;
+    read_regs(SG_I2C_REG_PERIOD_COUNT, count_bytes, sizeof(count_bytes));
+    uint64_t reported = le32(count_bytes) | ((uint64_t)le32(count_bytes + 4) << 32);
+    bool count_ok = reported + 1 >= count_before && reported <= ch1.count && reported > 0;
+    printf("PERIOD_COUNT: %llu, terlihat di pin %u..%u\n  %s\n", (unsigned long long)reported, count_before,
+           ch1.count, count_ok ? "OK" : "GAGAL");
+    ok &= count_ok;
+
+    // -- Tulisan tanpa COMMIT tidak berpengaruh --
+    first = ch1.count;
+    write_config(12500000u, 5000u, 3000u, false);
+    run_loop(2000);
+    bool shadow_ok = check_periods(first, ch1.count, period_old, width_old, period_old, width_old, &switch_index) == 0;
+    read_regs(SG_I2C_REG_ID, regs, sizeof(regs));
+    shadow_ok &= le32(&regs[SG_I2C_REG_FREQUENCY_MILLIHZ]) == 12500000u && le32(&regs[SG_I2C_REG_COMMITS]) == 0;
+    printf("tulis tanpa commit: register terbaca %lu mHz, output tetap\n  %s\n",
+           (unsigned long)le32(&regs[SG_I2C_REG_FREQUENCY_MILLIHZ]), shadow_ok ? "OK" : "GAGAL");
+    ok &= shadow_ok;
+
+    // -- COMMIT: pergantian utuh di batas periode --
+    uint64_t period_new, width_new;
+    expected_shape(12500.0f, 5.0f, 3.0f, &period_new, &width_new);
+    first = ch1.count;
+    write_config(12500000u, 5000u, 3000u, true);
+    uint64_t commit_ps = fake_hw_now_ps();
+    uint commit_index = ch1.count;
+    run_loop(2000);
+    bool commit_ok = check_periods(first, ch1.count, period_old, width_old, period_new, width_new, &switch_index) == 0;
+    // Periode yang sudah berjalan + satu periode di FIFO, lalu yang baru
+    commit_ok &= switch_index != ch1.count && switch_index <= commit_index + 1;
+    read_regs(SG_I2C_REG_ID, regs, sizeof(regs));
+    commit_ok &= regs[SG_I2C_REG_STATUS] == SG_I2C_STATUS_RUNNING && le32(&regs[SG_I2C_REG_COMMITS]) == 1;
+    printf("commit: %llu -> %llu siklus, periode baru mulai %.1f us setelah STOP commit (periode ke-%d)\n  %s\n",
+           (unsigned long long)period_old, (unsigned long long)period_new,
+           switch_index < ch1.count ? (double)(ch1.rise_ps[switch_index] - commit_ps) * 1e-6 : -1.0,
+           (int)switch_index - (int)commit_index, commit_ok ? "OK" : "GAGAL");
+    ok &= commit_ok;
+
+    // -- COMMIT tidak valid --
+    first = ch1.count;
+    write_config(12500000u, 60000u, 3000u, true);
+    run_loop(1000);
+    status = read_status();
+    bool invalid_ok = check_periods(first, ch1.count, period_new, width_new, period_new, width_new, &switch_index) == 0 &&
+                      (status & SG_I2C_STATUS_ERROR) && (status & SG_I2C_STATUS_RUNNING);
+    read_regs(SG_I2C_REG_COMMITS, regs, 4);
+    invalid_ok &= le32(regs) == 1;
+    printf("commit tidak valid: status 0x%02x, output tetap\n  %s\n", status, invalid_ok ? "OK" : "GAGAL");
+    ok &= invalid_ok;
+
+    // -- STOP --
+    write_control(SG_I2C_CTRL_STOP);
+    run_loop(100);
+    uint stopped_count = ch1.count;
+    run_loop(1000);
+    status = read_status();
+    bool stop_ok = ch1.count == stopped_count && status == 0 && !((fake_hw_gpio_levels() >> PIN_CH1_BASE) & 1u);
+    printf("stop: status 0x%02x, output diam\n  %s\n", status, stop_ok ? "OK" : "GAGAL");
+    ok &= stop_ok;
+
+    // -- ARM: output mulai pada trigger --
+    write_config(10000000u, 2000u, 1000u, false);
+    write_control(SG_I2C_CTRL_COMMIT | SG_I2C_CTRL_ARM);
+    run_loop(500);
+    uint8_t armed_status = read_status();
+    bool silent = ch1.count == stopped_count;
+    uint64_t trigger_us = fake_hw_now_ps() / 1000000u + 50;
+    fake_hw_gpio_schedule(TRIGGER_PIN, true, trigger_us);
+    first = ch1.count;
+    run_loop(1000);
+    status = read_status();
+    bool arm_ok = armed_status == SG_I2C_STATUS_ARMED && silent &&
+                  status == SG_I2C_STATUS_RUNNING && ch1.count > first &&
+                  check_periods(first, ch1.count, period_old, width_old, period_old, width_old, &switch_index) == 0 &&
+                  ch1.rise_ps[first] > trigger_us * 1000000u;
+    printf("arm: status menunggu 0x%02x, setelah trigger 0x%02x, %u periode konfigurasi awal\n  %s\n", armed_status,
+           status, ch1.count - first, arm_ok ? "OK" : "GAGAL");
+    ok &= arm_ok;
+
+    sg_i2c_deinit(&target);
+    sg_count_stop(&counter);
+    sg_deinit(&gen);
+    fake_hw_set_pin_listener(NULL, NULL);
+    printf("%s\n", ok ? "OK" : "GAGAL");
+    return ok ? 0 : 1;
+}
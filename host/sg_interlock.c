@@ -0,0 +1,208 @@
+/**
+ * sg_interlock: pemeriksaan interlock PWM komplementer di simulasi.
+ *
+ * PWM komplementer (signal_pwm) dijalankan di atas simulasi PIO dengan duty,
+ * frekuensi dan dead time yang diubah setiap periode (termasuk duty 0 dan 1
+ * serta nilai di sekitar batas event minimum), lalu dihentikan dan dimulai
+ * ulang pada waktu acak di tengah periode. Setiap edge pin diperiksa:
+ * - pasangan komplementer CH1/CH2 dan CH4/CH3 tidak pernah HIGH bersamaan;
+ * - jarak dari turunnya satu pin ke naiknya pasangannya tidak pernah lebih
+ *   pendek dari dead time;
+ * - setelah stop semua pin kembali LOW.
+ *
+ * Pemakaian: sg_interlock [--runs <n>] [--seed <n>]
+ * Exit 1 jika ada pelanggaran.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fake_hw.h"
+#include "hardware/clocks.h"
+#include "signal_pwm.h"
+
+#define PIN_BASE 6
+#define PIO_CLK_DIV 1.0f
+
+// Pasangan komplementer per leg (bit pin relatif terhadap PIN_BASE)
+static const uint pairs[][2] = {{0, 1}, {3, 2}};
+
+static struct
+{
+    uint32_t levels;
+    uint64_t last_fall_ps[SG_PWM_NUM_PINS];
+    bool has_fall[SG_PWM_NUM_PINS];
+    uint64_t deadtime_ps; // Dead time terpendek di antara konfigurasi yang dipakai
+    uint64_t min_gap_ps;
+    uint64_t edges;
+    uint overlaps;
+    uint short_gaps;
+} check;
+
+static uint32_t rng_state = 1;
+
+static uint32_t rng_next(void)
+{
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return rng_state >> 8;
+}
+
+static float rng_float(void)
+{
+    return (float)(rng_next() & 0xffffu) / 65535.0f;
+}
+
+static void on_pins(void *ctx, uint64_t time_ps, uint32_t levels, uint32_t changed)
+{
+    (void)ctx;
+    uint32_t mask = ((1u << SG_PWM_NUM_PINS) - 1u) << PIN_BASE;
+    if (!(changed & mask))
+    {
+        return;
+    }
+    uint32_t now = (levels & mask) >> PIN_BASE;
+    uint32_t rise = now & ~check.levels;
+    uint32_t fall = check.levels & ~now;
+    check.edges++;
+
+    for (uint p = 0; p < count_of(pairs); ++p)
+    {
+        for (uint k = 0; k < 2; ++k)
+        {
+            uint pin = pairs[p][k];
+            uint other = pairs[p][k ^ 1];
+            if ((rise & (1u << pin)) && check.has_fall[other])
+            {
+                uint64_t gap = time_ps - check.last_fall_ps[other];
+                if (gap < check.min_gap_ps)
+                {
+                    check.min_gap_ps = gap;
+                }
+                if (gap < check.deadtime_ps)
+                {
+                    printf("  pelanggaran dead time CH%u->CH%u: %.3f ns pada %.3f us\n", other + 1, pin + 1,
+                           (double)gap / 1e3, (double)time_ps / 1e6);
+                    check.short_gaps++;
+                }
+            }
+        }
+        if ((now & (1u << pairs[p][0])) && (now & (1u << pairs[p][1])))
+        {
+            printf("  shoot-through CH%u+CH%u pada %.3f us\n", pairs[p][0] + 1, pairs[p][1] + 1,
+                   (double)time_ps / 1e6);
+            check.overlaps++;
+        }
+    }
+    for (uint pin = 0; pin < SG_PWM_NUM_PINS; ++pin)
+    {
+        if (fall & (1u << pin))
+        {
+            check.last_fall_ps[pin] = time_ps;
+            check.has_fall[pin] = true;
+        }
+    }
+    check.levels = now;
+}
+
+/**
+ * @brief Memilih parameter berikutnya: duty ekstrem, duty di sekitar batas
+ *        event minimum, atau acak.
+ */
+static sg_pwm_config next_config(uint step)
+{
+    static const float special_duty[] = {0.0f, 1.0f, 0.5f, 0.001f, 0.999f, 0.013f, 0.987f};
+    sg_pwm_config c = {
+        .frequency_hz = 20000.0f,
+        .duty = step % 3 == 0 ? special_duty[(step / 3) % count_of(special_duty)] : rng_float(),
+        .deadtime_us = 0.5f,
+        .pio_clk_div = PIO_CLK_DIV,
+    };
+    if (step % 7 == 0)
+    {
+        c.frequency_hz = 10000.0f + 30000.0f * rng_float();
+        c.deadtime_us = 0.2f + 0.6f * rng_float();
+    }
+    return c;
+}
+
+int main(int argc, char **argv)
+{
+    uint runs = 40;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--runs") == 0 && i + 1 < argc)
+        {
+            runs = (uint)strtoul(argv[++i], NULL, 0);
+        }
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+        {
+            rng_state = (uint32_t)strtoul(argv[++i], NULL, 0);
+        }
+        else
+        {
+            fprintf(stderr, "pemakaian: %s [--runs <n>] [--seed <n>]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    fake_hw_reset();
+    fake_hw_log_set_enabled(false);
+    fake_hw_set_pin_listener(on_pins, NULL);
+    check.min_gap_ps = UINT64_MAX;
+    // Batas pemeriksaan: dead time terkecil yang mungkin dipilih, dikuantisasi ke siklus PIO
+    uint32_t min_deadtime_cycles = (uint32_t)(0.2f * 1e-6f * SYS_CLK_HZ / PIO_CLK_DIV);
+    check.deadtime_ps = (uint64_t)min_deadtime_cycles * 1000000000000ull / SYS_CLK_HZ;
+
+    sg_seq_instance pwm;
+    sg_pwm_config config = next_config(1);
+    if (!sg_seq_init(&pwm, pio0, PIN_BASE, SG_PWM_NUM_PINS) || !sg_pwm_configure(&pwm, &config))
+    {
+        fprintf(stderr, "sg_interlock: konfigurasi PWM ditolak\n");
+        return 1;
+    }
+
+    uint updates = 0, rejected = 0, stuck = 0;
+    uint step = 0;
+    for (uint run = 0; run < runs; ++run)
+    {
+        sg_seq_start(&pwm);
+        uint64_t stop_at = fake_hw_now_ps() + (uint64_t)(200 + rng_next() % 3000) * 1000000ull;
+        while (fake_hw_now_ps() < stop_at)
+        {
+            sg_seq_service(&pwm);
+            if (!pwm.update_pending)
+            {
+                config = next_config(step++);
+                if (sg_pwm_update(&pwm, &config))
+                {
+                    updates++;
+                }
+                else
+                {
+                    rejected++;
+                }
+            }
+        }
+        sg_seq_stop(&pwm);
+        if (check.levels != 0)
+        {
+            printf("  run %u: pin tidak LOW setelah stop (0x%x)\n", run, check.levels);
+            stuck++;
+        }
+        fake_hw_advance_us(50 + rng_next() % 200);
+    }
+    sg_seq_deinit(&pwm);
+
+    bool ok = check.overlaps == 0 && check.short_gaps == 0 && stuck == 0;
+    printf("sg_interlock: %u run, %u pembaruan (%u ditolak), %llu edge\n", runs, updates, rejected,
+           (unsigned long long)check.edges);
+    printf("  shoot-through %u, dead time < %.1f ns: %u, pin tidak LOW setelah stop: %u\n", check.overlaps,
+           (double)check.deadtime_ps / 1e3, check.short_gaps, stuck);
+    printf("  dead time terpendek yang teramati: %.1f ns\n",
+           check.min_gap_ps == UINT64_MAX ? 0.0 : (double)check.min_gap_ps / 1e3);
+    printf("%s\n", ok ? "OK" : "GAGAL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,423 @@
+/**
+ * sg_modes: pemeriksaan program resident dan pergantian mode di simulasi.
+ *
+ * Beberapa varian program dimuat sekaligus lalu dijalankan bergantian lewat
+ * sg_modes_switch(). Setiap segmen mode dibandingkan per siklus dengan pola
+ * yang dikirim: periode terakhir mode lama harus keluar utuh, dan jeda
+ * tambahan sampai edge pertama mode baru dilaporkan sebagai latensi
+ * pergantian dalam siklus PIO. Instruction memory tidak boleh ditulis ulang
+ * selama pergantian.
+ *
+ * Pemakaian: sg_modes
+ * Exit 1 jika ada perbedaan atau latensi melebihi batas.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fake_hw.h"
+#include "hardware/clocks.h"
+#include "signal_modes.h"
+
+#define PIN_BASE 6
+#define PIN_COUNT 4
+#define PIN_MASK (((1u << PIN_COUNT) - 1u) << PIN_BASE)
+#define TRIGGER_PIN 2
+
+#define MAX_SEGMENTS 8
+#define MAX_STEPS 4
+#define MAX_TRIGGERS 8
+#define MAX_SWITCH_LATENCY_CYCLES 128 // Batas latensi pergantian (siklus PIO, div 1)
+#define MAX_TRIGGER_LATENCY_CYCLES 4  // Edge trigger sampai output
+
+static const char *const mode_names[SG_NUM_MODES] = {"CLASSIC", "SEQUENCER", "PACKED", "AUTONOMOUS", "TRIGGERED"};
+
+typedef struct
+{
+    uint64_t cycle; // Siklus clk_sys
+    uint32_t levels;
+} transition;
+
+static struct
+{
+    transition *items;
+    size_t count;
+    size_t capacity;
+} captured;
+
+static void on_pins(void *ctx, uint64_t time_ps, uint32_t levels, uint32_t changed)
+{
+    (void)ctx;
+    (void)time_ps;
+    if (!(changed & PIN_MASK))
+    {
+        return;
+    }
+    if (captured.count == captured.capacity)
+    {
+        captured.capacity = captured.capacity ? 2 * captured.capacity : 4096;
+        captured.items = realloc(captured.items, captured.capacity * sizeof(transition));
+        if (!captured.items)
+        {
+            fprintf(stderr, "sg_modes: memori habis\n");
+            exit(2);
+        }
+    }
+    captured.items[captured.count].cycle = fake_hw_sys_cycles();
+    captured.items[captured.count].levels = (levels & PIN_MASK) >> PIN_BASE;
+    captured.count++;
+}
+
+// -- Pola per Segmen --
+
+/**
+ * @brief Satu event dalam pola: level pin selama `cycles` siklus PIO.
+ */
+typedef struct
+{
+    uint32_t mask;
+    uint32_t cycles;
+    bool wait; // Menunggu edge trigger (hanya SG_MODE_TRIGGERED)
+} step;
+
+/**
+ * @brief Satu segmen mode: pola satu periode yang diulang.
+ */
+typedef struct
+{
+    sg_mode mode;
+    const step *steps;
+    uint count;
+    uint periods;    // Jumlah periode yang dikirim (mode FIFO)
+    uint64_t run_us; // Lama berjalan untuk SG_MODE_AUTONOMOUS (periode tidak dihitung)
+} segment;
+
+// Setiap pola diawali level yang berbeda dari akhir pola lain (semua LOW),
+// sehingga edge pertama setiap segmen selalu terlihat
+static const step seq_period[] = {{0x1, 40, false}, {0x0, 20, false}, {0x2, 40, false}, {0x0, 60, false}};
+static const step packed_period[] = {{0x4, 30, false}, {0x0, 10, false}, {0x8, 30, false}, {0x0, 50, false}};
+static const step auto_period[] = {{0x3, 50, false}, {0x0, 70, false}};
+static const step trig_period[] = {{0x6, 40, false}, {0x0, 40, false}, {0x5, 40, true}, {0x0, 40, false}};
+// CLASSIC: mask tetap dari program (9, 0, 6, 0)
+static const step classic_period[] = {{0x9, 30, false}, {0x0, 12, false}, {0x6, 30, false}, {0x0, 48, false}};
+
+/**
+ * @brief Menyusun word FIFO (atau parameter autonomous) untuk segmen.
+ *
+ * @return Jumlah word
+ */
+static uint encode(const segment *g, uint32_t *out)
+{
+    if (g->mode == SG_MODE_AUTONOMOUS)
+    {
+        const uint32_t params[] = {SG_AUTO_PARAMS(g->steps[0].mask, g->steps[0].cycles, g->steps[1].cycles)};
+        memcpy(out, params, sizeof(params));
+        return SG_AUTO_NUM_PARAMS;
+    }
+    uint n = 0;
+    for (uint p = 0; p < g->periods; ++p)
+    {
+        for (uint j = 0; j < g->count; ++j)
+        {
+            const step *st = &g->steps[j];
+            switch (g->mode)
+            {
+            case SG_MODE_CLASSIC:
+                out[n++] = st->cycles -
+                           (j == SG_NUM_EVENTS - 1 ? SG_EVENT_D_OVERHEAD_CYCLES : SG_EVENT_OVERHEAD_CYCLES);
+                break;
+            case SG_MODE_PACKED:
+                if (j % 2 == 0)
+                {
+                    out[n++] = SG_PACKED_EVENT(st->mask, st->cycles);
+                }
+                else
+                {
+                    out[n - 1] = SG_PACKED_WORD(out[n - 1], SG_PACKED_EVENT(st->mask, st->cycles));
+                }
+                break;
+            case SG_MODE_TRIGGERED:
+                out[n++] = SG_TRIG_EVENT(st->mask, st->cycles, st->wait);
+                break;
+            default:
+                out[n++] = SG_SEQ_EVENT(st->mask, st->cycles);
+                break;
+            }
+        }
+    }
+    return n;
+}
+
+// -- Skenario --
+
+typedef struct
+{
+    const char *name;
+    uint32_t wanted;   // Mode yang diminta ke sg_modes_init()
+    uint32_t resident; // Mode yang diharapkan muat
+    segment segments[MAX_SEGMENTS];
+    uint count;
+} scenario;
+
+typedef struct
+{
+    uint64_t triggers[MAX_TRIGGERS]; // Siklus edge naik trigger
+    uint trigger_count;
+    uint max_switch_latency;
+    uint max_trigger_latency;
+} run_result;
+
+/**
+ * @brief Menjalankan satu segmen: start/switch, lalu feed sisa word.
+ */
+static bool run_segment(sg_modes_instance *m, const segment *g, bool first, run_result *r)
+{
+    static uint32_t words[1024];
+    uint n = encode(g, words);
+    uint head = g->mode == SG_MODE_AUTONOMOUS ? n : (n < 4 ? n : 4);
+    bool ok = first ? sg_modes_start(m, g->mode, 1.0f, words, head) : sg_modes_switch(m, g->mode, words, head);
+    if (!ok)
+    {
+        return false;
+    }
+
+    if (g->mode == SG_MODE_TRIGGERED)
+    {
+        // Satu pulsa trigger 1 us per periode, cukup jauh agar setiap `wait` sudah menunggu
+        uint64_t cycles_per_us = clock_get_hz(clk_sys) / 1000000u;
+        uint64_t now_us = fake_hw_now_ps() / 1000000u + 1;
+        for (uint p = 0; p < g->periods && r->trigger_count < MAX_TRIGGERS; ++p)
+        {
+            uint64_t at_us = now_us + 4 + 4 * p;
+            fake_hw_gpio_schedule(TRIGGER_PIN, true, at_us);
+            fake_hw_gpio_schedule(TRIGGER_PIN, false, at_us + 1);
+            r->triggers[r->trigger_count++] = at_us * cycles_per_us;
+        }
+    }
+    sg_modes_put(m, words + head, n - head);
+    if (g->mode == SG_MODE_AUTONOMOUS)
+    {
+        fake_hw_advance_us(g->run_us);
+    }
+    return true;
+}
+
+/**
+ * @brief Membandingkan transisi yang terekam dengan pola semua segmen.
+ *
+ * @return Jumlah perbedaan
+ */
+static uint check_segments(const scenario *sc, run_result *r)
+{
+    uint mismatches = 0;
+    size_t i = 0;
+    uint trig = 0;
+    uint32_t level = 0;
+    uint64_t end = 0;
+    for (uint s = 0; s < sc->count; ++s)
+    {
+        const segment *g = &sc->segments[s];
+        if (i >= captured.count || captured.items[i].levels != g->steps[0].mask)
+        {
+            printf("  segmen %u (%s): edge pertama tidak ditemukan\n", s, mode_names[g->mode]);
+            return mismatches + 1;
+        }
+        uint64_t t = captured.items[i].cycle;
+        if (s > 0)
+        {
+            if (t < end)
+            {
+                printf("  %s -> %s: periode terakhir terpotong %llu siklus\n", mode_names[sc->segments[s - 1].mode],
+                       mode_names[g->mode], (unsigned long long)(end - t));
+                return mismatches + 1;
+            }
+            uint latency = (uint)(t - end);
+            printf("  %-10s -> %-10s latensi %3u siklus PIO\n", mode_names[sc->segments[s - 1].mode],
+                   mode_names[g->mode], latency);
+            if (latency > r->max_switch_latency)
+            {
+                r->max_switch_latency = latency;
+            }
+        }
+
+        bool first = true;
+        bool repeat = g->mode == SG_MODE_AUTONOMOUS;
+        uint rep = 0;
+        for (; repeat || rep < g->periods; ++rep)
+        {
+            // Mode autonomous berakhir saat edge awal periode berikutnya tidak muncul tepat waktu
+            if (repeat && rep > 0 &&
+                (i >= captured.count || captured.items[i].cycle != t || captured.items[i].levels != g->steps[0].mask))
+            {
+                break;
+            }
+            for (uint j = 0; j < g->count; ++j)
+            {
+                const step *st = &g->steps[j];
+                if (st->wait && !first)
+                {
+                    uint64_t tc = trig < r->trigger_count ? r->triggers[trig++] : UINT64_MAX;
+                    if (i >= captured.count || captured.items[i].levels != st->mask || captured.items[i].cycle < tc ||
+                        captured.items[i].cycle > tc + MAX_TRIGGER_LATENCY_CYCLES)
+                    {
+                        printf("  segmen %u periode %u: edge trigger tidak sesuai\n", s, rep);
+                        return mismatches + 1;
+                    }
+                    uint latency = (uint)(captured.items[i].cycle - tc);
+                    if (latency > r->max_trigger_latency)
+                    {
+                        r->max_trigger_latency = latency;
+                    }
+                    t = captured.items[i].cycle;
+                    i++;
+                }
+                else if (first || st->mask != level)
+                {
+                    if (i >= captured.count || captured.items[i].cycle != t || captured.items[i].levels != st->mask)
+                    {
+                        if (mismatches < 5)
+                        {
+                            printf("  segmen %u periode %u event %u: level 0x%x di siklus %llu, seharusnya 0x%x di "
+                                   "siklus %llu\n",
+                                   s, rep, j, i < captured.count ? captured.items[i].levels : 0,
+                                   i < captured.count ? (unsigned long long)captured.items[i].cycle : 0ull, st->mask,
+                                   (unsigned long long)t);
+                        }
+                        mismatches++;
+                    }
+                    i++;
+                }
+                level = st->mask;
+                t += st->cycles;
+                first = false;
+            }
+        }
+        if (repeat && rep < 2)
+        {
+            printf("  segmen %u (%s): hanya %u periode\n", s, mode_names[g->mode], rep);
+            mismatches++;
+        }
+        end = t;
+    }
+    // Sisa satu transisi boleh berasal dari stop
+    if (i + 1 < captured.count)
+    {
+        printf("  %zu transisi tak terduga setelah segmen terakhir\n", captured.count - i);
+        mismatches++;
+    }
+    return mismatches;
+}
+
+static bool run_scenario(const scenario *sc)
+{
+    fake_hw_reset();
+    fake_hw_log_set_enabled(false);
+    memset(&captured, 0, sizeof(captured));
+    fake_hw_set_pin_listener(on_pins, NULL);
+    fake_hw_gpio_set_input(TRIGGER_PIN, false);
+
+    printf("%s:\n", sc->name);
+    sg_modes_instance m;
+    if (!sg_modes_init(&m, pio0, PIN_BASE, PIN_COUNT, TRIGGER_PIN, sc->wanted))
+    {
+        printf("  init gagal\n  GAGAL\n");
+        return false;
+    }
+    uint used = 0;
+    for (uint mode = 0; mode < SG_NUM_MODES; ++mode)
+    {
+        if (sg_modes_is_resident(&m, (sg_mode)mode))
+        {
+            printf("  %-10s offset %2u, %2u instruksi\n", mode_names[mode], m.offset[mode],
+                   sg_modes_program_length((sg_mode)mode));
+            used += sg_modes_program_length((sg_mode)mode);
+        }
+        else if (sc->wanted & SG_MODE_BIT(mode))
+        {
+            printf("  %-10s tidak muat (%u instruksi)\n", mode_names[mode], sg_modes_program_length((sg_mode)mode));
+        }
+    }
+    printf("  instruction memory: %u/%u\n", used, PIO_INSTRUCTION_COUNT);
+    bool resident_ok = m.resident == sc->resident;
+
+    // Pergantian mode tidak boleh menulis instruction memory
+    fake_hw_log_set_enabled(true);
+    fake_hw_log_clear();
+    run_result r = {0};
+    bool fed = true;
+    for (uint s = 0; s < sc->count && fed; ++s)
+    {
+        fed = run_segment(&m, &sc->segments[s], s == 0, &r);
+    }
+    fake_hw_advance_us(20); // Segmen terakhir selesai
+    size_t instr_writes = fake_hw_log_count_matching(FAKE_HW_LOG_REG_WRITE, "INSTR_MEM");
+    fake_hw_log_set_enabled(false);
+    sg_modes_stop(&m);
+    sg_modes_deinit(&m);
+
+    uint mismatches = fed ? check_segments(sc, &r) : 1;
+    if (r.trigger_count > 0)
+    {
+        printf("  latensi trigger ke output maksimal %u siklus PIO\n", r.max_trigger_latency);
+    }
+    bool ok = resident_ok && fed && mismatches == 0 && instr_writes == 0 &&
+              r.max_switch_latency <= MAX_SWITCH_LATENCY_CYCLES;
+    printf("  %zu transisi, %u berbeda, latensi switch maksimal %u siklus PIO%s%s%s\n", captured.count, mismatches,
+           r.max_switch_latency, resident_ok ? "" : ", mode resident tidak sesuai", fed ? "" : ", switch ditolak",
+           instr_writes ? ", instruction memory ditulis ulang" : "");
+    printf("  %s\n", ok ? "OK" : "GAGAL");
+    free(captured.items);
+    captured.items = NULL;
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 1)
+    {
+        fprintf(stderr, "pemakaian: %s\n", argv[0]);
+        return 2;
+    }
+
+    const uint32_t no_classic = SG_MODE_ALL_BITS & ~SG_MODE_BIT(SG_MODE_CLASSIC);
+    const scenario scenarios[] = {
+        {
+            "four_resident",
+            no_classic,
+            no_classic,
+            {
+                {SG_MODE_SEQUENCER, seq_period, count_of(seq_period), 20, 0},
+                {SG_MODE_PACKED, packed_period, count_of(packed_period), 20, 0},
+                {SG_MODE_AUTONOMOUS, auto_period, count_of(auto_period), 0, 20},
+                {SG_MODE_TRIGGERED, trig_period, count_of(trig_period), 3, 0},
+                {SG_MODE_SEQUENCER, seq_period, count_of(seq_period), 10, 0},
+                {SG_MODE_AUTONOMOUS, auto_period, count_of(auto_period), 0, 10},
+                {SG_MODE_PACKED, packed_period, count_of(packed_period), 10, 0},
+            },
+            7,
+        },
+        {
+            "with_classic",
+            SG_MODE_ALL_BITS,
+            SG_MODE_BIT(SG_MODE_CLASSIC) | SG_MODE_BIT(SG_MODE_SEQUENCER) | SG_MODE_BIT(SG_MODE_PACKED),
+            {
+                {SG_MODE_CLASSIC, classic_period, count_of(classic_period), 20, 0},
+                {SG_MODE_SEQUENCER, seq_period, count_of(seq_period), 10, 0},
+                {SG_MODE_PACKED, packed_period, count_of(packed_period), 10, 0},
+                {SG_MODE_CLASSIC, classic_period, count_of(classic_period), 10, 0},
+            },
+            4,
+        },
+    };
+
+    bool ok = true;
+    for (uint i = 0; i < count_of(scenarios); ++i)
+    {
+        ok &= run_scenario(&scenarios[i]);
+    }
+    printf("%s\n", ok ? "OK" : "GAGAL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,443 @@
+/**
+ * sg_preset: pemeriksaan preset flash (signal_preset) dan boot ke output.
+ *
+ * Diperiksa:
+ *   - simpan, hapus dan preset power-on bertahan setelah indeks dibangun
+ *     ulang dari flash,
+ *   - wear leveling: banyak penyimpanan meng-erase setiap sektor region sama
+ *     seringnya (selisih paling banyak 1) dan tidak menyentuh flash lain,
+ *   - listrik padam di byte acak selama program/erase: setelah scan ulang,
+ *     slot yang ditulis berisi nilai lama atau baru, slot lain tidak berubah,
+ *   - semua erase/program lewat flash_safe_execute(),
+ *   - perintah SCPI *SAV, *RCL, MEM:STAT:... termasuk kode error dan
+ *     penolakan penulisan saat generator berjalan,
+ *   - boot firmware (main() dengan SCPI_CONTROL): preset power-on menjalankan
+ *     output sebelum stdio_init_all(), perintah dari host tetap dilayani,
+ *     dan BURS:NCYC n menghasilkan tepat n periode selagi penghitung
+ *     periode main() berjalan.
+ *
+ * Pemakaian: sg_preset
+ * Exit 1 jika ada perbedaan.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "fake_hw.h"
+#include "hardware/gpio.h"
+#include "signal_preset.h"
+#include "signal_scpi.h"
+
+#define WEAR_SAVES 3000
+#define POWER_LOSS_RUNS 400
+#define OUTPUT_SIZE 4096
+#define BOOT_US 20000
+
+// Konstanta dan entry firmware dari main.c (main di-rename menjadi
+// firmware_main, SCPI_CONTROL diaktifkan lewat SIGNAL_GENERATOR_SCPI_CONTROL)
+extern const uint PIN_CH1_BASE;
+int firmware_main(void);
+void firmware_release(void);
+
+/**
+ * @brief Preset uji ke-n: setiap n menghasilkan nilai berbeda.
+ */
+static sg_preset make_preset(uint n)
+{
+    sg_preset preset;
+    memset(&preset, 0, sizeof(preset));
+    snprintf(preset.name, sizeof(preset.name), "preset %u", n);
+    preset.timing.frequency_hz = 1000.0f + (float)n;
+    preset.timing.pulse_width_us = 1.0f + (float)(n % 7) * 0.5f;
+    preset.timing.phase_shift_us = (float)(n % 3);
+    preset.timing.pio_clk_div = 1.0f;
+    preset.timing.trigger_delay_ns = n % 5;
+    preset.burst_cycles = n % 11;
+    preset.trigger_source = (uint8_t)(n % 3);
+    return preset;
+}
+
+static bool preset_equal(const sg_preset *a, const sg_preset *b)
+{
+    return strcmp(a->name, b->name) == 0 && a->timing.frequency_hz == b->timing.frequency_hz &&
+           a->timing.pulse_width_us == b->timing.pulse_width_us &&
+           a->timing.phase_shift_us == b->timing.phase_shift_us && a->timing.pio_clk_div == b->timing.pio_clk_div &&
+           a->timing.trigger_delay_ns == b->timing.trigger_delay_ns && a->burst_cycles == b->burst_cycles &&
+           a->trigger_source == b->trigger_source;
+}
+
+/**
+ * @brief Isi slot sama dengan model (present = false berarti kosong).
+ */
+static bool slot_is(const sg_preset_store *store, uint slot, bool present, const sg_preset *expected)
+{
+    sg_preset got;
+    bool loaded = sg_preset_load(store, slot, &got);
+    return loaded == present && (!present || preset_equal(&got, expected));
+}
+
+static uint32_t lcg_state = 12345u;
+
+static uint32_t random_u32(void)
+{
+    lcg_state = lcg_state * 1664525u + 1013904223u;
+    return lcg_state >> 8;
+}
+
+// -- Jawaban SCPI --
+static struct
+{
+    char text[OUTPUT_SIZE];
+    size_t len;
+} output;
+
+static void capture(void *ctx, const char *data, size_t len)
+{
+    (void)ctx;
+    for (size_t i = 0; i < len && output.len < OUTPUT_SIZE - 1; ++i)
+    {
+        output.text[output.len++] = data[i];
+    }
+    output.text[output.len] = '\0';
+}
+
+static sg_scpi_instance scpi;
+
+/**
+ * @brief Mengirim satu baris dan menjalankan poll sampai dieksekusi.
+ */
+static const char *command(const char *line)
+{
+    output.len = 0;
+    output.text[0] = '\0';
+    sg_scpi_receive(&scpi, (const uint8_t *)line, strlen(line));
+    sg_scpi_receive(&scpi, (const uint8_t *)"\n", 1);
+    for (uint i = 0; i < 1000 && scpi.head != scpi.tail; ++i)
+    {
+        sg_scpi_poll(&scpi);
+        fake_hw_advance_us(1);
+    }
+    sg_scpi_poll(&scpi);
+    if (output.len > 0 && output.text[output.len - 1] == '\n')
+    {
+        output.text[--output.len] = '\0';
+    }
+    return output.text;
+}
+
+static bool expect(const char *line, const char *expected)
+{
+    const char *got = command(line);
+    bool ok = strcmp(got, expected) == 0;
+    if (!ok)
+    {
+        printf("  \"%s\" -> \"%s\", diharapkan \"%s\"\n", line, got, expected);
+    }
+    return ok;
+}
+
+static bool error_is(const char *line, int code)
+{
+    command(line);
+    char expected[64];
+    snprintf(expected, sizeof(expected), "%d,\"%s\"", code, sg_scpi_error_message(code));
+    return expect("SYST:ERR?", expected);
+}
+
+// -- Boot firmware --
+static struct
+{
+    bool level;
+    uint64_t first_rise_ps;
+    uint64_t second_rise_ps;
+    uint rises;
+} ch1;
+
+static void on_pins(void *ctx, uint64_t time_ps, uint32_t levels, uint32_t changed)
+{
+    (void)ctx;
+    if (!(changed & (1u << PIN_CH1_BASE)))
+    {
+        return;
+    }
+    bool level = (levels >> PIN_CH1_BASE) & 1u;
+    if (level && !ch1.level)
+    {
+        if (ch1.rises == 0)
+        {
+            ch1.first_rise_ps = time_ps;
+        }
+        else if (ch1.rises == 1)
+        {
+            ch1.second_rise_ps = time_ps;
+        }
+        ch1.rises++;
+    }
+    ch1.level = level;
+}
+
+/**
+ * @brief "Menyalakan" board: reset (flash bertahan), kirim input, jalankan
+ *        firmware selama BOOT_US dan tangkap stdout-nya.
+ */
+static void power_cycle(const char *input, char *out, size_t out_size)
+{
+    int in_pipe[2];
+    int out_pipe[2];
+    if (pipe(in_pipe) != 0 || pipe(out_pipe) != 0)
+    {
+        perror("sg_preset: pipe");
+        exit(1);
+    }
+    write(in_pipe[1], input, strlen(input));
+    close(in_pipe[1]);
+
+    // Program PIO dan penghitung main() sebelumnya dilepas agar boot berikut
+    // memuatnya ulang ke memori instruksi yang dikosongkan reset
+    firmware_release();
+    fake_hw_reset();
+    fake_hw_log_set_enabled(false);
+    memset(&ch1, 0, sizeof(ch1));
+    fake_hw_set_pin_listener(on_pins, NULL);
+    fake_hw_stdin_attach_fd(in_pipe[0], false);
+
+    fflush(stdout);
+    int saved_stdout = dup(STDOUT_FILENO);
+    dup2(out_pipe[1], STDOUT_FILENO);
+    fake_hw_run_firmware(firmware_main, BOOT_US);
+    fflush(stdout);
+    dup2(saved_stdout, STDOUT_FILENO);
+    close(saved_stdout);
+    close(out_pipe[1]);
+
+    ssize_t n = read(out_pipe[0], out, out_size - 1);
+    out[n > 0 ? n : 0] = '\0';
+    close(out_pipe[0]);
+    close(in_pipe[0]);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 1)
+    {
+        fprintf(stderr, "pemakaian: %s\n", argv[0]);
+        return 2;
+    }
+
+    fake_hw_reset();
+    fake_hw_log_set_enabled(false);
+    fake_hw_flash_erase_all();
+    bool ok = true;
+
+    // -- Simpan, hapus dan power-on --
+    sg_preset_store store;
+    sg_preset_init(&store);
+    sg_preset expected[SG_PRESET_COUNT];
+    bool present[SG_PRESET_COUNT] = {false};
+    bool storage_ok = store.records == 0 && sg_preset_power_on(&store) == SG_PRESET_NONE;
+    for (uint slot = 0; slot < SG_PRESET_COUNT; ++slot)
+    {
+        expected[slot] = make_preset(slot);
+        present[slot] = true;
+        storage_ok &= sg_preset_save(&store, slot, &expected[slot]);
+    }
+    storage_ok &= sg_preset_delete(&store, 3) && sg_preset_set_power_on(&store, 5, true) &&
+                  !sg_preset_save(&store, SG_PRESET_COUNT, &expected[0]);
+    present[3] = false;
+    sg_preset_init(&store);
+    for (uint slot = 0; slot < SG_PRESET_COUNT; ++slot)
+    {
+        storage_ok &= slot_is(&store, slot, present[slot], &expected[slot]);
+    }
+    storage_ok &= sg_preset_power_on(&store) == 5 && store.power_on_output && store.corrupt == 0;
+    printf("simpan %u slot, hapus slot 3, power-on slot 5: terbaca setelah scan ulang (%lu record)\n  %s\n",
+           SG_PRESET_COUNT, (unsigned long)store.records, storage_ok ? "OK" : "GAGAL");
+    ok &= storage_ok;
+
+    // -- Wear leveling --
+    uint32_t erases_before[SG_PRESET_SECTORS];
+    for (uint sector = 0; sector < SG_PRESET_SECTORS; ++sector)
+    {
+        erases_before[sector] = fake_hw_flash_erase_count(SG_PRESET_FLASH_OFFSET + sector * FLASH_SECTOR_SIZE);
+    }
+    uint64_t start_ps = fake_hw_now_ps();
+    bool wear_ok = true;
+    for (uint i = 0; i < WEAR_SAVES && wear_ok; ++i)
+    {
+        uint slot = random_u32() % SG_PRESET_COUNT;
+        expected[slot] = make_preset(100 + i);
+        present[slot] = true;
+        wear_ok = sg_preset_save(&store, slot, &expected[slot]);
+    }
+    double save_ms = (double)(fake_hw_now_ps() - start_ps) / 1e9 / WEAR_SAVES;
+    uint32_t min_erases = UINT32_MAX;
+    uint32_t max_erases = 0;
+    uint32_t total_erases = 0;
+    for (uint sector = 0; sector < SG_PRESET_SECTORS; ++sector)
+    {
+        uint32_t n =
+            fake_hw_flash_erase_count(SG_PRESET_FLASH_OFFSET + sector * FLASH_SECTOR_SIZE) - erases_before[sector];
+        min_erases = n < min_erases ? n : min_erases;
+        max_erases = n > max_erases ? n : max_erases;
+        total_erases += n;
+    }
+    uint32_t outside_erases = 0;
+    for (uint32_t offs = 0; offs < SG_PRESET_FLASH_OFFSET; offs += FLASH_SECTOR_SIZE)
+    {
+        outside_erases += fake_hw_flash_erase_count(offs);
+    }
+    sg_preset_init(&store);
+    for (uint slot = 0; slot < SG_PRESET_COUNT; ++slot)
+    {
+        wear_ok &= slot_is(&store, slot, present[slot], &expected[slot]);
+    }
+    wear_ok &= max_erases - min_erases <= 1 && outside_erases == 0 && sg_preset_power_on(&store) == 5;
+    printf("wear leveling: %u simpan, erase per sektor %lu..%lu (%.1f simpan per erase), %.2f ms per simpan\n  %s\n",
+           WEAR_SAVES, (unsigned long)min_erases, (unsigned long)max_erases,
+           (double)WEAR_SAVES / (double)(total_erases ? total_erases : 1), save_ms, wear_ok ? "OK" : "GAGAL");
+    ok &= wear_ok;
+
+    // -- Listrik padam --
+    bool power_ok = true;
+    uint lost = 0;
+    uint torn = 0;
+    for (uint i = 0; i < POWER_LOSS_RUNS && power_ok; ++i)
+    {
+        uint slot = random_u32() % SG_PRESET_COUNT;
+        sg_preset next = make_preset(10000 + i);
+        // Cukup untuk memotong program halaman atau erase sektor saat pindah sektor
+        fake_hw_flash_power_loss_after(random_u32() % (FLASH_SECTOR_SIZE + 4 * FLASH_PAGE_SIZE));
+        sg_preset_save(&store, slot, &next);
+        if (fake_hw_flash_power_lost())
+        {
+            lost++;
+        }
+        fake_hw_flash_power_restore();
+
+        // Boot ulang: indeks hanya dari isi flash
+        sg_preset_init(&store);
+        torn += store.corrupt > 0;
+        if (slot_is(&store, slot, true, &next))
+        {
+            expected[slot] = next;
+            present[slot] = true;
+        }
+        for (uint s = 0; s < SG_PRESET_COUNT; ++s)
+        {
+            if (!slot_is(&store, s, present[s], &expected[s]))
+            {
+                printf("  percobaan %u: slot %u tidak sama dengan nilai lama atau baru\n", i, s);
+                power_ok = false;
+            }
+        }
+        power_ok &= sg_preset_power_on(&store) == 5;
+    }
+    printf("listrik padam acak: %u percobaan, %u terpotong, %u scan dengan record rusak\n  %s\n", POWER_LOSS_RUNS,
+           lost, torn, power_ok ? "OK" : "GAGAL");
+    ok &= power_ok;
+
+    // -- SCPI --
+    fake_hw_flash_erase_all();
+    sg_preset_init(&store);
+    sg_instance gen;
+    sg_count_instance counter;
+    sg_count_init(&counter);
+    const sg_timing_config timing = {
+        .frequency_hz = 10000.0f,
+        .pulse_width_us = 2.0f,
+        .phase_shift_us = 1.0f,
+        .pio_clk_div = 1.0f,
+    };
+    bool scpi_ok = sg_init(&gen, pio0, 6) && sg_configure(&gen, &timing) &&
+                   sg_count_start(&counter, &gen, SG_COUNT_DEFAULT_INTERVAL, NULL, NULL) &&
+                   sg_scpi_init(&scpi, &gen, &counter, 2, true, capture, NULL);
+    scpi_ok = scpi_ok && error_is("*SAV 1", SG_SCPI_ERR_HARDWARE_MISSING);
+    sg_scpi_attach_presets(&scpi, &store);
+    scpi_ok = scpi_ok && expect("MEM:STAT:VAL? 2", "0") &&
+              expect("FREQ 20kHz;:PULS:WIDT 3us;:BURS:NCYC 5;:TRIG:SOUR BUS;:*SAV 2;:MEM:STAT:VAL? 2", "1") &&
+              expect("MEMory:STATe:NAME 2, \"bench A\";NAME? 2", "\"bench A\"") &&
+              expect("*RST;FREQ?;:TRIG:SOUR?", "10000;IMM") &&
+              expect("*RCL 2;:FREQ?;:PULS:WIDT?;:BURS:NCYC?;:TRIG:SOUR?", "20000;3e-06;5;BUS") &&
+              expect("MEM:STAT:NAME? 2", "\"bench A\"") && expect("SYST:ERR?", "0,\"No error\"") &&
+              error_is("*RCL 4", SG_SCPI_ERR_ILLEGAL_VALUE) && error_is("*SAV 8", SG_SCPI_ERR_OUT_OF_RANGE) &&
+              error_is("*SAV two", SG_SCPI_ERR_DATA_TYPE) && error_is("MEM:STAT:VAL?", SG_SCPI_ERR_MISSING_PARAM) &&
+              error_is("MEM:STAT:NAME 2,\"seventeen chars!!\"", SG_SCPI_ERR_ILLEGAL_VALUE) &&
+              error_is("MEM:STAT:NAME 6,\"empty\"", SG_SCPI_ERR_ILLEGAL_VALUE) &&
+              error_is("MEM:STAT:REC:AUTO 7", SG_SCPI_ERR_ILLEGAL_VALUE);
+
+    // Penulisan flash ditolak selama output berjalan
+    uint32_t programs = fake_hw_flash_program_count();
+    scpi_ok = scpi_ok && expect("*RST;FREQ 50kHz;:PULS:WIDT 4us;:OUTP ON;:OUTP?", "1") &&
+              error_is("*SAV 4", SG_SCPI_ERR_SETTINGS_CONFLICT) &&
+              error_is("MEM:STAT:DEL 2", SG_SCPI_ERR_SETTINGS_CONFLICT) &&
+              fake_hw_flash_program_count() == programs && expect("OUTP OFF;:*SAV 4;:MEM:STAT:VAL? 4", "1") &&
+              expect("MEM:STAT:REC:AUTO?;OUTP?", "OFF;0") &&
+              error_is("MEM:STAT:REC:OUTP ON", SG_SCPI_ERR_SETTINGS_CONFLICT) &&
+              expect("MEM:STAT:REC:AUTO 4;OUTP ON;:MEM:STAT:REC:AUTO?;OUTP?", "4;1") &&
+              expect("MEM:STAT:DEL 2;:MEM:STAT:VAL? 2", "0") && expect("SYST:ERR?", "0,\"No error\"");
+    sg_preset_store reread;
+    sg_preset_init(&reread);
+    scpi_ok &= sg_preset_power_on(&reread) == 4 && reread.power_on_output && reread.slot_offset[2] == 0;
+    sg_count_stop(&counter);
+    sg_deinit(&gen);
+    printf("SCPI *SAV/*RCL/MEM:STAT, error -241/-224/-222/-104/-109, -221 saat berjalan\n  %s\n",
+           scpi_ok ? "OK" : "GAGAL");
+    ok &= scpi_ok;
+
+    // -- Boot ke output --
+    char boot_output[OUTPUT_SIZE];
+    power_cycle("FREQ?;:OUTP?\n", boot_output, sizeof(boot_output));
+    uint64_t stdio_ps = fake_hw_stdio_init_ps();
+    uint64_t period_ps = ch1.second_rise_ps - ch1.first_rise_ps;
+    // Fake stdio_init_all() tidak memodelkan waktu inisialisasi USB; yang
+    // diperiksa adalah output sudah dijalankan sebelum stdio diinisialisasi.
+    // Waktu ke sisi pertama mencakup seluruh inisialisasi main(), termasuk
+    // penghitung periode
+    unsigned long long output_us = UINT64_MAX;
+    const char *report = strstr(boot_output, "scpi: preset 4 dipanggil, output aktif pada ");
+    if (report)
+    {
+        sscanf(report, "scpi: preset 4 dipanggil, output aktif pada %llu us", &output_us);
+    }
+    bool boot_ok = ch1.rises >= 2 && output_us * 1000000u <= stdio_ps && ch1.first_rise_ps < 100000000u &&
+                   period_ps > 19000000u && period_ps < 21000000u && strstr(boot_output, "50000;1\n");
+    printf("boot dengan preset power-on 4 (50 kHz): output dijalankan sebelum stdio_init_all (%.2f us), "
+           "sisi CH1 pertama %.2f us setelah reset\n  %s\n",
+           stdio_ps == UINT64_MAX ? -1.0 : (double)stdio_ps / 1e6, (double)ch1.first_rise_ps / 1e6,
+           boot_ok ? "OK" : "GAGAL");
+    if (!boot_ok)
+    {
+        printf("  stdout: %s\n", boot_output);
+    }
+    ok &= boot_ok;
+
+    power_cycle("OUTP OFF;:MEM:STAT:REC:AUTO OFF;AUTO?\n", boot_output, sizeof(boot_output));
+    bool off_ok = strstr(boot_output, "\nOFF\n") != NULL;
+    power_cycle("FREQ?;:OUTP?\n", boot_output, sizeof(boot_output));
+    off_ok &= ch1.rises == 0 && strcmp(boot_output, "1000;0\n") == 0;
+    printf("boot tanpa preset power-on: konstanta main.c, output mati\n  %s\n", off_ok ? "OK" : "GAGAL");
+    ok &= off_ok;
+
+    // Burst N-siklus lewat jalur boot lengkap: penghitung periode main() ikut
+    // berjalan dan menjadi satu-satunya pembaca FIFO RX generator
+    power_cycle("BURS:NCYC 5;:OUTP ON;:SYST:ERR?\n", boot_output, sizeof(boot_output));
+    bool ncycle_ok = ch1.rises == 5 && strcmp(boot_output, "0,\"No error\"\n") == 0;
+    printf("boot lalu BURS:NCYC 5 (1 kHz): %u periode\n  %s\n", ch1.rises, ncycle_ok ? "OK" : "GAGAL");
+    if (!ncycle_ok)
+    {
+        printf("  stdout: %s\n", boot_output);
+    }
+    ok &= ncycle_ok;
+
+    bool safe_ok = fake_hw_flash_unsafe_ops() == 0;
+    printf("erase/program di luar flash_safe_execute: %lu\n  %s\n", (unsigned long)fake_hw_flash_unsafe_ops(),
+           safe_ok ? "OK" : "GAGAL");
+    ok &= safe_ok;
+
+    printf("%s\n", ok ? "OK" : "GAGAL");
+    return ok ? 0 : 1;
+}
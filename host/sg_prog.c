@@ -0,0 +1,336 @@
+/**
+ * sg_prog: pemeriksaan interpreter program sequence hierarkis di simulasi.
+ *
+ * Beberapa program (termasuk pola 10^9 periode dan pola tanpa akhir dengan
+ * JUMP) dijalankan lewat sg_prog_service()/sg_prog_run() di atas simulasi PIO.
+ * Setiap edge pin dibandingkan per siklus dengan ekspansi referensi yang
+ * dihitung terpisah, sehingga jeda sekecil satu siklus di batas REPEAT/END
+ * atau FIFO yang sempat kosong langsung terdeteksi.
+ *
+ * Pemakaian: sg_prog [--duration-us <n>]
+ * Exit 1 jika ada perbedaan.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fake_hw.h"
+#include "signal_prog.h"
+
+#define PIN_BASE 6
+#define PIN_COUNT 4
+#define PIN_MASK (((1u << PIN_COUNT) - 1u) << PIN_BASE)
+
+typedef struct
+{
+    uint64_t cycle; // Siklus clk_sys
+    uint32_t levels;
+} transition;
+
+typedef struct
+{
+    transition *items;
+    size_t count;
+    size_t capacity;
+} transition_list;
+
+static transition_list captured;
+
+static void push_transition(transition_list *list, uint64_t cycle, uint32_t levels)
+{
+    if (list->count == list->capacity)
+    {
+        list->capacity = list->capacity ? 2 * list->capacity : 4096;
+        list->items = realloc(list->items, list->capacity * sizeof(transition));
+        if (!list->items)
+        {
+            fprintf(stderr, "sg_prog: memori habis\n");
+            exit(2);
+        }
+    }
+    list->items[list->count].cycle = cycle;
+    list->items[list->count].levels = levels;
+    list->count++;
+}
+
+static void on_pins(void *ctx, uint64_t time_ps, uint32_t levels, uint32_t changed)
+{
+    (void)ctx;
+    (void)time_ps;
+    if (changed & PIN_MASK)
+    {
+        push_transition(&captured, fake_hw_sys_cycles(), (levels & PIN_MASK) >> PIN_BASE);
+    }
+}
+
+// -- Ekspansi Referensi --
+
+/**
+ * @brief State ekspansi referensi: transisi pin yang diharapkan dengan
+ *        event bermask sama digabung.
+ */
+typedef struct
+{
+    transition_list *out;
+    uint64_t cycle;
+    uint32_t levels;
+    uint64_t budget; // Sisa event yang diekspansi
+    uint64_t events;
+} reference;
+
+static void ref_event(reference *r, uint32_t event)
+{
+    uint32_t mask = SG_SEQ_EVENT_MASK(event) & ((1u << PIN_COUNT) - 1u);
+    if (mask != r->levels)
+    {
+        push_transition(r->out, r->cycle, mask);
+        r->levels = mask;
+    }
+    r->cycle += SG_SEQ_EVENT_CYCLES(event);
+    r->budget--;
+    r->events++;
+}
+
+/**
+ * @brief Mengekspansi program secara rekursif mulai dari pc sampai END
+ *        yang menutup level ini, HALT, atau budget habis.
+ *
+ * @return Indeks word setelah END, atau length jika berhenti
+ */
+static uint ref_expand(reference *r, const uint32_t *code, uint length, uint pc, bool *halted)
+{
+    while (pc < length && r->budget > 0 && !*halted)
+    {
+        uint32_t word = code[pc];
+        uint32_t operand = word & SG_PROG_OPERAND_MASK;
+        switch (word >> SG_PROG_OP_SHIFT)
+        {
+        case SG_PROG_OP_EMIT:
+            for (uint i = 0; i < operand && r->budget > 0; ++i)
+            {
+                ref_event(r, code[pc + 1 + i]);
+            }
+            pc += 1 + operand;
+            break;
+        case SG_PROG_OP_REPEAT:
+        {
+            uint after = pc + 1;
+            for (uint32_t n = 0; n < operand && r->budget > 0 && !*halted; ++n)
+            {
+                after = ref_expand(r, code, length, pc + 1, halted);
+            }
+            pc = after;
+            break;
+        }
+        case SG_PROG_OP_END:
+            return pc + 1;
+        case SG_PROG_OP_JUMP:
+            pc = operand;
+            break;
+        default:
+            *halted = true;
+            break;
+        }
+    }
+    if (pc >= length)
+    {
+        *halted = true;
+    }
+    return pc;
+}
+
+// -- Kasus Uji --
+
+typedef struct
+{
+    const char *name;
+    const uint32_t *code;
+    uint length;
+    uint64_t run_us; // 0 = jalankan sampai HALT dengan sg_prog_run()
+} prog_case;
+
+// 10^9 burst: 3 pulsa 320 ns lalu jeda 1.6 us, diulang 1000 x 10^6 kali
+static const uint32_t prog_billion[] = {
+    SG_PROG_REPEAT(1000),
+    SG_PROG_REPEAT(1000000),
+    SG_PROG_REPEAT(3),
+    SG_PROG_EMIT(2),
+    SG_SEQ_EVENT(0x1, 40),
+    SG_SEQ_EVENT(0x0, 40),
+    SG_PROG_END,
+    SG_PROG_EMIT(1),
+    SG_SEQ_EVENT(0x2, 200),
+    SG_PROG_END,
+    SG_PROG_END,
+    SG_PROG_HALT,
+};
+
+// Semua batas loop sering dilewati dan program berakhir dengan HALT
+static const uint32_t prog_nested[] = {
+    SG_PROG_REPEAT(3),
+    SG_PROG_REPEAT(4),
+    SG_PROG_EMIT(2),
+    SG_SEQ_EVENT(0x1, 24),
+    SG_SEQ_EVENT(0x0, 24),
+    SG_PROG_END,
+    SG_PROG_EMIT(1),
+    SG_SEQ_EVENT(0x4, 32),
+    SG_PROG_REPEAT(2),
+    SG_PROG_EMIT(1),
+    SG_SEQ_EVENT(0x8, 24),
+    SG_PROG_END,
+    SG_PROG_END,
+    SG_PROG_EMIT(1),
+    SG_SEQ_EVENT(0x0, 64),
+    SG_PROG_HALT,
+};
+
+// Pembuka sekali, lalu badan berulang tanpa akhir lewat JUMP
+static const uint32_t prog_forever[] = {
+    SG_PROG_EMIT(1),
+    SG_SEQ_EVENT(0x0, 100),
+    SG_PROG_REPEAT(5),
+    SG_PROG_EMIT(2),
+    SG_SEQ_EVENT(0x3, 30),
+    SG_SEQ_EVENT(0x1, 30),
+    SG_PROG_END,
+    SG_PROG_EMIT(1),
+    SG_SEQ_EVENT(0x0, 60),
+    SG_PROG_JUMP(2),
+};
+
+static bool run_case(const prog_case *c, uint64_t default_us)
+{
+    fake_hw_reset();
+    fake_hw_log_set_enabled(false);
+    memset(&captured, 0, sizeof(captured));
+    fake_hw_set_pin_listener(on_pins, NULL);
+
+    uint64_t expanded = sg_prog_expanded_events(c->code, c->length);
+    sg_seq_instance inst;
+    sg_prog_state state;
+    if (!sg_seq_init(&inst, pio0, PIN_BASE, PIN_COUNT) || !sg_prog_start(&inst, &state, c->code, c->length, 1.0f, 0))
+    {
+        printf("%s: program ditolak\n", c->name);
+        return false;
+    }
+
+    bool underrun = false;
+    if (c->run_us == 0)
+    {
+        sg_prog_run(&inst, &state);
+        fake_hw_advance_us(10); // Event terakhir selesai
+    }
+    else
+    {
+        uint64_t stop_at = fake_hw_now_ps() + (c->run_us ? c->run_us : default_us) * 1000000ull;
+        while (fake_hw_now_ps() < stop_at)
+        {
+            sg_prog_service(&inst, &state);
+        }
+        // FIFO tidak boleh pernah kosong selama program belum selesai
+        underrun = fake_hw_pio(0)->sm[inst.sm].tx_stall;
+    }
+    sg_seq_stop(&inst);
+    sg_seq_deinit(&inst);
+
+    // Transisi yang diharapkan untuk event yang benar-benar dikirim ke FIFO
+    transition_list expected = {0};
+    reference ref = {.out = &expected, .budget = state.events};
+    bool halted = false;
+    ref_expand(&ref, c->code, c->length, 0, &halted);
+
+    // Bandingkan relatif terhadap transisi pertama; transisi terakhir pada
+    // run terbatas adalah stop, bukan bagian program
+    size_t compare = captured.count < expected.count ? captured.count : expected.count;
+    if (c->run_us != 0 && compare == captured.count && compare > 0)
+    {
+        compare--;
+    }
+    size_t mismatches = 0;
+    for (size_t i = 0; i < compare; ++i)
+    {
+        uint64_t got = captured.items[i].cycle - captured.items[0].cycle;
+        uint64_t want = expected.items[i].cycle - expected.items[0].cycle;
+        if (got != want || captured.items[i].levels != expected.items[i].levels)
+        {
+            if (mismatches < 5)
+            {
+                printf("  transisi %zu: siklus %llu level 0x%x, seharusnya siklus %llu level 0x%x\n", i,
+                       (unsigned long long)got, captured.items[i].levels, (unsigned long long)want,
+                       expected.items[i].levels);
+            }
+            mismatches++;
+        }
+    }
+    bool complete = c->run_us != 0 || (state.halted && state.events == expanded);
+    // Program yang selesai juga harus menghasilkan seluruh transisi plus stop
+    if (c->run_us == 0 && captured.count < expected.count)
+    {
+        mismatches++;
+    }
+
+    bool ok = mismatches == 0 && !underrun && complete && compare > 0;
+    printf("%s: %u word (%zu byte), ", c->name, c->length, c->length * sizeof(uint32_t));
+    if (expanded == SG_PROG_INFINITE)
+    {
+        printf("tanpa akhir\n");
+    }
+    else
+    {
+        printf("%llu event hasil ekspansi\n", (unsigned long long)expanded);
+    }
+    printf("  %llu event dikirim, %zu transisi dibandingkan, %zu berbeda%s%s\n", (unsigned long long)state.events,
+           compare, mismatches, underrun ? ", FIFO sempat kosong" : "", complete ? "" : ", program tidak selesai");
+    printf("  %s\n", ok ? "OK" : "GAGAL");
+    free(captured.items);
+    free(expected.items);
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    uint64_t duration_us = 2000;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--duration-us") == 0 && i + 1 < argc)
+        {
+            duration_us = strtoull(argv[++i], NULL, 0);
+        }
+        else
+        {
+            fprintf(stderr, "pemakaian: %s [--duration-us <n>]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    const prog_case cases[] = {
+        {"billion_bursts", prog_billion, count_of(prog_billion), duration_us},
+        {"nested_halt", prog_nested, count_of(prog_nested), 0},
+        {"jump_forever", prog_forever, count_of(prog_forever), duration_us},
+    };
+
+    bool ok = true;
+    for (uint i = 0; i < count_of(cases); ++i)
+    {
+        ok &= run_case(&cases[i], duration_us);
+    }
+
+    // Program yang salah bentuk harus ditolak
+    static const uint32_t bad_unbalanced[] = {SG_PROG_REPEAT(2), SG_PROG_EMIT(1), SG_SEQ_EVENT(1, 8)};
+    static const uint32_t bad_empty_loop[] = {SG_PROG_REPEAT(2), SG_PROG_END, SG_PROG_EMIT(1), SG_SEQ_EVENT(1, 8)};
+    static const uint32_t bad_jump_loop[] = {SG_PROG_EMIT(0), SG_PROG_JUMP(0)};
+    static const uint32_t bad_emit[] = {SG_PROG_EMIT(3), SG_SEQ_EVENT(1, 8)};
+    bool rejected = !sg_prog_validate(bad_unbalanced, count_of(bad_unbalanced)) &&
+                    !sg_prog_validate(bad_empty_loop, count_of(bad_empty_loop)) &&
+                    !sg_prog_validate(bad_jump_loop, count_of(bad_jump_loop)) &&
+                    !sg_prog_validate(bad_emit, count_of(bad_emit));
+    printf("validasi program salah bentuk: %s\n", rejected ? "OK" : "GAGAL");
+    ok &= rejected;
+
+    printf("%s\n", ok ? "OK" : "GAGAL");
+    return ok ? 0 : 1;
+}
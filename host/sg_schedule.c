@@ -0,0 +1,334 @@
+/**
+ * sg_schedule: pemeriksaan start terjadwal (sg_schedule, sg_schedule_pps)
+ * di simulasi.
+ *
+ * Diperiksa:
+ *   - edge naik CH1 pertama muncul tepat jeda trigger (minimal
+ *     SG_TRIGGER_LATENCY_CYCLES) setelah tick mikrodetik target, baik dengan
+ *     CPU memberi data (sg_run_armed_burst) maupun CPU diam,
+ *   - dua generator yang dijadwalkan pada waktu sama mulai bersamaan,
+ *   - target yang sudah lewat ditolak tanpa output dan tanpa alarm tertahan,
+ *   - sg_stop() membatalkan jadwal yang belum jatuh tempo,
+ *   - start PPS sejajar edge naik PPS pertama setelah waktu arm, dan jadwal
+ *     dibatalkan jika PPS sedang HIGH saat alarm.
+ *
+ * Handler interrupt di fake berjalan tanpa latensi, jadi start_late_us
+ * selalu 0 di sini; di hardware nilainya adalah latensi entry interrupt.
+ *
+ * Pemakaian: sg_schedule
+ * Exit 1 jika ada perbedaan.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "fake_hw.h"
+#include "hardware/clocks.h"
+#include "hardware/gpio.h"
+#include "hardware/timer.h"
+#include "signal_gen.h"
+
+#define PIN_CH1_BASE 6
+#define PIN_CH2_BASE 10
+#define PPS_PIN 20
+#define MAX_RISES 8
+
+// -- Edge Naik CH1 dan CH2 --
+typedef struct
+{
+    uint pin;
+    uint64_t time_ps[MAX_RISES];
+    uint count;
+    bool level;
+} rise_log;
+
+static rise_log ch[2];
+
+static void on_pins(void *ctx, uint64_t time_ps, uint32_t levels, uint32_t changed)
+{
+    (void)ctx;
+    for (uint i = 0; i < count_of(ch); ++i)
+    {
+        if (!(changed & (1u << ch[i].pin)))
+        {
+            continue;
+        }
+        bool level = (levels >> ch[i].pin) & 1u;
+        if (level && !ch[i].level && ch[i].count < MAX_RISES)
+        {
+            ch[i].time_ps[ch[i].count++] = time_ps;
+        }
+        ch[i].level = level;
+    }
+}
+
+static bool start_case(sg_instance *gen, uint pin_base, float pio_clk_div, uint64_t delay_ns)
+{
+    const sg_timing_config timing = {
+        .frequency_hz = 10000.0f,
+        .pulse_width_us = 2.0f,
+        .phase_shift_us = 1.0f,
+        .pio_clk_div = pio_clk_div,
+        .trigger_delay_ns = delay_ns,
+    };
+    return sg_init(gen, pio0, pin_base) && sg_configure(gen, &timing);
+}
+
+static void reset_case(void)
+{
+    fake_hw_reset();
+    fake_hw_log_set_enabled(false);
+    memset(ch, 0, sizeof(ch));
+    ch[0].pin = PIN_CH1_BASE;
+    ch[1].pin = PIN_CH2_BASE;
+    fake_hw_set_pin_listener(on_pins, NULL);
+}
+
+static bool no_alarm_claimed(void)
+{
+    for (uint i = 0; i < NUM_ALARMS; ++i)
+    {
+        if (hardware_alarm_is_claimed(i))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Jeda yang diharapkan dari pelepasan sampai edge pertama (siklus PIO).
+ */
+static double expected_delay_cycles(const sg_instance *gen)
+{
+    double pio_clk_hz = (double)clock_get_hz(clk_sys) / gen->timing.pio_clk_div;
+    double cycles = floor((double)gen->timing.trigger_delay_ns * pio_clk_hz / 1e9 + 0.5);
+    return cycles < SG_TRIGGER_LATENCY_CYCLES ? SG_TRIGGER_LATENCY_CYCLES : cycles;
+}
+
+/**
+ * @brief Jarak dari ref_ps ke edge pertama CH1 dalam siklus PIO, -1 jika tidak ada.
+ */
+static double measured_delay_cycles(const sg_instance *gen, const rise_log *log, uint64_t ref_ps)
+{
+    if (log->count == 0 || log->time_ps[0] < ref_ps)
+    {
+        return -1.0;
+    }
+    double pio_clk_hz = (double)clock_get_hz(clk_sys) / gen->timing.pio_clk_div;
+    return (double)(log->time_ps[0] - ref_ps) * 1e-12 * pio_clk_hz;
+}
+
+// -- Start pada Timestamp --
+
+typedef struct
+{
+    const char *name;
+    float pio_clk_div;
+    uint64_t delay_ns;
+    uint64_t lead_us; // Jarak waktu target dari saat penjadwalan
+    bool cpu_feed;    // true = sg_run_armed_burst(), false = CPU diam
+} timer_case;
+
+static bool run_timer_case(const timer_case *c)
+{
+    reset_case();
+    sg_instance gen;
+    if (!start_case(&gen, PIN_CH1_BASE, c->pio_clk_div, c->delay_ns))
+    {
+        printf("%s: konfigurasi ditolak\n", c->name);
+        return false;
+    }
+
+    uint64_t target_us = fake_hw_now_ps() / 1000000ull + c->lead_us;
+    bool scheduled = sg_schedule(&gen, from_us_since_boot(target_us));
+    bool claimed = !no_alarm_claimed();
+
+    double delay_cycles = expected_delay_cycles(&gen);
+    uint64_t settle_us = c->lead_us + (uint64_t)(delay_cycles * c->pio_clk_div / 125.0) + 260;
+    bool early = false;
+    if (c->cpu_feed)
+    {
+        sg_run_armed_burst(&gen, settle_us - c->lead_us);
+    }
+    else
+    {
+        // Target dibulatkan ke bawah ke tick mikrodetik, jadi lead - 1 us belum sampai
+        fake_hw_advance_us(c->lead_us - 1);
+        early = ch[0].count > 0;
+        fake_hw_advance_us(settle_us - c->lead_us + 1);
+        sg_stop(&gen);
+    }
+    bool released = no_alarm_claimed() && gen.alarm < 0;
+    sg_deinit(&gen);
+    fake_hw_set_pin_listener(NULL, NULL);
+
+    // Alarm sinkron terhadap clk_sys, tetapi fase tick PIO terhadap tick target
+    // bebas (hingga +1 siklus PIO) dan clock divider pecahan membuat jeda N
+    // siklus PIO bisa hanya floor(N x div) siklus clk_sys
+    double measured = measured_delay_cycles(&gen, &ch[0], target_us * 1000000ull);
+    double lower = floor(delay_cycles * c->pio_clk_div + 1e-6) / c->pio_clk_div;
+    bool delay_ok = measured >= lower - 1e-6 && measured < delay_cycles + 1.0;
+    bool period_ok = c->cpu_feed ? ch[0].count > 2 : ch[0].count == 1;
+
+    bool ok = scheduled && claimed && released && !early && delay_ok && period_ok && gen.start_late_us == 0;
+    printf("%s: div %.1f, jeda %llu ns = %.0f siklus PIO, target +%llu us%s\n", c->name, c->pio_clk_div,
+           (unsigned long long)c->delay_ns, delay_cycles, (unsigned long long)c->lead_us,
+           c->cpu_feed ? ", feed CPU" : ", CPU diam");
+    printf("  terukur %.3f siklus PIO dari target, %u edge CH1, terlambat %ld us%s%s\n", measured, ch[0].count,
+           (long)gen.start_late_us, early ? ", output sebelum target" : "", released ? "" : ", alarm tertahan");
+    printf("  %s\n", ok ? "OK" : "GAGAL");
+    return ok;
+}
+
+static bool run_simultaneous(void)
+{
+    reset_case();
+    sg_instance a, b;
+    if (!start_case(&a, PIN_CH1_BASE, 1.0f, 0) || !start_case(&b, PIN_CH2_BASE, 1.0f, 0))
+    {
+        printf("simultan: konfigurasi ditolak\n");
+        return false;
+    }
+    absolute_time_t target = from_us_since_boot(fake_hw_now_ps() / 1000000ull + 333);
+    bool scheduled = sg_schedule(&a, target) && sg_schedule(&b, target) && a.alarm != b.alarm;
+    fake_hw_advance_us(400);
+    sg_stop(&a);
+    sg_stop(&b);
+    sg_deinit(&a);
+    sg_deinit(&b);
+    fake_hw_set_pin_listener(NULL, NULL);
+
+    bool ok = scheduled && ch[0].count == 1 && ch[1].count == 1 && ch[0].time_ps[0] == ch[1].time_ps[0];
+    printf("simultan: dua state machine, alarm %s, edge pertama CH1/CH2 %s\n  %s\n",
+           scheduled ? "terpisah" : "gagal", ok ? "bersamaan" : "berbeda", ok ? "OK" : "GAGAL");
+    return ok;
+}
+
+static bool run_missed_and_cancel(void)
+{
+    reset_case();
+    sg_instance gen;
+    if (!start_case(&gen, PIN_CH1_BASE, 1.0f, 0))
+    {
+        printf("batal: konfigurasi ditolak\n");
+        return false;
+    }
+    fake_hw_advance_us(50);
+
+    // Target yang sudah lewat
+    bool missed = !sg_schedule(&gen, from_us_since_boot(10)) && gen.state == SG_STATE_IDLE && no_alarm_claimed();
+
+    // Jadwal dibatalkan sebelum jatuh tempo, lalu instance bisa dijadwalkan lagi
+    uint64_t target_us = fake_hw_now_ps() / 1000000ull + 200;
+    bool scheduled = sg_schedule(&gen, from_us_since_boot(target_us));
+    bool busy = !sg_schedule(&gen, from_us_since_boot(target_us + 10));
+    fake_hw_advance_us(100);
+    sg_stop(&gen);
+    bool cancelled = gen.state == SG_STATE_IDLE && no_alarm_claimed();
+    fake_hw_advance_us(300);
+    bool silent = ch[0].count == 0;
+
+    uint64_t again_us = fake_hw_now_ps() / 1000000ull + 50;
+    bool rescheduled = sg_schedule(&gen, from_us_since_boot(again_us));
+    fake_hw_advance_us(60);
+    bool restarted = ch[0].count == 1 && ch[0].time_ps[0] > again_us * 1000000ull;
+    sg_stop(&gen);
+    sg_deinit(&gen);
+    fake_hw_set_pin_listener(NULL, NULL);
+
+    bool ok = missed && scheduled && busy && cancelled && silent && rescheduled && restarted;
+    printf("batal: target lewat %s, jadwal ganda %s, sg_stop %s, output %s, jadwal ulang %s\n  %s\n",
+           missed ? "ditolak" : "DITERIMA", busy ? "ditolak" : "DITERIMA", cancelled ? "membatalkan" : "GAGAL",
+           silent ? "diam" : "KELUAR", restarted ? "berjalan" : "GAGAL", ok ? "OK" : "GAGAL");
+    return ok;
+}
+
+// -- Start pada Edge PPS --
+
+static bool run_pps(const char *name, float pio_clk_div, uint64_t delay_ns, bool arm_while_high)
+{
+    reset_case();
+    gpio_init(PPS_PIN);
+    gpio_set_dir(PPS_PIN, GPIO_IN);
+    sg_instance gen;
+    if (!start_case(&gen, PIN_CH1_BASE, pio_clk_div, delay_ns))
+    {
+        printf("%s: konfigurasi ditolak\n", name);
+        return false;
+    }
+
+    // "PPS" 1 kHz dengan pulsa 100 us, fase tidak sejajar clk_sys
+    const uint64_t pps_period_ps = 1000000000ull;
+    const uint64_t pps_start_ps = 20000000ull + 3217ull;
+    fake_hw_gpio_drive_clock(PPS_PIN, pps_start_ps, pps_period_ps * 1000ull, 100000000ull * 1000ull);
+
+    // Arm di tengah detik (PPS LOW), atau 50 us setelah edge (PPS HIGH)
+    uint64_t arm_us = arm_while_high ? 2050 : 2500;
+    bool scheduled = sg_schedule_pps(&gen, from_us_since_boot(arm_us), PPS_PIN);
+    absolute_time_t start = sg_run_armed_burst(&gen, 1500);
+    bool released = no_alarm_claimed();
+    sg_stop(&gen);
+    sg_deinit(&gen);
+    fake_hw_gpio_stop_clock(PPS_PIN);
+    fake_hw_set_pin_listener(NULL, NULL);
+
+    bool ok;
+    uint64_t edge_ps = pps_start_ps;
+    while (edge_ps < arm_us * 1000000ull)
+    {
+        edge_ps += pps_period_ps;
+    }
+    if (arm_while_high)
+    {
+        ok = scheduled && is_nil_time(start) && ch[0].count == 0 && released;
+        printf("%s: arm saat PPS HIGH -> %s, %u edge CH1\n", name,
+               is_nil_time(start) ? "dibatalkan" : "TIDAK dibatalkan", ch[0].count);
+    }
+    else
+    {
+        // Edge PPS asinkron terhadap clock PIO: hasil di [jeda, jeda + 1)
+        double delay_cycles = expected_delay_cycles(&gen);
+        double measured = measured_delay_cycles(&gen, &ch[0], edge_ps);
+        ok = scheduled && !is_nil_time(start) && released && ch[0].count > 2 && measured >= delay_cycles - 1e-6 &&
+             measured < delay_cycles + 1.0;
+        printf("%s: div %.1f, jeda %.0f siklus PIO, edge PPS %.6f us\n", name, pio_clk_div, delay_cycles,
+               (double)edge_ps * 1e-6);
+        printf("  terukur %.3f siklus PIO dari edge PPS, %u edge CH1\n", measured, ch[0].count);
+    }
+    printf("  %s\n", ok ? "OK" : "GAGAL");
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 1)
+    {
+        fprintf(stderr, "pemakaian: %s\n", argv[0]);
+        return 2;
+    }
+
+    const timer_case cases[] = {
+        {"timer_zero", 1.0f, 0, 200, true},
+        {"timer_1us", 1.0f, 1000, 137, false},
+        {"timer_10us_div12p5", 12.5f, 10000, 421, true},
+        {"timer_idle_div2p5", 2.5f, 0, 1000, false},
+    };
+
+    bool ok = true;
+    for (uint i = 0; i < count_of(cases); ++i)
+    {
+        ok &= run_timer_case(&cases[i]);
+    }
+    ok &= run_simultaneous();
+    ok &= run_missed_and_cancel();
+    ok &= run_pps("pps_zero", 1.0f, 0, false);
+    ok &= run_pps("pps_1us_div12p5", 12.5f, 1000, false);
+    ok &= run_pps("pps_high", 1.0f, 0, true);
+
+    printf("%s\n", ok ? "OK" : "GAGAL");
+    return ok ? 0 : 1;
+}
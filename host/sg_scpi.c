@@ -0,0 +1,528 @@
+/**
+ * sg_scpi: pemeriksaan parser SCPI (signal_scpi) dan benchmark throughput.
+ *
+ * Diperiksa:
+ *   - *IDN?, SYST:VERS?, query setiap parameter dan jawaban gabungan ';',
+ *   - bentuk pendek/panjang, huruf kecil, node opsional, aturan path ';',
+ *     satuan (kHz, us, ...) dan eksponen,
+ *   - kode error standar di SYST:ERR? (urutan FIFO, Queue overflow,
+ *     Input buffer overrun untuk baris terlalu panjang),
+ *   - input yang datang per byte di antara poll sama dengan satu blok,
+ *   - OUTP ON/OFF, update frekuensi saat berjalan tanpa periode campuran,
+ *     BURS:NCYC dengan TRIG:SOUR IMM, BUS (*TRG) dan EXT (pin trigger),
+ *     dan penghitung periode yang berjalan menghitung tepat setiap burst,
+ *   - BURS:NCYC 1 dan 7 pada 500 kHz tepat jumlahnya walau poll berikutnya
+ *     baru datang puluhan periode kemudian,
+ *   - *RST mengembalikan konfigurasi awal.
+ *
+ * Benchmark: waktu CPU host per perintah dan per byte untuk campuran perintah
+ * set/query, lalu banjir perintah ke generator 50 kHz yang berjalan dengan
+ * satu poll per us simulasi: setiap periode harus utuh dan tidak ada celah.
+ * Terakhir jawaban yang lambat: fungsi write memblok beberapa periode per
+ * jawaban, dan tetap tidak ada periode yang memanjang.
+ *
+ * Pemakaian: sg_scpi
+ * Exit 1 jika ada perbedaan.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "fake_hw.h"
+#include "hardware/clocks.h"
+#include "hardware/gpio.h"
+#include "signal_scpi.h"
+
+#define PIN_CH1_BASE 6
+#define TRIGGER_PIN 2
+#define MAX_PERIODS 16384
+#define OUTPUT_SIZE 65536
+#define BENCH_LINES 20000
+#define FLOOD_LINES 2000
+#define SLOW_LINES 200
+#define SLOW_WRITE_US 150 // Jawaban memblok 7,5 periode pada 50 kHz
+#define COUNT_INTERVAL 3  // Batch pendek: compare bergantian dengan ping-pong biasa
+
+// -- Edge CH1: periode (naik ke naik) dan lebar pulsa --
+static struct
+{
+    bool level;
+    uint64_t rise_ps[MAX_PERIODS];
+    uint64_t width_ps[MAX_PERIODS];
+    uint count;
+} ch1;
+
+static void on_pins(void *ctx, uint64_t time_ps, uint32_t levels, uint32_t changed)
+{
+    (void)ctx;
+    if (!(changed & (1u << PIN_CH1_BASE)))
+    {
+        return;
+    }
+    bool level = (levels >> PIN_CH1_BASE) & 1u;
+    if (level && !ch1.level && ch1.count < MAX_PERIODS)
+    {
+        ch1.rise_ps[ch1.count++] = time_ps;
+    }
+    else if (!level && ch1.level && ch1.count > 0)
+    {
+        ch1.width_ps[ch1.count - 1] = time_ps - ch1.rise_ps[ch1.count - 1];
+    }
+    ch1.level = level;
+}
+
+// -- Jawaban SCPI --
+static struct
+{
+    char text[OUTPUT_SIZE];
+    size_t len;
+    uint64_t write_us; // Waktu simulasi yang dihabiskan setiap write
+} output;
+
+static void capture(void *ctx, const char *data, size_t len)
+{
+    (void)ctx;
+    // USB CDC yang lambat: CPU tertahan di fwrite/fflush
+    fake_hw_advance_us(output.write_us);
+    for (size_t i = 0; i < len; ++i)
+    {
+        if (output.len < OUTPUT_SIZE - 1)
+        {
+            output.text[output.len++] = data[i];
+        }
+    }
+    output.text[output.len] = '\0';
+}
+
+static void clear_output(void)
+{
+    output.len = 0;
+    output.text[0] = '\0';
+}
+
+/**
+ * @brief Bentuk satu periode CH1 dalam siklus clk_sys.
+ */
+typedef struct
+{
+    uint64_t period;
+    uint64_t width;
+} shape;
+
+static shape make_shape(float freq_hz, float width_us, float phase_us)
+{
+    const sg_timing_config timing = {
+        .frequency_hz = freq_hz,
+        .pulse_width_us = width_us,
+        .phase_shift_us = phase_us,
+        .pio_clk_div = 1.0f,
+    };
+    uint32_t delays[SG_NUM_EVENTS];
+    sg_calculate_delays((float)clock_get_hz(clk_sys), &timing, delays);
+    shape s = {.width = delays[0] + SG_EVENT_OVERHEAD_CYCLES};
+    for (uint i = 0; i < SG_NUM_EVENTS; ++i)
+    {
+        s.period += delays[i] + SG_EVENT_OVERHEAD_CYCLES;
+    }
+    s.period += SG_EVENT_D_OVERHEAD_CYCLES - SG_EVENT_OVERHEAD_CYCLES;
+    return s;
+}
+
+static uint64_t ps_to_cycles(uint64_t ps)
+{
+    return ps * (clock_get_hz(clk_sys) / 1000000u) / 1000000u;
+}
+
+static bool period_is(uint i, const shape *s)
+{
+    return ps_to_cycles(ch1.rise_ps[i + 1] - ch1.rise_ps[i]) == s->period && ps_to_cycles(ch1.width_ps[i]) == s->width;
+}
+
+/**
+ * @brief Setiap periode utuh di [first, count) berbentuk a, lalu (opsional) b
+ *        tanpa kembali ke a.
+ */
+static bool periods_switch(uint first, const shape *a, const shape *b)
+{
+    bool switched = false;
+    for (uint i = first; i + 1 < ch1.count; ++i)
+    {
+        if (!switched && period_is(i, a))
+        {
+            continue;
+        }
+        if (b && period_is(i, b))
+        {
+            switched = true;
+            continue;
+        }
+        printf("  periode %u: %llu siklus, lebar %llu siklus tidak cocok\n", i,
+               (unsigned long long)ps_to_cycles(ch1.rise_ps[i + 1] - ch1.rise_ps[i]),
+               (unsigned long long)ps_to_cycles(ch1.width_ps[i]));
+        return false;
+    }
+    return true;
+}
+
+static sg_instance gen;
+static sg_count_instance counter;
+static sg_scpi_instance scpi;
+
+/**
+ * @brief Loop firmware simulasi: satu poll per us.
+ */
+static void run_us(uint64_t us)
+{
+    for (uint64_t t = 0; t < us; ++t)
+    {
+        sg_scpi_poll(&scpi);
+        fake_hw_advance_us(1);
+    }
+}
+
+static void send(const char *text)
+{
+    size_t len = strlen(text);
+    if (sg_scpi_receive(&scpi, (const uint8_t *)text, len) != len)
+    {
+        printf("  ring penuh saat mengirim \"%s\"\n", text);
+    }
+}
+
+/**
+ * @brief Mengirim satu baris dan menunggu sampai dieksekusi.
+ *
+ * @return Jawaban baris (tanpa newline), kosong jika tidak ada
+ */
+static const char *command(const char *line)
+{
+    clear_output();
+    send(line);
+    send("\n");
+    for (uint i = 0; i < 1000 && scpi.head != scpi.tail; ++i)
+    {
+        run_us(1);
+    }
+    run_us(1);
+    if (output.len > 0 && output.text[output.len - 1] == '\n')
+    {
+        output.text[--output.len] = '\0';
+    }
+    return output.text;
+}
+
+static bool expect(const char *line, const char *expected)
+{
+    const char *got = command(line);
+    bool ok = strcmp(got, expected) == 0;
+    if (!ok)
+    {
+        printf("  \"%s\" -> \"%s\", diharapkan \"%s\"\n", line, got, expected);
+    }
+    return ok;
+}
+
+static bool no_errors(void)
+{
+    return expect("SYST:ERR?", "0,\"No error\"");
+}
+
+static void trigger_pulse(void)
+{
+    fake_hw_gpio_set_input(TRIGGER_PIN, true);
+    run_us(5);
+    fake_hw_gpio_set_input(TRIGGER_PIN, false);
+}
+
+static double elapsed_s(const struct timespec *start)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)(now.tv_sec - start->tv_sec) + (double)(now.tv_nsec - start->tv_nsec) * 1e-9;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 1)
+    {
+        fprintf(stderr, "pemakaian: %s\n", argv[0]);
+        return 2;
+    }
+
+    fake_hw_reset();
+    fake_hw_log_set_enabled(false);
+    memset(&ch1, 0, sizeof(ch1));
+    fake_hw_set_pin_listener(on_pins, NULL);
+    gpio_init(TRIGGER_PIN);
+    gpio_set_dir(TRIGGER_PIN, GPIO_IN);
+    fake_hw_gpio_set_input(TRIGGER_PIN, false);
+
+    const sg_timing_config timing = {
+        .frequency_hz = 10000.0f,
+        .pulse_width_us = 2.0f,
+        .phase_shift_us = 1.0f,
+        .pio_clk_div = 1.0f,
+    };
+    sg_count_init(&counter);
+    if (!sg_init(&gen, pio0, PIN_CH1_BASE) || !sg_configure(&gen, &timing) ||
+        !sg_count_start(&counter, &gen, COUNT_INTERVAL, NULL, NULL) ||
+        !sg_scpi_init(&scpi, &gen, &counter, TRIGGER_PIN, true, capture, NULL))
+    {
+        printf("konfigurasi ditolak\nGAGAL\n");
+        return 1;
+    }
+    bool ok = true;
+
+    // -- Identitas dan query --
+    bool ident_ok = expect("*IDN?", SG_SCPI_IDN) && expect("  *idn?  \r", SG_SCPI_IDN) &&
+                    expect("SYST:VERS?", "1999.0") && expect("*OPC?", "1") &&
+                    expect("FREQ?;PULS:WIDT?;:PHAS?", "10000;2e-06;1e-06") &&
+                    expect("BURS:NCYC?;:TRIG:SOUR?;:OUTP?", "9.9E37;IMM;0") && no_errors();
+    printf("identitas dan query awal\n  %s\n", ident_ok ? "OK" : "GAGAL");
+    ok &= ident_ok;
+
+    // -- Bentuk header, path dan satuan --
+    bool syntax_ok = expect("sour:freq 2.5e3;puls:widt 3 us", "") &&
+                     expect(":SOURce:FREQuency:CW?;:PULSe:WIDTh?", "2500;3e-06") &&
+                     expect("PULS:WIDT 1500NS;WIDT?", "1.5e-06") && expect("FREQ 0.004MHZ;FREQ?", "4000") &&
+                     expect("phase 2E-6;:phas?", "2e-06") && expect("FREQ 10 kHz;:PULS:WIDT 2US;:PHAS 1us", "") &&
+                     expect("TRIGGER:SEQUENCE:SOURCE BUS;:TRIG:SOUR?", "BUS") &&
+                     expect("TRIG:SOUR imm;SOUR?", "IMM") && no_errors();
+    printf("header pendek/panjang, path ';' dan satuan\n  %s\n", syntax_ok ? "OK" : "GAGAL");
+    ok &= syntax_ok;
+
+    // -- Kode error --
+    // Sembilan error: yang terakhir tidak muat dan menjadi Queue overflow
+    command("FREQ 2e9;:FREQ 1MHz;:FREQ;:FREQ? 5;:FREQ abc;:FREQ 5 parsec;:PULS:WID 1us;*IDN;*RST 1");
+    bool errors_ok = expect("SYST:ERR?;ERR?;ERR?;ERR?", "-222,\"Data out of range\";-222,\"Data out of range\";"
+                                                        "-109,\"Missing parameter\";-108,\"Parameter not allowed\"") &&
+                     expect("SYST:ERR?;ERR?;ERR?;ERR?", "-104,\"Data type error\";-131,\"Invalid suffix\";"
+                                                        "-113,\"Undefined header\";-350,\"Queue overflow\"") &&
+                     no_errors() && expect("FREQ?", "10000");
+    command("BURS:NCYC 2.5;:OUTP maybe;:*TRG");
+    errors_ok &= expect("SYST:ERR:NEXT?;NEXT?;NEXT?", "-222,\"Data out of range\";-104,\"Data type error\";"
+                                                       "-211,\"Trigger ignored\"");
+    char long_line[SG_SCPI_LINE_MAX + 32];
+    memset(long_line, ' ', sizeof(long_line) - 1);
+    memcpy(&long_line[sizeof(long_line) - 7], "*IDN?", 6);
+    errors_ok &= expect(long_line, "") && expect("SYST:ERR?", "-363,\"Input buffer overrun\"") &&
+                 expect("*IDN?", SG_SCPI_IDN);
+    command("XYZ");
+    errors_ok &= expect("*CLS;SYST:ERR?", "0,\"No error\"");
+    printf("kode error, antrean FIFO dan overflow\n  %s\n", errors_ok ? "OK" : "GAGAL");
+    ok &= errors_ok;
+
+    // -- Input per byte --
+    clear_output();
+    const char *bytes = "FREQ 3000;FREQ?\n";
+    for (const char *p = bytes; *p; ++p)
+    {
+        sg_scpi_receive(&scpi, (const uint8_t *)p, 1);
+        run_us(2);
+    }
+    run_us(2);
+    bool bytes_ok = strcmp(output.text, "3000\n") == 0;
+    printf("input per byte di antara poll: \"%.*s\"\n", (int)(output.len ? output.len - 1 : 0), output.text);
+    bytes_ok &= expect("FREQ 10000", "");
+    printf("  %s\n", bytes_ok ? "OK" : "GAGAL");
+    ok &= bytes_ok;
+
+    // -- OUTP dan update saat berjalan --
+    const shape slow = make_shape(10000.0f, 2.0f, 1.0f);
+    const shape fast = make_shape(12500.0f, 2.0f, 1.0f);
+    uint first = ch1.count;
+    command("OUTP ON");
+    run_us(1000);
+    uint running = ch1.count - first;
+    command("FREQ 12.5kHz");
+    run_us(1000);
+    bool on_ok = running >= 9 && expect("OUTP?", "1") && periods_switch(first, &slow, &fast) &&
+                 period_is(ch1.count - 2, &fast);
+    command("OUTP OFF");
+    run_us(200);
+    uint stopped = ch1.count;
+    run_us(500);
+    on_ok &= ch1.count == stopped && !((fake_hw_gpio_levels() >> PIN_CH1_BASE) & 1u) && expect("OUTP?", "0") &&
+             no_errors();
+    printf("OUTP ON/OFF: %u periode per ms, FREQ saat berjalan tanpa periode campuran\n  %s\n", running,
+           on_ok ? "OK" : "GAGAL");
+    ok &= on_ok;
+
+    // -- Burst IMM --
+    command("FREQ 10kHz;:BURS:NCYC 5");
+    first = ch1.count;
+    uint64_t counted = sg_count_periods(&counter);
+    command("OUTP ON");
+    run_us(1500);
+    uint imm = ch1.count - first;
+    bool imm_ok = imm == 5 && sg_count_periods(&counter) - counted == 5 && expect("OUTP?", "0") &&
+                  periods_switch(first, &slow, NULL);
+    printf("BURS:NCYC 5 TRIG:SOUR IMM: %u pulsa, OUTP kembali 0\n  %s\n", imm, imm_ok ? "OK" : "GAGAL");
+    ok &= imm_ok;
+
+    // -- Burst BUS --
+    command("TRIG:SOUR BUS;:BURS:NCYC 3;:OUTP ON");
+    first = ch1.count;
+    counted = sg_count_periods(&counter);
+    run_us(1000);
+    uint idle = ch1.count - first;
+    command("*TRG");
+    run_us(1000);
+    uint bus1 = ch1.count - first;
+    command("*TRG");
+    run_us(1000);
+    uint bus2 = ch1.count - first;
+    command("TRIG:SOUR IMM");
+    bool bus_ok = idle == 0 && bus1 == 3 && bus2 == 6 && sg_count_periods(&counter) - counted == 6 && expect("SYST:ERR?", "-221,\"Settings conflict\"") &&
+                  expect("OUTP?", "1");
+    command("OUTP OFF");
+    printf("BURS:NCYC 3 TRIG:SOUR BUS: %u sebelum *TRG, %u lalu %u pulsa\n  %s\n", idle, bus1, bus2,
+           bus_ok ? "OK" : "GAGAL");
+    ok &= bus_ok;
+
+    // -- Burst EXT --
+    command("TRIG:SOUR EXT;:BURS:NCYC 2;:OUTP ON");
+    first = ch1.count;
+    counted = sg_count_periods(&counter);
+    run_us(1000);
+    idle = ch1.count - first;
+    trigger_pulse();
+    run_us(1000);
+    uint ext1 = ch1.count - first;
+    trigger_pulse();
+    run_us(1000);
+    uint ext2 = ch1.count - first;
+    command("OUTP OFF");
+    bool ext_ok = idle == 0 && ext1 == 2 && ext2 == 4 && sg_count_periods(&counter) - counted == 4 && no_errors();
+    printf("BURS:NCYC 2 TRIG:SOUR EXT: %u sebelum trigger, %u lalu %u pulsa\n  %s\n", idle, ext1, ext2,
+           ext_ok ? "OK" : "GAGAL");
+    ok &= ext_ok;
+
+    // -- Burst cepat dengan poll jarang --
+    const shape quick = make_shape(500000.0f, 0.5f, 0.2f);
+    bool quick_ok = true;
+    uint quick_count[2];
+    const uint quick_cycles[2] = {1, 7};
+    for (uint k = 0; k < 2; ++k)
+    {
+        char line[96];
+        snprintf(line, sizeof(line), "TRIG:SOUR IMM;:PULS:WIDT 0.5us;:PHAS 0.2us;:FREQ 500kHz;:BURS:NCYC %u",
+                 quick_cycles[k]);
+        quick_ok &= expect(line, "");
+        first = ch1.count;
+        counted = sg_count_periods(&counter);
+        command("OUTP ON");
+        // Tanpa poll selama 50 periode: hanya hardware yang menghentikan burst
+        fake_hw_advance_us(100);
+        quick_count[k] = ch1.count - first;
+        quick_ok &= quick_count[k] == quick_cycles[k] && sg_count_periods(&counter) - counted == quick_cycles[k] &&
+                    periods_switch(first, &quick, NULL) &&
+                    !((fake_hw_gpio_levels() >> PIN_CH1_BASE) & 1u) && expect("OUTP?", "0");
+    }
+    quick_ok &= no_errors() && expect("FREQ 10kHz;:PULS:WIDT 2us;:PHAS 1us", "");
+    printf("BURS:NCYC 1 dan 7 pada 500 kHz, poll setelah 100 us: %u dan %u pulsa\n  %s\n", quick_count[0],
+           quick_count[1], quick_ok ? "OK" : "GAGAL");
+    ok &= quick_ok;
+
+    // -- *RST --
+    command("FREQ 5kHz;:BURS:NCYC 7;:OUTP ON");
+    bool rst_ok = expect("*RST;FREQ?;PULS:WIDT?;:OUTP?;:TRIG:SOUR?;:BURS:NCYC?", "10000;2e-06;0;IMM;9.9E37") &&
+                  no_errors();
+    printf("*RST\n  %s\n", rst_ok ? "OK" : "GAGAL");
+    ok &= rst_ok;
+
+    // -- Throughput parser (CPU host) --
+    static const char *const mix[] = {
+        "FREQ 12345.5;:PULS:WIDT 2us;:PHAS 1.5e-6\n",
+        "FREQ?;:PULS:WIDT?;:PHAS?\n",
+        "SOUR:FREQ:CW 10 kHz;:SOUR:PULS:WIDT 2000 NS;PHAS?\n",
+        "SYST:ERR?;:OUTP?;:BURS:NCYC?\n",
+    };
+    fake_hw_set_pin_listener(NULL, NULL);
+    uint32_t commands_before = scpi.commands;
+    size_t bytes_total = 0;
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (uint i = 0; i < BENCH_LINES; ++i)
+    {
+        const char *line = mix[i % count_of(mix)];
+        clear_output();
+        send(line);
+        bytes_total += strlen(line);
+        while (sg_scpi_poll(&scpi) == 0)
+        {
+        }
+    }
+    double seconds = elapsed_s(&start);
+    uint32_t bench_commands = scpi.commands - commands_before;
+    bool bench_ok = bench_commands == BENCH_LINES * 3 && no_errors();
+    printf("throughput (CPU host, termasuk sg_stage dan hardware simulasi): %lu perintah, %.0f ns/perintah, "
+           "%.1f MB/s\n  %s\n",
+           (unsigned long)bench_commands, seconds * 1e9 / bench_commands, (double)bytes_total / seconds * 1e-6,
+           bench_ok ? "OK" : "GAGAL");
+    ok &= bench_ok;
+    fake_hw_set_pin_listener(on_pins, NULL);
+
+    // -- Banjir perintah ke generator 50 kHz yang berjalan --
+    command("*RST;FREQ 50kHz;:PULS:WIDT 1us;:PHAS 0.5us;:OUTP ON");
+    run_us(200);
+    const shape flood_shape = make_shape(50000.0f, 1.0f, 0.5f);
+    first = ch1.count;
+    uint64_t flood_start_ps = fake_hw_now_ps();
+    commands_before = scpi.commands;
+    for (uint i = 0; i < FLOOD_LINES; ++i)
+    {
+        clear_output();
+        send(i & 1u ? "FREQ?;:PULS:WIDT?;:PHAS?;:SYST:ERR?\n" : "FREQ 50 kHz;:PULS:WIDT 1us;:PHAS 500ns\n");
+        while (scpi.head != scpi.tail)
+        {
+            run_us(1);
+        }
+    }
+    run_us(100);
+    uint64_t flood_ps = fake_hw_now_ps() - flood_start_ps;
+    uint flood_periods = ch1.count - first;
+    uint expected_periods = (uint)(flood_ps / (flood_shape.period * 8000u));
+    bool flood_ok = scpi.commands - commands_before == FLOOD_LINES / 2 * 7 && periods_switch(first, &flood_shape, NULL) &&
+                    flood_periods + 1 >= expected_periods && flood_periods <= expected_periods + 1;
+    command("OUTP OFF");
+    printf("banjir %u baris ke generator 50 kHz: %u periode dalam %.1f ms, semuanya utuh\n  %s\n", FLOOD_LINES,
+           flood_periods, (double)flood_ps * 1e-9, flood_ok ? "OK" : "GAGAL");
+    ok &= flood_ok;
+
+    // -- Jawaban lambat ke generator 50 kHz yang berjalan --
+    command("OUTP ON");
+    run_us(200);
+    first = ch1.count;
+    uint64_t slow_start_ps = fake_hw_now_ps();
+    output.write_us = SLOW_WRITE_US;
+    for (uint i = 0; i < SLOW_LINES; ++i)
+    {
+        clear_output();
+        send("FREQ?;:PULS:WIDT?;:PHAS?;:SYST:ERR?\n");
+        while (scpi.head != scpi.tail)
+        {
+            run_us(1);
+        }
+    }
+    run_us(100);
+    output.write_us = 0;
+    uint64_t slow_ps = fake_hw_now_ps() - slow_start_ps;
+    uint slow_periods = ch1.count - first;
+    expected_periods = (uint)(slow_ps / (flood_shape.period * 8000u));
+    bool slow_ok = periods_switch(first, &flood_shape, NULL) && slow_periods + 1 >= expected_periods &&
+                   slow_periods <= expected_periods + 1;
+    command("OUTP OFF");
+    printf("%u jawaban yang masing-masing memblok %u us: %u periode dalam %.1f ms, semuanya utuh\n  %s\n",
+           SLOW_LINES, SLOW_WRITE_US, slow_periods, (double)slow_ps * 1e-9, slow_ok ? "OK" : "GAGAL");
+    ok &= slow_ok;
+
+    sg_count_stop(&counter);
+    sg_deinit(&gen);
+    fake_hw_set_pin_listener(NULL, NULL);
+    printf("%s\n", ok ? "OK" : "GAGAL");
+    return ok ? 0 : 1;
+}
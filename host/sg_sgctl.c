@@ -0,0 +1,226 @@
+/**
+ * sg_sgctl: pemeriksaan end-to-end library dan CLI sgctl terhadap sg_simdev.
+ *
+ * sg_simdev dijalankan sebagai proses anak (pty, simulasi realtime) dan
+ * proses ini berperan sebagai host Linux:
+ *   - *IDN? dan status awal sama dengan konstanta main.c,
+ *   - konfigurasi lewat pipeline lalu status membaca nilai yang sama,
+ *   - error device (-222, -113, -211) sampai ke sgctl_next_error() berurutan,
+ *   - burst BUS: sumber, NCYC, OUTP dan *TRG tanpa error,
+ *   - CLI sgctl: status, config, stream dan exit 1 untuk parameter di luar range.
+ *
+ * Benchmark: laju set parameter ke generator yang sedang berjalan, pipeline
+ * (sgctl_submit) dibandingkan dengan menunggu setiap set (sgctl_sync per set).
+ * Semua set harus diterima tanpa error dan tanpa Input buffer overrun.
+ *
+ * Pemakaian: sg_sgctl
+ * Exit 1 jika ada perbedaan.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <math.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "sgctl.h"
+#include "signal_scpi.h"
+
+#define STREAM_SETS 2000
+#define SYNC_SETS 200
+#define CLI_SETS 100
+
+static double wall_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static bool close_to(double a, double b)
+{
+    return fabs(a - b) <= fabs(b) * 1e-6;
+}
+
+static bool config_is(const sgctl_status *status, double freq, double width, double phase)
+{
+    return close_to(status->config.frequency_hz, freq) && close_to(status->config.pulse_width_s, width) &&
+           close_to(status->config.phase_shift_s, phase);
+}
+
+/**
+ * @brief Set parameter ke-i untuk benchmark: 10..50 kHz, lebar 1..2 us.
+ */
+static sgctl_config stream_config(uint i)
+{
+    return (sgctl_config){
+        .frequency_hz = 10000.0 + (double)(i % 41) * 1000.0,
+        .pulse_width_s = (1.0 + (double)(i % 5) * 0.25) * 1e-6,
+        .phase_shift_s = 0.5e-6,
+    };
+}
+
+/**
+ * @brief Mengambil semua error device; expected diakhiri 0.
+ */
+static bool errors_are(sgctl_device *dev, const int *expected)
+{
+    for (uint i = 0;; ++i)
+    {
+        int code;
+        if (!sgctl_next_error(dev, &code, NULL, 0) || code != expected[i])
+        {
+            return false;
+        }
+        if (code == 0)
+        {
+            return true;
+        }
+    }
+}
+
+static bool no_errors(sgctl_device *dev)
+{
+    static const int none[] = {0};
+    return errors_are(dev, none);
+}
+
+static int run_cli(const char *device, const char *args)
+{
+    char command[512];
+    snprintf(command, sizeof(command), "%s -d %s %s >/dev/null 2>&1", SGCTL_CLI_PATH, device, args);
+    int status = system(command);
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+int main(void)
+{
+    char device[64];
+    snprintf(device, sizeof(device), "/tmp/sg_sgctl_%d", (int)getpid());
+    pid_t child = fork();
+    if (child == 0)
+    {
+        freopen("/dev/null", "w", stderr);
+        execl(SG_SIMDEV_PATH, SG_SIMDEV_PATH, "--link", device, (char *)NULL);
+        _exit(127);
+    }
+    for (uint i = 0; i < 500 && access(device, F_OK) != 0; ++i)
+    {
+        usleep(10000);
+    }
+
+    sgctl_device dev;
+    if (!sgctl_open(&dev, device))
+    {
+        printf("sg_simdev tidak tersedia: %s\nGAGAL\n", dev.error);
+        kill(child, SIGTERM);
+        waitpid(child, NULL, 0);
+        return 1;
+    }
+    bool ok = true;
+
+    // -- Identitas dan status awal --
+    char idn[SGCTL_RESPONSE_MAX] = "";
+    sgctl_status status;
+    bool initial_ok = sgctl_identify(&dev, idn, sizeof(idn)) && strcmp(idn, SG_SCPI_IDN) == 0 &&
+                      sgctl_reset(&dev) && sgctl_read_status(&dev, &status) &&
+                      config_is(&status, 1000.0, 5e-6, 5e-6) && status.burst_cycles == 0 &&
+                      status.trigger_source == SGCTL_TRIG_IMMEDIATE && !status.output;
+    printf("*IDN? %s, status awal 1 kHz / 5 us / 5 us, output off\n  %s\n", idn, initial_ok ? "OK" : "GAGAL");
+    ok &= initial_ok;
+
+    // -- Konfigurasi lewat pipeline --
+    const sgctl_config config = {.frequency_hz = 20000.0, .pulse_width_s = 2e-6, .phase_shift_s = 3e-6};
+    bool config_ok = sgctl_configure(&dev, &config) && sgctl_set_burst(&dev, 7) &&
+                     sgctl_set_trigger_source(&dev, SGCTL_TRIG_BUS) && sgctl_read_status(&dev, &status) &&
+                     config_is(&status, 20000.0, 2e-6, 3e-6) && status.burst_cycles == 7 &&
+                     status.trigger_source == SGCTL_TRIG_BUS && no_errors(&dev);
+    printf("konfigurasi 20 kHz / 2 us / 3 us, burst 7, trigger bus terbaca kembali\n  %s\n",
+           config_ok ? "OK" : "GAGAL");
+    ok &= config_ok;
+
+    // -- Error device --
+    static const int expected_errors[] = {SG_SCPI_ERR_OUT_OF_RANGE, SG_SCPI_ERR_UNDEFINED_HEADER,
+                                          SG_SCPI_ERR_TRIGGER_IGNORED, 0};
+    bool error_ok = sgctl_submit(&dev, "FREQ 1e12") && sgctl_submit(&dev, "BOGus:NODE 1") &&
+                    sgctl_trigger(&dev) && sgctl_sync(&dev) && errors_are(&dev, expected_errors) &&
+                    sgctl_read_status(&dev, &status) && config_is(&status, 20000.0, 2e-6, 3e-6);
+    printf("error -222, -113, -211 berurutan, konfigurasi tidak berubah\n  %s\n", error_ok ? "OK" : "GAGAL");
+    ok &= error_ok;
+
+    // -- Burst BUS --
+    bool burst_ok = sgctl_set_output(&dev, true) && sgctl_trigger(&dev) && sgctl_sync(&dev) && no_errors(&dev) &&
+                    sgctl_read_status(&dev, &status) && status.output && sgctl_set_output(&dev, false) &&
+                    sgctl_sync(&dev);
+    printf("burst bus: OUTP ON, *TRG tanpa error\n  %s\n", burst_ok ? "OK" : "GAGAL");
+    ok &= burst_ok;
+
+    // -- Benchmark: set parameter ke generator yang berjalan --
+    bool stream_ok = sgctl_reset(&dev) && sgctl_set_output(&dev, true);
+    uint64_t submitted_before = dev.submitted;
+    double start = wall_s();
+    for (uint i = 0; i < STREAM_SETS && stream_ok; ++i)
+    {
+        sgctl_config set = stream_config(i);
+        stream_ok = sgctl_configure(&dev, &set);
+    }
+    stream_ok = stream_ok && sgctl_sync(&dev);
+    double pipelined_s = wall_s() - start;
+    sgctl_config last = stream_config(STREAM_SETS - 1);
+    stream_ok = stream_ok && dev.submitted - submitted_before == STREAM_SETS && no_errors(&dev) &&
+                sgctl_read_status(&dev, &status) && status.output &&
+                config_is(&status, last.frequency_hz, last.pulse_width_s, last.phase_shift_s);
+
+    start = wall_s();
+    for (uint i = 0; i < SYNC_SETS && stream_ok; ++i)
+    {
+        sgctl_config set = stream_config(i);
+        stream_ok = sgctl_configure(&dev, &set) && sgctl_sync(&dev);
+    }
+    double synced_s = wall_s() - start;
+    stream_ok = stream_ok && no_errors(&dev) && sgctl_set_output(&dev, false) && sgctl_sync(&dev);
+    double pipelined_rate = STREAM_SETS / pipelined_s;
+    double synced_rate = SYNC_SETS / synced_s;
+    printf("set parameter ke generator berjalan: pipeline %.0f set/s (%u set), tunggu per set %.0f set/s "
+           "(%.1fx)\n  %s\n",
+           pipelined_rate, STREAM_SETS, synced_rate, pipelined_rate / synced_rate, stream_ok ? "OK" : "GAGAL");
+    ok &= stream_ok;
+    if (!stream_ok && dev.error[0])
+    {
+        printf("  %s\n", dev.error);
+    }
+    sgctl_close(&dev);
+
+    // -- CLI --
+    char stream_path[64];
+    snprintf(stream_path, sizeof(stream_path), "/tmp/sg_sgctl_%d.txt", (int)getpid());
+    FILE *file = fopen(stream_path, "w");
+    fprintf(file, "# Hz lebar fasa\n");
+    for (uint i = 0; i < CLI_SETS; ++i)
+    {
+        sgctl_config set = stream_config(i);
+        fprintf(file, "%.9g %.9g %.9g\n", set.frequency_hz, set.pulse_width_s, set.phase_shift_s);
+    }
+    fclose(file);
+    char stream_args[96];
+    snprintf(stream_args, sizeof(stream_args), "stream %s", stream_path);
+    bool cli_ok = run_cli(device, "reset") == 0 && run_cli(device, "config 25000 1.5e-6 0.5e-6") == 0 &&
+                  run_cli(device, "output on") == 0 && run_cli(device, stream_args) == 0 &&
+                  run_cli(device, "status") == 0 && run_cli(device, "config 1e12 1e-6 0") == 1 &&
+                  run_cli(device, "errors") == 0 && run_cli(device, "output off") == 0;
+    unlink(stream_path);
+    printf("CLI sgctl: reset, config, output, stream %u set, status; exit 1 untuk -222\n  %s\n", CLI_SETS,
+           cli_ok ? "OK" : "GAGAL");
+    ok &= cli_ok;
+
+    kill(child, SIGTERM);
+    waitpid(child, NULL, 0);
+    unlink(device);
+    printf("%s\n", ok ? "OK" : "GAGAL");
+    return ok ? 0 : 1;
+}
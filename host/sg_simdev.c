@@ -0,0 +1,111 @@
+/**
+ * sg_simdev: generator simulasi sebagai device tty untuk sgctl.
+ *
+ * Membuat pseudo-terminal dan menjalankan main() firmware dengan SCPI_CONTROL
+ * aktif (inisialisasi yang sama, termasuk penghitung periode) di atas
+ * hardware simulasi.
+ * Sisi slave pty berperan sebagai /dev/ttyACM0: stdout firmware ditulis ke
+ * master dan byte dari host dibaca penjadwal fake SDK (fake_hw_stdin_attach_fd).
+ * Secara bawaan simulasi ditahan agar tidak mendahului jam dinding, jadi
+ * timeout dan laju yang diukur host bermakna.
+ *
+ * Pemakaian: sg_simdev [--link <path>] [--until <ms>] [--no-realtime]
+ *
+ *   ./build_host/host/sg_simdev --link /tmp/sg0 &
+ *   ./build_host/host/sgctl -d /tmp/sg0 status
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "fake_hw.h"
+#include "pico/stdlib.h"
+
+// Entry firmware dari main.c (main di-rename menjadi firmware_main, SCPI_CONTROL
+// diaktifkan lewat SIGNAL_GENERATOR_SCPI_CONTROL)
+int firmware_main(void);
+
+int main(int argc, char **argv)
+{
+    const char *link = NULL;
+    uint64_t until_ms = 0;
+    bool realtime = true;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--link") == 0 && i + 1 < argc)
+        {
+            link = argv[++i];
+        }
+        else if (strcmp(argv[i], "--until") == 0 && i + 1 < argc)
+        {
+            until_ms = strtoull(argv[++i], NULL, 0);
+        }
+        else if (strcmp(argv[i], "--no-realtime") == 0)
+        {
+            realtime = false;
+        }
+        else
+        {
+            fprintf(stderr, "pemakaian: %s [--link <path>] [--until <ms>] [--no-realtime]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0)
+    {
+        perror("sg_simdev: posix_openpt");
+        return 1;
+    }
+    const char *slave_name = ptsname(master);
+
+    // Slave tetap dibuka agar master tidak EIO saat host menutup device, dan
+    // dibuat raw agar byte dari host tidak di-echo sebelum host membukanya
+    int slave = open(slave_name, O_RDWR | O_NOCTTY);
+    struct termios tio;
+    if (slave < 0 || tcgetattr(slave, &tio) != 0)
+    {
+        perror("sg_simdev: slave pty");
+        return 1;
+    }
+    cfmakeraw(&tio);
+    tcsetattr(slave, TCSANOW, &tio);
+
+    if (link)
+    {
+        unlink(link);
+        if (symlink(slave_name, link) != 0)
+        {
+            perror("sg_simdev: symlink");
+            return 1;
+        }
+    }
+    fprintf(stderr, "sg_simdev: device %s%s%s\n", slave_name, link ? " -> " : "", link ? link : "");
+
+    // stdout firmware (printf/fwrite) menjadi keluaran USB CDC
+    fflush(stdout);
+    if (dup2(master, STDOUT_FILENO) < 0)
+    {
+        perror("sg_simdev: dup2");
+        return 1;
+    }
+
+    fake_hw_reset();
+    fake_hw_stdin_attach_fd(master, realtime);
+    fake_hw_run_firmware(firmware_main, until_ms ? until_ms * 1000 : UINT64_MAX / 1000000u);
+
+    if (link)
+    {
+        unlink(link);
+    }
+    close(slave);
+    close(master);
+    return 0;
+}
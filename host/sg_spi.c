@@ -0,0 +1,480 @@
+/**
+ * sg_spi: pemeriksaan dan benchmark latensi update kontrol SPI target
+ * (signal_spi) terhadap master SPI simulasi 10 MHz.
+ *
+ * Diperiksa:
+ *   - generator berjalan dengan set awal dari konfigurasinya,
+ *   - setiap periode utuh lama atau utuh baru, tidak ada periode campuran,
+ *   - frame dengan checksum salah ditolak tanpa mengubah output, dan frame
+ *     terpotong hanya menghilangkan frame berikutnya,
+ *   - frame yang diterima saat berhenti menentukan periode pertama start,
+ *   - penghitung periode (DMA_IRQ_0 bersama) tetap sesuai pin.
+ *
+ * Benchmark: frame dikirim pada fase acak terhadap periode output, diukur
+ * dari awal frame dan dari CS naik sampai edge naik pertama dengan
+ * parameter baru, di 10 kHz dan 50 kHz. Batas yang diperiksa: CS naik ->
+ * edge baru paling lama dua periode. Sebagai pembanding, update yang sama
+ * lewat I2C 400 kHz (signal_i2c, tulis 4 register + COMMIT) diukur dengan
+ * cara yang sama.
+ *
+ * Pemakaian: sg_spi
+ * Exit 1 jika ada perbedaan.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "fake_hw.h"
+#include "hardware/clocks.h"
+#include "signal_count.h"
+#include "signal_i2c.h"
+#include "signal_spi.h"
+
+#define PIN_CH1_BASE 6
+#define SPI_PIN_BASE 10 // MOSI 10, SCK 11, CS 12
+#define SCK_HZ 10000000u
+#define I2C_ADDRESS 0x42
+#define I2C_TRIGGER_PIN 2
+#define BENCH_FRAMES 200
+#define I2C_SAMPLES 20
+#define MAX_PERIODS 16384
+
+// -- Edge CH1: periode (naik ke naik) dan lebar pulsa --
+static struct
+{
+    bool level;
+    uint64_t rise_ps[MAX_PERIODS];
+    uint64_t width_ps[MAX_PERIODS];
+    uint count;
+} ch1;
+
+static void on_pins(void *ctx, uint64_t time_ps, uint32_t levels, uint32_t changed)
+{
+    (void)ctx;
+    if (!(changed & (1u << PIN_CH1_BASE)))
+    {
+        return;
+    }
+    bool level = (levels >> PIN_CH1_BASE) & 1u;
+    if (level && !ch1.level && ch1.count < MAX_PERIODS)
+    {
+        ch1.rise_ps[ch1.count++] = time_ps;
+    }
+    else if (!level && ch1.level && ch1.count > 0)
+    {
+        ch1.width_ps[ch1.count - 1] = time_ps - ch1.rise_ps[ch1.count - 1];
+    }
+    ch1.level = level;
+}
+
+/**
+ * @brief Bentuk satu periode CH1 dalam siklus clk_sys.
+ */
+typedef struct
+{
+    float frequency_hz;
+    float pulse_width_us;
+    float phase_shift_us;
+    uint64_t period;
+    uint64_t width;
+} shape;
+
+static sg_timing_config shape_timing(const shape *s)
+{
+    const sg_timing_config timing = {
+        .frequency_hz = s->frequency_hz,
+        .pulse_width_us = s->pulse_width_us,
+        .phase_shift_us = s->phase_shift_us,
+        .pio_clk_div = 1.0f,
+    };
+    return timing;
+}
+
+static shape make_shape(float freq_hz, float width_us, float phase_us)
+{
+    shape s = {.frequency_hz = freq_hz, .pulse_width_us = width_us, .phase_shift_us = phase_us};
+    const sg_timing_config timing = shape_timing(&s);
+    uint32_t delays[SG_NUM_EVENTS];
+    sg_calculate_delays((float)clock_get_hz(clk_sys), &timing, delays);
+    s.width = delays[0] + SG_EVENT_OVERHEAD_CYCLES;
+    for (uint i = 0; i < SG_NUM_EVENTS; ++i)
+    {
+        s.period += delays[i] + SG_EVENT_OVERHEAD_CYCLES;
+    }
+    s.period += SG_EVENT_D_OVERHEAD_CYCLES - SG_EVENT_OVERHEAD_CYCLES;
+    return s;
+}
+
+static uint64_t ps_to_cycles(uint64_t ps)
+{
+    return ps * (clock_get_hz(clk_sys) / 1000000u) / 1000000u;
+}
+
+static uint64_t cycles_to_ps(uint64_t cycles)
+{
+    return cycles * 1000000u / (clock_get_hz(clk_sys) / 1000000u);
+}
+
+static bool period_is(uint i, const shape *s)
+{
+    return ps_to_cycles(ch1.rise_ps[i + 1] - ch1.rise_ps[i]) == s->period && ps_to_cycles(ch1.width_ps[i]) == s->width;
+}
+
+/**
+ * @brief Memeriksa bahwa setiap periode utuh di [first, count) salah satu
+ *        bentuk yang diberikan.
+ */
+static bool periods_match(uint first, const shape *a, const shape *b)
+{
+    for (uint i = first; i + 1 < ch1.count; ++i)
+    {
+        if (!period_is(i, a) && !(b && period_is(i, b)))
+        {
+            printf("  periode %u: %llu siklus, lebar %llu siklus tidak cocok\n", i,
+                   (unsigned long long)ps_to_cycles(ch1.rise_ps[i + 1] - ch1.rise_ps[i]),
+                   (unsigned long long)ps_to_cycles(ch1.width_ps[i]));
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Indeks periode utuh pertama berbentuk s yang dimulai setelah after_ps.
+ */
+static int first_period(uint64_t after_ps, const shape *s)
+{
+    for (uint i = 0; i + 1 < ch1.count; ++i)
+    {
+        if (ch1.rise_ps[i] >= after_ps && period_is(i, s))
+        {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+static sg_instance gen;
+static sg_count_instance counter;
+static sg_spi_instance target;
+static uint16_t sequence;
+
+/**
+ * @brief Mengirim satu frame dan menunggu sampai CS naik.
+ *
+ * @return Waktu CS naik (ps)
+ */
+static uint64_t send_frame(const uint8_t *frame, size_t len)
+{
+    fake_hw_spi_master_write(frame, len);
+    uint64_t cs_rise_ps = fake_hw_now_ps() + fake_hw_spi_master_frame_ps(len);
+    fake_hw_advance_cycles(ps_to_cycles(fake_hw_spi_master_frame_ps(len)) + 1);
+    return cs_rise_ps;
+}
+
+static uint64_t send_timing(const shape *s)
+{
+    uint8_t frame[SG_SPI_FRAME_BYTES];
+    const sg_timing_config timing = shape_timing(s);
+    sg_spi_encode_frame(&gen, &timing, ++sequence, frame);
+    return send_frame(frame, sizeof(frame));
+}
+
+static uint32_t lcg_state = 12345u;
+
+static uint32_t lcg_next(void)
+{
+    lcg_state = lcg_state * 1664525u + 1013904223u;
+    return lcg_state >> 8;
+}
+
+typedef struct
+{
+    double min_us;
+    double max_us;
+    double sum_us;
+    uint samples;
+} latency_stats;
+
+static void stats_add(latency_stats *s, double us)
+{
+    if (s->samples == 0 || us < s->min_us)
+    {
+        s->min_us = us;
+    }
+    if (s->samples == 0 || us > s->max_us)
+    {
+        s->max_us = us;
+    }
+    s->sum_us += us;
+    s->samples++;
+}
+
+static void setup_generator(const shape *s)
+{
+    const sg_timing_config timing = shape_timing(s);
+    if (!sg_configure(&gen, &timing))
+    {
+        printf("konfigurasi generator ditolak\n");
+    }
+}
+
+/**
+ * @brief Benchmark latensi pada satu frekuensi: frame pada fase acak,
+ *        bergantian antara dua bentuk dengan periode sama.
+ */
+static bool bench_spi(const shape *a, const shape *b)
+{
+    setup_generator(a);
+    if (!sg_spi_init(&target, pio1, SPI_PIN_BASE, &gen) || !sg_spi_start(&target))
+    {
+        printf("sg_spi_init/start gagal\nGAGAL\n");
+        return false;
+    }
+    fake_hw_advance_cycles(4 * a->period);
+
+    uint first = ch1.count;
+    latency_stats from_cs = {0};
+    latency_stats from_start = {0};
+    bool ok = true;
+    for (uint i = 0; i < BENCH_FRAMES && ok; ++i)
+    {
+        const shape *next = (i & 1u) ? a : b;
+        fake_hw_advance_cycles(lcg_next() % a->period);
+        uint64_t start_ps = fake_hw_now_ps();
+        uint64_t cs_ps = send_timing(next);
+        fake_hw_advance_cycles(3 * a->period);
+        int k = first_period(cs_ps, next);
+        if (k < 0)
+        {
+            printf("  frame %u tidak pernah terlihat di output\n", i);
+            ok = false;
+            break;
+        }
+        stats_add(&from_cs, (double)(ch1.rise_ps[k] - cs_ps) * 1e-6);
+        stats_add(&from_start, (double)(ch1.rise_ps[k] - start_ps) * 1e-6);
+    }
+    ok &= periods_match(first, a, b);
+
+    double period_us = (double)cycles_to_ps(a->period) * 1e-6;
+    double frame_us = (double)fake_hw_spi_master_frame_ps(SG_SPI_FRAME_BYTES) * 1e-6;
+    bool bound_ok = ok && from_cs.max_us <= 2.0 * period_us && target.frames == BENCH_FRAMES &&
+                    target.rejected == 0;
+    printf("SPI %.0f kHz (periode %.1f us, frame %.1f us): %u frame\n", a->frequency_hz * 1e-3, period_us, frame_us,
+           from_cs.samples);
+    printf("  CS naik -> edge baru  min %7.1f  rata %7.1f  maks %7.1f us  (maks %.2f periode)\n", from_cs.min_us,
+           from_cs.sum_us / from_cs.samples, from_cs.max_us, from_cs.max_us / period_us);
+    printf("  awal frame -> edge    min %7.1f  rata %7.1f  maks %7.1f us\n  %s\n", from_start.min_us,
+           from_start.sum_us / from_start.samples, from_start.max_us, bound_ok ? "OK" : "GAGAL");
+
+    sg_spi_deinit(&target);
+    return bound_ok;
+}
+
+// -- Pembanding I2C --
+
+static sg_i2c_instance i2c_target;
+
+static void i2c_loop(uint64_t cycles)
+{
+    for (uint64_t t = 0; t < cycles; t += 500)
+    {
+        fake_hw_advance_cycles(500);
+        sg_i2c_poll(&i2c_target);
+    }
+}
+
+static bool i2c_transfer(const uint8_t *data, size_t len)
+{
+    fake_hw_i2c_master_start(0, I2C_ADDRESS, data, len, NULL, 0);
+    while (fake_hw_i2c_master_busy())
+    {
+        i2c_loop(500);
+    }
+    return fake_hw_i2c_master_acked();
+}
+
+static void put_le32(uint8_t *p, uint32_t value)
+{
+    for (uint i = 0; i < 4; ++i)
+    {
+        p[i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+static bool bench_i2c(const shape *a, const shape *b)
+{
+    setup_generator(a);
+    if (!sg_i2c_init(&i2c_target, i2c0, I2C_ADDRESS, 4, 5, &gen, NULL, I2C_TRIGGER_PIN, true))
+    {
+        printf("sg_i2c_init gagal\nGAGAL\n");
+        return false;
+    }
+    uint8_t start[2] = {SG_I2C_REG_CONTROL, SG_I2C_CTRL_START};
+    i2c_transfer(start, sizeof(start));
+    i2c_loop(4 * a->period);
+
+    uint first = ch1.count;
+    latency_stats from_start = {0};
+    bool ok = true;
+    for (uint i = 0; i < I2C_SAMPLES && ok; ++i)
+    {
+        const shape *next = (i & 1u) ? a : b;
+        uint8_t data[2 + 16] = {SG_I2C_REG_CONTROL, SG_I2C_CTRL_COMMIT};
+        put_le32(&data[2], (uint32_t)(next->frequency_hz * 1e3f + 0.5f));
+        put_le32(&data[6], (uint32_t)(next->pulse_width_us * 1e3f + 0.5f));
+        put_le32(&data[10], (uint32_t)(next->phase_shift_us * 1e3f + 0.5f));
+        put_le32(&data[14], 0);
+        i2c_loop(lcg_next() % a->period);
+        uint64_t start_ps = fake_hw_now_ps();
+        ok &= i2c_transfer(data, sizeof(data));
+        i2c_loop(3 * a->period);
+        int k = first_period(start_ps, next);
+        if (k < 0)
+        {
+            printf("  commit %u tidak pernah terlihat di output\n", i);
+            ok = false;
+            break;
+        }
+        stats_add(&from_start, (double)(ch1.rise_ps[k] - start_ps) * 1e-6);
+    }
+    ok &= periods_match(first, a, b);
+    printf("I2C 400 kHz %.0f kHz: %u commit\n", a->frequency_hz * 1e-3, from_start.samples);
+    printf("  awal transaksi -> edge min %7.1f  rata %7.1f  maks %7.1f us\n  %s\n", from_start.min_us,
+           from_start.sum_us / from_start.samples, from_start.max_us, ok ? "OK" : "GAGAL");
+
+    sg_i2c_deinit(&i2c_target);
+    sg_stop(&gen);
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 1)
+    {
+        fprintf(stderr, "pemakaian: %s\n", argv[0]);
+        return 2;
+    }
+
+    fake_hw_reset();
+    fake_hw_log_set_enabled(false);
+    memset(&ch1, 0, sizeof(ch1));
+    fake_hw_set_pin_listener(on_pins, NULL);
+    fake_hw_spi_master_init(SPI_PIN_BASE + 1, SPI_PIN_BASE, SPI_PIN_BASE + 2, SCK_HZ);
+    fake_hw_gpio_set_input(I2C_TRIGGER_PIN, false);
+
+    const shape slow_a = make_shape(10000.0f, 2.0f, 1.0f);
+    const shape slow_b = make_shape(10000.0f, 3.0f, 1.0f);
+    const shape other = make_shape(12500.0f, 5.0f, 3.0f);
+    const shape fast_a = make_shape(50000.0f, 1.0f, 0.5f);
+    const shape fast_b = make_shape(50000.0f, 2.0f, 0.5f);
+
+    const sg_timing_config timing = shape_timing(&slow_a);
+    sg_count_init(&counter);
+    if (!sg_init(&gen, pio0, PIN_CH1_BASE) || !sg_configure(&gen, &timing) ||
+        !sg_count_start(&counter, &gen, 64, NULL, NULL) || !sg_spi_init(&target, pio1, SPI_PIN_BASE, &gen))
+    {
+        printf("konfigurasi ditolak\nGAGAL\n");
+        return 1;
+    }
+    bool ok = true;
+
+    // -- Start dengan set awal --
+    sg_spi_start(&target);
+    fake_hw_advance_us(1000);
+    bool start_ok = ch1.count >= 9 && periods_match(0, &slow_a, NULL);
+    printf("start: %u periode %llu siklus dari set awal\n  %s\n", ch1.count, (unsigned long long)slow_a.period,
+           start_ok ? "OK" : "GAGAL");
+    ok &= start_ok;
+
+    // -- Satu update: periode lain, tidak ada periode campuran --
+    uint first = ch1.count;
+    uint64_t cs_ps = send_timing(&other);
+    fake_hw_advance_us(1000);
+    int k = first_period(cs_ps, &other);
+    double latency_us = k < 0 ? -1.0 : (double)(ch1.rise_ps[k] - cs_ps) * 1e-6;
+    double old_period_us = (double)cycles_to_ps(slow_a.period) * 1e-6;
+    bool update_ok = k >= 0 && periods_match(first, &slow_a, &other) && latency_us <= 2.0 * old_period_us &&
+                     target.frames == 1 && target.last_sequence == sequence;
+    printf("update %llu -> %llu siklus: edge baru %.1f us setelah CS naik, frame %lu, urutan %u\n  %s\n",
+           (unsigned long long)slow_a.period, (unsigned long long)other.period, latency_us,
+           (unsigned long)target.frames, target.last_sequence, update_ok ? "OK" : "GAGAL");
+    ok &= update_ok;
+
+    // -- Checksum salah ditolak --
+    first = ch1.count;
+    uint8_t bad[SG_SPI_FRAME_BYTES];
+    const sg_timing_config slow_timing = shape_timing(&slow_a);
+    sg_spi_encode_frame(&gen, &slow_timing, ++sequence, bad);
+    bad[SG_SPI_FRAME_BYTES - 1] ^= 0x01;
+    send_frame(bad, sizeof(bad));
+    fake_hw_advance_us(500);
+    cs_ps = send_timing(&slow_a);
+    fake_hw_advance_us(500);
+    bool reject_ok = target.rejected == 1 && target.frames == 2 && first_period(cs_ps, &slow_a) >= 0 &&
+                     periods_match(first, &other, &slow_a);
+    for (uint i = first; i + 1 < ch1.count && ch1.rise_ps[i] < cs_ps; ++i)
+    {
+        reject_ok &= period_is(i, &other);
+    }
+    printf("checksum salah: ditolak %lu, frame valid berikutnya diterima (%lu)\n  %s\n",
+           (unsigned long)target.rejected, (unsigned long)target.frames, reject_ok ? "OK" : "GAGAL");
+    ok &= reject_ok;
+
+    // -- Frame terpotong: frame berikutnya hilang, yang sesudahnya diterima --
+    first = ch1.count;
+    uint8_t partial[SG_SPI_FRAME_BYTES];
+    const sg_timing_config other_timing = shape_timing(&other);
+    sg_spi_encode_frame(&gen, &other_timing, ++sequence, partial);
+    send_frame(partial, 10);
+    fake_hw_advance_us(300);
+    send_timing(&other);
+    fake_hw_advance_us(300);
+    uint64_t lost_end_ps = fake_hw_now_ps();
+    cs_ps = send_timing(&other);
+    fake_hw_advance_us(500);
+    bool truncated_ok = target.rejected == 2 && target.frames == 3 && first_period(cs_ps, &other) >= 0;
+    for (uint i = first; i + 1 < ch1.count && ch1.rise_ps[i + 1] <= lost_end_ps; ++i)
+    {
+        truncated_ok &= period_is(i, &slow_a);
+    }
+    printf("frame terpotong: ditolak %lu, diterima %lu, output tetap sampai frame utuh berikutnya\n  %s\n",
+           (unsigned long)target.rejected, (unsigned long)target.frames, truncated_ok ? "OK" : "GAGAL");
+    ok &= truncated_ok;
+
+    // -- Penghitung periode tetap berjalan --
+    uint64_t periods = sg_count_periods(&counter);
+    bool count_ok = periods + 1 >= ch1.count && periods <= ch1.count;
+    printf("penghitung: %llu periode, terlihat di pin %u\n  %s\n", (unsigned long long)periods, ch1.count,
+           count_ok ? "OK" : "GAGAL");
+    ok &= count_ok;
+
+    // -- Frame saat berhenti menentukan periode pertama --
+    sg_spi_stop(&target);
+    fake_hw_advance_us(100);
+    uint stopped = ch1.count;
+    send_timing(&slow_b);
+    fake_hw_advance_us(500);
+    bool silent = ch1.count == stopped && !((fake_hw_gpio_levels() >> PIN_CH1_BASE) & 1u);
+    first = ch1.count;
+    sg_spi_start(&target);
+    fake_hw_advance_us(1000);
+    bool restart_ok = silent && ch1.count > first + 5 && periods_match(first, &slow_b, NULL);
+    printf("stop/start: diam saat berhenti, %u periode dari frame terakhir\n  %s\n", ch1.count - first,
+           restart_ok ? "OK" : "GAGAL");
+    ok &= restart_ok;
+    sg_spi_deinit(&target);
+    sg_count_stop(&counter);
+
+    // -- Benchmark latensi --
+    ok &= bench_spi(&slow_a, &slow_b);
+    ok &= bench_spi(&fast_a, &fast_b);
+    ok &= bench_i2c(&slow_a, &slow_b);
+
+    sg_deinit(&gen);
+    fake_hw_set_pin_listener(NULL, NULL);
+    printf("%s\n", ok ? "OK" : "GAGAL");
+    return ok ? 0 : 1;
+}
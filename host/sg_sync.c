@@ -0,0 +1,202 @@
+/**
+ * sg_sync: pemeriksaan sinkronisasi master/slave (signal_sync) di simulasi.
+ *
+ * Dua "board" disimulasikan dalam satu chip: master di pio0 mengeluarkan
+ * sync di SYNC_PIN, slave di pio1 membaca pin yang sama. Edge naik CH1 kedua
+ * generator direkam lalu diperiksa:
+ *   - slave tidak mengeluarkan apa pun sebelum master mulai,
+ *   - setiap periode, edge CH1 slave jatuh di (-1, 0] siklus PIO slave dari
+ *     edge CH1 master (tanpa sinkronisasi input GPIO di simulasi),
+ *   - pada mode re-align, slave yang clock-nya menyimpang SG_SYNC_DRIFT_PPM
+ *     tetap terkunci, dan berhenti bersama master dengan periode utuh,
+ *   - burst master berikutnya diikuti slave tanpa CPU slave,
+ *   - clock referensi keluar di pin GPOUT.
+ *
+ * Pemakaian: sg_sync
+ * Exit 1 jika ada perbedaan.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "fake_hw.h"
+#include "hardware/clocks.h"
+#include "hardware/gpio.h"
+#include "signal_sync.h"
+
+#define MASTER_PIN_BASE 6
+#define SLAVE_PIN_BASE 16
+#define SYNC_PIN 15
+#define REF_CLOCK_GPIO 21
+#define MAX_RISES 512
+
+// -- Edge Naik CH1 Master dan Slave --
+typedef struct
+{
+    uint64_t time_ps[MAX_RISES];
+    uint count;
+    bool level;
+} rise_log;
+
+static rise_log master_ch1, slave_ch1;
+static uint32_t last_levels;
+
+static void log_rise(rise_log *log, uint pin, uint64_t time_ps, uint32_t levels)
+{
+    bool level = (levels >> pin) & 1u;
+    if (level && !log->level && log->count < MAX_RISES)
+    {
+        log->time_ps[log->count++] = time_ps;
+    }
+    log->level = level;
+}
+
+static void on_pins(void *ctx, uint64_t time_ps, uint32_t levels, uint32_t changed)
+{
+    (void)ctx;
+    if (changed & (1u << MASTER_PIN_BASE))
+    {
+        log_rise(&master_ch1, MASTER_PIN_BASE, time_ps, levels);
+    }
+    if (changed & (1u << SLAVE_PIN_BASE))
+    {
+        log_rise(&slave_ch1, SLAVE_PIN_BASE, time_ps, levels);
+    }
+    last_levels = levels;
+}
+
+// -- Kasus Uji --
+
+typedef struct
+{
+    const char *name;
+    sg_sync_role slave_role;
+    float pio_clk_div;
+    float frequency_hz;
+    double slave_ppm; // Selisih clock slave (frekuensi slave lebih rendah)
+    uint bursts;      // Jumlah burst master berturut-turut
+} sync_case;
+
+static bool run_case(const sync_case *c)
+{
+    fake_hw_reset();
+    fake_hw_log_set_enabled(false);
+    memset(&master_ch1, 0, sizeof(master_ch1));
+    memset(&slave_ch1, 0, sizeof(slave_ch1));
+    last_levels = 0;
+    fake_hw_set_pin_listener(on_pins, NULL);
+
+    const sg_timing_config timing = {
+        .frequency_hz = c->frequency_hz,
+        .pulse_width_us = 2.0f,
+        .phase_shift_us = 1.0f,
+        .pio_clk_div = c->pio_clk_div,
+    };
+    // Clock slave yang lebih lambat setara dengan periode slave yang lebih panjang
+    sg_timing_config slave_timing = timing;
+    slave_timing.frequency_hz = (float)(c->frequency_hz * (1.0 - c->slave_ppm * 1e-6));
+
+    sg_sync_instance master, slave;
+    if (!sg_sync_init(&master, pio0, MASTER_PIN_BASE, SYNC_PIN, SG_SYNC_MASTER) ||
+        !sg_sync_init(&slave, pio1, SLAVE_PIN_BASE, SYNC_PIN, c->slave_role) ||
+        !sg_sync_configure(&master, &timing) || !sg_sync_configure(&slave, &slave_timing))
+    {
+        printf("%s: konfigurasi ditolak\n", c->name);
+        return false;
+    }
+
+    // Slave menunggu lebih dulu; master mulai pada waktu sembarang
+    sg_sync_start(&slave);
+    fake_hw_advance_us(37);
+    bool early = slave_ch1.count > 0;
+
+    double period_us = 1e6 / c->frequency_hz;
+    uint64_t burst_us = (uint64_t)(20.5 * period_us);
+    bool stop_ok = true;
+    for (uint b = 0; b < c->bursts; ++b)
+    {
+        sg_sync_start(&master);
+        fake_hw_advance_us(burst_us);
+        sg_sync_stop(&master);
+        uint master_rises = master_ch1.count;
+
+        // Slave re-align berhenti sendiri bersama master dengan output LOW
+        fake_hw_advance_us((uint64_t)(3 * period_us));
+        if (c->slave_role == SG_SYNC_SLAVE_ALIGN)
+        {
+            uint32_t slave_mask = 0xfu << SLAVE_PIN_BASE;
+            stop_ok &= slave_ch1.count == master_rises && !(last_levels & slave_mask);
+        }
+        stop_ok &= !((last_levels >> SYNC_PIN) & 1u) && master_ch1.count == master_rises;
+        fake_hw_advance_us(53);
+    }
+    sg_sync_stop(&slave);
+    sg_sync_deinit(&slave);
+    sg_sync_deinit(&master);
+    fake_hw_set_pin_listener(NULL, NULL);
+
+    // Skew per periode dalam siklus clk_sys
+    double cycle_ps = 1e12 / (double)clock_get_hz(clk_sys);
+    uint n = master_ch1.count < slave_ch1.count ? master_ch1.count : slave_ch1.count;
+    double min_skew = 1e30, max_skew = -1e30;
+    for (uint i = 0; i < n; ++i)
+    {
+        double skew = ((double)slave_ch1.time_ps[i] - (double)master_ch1.time_ps[i]) / cycle_ps;
+        min_skew = fmin(min_skew, skew);
+        max_skew = fmax(max_skew, skew);
+    }
+    bool count_ok = n == 20u * c->bursts + c->bursts && (c->slave_role != SG_SYNC_SLAVE_ALIGN ||
+                                                        master_ch1.count == slave_ch1.count);
+    bool skew_ok = n > 0 && min_skew > -c->pio_clk_div && max_skew <= 0.0;
+
+    bool ok = !early && count_ok && skew_ok && stop_ok;
+    printf("%s: %s, div %.1f, %.0f Hz, slave %.0f ppm, %u burst\n", c->name,
+           c->slave_role == SG_SYNC_SLAVE_ALIGN ? "re-align" : "start-only", c->pio_clk_div, c->frequency_hz,
+           c->slave_ppm, c->bursts);
+    printf("  %u/%u edge CH1 master/slave, skew %.1f..%.1f siklus clk_sys%s%s\n", master_ch1.count,
+           slave_ch1.count, min_skew, max_skew, early ? ", slave keluar sebelum master" : "",
+           stop_ok ? "" : ", akhir burst salah");
+    printf("  %s\n", ok ? "OK" : "GAGAL");
+    return ok;
+}
+
+static bool run_ref_clock(void)
+{
+    fake_hw_reset();
+    fake_hw_log_set_enabled(false);
+    bool ok = sg_sync_ref_clock_out(REF_CLOCK_GPIO, 4.0f) &&
+              gpio_get_function(REF_CLOCK_GPIO) == GPIO_FUNC_GPCK && !sg_sync_ref_clock_out(20, 1.0f) &&
+              !sg_sync_ref_clock_out(REF_CLOCK_GPIO, 0.5f);
+    printf("clock referensi di GPOUT: %s\n", ok ? "OK" : "GAGAL");
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 1)
+    {
+        fprintf(stderr, "pemakaian: %s\n", argv[0]);
+        return 2;
+    }
+
+    const sync_case cases[] = {
+        {"start_div1", SG_SYNC_SLAVE_START, 1.0f, 10000.0f, 0.0, 1},
+        {"align_div1", SG_SYNC_SLAVE_ALIGN, 1.0f, 10000.0f, 0.0, 2},
+        {"align_drift_div1", SG_SYNC_SLAVE_ALIGN, 1.0f, 10000.0f, 150.0, 2},
+        {"align_fast_slave", SG_SYNC_SLAVE_ALIGN, 1.0f, 10000.0f, -150.0, 1},
+        {"align_div12p5", SG_SYNC_SLAVE_ALIGN, 12.5f, 1000.0f, 150.0, 2},
+    };
+
+    bool ok = true;
+    for (uint i = 0; i < count_of(cases); ++i)
+    {
+        ok &= run_case(&cases[i]);
+    }
+    ok &= run_ref_clock();
+
+    printf("%s\n", ok ? "OK" : "GAGAL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,223 @@
+/**
+ * sg_trigger: pemeriksaan jeda trigger -> output (sg_arm) di simulasi.
+ *
+ * Generator di-arm pada pin trigger, lalu edge trigger dijadwalkan pada waktu
+ * yang tidak sejajar dengan clock PIO. Jarak dari edge trigger sampai edge
+ * naik CH1 pertama harus sama dengan jeda yang diminta dalam siklus PIO
+ * (ditambah kuantisasi < 1 siklus karena trigger asinkron), untuk trigger
+ * eksternal aktif-high maupun tombol aktif-low dengan pull-up, dari jeda 0
+ * sampai beberapa detik. Selama menunggu trigger CPU tidak menyentuh
+ * generator sama sekali (interrupt dimatikan); periode pertama sudah dimuat
+ * sg_arm() sehingga tetap keluar tepat satu kali. Kasus yang memakai
+ * sg_run_armed_burst() juga memeriksa periode berikutnya.
+ *
+ * Pemakaian: sg_trigger
+ * Exit 1 jika ada perbedaan.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "fake_hw.h"
+#include "hardware/clocks.h"
+#include "hardware/gpio.h"
+#include "hardware/sync.h"
+#include "signal_gen.h"
+
+#define PIN_BASE 6
+#define EXTERNAL_TRIGGER_PIN 2
+#define BUTTON_PIN 13
+#define MAX_RISES 8
+
+// -- Edge Naik CH1 --
+static struct
+{
+    uint64_t time_ps[MAX_RISES];
+    uint count;
+    bool level;
+} ch1;
+
+static void on_pins(void *ctx, uint64_t time_ps, uint32_t levels, uint32_t changed)
+{
+    (void)ctx;
+    if (!(changed & (1u << PIN_BASE)))
+    {
+        return;
+    }
+    bool level = (levels >> PIN_BASE) & 1u;
+    if (level && !ch1.level && ch1.count < MAX_RISES)
+    {
+        ch1.time_ps[ch1.count++] = time_ps;
+    }
+    ch1.level = level;
+}
+
+// -- Kasus Uji --
+
+typedef struct
+{
+    const char *name;
+    uint trigger_pin;
+    bool active_high;     // false = tombol ke ground dengan pull-up
+    float pio_clk_div;
+    uint64_t delay_ns;
+    uint64_t trigger_us;  // Waktu edge trigger setelah arm
+    bool cpu_feed;        // true = sg_run_armed_burst(), false = CPU diam
+} trigger_case;
+
+static bool run_case(const trigger_case *c)
+{
+    fake_hw_reset();
+    fake_hw_log_set_enabled(false);
+    memset(&ch1, 0, sizeof(ch1));
+    fake_hw_set_pin_listener(on_pins, NULL);
+
+    gpio_init(c->trigger_pin);
+    gpio_set_dir(c->trigger_pin, GPIO_IN);
+    if (c->active_high)
+    {
+        fake_hw_gpio_set_input(c->trigger_pin, false);
+    }
+    else
+    {
+        gpio_pull_up(c->trigger_pin);
+    }
+
+    sg_instance gen;
+    const sg_timing_config timing = {
+        .frequency_hz = 10000.0f,
+        .pulse_width_us = 2.0f,
+        .phase_shift_us = 1.0f,
+        .pio_clk_div = c->pio_clk_div,
+        .trigger_delay_ns = c->delay_ns,
+    };
+    if (!sg_init(&gen, pio0, PIN_BASE) || !sg_configure(&gen, &timing))
+    {
+        printf("%s: konfigurasi ditolak\n", c->name);
+        return false;
+    }
+
+    // Trigger yang sedang aktif harus ditolak
+    fake_hw_gpio_set_input(c->trigger_pin, c->active_high);
+    bool rejected = !sg_arm(&gen, c->trigger_pin, c->active_high);
+    if (c->active_high)
+    {
+        fake_hw_gpio_set_input(c->trigger_pin, false);
+    }
+    else
+    {
+        fake_hw_gpio_release_input(c->trigger_pin);
+    }
+
+    if (!sg_arm(&gen, c->trigger_pin, c->active_high))
+    {
+        printf("%s: sg_arm gagal\n", c->name);
+        return false;
+    }
+    uint64_t arm_us = fake_hw_now_ps() / 1000000ull + 1;
+    uint64_t trigger_us = arm_us + c->trigger_us;
+    fake_hw_gpio_schedule(c->trigger_pin, c->active_high, trigger_us);
+
+    double pio_clk_hz = (double)clock_get_hz(clk_sys) / c->pio_clk_div;
+    double delay_cycles = floor((double)c->delay_ns * pio_clk_hz / 1e9 + 0.5);
+    if (delay_cycles < SG_TRIGGER_LATENCY_CYCLES)
+    {
+        delay_cycles = SG_TRIGGER_LATENCY_CYCLES;
+    }
+    double period_s = 1.0 / timing.frequency_hz;
+    uint64_t settle_us = (uint64_t)(delay_cycles / pio_clk_hz * 1e6) + (uint64_t)(2.5 * period_s * 1e6) + 10;
+
+    bool early = false;
+    if (c->cpu_feed)
+    {
+        sg_run_armed_burst(&gen, settle_us);
+    }
+    else
+    {
+        // CPU sibuk dengan interrupt mati; output sepenuhnya ditentukan PIO
+        uint32_t status = save_and_disable_interrupts();
+        fake_hw_advance_us(c->trigger_us);
+        early = ch1.count > 0;
+        fake_hw_advance_us(settle_us);
+        restore_interrupts(status);
+        sg_stop(&gen);
+    }
+    fake_hw_set_pin_listener(NULL, NULL);
+    sg_deinit(&gen);
+
+    // Jeda trigger -> edge pertama dalam siklus PIO; trigger asinkron
+    // terhadap clock PIO sehingga hasilnya di [jeda, jeda + 1)
+    double measured = -1.0;
+    if (ch1.count > 0)
+    {
+        measured = (double)(ch1.time_ps[0] - trigger_us * 1000000ull) * 1e-12 * pio_clk_hz;
+    }
+    bool delay_ok = measured >= delay_cycles - 1e-6 && measured < delay_cycles + 1.0;
+
+    // Tanpa CPU hanya satu periode yang sudah dimuat sg_arm() yang keluar;
+    // dengan feed CPU periode berikutnya harus mengikuti konfigurasi biasa
+    bool period_ok = false;
+    double period_cycles = 0.0;
+    if (!c->cpu_feed)
+    {
+        period_ok = ch1.count == 1;
+    }
+    else if (ch1.count > 1)
+    {
+        period_cycles = (double)(ch1.time_ps[1] - ch1.time_ps[0]) * 1e-12 * pio_clk_hz;
+        period_ok = fabs(period_cycles - floor(period_s * pio_clk_hz)) < 1e-3;
+    }
+
+    bool ok = rejected && !early && delay_ok && period_ok;
+    printf("%s: pin %u %s, div %.1f, jeda %llu ns = %.0f siklus PIO%s\n", c->name, c->trigger_pin,
+           c->active_high ? "aktif-high" : "aktif-low", c->pio_clk_div, (unsigned long long)c->delay_ns,
+           delay_cycles, c->cpu_feed ? ", feed CPU" : ", CPU diam");
+    printf("  terukur %.3f siklus PIO, %u edge CH1, periode berikutnya %.1f siklus%s%s\n", measured, ch1.count,
+           period_cycles, rejected ? "" : ", trigger aktif tidak ditolak", early ? ", output sebelum trigger" : "");
+    printf("  %s\n", ok ? "OK" : "GAGAL");
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 1)
+    {
+        fprintf(stderr, "pemakaian: %s\n", argv[0]);
+        return 2;
+    }
+
+    const trigger_case cases[] = {
+        {"ext_zero", EXTERNAL_TRIGGER_PIN, true, 1.0f, 0, 37, false},
+        {"ext_min", EXTERNAL_TRIGGER_PIN, true, 1.0f, 40, 41, false},
+        {"ext_1us", EXTERNAL_TRIGGER_PIN, true, 1.0f, 1000, 53, false},
+        {"ext_1ms_div2p5", EXTERNAL_TRIGGER_PIN, true, 2.5f, 1000000, 29, false},
+        {"ext_2p5s", EXTERNAL_TRIGGER_PIN, true, 1.0f, 2500000008ull, 17, false},
+        {"button_10us", BUTTON_PIN, false, 12.5f, 10000, 101, false},
+        {"button_250ms", BUTTON_PIN, false, 12.5f, 250000000, 73, false},
+        {"ext_fed_1us", EXTERNAL_TRIGGER_PIN, true, 1.0f, 1000, 23, true},
+        {"button_fed_100us", BUTTON_PIN, false, 12.5f, 100000, 61, true},
+    };
+
+    bool ok = true;
+    for (uint i = 0; i < count_of(cases); ++i)
+    {
+        ok &= run_case(&cases[i]);
+    }
+
+    // Jeda yang tidak muat di register X harus ditolak
+    const sg_timing_config too_long = {
+        .frequency_hz = 1000.0f,
+        .pio_clk_div = 1.0f,
+        .trigger_delay_ns = 60ull * 1000000000ull,
+    };
+    uint32_t n;
+    bool limit_ok = !sg_calculate_trigger_delay(125000000.0f, &too_long, &n);
+    printf("jeda di luar jangkauan ditolak: %s\n", limit_ok ? "OK" : "GAGAL");
+    ok &= limit_ok;
+
+    printf("%s\n", ok ? "OK" : "GAGAL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,333 @@
+/**
+ * sg_vcd: ekspor bentuk gelombang simulasi ke file VCD untuk GTKWave.
+ *
+ * Satu konfigurasi timing dijalankan lewat library signal_gen di atas
+ * simulasi PIO selama satu burst. Edge keempat pin output ditulis langsung
+ * ke file saat terjadi (tidak ada trace yang ditampung di memori), sehingga
+ * burst beberapa detik tetap bisa diekspor. Di samping output, ditulis juga
+ * sinyal referensi ideal dari spesifikasi (ref_ch14, ref_ch23) yang diselaraskan
+ * dengan edge pertama CH1.
+ *
+ * Opsi --internal menambahkan trace level FIFO TX, register X dan program
+ * counter. Fast-forward loop delay dimatikan agar setiap iterasi X tercatat,
+ * sehingga simulasi dan file VCD jauh lebih besar.
+ *
+ * Pemakaian:
+ *   sg_vcd [--freq <Hz>] [--pulse <us>] [--phase <us>] [--div <n>]
+ *          [--duration <us>] [--internal] [-o <file.vcd>]
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fake_hw.h"
+#include "signal_gen.h"
+
+#define PIN_BASE 6
+#define VCD_BUFFER_SIZE (1u << 20)
+
+// Identifier VCD: empat pin output, dua referensi, lalu trace internal
+static const char *const pin_ids[SG_NUM_PINS] = {"!", "\"", "#", "$"};
+#define ID_REF_CH14 "r"
+#define ID_REF_CH23 "s"
+#define ID_TX_LEVEL "f"
+#define ID_X "x"
+#define ID_PC "p"
+
+static struct
+{
+    FILE *out;
+    uint64_t last_time_ps;
+    bool time_written;
+    uint32_t levels;
+    uint64_t last_pin_ps;
+
+    // Referensi ideal
+    bool ref_started;
+    uint64_t ref_origin_ps;
+    uint64_t ref_period_index;
+    uint ref_phase; // 0..3: edge berikutnya dalam periode
+    uint64_t ref_offsets_ps[4];
+    double ref_period_ps;
+    uint64_t ref_end_ps;
+
+    // Trace internal
+    bool internal;
+    uint sm;
+    uint tx_level;
+    uint32_t x;
+    uint pc;
+} vcd;
+
+static void emit_time(uint64_t time_ps)
+{
+    if (!vcd.time_written || time_ps != vcd.last_time_ps)
+    {
+        fprintf(vcd.out, "#%llu\n", (unsigned long long)time_ps);
+        vcd.last_time_ps = time_ps;
+        vcd.time_written = true;
+    }
+}
+
+static void emit_vector(uint32_t value, uint bits, const char *id)
+{
+    char buf[33];
+    for (uint i = 0; i < bits; ++i)
+    {
+        buf[i] = (value >> (bits - 1 - i)) & 1u ? '1' : '0';
+    }
+    buf[bits] = '\0';
+    fprintf(vcd.out, "b%s %s\n", buf, id);
+}
+
+static uint64_t ref_next_edge_ps(void)
+{
+    return vcd.ref_origin_ps + (uint64_t)(vcd.ref_period_index * vcd.ref_period_ps) +
+           vcd.ref_offsets_ps[vcd.ref_phase];
+}
+
+/**
+ * @brief Menulis edge referensi ideal sampai (dan termasuk) time_ps.
+ */
+static void flush_reference(uint64_t time_ps)
+{
+    if (!vcd.ref_started)
+    {
+        return;
+    }
+    while (true)
+    {
+        uint64_t t = ref_next_edge_ps();
+        if (t > time_ps || t > vcd.ref_end_ps)
+        {
+            break;
+        }
+        emit_time(t);
+        // Urutan edge per periode: naik CH1/CH4, turun, naik CH2/CH3, turun
+        fprintf(vcd.out, "%c%s\n", vcd.ref_phase % 2 == 0 ? '1' : '0', vcd.ref_phase < 2 ? ID_REF_CH14 : ID_REF_CH23);
+        if (++vcd.ref_phase == 4)
+        {
+            vcd.ref_phase = 0;
+            vcd.ref_period_index++;
+        }
+    }
+}
+
+static void on_pins(void *ctx, uint64_t time_ps, uint32_t levels, uint32_t changed)
+{
+    (void)ctx;
+    uint32_t mask = ((1u << SG_NUM_PINS) - 1u) << PIN_BASE;
+    if (!(changed & mask))
+    {
+        return;
+    }
+    uint32_t now = (levels & mask) >> PIN_BASE;
+    if (!vcd.ref_started && (now & ~vcd.levels & 0x1u))
+    {
+        vcd.ref_started = true;
+        vcd.ref_origin_ps = time_ps;
+    }
+    flush_reference(time_ps);
+    emit_time(time_ps);
+    for (uint i = 0; i < SG_NUM_PINS; ++i)
+    {
+        if ((now ^ vcd.levels) & (1u << i))
+        {
+            fprintf(vcd.out, "%c%s\n", (now >> i) & 1u ? '1' : '0', pin_ids[i]);
+        }
+    }
+    vcd.levels = now;
+    vcd.last_pin_ps = time_ps;
+}
+
+static void on_sm(void *ctx, uint64_t time_ps, uint pio, uint sm, const struct fake_pio_sm *s)
+{
+    (void)ctx;
+    if (pio != 0 || sm != vcd.sm)
+    {
+        return;
+    }
+    if (s->tx_level == vcd.tx_level && s->x == vcd.x && s->pc == vcd.pc)
+    {
+        return;
+    }
+    flush_reference(time_ps);
+    emit_time(time_ps);
+    if (s->tx_level != vcd.tx_level)
+    {
+        emit_vector(s->tx_level, 4, ID_TX_LEVEL);
+        vcd.tx_level = s->tx_level;
+    }
+    if (s->x != vcd.x)
+    {
+        emit_vector(s->x, 32, ID_X);
+        vcd.x = s->x;
+    }
+    if (s->pc != vcd.pc)
+    {
+        emit_vector(s->pc, 5, ID_PC);
+        vcd.pc = s->pc;
+    }
+}
+
+static void write_header(const sg_timing_config *timing, const sg_instance *gen)
+{
+    fprintf(vcd.out, "$date simulasi sg_vcd $end\n");
+    fprintf(vcd.out, "$version sg_vcd (signal_generator.pio di atas fake Pico SDK) $end\n");
+    fprintf(vcd.out,
+            "$comment spesifikasi: %.3f Hz, pulsa %.3f us, fase %.3f us, clkdiv %.4f; "
+            "delay A..D = %u %u %u %u $end\n",
+            timing->frequency_hz, timing->pulse_width_us, timing->phase_shift_us, timing->pio_clk_div,
+            gen->delays[0], gen->delays[1], gen->delays[2], gen->delays[3]);
+    fprintf(vcd.out, "$timescale 1ps $end\n");
+    fprintf(vcd.out, "$scope module signal_generator $end\n");
+    for (uint i = 0; i < SG_NUM_PINS; ++i)
+    {
+        fprintf(vcd.out, "$var wire 1 %s ch%u $end\n", pin_ids[i], i + 1);
+    }
+    fprintf(vcd.out, "$var wire 1 %s ref_ch14 $end\n", ID_REF_CH14);
+    fprintf(vcd.out, "$var wire 1 %s ref_ch23 $end\n", ID_REF_CH23);
+    if (vcd.internal)
+    {
+        fprintf(vcd.out, "$var wire 4 %s tx_level $end\n", ID_TX_LEVEL);
+        fprintf(vcd.out, "$var wire 32 %s x $end\n", ID_X);
+        fprintf(vcd.out, "$var wire 5 %s pc $end\n", ID_PC);
+    }
+    fprintf(vcd.out, "$upscope $end\n$enddefinitions $end\n");
+
+    fprintf(vcd.out, "#0\n$dumpvars\n");
+    for (uint i = 0; i < SG_NUM_PINS; ++i)
+    {
+        fprintf(vcd.out, "0%s\n", pin_ids[i]);
+    }
+    fprintf(vcd.out, "0%s\n0%s\n", ID_REF_CH14, ID_REF_CH23);
+    if (vcd.internal)
+    {
+        emit_vector(0, 4, ID_TX_LEVEL);
+        emit_vector(0, 32, ID_X);
+        emit_vector(0, 5, ID_PC);
+    }
+    fprintf(vcd.out, "$end\n");
+    vcd.last_time_ps = 0;
+    vcd.time_written = true;
+}
+
+static int usage(const char *argv0)
+{
+    fprintf(stderr,
+            "pemakaian: %s [--freq <Hz>] [--pulse <us>] [--phase <us>] [--div <n>]\n"
+            "          [--duration <us>] [--internal] [-o <file.vcd>]\n",
+            argv0);
+    return 2;
+}
+
+int main(int argc, char **argv)
+{
+    sg_timing_config timing = {
+        .frequency_hz = 1000.0f,
+        .pulse_width_us = 5.0f,
+        .phase_shift_us = 5.0f,
+        .pio_clk_div = 12.5f,
+    };
+    uint64_t duration_us = 10000;
+    const char *path = "signal_generator.vcd";
+
+    for (int i = 1; i < argc; ++i)
+    {
+        bool has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--freq") == 0 && has_value)
+        {
+            timing.frequency_hz = strtof(argv[++i], NULL);
+        }
+        else if (strcmp(argv[i], "--pulse") == 0 && has_value)
+        {
+            timing.pulse_width_us = strtof(argv[++i], NULL);
+        }
+        else if (strcmp(argv[i], "--phase") == 0 && has_value)
+        {
+            timing.phase_shift_us = strtof(argv[++i], NULL);
+        }
+        else if (strcmp(argv[i], "--div") == 0 && has_value)
+        {
+            timing.pio_clk_div = strtof(argv[++i], NULL);
+        }
+        else if (strcmp(argv[i], "--duration") == 0 && has_value)
+        {
+            duration_us = strtoull(argv[++i], NULL, 0);
+        }
+        else if (strcmp(argv[i], "--internal") == 0)
+        {
+            vcd.internal = true;
+        }
+        else if (strcmp(argv[i], "-o") == 0 && has_value)
+        {
+            path = argv[++i];
+        }
+        else
+        {
+            return usage(argv[0]);
+        }
+    }
+
+    fake_hw_reset();
+    fake_hw_log_set_enabled(false);
+
+    sg_instance gen;
+    if (!sg_init(&gen, pio0, PIN_BASE) || !sg_configure(&gen, &timing))
+    {
+        fprintf(stderr, "konfigurasi timing ditolak oleh sg_configure()\n");
+        return 1;
+    }
+
+    vcd.out = fopen(path, "w");
+    if (!vcd.out)
+    {
+        perror(path);
+        return 1;
+    }
+    setvbuf(vcd.out, NULL, _IOFBF, VCD_BUFFER_SIZE);
+    vcd.sm = gen.sm;
+
+    // Referensi ideal: offset edge dalam satu periode menurut spesifikasi
+    double pulse_ps = timing.pulse_width_us * 1e6;
+    double phase_ps = timing.phase_shift_us * 1e6;
+    vcd.ref_period_ps = 1e12 / timing.frequency_hz;
+    vcd.ref_offsets_ps[0] = 0;
+    vcd.ref_offsets_ps[1] = (uint64_t)pulse_ps;
+    vcd.ref_offsets_ps[2] = (uint64_t)(pulse_ps + phase_ps);
+    vcd.ref_offsets_ps[3] = (uint64_t)(2 * pulse_ps + phase_ps);
+    vcd.ref_end_ps = UINT64_MAX;
+
+    write_header(&timing, &gen);
+    fake_hw_set_pin_listener(on_pins, NULL);
+    if (vcd.internal)
+    {
+        fake_hw_set_fast_forward(false);
+        fake_hw_set_sm_listener(on_sm, NULL);
+    }
+
+    sg_run_burst(&gen, duration_us);
+    // Biarkan event terakhir di FIFO selesai sebelum state machine dihentikan
+    fake_hw_advance_us((uint64_t)(2e6 / timing.frequency_hz) + 1);
+    sg_stop(&gen);
+
+    // Referensi berhenti bersama edge output terakhir
+    vcd.ref_end_ps = vcd.last_pin_ps;
+    flush_reference(vcd.ref_end_ps);
+    emit_time(fake_hw_now_ps());
+    fake_hw_set_pin_listener(NULL, NULL);
+    fake_hw_set_sm_listener(NULL, NULL);
+
+    if (fclose(vcd.out) != 0)
+    {
+        perror(path);
+        return 1;
+    }
+    printf("sg_vcd: %s, burst %llu us, delay A..D = %u %u %u %u%s\n", path, (unsigned long long)duration_us,
+           gen.delays[0], gen.delays[1], gen.delays[2], gen.delays[3], vcd.internal ? ", trace internal" : "");
+    sg_deinit(&gen);
+    return 0;
+}
@@ -0,0 +1,394 @@
+/**
+ * sg_vco: pemeriksaan mode VCO (signal_vco) di atas ADC dan DMA simulasi.
+ *
+ * Diperiksa:
+ *   - tegangan tetap: setiap periode sama dengan tabel event D untuk kode ADC
+ *     tegangan itu (dalam satu siklus clk_sys karena divider PIO 12,5), pada
+ *     pemetaan linear dan eksponensial, termasuk ujung rentang dan tegangan
+ *     di luar 0..3,3 V,
+ *   - kalibrasi: kode rata-rata dari sg_vco_code() pada dua tegangan menjadi
+ *     code_min/code_max, lalu kedua tegangan itu menghasilkan tepat f_min dan
+ *     f_max; kalibrasi dan rentang yang tidak valid ditolak,
+ *   - pelacakan sinus dan ramp: setiap periode terukur berada di antara
+ *     periode untuk kode minimum dan maksimum tegangan dalam jendela lag
+ *     (dua periode sebelumnya ditambah jendela rata-rata); lebar pulsa A dan
+ *     C tetap di setiap periode,
+ *   - tidak ada sampel ADC yang dibuang (FIFO ADC tidak pernah penuh) dan
+ *     FIFO generator tidak pernah kosong selama loop sg_vco_service().
+ * Rata-rata dan maksimum kesalahan pelacakan terhadap tegangan sesaat
+ * dicetak per sinyal.
+ *
+ * Pemakaian: sg_vco
+ * Exit 1 jika ada perbedaan.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fake_hw.h"
+#include "hardware/clocks.h"
+#include "signal_vco.h"
+
+#define PIN_BASE 6
+#define CH1_MASK (1u << PIN_BASE)
+#define CH2_MASK (1u << (PIN_BASE + 1))
+#define ADC_INPUT 0
+#define F_MIN_HZ 100.0f
+#define F_MAX_HZ 10000.0f
+#define SAMPLE_RATE_HZ 500000u
+#define SETTLE_PERIODS 3 // Periode awal yang sudah ada di FIFO sebelum tegangan stabil
+#define LAG_MARGIN_US 40.0 // Jendela rata-rata 16 x 2 us ditambah loop service
+
+static const sg_timing_config timing = {
+    .frequency_hz = 1000.0f,
+    .pulse_width_us = 5.0f,
+    .phase_shift_us = 5.0f,
+    .pio_clk_div = 12.5f,
+};
+
+// -- Edge Pin --
+
+static struct
+{
+    uint64_t *rise;     // Edge naik CH1 = awal periode
+    uint64_t *ch1_high; // Lebar pulsa CH1 periode yang sama
+    uint64_t *ch2_high; // Lebar pulsa CH2 periode yang sama
+    size_t count;
+    size_t capacity;
+    uint64_t ch2_rise;
+} edges;
+
+static void on_pins(void *ctx, uint64_t time_ps, uint32_t levels, uint32_t changed)
+{
+    (void)ctx;
+    if ((changed & CH1_MASK) && (levels & CH1_MASK))
+    {
+        if (edges.count == edges.capacity)
+        {
+            edges.capacity = edges.capacity ? 2 * edges.capacity : 4096;
+            edges.rise = realloc(edges.rise, edges.capacity * sizeof(uint64_t));
+            edges.ch1_high = realloc(edges.ch1_high, edges.capacity * sizeof(uint64_t));
+            edges.ch2_high = realloc(edges.ch2_high, edges.capacity * sizeof(uint64_t));
+            if (!edges.rise || !edges.ch1_high || !edges.ch2_high)
+            {
+                fprintf(stderr, "sg_vco: memori habis\n");
+                exit(2);
+            }
+        }
+        edges.rise[edges.count] = time_ps;
+        edges.ch1_high[edges.count] = 0;
+        edges.ch2_high[edges.count] = 0;
+        edges.count++;
+    }
+    if (edges.count == 0)
+    {
+        return;
+    }
+    if ((changed & CH1_MASK) && !(levels & CH1_MASK))
+    {
+        edges.ch1_high[edges.count - 1] = time_ps - edges.rise[edges.count - 1];
+    }
+    if ((changed & CH2_MASK) && (levels & CH2_MASK))
+    {
+        edges.ch2_rise = time_ps;
+    }
+    if ((changed & CH2_MASK) && !(levels & CH2_MASK))
+    {
+        edges.ch2_high[edges.count - 1] = time_ps - edges.ch2_rise;
+    }
+}
+
+// -- Sumber Tegangan --
+
+typedef struct
+{
+    const char *name;
+    double offset_v;
+    double amplitude_v;
+    double freq_hz; // 0 = ramp naik dari offset sebesar amplitude per detik
+} signal_spec;
+
+static uint64_t signal_start_ps; // t = 0 sinyal yang sedang diuji
+
+static float signal_volts(void *ctx, uint64_t time_ps)
+{
+    const signal_spec *s = ctx;
+    double t = ((double)time_ps - (double)signal_start_ps) / 1e12;
+    if (s->freq_hz == 0.0)
+    {
+        return (float)(s->offset_v + s->amplitude_v * t);
+    }
+    return (float)(s->offset_v + s->amplitude_v * sin(2.0 * M_PI * s->freq_hz * t));
+}
+
+static uint volts_to_code(double v)
+{
+    long code = lround(v * 4096.0 / 3.3);
+    return (uint)(code < 0 ? 0 : code > 4095 ? 4095 : code);
+}
+
+// -- Generator --
+
+static sg_instance gen;
+static sg_vco_instance vco;
+static double ps_per_pio_cycle;
+static uint64_t sys_cycle_ps; // Divider pecahan 12,5: tiap siklus PIO 12 atau 13 siklus clk_sys
+static uint32_t fixed_cycles; // Siklus PIO event A..C (termasuk overhead)
+
+/**
+ * @brief Selisih waktu sama dengan nilai harapan, dalam satu siklus clk_sys.
+ */
+static bool near(uint64_t got, uint64_t expected)
+{
+    return got + sys_cycle_ps >= expected && got <= expected + sys_cycle_ps;
+}
+
+/**
+ * @brief Periode (ps) untuk sebuah kode menurut tabel VCO.
+ */
+static uint64_t code_period_ps(uint code)
+{
+    return (uint64_t)llround((double)(fixed_cycles + vco.delay_d[code] + SG_EVENT_D_OVERHEAD_CYCLES) *
+                             ps_per_pio_cycle);
+}
+
+static uint64_t frequency_period_ps(float frequency_hz)
+{
+    sg_timing_config t = gen.timing;
+    t.frequency_hz = frequency_hz;
+    uint32_t delays[SG_NUM_EVENTS];
+    sg_calculate_delays((float)gen.sys_clk_hz, &t, delays);
+    return (uint64_t)llround((double)(fixed_cycles + delays[SG_NUM_EVENTS - 1] + SG_EVENT_D_OVERHEAD_CYCLES) *
+                             ps_per_pio_cycle);
+}
+
+static bool start_vco(sg_vco_curve curve, uint16_t code_min, uint16_t code_max)
+{
+    const sg_vco_config config = {
+        .adc_input = ADC_INPUT,
+        .sample_rate_hz = SAMPLE_RATE_HZ,
+        .curve = curve,
+        .f_min_hz = F_MIN_HZ,
+        .f_max_hz = F_MAX_HZ,
+        .code_min = code_min,
+        .code_max = code_max,
+    };
+    edges.count = 0;
+    return sg_vco_init(&vco, &gen, &config) && sg_vco_start(&vco);
+}
+
+typedef struct
+{
+    uint64_t services;
+    uint64_t starved; // Pemanggilan yang menemukan FIFO TX kosong
+} run_stats;
+
+/**
+ * @brief Menjalankan loop sg_vco_service() selama duration_us.
+ */
+static run_stats run_service(uint64_t duration_us)
+{
+    run_stats st = {0, 0};
+    uint64_t end_ps = fake_hw_now_ps() + duration_us * 1000000ull;
+    while (fake_hw_now_ps() < end_ps)
+    {
+        if (pio_sm_is_tx_fifo_empty(gen.pio, gen.sm))
+        {
+            st.starved++;
+        }
+        sg_vco_service(&vco);
+        st.services++;
+    }
+    return st;
+}
+
+/**
+ * @brief Memeriksa lebar pulsa A dan C setiap periode lengkap.
+ */
+static size_t pulse_mismatches(void)
+{
+    uint64_t pulse_ps = (uint64_t)llround((double)(gen.delays[0] + SG_EVENT_OVERHEAD_CYCLES) * ps_per_pio_cycle);
+    uint64_t pulse_c_ps = (uint64_t)llround((double)(gen.delays[2] + SG_EVENT_OVERHEAD_CYCLES) * ps_per_pio_cycle);
+    size_t bad = 0;
+    for (size_t k = 0; k + 1 < edges.count; ++k)
+    {
+        bad += !near(edges.ch1_high[k], pulse_ps) || !near(edges.ch2_high[k], pulse_c_ps);
+    }
+    return bad;
+}
+
+/**
+ * @brief Tegangan tetap: setiap periode setelah settle sama dengan tabel.
+ */
+static bool check_constant(sg_vco_curve curve, double volts, float expect_hz)
+{
+    fake_hw_adc_set_voltage(ADC_INPUT, (float)volts);
+    bool ok = start_vco(curve, 0, SG_VCO_CODES - 1);
+    uint64_t period_ps = code_period_ps(volts_to_code(volts));
+    run_service((uint64_t)(period_ps * (SETTLE_PERIODS + 12) / 1000000u) + 100u);
+    size_t mismatches = 0;
+    for (size_t k = SETTLE_PERIODS; k + 1 < edges.count; ++k)
+    {
+        mismatches += !near(edges.rise[k + 1] - edges.rise[k], period_ps);
+    }
+    size_t pulses = pulse_mismatches();
+    double f = 1e12 / (double)period_ps;
+    ok &= edges.count > SETTLE_PERIODS + 8 && mismatches == 0 && pulses == 0 && vco.code == volts_to_code(volts) &&
+          fabs(f - expect_hz) <= expect_hz * 0.002 + 0.5;
+    printf("%-5s %.2f V: kode %4u, %zu periode %.3f us = %.2f Hz (nominal %.2f Hz)\n  %s\n",
+           curve == SG_VCO_LINEAR ? "lin" : "exp", volts, vco.code, edges.count, (double)period_ps / 1e6, f,
+           (double)expect_hz, ok ? "OK" : "GAGAL");
+    if (!ok)
+    {
+        printf("  beda periode %zu, beda pulsa %zu\n", mismatches, pulses);
+    }
+    sg_vco_stop(&vco);
+    return ok;
+}
+
+/**
+ * @brief Pelacakan sinyal berubah: periode terukur di dalam rentang kode
+ *        jendela lag, dan kesalahan terhadap tegangan sesaat dicetak.
+ */
+static bool check_tracking(const signal_spec *s, uint64_t duration_us)
+{
+    signal_start_ps = fake_hw_now_ps();
+    fake_hw_adc_set_source(ADC_INPUT, signal_volts, (void *)s);
+    uint64_t overflows = fake_hw_adc_overflows();
+    bool ok = start_vco(SG_VCO_EXPONENTIAL, 0, SG_VCO_CODES - 1);
+    run_stats st = run_service(duration_us);
+    sg_vco_stop(&vco);
+
+    size_t outside = 0;
+    double err_sum = 0.0;
+    double err_max = 0.0;
+    size_t checked = 0;
+    for (size_t k = 1; k + 1 < edges.count; ++k)
+    {
+        uint64_t start = edges.rise[k];
+        uint64_t got = edges.rise[k + 1] - start;
+        double lag_ps = 2.0 * (double)(start - edges.rise[k - 1]) + LAG_MARGIN_US * 1e6;
+        uint code_lo = SG_VCO_CODES;
+        uint code_hi = 0;
+        for (double t = (double)start - lag_ps; t <= (double)start; t += 1e6)
+        {
+            uint code = volts_to_code(signal_volts((void *)s, (uint64_t)t));
+            code_lo = code < code_lo ? code : code_lo;
+            code_hi = code > code_hi ? code : code_hi;
+        }
+        // Kode lebih tinggi = frekuensi lebih tinggi = periode lebih pendek
+        if (got + sys_cycle_ps < code_period_ps(code_hi) || got > code_period_ps(code_lo) + sys_cycle_ps)
+        {
+            if (outside++ < 3)
+            {
+                printf("  periode %zu: %.3f us, rentang %.3f..%.3f us\n", k, (double)got / 1e6,
+                       (double)code_period_ps(code_hi) / 1e6, (double)code_period_ps(code_lo) / 1e6);
+            }
+        }
+        double f_now = sg_vco_frequency(&vco, volts_to_code(signal_volts((void *)s, start)));
+        double err = fabs(1e12 / (double)got - f_now) / f_now;
+        err_sum += err;
+        err_max = err > err_max ? err : err_max;
+        checked++;
+    }
+    size_t pulses = pulse_mismatches();
+    uint64_t dropped = fake_hw_adc_overflows() - overflows;
+    ok &= checked > 20 && outside == 0 && pulses == 0 && dropped == 0 && st.starved == 0 && vco.updates > 0;
+    printf("%-6s %zu periode, %lu update event D, %llu service: kesalahan frekuensi terhadap tegangan sesaat "
+           "rata-rata %.2f%%, maks %.2f%%\n  %s\n",
+           s->name, checked, (unsigned long)vco.updates, (unsigned long long)st.services, 100.0 * err_sum / checked,
+           100.0 * err_max, ok ? "OK" : "GAGAL");
+    if (!ok)
+    {
+        printf("  di luar rentang %zu, beda pulsa %zu, sampel ADC dibuang %llu, FIFO kosong %llu\n", outside, pulses,
+               (unsigned long long)dropped, (unsigned long long)st.starved);
+    }
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 1)
+    {
+        fprintf(stderr, "pemakaian: %s\n", argv[0]);
+        return 2;
+    }
+
+    fake_hw_reset();
+    fake_hw_log_set_enabled(false);
+    fake_hw_set_pin_listener(on_pins, NULL);
+    if (!sg_init(&gen, pio0, PIN_BASE) || !sg_configure(&gen, &timing))
+    {
+        fprintf(stderr, "sg_vco: inisialisasi generator gagal\n");
+        return 2;
+    }
+    ps_per_pio_cycle = 1e12 * (double)timing.pio_clk_div / (double)clock_get_hz(clk_sys);
+    sys_cycle_ps = 1000000000000ull / clock_get_hz(clk_sys);
+    fixed_cycles = gen.delays[0] + gen.delays[1] + gen.delays[2] + 3u * SG_EVENT_OVERHEAD_CYCLES;
+    bool ok = true;
+
+    // -- Tegangan Tetap --
+    ok &= check_constant(SG_VCO_LINEAR, 0.0, F_MIN_HZ);
+    ok &= check_constant(SG_VCO_LINEAR, 1.0, F_MIN_HZ + (F_MAX_HZ - F_MIN_HZ) * volts_to_code(1.0) / 4095.0f);
+    ok &= check_constant(SG_VCO_LINEAR, 3.3, F_MAX_HZ);
+    ok &= check_constant(SG_VCO_EXPONENTIAL, 1.65, F_MIN_HZ * powf(100.0f, volts_to_code(1.65) / 4095.0f));
+    ok &= check_constant(SG_VCO_EXPONENTIAL, 2.5, F_MIN_HZ * powf(100.0f, volts_to_code(2.5) / 4095.0f));
+    ok &= check_constant(SG_VCO_EXPONENTIAL, 4.0, F_MAX_HZ);
+    ok &= check_constant(SG_VCO_EXPONENTIAL, -0.5, F_MIN_HZ);
+
+    // -- Kalibrasi --
+    fake_hw_adc_set_voltage(ADC_INPUT, 0.5f);
+    bool cal_ok = start_vco(SG_VCO_LINEAR, 0, SG_VCO_CODES - 1);
+    run_service(200);
+    uint16_t code_min = (uint16_t)sg_vco_code(&vco);
+    fake_hw_adc_set_voltage(ADC_INPUT, 2.5f);
+    run_service(200);
+    uint16_t code_max = (uint16_t)sg_vco_code(&vco);
+    cal_ok &= sg_vco_set_calibration(&vco, code_min, code_max) && !sg_vco_set_calibration(&vco, 900, 900) &&
+              !sg_vco_set_calibration(&vco, 100, SG_VCO_CODES) && vco.config.code_min == code_min;
+    edges.count = 0;
+    run_service(3000);
+    uint64_t period_max = edges.count > 2 ? edges.rise[edges.count - 1] - edges.rise[edges.count - 2] : 0;
+    fake_hw_adc_set_voltage(ADC_INPUT, 0.5f);
+    run_service(40000);
+    uint64_t period_min = edges.count > 2 ? edges.rise[edges.count - 1] - edges.rise[edges.count - 2] : 0;
+    sg_vco_stop(&vco);
+    cal_ok &= code_min == volts_to_code(0.5) && code_max == volts_to_code(2.5) &&
+              near(period_max, frequency_period_ps(F_MAX_HZ)) && near(period_min, frequency_period_ps(F_MIN_HZ));
+    printf("kalibrasi 0,50 V -> kode %u, 2,50 V -> kode %u: %.2f Hz dan %.2f Hz saat berjalan\n  %s\n", code_min,
+           code_max, period_min ? 1e12 / (double)period_min : 0.0, period_max ? 1e12 / (double)period_max : 0.0,
+           cal_ok ? "OK" : "GAGAL");
+    ok &= cal_ok;
+
+    // Pulsa 15 us tidak muat pada 100 kHz; rentang dan input tidak valid
+    sg_vco_config bad = vco.config;
+    bad.f_max_hz = 100000.0f;
+    bool reject_ok = !sg_vco_init(&vco, &gen, &bad);
+    bad = vco.config;
+    bad.adc_input = 4;
+    reject_ok &= !sg_vco_init(&vco, &gen, &bad);
+    bad = vco.config;
+    bad.sample_rate_hz = SG_VCO_MAX_SAMPLE_RATE_HZ + 1u;
+    reject_ok &= !sg_vco_init(&vco, &gen, &bad);
+    printf("f_max di atas batas pulsa, input ADC 4 dan laju sampel > 500 kS/s ditolak\n  %s\n",
+           reject_ok ? "OK" : "GAGAL");
+    ok &= reject_ok;
+
+    // -- Pelacakan --
+    static const signal_spec sine = {"sinus", 1.65, 1.2, 20.0};
+    static const signal_spec fast = {"sinus2", 2.2, 0.6, 200.0};
+    static const signal_spec ramp = {"ramp", 0.2, 20.0, 0.0};
+    uint64_t adc_samples = fake_hw_adc_samples();
+    ok &= check_tracking(&sine, 100000);
+    ok &= check_tracking(&fast, 20000);
+    ok &= check_tracking(&ramp, 150000);
+    printf("ADC: %llu sampel, %llu dibuang\n", (unsigned long long)(fake_hw_adc_samples() - adc_samples),
+           (unsigned long long)fake_hw_adc_overflows());
+
+    printf("%s\n", ok ? "OK" : "GAGAL");
+    return ok ? 0 : 1;
+}
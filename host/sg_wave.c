@@ -0,0 +1,353 @@
+/**
+ * sg_wave: pemeriksaan library tabel gelombang di flash (signal_wave) dan
+ * pemutarannya lewat stream XIP, bounce buffer dan DMA ke sequencer.
+ *
+ * Diperiksa:
+ *   - tabel ditulis per potongan (termasuk sweep 64 Ki event = 256 KiB, lebih
+ *     besar dari SRAM RP2040), terbaca kembali setelah indeks dibangun ulang,
+ *     CRC cocok, nama duplikat dan ukuran berlebih ditolak,
+ *   - listrik padam saat commit: tabel itu tidak terlihat, tabel lain utuh,
+ *   - setiap durasi event di pin sama dengan tabel di flash pada rata-rata
+ *     200/100/64/48 siklus per event (divider 1, clk_sys 125 MHz), tanpa
+ *     underrun, termasuk sweep penuh dan tabel loop melewati batas putaran,
+ *   - di atas laju stream (28 siklus per event) underrun terdeteksi, output
+ *     berhenti ke idle dan tidak ada event basi yang keluar,
+ *   - semua erase/program lewat flash_safe_execute(), region preset tidak
+ *     tersentuh.
+ * Laju event dan MB/s yang tercapai dicetak per tabel.
+ *
+ * Pemakaian: sg_wave
+ * Exit 1 jika ada perbedaan.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fake_hw.h"
+#include "hardware/clocks.h"
+#include "signal_wave.h"
+
+#define PIN_BASE 2
+#define PIN_MASK (1u << PIN_BASE)
+#define RATE_WORDS 8192
+#define SWEEP_WORDS 65536
+#define SWEEP_FROM 400 // Siklus event pertama sweep
+#define SWEEP_TO 52    // Siklus event terakhir sweep
+#define WRITE_CHUNK 1000
+#define LOOP_PASSES 2.5
+
+/**
+ * @brief Isi tabel uji: event bergantian mask 1/0 dengan durasi rata-rata
+ *        avg_cycles (+-8 siklus) atau sweep SWEEP_FROM..SWEEP_TO.
+ */
+typedef struct
+{
+    const char *name;
+    uint32_t words;
+    uint32_t avg_cycles; // 0 = sweep
+} table_spec;
+
+static const table_spec specs[] = {
+    {"rate200", RATE_WORDS, 200}, {"rate100", RATE_WORDS, 100}, {"rate64", RATE_WORDS, 64},
+    {"rate48", RATE_WORDS, 48},   {"sweep", SWEEP_WORDS, 0},    {"dense28", RATE_WORDS, 28},
+};
+#define NUM_SPECS (sizeof(specs) / sizeof(specs[0]))
+#define DENSE_SPEC (NUM_SPECS - 1)
+
+static uint32_t event_cycles(const table_spec *spec, uint32_t i)
+{
+    if (spec->avg_cycles == 0)
+    {
+        return SWEEP_FROM - (uint32_t)((uint64_t)(SWEEP_FROM - SWEEP_TO) * i / (spec->words - 1u));
+    }
+    return spec->avg_cycles + (i * 37u) % 17u - 8u;
+}
+
+static uint32_t event_at(const table_spec *spec, uint32_t i)
+{
+    return SG_SEQ_EVENT((i & 1u) ? 0u : 1u, event_cycles(spec, i));
+}
+
+static struct
+{
+    uint64_t *time_ps;
+    size_t count;
+    size_t capacity;
+} edges;
+
+static void on_pins(void *ctx, uint64_t time_ps, uint32_t levels, uint32_t changed)
+{
+    (void)ctx;
+    (void)levels;
+    if (!(changed & PIN_MASK))
+    {
+        return;
+    }
+    if (edges.count == edges.capacity)
+    {
+        edges.capacity = edges.capacity ? 2 * edges.capacity : 65536;
+        edges.time_ps = realloc(edges.time_ps, edges.capacity * sizeof(uint64_t));
+        if (!edges.time_ps)
+        {
+            fprintf(stderr, "sg_wave: memori habis\n");
+            exit(2);
+        }
+    }
+    edges.time_ps[edges.count++] = time_ps;
+}
+
+/**
+ * @brief Menulis satu tabel per potongan WRITE_CHUNK word.
+ */
+static bool write_table(sg_wave_library *lib, const table_spec *spec)
+{
+    uint32_t chunk[WRITE_CHUNK];
+    if (!sg_wave_library_begin(lib, spec->name, spec->words))
+    {
+        return false;
+    }
+    for (uint32_t pos = 0; pos < spec->words; pos += WRITE_CHUNK)
+    {
+        uint32_t n = spec->words - pos < WRITE_CHUNK ? spec->words - pos : WRITE_CHUNK;
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            chunk[i] = event_at(spec, pos + i);
+        }
+        if (!sg_wave_library_write(lib, chunk, n))
+        {
+            return false;
+        }
+    }
+    return sg_wave_library_commit(lib);
+}
+
+/**
+ * @brief Hasil satu pemutaran.
+ */
+typedef struct
+{
+    bool started;
+    bool finished;
+    uint32_t underruns;
+    uint32_t chunks;
+    size_t edges;
+    size_t mismatches;    // Selisih edge yang tidak sama dengan durasi tabel
+    bool idle;            // Pin LOW setelah stop
+    double start_us;      // Durasi sg_wave_start() (isi awal bounce buffer)
+    uint64_t start_words; // Word yang dibaca stream selama sg_wave_start()
+    double events_per_s;
+} play_result;
+
+/**
+ * @brief Memutar tabel sampai habis (tanpa loop) atau sebanyak `events`
+ *        event (loop), lalu membandingkan setiap selisih edge dengan tabel.
+ *
+ * Jika tabel tidak selesai (loop atau underrun), edge terakhir bisa berasal
+ * dari stop di tengah event: event itu hanya boleh lebih pendek dari tabel.
+ */
+static play_result play(sg_wave_player *player, const table_spec *spec, const sg_wave_table *table, bool loop,
+                        uint64_t events)
+{
+    play_result r;
+    memset(&r, 0, sizeof(r));
+    double ps_per_cycle = 1e12 / (double)clock_get_hz(clk_sys);
+    uint64_t run_cycles = 0;
+    for (uint64_t i = 0; i < events; ++i)
+    {
+        run_cycles += event_cycles(spec, (uint32_t)(i % spec->words));
+    }
+
+    edges.count = 0;
+    uint64_t before_ps = fake_hw_now_ps();
+    uint64_t before_words = fake_hw_flash_stream_words();
+    r.started = sg_wave_start(player, table, 1.0f, 0, loop);
+    r.start_us = (double)(fake_hw_now_ps() - before_ps) / 1e6;
+    r.start_words = fake_hw_flash_stream_words() - before_words;
+    if (!r.started)
+    {
+        return r;
+    }
+    fake_hw_advance_us((uint64_t)((double)run_cycles * ps_per_cycle / 1e6) + 50u);
+    r.finished = player->finished;
+    r.underruns = player->underruns;
+    r.chunks = player->chunks;
+    sg_wave_stop(player);
+    r.idle = (fake_hw_gpio_levels() & PIN_MASK) == 0;
+
+    r.edges = edges.count;
+    for (size_t k = 0; k + 1 < edges.count; ++k)
+    {
+        uint64_t expected = (uint64_t)((double)event_cycles(spec, (uint32_t)(k % spec->words)) * ps_per_cycle);
+        uint64_t got = edges.time_ps[k + 1] - edges.time_ps[k];
+        bool truncated = !r.finished && k + 2 == edges.count && got < expected;
+        if (got != expected && !truncated)
+        {
+            if (r.mismatches++ < 3)
+            {
+                printf("  event %zu: %.1f ns, tabel %.1f ns\n", k, (double)got / 1e3, (double)expected / 1e3);
+            }
+        }
+    }
+    if (edges.count > 1)
+    {
+        r.events_per_s = (double)(edges.count - 1) * 1e12 / (double)(edges.time_ps[edges.count - 1] - edges.time_ps[0]);
+    }
+    return r;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 1)
+    {
+        fprintf(stderr, "pemakaian: %s\n", argv[0]);
+        return 2;
+    }
+
+    fake_hw_reset();
+    fake_hw_log_set_enabled(false);
+    fake_hw_flash_erase_all();
+    fake_hw_set_pin_listener(on_pins, NULL);
+    bool ok = true;
+
+    // -- Library --
+    sg_wave_library lib;
+    sg_wave_library_init(&lib);
+    bool lib_ok = lib.tables == 0 && sg_wave_library_format(&lib);
+    for (uint i = 0; i < NUM_SPECS && lib_ok; ++i)
+    {
+        lib_ok = write_table(&lib, &specs[i]);
+    }
+    uint32_t writes = lib.writes;
+    uint32_t erases = lib.erases;
+    const uint32_t pair[2] = {SG_SEQ_EVENT(1, 100), SG_SEQ_EVENT(0, 100)};
+    lib_ok &= !sg_wave_library_begin(&lib, "rate64", 1) && !sg_wave_library_begin(&lib, "", 1) &&
+              !sg_wave_library_begin(&lib, "nama_terlalu_panjang", 1) &&
+              !sg_wave_library_begin(&lib, "besar", SG_WAVE_MAX_WORDS) && sg_wave_library_begin(&lib, "dua", 2) &&
+              sg_wave_library_write(&lib, pair, 1) && !sg_wave_library_commit(&lib) &&
+              !sg_wave_library_write(&lib, pair, 2);
+
+    sg_wave_library_init(&lib);
+    sg_wave_table tables[NUM_SPECS];
+    lib_ok &= lib.tables == NUM_SPECS && lib.corrupt == 0;
+    for (uint i = 0; i < NUM_SPECS && lib_ok; ++i)
+    {
+        char name[SG_WAVE_NAME_MAX + 1];
+        sg_wave_table by_index;
+        lib_ok = sg_wave_library_find(&lib, specs[i].name, &tables[i]) &&
+                 sg_wave_library_get(&lib, i, &by_index, name) && strcmp(name, specs[i].name) == 0 &&
+                 by_index.offset == tables[i].offset && tables[i].words == specs[i].words &&
+                 sg_wave_table_verify(&tables[i]);
+        const uint32_t *data = sg_wave_table_data(&tables[i]);
+        for (uint32_t w = 0; w < specs[i].words && lib_ok; ++w)
+        {
+            lib_ok = data[w] == event_at(&specs[i], w);
+        }
+    }
+    lib_ok &= !sg_wave_library_get(&lib, NUM_SPECS, &tables[0], NULL) &&
+              !sg_wave_library_find(&lib, "tidak_ada", &tables[0]) &&
+              sg_wave_library_find(&lib, specs[0].name, &tables[0]);
+    printf("library: %u tabel (sweep %u event = %u KiB), %lu halaman diprogram, %lu sektor di-erase, "
+           "%lu KiB terpakai\n  %s\n",
+           (unsigned)lib.tables, SWEEP_WORDS, SWEEP_WORDS * 4u / 1024u, (unsigned long)writes, (unsigned long)erases,
+           (unsigned long)(lib.next_offset / 1024u), lib_ok ? "OK" : "GAGAL");
+    ok &= lib_ok;
+
+    // -- Listrik padam saat commit --
+    // Anggaran: erase sektor data, satu halaman data, bagian halaman direktori
+    // sebelum slot entri baru, lalu 10 byte entri
+    const table_spec lost = {"hilang", 64, 100};
+    fake_hw_flash_power_loss_after(FLASH_SECTOR_SIZE + FLASH_PAGE_SIZE + (lib.entries * 32u) % FLASH_PAGE_SIZE + 10u);
+    write_table(&lib, &lost);
+    fake_hw_flash_power_restore();
+    sg_wave_library_init(&lib);
+    sg_wave_table lost_table;
+    bool power_ok = lib.tables == NUM_SPECS && lib.corrupt == 1 && !sg_wave_library_find(&lib, lost.name, &lost_table);
+    for (uint i = 0; i < NUM_SPECS; ++i)
+    {
+        power_ok &= sg_wave_table_verify(&tables[i]);
+    }
+    power_ok &= write_table(&lib, &lost);
+    sg_wave_library_init(&lib);
+    power_ok &= lib.tables == NUM_SPECS + 1 && sg_wave_library_find(&lib, lost.name, &lost_table) &&
+                sg_wave_table_verify(&lost_table);
+    printf("listrik padam setelah 10 byte entri direktori: entri rusak diabaikan, tabel lain utuh, "
+           "tulis ulang berhasil\n  %s\n",
+           power_ok ? "OK" : "GAGAL");
+    ok &= power_ok;
+
+    // -- Pemutaran --
+    sg_seq_instance seq;
+    sg_wave_player player;
+    if (!sg_seq_init(&seq, pio0, PIN_BASE, 1) || !sg_wave_player_init(&player, &seq))
+    {
+        fprintf(stderr, "sg_wave: inisialisasi sequencer gagal\n");
+        return 2;
+    }
+    double stream_words_per_s = 0.0;
+    for (uint i = 0; i < DENSE_SPEC; ++i)
+    {
+        const table_spec *spec = &specs[i];
+        play_result r = play(&player, spec, &tables[i], false, spec->words);
+        bool play_ok = r.started && r.finished && r.underruns == 0 && r.edges == spec->words && r.mismatches == 0 &&
+                       r.idle;
+        printf("%-8s %6lu event: %.2f juta event/s (%.1f MB/s), %lu potongan diisi ulang, isi awal %.1f us, "
+               "underrun %lu\n  %s\n",
+               spec->name, (unsigned long)spec->words, r.events_per_s / 1e6, r.events_per_s * 4.0 / 1e6,
+               (unsigned long)r.chunks, r.start_us, (unsigned long)r.underruns, play_ok ? "OK" : "GAGAL");
+        if (!play_ok)
+        {
+            printf("  start %d selesai %d edge %zu beda %zu idle %d\n", r.started, r.finished, r.edges, r.mismatches,
+                   r.idle);
+        }
+        ok &= play_ok;
+        stream_words_per_s = (double)r.start_words / (r.start_us / 1e6);
+    }
+
+    // Loop melewati batas tabel beberapa kali, dihentikan di tengah putaran
+    const table_spec *loop_spec = &specs[3];
+    uint64_t loop_events = (uint64_t)(LOOP_PASSES * loop_spec->words);
+    play_result r = play(&player, loop_spec, &tables[3], true, loop_events);
+    bool loop_ok =
+        r.started && !r.finished && r.underruns == 0 && r.edges >= loop_events && r.mismatches == 0 && r.idle;
+    printf("loop %s %.1f putaran: %zu event sama dengan tabel, stop ke idle\n  %s\n", loop_spec->name, LOOP_PASSES,
+           r.edges, loop_ok ? "OK" : "GAGAL");
+    ok &= loop_ok;
+
+    // Di atas laju stream: underrun harus dihentikan, bukan memutar data basi
+    const table_spec *dense = &specs[DENSE_SPEC];
+    r = play(&player, dense, &tables[DENSE_SPEC], false, dense->words);
+    bool dense_ok = r.started && !r.finished && r.underruns == 1 && r.edges < dense->words && r.mismatches == 0 &&
+                    r.idle;
+    printf("%s (%.2f juta event/s diminta): underrun setelah %zu event, output idle\n  %s\n", dense->name,
+           (double)clock_get_hz(clk_sys) / dense->avg_cycles / 1e6, r.edges, dense_ok ? "OK" : "GAGAL");
+    ok &= dense_ok;
+
+    // Player tetap bisa dipakai setelah underrun
+    r = play(&player, &specs[0], &tables[0], false, specs[0].words);
+    bool again_ok = r.started && r.finished && r.underruns == 0 && r.mismatches == 0;
+    printf("start ulang setelah underrun\n  %s\n", again_ok ? "OK" : "GAGAL");
+    ok &= again_ok;
+    sg_wave_player_deinit(&player);
+    sg_seq_deinit(&seq);
+
+    // Isi awal dua bagian bounce buffer murni dibatasi stream XIP
+    printf("stream XIP (isi awal %u word): %.2f juta word/s = %.1f MB/s, batas rata-rata %.0f siklus per event\n",
+           2 * SG_WAVE_CHUNK_WORDS, stream_words_per_s / 1e6, stream_words_per_s * 4.0 / 1e6,
+           (double)clock_get_hz(clk_sys) / stream_words_per_s);
+
+    uint32_t preset_erases = 0;
+    for (uint32_t offs = SG_PRESET_FLASH_OFFSET; offs < PICO_FLASH_SIZE_BYTES; offs += FLASH_SECTOR_SIZE)
+    {
+        preset_erases += fake_hw_flash_erase_count(offs);
+    }
+    bool safe_ok = fake_hw_flash_unsafe_ops() == 0 && preset_erases == 0;
+    printf("erase/program di luar flash_safe_execute: %lu, erase region preset: %lu\n  %s\n",
+           (unsigned long)fake_hw_flash_unsafe_ops(), (unsigned long)preset_erases, safe_ok ? "OK" : "GAGAL");
+    ok &= safe_ok;
+
+    printf("%s\n", ok ? "OK" : "GAGAL");
+    return ok ? 0 : 1;
+}
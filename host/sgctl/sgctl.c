@@ -0,0 +1,390 @@
+/**
+ * sgctl: library kontrol generator dari Linux (lihat sgctl.h).
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "sgctl.h"
+
+static bool fail(sgctl_device *dev, const char *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(dev->error, sizeof(dev->error), fmt, args);
+    va_end(args);
+    return false;
+}
+
+static uint64_t now_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000u + (uint64_t)ts.tv_nsec / 1000000u;
+}
+
+// -- I/O --
+
+static bool write_all(sgctl_device *dev, const char *data, size_t len)
+{
+    while (len > 0)
+    {
+        ssize_t n = write(dev->fd, data, len);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return fail(dev, "write: %s", strerror(errno));
+        }
+        data += n;
+        len -= (size_t)n;
+    }
+    return true;
+}
+
+/**
+ * @brief Membaca satu baris jawaban tanpa newline (dan tanpa '\r').
+ */
+static bool read_line(sgctl_device *dev, char *line, size_t size)
+{
+    uint64_t deadline = now_ms() + SGCTL_TIMEOUT_MS;
+    while (true)
+    {
+        char *nl = memchr(dev->rx, '\n', dev->rx_len);
+        if (nl)
+        {
+            size_t len = (size_t)(nl - dev->rx);
+            size_t consumed = len + 1;
+            if (len > 0 && dev->rx[len - 1] == '\r')
+            {
+                len--;
+            }
+            if (line)
+            {
+                size_t copy = len < size - 1 ? len : size - 1;
+                memcpy(line, dev->rx, copy);
+                line[copy] = '\0';
+            }
+            memmove(dev->rx, dev->rx + consumed, dev->rx_len - consumed);
+            dev->rx_len -= consumed;
+            return true;
+        }
+        if (dev->rx_len == sizeof(dev->rx))
+        {
+            dev->rx_len = 0;
+            return fail(dev, "jawaban lebih panjang dari %zu byte", sizeof(dev->rx));
+        }
+
+        uint64_t now = now_ms();
+        if (now >= deadline)
+        {
+            return fail(dev, "timeout menunggu jawaban");
+        }
+        struct pollfd pfd = {.fd = dev->fd, .events = POLLIN};
+        int ready = poll(&pfd, 1, (int)(deadline - now));
+        if (ready < 0 && errno != EINTR)
+        {
+            return fail(dev, "poll: %s", strerror(errno));
+        }
+        if (ready <= 0)
+        {
+            continue;
+        }
+        ssize_t n = read(dev->fd, dev->rx + dev->rx_len, sizeof(dev->rx) - dev->rx_len);
+        if (n < 0 && errno != EINTR && errno != EAGAIN)
+        {
+            return fail(dev, "read: %s", strerror(errno));
+        }
+        if (n == 0)
+        {
+            return fail(dev, "device ditutup");
+        }
+        if (n > 0)
+        {
+            dev->rx_len += (size_t)n;
+        }
+    }
+}
+
+/**
+ * @brief Menunggu jawaban baris pipeline tertua.
+ */
+static bool retire_one(sgctl_device *dev)
+{
+    if (!read_line(dev, NULL, 0))
+    {
+        return false;
+    }
+    dev->window -= dev->in_flight[dev->in_flight_first];
+    dev->in_flight_first = (dev->in_flight_first + 1) % SGCTL_MAX_IN_FLIGHT;
+    dev->in_flight_count--;
+    return true;
+}
+
+// -- Koneksi --
+
+/**
+ * @brief Membuka device tty dalam mode raw.
+ *
+ * @param dev Koneksi yang diisi
+ * @param path Misalnya /dev/ttyACM0 atau link pty dari sg_simdev
+ * @return false jika device tidak bisa dibuka
+ */
+bool sgctl_open(sgctl_device *dev, const char *path)
+{
+    memset(dev, 0, sizeof(*dev));
+    dev->fd = open(path, O_RDWR | O_NOCTTY | O_CLOEXEC);
+    if (dev->fd < 0)
+    {
+        return fail(dev, "%s: %s", path, strerror(errno));
+    }
+    struct termios tio;
+    if (tcgetattr(dev->fd, &tio) == 0)
+    {
+        // USB CDC mengabaikan baud rate; raw agar echo dan CR/LF tidak diubah
+        cfmakeraw(&tio);
+        tio.c_cc[VMIN] = 1;
+        tio.c_cc[VTIME] = 0;
+        tcsetattr(dev->fd, TCSANOW, &tio);
+        tcflush(dev->fd, TCIOFLUSH);
+    }
+    return true;
+}
+
+void sgctl_close(sgctl_device *dev)
+{
+    if (dev->fd >= 0)
+    {
+        close(dev->fd);
+    }
+    dev->fd = -1;
+}
+
+// -- Pipeline dan Query --
+
+/**
+ * @brief Mengirim satu baris SCPI tanpa menunggu eksekusinya.
+ *
+ * Baris diberi `;*OPC?`; jawabannya diambil saat jendela penuh atau pada
+ * sgctl_sync(). Error eksekusi masuk antrean error device (sgctl_next_error).
+ *
+ * @param dev Koneksi
+ * @param line Satu baris SCPI tanpa newline, paling panjang SGCTL_LINE_MAX
+ * @return false pada baris terlalu panjang, error I/O atau timeout
+ */
+bool sgctl_submit(sgctl_device *dev, const char *line)
+{
+    char buf[SGCTL_LINE_MAX + 1];
+    int len = snprintf(buf, sizeof(buf), "%s;*OPC?\n", line);
+    if (len < 0 || (size_t)len >= sizeof(buf) || strchr(line, '\n'))
+    {
+        return fail(dev, "baris terlalu panjang atau berisi newline");
+    }
+    while (dev->in_flight_count == SGCTL_MAX_IN_FLIGHT || dev->window + (size_t)len > SGCTL_WINDOW_BYTES)
+    {
+        if (!retire_one(dev))
+        {
+            return false;
+        }
+    }
+    if (!write_all(dev, buf, (size_t)len))
+    {
+        return false;
+    }
+    dev->in_flight[(dev->in_flight_first + dev->in_flight_count) % SGCTL_MAX_IN_FLIGHT] = (size_t)len;
+    dev->in_flight_count++;
+    dev->window += (size_t)len;
+    dev->submitted++;
+    return true;
+}
+
+/**
+ * @brief Menunggu semua baris pipeline selesai dieksekusi device.
+ */
+bool sgctl_sync(sgctl_device *dev)
+{
+    while (dev->in_flight_count > 0)
+    {
+        if (!retire_one(dev))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Mengirim satu baris berisi query dan membaca jawabannya.
+ *
+ * @param dev Koneksi
+ * @param line Baris SCPI dengan paling sedikit satu query
+ * @param response Buffer jawaban (tanpa newline)
+ * @param size Ukuran buffer
+ */
+bool sgctl_query(sgctl_device *dev, const char *line, char *response, size_t size)
+{
+    if (!sgctl_sync(dev))
+    {
+        return false;
+    }
+    size_t len = strlen(line);
+    if (len >= SGCTL_LINE_MAX || memchr(line, '\n', len))
+    {
+        return fail(dev, "baris terlalu panjang atau berisi newline");
+    }
+    return write_all(dev, line, len) && write_all(dev, "\n", 1) && read_line(dev, response, size);
+}
+
+// -- Perintah --
+
+bool sgctl_identify(sgctl_device *dev, char *idn, size_t size)
+{
+    return sgctl_query(dev, "*IDN?", idn, size);
+}
+
+/**
+ * @brief *RST dan *CLS: konfigurasi awal firmware, output mati, antrean error kosong.
+ */
+bool sgctl_reset(sgctl_device *dev)
+{
+    return sgctl_submit(dev, "*RST;*CLS") && sgctl_sync(dev);
+}
+
+/**
+ * @brief Mengirim frekuensi, lebar pulsa dan jeda fasa dalam satu baris.
+ *
+ * Firmware menyerahkan ketiganya ke sg_stage() bersama-sama, jadi set
+ * parameter berlaku utuh di satu batas periode. Tidak menunggu eksekusi.
+ */
+bool sgctl_configure(sgctl_device *dev, const sgctl_config *config)
+{
+    char line[SGCTL_LINE_MAX];
+    snprintf(line, sizeof(line), "FREQ %.9g;:PULS:WIDT %.9g;:PHAS %.9g", config->frequency_hz,
+             config->pulse_width_s, config->phase_shift_s);
+    return sgctl_submit(dev, line);
+}
+
+bool sgctl_set_output(sgctl_device *dev, bool on)
+{
+    return sgctl_submit(dev, on ? "OUTP ON" : "OUTP OFF");
+}
+
+bool sgctl_set_trigger_source(sgctl_device *dev, sgctl_trigger_source source)
+{
+    static const char *const lines[] = {"TRIG:SOUR IMM", "TRIG:SOUR EXT", "TRIG:SOUR BUS"};
+    if ((unsigned)source >= sizeof(lines) / sizeof(lines[0]))
+    {
+        return fail(dev, "sumber trigger tidak dikenal");
+    }
+    return sgctl_submit(dev, lines[source]);
+}
+
+/**
+ * @brief Mengatur jumlah periode per burst, 0 = kontinu (INF).
+ */
+bool sgctl_set_burst(sgctl_device *dev, uint32_t cycles)
+{
+    char line[32];
+    if (cycles == 0)
+    {
+        snprintf(line, sizeof(line), "BURS:NCYC INF");
+    }
+    else
+    {
+        snprintf(line, sizeof(line), "BURS:NCYC %lu", (unsigned long)cycles);
+    }
+    return sgctl_submit(dev, line);
+}
+
+bool sgctl_trigger(sgctl_device *dev)
+{
+    return sgctl_submit(dev, "*TRG");
+}
+
+/**
+ * @brief Membaca konfigurasi, burst, sumber trigger dan output dalam satu query.
+ */
+bool sgctl_read_status(sgctl_device *dev, sgctl_status *status)
+{
+    char response[SGCTL_RESPONSE_MAX];
+    if (!sgctl_query(dev, "FREQ?;:PULS:WIDT?;:PHAS?;:BURS:NCYC?;:TRIG:SOUR?;:OUTP?", response, sizeof(response)))
+    {
+        return false;
+    }
+    char source[8];
+    double cycles;
+    int output;
+    if (sscanf(response, "%lf;%lf;%lf;%lf;%7[A-Z];%d", &status->config.frequency_hz,
+               &status->config.pulse_width_s, &status->config.phase_shift_s, &cycles, source, &output) != 6)
+    {
+        return fail(dev, "jawaban status tidak dikenal: %s", response);
+    }
+    // INF dilaporkan sebagai 9.9E37
+    status->burst_cycles = cycles >= 4294967296.0 ? 0 : (uint32_t)cycles;
+    if (strcmp(source, "IMM") == 0)
+    {
+        status->trigger_source = SGCTL_TRIG_IMMEDIATE;
+    }
+    else if (strcmp(source, "EXT") == 0)
+    {
+        status->trigger_source = SGCTL_TRIG_EXTERNAL;
+    }
+    else if (strcmp(source, "BUS") == 0)
+    {
+        status->trigger_source = SGCTL_TRIG_BUS;
+    }
+    else
+    {
+        return fail(dev, "sumber trigger tidak dikenal: %s", source);
+    }
+    status->output = output != 0;
+    return true;
+}
+
+/**
+ * @brief Mengambil satu error dari antrean device.
+ *
+ * @param code 0 jika antrean kosong
+ * @param message Pesan error (boleh NULL)
+ */
+bool sgctl_next_error(sgctl_device *dev, int *code, char *message, size_t size)
+{
+    char response[SGCTL_RESPONSE_MAX];
+    if (!sgctl_query(dev, "SYST:ERR?", response, sizeof(response)))
+    {
+        return false;
+    }
+    char *comma = strchr(response, ',');
+    if (!comma)
+    {
+        return fail(dev, "jawaban SYST:ERR? tidak dikenal: %s", response);
+    }
+    *code = atoi(response);
+    if (message && size > 0)
+    {
+        // Pesan dikutip: "No error"
+        char *text = comma + 1;
+        size_t len = strlen(text);
+        if (len >= 2 && text[0] == '"' && text[len - 1] == '"')
+        {
+            text++;
+            len -= 2;
+        }
+        size_t copy = len < size - 1 ? len : size - 1;
+        memcpy(message, text, copy);
+        message[copy] = '\0';
+    }
+    return true;
+}
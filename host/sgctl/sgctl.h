@@ -0,0 +1,106 @@
+/**
+ * sgctl: library kontrol generator dari Linux lewat konsol SCPI (signal_scpi).
+ *
+ * Device dibuka sebagai tty (USB CDC /dev/ttyACM*, atau pty dari sg_simdev)
+ * dalam mode raw. Dua cara mengirim:
+ *
+ *   - sgctl_submit(): pipeline. Setiap baris diberi `;*OPC?` sehingga device
+ *     selalu menjawab tepat satu baris; library tidak menunggu jawaban itu
+ *     kecuali byte yang belum dijawab akan melewati SGCTL_WINDOW_BYTES.
+ *     Jendela ini lebih kecil dari ring buffer firmware (SG_SCPI_RING_SIZE),
+ *     jadi device tidak pernah membuang byte (Input buffer overrun) walaupun
+ *     ratusan set parameter dikirim per detik.
+ *   - sgctl_query(): menunggu pipeline kosong, lalu satu query dan jawabannya.
+ *
+ * Fungsi tingkat tinggi (konfigurasi, output, trigger, burst, status) hanya
+ * menyusun baris SCPI. Protokol firmware belum punya perintah tabel event;
+ * aliran parameter (sgctl stream) mengirim set parameter berurutan lewat
+ * pipeline dan baris SCPI lain bisa dikirim mentah.
+ *
+ * Semua fungsi yang mengembalikan bool memberi false pada error I/O atau
+ * timeout (SGCTL_TIMEOUT_MS); pesannya ada di sgctl_device.error.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef SGCTL_H
+#define SGCTL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define SGCTL_WINDOW_BYTES 192 // < SG_SCPI_RING_SIZE firmware
+#define SGCTL_MAX_IN_FLIGHT 32
+#define SGCTL_LINE_MAX 120     // < SG_SCPI_LINE_MAX firmware, termasuk ";*OPC?"
+#define SGCTL_RESPONSE_MAX 256
+#define SGCTL_TIMEOUT_MS 2000
+
+/**
+ * @brief Sumber trigger burst (TRIG:SOUR).
+ */
+typedef enum
+{
+    SGCTL_TRIG_IMMEDIATE = 0,
+    SGCTL_TRIG_EXTERNAL,
+    SGCTL_TRIG_BUS,
+} sgctl_trigger_source;
+
+/**
+ * @brief Parameter sinyal dalam satuan SI.
+ */
+typedef struct
+{
+    double frequency_hz;
+    double pulse_width_s;
+    double phase_shift_s;
+} sgctl_config;
+
+/**
+ * @brief Status device dari satu query gabungan.
+ */
+typedef struct
+{
+    sgctl_config config;
+    uint32_t burst_cycles; // 0 = kontinu
+    sgctl_trigger_source trigger_source;
+    bool output;
+} sgctl_status;
+
+/**
+ * @brief Koneksi ke satu device.
+ */
+typedef struct
+{
+    int fd;
+    char rx[SGCTL_RESPONSE_MAX * 2]; // Byte diterima yang belum membentuk baris
+    size_t rx_len;
+    size_t in_flight[SGCTL_MAX_IN_FLIGHT]; // Panjang baris yang belum dijawab (FIFO)
+    unsigned in_flight_first;
+    unsigned in_flight_count;
+    size_t window;                   // Jumlah byte yang belum dijawab
+    uint64_t submitted;              // Baris yang dikirim lewat pipeline
+    char error[128];
+} sgctl_device;
+
+// -- Koneksi --
+bool sgctl_open(sgctl_device *dev, const char *path);
+void sgctl_close(sgctl_device *dev);
+
+// -- Pipeline dan Query --
+bool sgctl_submit(sgctl_device *dev, const char *line);
+bool sgctl_sync(sgctl_device *dev);
+bool sgctl_query(sgctl_device *dev, const char *line, char *response, size_t size);
+
+// -- Perintah --
+bool sgctl_identify(sgctl_device *dev, char *idn, size_t size);
+bool sgctl_reset(sgctl_device *dev);
+bool sgctl_configure(sgctl_device *dev, const sgctl_config *config);
+bool sgctl_set_output(sgctl_device *dev, bool on);
+bool sgctl_set_trigger_source(sgctl_device *dev, sgctl_trigger_source source);
+bool sgctl_set_burst(sgctl_device *dev, uint32_t cycles);
+bool sgctl_trigger(sgctl_device *dev);
+bool sgctl_read_status(sgctl_device *dev, sgctl_status *status);
+bool sgctl_next_error(sgctl_device *dev, int *code, char *message, size_t size);
+
+#endif
@@ -0,0 +1,308 @@
+/**
+ * sgctl: CLI kontrol generator dari Linux di atas library sgctl.
+ *
+ * Pemakaian: sgctl [-d <device>] <perintah> [argumen]
+ *
+ *   idn                              identitas device (*IDN?)
+ *   status                           konfigurasi, burst, trigger dan output
+ *   reset                            *RST dan *CLS
+ *   config <Hz> <lebar s> <fasa s>   satu set parameter, berlaku di batas periode
+ *   output on|off
+ *   source imm|ext|bus               sumber trigger burst
+ *   burst <n>|inf                    periode per burst
+ *   trigger                          *TRG (sumber bus)
+ *   send "<baris scpi>"              baris mentah; jawaban query dicetak
+ *   stream <file>|-                  set parameter per baris (Hz lebar fasa,
+ *                                    '#' = komentar) lewat pipeline, laju dicetak
+ *   errors                           mengosongkan antrean error
+ *
+ * Device default: $SGCTL_DEVICE, lalu /dev/ttyACM0. Setelah perintah set,
+ * antrean error device dibaca; exit 1 jika ada error.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+
+#include "sgctl.h"
+
+static void usage(const char *argv0)
+{
+    fprintf(stderr,
+            "pemakaian: %s [-d <device>] idn|status|reset|errors|trigger\n"
+            "       %s [-d <device>] config <Hz> <lebar s> <fasa s>\n"
+            "       %s [-d <device>] output on|off | source imm|ext|bus | burst <n>|inf\n"
+            "       %s [-d <device>] send \"<baris scpi>\" | stream <file>|-\n",
+            argv0, argv0, argv0, argv0);
+}
+
+static double wall_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static bool parse_double(const char *text, double *value)
+{
+    char *end;
+    *value = strtod(text, &end);
+    return end != text && *end == '\0';
+}
+
+/**
+ * @brief Mencetak dan mengosongkan antrean error device.
+ *
+ * @return Jumlah error, -1 jika gagal membaca
+ */
+static int drain_errors(sgctl_device *dev)
+{
+    int count = 0;
+    while (true)
+    {
+        int code;
+        char message[96];
+        if (!sgctl_next_error(dev, &code, message, sizeof(message)))
+        {
+            return -1;
+        }
+        if (code == 0)
+        {
+            return count;
+        }
+        fprintf(stderr, "error %d: %s\n", code, message);
+        count++;
+    }
+}
+
+static int print_status(sgctl_device *dev)
+{
+    static const char *const sources[] = {"imm", "ext", "bus"};
+    sgctl_status status;
+    if (!sgctl_read_status(dev, &status))
+    {
+        return -1;
+    }
+    printf("frekuensi   %.7g Hz\n", status.config.frequency_hz);
+    printf("lebar pulsa %.7g us\n", status.config.pulse_width_s * 1e6);
+    printf("jeda fasa   %.7g us\n", status.config.phase_shift_s * 1e6);
+    if (status.burst_cycles == 0)
+    {
+        printf("burst       kontinu\n");
+    }
+    else
+    {
+        printf("burst       %lu periode\n", (unsigned long)status.burst_cycles);
+    }
+    printf("trigger     %s\n", sources[status.trigger_source]);
+    printf("output      %s\n", status.output ? "on" : "off");
+    return 0;
+}
+
+/**
+ * @brief Mengirim set parameter dari file lewat pipeline dan mencetak lajunya.
+ */
+static int stream_file(sgctl_device *dev, const char *path)
+{
+    FILE *in = strcmp(path, "-") == 0 ? stdin : fopen(path, "r");
+    if (!in)
+    {
+        perror(path);
+        return -1;
+    }
+    char text[256];
+    unsigned long line_number = 0;
+    unsigned long sets = 0;
+    double start = wall_s();
+    int result = 0;
+    while (fgets(text, sizeof(text), in))
+    {
+        line_number++;
+        char *comment = strchr(text, '#');
+        if (comment)
+        {
+            *comment = '\0';
+        }
+        sgctl_config config;
+        char extra;
+        int fields = sscanf(text, "%lf %lf %lf %c", &config.frequency_hz, &config.pulse_width_s,
+                            &config.phase_shift_s, &extra);
+        if (fields <= 0)
+        {
+            continue;
+        }
+        if (fields != 3)
+        {
+            fprintf(stderr, "%s:%lu: butuh <Hz> <lebar s> <fasa s>\n", path, line_number);
+            result = -1;
+            break;
+        }
+        if (!sgctl_configure(dev, &config))
+        {
+            result = -1;
+            break;
+        }
+        sets++;
+    }
+    if (in != stdin)
+    {
+        fclose(in);
+    }
+    if (result == 0 && !sgctl_sync(dev))
+    {
+        return -1;
+    }
+    double elapsed = wall_s() - start;
+    printf("%lu set parameter dalam %.3f s (%.0f set/s)\n", sets, elapsed, elapsed > 0 ? sets / elapsed : 0.0);
+    return result;
+}
+
+int main(int argc, char **argv)
+{
+    const char *path = getenv("SGCTL_DEVICE");
+    if (!path)
+    {
+        path = "/dev/ttyACM0";
+    }
+    int arg = 1;
+    if (arg + 1 < argc && strcmp(argv[arg], "-d") == 0)
+    {
+        path = argv[arg + 1];
+        arg += 2;
+    }
+    if (arg >= argc)
+    {
+        usage(argv[0]);
+        return 2;
+    }
+    const char *cmd = argv[arg++];
+    int nargs = argc - arg;
+    char **args = &argv[arg];
+
+    sgctl_device dev;
+    if (!sgctl_open(&dev, path))
+    {
+        fprintf(stderr, "sgctl: %s\n", dev.error);
+        return 1;
+    }
+
+    // Perintah set: -1 = gagal, 0 = terkirim (error device dibaca setelahnya)
+    int result;
+    bool check_errors = true;
+    if (strcmp(cmd, "idn") == 0 && nargs == 0)
+    {
+        char idn[SGCTL_RESPONSE_MAX];
+        result = sgctl_identify(&dev, idn, sizeof(idn)) ? 0 : -1;
+        if (result == 0)
+        {
+            printf("%s\n", idn);
+        }
+    }
+    else if (strcmp(cmd, "status") == 0 && nargs == 0)
+    {
+        result = print_status(&dev);
+    }
+    else if (strcmp(cmd, "reset") == 0 && nargs == 0)
+    {
+        result = sgctl_reset(&dev) ? 0 : -1;
+    }
+    else if (strcmp(cmd, "errors") == 0 && nargs == 0)
+    {
+        int count = drain_errors(&dev);
+        result = count < 0 ? -1 : 0;
+        if (count == 0)
+        {
+            printf("tidak ada error\n");
+        }
+        check_errors = false;
+    }
+    else if (strcmp(cmd, "trigger") == 0 && nargs == 0)
+    {
+        result = sgctl_trigger(&dev) ? 0 : -1;
+    }
+    else if (strcmp(cmd, "config") == 0 && nargs == 3)
+    {
+        sgctl_config config;
+        if (!parse_double(args[0], &config.frequency_hz) || !parse_double(args[1], &config.pulse_width_s) ||
+            !parse_double(args[2], &config.phase_shift_s))
+        {
+            usage(argv[0]);
+            return 2;
+        }
+        result = sgctl_configure(&dev, &config) ? 0 : -1;
+    }
+    else if (strcmp(cmd, "output") == 0 && nargs == 1 &&
+             (strcasecmp(args[0], "on") == 0 || strcasecmp(args[0], "off") == 0))
+    {
+        result = sgctl_set_output(&dev, strcasecmp(args[0], "on") == 0) ? 0 : -1;
+    }
+    else if (strcmp(cmd, "source") == 0 && nargs == 1)
+    {
+        static const char *const names[] = {"imm", "ext", "bus"};
+        result = -2;
+        for (int i = 0; i < 3; ++i)
+        {
+            if (strcasecmp(args[0], names[i]) == 0)
+            {
+                result = sgctl_set_trigger_source(&dev, (sgctl_trigger_source)i) ? 0 : -1;
+            }
+        }
+    }
+    else if (strcmp(cmd, "burst") == 0 && nargs == 1)
+    {
+        char *end;
+        unsigned long cycles = strcasecmp(args[0], "inf") == 0 ? 0 : strtoul(args[0], &end, 0);
+        result = cycles == 0 && strcasecmp(args[0], "inf") != 0 ? -2 : (sgctl_set_burst(&dev, cycles) ? 0 : -1);
+    }
+    else if (strcmp(cmd, "send") == 0 && nargs == 1)
+    {
+        // Query dikenali dari '?'; baris tanpa query lewat pipeline
+        if (strchr(args[0], '?'))
+        {
+            char response[SGCTL_RESPONSE_MAX];
+            result = sgctl_query(&dev, args[0], response, sizeof(response)) ? 0 : -1;
+            if (result == 0)
+            {
+                printf("%s\n", response);
+            }
+        }
+        else
+        {
+            result = sgctl_submit(&dev, args[0]) ? 0 : -1;
+        }
+    }
+    else if (strcmp(cmd, "stream") == 0 && nargs == 1)
+    {
+        result = stream_file(&dev, args[0]);
+    }
+    else
+    {
+        result = -2;
+    }
+
+    if (result == -2)
+    {
+        sgctl_close(&dev);
+        usage(argv[0]);
+        return 2;
+    }
+    if (result == 0 && check_errors)
+    {
+        int count = sgctl_sync(&dev) ? drain_errors(&dev) : -1;
+        result = count == 0 ? 0 : -1;
+        if (count < 0)
+        {
+            fprintf(stderr, "sgctl: %s\n", dev.error);
+        }
+    }
+    else if (result < 0 && dev.error[0])
+    {
+        fprintf(stderr, "sgctl: %s\n", dev.error);
+    }
+    sgctl_close(&dev);
+    return result == 0 ? 0 : 1;
+}
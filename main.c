@@ -4,72 +4,352 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <stdio.h>
 #include "pico/stdlib.h"
-#include "hardware/pio.h"
 #include "hardware/clocks.h"
-#include "signal_generator.pio.h" // Header yang di-generate otomatis
+#include "hardware/sync.h"
+#include "signal_gen.h"
+#include "signal_count.h"
+#include "signal_burst.h"
+#include "signal_fault.h"
+#include "signal_sync.h"
+#include "signal_discipline.h"
+#include "signal_i2c.h"
+#include "signal_spi.h"
+#include "signal_scpi.h"
+#include "signal_vco.h"
 
 // -- Konfigurasi Sinyal --
 const uint PIN_CH1_BASE = 6;
 const float FREQUENCY_HZ = 1000.0f;
 const float PULSE_WIDTH_US = 5.0f;
 const float PHASE_SHIFT_US = 5.0f;
+// Tentukan clock divider untuk PIO agar 1 siklus = 0.1 us
+// Ini memberikan resolusi yang baik dan menjaga nilai delay dalam rentang wajar
+const float PIO_CLK_DIV = 12.5f;
 
 // -- Konfigurasi Tombol --
 const uint BUTTON_PIN = 13;
 const uint64_t SIGNAL_DURATION_US = 5 * 1000 * 1000; // 5 detik
 
+// -- Konfigurasi Trigger Hardware --
+// Jika aktif, tombol langsung memicu state machine (sg_arm) sehingga edge
+// pertama muncul tepat TRIGGER_DELAY_NS setelah tombol ditekan, tanpa
+// bergantung pada polling CPU. Mode ini tidak memakai idle hemat daya karena
+// clk_sys harus tetap pada frekuensi kerja selama menunggu trigger.
+const bool HARDWARE_TRIGGER = false;
+const uint64_t TRIGGER_DELAY_NS = 0;
+
+// -- Konfigurasi Mode Burst PIO --
+// Jika aktif, semantik tombol diputuskan seluruhnya oleh PIO (signal_burst):
+// gated, N-siklus, one-shot retriggerable atau kontinu. N periode diambil
+// dari SIGNAL_DURATION_US, dan CPU hanya melaporkan jumlah periode.
+const bool PIO_BURST_MODE = false;
+const sg_burst_mode BURST_MODE = SG_BURST_RETRIGGER;
+
+// -- Konfigurasi Sinkronisasi Multi-Board --
+// Jika aktif, master memulai burst dari tombol dan mengeluarkan pulsa sync di
+// SYNC_PIN setiap periode (opsional clock referensi di REF_CLOCK_GPIO);
+// slave memulai dan menyelaraskan periodenya dari edge sync lewat PIO.
+const bool MULTI_BOARD_SYNC = false;
+const sg_sync_role SYNC_ROLE = SG_SYNC_MASTER;
+const uint SYNC_PIN = 15;
+const int REF_CLOCK_GPIO = 21; // -1 = tanpa clock referensi
+const float REF_CLOCK_DIV = 10.0f;
+
+// -- Konfigurasi Disiplin Referensi --
+// Jika aktif, clk_sys diukur terhadap referensi eksternal di REF_PIN (1 PPS
+// atau 10 MHz) oleh state machine di pio1. Di antara burst estimasinya
+// diterapkan ke generator (sg_trim_clock) dan dilaporkan lewat USB.
+const bool REF_DISCIPLINE = false;
+const uint REF_PIN = 20;
+const float REF_FREQUENCY_HZ = 1.0f;   // 1 PPS; 10e6f untuk 10 MHz
+const uint32_t REF_EDGES_PER_GATE = 1; // 10000000 untuk 10 MHz (gerbang 1 detik)
+
+// -- Konfigurasi Start Terjadwal --
+// Jika aktif, burst dimulai sendiri pada SCHEDULED_START_US (us sejak boot)
+// lalu setiap SCHEDULE_INTERVAL_US, tanpa tombol: hardware alarm melepas state
+// machine yang sudah terisi. Dengan SCHEDULE_ON_PPS, alarm hanya meng-arm dan
+// burst dimulai tepat pada edge naik PPS berikutnya di REF_PIN; pilih waktu
+// alarm saat PPS LOW (mis. setengah detik sebelum detik yang diinginkan).
+const bool SCHEDULED_START = false;
+const uint64_t SCHEDULED_START_US = 3 * 1000 * 1000;
+const uint64_t SCHEDULE_INTERVAL_US = 10 * 1000 * 1000; // 0 = sekali saja
+const bool SCHEDULE_ON_PPS = false;
+
+// -- Konfigurasi Kontrol I2C --
+// Jika aktif, MCU host mengontrol generator lewat register map I2C target
+// (signal_i2c.h) di i2c0: start/stop/arm, konfigurasi yang di-commit utuh di
+// batas periode, status dan penghitung periode. Tombol menjadi trigger
+// CONTROL.ARM dan loop utama hanya melayani sg_i2c_poll().
+const bool I2C_CONTROL = false;
+const uint8_t I2C_ADDRESS = 0x42;
+const uint I2C_SDA_PIN = 4;
+const uint I2C_SCL_PIN = 5;
+
+// -- Konfigurasi Kontrol SPI --
+// Jika aktif, controller eksternal mengirim frame delay (signal_spi.h) lewat
+// SPI mode 0 ke state machine penerima di pio1; frame disalin DMA langsung
+// ke generator dan berlaku utuh mulai batas periode berikutnya yang belum
+// diantrekan. Loop utama hanya melaporkan frame yang diterima/ditolak.
+const bool SPI_CONTROL = false;
+const uint SPI_MOSI_PIN = 16; // SCK = 17, CS = 18
+
+// -- Konfigurasi Kontrol SCPI --
+// Jika aktif, rak pengujian mengontrol generator dengan perintah SCPI di
+// konsol USB CDC (signal_scpi.h): FREQ/PULS:WIDT/PHAS menggantikan konstanta
+// sinyal di atas, BURS:NCYC menggantikan SIGNAL_DURATION_US, TRIG:SOUR EXT
+// memakai tombol sebagai trigger dan OUTP ON|OFF menjalankan generator.
+// *SAV/*RCL menyimpan konfigurasi ke flash (signal_preset.h); preset
+// power-on (MEM:STAT:REC:AUTO) dipanggil saat boot sebelum USB diinisialisasi
+// sehingga output muncul tanpa menunggu enumerasi. Opsi CMake
+// SIGNAL_GENERATOR_SCPI_CONTROL mengaktifkannya tanpa mengubah file ini.
+#ifndef SIGNAL_GENERATOR_SCPI_CONTROL
+#define SIGNAL_GENERATOR_SCPI_CONTROL false
+#endif
+const bool SCPI_CONTROL = SIGNAL_GENERATOR_SCPI_CONTROL;
+
+// -- Konfigurasi Mode VCO --
+// Jika aktif, tegangan 0..3,3 V di GPIO 26 + VCO_ADC_INPUT mengatur frekuensi
+// antara VCO_F_MIN_HZ dan VCO_F_MAX_HZ secara real time (signal_vco.h): event
+// D diperbarui setiap periode, lebar pulsa dan jeda tetap dari konfigurasi
+// sinyal di atas. Tombol tidak dipakai; output berjalan sejak boot.
+const bool VCO_MODE = false;
+const uint VCO_ADC_INPUT = 0;
+const float VCO_F_MIN_HZ = 100.0f;
+const float VCO_F_MAX_HZ = 10000.0f;
+const sg_vco_curve VCO_CURVE = SG_VCO_EXPONENTIAL;
+const uint32_t VCO_SAMPLE_RATE_HZ = 500000;
+
+// -- Konfigurasi Input Fault --
+// Jika aktif, state machine watchdog menarik semua output LOW beberapa
+// nanodetik setelah FAULT_PIN aktif (misalnya komparator overcurrent) dan
+// menahannya sampai tombol ditekan lagi setelah fault hilang.
+const bool FAULT_INPUT = false;
+const uint FAULT_PIN = 14;
+const bool FAULT_ACTIVE_HIGH = true;
+
+// -- Konfigurasi Penghitung Periode --
+// Satu interrupt DMA (dan latch waktu) per detik pada 1 kHz
+const uint32_t COUNT_INTERVAL_PERIODS = 1000;
+
+// -- Konfigurasi Mode Idle Hemat Daya --
+// Di antara burst, core 0 tidur di __wfi() dan clk_sys diturunkan ke 48 MHz
+// (diambil dari PLL USB sehingga PLL sys bisa dimatikan). Tombol dipakai
+// sebagai sumber wake melalui interrupt GPIO.
+const bool LOW_POWER_IDLE = !HARDWARE_TRIGGER && !PIO_BURST_MODE && !MULTI_BOARD_SYNC && !REF_DISCIPLINE &&
+                             !SCHEDULED_START && !I2C_CONTROL && !SPI_CONTROL && !SCPI_CONTROL &&
+                             !VCO_MODE;
+
+// -- Status Wake (diisi oleh interrupt tombol) --
+static volatile bool button_wake = false;
+static volatile uint64_t wake_time_us = 0;
+
+// -- Instance Firmware --
+// Di luar stack main() agar build host bisa melepasnya (firmware_release())
+// sebelum menjalankan main() lagi setelah reset simulasi
+static sg_instance gen;
+static sg_fault_instance fault;
+static sg_count_instance counter;
+
 // -- Deklarasi Fungsi --
-void init_pio(PIO pio, uint *sm, uint *offset, float clk_div);
-void calculate_delays(float sys_clk_hz, float pio_clk_div,
-                      uint32_t *delay_A, uint32_t *delay_B,
-                      uint32_t *delay_C, uint32_t *delay_D);
+void button_irq_callback(uint gpio, uint32_t events);
+void enter_idle(void);
+uint64_t restore_run_clocks(sg_instance *gen, uint32_t run_sys_clk_khz);
+void run_pio_burst_mode(const sg_timing_config *timing);
+void run_sync_mode(const sg_timing_config *timing);
+void run_i2c_mode(sg_instance *gen, const sg_count_instance *counter);
+void run_spi_mode(sg_instance *gen, const sg_count_instance *counter);
+void run_scpi_mode(sg_instance *gen, sg_count_instance *counter);
+void run_vco_mode(sg_instance *gen);
+void firmware_release(void);
 
 int main()
 {
-    stdio_init_all();
+    // Mode SCPI menginisialisasi stdio sendiri setelah output preset berjalan
+    if (!SCPI_CONTROL)
+    {
+        stdio_init_all();
+    }
+
+    // -- Inisialisasi Input Fault (watchdog diaktifkan setelah generator) --
+    if (FAULT_INPUT)
+    {
+        gpio_init(FAULT_PIN);
+        gpio_set_dir(FAULT_PIN, GPIO_IN);
+    }
 
     // -- Inisialisasi Tombol --
     gpio_init(BUTTON_PIN);
     gpio_set_dir(BUTTON_PIN, GPIO_IN);
     gpio_pull_up(BUTTON_PIN); // Tombol terhubung ke ground, jadi butuh pull-up
+    if (LOW_POWER_IDLE)
+    {
+        gpio_set_irq_enabled_with_callback(BUTTON_PIN, GPIO_IRQ_EDGE_FALL, true, &button_irq_callback);
+    }
+
+    // -- Inisialisasi Generator --
+    const sg_timing_config timing = {
+        .frequency_hz = FREQUENCY_HZ,
+        .pulse_width_us = PULSE_WIDTH_US,
+        .phase_shift_us = PHASE_SHIFT_US,
+        .pio_clk_div = PIO_CLK_DIV,
+        .trigger_delay_ns = TRIGGER_DELAY_NS,
+    };
+    if (PIO_BURST_MODE)
+    {
+        run_pio_burst_mode(&timing);
+    }
+    if (MULTI_BOARD_SYNC)
+    {
+        run_sync_mode(&timing);
+    }
+    if (!sg_init(&gen, pio0, PIN_CH1_BASE) || !sg_configure(&gen, &timing))
+    {
+        panic("signal_gen: konfigurasi tidak valid");
+    }
+    if (FAULT_INPUT &&
+        !sg_fault_init(&fault, pio0, PIN_CH1_BASE, FAULT_PIN, FAULT_ACTIVE_HIGH, 1u << gen.sm, NULL, NULL))
+    {
+        panic("signal_fault: tidak ada state machine watchdog");
+    }
 
-    // -- Inisialisasi PIO --
-    PIO pio = pio0;
-    uint sm, offset;
-    // Tentukan clock divider untuk PIO agar 1 siklus = 0.1 us
-    // Ini memberikan resolusi yang baik dan menjaga nilai delay dalam rentang wajar
-    float pio_clk_div = 12.5f;
-    init_pio(pio, &sm, &offset, pio_clk_div);
+    // -- Inisialisasi Penghitung Periode --
+    sg_count_init(&counter);
+    if (!sg_count_start(&counter, &gen, COUNT_INTERVAL_PERIODS, NULL, NULL))
+    {
+        panic("signal_count: tidak ada channel DMA");
+    }
+    if (I2C_CONTROL)
+    {
+        run_i2c_mode(&gen, &counter);
+    }
+    if (SPI_CONTROL)
+    {
+        run_spi_mode(&gen, &counter);
+    }
+    if (SCPI_CONTROL)
+    {
+        run_scpi_mode(&gen, &counter);
+    }
+    if (VCO_MODE)
+    {
+        run_vco_mode(&gen);
+    }
 
-    // -- Kalkulasi Durasi Delay --
-    uint32_t delay_A, delay_B, delay_C, delay_D;
-    calculate_delays(clock_get_hz(clk_sys), pio_clk_div, &delay_A, &delay_B, &delay_C, &delay_D);
+    // -- Inisialisasi Disiplin Referensi --
+    sg_discipline_instance discipline;
+    if (REF_DISCIPLINE || SCHEDULE_ON_PPS)
+    {
+        gpio_init(REF_PIN);
+        gpio_set_dir(REF_PIN, GPIO_IN);
+    }
+    if (REF_DISCIPLINE)
+    {
+        if (!sg_discipline_init(&discipline, pio1, REF_PIN, REF_FREQUENCY_HZ, REF_EDGES_PER_GATE))
+        {
+            panic("signal_discipline: konfigurasi referensi tidak valid");
+        }
+        sg_discipline_start(&discipline);
+    }
+
+    // Simpan clk_sys saat berjalan agar bisa dipulihkan persis setelah wake
+    uint32_t run_sys_clk_khz = clock_get_hz(clk_sys) / 1000;
+    uint64_t next_start_us = SCHEDULED_START_US;
 
     // Loop utama untuk menunggu penekanan tombol
     while (true)
     {
-        // Tunggu tombol ditekan (pin menjadi LOW)
-        if (!gpio_get(BUTTON_PIN))
+        uint64_t clock_restore_us = 0;
+        if (LOW_POWER_IDLE)
+        {
+            // Tidur sampai tombol ditekan, lalu kembalikan clock ke kondisi semula
+            enter_idle();
+            clock_restore_us = restore_run_clocks(&gen, run_sys_clk_khz);
+        }
+
+        // Estimasi referensi terbaru berlaku mulai burst berikutnya
+        if (REF_DISCIPLINE && sg_discipline_poll(&discipline))
+        {
+            if (discipline.state != SG_DISCIPLINE_NO_REF)
+            {
+                sg_trim_clock(&gen, discipline.ppm);
+            }
+            printf("discipline: %s, clk_sys %+.4f ppm (resolusi %.1f ppb), gerbang %lu, ditolak %lu\n",
+                   sg_discipline_state_name(discipline.state), discipline.ppm, discipline.resolution_ppb,
+                   (unsigned long)discipline.gates, (unsigned long)discipline.rejected);
+        }
+
+        // Fault ter-latch: tombol melepas latch hanya jika input fault sudah tidak aktif
+        if (FAULT_INPUT && sg_fault_is_latched(&fault) && !gpio_get(BUTTON_PIN))
+        {
+            bool cleared = sg_fault_clear(&fault);
+            printf("fault: latch %s\n", cleared ? "dilepas" : "dipertahankan, input fault masih aktif");
+            while (!gpio_get(BUTTON_PIN))
+            {
+                tight_loop_contents();
+            }
+            continue;
+        }
+
+        // Mode trigger hardware: state machine menunggu tombol sendiri; arm
+        // gagal selama tombol masih ditekan sejak burst sebelumnya
+        bool triggered = HARDWARE_TRIGGER && sg_arm(&gen, BUTTON_PIN, false);
+
+        // Mode start terjadwal: state machine dilepas oleh alarm (atau PPS)
+        bool scheduled = false;
+        if (SCHEDULED_START && next_start_us != 0)
         {
+            absolute_time_t when = from_us_since_boot(next_start_us);
+            scheduled = SCHEDULE_ON_PPS ? sg_schedule_pps(&gen, when, REF_PIN) : sg_schedule(&gen, when);
+            if (!scheduled)
+            {
+                printf("schedule: target %llu us terlewat\n", (unsigned long long)next_start_us);
+            }
+            next_start_us = SCHEDULE_INTERVAL_US ? next_start_us + SCHEDULE_INTERVAL_US : 0;
+        }
 
-            // Aktifkan State Machine PIO untuk memulai pembangkitan sinyal
-            pio_sm_set_enabled(pio, sm, true);
+        // Tunggu tombol ditekan (pin menjadi LOW)
+        if (scheduled || triggered || (!HARDWARE_TRIGGER && !SCHEDULED_START && !gpio_get(BUTTON_PIN)))
+        {
+            // Jalankan burst selama 5 detik (loop ini berjalan dari SRAM)
+            uint64_t periods_before = sg_count_periods(&counter);
+            absolute_time_t start_time = (scheduled || triggered) ? sg_run_armed_burst(&gen, SIGNAL_DURATION_US)
+                                                                  : sg_run_burst(&gen, SIGNAL_DURATION_US);
 
-            // Catat waktu mulai
-            absolute_time_t start_time = get_absolute_time();
+            // -- Laporan Burst --
+            if (LOW_POWER_IDLE)
+            {
+                // Edge pertama = waktu enable + SG_START_LATENCY_CYCLES siklus PIO
+                float first_edge_offset_us = sg_cycles_to_us(&gen, SG_START_LATENCY_CYCLES);
+                int64_t wake_to_enable_us = absolute_time_diff_us(from_us_since_boot(wake_time_us), start_time);
+                printf("burst: sysclk=%lu Hz, clkdiv=%.3f, clock restore=%llu us, wake->first edge=%.2f us\n",
+                       (unsigned long)gen.sys_clk_hz, gen.timing.pio_clk_div, (unsigned long long)clock_restore_us,
+                       (float)wake_to_enable_us + first_edge_offset_us);
+            }
 
-            // Loop untuk memberi data delay ke PIO selama 5 detik
-            while (absolute_time_diff_us(start_time, get_absolute_time()) < SIGNAL_DURATION_US)
+            if (scheduled && is_nil_time(start_time))
             {
-                pio_sm_put_blocking(pio, sm, delay_A);
-                pio_sm_put_blocking(pio, sm, delay_B);
-                pio_sm_put_blocking(pio, sm, delay_C);
-                pio_sm_put_blocking(pio, sm, delay_D);
+                printf("schedule: dibatalkan, PPS HIGH saat alarm %llu us\n", (unsigned long long)gen.scheduled_us);
+            }
+            else if (scheduled)
+            {
+                printf("schedule: alarm %llu us, handler terlambat %ld us, start terdeteksi CPU %llu us\n",
+                       (unsigned long long)gen.scheduled_us, (long)gen.start_late_us,
+                       (unsigned long long)to_us_since_boot(start_time));
             }
 
-            // Nonaktifkan State Machine PIO untuk menghentikan sinyal
-            pio_sm_set_enabled(pio, sm, false);
+            // Jumlah periode yang benar-benar keluar, dihitung oleh DMA
+            uint64_t periods_total = sg_count_periods(&counter);
+            uint64_t latch_periods = 0, latch_time_us = 0;
+            sg_count_last_latch(&counter, &latch_periods, &latch_time_us);
+            printf("periods: burst=%llu total=%llu, latch=%llu @ %llu us\n",
+                   (unsigned long long)(periods_total - periods_before), (unsigned long long)periods_total,
+                   (unsigned long long)latch_periods, (unsigned long long)latch_time_us);
+            if (FAULT_INPUT && sg_fault_is_latched(&fault))
+            {
+                printf("fault: output ditahan LOW sejak %llu us\n", (unsigned long long)fault.trip_time_us);
+            }
 
             // Tunggu hingga tombol dilepas untuk menghindari pemicuan berulang
             while (!gpio_get(BUTTON_PIN))
@@ -83,65 +363,378 @@ int main()
 }
 
 /**
- * @brief Menghitung nilai delay untuk setiap event dalam satuan siklus PIO.
- * * @param sys_clk_hz Frekuensi clock sistem (Hz)
- * @param pio_clk_div Clock divider yang dikonfigurasi untuk PIO SM
- * @param delay_A Pointer untuk menyimpan delay event A
- * @param delay_B Pointer untuk menyimpan delay event B
- * @param delay_C Pointer untuk menyimpan delay event C
- * @param delay_D Pointer untuk menyimpan delay event D
+ * @brief Callback interrupt GPIO untuk tombol, dipakai sebagai sumber wake.
+ *
+ * @param gpio Nomor pin yang memicu interrupt
+ * @param events Jenis event GPIO yang terjadi
+ */
+void button_irq_callback(uint gpio, uint32_t events)
+{
+    if (gpio == BUTTON_PIN && (events & GPIO_IRQ_EDGE_FALL))
+    {
+        wake_time_us = time_us_64();
+        button_wake = true;
+    }
+}
+
+/**
+ * @brief Menurunkan clock sistem dan menidurkan core 0 sampai tombol ditekan.
+ *
+ * clk_sys dipindah ke PLL USB (48 MHz) dan PLL sys dimatikan. Pengecekan flag
+ * dilakukan dengan interrupt dimatikan sehingga tidak ada wake yang terlewat;
+ * __wfi() tetap bangun oleh interrupt yang pending walaupun PRIMASK aktif.
  */
-void calculate_delays(float sys_clk_hz, float pio_clk_div,
-                      uint32_t *delay_A, uint32_t *delay_B,
-                      uint32_t *delay_C, uint32_t *delay_D)
+void enter_idle(void)
 {
-    float pio_clk_hz = sys_clk_hz / pio_clk_div;
-    float period_s = 1.0f / FREQUENCY_HZ;
-    uint32_t total_pio_cycles = (uint32_t)(period_s * pio_clk_hz);
-    uint32_t pulse_width_cycles = (uint32_t)(PULSE_WIDTH_US * 1e-6f * pio_clk_hz);
-    uint32_t phase_shift_cycles = (uint32_t)(PHASE_SHIFT_US * 1e-6f * pio_clk_hz);
-
-    // Durasi setiap event dalam siklus PIO
-    uint32_t event_A_duration = pulse_width_cycles;
-    uint32_t event_B_duration = phase_shift_cycles;
-    uint32_t event_C_duration = pulse_width_cycles;
-    uint32_t event_D_duration = total_pio_cycles - event_A_duration - event_B_duration - event_C_duration;
-
-    // Nilai N (loop counter) yang dikirim ke PIO
-    // Rumus: N = durasi_siklus - overhead_instruksi
-    // Overhead untuk program PIO ini adalah 4 siklus per loop
-    *delay_A = event_A_duration > 4 ? event_A_duration - 4 : 0;
-    *delay_B = event_B_duration > 4 ? event_B_duration - 4 : 0;
-    *delay_C = event_C_duration > 4 ? event_C_duration - 4 : 0;
-    *delay_D = event_D_duration > 4 ? event_D_duration - 4 : 0;
+    button_wake = false;
+
+    // Jika tombol masih ditekan, tidak perlu tidur
+    if (!gpio_get(BUTTON_PIN))
+    {
+        wake_time_us = time_us_64();
+        return;
+    }
+
+    set_sys_clock_48mhz();
+    while (true)
+    {
+        uint32_t status = save_and_disable_interrupts();
+        bool woken = button_wake;
+        if (!woken)
+        {
+            __wfi();
+        }
+        restore_interrupts(status);
+        if (woken)
+        {
+            break;
+        }
+    }
 }
 
 /**
- * @brief Menginisialisasi PIO, memuat program, dan mengkonfigurasi state machine.
+ * @brief Mengembalikan clk_sys dan clock divider PIO ke nilai saat berjalan.
  *
- * @param pio Instance PIO yang akan digunakan (pio0 atau pio1)
- * @param sm Pointer untuk menyimpan nomor state machine yang dialokasikan
- * @param offset Pointer untuk menyimpan offset program PIO di instruction memory
- * @param clk_div Nilai clock divider untuk state machine
+ * @param gen Instance generator yang clock divider-nya harus diterapkan kembali
+ * @param run_sys_clk_khz Frekuensi clk_sys saat berjalan (kHz)
+ * @return Lama proses pemulihan clock dalam mikrodetik
  */
-void init_pio(PIO pio, uint *sm, uint *offset, float clk_div)
+uint64_t restore_run_clocks(sg_instance *gen, uint32_t run_sys_clk_khz)
 {
-    *offset = pio_add_program(pio, &signal_generator_program);
-    *sm = pio_claim_unused_sm(pio, true);
-    pio_sm_config c = signal_generator_program_get_default_config(*offset);
+    uint64_t t0 = time_us_64();
+    set_sys_clock_khz(run_sys_clk_khz, true);
+    // Jika PLL tidak bisa menghasilkan frekuensi yang sama, delay dihitung ulang
+    if (!sg_sync_clock(gen))
+    {
+        panic("signal_gen: delay tidak valid setelah wake");
+    }
+    return time_us_64() - t0;
+}
 
-    // Konfigurasi pin-pin yang akan digunakan oleh PIO
-    // Pin dasar untuk 'set' adalah PIN_CH1_BASE, dan akan mempengaruhi 4 pin secara berurutan
-    sm_config_set_set_pins(&c, PIN_CH1_BASE, 4);
-    for (uint i = 0; i < 4; ++i)
+/**
+ * @brief Menjalankan generator dalam mode burst PIO dan tidak kembali.
+ *
+ * Trigger, jumlah periode dan akhir burst diputuskan oleh state machine;
+ * CPU hanya membaca penghitung periode secara berkala.
+ *
+ * @param timing Parameter timing sinyal
+ */
+void run_pio_burst_mode(const sg_timing_config *timing)
+{
+    sg_burst_instance burst;
+    uint32_t periods = (uint32_t)((double)SIGNAL_DURATION_US * timing->frequency_hz / 1e6);
+    if (!sg_burst_init(&burst, pio0, PIN_CH1_BASE, BUTTON_PIN, false) ||
+        !sg_burst_configure(&burst, timing, BURST_MODE, periods))
+    {
+        panic("signal_burst: konfigurasi tidak valid");
+    }
+    sg_fault_instance fault;
+    if (FAULT_INPUT &&
+        !sg_fault_init(&fault, pio0, PIN_CH1_BASE, FAULT_PIN, FAULT_ACTIVE_HIGH, 1u << burst.sm, NULL, NULL))
     {
-        pio_gpio_init(pio, PIN_CH1_BASE + i);
+        panic("signal_fault: tidak ada state machine watchdog");
     }
-    pio_sm_set_consecutive_pindirs(pio, *sm, PIN_CH1_BASE, 4, true);
 
-    // Atur clock divider
-    sm_config_set_clkdiv(&c, clk_div);
+    sg_count_instance counter;
+    sg_count_init(&counter);
+    if (!sg_count_start_sm(&counter, burst.pio, burst.sm, COUNT_INTERVAL_PERIODS, NULL, NULL) ||
+        !sg_burst_start(&burst))
+    {
+        panic("signal_burst: tidak ada channel DMA");
+    }
 
-    // Terapkan konfigurasi ke state machine
-    pio_sm_init(pio, *sm, *offset, &c);
+    uint64_t reported = 0;
+    bool fault_reported = false;
+    while (true)
+    {
+        sleep_ms(100);
+        if (FAULT_INPUT && !fault_reported && sg_fault_is_latched(&fault))
+        {
+            printf("fault: output ditahan LOW sejak %llu us\n", (unsigned long long)fault.trip_time_us);
+            fault_reported = true;
+        }
+        uint64_t total = sg_count_periods(&counter);
+        if (total != reported)
+        {
+            printf("periods: total=%llu\n", (unsigned long long)total);
+            reported = total;
+        }
+    }
+}
+
+/**
+ * @brief Menjalankan generator sebagai master atau slave grup sinkron dan
+ *        tidak kembali.
+ *
+ * Master memulai burst dari tombol; slave menunggu sync sendiri. Slave
+ * start-only berjalan bebas sehingga dihentikan CPU setelah
+ * SIGNAL_DURATION_US, sedangkan slave re-align berhenti bersama master.
+ *
+ * @param timing Parameter timing sinyal (harus sama di semua board)
+ */
+void run_sync_mode(const sg_timing_config *timing)
+{
+    if (SYNC_ROLE != SG_SYNC_MASTER)
+    {
+        gpio_init(SYNC_PIN);
+        gpio_set_dir(SYNC_PIN, GPIO_IN);
+        gpio_pull_down(SYNC_PIN); // Sync tidak aktif saat kabel lepas
+    }
+    sg_sync_instance sync;
+    if (!sg_sync_init(&sync, pio0, PIN_CH1_BASE, SYNC_PIN, SYNC_ROLE) || !sg_sync_configure(&sync, timing))
+    {
+        panic("signal_sync: konfigurasi tidak valid");
+    }
+    if (SYNC_ROLE == SG_SYNC_MASTER && REF_CLOCK_GPIO >= 0 &&
+        !sg_sync_ref_clock_out((uint)REF_CLOCK_GPIO, REF_CLOCK_DIV))
+    {
+        panic("signal_sync: REF_CLOCK_GPIO bukan pin GPOUT");
+    }
+
+    sg_count_instance counter;
+    sg_count_init(&counter);
+    if (!sg_count_start_sm(&counter, sync.pio, sync.sm, COUNT_INTERVAL_PERIODS, NULL, NULL))
+    {
+        panic("signal_count: tidak ada channel DMA");
+    }
+
+    uint64_t reported = 0;
+    uint64_t last = 0;
+    while (true)
+    {
+        if (SYNC_ROLE == SG_SYNC_MASTER)
+        {
+            // Tunggu tombol ditekan (pin menjadi LOW), lalu burst di semua board
+            if (gpio_get(BUTTON_PIN))
+            {
+                tight_loop_contents();
+                continue;
+            }
+            sg_sync_start(&sync);
+            sleep_us(SIGNAL_DURATION_US);
+            sg_sync_stop(&sync);
+            while (!gpio_get(BUTTON_PIN))
+            {
+                tight_loop_contents();
+            }
+        }
+        else
+        {
+            if (sync.state != SG_STATE_RUNNING && !sg_sync_start(&sync))
+            {
+                panic("signal_sync: tidak ada channel DMA");
+            }
+            if (SYNC_ROLE == SG_SYNC_SLAVE_START && sg_count_periods(&counter) != reported)
+            {
+                sleep_us(SIGNAL_DURATION_US);
+                sg_sync_stop(&sync);
+            }
+
+            // Burst slave dianggap selesai setelah penghitung diam 100 ms
+            sleep_ms(100);
+            uint64_t now = sg_count_periods(&counter);
+            bool settled = now == last;
+            last = now;
+            if (!settled)
+            {
+                continue;
+            }
+        }
+
+        uint64_t total = sg_count_periods(&counter);
+        if (total != reported)
+        {
+            printf("periods: burst=%llu total=%llu\n", (unsigned long long)(total - reported),
+                   (unsigned long long)total);
+            reported = total;
+        }
+    }
+}
+
+/**
+ * @brief Melayani register map I2C target untuk generator dan tidak kembali.
+ *
+ * @param gen Generator yang sudah dikonfigurasi dan berhenti
+ * @param counter Penghitung periode generator untuk register PERIOD_COUNT
+ */
+void run_i2c_mode(sg_instance *gen, const sg_count_instance *counter)
+{
+    sg_i2c_instance target;
+    if (!sg_i2c_init(&target, i2c0, I2C_ADDRESS, I2C_SDA_PIN, I2C_SCL_PIN, gen, counter, BUTTON_PIN, false))
+    {
+        panic("signal_i2c: controller I2C tidak tersedia");
+    }
+    while (true)
+    {
+        sg_i2c_poll(&target);
+    }
+}
+
+/**
+ * @brief Menjalankan generator di bawah kontrol SPI target dan tidak kembali.
+ *
+ * @param gen Generator yang sudah dikonfigurasi dan berhenti
+ * @param counter Penghitung periode generator untuk laporan
+ */
+void run_spi_mode(sg_instance *gen, const sg_count_instance *counter)
+{
+    sg_spi_instance target;
+    if (!sg_spi_init(&target, pio1, SPI_MOSI_PIN, gen) || !sg_spi_start(&target))
+    {
+        panic("signal_spi: state machine atau channel DMA tidak tersedia");
+    }
+    uint32_t reported_frames = 0;
+    uint32_t reported_rejected = 0;
+    while (true)
+    {
+        sleep_ms(100);
+        uint32_t frames = target.frames;
+        uint32_t rejected = target.rejected;
+        if (frames != reported_frames || rejected != reported_rejected)
+        {
+            printf("spi: frames=%lu rejected=%lu seq=%u periods=%llu\n", (unsigned long)frames,
+                   (unsigned long)rejected, target.last_sequence, (unsigned long long)sg_count_periods(counter));
+            reported_frames = frames;
+            reported_rejected = rejected;
+        }
+    }
+}
+
+/**
+ * @brief Mengirim jawaban SCPI ke konsol USB CDC.
+ *
+ * Boleh memblok sampai host membaca: FIFO generator diisi DMA, bukan loop ini.
+ */
+static void scpi_write(void *ctx, const char *data, size_t len)
+{
+    (void)ctx;
+    fwrite(data, 1, len, stdout);
+    fflush(stdout);
+}
+
+/**
+ * @brief Callback stdio saat byte dari host tersedia: hanya menyalin ke ring.
+ */
+static void scpi_chars_available(void *param)
+{
+    sg_scpi_instance *scpi = param;
+    int c;
+    while ((c = getchar_timeout_us(0)) != PICO_ERROR_TIMEOUT)
+    {
+        uint8_t byte = (uint8_t)c;
+        sg_scpi_receive(scpi, &byte, 1);
+    }
+}
+
+/**
+ * @brief Melayani perintah SCPI dari konsol USB CDC dan tidak kembali.
+ *
+ * Preset power-on dipanggil (dan output dijalankan jika diminta) sebelum
+ * stdio_init_all(), jadi waktu dari reset ke sisi pertama hanya inisialisasi
+ * main() (generator, watchdog fault, penghitung periode) dan scan region
+ * preset, bukan enumerasi USB. stdio USB bawaan SDK tidak menunggu host
+ * membuka port (PICO_STDIO_USB_CONNECT_WAIT_TIMEOUT_MS = 0).
+ *
+ * @param gen Generator yang sudah dikonfigurasi dan berhenti
+ * @param counter Penghitung periode gen yang berjalan, juga menghitung BURS:NCYC
+ */
+void run_scpi_mode(sg_instance *gen, sg_count_instance *counter)
+{
+    static sg_scpi_instance scpi;
+    static sg_preset_store presets;
+    if (!sg_scpi_init(&scpi, gen, counter, BUTTON_PIN, false, scpi_write, NULL))
+    {
+        panic("signal_scpi: generator belum siap atau channel DMA habis");
+    }
+    sg_preset_init(&presets);
+    sg_scpi_attach_presets(&scpi, &presets);
+    uint power_on = sg_preset_power_on(&presets);
+    bool recalled = power_on != SG_PRESET_NONE && sg_scpi_recall(&scpi, power_on, presets.power_on_output);
+    uint64_t output_us = time_us_64();
+
+    stdio_init_all();
+    stdio_set_chars_available_callback(scpi_chars_available, &scpi);
+    // Byte yang tiba sebelum callback terpasang tidak memicu callback
+    scpi_chars_available(&scpi);
+    if (power_on != SG_PRESET_NONE)
+    {
+        printf("scpi: preset %u %s, output %s pada %llu us\n", power_on, recalled ? "dipanggil" : "gagal",
+               scpi.output ? "aktif" : "mati", (unsigned long long)output_us);
+    }
+    while (true)
+    {
+        if (sg_scpi_poll(&scpi) == 0)
+        {
+            tight_loop_contents();
+        }
+    }
+}
+
+/**
+ * @brief Menjalankan generator sebagai VCO dari input ADC dan tidak kembali.
+ *
+ * Loop hanya memanggil sg_vco_service(), yang tidak blocking, sehingga event
+ * D mengikuti ring sampel ADC setiap periode sambil menjaga FIFO terisi.
+ *
+ * @param gen Generator yang sudah dikonfigurasi dan berhenti
+ */
+void run_vco_mode(sg_instance *gen)
+{
+    static sg_vco_instance vco;
+    const sg_vco_config config = {
+        .adc_input = VCO_ADC_INPUT,
+        .sample_rate_hz = VCO_SAMPLE_RATE_HZ,
+        .curve = VCO_CURVE,
+        .f_min_hz = VCO_F_MIN_HZ,
+        .f_max_hz = VCO_F_MAX_HZ,
+        .code_min = 0,
+        .code_max = SG_VCO_CODES - 1,
+    };
+    if (!sg_vco_init(&vco, gen, &config) || !sg_vco_start(&vco))
+    {
+        panic("signal_vco: rentang frekuensi tidak valid atau channel DMA tidak tersedia");
+    }
+    while (true)
+    {
+        sg_vco_service(&vco);
+    }
+}
+
+/**
+ * @brief Melepas penghitung, watchdog fault dan generator milik main().
+ *
+ * Tidak dipanggil di firmware (main() tidak kembali). Build host memanggilnya
+ * sebelum fake_hw_reset() agar main() yang dijalankan lagi memuat ulang
+ * program PIO dan mendaftarkan penghitungnya dari awal, seperti setelah
+ * power cycle.
+ */
+void firmware_release(void)
+{
+    if (gen.state == SG_STATE_UNINIT)
+    {
+        return;
+    }
+    sg_count_stop(&counter);
+    sg_fault_deinit(&fault);
+    sg_deinit(&gen);
 }
@@ -0,0 +1,404 @@
+/**
+ * Implementasi tabel PWM tiga fasa yang diputar DMA.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <math.h>
+
+#include "signal_3phase.h"
+
+#define GRID SG_EVENT_OVERHEAD_CYCLES
+#define TWO_PI 6.28318530718f
+#define SVPWM_MAX_INDEX 1.1547005f // 2 / sqrt(3)
+
+// Kandidat edge dalam satu periode carrier: awal periode + 5 per fasa
+#define MAX_CANDIDATES (1 + 5 * 3)
+
+/**
+ * @brief Jendela perintah "high" satu fasa pada satu periode carrier,
+ *        relatif terhadap awal periode: [start, end), kosong jika start == end.
+ */
+typedef struct
+{
+    uint32_t start;
+    uint32_t end;
+} command_window;
+
+/**
+ * @brief State pembangun tabel.
+ */
+typedef struct
+{
+    const sg_3ph_config *config;
+    uint32_t period;   // Periode carrier (siklus PIO, kelipatan GRID)
+    uint32_t deadtime; // Dead time (siklus PIO, kelipatan GRID)
+    uint carriers;     // Periode carrier per periode fundamental
+    uint32_t *out;
+    uint capacity;
+    uint count;
+    uint32_t mask;     // Mask segmen yang sedang berjalan
+    uint64_t start;    // Awal segmen yang sedang berjalan (siklus dari awal tabel)
+} builder;
+
+/**
+ * @brief Duty fasa pada sudut listrik theta.
+ *
+ * @param config Parameter modulasi
+ * @param phase Indeks fasa (0 = U, 1 = V, 2 = W)
+ * @param theta Sudut listrik fasa U (radian)
+ * @return Porsi periode carrier untuk perintah high (0.0 .. 1.0)
+ */
+float sg_3ph_duty(const sg_3ph_config *config, uint phase, float theta)
+{
+    float v[3];
+    for (uint p = 0; p < 3; ++p)
+    {
+        v[p] = sinf(theta - (float)p * (TWO_PI / 3.0f));
+    }
+    float offset = 0.0f;
+    if (config->modulation == SG_3PH_SVPWM)
+    {
+        float vmax = fmaxf(v[0], fmaxf(v[1], v[2]));
+        float vmin = fminf(v[0], fminf(v[1], v[2]));
+        offset = -0.5f * (vmax + vmin);
+    }
+    float d = 0.5f + 0.5f * config->modulation_index * (v[phase] + offset);
+    return d < 0.0f ? 0.0f : d > 1.0f ? 1.0f : d;
+}
+
+/**
+ * @brief Jendela perintah fasa pada periode carrier k (boleh di luar 0..N-1,
+ *        tabel berulang).
+ */
+static command_window window_at(const builder *b, uint phase, int64_t k)
+{
+    uint idx = (uint)(((k % (int64_t)b->carriers) + (int64_t)b->carriers) % (int64_t)b->carriers);
+    float theta = TWO_PI * ((float)idx + 0.5f) / (float)b->carriers;
+    float d = sg_3ph_duty(b->config, phase, theta);
+    // Pulsa center-aligned; start dibulatkan ke grid, end simetris
+    uint32_t start = (uint32_t)((float)b->period * (1.0f - d) / (2.0f * GRID) + 0.5f) * GRID;
+    command_window w = {start, b->period - start};
+    return w;
+}
+
+/**
+ * @brief Level pin high dan low satu fasa pada waktu t (relatif terhadap
+ *        awal periode k).
+ *
+ * High aktif jika perintah sudah high minimal satu dead time, low aktif jika
+ * perintah sudah low minimal satu dead time. Periode sebelumnya cukup dilihat
+ * satu langkah karena periode carrier lebih panjang dari dead time.
+ */
+static uint32_t phase_bits(const builder *b, uint phase, const command_window w[2], uint32_t t)
+{
+    const command_window *prev = &w[0];
+    const command_window *cur = &w[1];
+    bool cur_nonempty = cur->end > cur->start;
+    bool prev_nonempty = prev->end > prev->start;
+
+    if (cur_nonempty && t >= cur->start && t < cur->end)
+    {
+        // Awal perintah high; bersambung dari periode sebelumnya jika jendela bersentuhan
+        int64_t run_start = cur->start;
+        if (cur->start == 0 && prev_nonempty && prev->end == b->period)
+        {
+            run_start = (int64_t)prev->start - (int64_t)b->period;
+        }
+        return (int64_t)t - run_start >= (int64_t)b->deadtime ? SG_3PH_HIGH_BIT(phase) : 0;
+    }
+
+    // Akhir perintah high terakhir sebelum t
+    int64_t last_end;
+    if (cur_nonempty && t >= cur->end)
+    {
+        last_end = cur->end;
+    }
+    else if (prev_nonempty)
+    {
+        last_end = (int64_t)prev->end - (int64_t)b->period;
+    }
+    else
+    {
+        return SG_3PH_LOW_BIT(phase);
+    }
+    return (int64_t)t - last_end >= (int64_t)b->deadtime ? SG_3PH_LOW_BIT(phase) : 0;
+}
+
+/**
+ * @brief Menulis satu segmen ke tabel, dipecah jika melebihi durasi event maksimal.
+ */
+static bool emit(builder *b, uint32_t mask, uint64_t cycles)
+{
+    while (cycles > 0)
+    {
+        uint64_t chunk = cycles;
+        if (chunk > SG_SEQ_MAX_EVENT_CYCLES)
+        {
+            // Sisakan minimal satu event penuh untuk potongan terakhir
+            chunk = cycles - SG_SEQ_MAX_EVENT_CYCLES < GRID ? SG_SEQ_MAX_EVENT_CYCLES - GRID : SG_SEQ_MAX_EVENT_CYCLES;
+        }
+        if (b->count >= b->capacity)
+        {
+            return false;
+        }
+        b->out[b->count++] = SG_SEQ_EVENT(mask, chunk);
+        cycles -= chunk;
+    }
+    return true;
+}
+
+/**
+ * @brief Memecah event yang cukup panjang sampai jumlah word menjadi pangkat dua.
+ *
+ * Memecah satu event menjadi dua event dengan mask yang sama tidak mengubah
+ * bentuk gelombang. Dikerjakan dari belakang sehingga bisa di tempat.
+ */
+static bool pad_to_power_of_two(builder *b, uint *words)
+{
+    uint target = 1;
+    while (target < b->count)
+    {
+        target <<= 1;
+    }
+    if (target > b->capacity || target > SG_SEQ_DMA_MAX_WORDS)
+    {
+        return false;
+    }
+
+    uint extra = target - b->count;
+    int r = (int)b->count - 1;
+    int w = (int)target - 1;
+    while (r >= 0)
+    {
+        uint32_t ev = b->out[r--];
+        uint32_t cycles = SG_SEQ_EVENT_CYCLES(ev);
+        if (extra > 0 && cycles >= 2 * GRID)
+        {
+            uint32_t first = cycles / 2;
+            b->out[w--] = SG_SEQ_EVENT(SG_SEQ_EVENT_MASK(ev), cycles - first);
+            b->out[w--] = SG_SEQ_EVENT(SG_SEQ_EVENT_MASK(ev), first);
+            extra--;
+        }
+        else
+        {
+            b->out[w--] = ev;
+        }
+    }
+    *words = target;
+    return extra == 0;
+}
+
+/**
+ * @brief Memeriksa tabel yang berputar: high dan low satu fasa tidak pernah
+ *        aktif bersamaan dan jarak turn-off ke turn-on pasangannya minimal
+ *        deadtime siklus.
+ */
+static bool check_interlock(const uint32_t *words, uint count, uint32_t deadtime)
+{
+    uint64_t t = 0;
+    uint64_t last_off[SG_3PH_NUM_PINS] = {0};
+    bool seen_off[SG_3PH_NUM_PINS] = {false};
+    uint32_t prev = SG_SEQ_EVENT_MASK(words[count - 1]);
+
+    // Dua putaran agar jarak yang melintasi akhir tabel ikut diperiksa
+    for (uint n = 0; n < 2 * count; ++n)
+    {
+        uint32_t mask = SG_SEQ_EVENT_MASK(words[n % count]);
+        for (uint pin = 0; pin < SG_3PH_NUM_PINS; ++pin)
+        {
+            if (!(mask & (1u << pin)) && (prev & (1u << pin)))
+            {
+                last_off[pin] = t;
+                seen_off[pin] = true;
+            }
+        }
+        for (uint pin = 0; pin < SG_3PH_NUM_PINS; ++pin)
+        {
+            uint partner = pin ^ 1u; // Pasangan high/low satu fasa
+            if (!(mask & (1u << pin)))
+            {
+                continue;
+            }
+            if (mask & (1u << partner))
+            {
+                return false;
+            }
+            if (!(prev & (1u << pin)) && seen_off[partner] && t - last_off[partner] < deadtime)
+            {
+                return false;
+            }
+        }
+        prev = mask;
+        t += SG_SEQ_EVENT_CYCLES(words[n % count]);
+    }
+    return true;
+}
+
+/**
+ * @brief Membangun tabel satu periode fundamental.
+ *
+ * Periode carrier dibulatkan ke grid dan jumlah periode carrier per periode
+ * fundamental dibulatkan ke bilangan bulat; frekuensi aktual dilaporkan di
+ * out. Event yang tersisa dipecah sampai jumlahnya pangkat dua agar tabel
+ * bisa diputar dengan ring DMA.
+ *
+ * @param sys_clk_hz Frekuensi clock sistem (Hz)
+ * @param config Parameter PWM tiga fasa
+ * @param buffer Buffer word event, rata ke SG_3PH_TABLE_ALIGN (atau minimal
+ *        ke ukuran tabel dalam byte)
+ * @param capacity Kapasitas buffer (word)
+ * @param out Deskripsi tabel hasil
+ * @return false jika parameter tidak valid atau tabel tidak muat
+ */
+bool sg_3ph_build(float sys_clk_hz, const sg_3ph_config *config, uint32_t *buffer, uint capacity,
+                  sg_3ph_table *out)
+{
+    float max_index = config->modulation == SG_3PH_SVPWM ? SVPWM_MAX_INDEX : 1.0f;
+    if (config->fundamental_hz <= 0.0f || config->carrier_hz <= config->fundamental_hz ||
+        config->pio_clk_div < 1.0f || config->modulation_index < 0.0f || config->modulation_index > max_index ||
+        config->deadtime_us < 0.0f)
+    {
+        return false;
+    }
+
+    float pio_clk_hz = sys_clk_hz / config->pio_clk_div;
+    uint32_t period = (uint32_t)(pio_clk_hz / config->carrier_hz / GRID + 0.5f) * GRID;
+    uint32_t raw_deadtime = (uint32_t)(config->deadtime_us * 1e-6f * pio_clk_hz + 0.5f);
+    uint32_t deadtime = (raw_deadtime + GRID - 1) / GRID * GRID;
+    if (deadtime < GRID)
+    {
+        deadtime = GRID;
+    }
+    if (period < 2 * deadtime + 2 * GRID || period > SG_SEQ_MAX_EVENT_CYCLES)
+    {
+        return false;
+    }
+    float carrier_hz = pio_clk_hz / (float)period;
+    uint carriers = (uint)(carrier_hz / config->fundamental_hz + 0.5f);
+    if (carriers == 0)
+    {
+        return false;
+    }
+
+    builder b = {
+        .config = config,
+        .period = period,
+        .deadtime = deadtime,
+        .carriers = carriers,
+        .out = buffer,
+        .capacity = capacity,
+    };
+
+    uint max_per_carrier = 0;
+    for (uint k = 0; k < carriers; ++k)
+    {
+        command_window w[3][2];
+        uint32_t candidates[MAX_CANDIDATES];
+        uint n = 0;
+        candidates[n++] = 0;
+        for (uint phase = 0; phase < 3; ++phase)
+        {
+            w[phase][0] = window_at(&b, phase, (int64_t)k - 1);
+            w[phase][1] = window_at(&b, phase, k);
+            uint32_t edges[5] = {
+                w[phase][1].start,
+                w[phase][1].start + deadtime,
+                w[phase][1].end,
+                w[phase][1].end + deadtime,
+                w[phase][0].end + deadtime - period, // Sisa dead time dari periode sebelumnya
+            };
+            for (uint i = 0; i < 5; ++i)
+            {
+                if (edges[i] < period)
+                {
+                    candidates[n++] = edges[i];
+                }
+            }
+        }
+        // Insertion sort; n kecil
+        for (uint i = 1; i < n; ++i)
+        {
+            uint32_t v = candidates[i];
+            uint j = i;
+            while (j > 0 && candidates[j - 1] > v)
+            {
+                candidates[j] = candidates[j - 1];
+                j--;
+            }
+            candidates[j] = v;
+        }
+
+        uint before = b.count;
+        uint64_t base = (uint64_t)k * period;
+        for (uint i = 0; i < n; ++i)
+        {
+            if (i > 0 && candidates[i] == candidates[i - 1])
+            {
+                continue;
+            }
+            uint32_t mask = 0;
+            for (uint phase = 0; phase < 3; ++phase)
+            {
+                mask |= phase_bits(&b, phase, w[phase], candidates[i]);
+            }
+            uint64_t t = base + candidates[i];
+            if (t == 0)
+            {
+                b.mask = mask;
+            }
+            else if (mask != b.mask)
+            {
+                if (!emit(&b, b.mask, t - b.start))
+                {
+                    return false;
+                }
+                b.mask = mask;
+                b.start = t;
+            }
+        }
+        if (b.count - before > max_per_carrier)
+        {
+            max_per_carrier = b.count - before;
+        }
+    }
+    if (!emit(&b, b.mask, (uint64_t)carriers * period - b.start))
+    {
+        return false;
+    }
+
+    uint events = b.count;
+    uint words;
+    if (!pad_to_power_of_two(&b, &words) || !check_interlock(buffer, words, raw_deadtime))
+    {
+        return false;
+    }
+
+    out->words = buffer;
+    out->count = words;
+    out->events = events;
+    out->carrier_periods = carriers;
+    out->max_events_per_carrier = max_per_carrier;
+    out->carrier_cycles = period;
+    out->deadtime_cycles = deadtime;
+    out->carrier_hz = carrier_hz;
+    out->fundamental_hz = carrier_hz / (float)carriers;
+    out->pio_clk_div = config->pio_clk_div;
+    return true;
+}
+
+/**
+ * @brief Memutar tabel tiga fasa lewat DMA. Semua pin LOW saat berhenti.
+ *
+ * @param inst Instance sequencer dengan minimal SG_3PH_NUM_PINS pin output
+ * @param table Tabel dari sg_3ph_build(); buffer harus tetap valid selama berjalan
+ * @return false jika instance tidak cocok atau DMA tidak bisa dimulai
+ */
+bool sg_3ph_start(sg_seq_instance *inst, const sg_3ph_table *table)
+{
+    if (inst->pin_count < SG_3PH_NUM_PINS)
+    {
+        return false;
+    }
+    return sg_seq_start_dma(inst, table->words, table->count, table->pio_clk_div, 0);
+}
@@ -0,0 +1,73 @@
+/**
+ * PWM tiga fasa (SPWM/SVPWM) untuk gate-drive inverter enam switch.
+ *
+ * Satu periode fundamental dibangun sekali menjadi tabel event sequencer:
+ * setiap periode carrier berisi pulsa center-aligned per fasa dengan duty dari
+ * sinus (SPWM) atau sinus + injeksi min-max (SVPWM, setara space-vector
+ * simetris). Dead time disisipkan dengan menunda setiap turn-on. Tabel
+ * kemudian diputar terus oleh DMA (sg_seq_start_dma) sehingga CPU bebas
+ * sepenuhnya selama output berjalan.
+ *
+ * Semua edge berada di grid SG_EVENT_OVERHEAD_CYCLES siklus PIO dan dead time
+ * dibulatkan ke atas ke grid yang sama, sehingga setiap segmen memenuhi durasi
+ * event minimum dan dead time tidak pernah lebih pendek dari yang diminta.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef SIGNAL_3PHASE_H
+#define SIGNAL_3PHASE_H
+
+#include "signal_seq.h"
+
+// -- Pemetaan Pin (relatif terhadap pin_base) --
+#define SG_3PH_NUM_PINS 6
+#define SG_3PH_HIGH_BIT(phase) (1u << (2u * (phase)))      // U_H, V_H, W_H
+#define SG_3PH_LOW_BIT(phase) (1u << (2u * (phase) + 1u)) // U_L, V_L, W_L
+
+// Perataan buffer tabel yang cukup untuk ukuran tabel berapa pun
+#define SG_3PH_TABLE_ALIGN (SG_SEQ_DMA_MAX_WORDS * 4u)
+
+typedef enum
+{
+    SG_3PH_SPWM,  // Sinus murni, indeks modulasi 0..1
+    SG_3PH_SVPWM, // Injeksi min-max, indeks modulasi 0..2/sqrt(3)
+} sg_3ph_modulation;
+
+/**
+ * @brief Parameter PWM tiga fasa.
+ */
+typedef struct
+{
+    float fundamental_hz;         // Frekuensi keluaran (Hz)
+    float carrier_hz;             // Frekuensi carrier PWM (Hz)
+    float modulation_index;       // Amplitudo relatif terhadap setengah tegangan DC
+    float deadtime_us;            // Dead time setiap turn-on (us)
+    float pio_clk_div;            // Clock divider state machine PIO
+    sg_3ph_modulation modulation; // SPWM atau SVPWM
+} sg_3ph_config;
+
+/**
+ * @brief Tabel satu periode fundamental yang siap diputar DMA.
+ */
+typedef struct
+{
+    const uint32_t *words;     // Word event (menunjuk ke buffer pemanggil)
+    uint count;                // Jumlah word, pangkat dua
+    uint events;               // Jumlah event sebelum dipecah untuk mengisi pangkat dua
+    uint carrier_periods;      // Periode carrier per periode fundamental
+    uint max_events_per_carrier;
+    uint32_t carrier_cycles;   // Periode carrier (siklus PIO)
+    uint32_t deadtime_cycles;  // Dead time setelah dibulatkan ke grid (siklus PIO)
+    float carrier_hz;          // Frekuensi carrier aktual
+    float fundamental_hz;      // Frekuensi fundamental aktual
+    float pio_clk_div;
+} sg_3ph_table;
+
+// -- API --
+bool sg_3ph_build(float sys_clk_hz, const sg_3ph_config *config, uint32_t *buffer, uint capacity,
+                  sg_3ph_table *out);
+float sg_3ph_duty(const sg_3ph_config *config, uint phase, float theta);
+bool sg_3ph_start(sg_seq_instance *inst, const sg_3ph_table *table);
+
+#endif
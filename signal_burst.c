@@ -0,0 +1,324 @@
+/**
+ * Implementasi mode burst generator klasik yang diputuskan PIO.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "signal_burst.h"
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "signal_burst.pio.h" // Header yang di-generate otomatis
+
+// Siklus tambahan di batas periode per mode, dikurangkan dari delay event D
+// irq wait: set flag, SM kontrol melihat dan membersihkannya satu siklus
+// kemudian, generator melihat flag bersih satu siklus berikutnya; lalu jmp
+#define SYNC_BOUNDARY_CYCLES 4
+static const uint32_t boundary_cycles[SG_BURST_NUM_MODES] = {
+    [SG_BURST_CONTINUOUS] = 0,
+    [SG_BURST_GATED] = 1, // wait yang langsung lolos
+    [SG_BURST_NCYCLE] = SYNC_BOUNDARY_CYCLES,
+    [SG_BURST_RETRIGGER] = SYNC_BOUNDARY_CYCLES,
+};
+
+// Titik masuk batas periode program signal_burst per mode (wrap_target)
+static const uint gen_entry[SG_BURST_NUM_MODES] = {
+    [SG_BURST_CONTINUOUS] = signal_burst_wrap_target,
+    [SG_BURST_GATED] = signal_burst_offset_gate,
+    [SG_BURST_NCYCLE] = signal_burst_offset_sync,
+    [SG_BURST_RETRIGGER] = signal_burst_offset_sync,
+};
+
+// -- Program PIO yang Dimuat per Blok PIO --
+static struct
+{
+    uint offset;
+    uint ctl_offset;
+    uint users;
+} loaded_program[NUM_PIOS];
+
+/**
+ * @brief Memeriksa apakah mode memakai state machine kontrol.
+ */
+static inline bool uses_ctl(sg_burst_mode mode)
+{
+    return mode == SG_BURST_NCYCLE || mode == SG_BURST_RETRIGGER;
+}
+
+/**
+ * @brief Menginisialisasi instance: memuat kedua program PIO, mengklaim
+ *        pasangan state machine, dan mengkonfigurasi pin.
+ *
+ * Pin trigger harus sudah dikonfigurasi sebagai input oleh pemanggil
+ * (misalnya dengan pull-up untuk tombol).
+ *
+ * @param b Instance yang akan diinisialisasi
+ * @param pio Instance PIO yang akan digunakan (pio0 atau pio1)
+ * @param pin_base Pin pertama dari SG_NUM_PINS pin output berurutan
+ * @param trigger_pin GPIO trigger
+ * @param active_high true = trigger aktif saat HIGH, false = aktif saat LOW
+ * @return false jika tidak ada pasangan state machine (n, n + 1) atau
+ *         instruction memory yang tersisa
+ */
+bool sg_burst_init(sg_burst_instance *b, PIO pio, uint pin_base, uint trigger_pin, bool active_high)
+{
+    // SM kontrol harus SM generator + 1 (mod 4) agar `irq rel` menunjuk flag yang sama
+    int sm = -1;
+    for (uint i = 0; i < NUM_PIO_STATE_MACHINES && sm < 0; ++i)
+    {
+        if (!pio_sm_is_claimed(pio, i) && !pio_sm_is_claimed(pio, (i + 1) % NUM_PIO_STATE_MACHINES))
+        {
+            sm = (int)i;
+        }
+    }
+    if (sm < 0)
+    {
+        return false;
+    }
+
+    uint pio_index = pio_get_index(pio);
+    if (loaded_program[pio_index].users == 0)
+    {
+        if (!pio_can_add_program(pio, &signal_burst_program))
+        {
+            return false;
+        }
+        uint offset = pio_add_program(pio, &signal_burst_program);
+        if (!pio_can_add_program(pio, &signal_burst_ctl_program))
+        {
+            pio_remove_program(pio, &signal_burst_program, offset);
+            return false;
+        }
+        loaded_program[pio_index].offset = offset;
+        loaded_program[pio_index].ctl_offset = pio_add_program(pio, &signal_burst_ctl_program);
+    }
+    loaded_program[pio_index].users++;
+
+    b->pio = pio;
+    b->sm = (uint)sm;
+    b->ctl_sm = ((uint)sm + 1) % NUM_PIO_STATE_MACHINES;
+    pio_claim_sm_mask(pio, (1u << b->sm) | (1u << b->ctl_sm));
+    b->offset = loaded_program[pio_index].offset;
+    b->ctl_offset = loaded_program[pio_index].ctl_offset;
+    b->pin_base = pin_base;
+    b->trigger_pin = trigger_pin;
+    b->active_high = active_high;
+    b->mode = SG_BURST_CONTINUOUS;
+    b->periods = 0;
+    b->sys_clk_hz = 0;
+    b->dma_chan[0] = -1;
+    b->dma_chan[1] = -1;
+    for (uint i = 0; i < SG_NUM_EVENTS; ++i)
+    {
+        b->ring[i] = 0;
+    }
+
+    // Trigger dinormalisasi ke aktif-high untuk `wait 1 pin` dan `jmp pin`
+    gpio_set_inover(trigger_pin, active_high ? GPIO_OVERRIDE_NORMAL : GPIO_OVERRIDE_INVERT);
+
+    pio_sm_config c = signal_burst_program_get_default_config(b->offset);
+    sm_config_set_set_pins(&c, pin_base, SG_NUM_PINS);
+    sm_config_set_in_pins(&c, trigger_pin);
+    for (uint i = 0; i < SG_NUM_PINS; ++i)
+    {
+        pio_gpio_init(pio, pin_base + i);
+    }
+    pio_sm_set_consecutive_pindirs(pio, b->sm, pin_base, SG_NUM_PINS, true);
+    pio_sm_init(pio, b->sm, b->offset + signal_burst_wrap_target, &c);
+
+    pio_sm_config ctl = signal_burst_ctl_program_get_default_config(b->ctl_offset);
+    sm_config_set_in_pins(&ctl, trigger_pin);
+    sm_config_set_jmp_pin(&ctl, trigger_pin);
+    pio_sm_init(pio, b->ctl_sm, b->ctl_offset, &ctl);
+
+    b->state = SG_STATE_READY;
+    return true;
+}
+
+/**
+ * @brief Menghentikan instance dan melepaskan state machine, channel DMA,
+ *        program PIO, serta override pin trigger.
+ *
+ * @param b Instance yang akan dilepas
+ */
+void sg_burst_deinit(sg_burst_instance *b)
+{
+    if (b->state == SG_STATE_UNINIT)
+    {
+        return;
+    }
+    sg_burst_stop(b);
+    gpio_set_inover(b->trigger_pin, GPIO_OVERRIDE_NORMAL);
+    pio_sm_unclaim(b->pio, b->sm);
+    pio_sm_unclaim(b->pio, b->ctl_sm);
+    for (uint i = 0; i < 2; ++i)
+    {
+        if (b->dma_chan[i] >= 0)
+        {
+            dma_channel_unclaim((uint)b->dma_chan[i]);
+            b->dma_chan[i] = -1;
+        }
+    }
+
+    uint pio_index = pio_get_index(b->pio);
+    if (--loaded_program[pio_index].users == 0)
+    {
+        pio_remove_program(b->pio, &signal_burst_ctl_program, b->ctl_offset);
+        pio_remove_program(b->pio, &signal_burst_program, b->offset);
+    }
+    b->state = SG_STATE_UNINIT;
+}
+
+/**
+ * @brief Menerapkan timing dan mode ke instance yang sedang berhenti.
+ *
+ * @param b Instance burst
+ * @param timing Parameter timing (sama dengan generator klasik)
+ * @param mode Semantik trigger
+ * @param periods N periode per burst untuk SG_BURST_NCYCLE/SG_BURST_RETRIGGER
+ *        (>= 1), diabaikan untuk mode lain
+ * @return false jika instance berjalan, parameter tidak valid, atau delay
+ *         event D terlalu pendek untuk overhead batas periode mode
+ */
+bool sg_burst_configure(sg_burst_instance *b, const sg_timing_config *timing, sg_burst_mode mode,
+                        uint32_t periods)
+{
+    if (b->state == SG_STATE_UNINIT || b->state == SG_STATE_RUNNING || (uint)mode >= SG_BURST_NUM_MODES ||
+        (uses_ctl(mode) && periods == 0))
+    {
+        return false;
+    }
+    uint32_t sys_clk_hz = clock_get_hz(clk_sys);
+    uint32_t delays[SG_NUM_EVENTS];
+    if (!sg_calculate_delays((float)sys_clk_hz, timing, delays) || delays[3] < boundary_cycles[mode])
+    {
+        return false;
+    }
+
+    b->timing = *timing;
+    b->sys_clk_hz = sys_clk_hz;
+    b->mode = mode;
+    b->periods = uses_ctl(mode) ? periods : 0;
+    for (uint i = 0; i < SG_NUM_EVENTS; ++i)
+    {
+        b->ring[i] = delays[i];
+    }
+    b->ring[3] -= boundary_cycles[mode];
+    pio_sm_set_clkdiv(b->pio, b->sm, timing->pio_clk_div);
+    pio_sm_set_clkdiv(b->pio, b->ctl_sm, timing->pio_clk_div);
+    b->state = SG_STATE_IDLE;
+    return true;
+}
+
+/**
+ * @brief Menjalankan mode yang dikonfigurasi; setelah ini PIO dan DMA
+ *        berjalan sendiri sampai sg_burst_stop().
+ *
+ * Mode CONTINUOUS langsung mengeluarkan sinyal; mode lain menunggu trigger.
+ *
+ * @param b Instance dalam state SG_STATE_IDLE
+ * @return false jika belum dikonfigurasi, sedang berjalan, atau tidak ada
+ *         channel DMA yang tersisa
+ */
+bool sg_burst_start(sg_burst_instance *b)
+{
+    if (b->state != SG_STATE_IDLE)
+    {
+        return false;
+    }
+    for (uint i = 0; i < 2; ++i)
+    {
+        if (b->dma_chan[i] < 0)
+        {
+            b->dma_chan[i] = dma_claim_unused_channel(false);
+            if (b->dma_chan[i] < 0)
+            {
+                return false;
+            }
+        }
+    }
+
+    PIO pio = b->pio;
+    uint32_t mask = 1u << b->sm;
+    pio_sm_clear_fifos(pio, b->sm);
+    pio_sm_restart(pio, b->sm);
+    pio_interrupt_clear(pio, b->sm); // Flag `irq 0 rel` generator
+    pio_sm_set_wrap(pio, b->sm, b->offset + gen_entry[b->mode], b->offset + signal_burst_wrap);
+    pio_sm_exec(pio, b->sm, pio_encode_jmp(b->offset + gen_entry[b->mode]));
+
+    if (uses_ctl(b->mode))
+    {
+        bool ncycle = b->mode == SG_BURST_NCYCLE;
+        uint entry = ncycle ? signal_burst_ctl_offset_ncycle : signal_burst_ctl_offset_retrigger;
+        uint wrap = ncycle ? signal_burst_ctl_offset_ncycle_wrap : signal_burst_ctl_offset_retrigger_wrap;
+        pio_sm_clear_fifos(pio, b->ctl_sm);
+        pio_sm_restart(pio, b->ctl_sm);
+        pio_sm_set_wrap(pio, b->ctl_sm, b->ctl_offset + entry, b->ctl_offset + wrap);
+        pio_sm_put(pio, b->ctl_sm, b->periods - 1);
+        pio_sm_exec(pio, b->ctl_sm, pio_encode_pull(false, true));
+        pio_sm_exec(pio, b->ctl_sm, pio_encode_jmp(b->ctl_offset + entry));
+        mask |= 1u << b->ctl_sm;
+    }
+
+    // Satu periode per channel; ring baca 16 byte memutar keempat delay
+    for (uint i = 0; i < 2; ++i)
+    {
+        uint chan = (uint)b->dma_chan[i];
+        dma_channel_config c = dma_channel_get_default_config(chan);
+        channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+        channel_config_set_read_increment(&c, true);
+        channel_config_set_write_increment(&c, false);
+        channel_config_set_ring(&c, false, 4);
+        channel_config_set_dreq(&c, pio_get_dreq(pio, b->sm, true));
+        channel_config_set_chain_to(&c, (uint)b->dma_chan[i ^ 1u]);
+        dma_channel_configure(chan, &c, &pio->txf[b->sm], b->ring, SG_NUM_EVENTS, false);
+    }
+
+    // FIFO terisi satu periode sebelum state machine diaktifkan bersamaan
+    dma_channel_start((uint)b->dma_chan[0]);
+    b->state = SG_STATE_RUNNING;
+    pio_enable_sm_mask_in_sync(pio, mask);
+    return true;
+}
+
+/**
+ * @brief Menghentikan kedua state machine dan DMA, lalu menahan output LOW.
+ *
+ * Berbeda dengan akhir burst yang diputuskan PIO, stop bisa terjadi di
+ * tengah periode.
+ *
+ * @param b Instance burst
+ */
+void sg_burst_stop(sg_burst_instance *b)
+{
+    if (b->state != SG_STATE_RUNNING)
+    {
+        return;
+    }
+    PIO pio = b->pio;
+    pio_set_sm_mask_enabled(pio, (1u << b->sm) | (1u << b->ctl_sm), false);
+
+    // Putus chain dulu agar abort satu channel tidak memicu pasangannya
+    for (uint i = 0; i < 2; ++i)
+    {
+        dma_channel_config c = dma_get_channel_config((uint)b->dma_chan[i]);
+        channel_config_set_chain_to(&c, (uint)b->dma_chan[i]);
+        dma_channel_set_config((uint)b->dma_chan[i], &c, false);
+    }
+    dma_channel_abort((uint)b->dma_chan[0]);
+    dma_channel_abort((uint)b->dma_chan[1]);
+    pio_sm_clear_fifos(pio, b->sm);
+    pio_interrupt_clear(pio, b->sm);
+
+    uint32_t pin_mask = ((1u << SG_NUM_PINS) - 1u) << b->pin_base;
+    pio_sm_set_pins_with_mask(pio, b->sm, 0, pin_mask);
+    b->state = SG_STATE_IDLE;
+}
+
+/**
+ * @brief Overhead batas periode mode dalam siklus PIO (sudah dikompensasi
+ *        dari delay event D).
+ */
+uint32_t sg_burst_boundary_cycles(sg_burst_mode mode)
+{
+    return (uint)mode < SG_BURST_NUM_MODES ? boundary_cycles[mode] : 0;
+}
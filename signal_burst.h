@@ -0,0 +1,86 @@
+/**
+ * Mode burst generator klasik yang keputusannya diambil oleh PIO.
+ *
+ *   SG_BURST_CONTINUOUS  berjalan terus sampai sg_burst_stop()
+ *   SG_BURST_GATED       keluar selama trigger aktif; level diperiksa di
+ *                        setiap batas periode sehingga output selalu berhenti
+ *                        setelah periode utuh
+ *   SG_BURST_NCYCLE      N periode per edge aktif trigger
+ *   SG_BURST_RETRIGGER   one-shot retriggerable: burst berakhir N periode
+ *                        setelah batas periode terakhir yang melihat trigger
+ *                        aktif, sehingga setiap trigger me-restart timer
+ *
+ * Bentuk periode sama dengan generator klasik (signal_generator.pio). Delay
+ * diputar DMA dari ring 4 word dan keputusan mode diambil oleh `wait`/`jmp
+ * pin` di PIO, sehingga setelah sg_burst_start() CPU tidak ikut campur dan
+ * reaksi terhadap trigger hanya beberapa siklus PIO (SG_BURST_TRIGGER_LATENCY).
+ * Mode N-siklus dan retrigger memakai state machine kontrol kedua (SM
+ * generator + 1) yang mengizinkan satu periode per flag IRQ; overhead batas
+ * periode tiap mode dikompensasi dari delay event D sehingga periode tetap
+ * tepat.
+ *
+ * Di luar burst, output tertahan LOW (level event D) dan state machine
+ * generator stall di batas periode. Trigger aktif-low dinormalisasi dengan
+ * INOVER pin trigger, sehingga gpio_get() pin tersebut ikut terbalik selama
+ * instance di-init.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef SIGNAL_BURST_H
+#define SIGNAL_BURST_H
+
+#include "signal_gen.h"
+
+/**
+ * @brief Semantik trigger burst.
+ */
+typedef enum
+{
+    SG_BURST_CONTINUOUS = 0,
+    SG_BURST_GATED,
+    SG_BURST_NCYCLE,
+    SG_BURST_RETRIGGER,
+    SG_BURST_NUM_MODES,
+} sg_burst_mode;
+
+// Jarak edge trigger -> edge pertama saat generator menunggu (siklus PIO).
+// Gated: wait, pull, mov sebelum set. N-siklus/retrigger: wait pin, mov x,
+// wait irq (SM kontrol), fase kedua irq wait, jmp, pull, mov sebelum set.
+// Di hardware sinkronisasi input GPIO menambah sekitar 2 siklus clk_sys.
+#define SG_BURST_GATED_LATENCY_CYCLES 3
+#define SG_BURST_NCYCLE_LATENCY_CYCLES 7
+#define SG_BURST_RETRIGGER_LATENCY_CYCLES 7
+
+/**
+ * @brief Generator klasik dengan mode burst otonom.
+ */
+typedef struct
+{
+    PIO pio;                          // Blok PIO yang digunakan
+    uint sm;                          // State machine generator
+    uint ctl_sm;                      // State machine kontrol (sm + 1)
+    uint offset;                      // Offset program signal_burst
+    uint ctl_offset;                  // Offset program signal_burst_ctl
+    uint pin_base;                    // Pin pertama dari SG_NUM_PINS pin output
+    uint trigger_pin;                 // Pin input trigger
+    bool active_high;                 // Polaritas trigger
+    sg_burst_mode mode;               // Mode yang dikonfigurasi
+    uint32_t periods;                 // N untuk NCYCLE/RETRIGGER
+    sg_timing_config timing;          // Konfigurasi timing aktif
+    uint32_t sys_clk_hz;              // clk_sys yang dipakai untuk menghitung delay
+    uint32_t ring[SG_NUM_EVENTS] __attribute__((aligned(SG_NUM_EVENTS * sizeof(uint32_t))));
+    int dma_chan[2];                  // Channel DMA ping-pong untuk ring delay
+    sg_state state;
+} sg_burst_instance;
+
+// -- API --
+bool sg_burst_init(sg_burst_instance *b, PIO pio, uint pin_base, uint trigger_pin, bool active_high);
+void sg_burst_deinit(sg_burst_instance *b);
+bool sg_burst_configure(sg_burst_instance *b, const sg_timing_config *timing, sg_burst_mode mode,
+                        uint32_t periods);
+bool sg_burst_start(sg_burst_instance *b);
+void sg_burst_stop(sg_burst_instance *b);
+uint32_t sg_burst_boundary_cycles(sg_burst_mode mode);
+
+#endif
@@ -0,0 +1,387 @@
+/**
+ * Implementasi penghitung periode berbasis token FIFO RX dan DMA ping-pong.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "signal_count.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+
+#define MAX_COUNTERS (NUM_DMA_CHANNELS / 2)
+
+// -- Penghitung Aktif yang Dilayani Handler DMA_IRQ_0 --
+// Handler dipasang oleh penghitung pertama dan dilepas oleh yang terakhir
+static sg_count_instance *active_counters[MAX_COUNTERS];
+static uint active_count;
+
+/**
+ * @brief Handler shared DMA_IRQ_0: satu batch per channel yang selesai.
+ */
+static void __isr __time_critical_func(count_irq_handler)(void)
+{
+    for (uint i = 0; i < MAX_COUNTERS; ++i)
+    {
+        sg_count_instance *cnt = active_counters[i];
+        if (!cnt)
+        {
+            continue;
+        }
+        for (uint k = 0; k < 2; ++k)
+        {
+            uint chan = (uint)cnt->dma_chan[k];
+            if (!dma_channel_get_irq0_status(chan))
+            {
+                continue;
+            }
+            dma_channel_acknowledge_irq0(chan);
+            if (k == 0 && cnt->compare_armed)
+            {
+                // Batch compare selesai: ping-pong biasa sebelum giliran channel ini lagi
+                dma_channel_config c = dma_get_channel_config(chan);
+                channel_config_set_chain_to(&c, (uint)cnt->dma_chan[1]);
+                dma_channel_set_config(chan, &c, false);
+                dma_channel_set_trans_count(chan, cnt->interval, false);
+                cnt->compare_armed = false;
+            }
+            cnt->batches++;
+            cnt->interrupts++;
+            cnt->latch_periods = cnt->base + cnt->batches * cnt->interval;
+            cnt->latch_time_us = time_us_64();
+            if (cnt->callback)
+            {
+                cnt->callback(cnt->callback_ctx, cnt->latch_periods, cnt->latch_time_us);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Status IRQ kedua channel yang belum dilayani handler.
+ */
+static uint32_t pending_batches(const sg_count_instance *cnt)
+{
+    uint32_t pending = 0;
+    for (uint k = 0; k < 2; ++k)
+    {
+        if (dma_channel_get_irq0_status((uint)cnt->dma_chan[k]))
+        {
+            pending |= 1u << k;
+        }
+    }
+    return pending;
+}
+
+/**
+ * @brief Menyiapkan instance penghitung yang belum berjalan.
+ *
+ * @param cnt Instance penghitung
+ */
+void sg_count_init(sg_count_instance *cnt)
+{
+    cnt->pio = NULL;
+    cnt->sm = 0;
+    cnt->dma_chan[0] = -1;
+    cnt->dma_chan[1] = -1;
+    cnt->interval = 0;
+    cnt->sink = 0;
+    cnt->base = 0;
+    cnt->batches = 0;
+    cnt->latch_periods = 0;
+    cnt->latch_time_us = 0;
+    cnt->interrupts = 0;
+    cnt->compare_armed = false;
+    cnt->callback = NULL;
+    cnt->callback_ctx = NULL;
+}
+
+/**
+ * @brief Mulai menghitung periode generator klasik.
+ *
+ * Token yang sudah menumpuk di FIFO RX dibuang, sehingga penghitungan dimulai
+ * dari periode berikutnya. Bisa dipanggil sebelum sg_start()/sg_run_burst()
+ * maupun saat generator berjalan; penghitung tetap berjalan di antara burst.
+ *
+ * @param cnt Instance penghitung (sudah sg_count_init)
+ * @param gen Generator klasik yang sudah di-init
+ * @param interval Periode per callback/interrupt, >= 2 (SG_COUNT_DEFAULT_INTERVAL
+ *        jika hanya butuh jumlah periode)
+ * @param callback Dipanggil dari interrupt setiap `interval` periode, boleh NULL
+ * @param ctx Diteruskan ke callback
+ * @return false jika sudah berjalan, interval tidak valid, atau tidak ada
+ *         channel DMA yang tersisa
+ */
+bool sg_count_start(sg_count_instance *cnt, const sg_instance *gen, uint32_t interval, sg_count_callback callback,
+                    void *ctx)
+{
+    if (gen->state == SG_STATE_UNINIT)
+    {
+        return false;
+    }
+    return sg_count_start_sm(cnt, gen->pio, gen->sm, interval, callback, ctx);
+}
+
+/**
+ * @brief Mulai menghitung periode state machine lain yang mendorong satu
+ *        token per periode dengan format yang sama (misalnya signal_burst).
+ *
+ * @param cnt Instance penghitung (sudah sg_count_init)
+ * @param pio Blok PIO generator
+ * @param sm State machine generator
+ * @param interval Lihat sg_count_start()
+ * @param callback Lihat sg_count_start()
+ * @param ctx Diteruskan ke callback
+ * @return false jika sudah berjalan, interval tidak valid, atau tidak ada
+ *         channel DMA yang tersisa
+ */
+bool sg_count_start_sm(sg_count_instance *cnt, PIO pio, uint sm, uint32_t interval, sg_count_callback callback,
+                       void *ctx)
+{
+    if (sg_count_is_running(cnt) || interval < 2 || active_count == MAX_COUNTERS)
+    {
+        return false;
+    }
+    int chan[2];
+    chan[0] = dma_claim_unused_channel(false);
+    chan[1] = chan[0] < 0 ? -1 : dma_claim_unused_channel(false);
+    if (chan[1] < 0)
+    {
+        if (chan[0] >= 0)
+        {
+            dma_channel_unclaim((uint)chan[0]);
+        }
+        return false;
+    }
+
+    cnt->pio = pio;
+    cnt->sm = sm;
+    cnt->interval = interval;
+    cnt->batches = 0;
+    cnt->callback = callback;
+    cnt->callback_ctx = ctx;
+    while (!pio_sm_is_rx_fifo_empty(pio, sm))
+    {
+        (void)pio_sm_get(pio, sm);
+    }
+
+    for (uint k = 0; k < 2; ++k)
+    {
+        dma_channel_config c = dma_channel_get_default_config((uint)chan[k]);
+        channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+        channel_config_set_read_increment(&c, false);
+        channel_config_set_write_increment(&c, false);
+        channel_config_set_dreq(&c, pio_get_dreq(pio, sm, false));
+        channel_config_set_chain_to(&c, (uint)chan[k ^ 1u]);
+        dma_channel_configure((uint)chan[k], &c, &cnt->sink, &pio->rxf[sm], interval, false);
+        dma_channel_acknowledge_irq0((uint)chan[k]);
+    }
+    cnt->dma_chan[0] = chan[0];
+    cnt->dma_chan[1] = chan[1];
+
+    for (uint i = 0; i < MAX_COUNTERS; ++i)
+    {
+        if (!active_counters[i])
+        {
+            active_counters[i] = cnt;
+            break;
+        }
+    }
+    if (active_count++ == 0)
+    {
+        irq_add_shared_handler(DMA_IRQ_0, count_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+        irq_set_enabled(DMA_IRQ_0, true);
+    }
+    dma_set_irq0_channel_mask_enabled((1u << chan[0]) | (1u << chan[1]), true);
+    dma_channel_start((uint)chan[0]);
+    return true;
+}
+
+/**
+ * @brief Menghentikan penghitung dan melepaskan channel DMA.
+ *
+ * Jumlah periode yang sudah terhitung dipertahankan untuk sg_count_periods()
+ * dan dilanjutkan oleh sg_count_start() berikutnya.
+ *
+ * @param cnt Instance penghitung
+ */
+void sg_count_stop(sg_count_instance *cnt)
+{
+    if (!sg_count_is_running(cnt))
+    {
+        return;
+    }
+    uint32_t mask = (1u << cnt->dma_chan[0]) | (1u << cnt->dma_chan[1]);
+    uint32_t status = save_and_disable_interrupts();
+    uint64_t total = sg_count_periods(cnt);
+    dma_set_irq0_channel_mask_enabled(mask, false);
+    for (uint k = 0; k < 2; ++k)
+    {
+        // Abort bisa menyetel status IRQ (RP2040-E13), jadi di-acknowledge sesudahnya
+        dma_channel_abort((uint)cnt->dma_chan[k]);
+        dma_channel_acknowledge_irq0((uint)cnt->dma_chan[k]);
+        dma_channel_unclaim((uint)cnt->dma_chan[k]);
+        cnt->dma_chan[k] = -1;
+    }
+    cnt->base = total;
+    cnt->batches = 0;
+    cnt->compare_armed = false;
+    for (uint i = 0; i < MAX_COUNTERS; ++i)
+    {
+        if (active_counters[i] == cnt)
+        {
+            active_counters[i] = NULL;
+        }
+    }
+    if (--active_count == 0)
+    {
+        // Status channel sudah di-acknowledge; pending NVIC yang tersisa
+        // dibersihkan agar tidak jatuh ke handler default setelah dilepas
+        irq_clear(DMA_IRQ_0);
+        irq_remove_handler(DMA_IRQ_0, count_irq_handler);
+    }
+    restore_interrupts(status);
+}
+
+/**
+ * @brief Memulai ulang kedua channel dari jumlah periode saat ini: channel
+ *        pertama menghitung `first` token lalu chain ke `chain_to`.
+ *
+ * Dipanggil dengan interrupt dimatikan.
+ */
+static void restart_channels(sg_count_instance *cnt, uint32_t first, uint chain_to)
+{
+    uint64_t total = sg_count_periods(cnt);
+    for (uint k = 0; k < 2; ++k)
+    {
+        dma_channel_abort((uint)cnt->dma_chan[k]);
+        dma_channel_acknowledge_irq0((uint)cnt->dma_chan[k]);
+    }
+    // Batch pertama berisi `first` token, bukan interval: base dikoreksi
+    // (modulo 2^64) agar rumus sg_count_periods() tetap berlaku
+    cnt->base = total + first - cnt->interval;
+    cnt->batches = 0;
+    uint chan = (uint)cnt->dma_chan[0];
+    dma_channel_config c = dma_get_channel_config(chan);
+    channel_config_set_chain_to(&c, chain_to);
+    dma_channel_set_config(chan, &c, false);
+    dma_channel_set_trans_count(chan, first, false);
+    dma_channel_start(chan);
+}
+
+/**
+ * @brief Menjalankan satu transfer DMA tepat setelah `periods` token
+ *        berikutnya, tanpa pembaca FIFO RX kedua.
+ *
+ * Channel `chan` milik pemanggil dikonfigurasi untuk menyalin satu word dari
+ * read_addr ke write_addr lalu chain ke channel kedua penghitung, sehingga
+ * penghitungan berlanjut tanpa celah. Panggil selagi generator tidak
+ * mendorong token (berhenti atau menunggu trigger): token yang tiba di
+ * tengah restart channel bisa terlewat.
+ *
+ * @param cnt Instance penghitung yang sedang berjalan
+ * @param periods Token sebelum transfer, >= 1
+ * @param chan Channel DMA milik pemanggil, tidak dipakai selama compare aktif
+ * @param write_addr Tujuan word (mis. register channel DMA lain)
+ * @param read_addr Sumber word
+ * @return false jika penghitung tidak berjalan atau periods 0
+ */
+bool sg_count_set_compare(sg_count_instance *cnt, uint32_t periods, uint chan, volatile void *write_addr,
+                          const volatile void *read_addr)
+{
+    if (!sg_count_is_running(cnt) || periods == 0)
+    {
+        return false;
+    }
+    dma_channel_config c = dma_channel_get_default_config(chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_chain_to(&c, (uint)cnt->dma_chan[1]);
+    channel_config_set_irq_quiet(&c, true);
+    dma_channel_configure(chan, &c, write_addr, read_addr, 1, false);
+
+    uint32_t status = save_and_disable_interrupts();
+    restart_channels(cnt, periods, chan);
+    cnt->compare_armed = true;
+    restore_interrupts(status);
+    return true;
+}
+
+/**
+ * @brief Membatalkan compare yang belum tercapai; penghitungan berlanjut.
+ *
+ * Setelah kembali, channel compare pemanggil tidak lagi di-chain dan boleh
+ * di-abort atau dipakai ulang.
+ *
+ * @param cnt Instance penghitung
+ */
+void sg_count_clear_compare(sg_count_instance *cnt)
+{
+    uint32_t status = save_and_disable_interrupts();
+    if (sg_count_is_running(cnt) && cnt->compare_armed)
+    {
+        restart_channels(cnt, cnt->interval, (uint)cnt->dma_chan[1]);
+        cnt->compare_armed = false;
+    }
+    restore_interrupts(status);
+}
+
+/**
+ * @brief Jumlah periode yang sudah dikeluarkan, tepat per periode.
+ *
+ * Batch yang sudah selesai tetapi belum dilayani handler ikut dihitung lewat
+ * status IRQ channel. Pembacaan diulang jika DMA berpindah channel di
+ * tengah pembacaan.
+ *
+ * @param cnt Instance penghitung
+ * @return Jumlah periode sejak sg_count_init()
+ */
+uint64_t __time_critical_func(sg_count_periods)(const sg_count_instance *cnt)
+{
+    if (!sg_count_is_running(cnt))
+    {
+        return cnt->base;
+    }
+    uint32_t status = save_and_disable_interrupts();
+    uint64_t total;
+    while (true)
+    {
+        uint32_t pending = pending_batches(cnt);
+        uint k = dma_channel_is_busy((uint)cnt->dma_chan[0]) ? 0 : 1;
+        uint32_t remaining = dma_channel_hw_addr((uint)cnt->dma_chan[k])->transfer_count;
+        if (dma_channel_is_busy((uint)cnt->dma_chan[k]) && pending_batches(cnt) == pending)
+        {
+            uint64_t batches = cnt->batches + (uint)__builtin_popcount(pending);
+            // Batch compare bisa lebih panjang dari interval: selisih modulo 2^64
+            total = cnt->base + batches * cnt->interval + ((uint64_t)cnt->interval - remaining);
+            break;
+        }
+    }
+    restore_interrupts(status);
+    return total;
+}
+
+/**
+ * @brief Membaca latch terakhir (setiap `interval` periode) secara konsisten.
+ *
+ * @param cnt Instance penghitung
+ * @param periods Jumlah periode saat latch, boleh NULL
+ * @param time_us time_us_64() saat latch, boleh NULL
+ * @return false jika belum pernah ada latch
+ */
+bool sg_count_last_latch(const sg_count_instance *cnt, uint64_t *periods, uint64_t *time_us)
+{
+    uint32_t status = save_and_disable_interrupts();
+    uint64_t latch_periods = cnt->latch_periods;
+    uint64_t latch_time_us = cnt->latch_time_us;
+    restore_interrupts(status);
+    if (periods)
+    {
+        *periods = latch_periods;
+    }
+    if (time_us)
+    {
+        *time_us = latch_time_us;
+    }
+    return latch_periods != 0;
+}
@@ -0,0 +1,92 @@
+/**
+ * Penghitung periode 64-bit untuk generator klasik tanpa wakeup per periode.
+ *
+ * Program signal_generator mendorong satu token ke FIFO RX di awal event D
+ * setiap periode. Dua channel DMA ping-pong (saling chain) menguras token itu
+ * ke satu word dummy dengan DREQ RX, masing-masing sebanyak `interval` token.
+ * CPU hanya dibangunkan oleh DMA_IRQ_0 setiap `interval` periode: handler
+ * menambah penghitung batch, me-latch time_us_64() beserta jumlah periode,
+ * lalu memanggil callback opsional.
+ *
+ * sg_count_periods() menggabungkan jumlah batch dengan sisa transfer_count
+ * channel yang sedang berjalan, sehingga hasilnya tepat per periode kapan pun
+ * dibaca. Token dihitung saat event D dimulai, yaitu setelah pulsa A..C
+ * periode tersebut selesai dikeluarkan. Waktu latch adalah waktu handler
+ * berjalan (token ke-N ditambah latensi interrupt), bukan awal periode.
+ *
+ * sg_count_start_sm() memakai SM mana pun yang menjalankan badan periode yang
+ * sama (mis. generator signal_burst) tanpa memeriksa instance sg_instance.
+ *
+ * Penghitung adalah satu-satunya pembaca FIFO RX generator. Pemakai lain
+ * yang butuh aksi tepat setelah n periode (BURS:NCYC di signal_scpi) memakai
+ * sg_count_set_compare(): channel pertama dimulai ulang dengan n token dan
+ * chain ke channel milik pemanggil, yang menyalin satu word lalu chain ke
+ * channel kedua. Handler interrupt mengembalikan channel pertama ke
+ * `interval` token sebelum gilirannya lagi; jumlah periode tetap tepat.
+ *
+ * Handler interrupt harus berjalan sebelum channel yang sama selesai lagi
+ * (kurang dari 2 x interval periode), jika tidak satu batch akan hilang.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef SIGNAL_COUNT_H
+#define SIGNAL_COUNT_H
+
+#include "signal_gen.h"
+#include "hardware/dma.h"
+
+// Interval default jika tidak butuh callback: interrupt hampir tidak pernah terjadi
+#define SG_COUNT_DEFAULT_INTERVAL (1u << 30)
+
+/**
+ * @brief Callback setiap `interval` periode, dipanggil dari handler interrupt.
+ *
+ * @param ctx Pointer yang diberikan ke sg_count_start()
+ * @param periods Jumlah periode total saat batch selesai
+ * @param time_us time_us_64() saat handler berjalan
+ */
+typedef void (*sg_count_callback)(void *ctx, uint64_t periods, uint64_t time_us);
+
+/**
+ * @brief Penghitung periode untuk satu instance generator.
+ */
+typedef struct
+{
+    PIO pio;                          // Blok PIO generator yang dihitung
+    uint sm;                          // State machine generator
+    int dma_chan[2];                  // Channel DMA ping-pong, -1 jika tidak berjalan
+    uint32_t interval;                // Periode per batch DMA dan per callback
+    uint32_t sink;                    // Tujuan DMA untuk token yang dibuang
+    uint64_t base;                    // Periode dari sesi sebelum sg_count_stop()
+    volatile uint64_t batches;        // Batch selesai sejak sg_count_start() (ISR)
+    volatile uint64_t latch_periods;  // Jumlah periode saat latch terakhir
+    volatile uint64_t latch_time_us;  // time_us_64() saat latch terakhir
+    volatile uint32_t interrupts;     // Jumlah pemanggilan handler untuk counter ini
+    volatile bool compare_armed;      // Batch channel pertama berakhir di channel compare
+    sg_count_callback callback;
+    void *callback_ctx;
+} sg_count_instance;
+
+// -- API --
+void sg_count_init(sg_count_instance *cnt);
+bool sg_count_start(sg_count_instance *cnt, const sg_instance *gen, uint32_t interval, sg_count_callback callback,
+                    void *ctx);
+bool sg_count_start_sm(sg_count_instance *cnt, PIO pio, uint sm, uint32_t interval, sg_count_callback callback,
+                       void *ctx);
+void sg_count_stop(sg_count_instance *cnt);
+bool sg_count_set_compare(sg_count_instance *cnt, uint32_t periods, uint chan, volatile void *write_addr,
+                          const volatile void *read_addr);
+void sg_count_clear_compare(sg_count_instance *cnt);
+uint64_t sg_count_periods(const sg_count_instance *cnt);
+bool sg_count_last_latch(const sg_count_instance *cnt, uint64_t *periods, uint64_t *time_us);
+
+/**
+ * @brief Memeriksa apakah penghitung sedang berjalan.
+ */
+static inline bool sg_count_is_running(const sg_count_instance *cnt)
+{
+    return cnt->dma_chan[0] >= 0;
+}
+
+#endif
@@ -0,0 +1,231 @@
+/**
+ * Implementasi disiplin frekuensi terhadap referensi PPS / 10 MHz.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "signal_discipline.h"
+#include "hardware/clocks.h"
+#include "signal_discipline.pio.h" // Header yang di-generate otomatis
+
+// -- Program PIO yang Dimuat per Blok PIO --
+static struct
+{
+    uint offset;
+    uint users;
+} loaded_program[NUM_PIOS];
+
+/**
+ * @brief Mengosongkan jendela estimasi; estimasi ppm terakhir dipertahankan.
+ */
+static void reset_window(sg_discipline_instance *d)
+{
+    d->window_count = 0;
+    d->window_next = 0;
+    d->window_sum = 0;
+}
+
+/**
+ * @brief Menginisialisasi pengukur referensi tanpa menjalankannya.
+ *
+ * Pin referensi harus sudah dikonfigurasi sebagai input oleh pemanggil.
+ * Gerbang dibatasi agar register X tidak habis: kurang dari 2^32 siklus
+ * clk_sys (sekitar 34 detik pada 125 MHz).
+ *
+ * @param d Instance yang akan diinisialisasi
+ * @param pio Blok PIO untuk state machine pengukur
+ * @param ref_pin GPIO input referensi
+ * @param ref_hz Frekuensi nominal referensi (1 untuk PPS)
+ * @param edges_per_gate Edge naik referensi per gerbang (mis. 1 untuk PPS,
+ *        10000000 untuk 10 MHz = gerbang 1 detik)
+ * @return false jika parameter tidak valid, atau tidak ada state machine
+ *         maupun instruction memory yang tersisa
+ */
+bool sg_discipline_init(sg_discipline_instance *d, PIO pio, uint ref_pin, float ref_hz, uint32_t edges_per_gate)
+{
+    uint32_t sys_clk_hz = clock_get_hz(clk_sys);
+    double nominal_cycles = (double)sys_clk_hz * (double)edges_per_gate / (double)ref_hz;
+    if (ref_hz <= 0.0f || edges_per_gate == 0 || nominal_cycles >= 4294967296.0)
+    {
+        return false;
+    }
+
+    int sm = pio_claim_unused_sm(pio, false);
+    if (sm < 0)
+    {
+        return false;
+    }
+    uint pio_index = pio_get_index(pio);
+    if (loaded_program[pio_index].users == 0)
+    {
+        if (!pio_can_add_program(pio, &signal_ref_capture_program))
+        {
+            pio_sm_unclaim(pio, (uint)sm);
+            return false;
+        }
+        loaded_program[pio_index].offset = pio_add_program(pio, &signal_ref_capture_program);
+    }
+    loaded_program[pio_index].users++;
+
+    d->pio = pio;
+    d->sm = (uint)sm;
+    d->offset = loaded_program[pio_index].offset;
+    d->ref_pin = ref_pin;
+    d->edges_per_gate = edges_per_gate;
+    d->sys_clk_hz = sys_clk_hz;
+    d->nominal_cycles = nominal_cycles;
+    d->gate_us = (uint64_t)(1e6 * (double)edges_per_gate / (double)ref_hz);
+    reset_window(d);
+    d->skip_gate = true;
+    d->last_gate_us = 0;
+    d->ppm = 0.0;
+    d->resolution_ppb = 0.0;
+    d->gates = 0;
+    d->rejected = 0;
+    d->state = SG_DISCIPLINE_NO_REF;
+    d->running = false;
+
+    // Clock divider default 1: pengukur selalu menghitung clk_sys penuh
+    pio_sm_config c = signal_ref_capture_program_get_default_config(d->offset);
+    sm_config_set_in_pins(&c, ref_pin);
+    sm_config_set_jmp_pin(&c, ref_pin);
+    pio_sm_init(pio, d->sm, d->offset, &c);
+    return true;
+}
+
+/**
+ * @brief Menghentikan pengukur dan melepaskan state machine serta program PIO.
+ *
+ * @param d Instance yang akan dilepas
+ */
+void sg_discipline_deinit(sg_discipline_instance *d)
+{
+    sg_discipline_stop(d);
+    pio_sm_unclaim(d->pio, d->sm);
+
+    uint pio_index = pio_get_index(d->pio);
+    if (--loaded_program[pio_index].users == 0)
+    {
+        pio_remove_program(d->pio, &signal_ref_capture_program, d->offset);
+    }
+}
+
+/**
+ * @brief Memulai pengukuran dari awal; estimasi ppm sebelumnya dipertahankan
+ *        sampai jendela baru menghasilkan estimasi.
+ *
+ * @param d Instance pengukur
+ */
+void sg_discipline_start(sg_discipline_instance *d)
+{
+    PIO pio = d->pio;
+    uint sm = d->sm;
+
+    pio_sm_set_enabled(pio, sm, false);
+    pio_sm_clear_fifos(pio, sm);
+    pio_sm_restart(pio, sm);
+    pio_sm_exec(pio, sm, pio_encode_jmp(d->offset));
+    pio_sm_put(pio, sm, d->edges_per_gate - 1);
+    reset_window(d);
+    d->skip_gate = true;
+    d->last_gate_us = time_us_64();
+    d->running = true;
+    pio_sm_set_enabled(pio, sm, true);
+}
+
+/**
+ * @brief Menghentikan pengukuran. Status dan estimasi terakhir dipertahankan.
+ *
+ * @param d Instance pengukur
+ */
+void sg_discipline_stop(sg_discipline_instance *d)
+{
+    pio_sm_set_enabled(d->pio, d->sm, false);
+    d->running = false;
+}
+
+/**
+ * @brief Memproses gerbang yang sudah selesai dan memperbarui estimasi.
+ *
+ * Non-blocking; panggil dari loop utama minimal sekali per 4 gerbang.
+ *
+ * @param d Instance pengukur yang berjalan
+ * @return true jika estimasi ppm atau status berubah
+ */
+bool sg_discipline_poll(sg_discipline_instance *d)
+{
+    if (!d->running)
+    {
+        return false;
+    }
+
+    sg_discipline_state prev_state = d->state;
+    bool updated = false;
+    while (!pio_sm_is_rx_fifo_empty(d->pio, d->sm))
+    {
+        uint32_t decrements = ~pio_sm_get(d->pio, d->sm);
+        uint64_t cycles = 2ull * decrements + d->edges_per_gate + SG_DISCIPLINE_GATE_OVERHEAD_CYCLES;
+        d->last_gate_us = time_us_64();
+
+        // Gerbang pertama diawali `wait` sehingga panjangnya tidak tepat
+        if (d->skip_gate)
+        {
+            d->skip_gate = false;
+            continue;
+        }
+        double gate_ppm = ((double)cycles / d->nominal_cycles - 1.0) * 1e6;
+        if (gate_ppm > SG_DISCIPLINE_MAX_PPM || gate_ppm < -SG_DISCIPLINE_MAX_PPM)
+        {
+            d->rejected++;
+            reset_window(d);
+            continue;
+        }
+
+        if (d->window_count == SG_DISCIPLINE_WINDOW)
+        {
+            d->window_sum -= d->window[d->window_next];
+        }
+        else
+        {
+            d->window_count++;
+        }
+        d->window[d->window_next] = cycles;
+        d->window_sum += cycles;
+        d->window_next = (d->window_next + 1) % SG_DISCIPLINE_WINDOW;
+        d->gates++;
+
+        double expected = d->nominal_cycles * (double)d->window_count;
+        d->ppm = ((double)d->window_sum / expected - 1.0) * 1e6;
+        d->resolution_ppb = 2.0 / (double)d->window_sum * 1e9;
+        d->state = d->window_count == SG_DISCIPLINE_WINDOW ? SG_DISCIPLINE_LOCKED : SG_DISCIPLINE_ACQUIRING;
+        updated = true;
+    }
+
+    // Referensi hilang jika dua gerbang lewat tanpa hasil
+    if (d->state != SG_DISCIPLINE_NO_REF && d->state != SG_DISCIPLINE_HOLDOVER &&
+        time_us_64() - d->last_gate_us > 2 * d->gate_us)
+    {
+        d->state = SG_DISCIPLINE_HOLDOVER;
+        reset_window(d);
+    }
+    return updated || d->state != prev_state;
+}
+
+/**
+ * @brief Nama status untuk laporan USB.
+ */
+const char *sg_discipline_state_name(sg_discipline_state state)
+{
+    switch (state)
+    {
+    case SG_DISCIPLINE_NO_REF:
+        return "NO_REF";
+    case SG_DISCIPLINE_ACQUIRING:
+        return "ACQUIRING";
+    case SG_DISCIPLINE_LOCKED:
+        return "LOCKED";
+    case SG_DISCIPLINE_HOLDOVER:
+        return "HOLDOVER";
+    }
+    return "?";
+}
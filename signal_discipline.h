@@ -0,0 +1,89 @@
+/**
+ * Disiplin frekuensi output terhadap referensi eksternal (1 PPS atau 10 MHz).
+ *
+ * State machine pengukur (signal_ref_capture, clock divider 1) menghitung
+ * siklus clk_sys di setiap gerbang `edges_per_gate` edge naik referensi dan
+ * mendorong hasilnya ke FIFO RX. sg_discipline_poll(), dipanggil dari loop
+ * utama, menjumlah SG_DISCIPLINE_WINDOW gerbang terakhir dan membandingkannya
+ * dengan clock_get_hz(clk_sys) nominal. Karena gerbang bersambung tanpa
+ * celah, galat kuantisasi hanya 2 siklus per jendela: dengan 1 PPS dan
+ * jendela 16 detik resolusinya sekitar 1 ppb pada 125 MHz.
+ *
+ * Estimasi ppm diterapkan ke generator dengan sg_trim_clock(), yang men-dither
+ * panjang event D sehingga frekuensi output jangka panjang mengikuti
+ * referensi, bukan kristal board.
+ *
+ *   SG_DISCIPLINE_NO_REF     belum ada gerbang valid
+ *   SG_DISCIPLINE_ACQUIRING  estimasi ada, jendela belum penuh
+ *   SG_DISCIPLINE_LOCKED     jendela penuh
+ *   SG_DISCIPLINE_HOLDOVER   referensi hilang; estimasi terakhir dipertahankan
+ *
+ * Gerbang yang menyimpang lebih dari SG_DISCIPLINE_MAX_PPM (pulsa hilang
+ * atau glitch) ditolak dan jendela diulang. FIFO RX menampung 4 gerbang,
+ * sehingga poll boleh tertunda (mis. selama sg_run_burst()) hingga 4 gerbang
+ * tanpa merusak estimasi; gerbang yang terlewat hanya hilang dari jendela.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef SIGNAL_DISCIPLINE_H
+#define SIGNAL_DISCIPLINE_H
+
+#include "signal_gen.h"
+
+// Jumlah gerbang yang dijumlah untuk satu estimasi
+#define SG_DISCIPLINE_WINDOW 16
+
+// Batas selisih gerbang terhadap nominal sebelum dianggap glitch
+#define SG_DISCIPLINE_MAX_PPM 1000.0
+
+// Overhead tetap gerbang: panjang = 2 x decrement + edge + overhead
+#define SG_DISCIPLINE_GATE_OVERHEAD_CYCLES 5
+
+/**
+ * @brief Status konvergensi disiplin.
+ */
+typedef enum
+{
+    SG_DISCIPLINE_NO_REF = 0,
+    SG_DISCIPLINE_ACQUIRING,
+    SG_DISCIPLINE_LOCKED,
+    SG_DISCIPLINE_HOLDOVER,
+} sg_discipline_state;
+
+/**
+ * @brief Pengukur referensi dan estimasi kesalahan clk_sys.
+ */
+typedef struct
+{
+    PIO pio;                                  // Blok PIO pengukur
+    uint sm;                                  // State machine pengukur
+    uint offset;                              // Offset program signal_ref_capture
+    uint ref_pin;                             // Pin input referensi
+    uint32_t edges_per_gate;                  // Edge naik referensi per gerbang
+    uint32_t sys_clk_hz;                      // clk_sys nominal
+    double nominal_cycles;                    // Siklus clk_sys nominal per gerbang
+    uint64_t gate_us;                         // Panjang gerbang nominal (us)
+    uint64_t window[SG_DISCIPLINE_WINDOW];    // Siklus clk_sys per gerbang
+    uint window_count;                        // Isi jendela
+    uint window_next;                         // Slot berikutnya di jendela
+    uint64_t window_sum;                      // Jumlah isi jendela
+    bool skip_gate;                           // Gerbang berikutnya dibuang
+    uint64_t last_gate_us;                    // time_us_64() saat gerbang terakhir diterima
+    double ppm;                               // Kesalahan clk_sys (positif = lebih cepat)
+    double resolution_ppb;                    // Galat kuantisasi estimasi saat ini
+    uint32_t gates;                           // Gerbang diterima
+    uint32_t rejected;                        // Gerbang ditolak
+    sg_discipline_state state;
+    bool running;
+} sg_discipline_instance;
+
+// -- API --
+bool sg_discipline_init(sg_discipline_instance *d, PIO pio, uint ref_pin, float ref_hz, uint32_t edges_per_gate);
+void sg_discipline_deinit(sg_discipline_instance *d);
+void sg_discipline_start(sg_discipline_instance *d);
+void sg_discipline_stop(sg_discipline_instance *d);
+bool sg_discipline_poll(sg_discipline_instance *d);
+const char *sg_discipline_state_name(sg_discipline_state state);
+
+#endif
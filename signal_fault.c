@@ -0,0 +1,242 @@
+/**
+ * Implementasi input fault hardware berbasis state machine watchdog.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "signal_fault.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "signal_fault.pio.h" // Header yang di-generate otomatis
+
+// -- Watchdog Aktif (dibaca handler PIO IRQ 0) --
+#define MAX_FAULTS (NUM_PIOS * NUM_PIO_STATE_MACHINES)
+static sg_fault_instance *active_faults[MAX_FAULTS];
+
+// -- Program PIO yang Dimuat per Blok PIO --
+// Handler PIO IRQ 0 blok tersebut terpasang selama ada pengguna
+static struct
+{
+    uint offset;
+    uint users;
+} loaded_program[NUM_PIOS];
+
+static inline enum pio_interrupt_source fault_source(const sg_fault_instance *f)
+{
+    return (enum pio_interrupt_source)(pis_interrupt0 + f->sm);
+}
+
+/**
+ * @brief Handler shared PIO IRQ 0: melaporkan fault yang baru ter-latch.
+ *
+ * Flag IRQ PIO tetap diset sebagai latch; sumber interrupt-nya dimatikan
+ * sampai sg_fault_clear() agar handler tidak dipanggil berulang.
+ */
+static void __isr __time_critical_func(fault_irq_handler)(void)
+{
+    for (uint i = 0; i < MAX_FAULTS; ++i)
+    {
+        sg_fault_instance *f = active_faults[i];
+        if (!f || f->tripped || !pio_interrupt_get(f->pio, f->sm))
+        {
+            continue;
+        }
+        pio_set_irq0_source_enabled(f->pio, fault_source(f), false);
+        f->tripped = true;
+        f->trips++;
+        f->trip_time_us = time_us_64();
+        if (f->callback)
+        {
+            f->callback(f->callback_ctx, f->trip_time_us);
+        }
+    }
+}
+
+/**
+ * @brief Menginisialisasi dan langsung mengaktifkan watchdog fault.
+ *
+ * Watchdog mengklaim state machine bebas bernomor tertinggi di blok PIO.
+ * Jika fault sudah aktif saat init, output langsung ditarik LOW dan fault
+ * ter-latch. Pin fault harus sudah dikonfigurasi sebagai input oleh
+ * pemanggil.
+ *
+ * @param f Instance yang akan diinisialisasi
+ * @param pio Blok PIO generator yang dijaga
+ * @param pin_base Pin pertama dari SG_NUM_PINS pin output yang dijaga
+ * @param fault_pin GPIO input fault
+ * @param active_high true = fault aktif saat HIGH, false = aktif saat LOW
+ * @param guarded_sm_mask State machine yang menggerakkan pin output
+ * @param callback Callback opsional saat fault ter-latch (konteks interrupt)
+ * @param ctx Diteruskan ke callback
+ * @return false jika tidak ada state machine bebas yang bernomor lebih
+ *         tinggi dari semua SM di guarded_sm_mask, atau instruction memory
+ *         tidak cukup
+ */
+bool sg_fault_init(sg_fault_instance *f, PIO pio, uint pin_base, uint fault_pin, bool active_high,
+                   uint32_t guarded_sm_mask, sg_fault_callback callback, void *ctx)
+{
+    int sm = -1;
+    for (int i = NUM_PIO_STATE_MACHINES - 1; i >= 0 && sm < 0; --i)
+    {
+        if (!pio_sm_is_claimed(pio, (uint)i))
+        {
+            sm = i;
+        }
+    }
+    // SM bernomor lebih tinggi menang saat menulis pin pada siklus yang sama
+    if (sm < 0 || (guarded_sm_mask >> (uint)sm) != 0)
+    {
+        return false;
+    }
+
+    uint slot = MAX_FAULTS;
+    for (uint i = 0; i < MAX_FAULTS && slot == MAX_FAULTS; ++i)
+    {
+        if (!active_faults[i])
+        {
+            slot = i;
+        }
+    }
+    if (slot == MAX_FAULTS)
+    {
+        return false;
+    }
+
+    uint pio_index = pio_get_index(pio);
+    if (loaded_program[pio_index].users == 0)
+    {
+        if (!pio_can_add_program(pio, &signal_fault_program))
+        {
+            return false;
+        }
+        loaded_program[pio_index].offset = pio_add_program(pio, &signal_fault_program);
+    }
+
+    pio_sm_claim(pio, (uint)sm);
+    f->pio = pio;
+    f->sm = (uint)sm;
+    f->offset = loaded_program[pio_index].offset;
+    f->pin_base = pin_base;
+    f->fault_pin = fault_pin;
+    f->active_high = active_high;
+    f->tripped = false;
+    f->trip_time_us = 0;
+    f->trips = 0;
+    f->callback = callback;
+    f->callback_ctx = ctx;
+
+    // Fault dinormalisasi ke aktif-high untuk `wait 1 pin`
+    gpio_set_inover(fault_pin, active_high ? GPIO_OVERRIDE_NORMAL : GPIO_OVERRIDE_INVERT);
+
+    // Clock divider default 1: watchdog selalu berjalan pada clk_sys penuh
+    pio_sm_config c = signal_fault_program_get_default_config(f->offset);
+    sm_config_set_sideset_pins(&c, pin_base);
+    sm_config_set_in_pins(&c, fault_pin);
+    for (uint i = 0; i < SG_NUM_PINS; ++i)
+    {
+        pio_gpio_init(pio, pin_base + i);
+    }
+    pio_sm_set_consecutive_pindirs(pio, f->sm, pin_base, SG_NUM_PINS, true);
+    pio_sm_init(pio, f->sm, f->offset, &c);
+    pio_interrupt_clear(pio, f->sm);
+
+    active_faults[slot] = f;
+    if (loaded_program[pio_index].users++ == 0)
+    {
+        uint irq_num = pio_get_irq_num(pio, 0);
+        irq_add_shared_handler(irq_num, fault_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+        irq_set_enabled(irq_num, true);
+    }
+    pio_set_irq0_source_enabled(pio, fault_source(f), true);
+
+    f->state = SG_STATE_RUNNING;
+    pio_sm_set_enabled(pio, f->sm, true);
+    return true;
+}
+
+/**
+ * @brief Menghentikan watchdog dan melepaskan state machine, program PIO,
+ *        handler interrupt, serta override pin fault.
+ *
+ * Output yang sedang ditahan LOW tidak lagi dijaga setelah fungsi ini.
+ *
+ * @param f Instance yang akan dilepas
+ */
+void sg_fault_deinit(sg_fault_instance *f)
+{
+    if (f->state == SG_STATE_UNINIT)
+    {
+        return;
+    }
+    uint32_t status = save_and_disable_interrupts();
+    pio_sm_set_enabled(f->pio, f->sm, false);
+    pio_set_irq0_source_enabled(f->pio, fault_source(f), false);
+    pio_interrupt_clear(f->pio, f->sm);
+    for (uint i = 0; i < MAX_FAULTS; ++i)
+    {
+        if (active_faults[i] == f)
+        {
+            active_faults[i] = NULL;
+        }
+    }
+
+    uint pio_index = pio_get_index(f->pio);
+    if (--loaded_program[pio_index].users == 0)
+    {
+        uint irq_num = pio_get_irq_num(f->pio, 0);
+        irq_clear(irq_num);
+        irq_remove_handler(irq_num, fault_irq_handler);
+        pio_remove_program(f->pio, &signal_fault_program, f->offset);
+    }
+    restore_interrupts(status);
+
+    gpio_set_inover(f->fault_pin, GPIO_OVERRIDE_NORMAL);
+    pio_sm_unclaim(f->pio, f->sm);
+    f->state = SG_STATE_UNINIT;
+}
+
+/**
+ * @brief Memeriksa latch fault langsung dari flag IRQ PIO.
+ *
+ * Berlaku juga sebelum handler interrupt sempat berjalan (misalnya saat
+ * interrupt sedang dimatikan).
+ *
+ * @param f Instance watchdog
+ * @return true jika fault ter-latch dan output sedang ditahan LOW
+ */
+bool sg_fault_is_latched(const sg_fault_instance *f)
+{
+    return f->state != SG_STATE_UNINIT && pio_interrupt_get(f->pio, f->sm);
+}
+
+/**
+ * @brief Melepas latch fault dan mengaktifkan kembali watchdog.
+ *
+ * Output tetap LOW sampai state machine generator menulisnya lagi; generator
+ * yang masih berjalan langsung melanjutkan output, jadi hentikan generator
+ * lebih dulu jika tidak diinginkan.
+ *
+ * @param f Instance watchdog
+ * @return false jika input fault masih aktif (latch dipertahankan)
+ */
+bool sg_fault_clear(sg_fault_instance *f)
+{
+    if (f->state == SG_STATE_UNINIT)
+    {
+        return false;
+    }
+    // Level sudah dinormalisasi INOVER: HIGH = fault aktif
+    if (gpio_get(f->fault_pin))
+    {
+        return false;
+    }
+
+    pio_sm_set_enabled(f->pio, f->sm, false);
+    pio_sm_restart(f->pio, f->sm);
+    pio_sm_exec(f->pio, f->sm, pio_encode_jmp(f->offset));
+    pio_interrupt_clear(f->pio, f->sm);
+    f->tripped = false;
+    pio_set_irq0_source_enabled(f->pio, fault_source(f), true);
+    pio_sm_set_enabled(f->pio, f->sm, true);
+    return true;
+}
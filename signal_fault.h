@@ -0,0 +1,65 @@
+/**
+ * Input fault hardware yang memaksa output generator LOW tanpa CPU.
+ *
+ * Sebuah state machine watchdog (program signal_fault) menunggu pin fault,
+ * misalnya output komparator overcurrent. Begitu fault aktif, keempat pin
+ * output ditarik LOW dalam SG_FAULT_REACTION_CYCLES siklus clk_sys dan terus
+ * ditulis LOW setiap siklus, sehingga generator yang masih berjalan (atau
+ * state machine yang dihentikan saat pin HIGH) tidak bisa menaikkannya lagi.
+ * Fault di-latch oleh state machine dan flag IRQ PIO-nya sampai
+ * sg_fault_clear(); firmware diberi tahu lewat interrupt PIO IRQ 0.
+ *
+ * Prioritas tulis pin antar state machine mengikuti nomor SM, jadi watchdog
+ * harus bernomor lebih tinggi dari setiap SM yang menggerakkan pin yang sama
+ * (guarded_sm_mask pada sg_fault_init()). Fault aktif-low dinormalisasi
+ * dengan INOVER pin fault, sehingga gpio_get() pin tersebut ikut terbalik
+ * selama instance di-init.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef SIGNAL_FAULT_H
+#define SIGNAL_FAULT_H
+
+#include "signal_gen.h"
+
+// Jarak edge fault -> output LOW (siklus clk_sys, watchdog berjalan tanpa
+// divider): `wait` lolos, lalu side-set pada loop `irq`. Di hardware
+// sinkronisasi input GPIO menambah sekitar 2 siklus clk_sys.
+#define SG_FAULT_REACTION_CYCLES 2
+
+/**
+ * @brief Callback saat fault ter-latch, dipanggil dari handler interrupt.
+ *
+ * @param ctx Pointer yang diberikan ke sg_fault_init()
+ * @param time_us time_us_64() saat handler berjalan
+ */
+typedef void (*sg_fault_callback)(void *ctx, uint64_t time_us);
+
+/**
+ * @brief Satu watchdog fault untuk SG_NUM_PINS pin output.
+ */
+typedef struct
+{
+    PIO pio;                        // Blok PIO tempat generator yang dijaga berjalan
+    uint sm;                        // State machine watchdog
+    uint offset;                    // Offset program signal_fault
+    uint pin_base;                  // Pin pertama dari SG_NUM_PINS pin yang dijaga
+    uint fault_pin;                 // Pin input fault
+    bool active_high;               // Polaritas fault
+    volatile bool tripped;          // Fault sudah dilaporkan handler
+    volatile uint64_t trip_time_us; // time_us_64() saat handler melapor
+    volatile uint32_t trips;        // Jumlah fault sejak sg_fault_init()
+    sg_fault_callback callback;
+    void *callback_ctx;
+    sg_state state;
+} sg_fault_instance;
+
+// -- API --
+bool sg_fault_init(sg_fault_instance *f, PIO pio, uint pin_base, uint fault_pin, bool active_high,
+                   uint32_t guarded_sm_mask, sg_fault_callback callback, void *ctx);
+void sg_fault_deinit(sg_fault_instance *f);
+bool sg_fault_is_latched(const sg_fault_instance *f);
+bool sg_fault_clear(sg_fault_instance *f);
+
+#endif
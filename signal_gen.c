@@ -0,0 +1,849 @@
+/**
+ * Implementasi library generator sinyal 4-kanal berbasis PIO.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include "signal_gen.h"
+#include "hardware/clocks.h"
+#include "hardware/sync.h"
+#include "hardware/timer.h"
+#include "signal_generator.pio.h" // Header yang di-generate otomatis
+
+// -- Program PIO yang Dimuat per Blok PIO --
+// Program dimuat sekali dan dipakai bersama oleh semua instance di blok yang sama
+static struct
+{
+    uint offset;
+    uint users;
+} loaded_program[NUM_PIOS];
+
+// -- Instance yang Menunggu Alarm sg_schedule() --
+static sg_instance *scheduled_instances[NUM_ALARMS];
+
+/**
+ * @brief Menginisialisasi instance: memuat program PIO, mengklaim state machine,
+ *        dan mengkonfigurasi pin output.
+ *
+ * @param inst Instance yang akan diinisialisasi
+ * @param pio Instance PIO yang akan digunakan (pio0 atau pio1)
+ * @param pin_base Pin pertama dari SG_NUM_PINS pin output berurutan
+ * @return true jika berhasil, false jika tidak ada state machine atau
+ *         instruction memory yang tersisa
+ */
+bool sg_init(sg_instance *inst, PIO pio, uint pin_base)
+{
+    int sm = pio_claim_unused_sm(pio, false);
+    if (sm < 0)
+    {
+        return false;
+    }
+
+    uint pio_index = pio_get_index(pio);
+    if (loaded_program[pio_index].users == 0)
+    {
+        if (!pio_can_add_program(pio, &signal_generator_program))
+        {
+            pio_sm_unclaim(pio, (uint)sm);
+            return false;
+        }
+        loaded_program[pio_index].offset = pio_add_program(pio, &signal_generator_program);
+    }
+    loaded_program[pio_index].users++;
+
+    inst->pio = pio;
+    inst->sm = (uint)sm;
+    inst->offset = loaded_program[pio_index].offset;
+    inst->pin_base = pin_base;
+    inst->sys_clk_hz = 0;
+    inst->trigger_delay = 0;
+    inst->clock_ppm = 0.0;
+    inst->dither_frac = 0;
+    inst->dither_acc = 0;
+    inst->alarm = -1;
+    inst->pps_pin = -1;
+    inst->scheduled_us = 0;
+    inst->start_late_us = 0;
+    inst->staged = false;
+    inst->next_event = 0;
+    for (uint i = 0; i < SG_NUM_EVENTS; ++i)
+    {
+        inst->delays[i] = 0;
+    }
+
+    pio_sm_config c = signal_generator_program_get_default_config(inst->offset);
+
+    // Konfigurasi pin-pin yang akan digunakan oleh PIO
+    // Pin dasar untuk 'set' adalah pin_base, dan akan mempengaruhi 4 pin secara berurutan
+    sm_config_set_set_pins(&c, pin_base, SG_NUM_PINS);
+    for (uint i = 0; i < SG_NUM_PINS; ++i)
+    {
+        pio_gpio_init(pio, pin_base + i);
+    }
+    pio_sm_set_consecutive_pindirs(pio, inst->sm, pin_base, SG_NUM_PINS, true);
+
+    // Terapkan konfigurasi ke state machine (clock divider diatur oleh sg_configure)
+    pio_sm_init(pio, inst->sm, inst->offset, &c);
+
+    inst->state = SG_STATE_READY;
+    return true;
+}
+
+/**
+ * @brief Menghentikan instance dan melepaskan state machine serta program PIO.
+ *
+ * @param inst Instance yang akan dilepas
+ */
+void sg_deinit(sg_instance *inst)
+{
+    if (inst->state == SG_STATE_UNINIT)
+    {
+        return;
+    }
+    sg_stop(inst);
+    pio_sm_unclaim(inst->pio, inst->sm);
+
+    uint pio_index = pio_get_index(inst->pio);
+    if (--loaded_program[pio_index].users == 0)
+    {
+        pio_remove_program(inst->pio, &signal_generator_program, inst->offset);
+    }
+    inst->state = SG_STATE_UNINIT;
+}
+
+/**
+ * @brief Menerapkan konfigurasi timing baru ke instance yang sedang berhenti.
+ *
+ * @param inst Instance generator
+ * @param timing Parameter timing yang diinginkan
+ * @return true jika konfigurasi valid dan diterapkan
+ */
+bool sg_configure(sg_instance *inst, const sg_timing_config *timing)
+{
+    if (inst->state == SG_STATE_UNINIT || inst->state == SG_STATE_RUNNING || inst->state == SG_STATE_ARMED)
+    {
+        return false;
+    }
+
+    uint32_t sys_clk_hz = clock_get_hz(clk_sys);
+    uint32_t delays[SG_NUM_EVENTS];
+    uint32_t trigger_delay;
+    if (!sg_calculate_delays((float)sys_clk_hz, timing, delays) ||
+        !sg_calculate_trigger_delay((float)sys_clk_hz, timing, &trigger_delay))
+    {
+        return false;
+    }
+
+    inst->timing = *timing;
+    inst->sys_clk_hz = sys_clk_hz;
+    inst->trigger_delay = trigger_delay;
+    inst->clock_ppm = 0.0;
+    inst->dither_frac = 0;
+    inst->dither_acc = 0;
+    inst->staged = false;
+    for (uint i = 0; i < SG_NUM_EVENTS; ++i)
+    {
+        inst->delays[i] = delays[i];
+    }
+    pio_sm_set_clkdiv(inst->pio, inst->sm, timing->pio_clk_div);
+    inst->state = SG_STATE_IDLE;
+    return true;
+}
+
+/**
+ * @brief Menyesuaikan instance setelah clk_sys berubah (misalnya setelah wake).
+ *
+ * Clock divider diterapkan ulang dan fasenya di-restart. Jika clk_sys tidak
+ * kembali ke frekuensi yang sama, delay dihitung ulang beserta trim
+ * sg_trim_clock() yang aktif.
+ *
+ * @param inst Instance generator yang sedang berhenti
+ * @return false jika delay tidak dapat dihitung untuk clk_sys yang baru
+ */
+bool sg_sync_clock(sg_instance *inst)
+{
+    if (inst->state != SG_STATE_IDLE)
+    {
+        return false;
+    }
+
+    bool ok = true;
+    uint32_t sys_clk_hz = clock_get_hz(clk_sys);
+    if (sys_clk_hz != inst->sys_clk_hz)
+    {
+        ok = sg_calculate_delays((float)sys_clk_hz, &inst->timing, inst->delays) &&
+             sg_calculate_trigger_delay((float)sys_clk_hz, &inst->timing, &inst->trigger_delay);
+        inst->sys_clk_hz = sys_clk_hz;
+        inst->dither_frac = 0;
+        if (ok && inst->clock_ppm != 0.0)
+        {
+            ok = sg_trim_clock(inst, inst->clock_ppm);
+        }
+    }
+    pio_sm_set_clkdiv(inst->pio, inst->sm, inst->timing.pio_clk_div);
+    pio_sm_clkdiv_restart(inst->pio, inst->sm);
+    return ok;
+}
+
+/**
+ * @brief Menghitung delay untuk clk_sys nominal x (1 + ppm) dengan sisa
+ *        pecahan siklus PIO event D dalam Q0.32.
+ */
+static bool calculate_trimmed_delays(uint32_t nominal_sys_clk_hz, const sg_timing_config *timing, double ppm,
+                                     uint32_t delays[SG_NUM_EVENTS], uint32_t *frac)
+{
+    double sys_clk_hz = (double)nominal_sys_clk_hz * (1.0 + ppm * 1e-6);
+    if (!sg_calculate_delays((float)sys_clk_hz, timing, delays))
+    {
+        return false;
+    }
+
+    // Event A..C memakai lebar pulsa hasil pembulatan; event D menampung sisa periode
+    double period_cycles = sys_clk_hz / (double)timing->pio_clk_div / (double)timing->frequency_hz;
+    double event_D_cycles = period_cycles;
+    for (uint i = 0; i < SG_NUM_EVENTS - 1; ++i)
+    {
+        event_D_cycles -= (double)delays[i] + SG_EVENT_OVERHEAD_CYCLES;
+    }
+    if (event_D_cycles < SG_EVENT_D_OVERHEAD_CYCLES || event_D_cycles >= 4294967296.0)
+    {
+        return false;
+    }
+    double whole = floor(event_D_cycles);
+    delays[SG_NUM_EVENTS - 1] = (uint32_t)whole - SG_EVENT_D_OVERHEAD_CYCLES;
+    *frac = (uint32_t)((event_D_cycles - whole) * 4294967296.0);
+    return true;
+}
+
+/**
+ * @brief Mengoreksi delay terhadap kesalahan clk_sys yang terukur.
+ *
+ * Periode dihitung ulang dalam double dari clk_sys nominal x (1 + ppm). Sisa
+ * pecahan siklus PIO ditampung event D: akumulator Q0.32 menambah satu
+ * siklus pada periode yang melimpah, sehingga frekuensi rata-rata jangka
+ * panjang tepat sampai jauh di bawah 1 ppb walaupun setiap periode tetap
+ * bilangan bulat siklus.
+ *
+ * Set terkoreksi masuk lewat jalur sg_stage(): dihitung dari konfigurasi yang
+ * akan aktif (stage yang belum diterapkan ikut dihitung ulang dengan ppm
+ * baru) dan diterapkan utuh sebelum event A berikutnya, termasuk di tengah
+ * sg_run_burst(). Karena itu boleh dipanggil saat berjalan maupun berhenti.
+ *
+ * @param inst Instance generator yang sudah dikonfigurasi
+ * @param ppm Kesalahan clk_sys terhadap referensi (positif = clk_sys lebih
+ *        cepat dari nominal)
+ * @return false jika instance belum dikonfigurasi atau pulsa tidak muat
+ */
+bool sg_trim_clock(sg_instance *inst, double ppm)
+{
+    if (inst->state == SG_STATE_UNINIT || inst->state == SG_STATE_READY)
+    {
+        return false;
+    }
+
+    while (true)
+    {
+        uint32_t status = save_and_disable_interrupts();
+        sg_timing_config timing = inst->staged ? inst->staged_timing : inst->timing;
+        restore_interrupts(status);
+
+        uint32_t delays[SG_NUM_EVENTS];
+        uint32_t frac;
+        uint32_t trigger_delay;
+        if (!calculate_trimmed_delays(inst->sys_clk_hz, &timing, ppm, delays, &frac) ||
+            !sg_calculate_trigger_delay((float)inst->sys_clk_hz, &timing, &trigger_delay))
+        {
+            return false;
+        }
+
+        // sg_stage() dari handler di tengah perhitungan: ulangi dengan timing barunya
+        status = save_and_disable_interrupts();
+        const sg_timing_config *target = inst->staged ? &inst->staged_timing : &inst->timing;
+        bool current = memcmp(target, &timing, sizeof(timing)) == 0;
+        if (current)
+        {
+            inst->staged_timing = timing;
+            for (uint i = 0; i < SG_NUM_EVENTS; ++i)
+            {
+                inst->staged_delays[i] = delays[i];
+            }
+            inst->staged_frac = frac;
+            inst->staged_trigger_delay = trigger_delay;
+            inst->staged = true;
+            inst->clock_ppm = ppm;
+        }
+        restore_interrupts(status);
+        if (current)
+        {
+            return true;
+        }
+    }
+}
+
+/**
+ * @brief Menyiapkan konfigurasi timing baru yang diterapkan utuh di batas periode.
+ *
+ * Delay dihitung sekarang (termasuk trim sg_trim_clock() yang aktif) dan
+ * disimpan sebagai satu set. Pemberi data (sg_start, sg_service, sg_run_burst,
+ * sg_run_armed_burst) menukarnya tepat sebelum mengirim event A, sehingga
+ * tidak ada periode yang memakai campuran delay lama dan baru. FIFO TX sudah
+ * berisi sampai satu periode, jadi konfigurasi baru keluar paling lambat di
+ * periode kedua setelah stage. Stage baru sebelum diterapkan menggantikan
+ * yang lama. Boleh dipanggil dari handler interrupt.
+ *
+ * Clock divider tidak bisa diganti di batas periode; untuk itu hentikan
+ * generator dan pakai sg_configure().
+ *
+ * @param inst Instance generator yang sudah dikonfigurasi (boleh berjalan)
+ * @param timing Parameter timing baru dengan pio_clk_div yang sama
+ * @return false jika instance belum dikonfigurasi, clock divider berbeda,
+ *         atau pulsa dan jeda tidak muat di dalam satu periode
+ */
+bool sg_stage(sg_instance *inst, const sg_timing_config *timing)
+{
+    if (inst->state == SG_STATE_UNINIT || inst->state == SG_STATE_READY ||
+        timing->pio_clk_div != inst->timing.pio_clk_div)
+    {
+        return false;
+    }
+
+    // Tanpa trim hasilnya identik dengan sg_configure()
+    uint32_t delays[SG_NUM_EVENTS];
+    uint32_t frac = 0;
+    uint32_t trigger_delay;
+    bool ok = inst->clock_ppm == 0.0
+                  ? sg_calculate_delays((float)inst->sys_clk_hz, timing, delays)
+                  : calculate_trimmed_delays(inst->sys_clk_hz, timing, inst->clock_ppm, delays, &frac);
+    if (!ok || !sg_calculate_trigger_delay((float)inst->sys_clk_hz, timing, &trigger_delay))
+    {
+        return false;
+    }
+
+    uint32_t status = save_and_disable_interrupts();
+    inst->staged_timing = *timing;
+    for (uint i = 0; i < SG_NUM_EVENTS; ++i)
+    {
+        inst->staged_delays[i] = delays[i];
+    }
+    inst->staged_frac = frac;
+    inst->staged_trigger_delay = trigger_delay;
+    inst->staged = true;
+    restore_interrupts(status);
+    return true;
+}
+
+/**
+ * @brief Menyiapkan nilai N event D baru tanpa menghitung ulang konfigurasi.
+ *
+ * Jalur murah sg_stage() untuk modulasi periode per periode (mode VCO): tidak
+ * ada perhitungan float, hanya penyalinan di bawah interrupt mati. Event A..C
+ * tetap, jadi lebar pulsa dan jeda antar pasangan tidak berubah; nilai baru
+ * diterapkan di batas periode seperti sg_stage(). Pemanggil bertanggung jawab
+ * atas nilai delay_d (misalnya dari tabel sg_calculate_delays()). Dither
+ * sg_trim_clock() dimatikan dan timing.frequency_hz tidak diperbarui.
+ *
+ * @param inst Instance generator yang sudah dikonfigurasi
+ * @param delay_d Nilai N event D untuk periode berikutnya
+ */
+void __time_critical_func(sg_stage_delay_d)(sg_instance *inst, uint32_t delay_d)
+{
+    uint32_t status = save_and_disable_interrupts();
+    if (!inst->staged)
+    {
+        // Bertumpu pada set aktif; stage penuh yang belum diterapkan dipertahankan
+        for (uint i = 0; i < SG_NUM_EVENTS - 1; ++i)
+        {
+            inst->staged_delays[i] = inst->delays[i];
+        }
+        inst->staged_trigger_delay = inst->trigger_delay;
+        inst->staged_timing = inst->timing;
+    }
+    inst->staged_delays[SG_NUM_EVENTS - 1] = delay_d;
+    inst->staged_frac = 0;
+    inst->staged = true;
+    restore_interrupts(status);
+}
+
+/**
+ * @brief Menerapkan set delay sg_stage() di batas periode.
+ *
+ * Interrupt dimatikan selama penyalinan agar sg_stage() dari handler tidak
+ * menimpa set yang baru disalin setengah.
+ */
+static __force_inline void apply_staged(sg_instance *inst)
+{
+    uint32_t status = save_and_disable_interrupts();
+    for (uint i = 0; i < SG_NUM_EVENTS; ++i)
+    {
+        inst->delays[i] = inst->staged_delays[i];
+    }
+    inst->dither_frac = inst->staged_frac;
+    inst->trigger_delay = inst->staged_trigger_delay;
+    inst->timing = inst->staged_timing;
+    inst->staged = false;
+    restore_interrupts(status);
+}
+
+/**
+ * @brief Mengambil nilai delay event berikutnya, dengan dither pada event D.
+ *
+ * Di-inline paksa agar jalur pemberi data di SRAM tidak memanggil ke flash.
+ */
+static __force_inline uint32_t event_delay(sg_instance *inst, uint event)
+{
+    if (event == 0 && inst->staged)
+    {
+        apply_staged(inst);
+    }
+    if (event != SG_NUM_EVENTS - 1)
+    {
+        return inst->delays[event];
+    }
+    uint32_t acc = inst->dither_acc + inst->dither_frac;
+    bool carry = acc < inst->dither_acc;
+    inst->dither_acc = acc;
+    return inst->delays[event] + carry;
+}
+
+/**
+ * @brief Memulai state machine dari awal program.
+ *
+ * FIFO dikosongkan lalu diisi satu periode penuh sebelum state machine
+ * diaktifkan, sehingga edge pertama muncul tepat SG_START_LATENCY_CYCLES
+ * siklus PIO setelah enable.
+ *
+ * @param inst Instance generator yang sudah dikonfigurasi
+ */
+void __time_critical_func(sg_start)(sg_instance *inst)
+{
+    PIO pio = inst->pio;
+    uint sm = inst->sm;
+
+    pio_sm_clear_fifos(pio, sm);
+    pio_sm_restart(pio, sm);
+    pio_sm_exec(pio, sm, pio_encode_jmp(inst->offset));
+    for (uint i = 0; i < SG_NUM_EVENTS; ++i)
+    {
+        pio_sm_put(pio, sm, event_delay(inst, i));
+    }
+    inst->next_event = 0;
+    inst->state = SG_STATE_RUNNING;
+
+    // Aktifkan State Machine PIO untuk memulai pembangkitan sinyal
+    pio_sm_set_enabled(pio, sm, true);
+}
+
+/**
+ * @brief Mengisi FIFO TX sebanyak ruang yang tersedia tanpa blocking.
+ *
+ * Dipakai untuk melayani beberapa instance secara bergantian dari satu loop.
+ *
+ * @param inst Instance yang sedang berjalan
+ * @return Jumlah event yang dikirim ke FIFO
+ */
+uint __time_critical_func(sg_service)(sg_instance *inst)
+{
+    uint pushed = 0;
+    while (!pio_sm_is_tx_fifo_full(inst->pio, inst->sm))
+    {
+        pio_sm_put(inst->pio, inst->sm, event_delay(inst, inst->next_event));
+        inst->next_event = (inst->next_event + 1) % SG_NUM_EVENTS;
+        pushed++;
+    }
+    return pushed;
+}
+
+/**
+ * @brief Memberi data delay ke FIFO sampai durasi burst habis, lalu stop.
+ *
+ * FIFO diasumsikan berisi kelipatan satu periode sehingga word berikutnya
+ * selalu delay event A.
+ *
+ * @return start_us yang diperluas ke 64-bit
+ */
+static absolute_time_t __time_critical_func(feed_burst)(sg_instance *inst, uint32_t start_us, uint32_t duration)
+{
+    PIO pio = inst->pio;
+    uint sm = inst->sm;
+    uint32_t delay_A = inst->delays[0];
+    uint32_t delay_B = inst->delays[1];
+    uint32_t delay_C = inst->delays[2];
+    uint32_t delay_D = inst->delays[3];
+    uint32_t frac = inst->dither_frac;
+    uint32_t acc = inst->dither_acc;
+
+    // Loop untuk memberi data delay ke PIO selama durasi burst
+    while (time_us_32() - start_us < duration)
+    {
+        // Konfigurasi sg_stage() diganti utuh sebelum event A
+        if (inst->staged)
+        {
+            apply_staged(inst);
+            delay_A = inst->delays[0];
+            delay_B = inst->delays[1];
+            delay_C = inst->delays[2];
+            delay_D = inst->delays[3];
+            frac = inst->dither_frac;
+        }
+        pio_sm_put_blocking(pio, sm, delay_A);
+        pio_sm_put_blocking(pio, sm, delay_B);
+        pio_sm_put_blocking(pio, sm, delay_C);
+        acc += frac;
+        pio_sm_put_blocking(pio, sm, delay_D + (acc < frac));
+    }
+    inst->dither_acc = acc;
+
+    sg_stop(inst);
+
+    // Perluas waktu mulai 32-bit ke 64-bit relatif terhadap waktu sekarang
+    uint64_t now_us = time_us_64();
+    return from_us_since_boot(now_us - (uint32_t)((uint32_t)now_us - start_us));
+}
+
+/**
+ * @brief Menjalankan satu burst: start, memberi data delay ke FIFO, lalu stop.
+ *
+ * Fungsi ini adalah jalur kritis waktu: ditempatkan di SRAM agar cache miss XIP
+ * tidak menambah stall pada loop pemberi data. Durasi dicek dengan time_us_32()
+ * (inline, langsung membaca register timer) sehingga tidak ada pemanggilan ke
+ * fungsi SDK yang berada di flash. pio_sm_put_blocking() juga inline.
+ *
+ * @param inst Instance generator yang sudah dikonfigurasi
+ * @param duration_us Durasi burst dalam mikrodetik (maksimal ~71 menit)
+ * @return Waktu saat state machine diaktifkan
+ */
+absolute_time_t __time_critical_func(sg_run_burst)(sg_instance *inst, uint64_t duration_us)
+{
+    sg_start(inst);
+
+    // Catat waktu mulai
+    uint32_t start_us = time_us_32();
+    return feed_burst(inst, start_us, (uint32_t)duration_us);
+}
+
+/**
+ * @brief Mengisi pre-event trigger dan satu periode penuh ke state machine
+ *        yang berhenti, tanpa mengaktifkannya.
+ */
+static void prefill_pre_event(sg_instance *inst)
+{
+    PIO pio = inst->pio;
+    uint sm = inst->sm;
+
+    pio_sm_set_enabled(pio, sm, false);
+    pio_sm_clear_fifos(pio, sm);
+    pio_sm_restart(pio, sm);
+    pio_sm_put(pio, sm, inst->trigger_delay);
+    pio_sm_exec(pio, sm, pio_encode_pull(false, true));
+    pio_sm_exec(pio, sm, pio_encode_mov(pio_x, pio_osr));
+    pio_sm_exec(pio, sm, pio_encode_jmp(inst->offset + signal_generator_offset_trigger_delay));
+    for (uint i = 0; i < SG_NUM_EVENTS; ++i)
+    {
+        pio_sm_put(pio, sm, event_delay(inst, i));
+    }
+    inst->next_event = 0;
+}
+
+/**
+ * @brief Menyiapkan state machine agar mulai sendiri pada edge trigger.
+ *
+ * State machine diaktifkan di pre-event `trigger_delay` dengan X berisi
+ * jeda trigger dan FIFO berisi satu periode penuh, lalu instruksi `wait` pada
+ * pin trigger di-exec sehingga state machine stall sampai level aktif. Setelah
+ * trigger, edge pertama muncul tepat timing.trigger_delay_ns kemudian
+ * (minimal SG_TRIGGER_LATENCY_CYCLES siklus PIO) tanpa keterlibatan CPU.
+ * Pin trigger boleh berupa tombol maupun input eksternal dan harus sudah
+ * dikonfigurasi sebagai input oleh pemanggil.
+ *
+ * @param inst Instance generator yang sudah dikonfigurasi dan berhenti
+ * @param trigger_pin GPIO trigger
+ * @param active_high true = trigger pada edge naik, false = edge turun
+ *        (misalnya tombol ke ground dengan pull-up)
+ * @return false jika instance belum siap atau pin trigger sedang aktif,
+ *         karena level aktif langsung dianggap sebagai trigger
+ */
+bool sg_arm(sg_instance *inst, uint trigger_pin, bool active_high)
+{
+    if (inst->state != SG_STATE_IDLE || gpio_get(trigger_pin) == active_high)
+    {
+        return false;
+    }
+    prefill_pre_event(inst);
+
+    // `wait` yang di-exec ditahan state machine sampai kondisinya terpenuhi
+    pio_sm_exec(inst->pio, inst->sm, pio_encode_wait_gpio(active_high, trigger_pin));
+    inst->state = SG_STATE_ARMED;
+    pio_sm_set_enabled(inst->pio, inst->sm, true);
+    return true;
+}
+
+/**
+ * @brief Melepas hardware alarm jadwal start milik instance.
+ */
+static void __time_critical_func(release_alarm)(sg_instance *inst)
+{
+    uint alarm = (uint)inst->alarm;
+    hardware_alarm_set_callback(alarm, NULL);
+    hardware_alarm_unclaim(alarm);
+    scheduled_instances[alarm] = NULL;
+    inst->alarm = -1;
+}
+
+/**
+ * @brief Callback hardware alarm jadwal start (konteks interrupt, dari SRAM).
+ *
+ * Start biasa hanya perlu satu tulisan IRQ_FORCE: state machine yang sudah
+ * terisi langsung lolos dari `wait irq`. Start PPS meng-exec `wait` pin PPS
+ * lalu mengaktifkan state machine; jika PPS sedang HIGH, edge-nya tidak bisa
+ * dibedakan dari pulsa yang sedang berlangsung sehingga jadwal dibatalkan.
+ */
+static void __time_critical_func(schedule_alarm_callback)(uint alarm_num)
+{
+    sg_instance *inst = scheduled_instances[alarm_num];
+    if (!inst)
+    {
+        return;
+    }
+    if (inst->pps_pin < 0)
+    {
+        inst->pio->irq_force = 1u << inst->sm;
+    }
+    else if (!gpio_get((uint)inst->pps_pin))
+    {
+        pio_sm_exec(inst->pio, inst->sm, pio_encode_wait_gpio(true, (uint)inst->pps_pin));
+        pio_sm_set_enabled(inst->pio, inst->sm, true);
+    }
+    else
+    {
+        inst->state = SG_STATE_IDLE;
+    }
+    inst->start_late_us = (int32_t)(time_us_32() - (uint32_t)inst->scheduled_us);
+    release_alarm(inst);
+}
+
+/**
+ * @brief Mengisi pre-event dan FIFO lalu memasang alarm jadwal start.
+ */
+static bool schedule_start(sg_instance *inst, absolute_time_t alarm_time, int pps_pin)
+{
+    if (inst->state != SG_STATE_IDLE)
+    {
+        return false;
+    }
+    int alarm = hardware_alarm_claim_unused(false);
+    if (alarm < 0)
+    {
+        return false;
+    }
+    PIO pio = inst->pio;
+    uint sm = inst->sm;
+
+    prefill_pre_event(inst);
+    if (pps_pin < 0)
+    {
+        // State machine langsung stall di `wait irq` sampai flag di-force alarm
+        pio_interrupt_clear(pio, sm);
+        pio_sm_exec(pio, sm, pio_encode_wait_irq(true, false, sm));
+        pio_sm_set_enabled(pio, sm, true);
+    }
+    inst->alarm = alarm;
+    inst->pps_pin = pps_pin;
+    inst->scheduled_us = to_us_since_boot(alarm_time);
+    inst->start_late_us = 0;
+    inst->state = SG_STATE_ARMED;
+
+    scheduled_instances[alarm] = inst;
+    hardware_alarm_set_callback((uint)alarm, schedule_alarm_callback);
+    if (hardware_alarm_set_target((uint)alarm, alarm_time))
+    {
+        // Waktu target sudah lewat: alarm tidak dipasang
+        sg_stop(inst);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Menjadwalkan start pada timestamp absolut lewat hardware alarm.
+ *
+ * State machine diisi seperti sg_arm() lalu stall di `wait irq` (flag IRQ
+ * PIO bernomor sm). Handler alarm yang berjalan dari SRAM hanya menulis
+ * IRQ_FORCE, sehingga edge pertama muncul timing.trigger_delay_ns (minimal
+ * SG_TRIGGER_LATENCY_CYCLES siklus PIO) setelah handler berjalan. Jitter
+ * start = latensi entry interrupt timer terhadap tick mikrodetik target;
+ * keterlambatan handler dalam us dicatat di start_late_us. Lanjutkan dengan
+ * sg_run_armed_burst() untuk memberi data selama burst.
+ *
+ * @param inst Instance generator yang sudah dikonfigurasi dan berhenti
+ * @param start_time Waktu start (us sejak boot)
+ * @return false jika instance belum siap, tidak ada alarm bebas, atau
+ *         start_time sudah lewat
+ */
+bool sg_schedule(sg_instance *inst, absolute_time_t start_time)
+{
+    return schedule_start(inst, start_time, -1);
+}
+
+/**
+ * @brief Menjadwalkan start pada edge naik PPS pertama setelah arm_time.
+ *
+ * Pada arm_time handler alarm meng-arm state machine ke pin PPS seperti
+ * sg_arm(), sehingga start sejajar detik referensi dengan presisi siklus
+ * PIO, tidak bergantung pada latensi interrupt. Pilih arm_time saat PPS LOW,
+ * misalnya setengah detik sebelum detik yang diinginkan; jika PPS HIGH saat
+ * alarm, jadwal dibatalkan dan sg_run_armed_burst() mengembalikan nil_time.
+ * Pin PPS harus sudah dikonfigurasi sebagai input oleh pemanggil.
+ *
+ * @param inst Instance generator yang sudah dikonfigurasi dan berhenti
+ * @param arm_time Waktu arm (us sejak boot)
+ * @param pps_pin GPIO input PPS (aktif-high)
+ * @return false jika instance belum siap, tidak ada alarm bebas, atau
+ *         arm_time sudah lewat
+ */
+bool sg_schedule_pps(sg_instance *inst, absolute_time_t arm_time, uint pps_pin)
+{
+    return schedule_start(inst, arm_time, (int)pps_pin);
+}
+
+/**
+ * @brief Menunggu trigger pada instance yang di-arm, lalu memberi data delay
+ *        ke FIFO selama durasi burst dan menghentikan state machine.
+ *
+ * Edge pertama sudah dijadwalkan oleh PIO; CPU hanya mendeteksi trigger dari
+ * word pertama yang ditarik state machine, sehingga beban CPU tidak
+ * mempengaruhi jeda trigger. Fungsi ini blocking sampai trigger datang.
+ *
+ * @param inst Instance dalam state SG_STATE_ARMED
+ * @param duration_us Durasi burst sejak trigger terdeteksi (maksimal ~71 menit)
+ * @return Waktu saat trigger terdeteksi CPU, atau nil_time jika belum di-arm
+ */
+absolute_time_t __time_critical_func(sg_run_armed_burst)(sg_instance *inst, uint64_t duration_us)
+{
+    if (inst->state != SG_STATE_ARMED)
+    {
+        return nil_time;
+    }
+    while (pio_sm_is_tx_fifo_full(inst->pio, inst->sm))
+    {
+        // Jadwal PPS bisa dibatalkan oleh handler alarm
+        if (((volatile sg_instance *)inst)->state != SG_STATE_ARMED)
+        {
+            return nil_time;
+        }
+        tight_loop_contents();
+    }
+    uint32_t start_us = time_us_32();
+    inst->state = SG_STATE_RUNNING;
+    return feed_burst(inst, start_us, (uint32_t)duration_us);
+}
+
+/**
+ * @brief Menghentikan state machine dan menarik semua output LOW.
+ *
+ * @param inst Instance generator
+ */
+void __time_critical_func(sg_stop)(sg_instance *inst)
+{
+    // Nonaktifkan State Machine PIO untuk menghentikan sinyal. Pin tetap pada
+    // level terakhir yang ditulis, jadi output dipaksa LOW lewat exec
+    pio_sm_set_enabled(inst->pio, inst->sm, false);
+    pio_sm_exec(inst->pio, inst->sm, pio_encode_set(pio_pins, 0));
+    if (inst->alarm >= 0)
+    {
+        hardware_alarm_cancel((uint)inst->alarm);
+        release_alarm(inst);
+    }
+    if (inst->state == SG_STATE_RUNNING || inst->state == SG_STATE_ARMED)
+    {
+        inst->state = SG_STATE_IDLE;
+    }
+}
+
+/**
+ * @brief Menghitung nilai delay untuk setiap event dalam satuan siklus PIO.
+ *
+ * @param sys_clk_hz Frekuensi clock sistem (Hz)
+ * @param timing Parameter timing (frekuensi, lebar pulsa, fase, clock divider)
+ * @param delays Array untuk menyimpan delay event A, B, C, D
+ * @return false jika pulsa dan jeda tidak muat di dalam satu periode
+ */
+bool sg_calculate_delays(float sys_clk_hz, const sg_timing_config *timing,
+                         uint32_t delays[SG_NUM_EVENTS])
+{
+    if (timing->frequency_hz <= 0.0f || timing->pio_clk_div < 1.0f)
+    {
+        return false;
+    }
+
+    float pio_clk_hz = sys_clk_hz / timing->pio_clk_div;
+    float period_s = 1.0f / timing->frequency_hz;
+    uint32_t total_pio_cycles = (uint32_t)(period_s * pio_clk_hz);
+    uint32_t pulse_width_cycles = (uint32_t)(timing->pulse_width_us * 1e-6f * pio_clk_hz);
+    uint32_t phase_shift_cycles = (uint32_t)(timing->phase_shift_us * 1e-6f * pio_clk_hz);
+
+    // Durasi setiap event dalam siklus PIO
+    uint32_t event_A_duration = pulse_width_cycles;
+    uint32_t event_B_duration = phase_shift_cycles;
+    uint32_t event_C_duration = pulse_width_cycles;
+    if ((uint64_t)event_A_duration + event_B_duration + event_C_duration > total_pio_cycles)
+    {
+        return false;
+    }
+    uint32_t event_D_duration = total_pio_cycles - event_A_duration - event_B_duration - event_C_duration;
+
+    // Nilai N (loop counter) yang dikirim ke PIO
+    // Rumus: N = durasi_siklus - overhead_instruksi
+    // Overhead untuk program PIO ini adalah 4 siklus per loop, 5 untuk event D
+    uint32_t durations[SG_NUM_EVENTS] = {event_A_duration, event_B_duration,
+                                         event_C_duration, event_D_duration};
+    for (uint i = 0; i < SG_NUM_EVENTS; ++i)
+    {
+        uint32_t overhead = i == SG_NUM_EVENTS - 1 ? SG_EVENT_D_OVERHEAD_CYCLES : SG_EVENT_OVERHEAD_CYCLES;
+        delays[i] = durations[i] > overhead ? durations[i] - overhead : 0;
+    }
+    return true;
+}
+
+/**
+ * @brief Menghitung nilai N pre-event trigger (loop `trigger_delay`).
+ *
+ * Dihitung dalam double agar jeda hingga beberapa detik tetap tepat per
+ * siklus PIO. Jeda di bawah SG_TRIGGER_LATENCY_CYCLES dibulatkan ke latensi
+ * minimum tersebut.
+ *
+ * @param sys_clk_hz Frekuensi clock sistem (Hz)
+ * @param timing Parameter timing (trigger_delay_ns dan clock divider)
+ * @param delay Nilai N yang dimuat ke register X
+ * @return false jika jeda tidak muat di register X 32-bit
+ */
+bool sg_calculate_trigger_delay(float sys_clk_hz, const sg_timing_config *timing, uint32_t *delay)
+{
+    if (timing->pio_clk_div < 1.0f)
+    {
+        return false;
+    }
+    double pio_clk_hz = (double)sys_clk_hz / (double)timing->pio_clk_div;
+    double cycles = (double)timing->trigger_delay_ns * pio_clk_hz / 1e9 + 0.5;
+    if (cycles >= (double)UINT32_MAX + SG_TRIGGER_LATENCY_CYCLES + 1.0)
+    {
+        return false;
+    }
+    uint64_t total = (uint64_t)cycles;
+    *delay = total > SG_TRIGGER_LATENCY_CYCLES ? (uint32_t)(total - SG_TRIGGER_LATENCY_CYCLES) : 0;
+    return true;
+}
+
+/**
+ * @brief Mengkonversi jumlah siklus PIO ke mikrodetik untuk konfigurasi aktif.
+ *
+ * @param inst Instance generator yang sudah dikonfigurasi
+ * @param pio_cycles Jumlah siklus PIO
+ * @return Durasi dalam mikrodetik
+ */
+float sg_cycles_to_us(const sg_instance *inst, uint32_t pio_cycles)
+{
+    return (float)pio_cycles * inst->timing.pio_clk_div * 1e6f / (float)inst->sys_clk_hz;
+}
@@ -0,0 +1,112 @@
+/**
+ * Library generator sinyal 4-kanal berbasis PIO.
+ *
+ * Seluruh state generator disimpan di dalam sg_instance sehingga beberapa
+ * generator independen dapat berjalan dalam satu firmware (misalnya di state
+ * machine atau blok PIO yang berbeda). Program PIO hanya dimuat sekali per
+ * blok PIO dan dipakai bersama oleh semua instance di blok tersebut.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef SIGNAL_GEN_H
+#define SIGNAL_GEN_H
+
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+
+// -- Konstanta Generator --
+#define SG_NUM_PINS 4   // Jumlah pin output berurutan mulai dari pin_base
+#define SG_NUM_EVENTS 4 // Event A, B, C, D per periode
+
+// Overhead instruksi per event (pull, mov, set, jmp terakhir)
+#define SG_EVENT_OVERHEAD_CYCLES 4
+
+// Event D juga mendorong token periode ke FIFO RX (push noblock)
+#define SG_EVENT_D_OVERHEAD_CYCLES (SG_EVENT_OVERHEAD_CYCLES + 1)
+
+// Jarak dari enable state machine sampai edge pertama (pull, mov, set)
+#define SG_START_LATENCY_CYCLES 3
+
+// Jarak minimum dari edge trigger sampai edge pertama pada sg_arm(): wait,
+// jmp x-- (X = 0), jmp, pull dan mov sebelum set. Jeda trigger yang lebih
+// pendek dibulatkan ke nilai ini. Di hardware sinkronisasi input GPIO
+// menambah sekitar 2 siklus clk_sys yang tidak termasuk di sini.
+#define SG_TRIGGER_LATENCY_CYCLES 5
+
+/**
+ * @brief Parameter timing sinyal.
+ */
+typedef struct
+{
+    float frequency_hz;        // Frekuensi sinyal (Hz)
+    float pulse_width_us;      // Lebar pulsa CH1/CH4 dan CH2/CH3 (us)
+    float phase_shift_us;      // Jeda (dead time) antar pasangan kanal (us)
+    float pio_clk_div;         // Clock divider state machine PIO
+    uint64_t trigger_delay_ns; // Jeda edge trigger -> edge pertama untuk sg_arm() (ns)
+} sg_timing_config;
+
+/**
+ * @brief Status siklus hidup sebuah instance generator.
+ */
+typedef enum
+{
+    SG_STATE_UNINIT = 0, // Belum di-init
+    SG_STATE_READY,      // PIO siap, belum ada konfigurasi timing
+    SG_STATE_IDLE,       // Terkonfigurasi, state machine berhenti
+    SG_STATE_RUNNING,    // State machine aktif
+    SG_STATE_ARMED,      // State machine menunggu trigger (sg_arm, sg_schedule)
+} sg_state;
+
+/**
+ * @brief Satu instance generator sinyal.
+ */
+typedef struct
+{
+    PIO pio;                         // Blok PIO yang digunakan
+    uint sm;                         // Nomor state machine
+    uint offset;                     // Offset program di instruction memory
+    uint pin_base;                   // Pin pertama dari SG_NUM_PINS pin output
+    sg_timing_config timing;         // Konfigurasi timing aktif
+    uint32_t sys_clk_hz;             // clk_sys yang dipakai untuk menghitung delay
+    uint32_t delays[SG_NUM_EVENTS];  // Nilai N per event yang dikirim ke FIFO
+    uint32_t trigger_delay;          // Nilai N pre-event trigger (register X)
+    double clock_ppm;                // Kesalahan clk_sys yang dikoreksi (sg_trim_clock)
+    uint32_t dither_frac;            // Pecahan siklus PIO event D per periode (Q0.32)
+    uint32_t dither_acc;             // Akumulator dither event D
+    int alarm;                       // Hardware alarm start terjadwal, -1 jika tidak ada
+    int pps_pin;                     // Pin PPS sg_schedule_pps(), -1 = dilepas flag IRQ
+    uint64_t scheduled_us;           // Waktu alarm terjadwal (us sejak boot)
+    volatile int32_t start_late_us;  // Keterlambatan handler alarm terhadap target (us)
+    sg_timing_config staged_timing;  // Konfigurasi sg_stage() yang menunggu batas periode
+    uint32_t staged_delays[SG_NUM_EVENTS];
+    uint32_t staged_frac;
+    uint32_t staged_trigger_delay;
+    volatile bool staged;            // true sampai staged_* diterapkan pemberi data
+    uint next_event;                 // Event berikutnya untuk sg_service()
+    sg_state state;
+} sg_instance;
+
+// -- API --
+bool sg_init(sg_instance *inst, PIO pio, uint pin_base);
+void sg_deinit(sg_instance *inst);
+bool sg_configure(sg_instance *inst, const sg_timing_config *timing);
+bool sg_sync_clock(sg_instance *inst);
+bool sg_trim_clock(sg_instance *inst, double ppm);
+bool sg_stage(sg_instance *inst, const sg_timing_config *timing);
+void sg_stage_delay_d(sg_instance *inst, uint32_t delay_d);
+void sg_start(sg_instance *inst);
+uint sg_service(sg_instance *inst);
+absolute_time_t sg_run_burst(sg_instance *inst, uint64_t duration_us);
+bool sg_arm(sg_instance *inst, uint trigger_pin, bool active_high);
+bool sg_schedule(sg_instance *inst, absolute_time_t start_time);
+bool sg_schedule_pps(sg_instance *inst, absolute_time_t arm_time, uint pps_pin);
+absolute_time_t sg_run_armed_burst(sg_instance *inst, uint64_t duration_us);
+void sg_stop(sg_instance *inst);
+
+bool sg_calculate_delays(float sys_clk_hz, const sg_timing_config *timing,
+                         uint32_t delays[SG_NUM_EVENTS]);
+bool sg_calculate_trigger_delay(float sys_clk_hz, const sg_timing_config *timing, uint32_t *delay);
+float sg_cycles_to_us(const sg_instance *inst, uint32_t pio_cycles);
+
+#endif
@@ -0,0 +1,275 @@
+/**
+ * Implementasi antarmuka kontrol I2C target bergaya register map.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <string.h>
+
+#include "signal_i2c.h"
+#include "hardware/gpio.h"
+#include "hardware/sync.h"
+#include "pico/i2c_slave.h"
+
+// Baudrate controller; di mode target hanya menentukan timing hold SDA
+#define SG_I2C_BAUDRATE (400 * 1000)
+
+// -- Target Aktif per Controller (dicari oleh handler interrupt) --
+static sg_i2c_instance *targets[NUM_I2CS];
+
+// -- Helper Register --
+
+static void put_u32(uint8_t *regs, uint reg, uint32_t value)
+{
+    for (uint i = 0; i < 4; ++i)
+    {
+        regs[reg + i] = (uint8_t)(value >> (8 * i));
+    }
+}
+
+static uint32_t get_u32(const uint8_t *regs, uint reg)
+{
+    uint32_t value = 0;
+    for (uint i = 0; i < 4; ++i)
+    {
+        value |= (uint32_t)regs[reg + i] << (8 * i);
+    }
+    return value;
+}
+
+/**
+ * @brief Mengambil snapshot seluruh register untuk satu transaksi baca.
+ */
+static void __time_critical_func(take_snapshot)(sg_i2c_instance *t)
+{
+    uint8_t *image = t->read_image;
+    memcpy(image, t->regs, SG_I2C_NUM_REGS);
+
+    uint8_t status = 0;
+    if (t->gen->state == SG_STATE_RUNNING)
+    {
+        status |= SG_I2C_STATUS_RUNNING;
+    }
+    else if (t->gen->state == SG_STATE_ARMED)
+    {
+        status |= SG_I2C_STATUS_ARMED;
+    }
+    if (t->pending || t->control || t->gen->staged)
+    {
+        status |= SG_I2C_STATUS_PENDING;
+    }
+    if (t->error)
+    {
+        status |= SG_I2C_STATUS_ERROR;
+    }
+    image[SG_I2C_REG_ID] = SG_I2C_ID;
+    image[SG_I2C_REG_VERSION] = SG_I2C_VERSION;
+    image[SG_I2C_REG_STATUS] = status;
+    image[SG_I2C_REG_CONTROL] = 0;
+
+    uint64_t periods = t->counter ? sg_count_periods(t->counter) : 0;
+    put_u32(image, SG_I2C_REG_PERIOD_COUNT, (uint32_t)periods);
+    put_u32(image, SG_I2C_REG_PERIOD_COUNT + 4, (uint32_t)(periods >> 32));
+    put_u32(image, SG_I2C_REG_COMMITS, t->commits);
+}
+
+/**
+ * @brief Menyimpan satu byte tulisan master ke register bayangan.
+ */
+static void __time_critical_func(write_register)(sg_i2c_instance *t, uint8_t reg, uint8_t value)
+{
+    if (reg == SG_I2C_REG_CONTROL)
+    {
+        t->control |= value;
+    }
+    else if (reg >= SG_I2C_CONFIG_FIRST && reg < SG_I2C_CONFIG_END)
+    {
+        t->regs[reg] = value;
+    }
+    // Register read-only dan alamat di luar map diabaikan
+}
+
+/**
+ * @brief Menerbitkan CONTROL transaksi yang selesai ke sg_i2c_poll().
+ *
+ * Konfigurasi untuk COMMIT diambil dari register bayangan saat ini, sehingga
+ * register dan commit dalam satu transaksi tulis juga diterapkan bersama.
+ */
+static void __time_critical_func(publish_control)(sg_i2c_instance *t)
+{
+    if (t->control & SG_I2C_CTRL_COMMIT)
+    {
+        sg_timing_config *c = &t->commit_timing;
+        c->frequency_hz = (float)get_u32(t->regs, SG_I2C_REG_FREQUENCY_MILLIHZ) / 1e3f;
+        c->pulse_width_us = (float)get_u32(t->regs, SG_I2C_REG_PULSE_WIDTH_NS) / 1e3f;
+        c->phase_shift_us = (float)get_u32(t->regs, SG_I2C_REG_PHASE_SHIFT_NS) / 1e3f;
+        c->pio_clk_div = t->gen->timing.pio_clk_div;
+        c->trigger_delay_ns = get_u32(t->regs, SG_I2C_REG_TRIGGER_DELAY_NS);
+    }
+    t->pending |= t->control;
+    t->control = 0;
+}
+
+/**
+ * @brief Handler event pico_i2c_slave (konteks interrupt, dari SRAM).
+ */
+static void __time_critical_func(i2c_slave_handler)(i2c_inst_t *i2c, i2c_slave_event_t event)
+{
+    sg_i2c_instance *t = targets[i2c_get_index(i2c)];
+    switch (event)
+    {
+    case I2C_SLAVE_RECEIVE:
+        while (i2c_get_read_available(i2c))
+        {
+            uint8_t value = i2c_read_byte_raw(i2c);
+            if (!t->pointer_written)
+            {
+                t->pointer = value;
+                t->pointer_written = true;
+            }
+            else
+            {
+                write_register(t, t->pointer++, value);
+            }
+        }
+        break;
+
+    case I2C_SLAVE_REQUEST:
+        if (!t->read_started)
+        {
+            take_snapshot(t);
+            t->read_started = true;
+        }
+        i2c_write_byte_raw(i2c, t->pointer < SG_I2C_NUM_REGS ? t->read_image[t->pointer] : 0xff);
+        t->pointer++;
+        break;
+
+    case I2C_SLAVE_FINISH:
+        if (t->control)
+        {
+            publish_control(t);
+        }
+        t->pointer_written = false;
+        t->read_started = false;
+        break;
+    }
+}
+
+/**
+ * @brief Menjalankan controller I2C sebagai target untuk satu generator.
+ *
+ * Register konfigurasi diisi dari timing generator saat ini. Generator harus
+ * sudah dikonfigurasi; selanjutnya hanya sg_i2c_poll() yang boleh
+ * memulai, menghentikan, atau mengisi FIFO-nya.
+ *
+ * @param t Instance target
+ * @param i2c Controller I2C (i2c0 atau i2c1)
+ * @param address Alamat target 7 bit
+ * @param sda_pin GPIO SDA yang sesuai dengan controller
+ * @param scl_pin GPIO SCL yang sesuai dengan controller
+ * @param gen Generator yang dikontrol
+ * @param counter Penghitung periode generator, boleh NULL (PERIOD_COUNT = 0)
+ * @param trigger_pin Pin trigger untuk CONTROL.ARM (lihat sg_arm())
+ * @param trigger_active_high Polaritas trigger
+ * @return false jika controller sudah dipakai atau generator belum dikonfigurasi
+ */
+bool sg_i2c_init(sg_i2c_instance *t, i2c_inst_t *i2c, uint8_t address, uint sda_pin, uint scl_pin,
+                 sg_instance *gen, const sg_count_instance *counter, uint trigger_pin, bool trigger_active_high)
+{
+    uint index = i2c_get_index(i2c);
+    if (targets[index] || gen->state == SG_STATE_UNINIT || gen->state == SG_STATE_READY)
+    {
+        return false;
+    }
+
+    memset(t, 0, sizeof(*t));
+    t->i2c = i2c;
+    t->gen = gen;
+    t->counter = counter;
+    t->trigger_pin = trigger_pin;
+    t->trigger_active_high = trigger_active_high;
+    put_u32(t->regs, SG_I2C_REG_FREQUENCY_MILLIHZ, (uint32_t)(gen->timing.frequency_hz * 1e3f + 0.5f));
+    put_u32(t->regs, SG_I2C_REG_PULSE_WIDTH_NS, (uint32_t)(gen->timing.pulse_width_us * 1e3f + 0.5f));
+    put_u32(t->regs, SG_I2C_REG_PHASE_SHIFT_NS, (uint32_t)(gen->timing.phase_shift_us * 1e3f + 0.5f));
+    put_u32(t->regs, SG_I2C_REG_TRIGGER_DELAY_NS, (uint32_t)gen->timing.trigger_delay_ns);
+    targets[index] = t;
+
+    // Pull-up internal hanya cadangan; bus sebaiknya punya pull-up eksternal
+    gpio_set_function(sda_pin, GPIO_FUNC_I2C);
+    gpio_set_function(scl_pin, GPIO_FUNC_I2C);
+    gpio_pull_up(sda_pin);
+    gpio_pull_up(scl_pin);
+    i2c_init(i2c, SG_I2C_BAUDRATE);
+    i2c_slave_init(i2c, address, i2c_slave_handler);
+    return true;
+}
+
+/**
+ * @brief Melepas controller I2C. Generator tidak dihentikan.
+ *
+ * @param t Instance target
+ */
+void sg_i2c_deinit(sg_i2c_instance *t)
+{
+    i2c_slave_deinit(t->i2c);
+    i2c_deinit(t->i2c);
+    targets[i2c_get_index(t->i2c)] = NULL;
+}
+
+/**
+ * @brief Mengeksekusi perintah CONTROL yang tertunda dan mengisi FIFO generator.
+ *
+ * Panggil terus-menerus dari loop utama; menggantikan sg_service() untuk
+ * generator yang dikontrol lewat I2C. Non-blocking.
+ *
+ * @param t Instance target
+ */
+void __time_critical_func(sg_i2c_poll)(sg_i2c_instance *t)
+{
+    sg_instance *gen = t->gen;
+    if (t->pending)
+    {
+        uint32_t status = save_and_disable_interrupts();
+        uint8_t commands = t->pending;
+        sg_timing_config timing = t->commit_timing;
+        t->pending = 0;
+        restore_interrupts(status);
+
+        bool ok = true;
+        if (commands & SG_I2C_CTRL_STOP)
+        {
+            sg_stop(gen);
+        }
+        if (commands & SG_I2C_CTRL_COMMIT)
+        {
+            // Berjalan atau tidak, konfigurasi diganti utuh di batas periode
+            if (sg_stage(gen, &timing))
+            {
+                t->commits++;
+            }
+            else
+            {
+                ok = false;
+            }
+        }
+        if ((commands & SG_I2C_CTRL_START) && gen->state == SG_STATE_IDLE)
+        {
+            sg_start(gen);
+        }
+        if (commands & SG_I2C_CTRL_ARM)
+        {
+            ok &= sg_arm(gen, t->trigger_pin, t->trigger_active_high);
+        }
+        t->error = !ok;
+    }
+
+    // Trigger yang sudah lolos terlihat dari FIFO yang mulai ditarik
+    if (gen->state == SG_STATE_ARMED && !pio_sm_is_tx_fifo_full(gen->pio, gen->sm))
+    {
+        gen->state = SG_STATE_RUNNING;
+    }
+    if (gen->state == SG_STATE_RUNNING)
+    {
+        sg_service(gen);
+    }
+}
@@ -0,0 +1,102 @@
+/**
+ * Antarmuka kontrol I2C target (slave) bergaya register map.
+ *
+ * MCU host mengatur generator lewat register 8 bit dengan auto-increment.
+ * Nilai multi-byte little-endian. Tulis: [alamat register, data...]. Baca:
+ * tulis [alamat register], repeated START, lalu baca; tanpa alamat baru
+ * pembacaan melanjutkan pointer terakhir.
+ *
+ *   0x00 ID                RO  SG_I2C_ID
+ *   0x01 VERSION           RO  SG_I2C_VERSION
+ *   0x02 STATUS            RO  SG_I2C_STATUS_*
+ *   0x03 CONTROL           WO  SG_I2C_CTRL_*, dibaca 0
+ *   0x04 FREQUENCY_MILLIHZ RW  u32, frekuensi dalam mili-hertz
+ *   0x08 PULSE_WIDTH_NS    RW  u32
+ *   0x0C PHASE_SHIFT_NS    RW  u32
+ *   0x10 TRIGGER_DELAY_NS  RW  u32, jeda trigger -> edge pertama (ARM)
+ *   0x14 PERIOD_COUNT      RO  u64, periode yang sudah keluar (sg_count)
+ *   0x1C COMMITS           RO  u32, commit konfigurasi yang diterima
+ *
+ * Register konfigurasi hanya bayangan: tidak ada yang berubah di output
+ * sampai CONTROL.COMMIT. Commit mengambil keempat register sekaligus dan
+ * diserahkan ke sg_stage(), sehingga konfigurasi baru keluar utuh di batas
+ * periode (paling lambat periode kedua) tanpa periode campuran. Clock divider
+ * PIO tetap milik firmware.
+ *
+ * Handler interrupt I2C hanya menyalin byte: tulisan CONTROL diterbitkan saat
+ * transaksi selesai (STOP atau repeated START) dan dieksekusi oleh
+ * sg_i2c_poll() di loop utama, satu-satunya yang menyentuh state machine dan
+ * FIFO generator. Pembacaan dilayani dari snapshot yang diambil di byte
+ * pertama transaksi baca (register multi-byte selalu konsisten) dan tidak
+ * pernah menunggu maupun menyentuh generator.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef SIGNAL_I2C_H
+#define SIGNAL_I2C_H
+
+#include "signal_count.h"
+#include "hardware/i2c.h"
+
+#define SG_I2C_ID 0x53
+#define SG_I2C_VERSION 1
+
+// -- Alamat Register --
+#define SG_I2C_REG_ID 0x00
+#define SG_I2C_REG_VERSION 0x01
+#define SG_I2C_REG_STATUS 0x02
+#define SG_I2C_REG_CONTROL 0x03
+#define SG_I2C_REG_FREQUENCY_MILLIHZ 0x04
+#define SG_I2C_REG_PULSE_WIDTH_NS 0x08
+#define SG_I2C_REG_PHASE_SHIFT_NS 0x0C
+#define SG_I2C_REG_TRIGGER_DELAY_NS 0x10
+#define SG_I2C_REG_PERIOD_COUNT 0x14
+#define SG_I2C_REG_COMMITS 0x1C
+#define SG_I2C_NUM_REGS 0x20
+
+// Rentang register konfigurasi yang bisa ditulis master
+#define SG_I2C_CONFIG_FIRST SG_I2C_REG_FREQUENCY_MILLIHZ
+#define SG_I2C_CONFIG_END SG_I2C_REG_PERIOD_COUNT
+
+// -- Bit STATUS --
+#define SG_I2C_STATUS_RUNNING 0x01 // Generator mengeluarkan sinyal
+#define SG_I2C_STATUS_ARMED 0x02   // Menunggu trigger (CONTROL.ARM)
+#define SG_I2C_STATUS_PENDING 0x04 // Commit atau perintah belum keluar di output
+#define SG_I2C_STATUS_ERROR 0x08   // Commit atau perintah terakhir ditolak
+
+// -- Bit CONTROL (diproses berurutan STOP, COMMIT, START, ARM) --
+#define SG_I2C_CTRL_START 0x01
+#define SG_I2C_CTRL_STOP 0x02
+#define SG_I2C_CTRL_ARM 0x04
+#define SG_I2C_CTRL_COMMIT 0x08
+
+/**
+ * @brief Target I2C untuk satu instance generator.
+ */
+typedef struct
+{
+    i2c_inst_t *i2c;                         // Controller I2C mode target
+    sg_instance *gen;                        // Generator yang dikontrol
+    const sg_count_instance *counter;        // Sumber PERIOD_COUNT, boleh NULL
+    uint trigger_pin;                        // Pin trigger untuk CONTROL.ARM
+    bool trigger_active_high;
+    uint8_t regs[SG_I2C_NUM_REGS];           // Register bayangan yang ditulis master
+    uint8_t read_image[SG_I2C_NUM_REGS];     // Snapshot transaksi baca
+    uint8_t pointer;                         // Pointer register auto-increment
+    bool pointer_written;                    // Byte pertama transaksi tulis sudah diterima
+    bool read_started;                       // Snapshot transaksi baca sudah diambil
+    uint8_t control;                         // CONTROL yang ditulis transaksi berjalan
+    volatile uint8_t pending;                // Perintah yang menunggu sg_i2c_poll()
+    sg_timing_config commit_timing;          // Konfigurasi saat CONTROL.COMMIT
+    volatile bool error;
+    volatile uint32_t commits;
+} sg_i2c_instance;
+
+// -- API --
+bool sg_i2c_init(sg_i2c_instance *t, i2c_inst_t *i2c, uint8_t address, uint sda_pin, uint scl_pin,
+                 sg_instance *gen, const sg_count_instance *counter, uint trigger_pin, bool trigger_active_high);
+void sg_i2c_deinit(sg_i2c_instance *t);
+void sg_i2c_poll(sg_i2c_instance *t);
+
+#endif
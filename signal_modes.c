@@ -0,0 +1,350 @@
+/**
+ * Implementasi program generator resident dan pergantian mode.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "signal_modes.h"
+#include "signal_generator.pio.h" // Header yang di-generate otomatis
+#include "signal_modes.pio.h"
+#include "signal_sequencer.pio.h"
+
+// -- Program PIO per Mode --
+// Urutan juga menentukan prioritas saat instruction memory tidak cukup
+static const pio_program_t *const mode_programs[SG_NUM_MODES] = {
+    [SG_MODE_CLASSIC] = &signal_generator_program,
+    [SG_MODE_SEQUENCER] = &signal_sequencer_program,
+    [SG_MODE_PACKED] = &signal_packed_program,
+    [SG_MODE_AUTONOMOUS] = &signal_autonomous_program,
+    [SG_MODE_TRIGGERED] = &signal_triggered_program,
+};
+
+// Alamat awal eksekusi relatif terhadap offset program; titik batas periode
+// (stall dengan FIFO kosong) selalu di offset 0
+static const uint mode_entry[SG_NUM_MODES] = {
+    [SG_MODE_CLASSIC] = signal_generator_wrap_target,
+    [SG_MODE_SEQUENCER] = signal_sequencer_wrap_target,
+    [SG_MODE_PACKED] = signal_packed_wrap_target,
+    [SG_MODE_AUTONOMOUS] = signal_autonomous_wrap_target,
+    [SG_MODE_TRIGGERED] = signal_triggered_wrap_target,
+};
+
+// Akhir wrap; instruksi setelahnya (pre-event trigger CLASSIC) hanya dicapai lewat jmp
+static const uint mode_wrap[SG_NUM_MODES] = {
+    [SG_MODE_CLASSIC] = signal_generator_wrap,
+    [SG_MODE_SEQUENCER] = signal_sequencer_wrap,
+    [SG_MODE_PACKED] = signal_packed_wrap,
+    [SG_MODE_AUTONOMOUS] = signal_autonomous_wrap,
+    [SG_MODE_TRIGGERED] = signal_triggered_wrap,
+};
+
+// -- Program PIO yang Dimuat per Blok PIO --
+static struct
+{
+    uint offset;
+    uint users;
+} loaded_program[NUM_PIOS][SG_NUM_MODES];
+
+/**
+ * @brief Menyusun konfigurasi state machine untuk satu mode.
+ *
+ * Semua mode memakai pin yang sama; hanya wrap dan autopull yang berbeda.
+ */
+static pio_sm_config mode_config(const sg_modes_instance *m, sg_mode mode)
+{
+    uint offset = m->offset[mode];
+    pio_sm_config c = pio_get_default_sm_config();
+    sm_config_set_wrap(&c, offset + mode_entry[mode], offset + mode_wrap[mode]);
+
+    // CLASSIC memakai `set pins` (maksimal 5 pin), mode lain `out`/`mov pins`
+    sm_config_set_set_pins(&c, m->pin_base, m->pin_count < 5 ? m->pin_count : 5);
+    sm_config_set_out_pins(&c, m->pin_base, m->pin_count);
+    sm_config_set_in_pins(&c, m->trigger_pin);
+    sm_config_set_out_shift(&c, true, mode == SG_MODE_PACKED, 32);
+    sm_config_set_clkdiv(&c, m->pio_clk_div);
+    return c;
+}
+
+/**
+ * @brief Memeriksa jumlah word awal untuk mode.
+ */
+static bool valid_words(sg_mode mode, uint count)
+{
+    return mode == SG_MODE_AUTONOMOUS ? count == SG_AUTO_NUM_PARAMS : count <= 4;
+}
+
+/**
+ * @brief Memasang mode pada state machine yang berada di titik batas periode
+ *        atau berhenti, lalu mengaktifkannya.
+ *
+ * State machine dinonaktifkan sebentar agar parameter autonomous bisa dimuat
+ * lewat FIFO tanpa ikut ditarik program lama. Restart mengosongkan OSR
+ * sehingga autopull mode PACKED langsung mengambil word pertama.
+ */
+static void __time_critical_func(enter_mode)(sg_modes_instance *m, sg_mode mode, const uint32_t *words,
+                                             uint count)
+{
+    PIO pio = m->pio;
+    uint sm = m->sm;
+
+    pio_sm_set_enabled(pio, sm, false);
+    pio_sm_restart(pio, sm);
+    pio_sm_config c = mode_config(m, mode);
+    pio_sm_set_config(pio, sm, &c);
+    if (mode == SG_MODE_AUTONOMOUS)
+    {
+        // ISR = level aktif, Y = N aktif, OSR = N idle
+        pio_sm_put(pio, sm, words[0]);
+        pio_sm_exec(pio, sm, pio_encode_pull(false, true));
+        pio_sm_exec(pio, sm, pio_encode_mov(pio_isr, pio_osr));
+        pio_sm_put(pio, sm, words[1]);
+        pio_sm_exec(pio, sm, pio_encode_pull(false, true));
+        pio_sm_exec(pio, sm, pio_encode_mov(pio_y, pio_osr));
+        pio_sm_put(pio, sm, words[2]);
+        pio_sm_exec(pio, sm, pio_encode_pull(false, true));
+    }
+    else
+    {
+        for (uint i = 0; i < count; ++i)
+        {
+            pio_sm_put(pio, sm, words[i]);
+        }
+    }
+    pio_sm_exec(pio, sm, pio_encode_jmp(m->offset[mode] + mode_entry[mode]));
+    m->mode = mode;
+    m->state = SG_STATE_RUNNING;
+    pio_sm_set_enabled(pio, sm, true);
+}
+
+/**
+ * @brief Menginisialisasi instance: memuat program mode yang diminta selama
+ *        masih muat, mengklaim state machine, dan mengkonfigurasi pin.
+ *
+ * Program yang sudah dimuat instance lain di blok yang sama dipakai bersama.
+ * Mode yang tidak muat dilewati; periksa hasilnya dengan sg_modes_is_resident().
+ *
+ * @param m Instance yang akan diinisialisasi
+ * @param pio Instance PIO yang akan digunakan (pio0 atau pio1)
+ * @param pin_base Pin pertama dari pin output berurutan
+ * @param pin_count Jumlah pin output (1..SG_SEQ_MAX_CHANNELS)
+ * @param trigger_pin Pin input trigger untuk SG_MODE_TRIGGERED
+ * @param wanted Gabungan SG_MODE_BIT() mode yang diinginkan
+ * @return false jika tidak ada state machine atau tidak satu pun program muat
+ */
+bool sg_modes_init(sg_modes_instance *m, PIO pio, uint pin_base, uint pin_count, uint trigger_pin,
+                   uint32_t wanted)
+{
+    if (pin_count == 0 || pin_count > SG_SEQ_MAX_CHANNELS || wanted == 0 || (wanted & ~SG_MODE_ALL_BITS))
+    {
+        return false;
+    }
+
+    int sm = pio_claim_unused_sm(pio, false);
+    if (sm < 0)
+    {
+        return false;
+    }
+
+    uint pio_index = pio_get_index(pio);
+    m->resident = 0;
+    for (uint mode = 0; mode < SG_NUM_MODES; ++mode)
+    {
+        if (!(wanted & SG_MODE_BIT(mode)))
+        {
+            continue;
+        }
+        if (loaded_program[pio_index][mode].users == 0)
+        {
+            if (!pio_can_add_program(pio, mode_programs[mode]))
+            {
+                continue;
+            }
+            loaded_program[pio_index][mode].offset = pio_add_program(pio, mode_programs[mode]);
+        }
+        loaded_program[pio_index][mode].users++;
+        m->offset[mode] = loaded_program[pio_index][mode].offset;
+        m->resident |= SG_MODE_BIT(mode);
+    }
+    if (m->resident == 0)
+    {
+        pio_sm_unclaim(pio, (uint)sm);
+        return false;
+    }
+
+    m->pio = pio;
+    m->sm = (uint)sm;
+    m->pin_base = pin_base;
+    m->pin_count = pin_count;
+    m->trigger_pin = trigger_pin;
+    m->pio_clk_div = 1.0f;
+    m->mode = SG_MODE_CLASSIC;
+    while (!sg_modes_is_resident(m, m->mode))
+    {
+        m->mode++;
+    }
+
+    for (uint i = 0; i < pin_count; ++i)
+    {
+        pio_gpio_init(pio, pin_base + i);
+    }
+    pio_sm_set_consecutive_pindirs(pio, m->sm, pin_base, pin_count, true);
+    pio_sm_set_pins_with_mask(pio, m->sm, 0, ((1u << pin_count) - 1u) << pin_base);
+
+    pio_sm_config c = mode_config(m, m->mode);
+    pio_sm_init(pio, m->sm, m->offset[m->mode], &c);
+
+    m->state = SG_STATE_READY;
+    return true;
+}
+
+/**
+ * @brief Menghentikan instance dan melepaskan state machine serta programnya.
+ *
+ * @param m Instance yang akan dilepas
+ */
+void sg_modes_deinit(sg_modes_instance *m)
+{
+    if (m->state == SG_STATE_UNINIT)
+    {
+        return;
+    }
+    sg_modes_stop(m);
+    pio_sm_unclaim(m->pio, m->sm);
+
+    uint pio_index = pio_get_index(m->pio);
+    for (uint mode = 0; mode < SG_NUM_MODES; ++mode)
+    {
+        if ((m->resident & SG_MODE_BIT(mode)) && --loaded_program[pio_index][mode].users == 0)
+        {
+            pio_remove_program(m->pio, mode_programs[mode], m->offset[mode]);
+        }
+    }
+    m->resident = 0;
+    m->state = SG_STATE_UNINIT;
+}
+
+/**
+ * @brief Memulai mode dari keadaan berhenti.
+ *
+ * Word awal masuk FIFO (atau register untuk SG_MODE_AUTONOMOUS) sebelum
+ * state machine diaktifkan. Mode FIFO selanjutnya diberi data dengan
+ * sg_modes_put().
+ *
+ * @param m Instance yang berhenti
+ * @param mode Mode yang dijalankan (harus resident)
+ * @param pio_clk_div Clock divider state machine, berlaku untuk semua mode
+ * @param words Word awal sesuai format mode
+ * @param count Jumlah word: 0..4 untuk mode FIFO, SG_AUTO_NUM_PARAMS untuk
+ *              SG_MODE_AUTONOMOUS
+ * @return false jika instance berjalan, mode tidak resident, atau jumlah
+ *         word tidak valid
+ */
+bool sg_modes_start(sg_modes_instance *m, sg_mode mode, float pio_clk_div, const uint32_t *words, uint count)
+{
+    if (m->state == SG_STATE_UNINIT || m->state == SG_STATE_RUNNING || !sg_modes_is_resident(m, mode) ||
+        !valid_words(mode, count))
+    {
+        return false;
+    }
+
+    m->pio_clk_div = pio_clk_div;
+    pio_sm_set_enabled(m->pio, m->sm, false);
+    pio_sm_clear_fifos(m->pio, m->sm);
+    pio_sm_set_pins_with_mask(m->pio, m->sm, 0, ((1u << m->pin_count) - 1u) << m->pin_base);
+    enter_mode(m, mode, words, count);
+    return true;
+}
+
+/**
+ * @brief Mengirim word ke FIFO TX mode yang sedang berjalan (blocking).
+ *
+ * @param m Instance yang berjalan dalam mode FIFO
+ * @param words Word sesuai format mode aktif
+ * @param count Jumlah word
+ */
+void __time_critical_func(sg_modes_put)(sg_modes_instance *m, const uint32_t *words, uint count)
+{
+    for (uint i = 0; i < count; ++i)
+    {
+        pio_sm_put_blocking(m->pio, m->sm, words[i]);
+    }
+}
+
+/**
+ * @brief Mengganti mode di batas periode tanpa memuat ulang program.
+ *
+ * Untuk mode FIFO, pemanggil harus sudah mengirim periode terakhir secara
+ * utuh dengan sg_modes_put(); fungsi ini menunggu flag TXSTALL di FDEBUG,
+ * yaitu sampai state machine menghabiskan word terakhir dan stall pada pull
+ * awal periode berikutnya. Flag yang sama di-set oleh pull mana pun yang
+ * menunggu, jadi word yang belum didorong membuat pergantian terjadi di
+ * tengah periode. SG_MODE_AUTONOMOUS diarahkan ke `park` lewat wrap_target
+ * sehingga berhenti setelah segmen idle periode yang sedang berjalan. Setelah
+ * itu konfigurasi diganti dan state machine melompat ke program baru dengan
+ * pio_sm_exec().
+ *
+ * @param m Instance yang sedang berjalan (atau berhenti, sama dengan
+ *          sg_modes_start() dengan clock divider terakhir)
+ * @param mode Mode baru (harus resident)
+ * @param words Word awal mode baru, lihat sg_modes_start()
+ * @param count Jumlah word awal
+ * @return false jika mode tidak resident atau jumlah word tidak valid
+ */
+bool __time_critical_func(sg_modes_switch)(sg_modes_instance *m, sg_mode mode, const uint32_t *words, uint count)
+{
+    if (m->state != SG_STATE_RUNNING)
+    {
+        return sg_modes_start(m, mode, m->pio_clk_div, words, count);
+    }
+    if (!sg_modes_is_resident(m, mode) || !valid_words(mode, count))
+    {
+        return false;
+    }
+
+    PIO pio = m->pio;
+    uint sm = m->sm;
+    uint boundary = m->offset[m->mode];
+    if (m->mode == SG_MODE_AUTONOMOUS)
+    {
+        // Akhir segmen idle kembali ke `park` (stall di pull), bukan ke awal periode
+        pio_sm_set_wrap(pio, sm, boundary + signal_autonomous_offset_park, boundary + signal_autonomous_wrap);
+    }
+    // PC di batas periode dengan FIFO kosong belum berarti selesai: pada mode
+    // autopull OSR masih bisa berisi word. TXSTALL (sticky) baru di-set saat
+    // pull di batas periode menunggu FIFO kosong, jadi hapus dulu lalu tunggu
+    uint32_t txstall = 1u << (PIO_FDEBUG_TXSTALL_LSB + sm);
+    pio->fdebug = txstall;
+    do
+    {
+        tight_loop_contents();
+    } while (!(pio->fdebug & txstall));
+    enter_mode(m, mode, words, count);
+    return true;
+}
+
+/**
+ * @brief Menghentikan state machine dan menurunkan semua pin output.
+ *
+ * @param m Instance
+ */
+void sg_modes_stop(sg_modes_instance *m)
+{
+    pio_sm_set_enabled(m->pio, m->sm, false);
+    pio_sm_clear_fifos(m->pio, m->sm);
+    pio_sm_set_pins_with_mask(m->pio, m->sm, 0, ((1u << m->pin_count) - 1u) << m->pin_base);
+    if (m->state == SG_STATE_RUNNING)
+    {
+        m->state = SG_STATE_IDLE;
+    }
+}
+
+/**
+ * @brief Jumlah instruksi program sebuah mode.
+ *
+ * @param mode Mode
+ * @return Panjang program (instruksi)
+ */
+uint sg_modes_program_length(sg_mode mode)
+{
+    return (uint)mode < SG_NUM_MODES ? mode_programs[mode]->length : 0;
+}
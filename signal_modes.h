@@ -0,0 +1,118 @@
+/**
+ * Beberapa program generator resident sekaligus dengan pergantian mode cepat.
+ *
+ * Satu state machine memakai beberapa varian program yang dimuat bersamaan
+ * ke instruction memory (32 instruksi per blok PIO):
+ *
+ *   SG_MODE_CLASSIC     signal_generator, 4 delay per periode (19 instruksi)
+ *   SG_MODE_SEQUENCER   signal_sequencer, word SG_SEQ_EVENT (4 instruksi)
+ *   SG_MODE_PACKED      dua event 16 bit per word, SG_PACKED_WORD (6 instruksi)
+ *   SG_MODE_AUTONOMOUS  pulsa periodik tanpa feed, SG_AUTO_PARAMS (7 instruksi)
+ *   SG_MODE_TRIGGERED   event yang bisa menunggu pin trigger, SG_TRIG_EVENT
+ *                       (8 instruksi)
+ *
+ * Program dimuat sesuai urutan di atas selama masih muat; mode yang tidak
+ * muat dilaporkan lewat sg_modes_is_resident(). Tanpa CLASSIC keempat mode
+ * lainnya memakai 25 instruksi.
+ *
+ * Pergantian mode tidak memuat ulang program: sg_modes_switch() menghapus
+ * flag sticky TXSTALL state machine di FDEBUG lalu menunggu flag itu di-set
+ * lagi, yaitu saat pull menunggu FIFO kosong, kemudian mengganti konfigurasi
+ * state machine dan melompat ke program baru dengan pio_sm_exec(). Untuk mode
+ * FIFO, seluruh word periode terakhir harus sudah didorong dengan
+ * sg_modes_put() (put_blocking) sebelum pergantian: stall pull di tengah
+ * periode (underrun) juga men-set TXSTALL sehingga periode itu terpotong.
+ * Level event terakhir mode lama bertahan selama pergantian, sehingga periode
+ * terakhir sebaiknya diakhiri event idle.
+ * Latensi pergantian (jeda tambahan dibanding periode berikutnya tanpa
+ * pergantian) diukur per pasangan mode oleh host/sg_modes.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef SIGNAL_MODES_H
+#define SIGNAL_MODES_H
+
+#include "signal_seq.h"
+
+/**
+ * @brief Varian program generator.
+ */
+typedef enum
+{
+    SG_MODE_CLASSIC = 0,
+    SG_MODE_SEQUENCER,
+    SG_MODE_PACKED,
+    SG_MODE_AUTONOMOUS,
+    SG_MODE_TRIGGERED,
+    SG_NUM_MODES,
+} sg_mode;
+
+#define SG_MODE_BIT(mode) (1u << (mode))
+#define SG_MODE_ALL_BITS ((1u << SG_NUM_MODES) - 1u)
+
+// -- Format Word Mode Packed --
+#define SG_PACKED_OVERHEAD_CYCLES 3 // out, out, jmp terakhir
+#define SG_PACKED_DURATION_BITS 12
+#define SG_PACKED_MAX_EVENT_CYCLES ((1u << SG_PACKED_DURATION_BITS) - 1u + SG_PACKED_OVERHEAD_CYCLES)
+
+// Satu event 16 bit: level 4 pin pertama selama `cycles` siklus PIO (>= 3)
+#define SG_PACKED_EVENT(mask, cycles) \
+    ((((uint32_t)(mask) & 0xfu) << SG_PACKED_DURATION_BITS) | ((uint32_t)(cycles) - SG_PACKED_OVERHEAD_CYCLES))
+#define SG_PACKED_WORD(first, second) ((uint32_t)(first) | ((uint32_t)(second) << 16))
+
+// -- Parameter Mode Autonomous --
+#define SG_AUTO_OVERHEAD_CYCLES 3 // mov pins, mov x, jmp terakhir
+#define SG_AUTO_NUM_PARAMS 3
+
+// Tiga word untuk sg_modes_start()/sg_modes_switch(): level aktif `mask`
+// selama `active` siklus, lalu semua LOW selama `idle` siklus (>= 3)
+#define SG_AUTO_PARAMS(mask, active, idle) \
+    (mask), ((uint32_t)(active) - SG_AUTO_OVERHEAD_CYCLES), ((uint32_t)(idle) - SG_AUTO_OVERHEAD_CYCLES)
+
+// -- Format Word Mode Triggered --
+#define SG_TRIG_OVERHEAD_CYCLES 6 // pull, out, out, jmp, out, jmp terakhir
+#define SG_TRIG_DURATION_BITS 23
+#define SG_TRIG_WAIT_BIT (1u << SG_TRIG_DURATION_BITS)
+
+// Event sequencer yang menunggu edge naik trigger sebelum dimulai jika `wait`
+#define SG_TRIG_EVENT(mask, cycles, wait)                                           \
+    (((uint32_t)(mask) << SG_SEQ_DURATION_BITS) | ((wait) ? SG_TRIG_WAIT_BIT : 0u) | \
+     ((uint32_t)(cycles) - SG_TRIG_OVERHEAD_CYCLES))
+
+/**
+ * @brief Satu state machine dengan beberapa program resident.
+ */
+typedef struct
+{
+    PIO pio;                    // Blok PIO yang digunakan
+    uint sm;                    // Nomor state machine
+    uint pin_base;              // Pin pertama
+    uint pin_count;             // Jumlah pin output (<= SG_SEQ_MAX_CHANNELS)
+    uint trigger_pin;           // Pin input untuk SG_MODE_TRIGGERED
+    uint32_t resident;          // SG_MODE_BIT() mode yang programnya dimuat
+    uint offset[SG_NUM_MODES];  // Offset program per mode (hanya jika resident)
+    float pio_clk_div;          // Clock divider aktif
+    sg_mode mode;               // Mode yang sedang/terakhir berjalan
+    sg_state state;
+} sg_modes_instance;
+
+// -- API --
+bool sg_modes_init(sg_modes_instance *m, PIO pio, uint pin_base, uint pin_count, uint trigger_pin,
+                   uint32_t wanted);
+void sg_modes_deinit(sg_modes_instance *m);
+bool sg_modes_start(sg_modes_instance *m, sg_mode mode, float pio_clk_div, const uint32_t *words, uint count);
+void sg_modes_put(sg_modes_instance *m, const uint32_t *words, uint count);
+bool sg_modes_switch(sg_modes_instance *m, sg_mode mode, const uint32_t *words, uint count);
+void sg_modes_stop(sg_modes_instance *m);
+uint sg_modes_program_length(sg_mode mode);
+
+/**
+ * @brief Memeriksa apakah program mode dimuat di instruction memory.
+ */
+static inline bool sg_modes_is_resident(const sg_modes_instance *m, sg_mode mode)
+{
+    return (uint)mode < SG_NUM_MODES && (m->resident & SG_MODE_BIT(mode));
+}
+
+#endif
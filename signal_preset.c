@@ -0,0 +1,420 @@
+/**
+ * Implementasi preset konfigurasi di flash.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "signal_preset.h"
+#include "hardware/flash.h"
+#include "pico/flash.h"
+
+#define RECORD_MAGIC 0x31504753u // "SGP1"
+#define FLASH_TIMEOUT_MS 100     // Batas tunggu core 1 masuk lockout
+
+/**
+ * @brief Jenis record log.
+ */
+typedef enum
+{
+    RECORD_PRESET = 1,   // Isi slot
+    RECORD_DELETE = 2,   // Slot dikosongkan
+    RECORD_POWER_ON = 3, // Slot preset power-on (atau SG_PRESET_NONE) dan output
+} record_kind;
+
+/**
+ * @brief Record di awal satu halaman flash; sisa halaman tetap 0xFF.
+ */
+typedef struct
+{
+    uint32_t magic;
+    uint32_t sequence;
+    uint8_t kind;
+    uint8_t slot;
+    uint8_t trigger_source;
+    uint8_t output; // Hanya RECORD_POWER_ON
+    char name[SG_PRESET_NAME_MAX];
+    float frequency_hz;
+    float pulse_width_us;
+    float phase_shift_us;
+    float pio_clk_div;
+    uint64_t trigger_delay_ns;
+    uint32_t burst_cycles;
+    uint32_t crc; // CRC-32 semua byte sebelumnya
+} record;
+
+_Static_assert(sizeof(record) <= FLASH_PAGE_SIZE, "record preset harus muat satu halaman");
+_Static_assert(SG_PRESET_COUNT + 2 <= SG_PRESET_PAGES_PER_SECTOR, "record berlaku harus muat satu sektor");
+
+/**
+ * @brief Operasi flash yang dijalankan flash_safe_execute().
+ */
+typedef struct
+{
+    uint32_t offset;
+    const uint8_t *data; // NULL = erase satu sektor
+} flash_op;
+
+// -- Helper --
+
+/**
+ * @brief CRC-32 (polinom 0xEDB88320) dengan tabel per nibble.
+ */
+static uint32_t crc32(const void *data, size_t len)
+{
+    static const uint32_t table[16] = {
+        0x00000000u, 0x1DB71064u, 0x3B6E20C8u, 0x26D930ACu, 0x76DC4190u, 0x6B6B51F4u, 0x4DB26158u, 0x5005713Cu,
+        0xEDB88320u, 0xF00F9344u, 0xD6D6A3E8u, 0xCB61B38Cu, 0x9B64C2B0u, 0x86D3D2D4u, 0xA00AE278u, 0xBDBDF21Cu,
+    };
+    const uint8_t *p = data;
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < len; ++i)
+    {
+        crc ^= p[i];
+        crc = (crc >> 4) ^ table[crc & 0xFu];
+        crc = (crc >> 4) ^ table[crc & 0xFu];
+    }
+    return ~crc;
+}
+
+static const record *record_at(uint32_t offset)
+{
+    return (const record *)(XIP_BASE + offset);
+}
+
+static uint32_t page_offset(uint sector, uint page)
+{
+    return SG_PRESET_FLASH_OFFSET + sector * FLASH_SECTOR_SIZE + page * FLASH_PAGE_SIZE;
+}
+
+static uint sector_of(uint32_t offset)
+{
+    return (offset - SG_PRESET_FLASH_OFFSET) / FLASH_SECTOR_SIZE;
+}
+
+static bool is_blank(const void *data, size_t len)
+{
+    const uint8_t *p = data;
+    for (size_t i = 0; i < len; ++i)
+    {
+        if (p[i] != 0xFFu)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool record_valid(const record *r)
+{
+    return r->magic == RECORD_MAGIC && r->crc == crc32(r, offsetof(record, crc)) && r->kind >= RECORD_PRESET &&
+           r->kind <= RECORD_POWER_ON && (r->slot < SG_PRESET_COUNT || r->kind == RECORD_POWER_ON);
+}
+
+// Nomor urut boleh melewati 2^32: "lebih baru" dibandingkan lewat selisih
+static bool sequence_newer(uint32_t a, uint32_t b)
+{
+    return (int32_t)(a - b) > 0;
+}
+
+// -- Akses Flash --
+
+static void __no_inline_not_in_flash_func(run_flash_op)(void *param)
+{
+    const flash_op *op = param;
+    if (op->data)
+    {
+        flash_range_program(op->offset, op->data, FLASH_PAGE_SIZE);
+    }
+    else
+    {
+        flash_range_erase(op->offset, FLASH_SECTOR_SIZE);
+    }
+}
+
+static bool erase_sector(sg_preset_store *store, uint sector)
+{
+    flash_op op = {.offset = page_offset(sector, 0), .data = NULL};
+    if (flash_safe_execute(run_flash_op, &op, FLASH_TIMEOUT_MS) != PICO_OK)
+    {
+        return false;
+    }
+    store->erases++;
+    return is_blank(record_at(op.offset), FLASH_SECTOR_SIZE);
+}
+
+/**
+ * @brief Memprogram record ke halaman tulis berikutnya dan memperbarui indeks.
+ *
+ * Halaman tetap terpakai walaupun verifikasi gagal.
+ */
+static bool program_record(sg_preset_store *store, record *r)
+{
+    if (store->page >= SG_PRESET_PAGES_PER_SECTOR)
+    {
+        return false;
+    }
+    r->magic = RECORD_MAGIC;
+    r->sequence = store->sequence++;
+    r->crc = crc32(r, offsetof(record, crc));
+
+    uint8_t page[FLASH_PAGE_SIZE];
+    memset(page, 0xFF, sizeof(page));
+    memcpy(page, r, sizeof(*r));
+    flash_op op = {.offset = page_offset(store->sector, store->page), .data = page};
+    store->page++;
+    if (flash_safe_execute(run_flash_op, &op, FLASH_TIMEOUT_MS) != PICO_OK)
+    {
+        return false;
+    }
+    store->writes++;
+    if (memcmp(record_at(op.offset), r, sizeof(*r)) != 0)
+    {
+        return false;
+    }
+
+    if (r->kind == RECORD_POWER_ON)
+    {
+        store->power_on_slot = r->slot;
+        store->power_on_output = r->output != 0;
+        store->power_on_offset = r->slot == SG_PRESET_NONE ? 0 : op.offset;
+    }
+    else
+    {
+        store->slot_offset[r->slot] = r->kind == RECORD_PRESET ? op.offset : 0;
+    }
+    return true;
+}
+
+/**
+ * @brief Menyalin record yang masih berlaku dari sektor cadangan ke sektor
+ *        tulis lalu meng-erase sektor cadangan.
+ *
+ * Record DELETE dan power-on kosong tidak perlu disalin: tidak ada record
+ * lebih tua untuk slot yang sama di luar sektor tertua.
+ */
+static bool reclaim(sg_preset_store *store)
+{
+    uint reserve = (store->sector + 1) % SG_PRESET_SECTORS;
+    if (is_blank(record_at(page_offset(reserve, 0)), FLASH_SECTOR_SIZE))
+    {
+        return true;
+    }
+    for (uint slot = 0; slot < SG_PRESET_COUNT; ++slot)
+    {
+        if (store->slot_offset[slot] && sector_of(store->slot_offset[slot]) == reserve)
+        {
+            record copy = *record_at(store->slot_offset[slot]);
+            if (!program_record(store, &copy))
+            {
+                return false;
+            }
+        }
+    }
+    if (store->power_on_offset && sector_of(store->power_on_offset) == reserve)
+    {
+        record copy = *record_at(store->power_on_offset);
+        if (!program_record(store, &copy))
+        {
+            return false;
+        }
+    }
+    return erase_sector(store, reserve);
+}
+
+/**
+ * @brief Menulis satu record baru, pindah ke sektor cadangan bila penuh.
+ */
+static bool append(sg_preset_store *store, record *r)
+{
+    // Sektor cadangan belum kosong setelah listrik padam di tengah reclaim
+    if (!reclaim(store))
+    {
+        return false;
+    }
+    if (store->page >= SG_PRESET_PAGES_PER_SECTOR)
+    {
+        store->sector = (store->sector + 1) % SG_PRESET_SECTORS;
+        store->page = 0;
+        if (!reclaim(store))
+        {
+            return false;
+        }
+    }
+    return program_record(store, r);
+}
+
+// -- API --
+
+/**
+ * @brief Membangun indeks dari isi region preset di flash.
+ *
+ * Hanya membaca (XIP); record dengan CRC salah diabaikan. Region yang belum
+ * pernah ditulis atau berisi data lain dibaca sebagai kosong dan dibersihkan
+ * bertahap oleh penulisan berikutnya.
+ *
+ * @param store Indeks yang diisi
+ */
+void sg_preset_init(sg_preset_store *store)
+{
+    memset(store, 0, sizeof(*store));
+    store->power_on_slot = SG_PRESET_NONE;
+
+    uint32_t slot_sequence[SG_PRESET_COUNT] = {0};
+    bool slot_seen[SG_PRESET_COUNT] = {false};
+    uint32_t power_on_sequence = 0;
+    bool power_on_seen = false;
+    uint32_t newest = 0;
+    bool any = false;
+    uint used_pages[SG_PRESET_SECTORS] = {0};
+
+    for (uint sector = 0; sector < SG_PRESET_SECTORS; ++sector)
+    {
+        for (uint page = 0; page < SG_PRESET_PAGES_PER_SECTOR; ++page)
+        {
+            uint32_t offset = page_offset(sector, page);
+            const record *r = record_at(offset);
+            // Sisa halaman setelah record selalu diprogram 0xFF
+            if (is_blank(r, sizeof(*r)))
+            {
+                continue;
+            }
+            used_pages[sector] = page + 1;
+            if (!record_valid(r))
+            {
+                store->corrupt++;
+                continue;
+            }
+            store->records++;
+            if (!any || sequence_newer(r->sequence, newest))
+            {
+                newest = r->sequence;
+                store->sector = sector;
+                any = true;
+            }
+            if (r->kind == RECORD_POWER_ON)
+            {
+                if (!power_on_seen || sequence_newer(r->sequence, power_on_sequence))
+                {
+                    power_on_seen = true;
+                    power_on_sequence = r->sequence;
+                    store->power_on_slot = r->slot < SG_PRESET_COUNT ? r->slot : SG_PRESET_NONE;
+                    store->power_on_output = r->output != 0;
+                    store->power_on_offset = store->power_on_slot == SG_PRESET_NONE ? 0 : offset;
+                }
+            }
+            else if (!slot_seen[r->slot] || sequence_newer(r->sequence, slot_sequence[r->slot]))
+            {
+                slot_seen[r->slot] = true;
+                slot_sequence[r->slot] = r->sequence;
+                store->slot_offset[r->slot] = r->kind == RECORD_PRESET ? offset : 0;
+            }
+        }
+    }
+    store->page = used_pages[store->sector];
+    store->sequence = any ? newest + 1 : 1;
+}
+
+/**
+ * @brief Membaca isi slot.
+ *
+ * @return false jika slot kosong atau di luar range
+ */
+bool sg_preset_load(const sg_preset_store *store, uint slot, sg_preset *preset)
+{
+    if (slot >= SG_PRESET_COUNT || store->slot_offset[slot] == 0)
+    {
+        return false;
+    }
+    const record *r = record_at(store->slot_offset[slot]);
+    memset(preset, 0, sizeof(*preset));
+    memcpy(preset->name, r->name, SG_PRESET_NAME_MAX);
+    preset->timing.frequency_hz = r->frequency_hz;
+    preset->timing.pulse_width_us = r->pulse_width_us;
+    preset->timing.phase_shift_us = r->phase_shift_us;
+    preset->timing.pio_clk_div = r->pio_clk_div;
+    preset->timing.trigger_delay_ns = r->trigger_delay_ns;
+    preset->burst_cycles = r->burst_cycles;
+    preset->trigger_source = r->trigger_source;
+    return true;
+}
+
+/**
+ * @brief Menyimpan preset ke slot, menggantikan isi sebelumnya.
+ *
+ * Memblok selama program (dan erase saat pindah sektor); jangan dipanggil
+ * saat generator klasik berjalan.
+ *
+ * @param store Indeks region preset
+ * @param slot 0..SG_PRESET_COUNT-1
+ * @param preset Isi baru; nama dipotong ke SG_PRESET_NAME_MAX karakter
+ * @return false jika slot di luar range atau penulisan flash gagal
+ */
+bool sg_preset_save(sg_preset_store *store, uint slot, const sg_preset *preset)
+{
+    if (slot >= SG_PRESET_COUNT)
+    {
+        return false;
+    }
+    record r;
+    memset(&r, 0, sizeof(r));
+    r.kind = RECORD_PRESET;
+    r.slot = (uint8_t)slot;
+    r.trigger_source = preset->trigger_source;
+    strncpy(r.name, preset->name, SG_PRESET_NAME_MAX);
+    r.frequency_hz = preset->timing.frequency_hz;
+    r.pulse_width_us = preset->timing.pulse_width_us;
+    r.phase_shift_us = preset->timing.phase_shift_us;
+    r.pio_clk_div = preset->timing.pio_clk_div;
+    r.trigger_delay_ns = preset->timing.trigger_delay_ns;
+    r.burst_cycles = preset->burst_cycles;
+    return append(store, &r);
+}
+
+/**
+ * @brief Mengosongkan slot. Slot yang sudah kosong tidak menulis flash.
+ */
+bool sg_preset_delete(sg_preset_store *store, uint slot)
+{
+    if (slot >= SG_PRESET_COUNT)
+    {
+        return false;
+    }
+    if (store->slot_offset[slot] == 0)
+    {
+        return true;
+    }
+    record r;
+    memset(&r, 0, sizeof(r));
+    r.kind = RECORD_DELETE;
+    r.slot = (uint8_t)slot;
+    return append(store, &r);
+}
+
+/**
+ * @brief Memilih preset yang dipanggil saat boot.
+ *
+ * @param store Indeks region preset
+ * @param slot 0..SG_PRESET_COUNT-1, atau SG_PRESET_NONE untuk konstanta bawaan
+ * @param output Output langsung aktif setelah preset dipanggil
+ */
+bool sg_preset_set_power_on(sg_preset_store *store, uint slot, bool output)
+{
+    if (slot >= SG_PRESET_COUNT && slot != SG_PRESET_NONE)
+    {
+        return false;
+    }
+    output = output && slot != SG_PRESET_NONE;
+    if (slot == store->power_on_slot && output == store->power_on_output)
+    {
+        return true;
+    }
+    record r;
+    memset(&r, 0, sizeof(r));
+    r.kind = RECORD_POWER_ON;
+    r.slot = (uint8_t)slot;
+    r.output = output ? 1 : 0;
+    return append(store, &r);
+}
@@ -0,0 +1,92 @@
+/**
+ * Preset konfigurasi bernama di flash dengan wear leveling dan CRC.
+ *
+ * SG_PRESET_COUNT preset disimpan di SG_PRESET_SECTORS sektor terakhir flash
+ * sebagai log: setiap penyimpanan, penghapusan, atau perubahan preset
+ * power-on menulis satu record baru (satu halaman flash, nomor urut naik,
+ * CRC-32) ke halaman kosong berikutnya; record dengan nomor urut tertinggi
+ * untuk satu slot yang berlaku. Sektor dipakai bergiliran sehingga setiap
+ * sektor di-erase sama seringnya. Satu sektor selalu kosong sebagai cadangan:
+ * saat penulisan pindah ke sektor cadangan, record yang masih berlaku di
+ * sektor tertua disalin dulu ke sektor baru, baru sektor tertua di-erase
+ * menjadi cadangan berikutnya. Listrik padam di tengah penulisan atau erase
+ * hanya merusak record yang sedang ditulis (CRC salah, diabaikan): slot itu
+ * tetap berisi nilai lamanya.
+ *
+ * Selain slot, log menyimpan preset power-on: slot yang dipanggil saat boot
+ * dan apakah output langsung aktif. sg_preset_init() hanya membaca lewat XIP
+ * (bagian record saja, bukan seluruh halaman), jadi cukup cepat untuk
+ * dipanggil di awal boot sebelum stdio. Erase dan program dijalankan lewat
+ * flash_safe_execute(): interrupt dimatikan dan core 1 ditahan selama flash
+ * tidak bisa dibaca (core 1 yang berjalan harus sudah memanggil
+ * flash_safe_execute_core_init(), misalnya di awal loop sg_prog_run()).
+ * Penulisan memakan waktu sampai puluhan milidetik (erase sektor), sehingga
+ * feed CPU generator klasik terhenti; pemanggil harus menyimpan preset hanya
+ * saat generator berhenti.
+ *
+ * Region flash ini harus berada di luar binary (SG_PRESET_FLASH_OFFSET).
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef SIGNAL_PRESET_H
+#define SIGNAL_PRESET_H
+
+#include "signal_gen.h"
+#include "hardware/flash.h"
+
+#define SG_PRESET_COUNT 8
+#define SG_PRESET_NAME_MAX 16 // Karakter, tanpa terminator
+#define SG_PRESET_SECTORS 4   // Minimal 2 (satu cadangan)
+#define SG_PRESET_FLASH_OFFSET (PICO_FLASH_SIZE_BYTES - SG_PRESET_SECTORS * FLASH_SECTOR_SIZE)
+#define SG_PRESET_PAGES_PER_SECTOR (FLASH_SECTOR_SIZE / FLASH_PAGE_SIZE)
+#define SG_PRESET_NONE 0xFFu  // Tidak ada preset power-on
+
+/**
+ * @brief Satu set konfigurasi yang disimpan.
+ */
+typedef struct
+{
+    char name[SG_PRESET_NAME_MAX + 1];
+    sg_timing_config timing;
+    uint32_t burst_cycles;  // 0 = kontinu
+    uint8_t trigger_source; // Nilai sg_scpi_trigger_source
+} sg_preset;
+
+/**
+ * @brief Indeks RAM atas region preset di flash.
+ *
+ * Alamat record yang berlaku per slot (0 = kosong) dan posisi tulis
+ * berikutnya, dibangun sg_preset_init() dan diperbarui setiap penulisan.
+ */
+typedef struct
+{
+    uint32_t slot_offset[SG_PRESET_COUNT]; // Offset flash record slot, 0 = kosong
+    uint32_t power_on_offset;              // Offset record power-on, 0 = tidak ada
+    uint8_t power_on_slot;                 // SG_PRESET_NONE = tidak ada
+    bool power_on_output;                  // Output aktif setelah preset power-on dipanggil
+    uint sector;                           // Sektor tulis (0..SG_PRESET_SECTORS-1)
+    uint page;                             // Halaman kosong berikutnya di sektor tulis
+    uint32_t sequence;                     // Nomor urut record berikutnya
+    uint32_t records;                      // Record valid saat scan
+    uint32_t corrupt;                      // Halaman terisi dengan CRC salah saat scan
+    uint32_t writes;                       // Halaman yang diprogram sejak init
+    uint32_t erases;                       // Sektor yang di-erase sejak init
+} sg_preset_store;
+
+// -- API --
+void sg_preset_init(sg_preset_store *store);
+bool sg_preset_load(const sg_preset_store *store, uint slot, sg_preset *preset);
+bool sg_preset_save(sg_preset_store *store, uint slot, const sg_preset *preset);
+bool sg_preset_delete(sg_preset_store *store, uint slot);
+bool sg_preset_set_power_on(sg_preset_store *store, uint slot, bool output);
+
+/**
+ * @brief Slot preset power-on, SG_PRESET_NONE jika tidak ada.
+ */
+static inline uint sg_preset_power_on(const sg_preset_store *store)
+{
+    return store->power_on_slot;
+}
+
+#endif
@@ -0,0 +1,323 @@
+/**
+ * Implementasi interpreter program sequence hierarkis.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "signal_prog.h"
+
+static uint32_t word_op(uint32_t word)
+{
+    return word >> SG_PROG_OP_SHIFT;
+}
+
+static uint32_t word_operand(uint32_t word)
+{
+    return word & SG_PROG_OPERAND_MASK;
+}
+
+/**
+ * @brief Panjang instruksi di pc (word), termasuk word event milik EMIT.
+ */
+static uint instruction_length(const uint32_t *code, uint pc)
+{
+    return word_op(code[pc]) == SG_PROG_OP_EMIT ? 1u + word_operand(code[pc]) : 1u;
+}
+
+/**
+ * @brief Memeriksa apakah target adalah awal instruksi di luar REPEAT.
+ */
+static bool is_top_level_instruction(const uint32_t *code, uint length, uint target)
+{
+    uint depth = 0;
+    uint pc = 0;
+    while (pc < target && pc < length)
+    {
+        uint32_t op = word_op(code[pc]);
+        if (op == SG_PROG_OP_REPEAT)
+        {
+            depth++;
+        }
+        else if (op == SG_PROG_OP_END && depth > 0)
+        {
+            depth--;
+        }
+        pc += instruction_length(code, pc);
+    }
+    return pc == target && target < length && depth == 0;
+}
+
+/**
+ * @brief Memeriksa apakah instruksi di [from, to) mengirim minimal satu event.
+ */
+static bool has_event_between(const uint32_t *code, uint from, uint to)
+{
+    for (uint pc = from; pc < to; pc += instruction_length(code, pc))
+    {
+        if (word_op(code[pc]) == SG_PROG_OP_EMIT && word_operand(code[pc]) > 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Memeriksa struktur program sebelum dijalankan.
+ *
+ * Setiap blok EMIT harus muat di dalam program, REPEAT dan END harus
+ * berpasangan dengan kedalaman maksimal SG_PROG_MAX_DEPTH dan jumlah ulang
+ * minimal 1, JUMP hanya boleh di luar REPEAT ke awal instruksi di luar
+ * REPEAT. Setiap badan loop dan setiap lompatan mundur wajib mengirim event,
+ * sehingga interpreter tidak pernah berputar tanpa mengisi FIFO.
+ *
+ * @param code Word program
+ * @param length Panjang program (word)
+ * @return true jika program valid
+ */
+bool sg_prog_validate(const uint32_t *code, uint length)
+{
+    bool has_event[SG_PROG_MAX_DEPTH + 1] = {false};
+    uint depth = 0;
+    uint pc = 0;
+    while (pc < length)
+    {
+        uint32_t operand = word_operand(code[pc]);
+        switch (word_op(code[pc]))
+        {
+        case SG_PROG_OP_EMIT:
+            if (operand > length - pc - 1u)
+            {
+                return false;
+            }
+            if (operand > 0)
+            {
+                for (uint d = 0; d <= depth; ++d)
+                {
+                    has_event[d] = true;
+                }
+            }
+            break;
+        case SG_PROG_OP_REPEAT:
+            if (operand == 0 || depth == SG_PROG_MAX_DEPTH)
+            {
+                return false;
+            }
+            has_event[++depth] = false;
+            break;
+        case SG_PROG_OP_END:
+            if (depth == 0 || !has_event[depth])
+            {
+                return false;
+            }
+            depth--;
+            break;
+        case SG_PROG_OP_JUMP:
+            if (depth != 0 || !is_top_level_instruction(code, length, operand) ||
+                (operand <= pc && !has_event_between(code, operand, pc)))
+            {
+                return false;
+            }
+            break;
+        case SG_PROG_OP_HALT:
+            break;
+        default:
+            return false;
+        }
+        pc += instruction_length(code, pc);
+    }
+    return depth == 0;
+}
+
+static uint64_t add_saturate(uint64_t a, uint64_t b)
+{
+    return a > SG_PROG_INFINITE - b ? SG_PROG_INFINITE : a + b;
+}
+
+static uint64_t mul_saturate(uint64_t a, uint64_t b)
+{
+    return b != 0 && a > SG_PROG_INFINITE / b ? SG_PROG_INFINITE : a * b;
+}
+
+/**
+ * @brief Menghitung jumlah event yang dihasilkan program yang sudah valid.
+ *
+ * @param code Word program (lolos sg_prog_validate())
+ * @param length Panjang program (word)
+ * @return Jumlah event, atau SG_PROG_INFINITE jika program berulang tanpa akhir
+ */
+uint64_t sg_prog_expanded_events(const uint32_t *code, uint length)
+{
+    uint64_t sum[SG_PROG_MAX_DEPTH + 1];
+    uint32_t repeat[SG_PROG_MAX_DEPTH + 1];
+    uint depth = 0;
+    uint pc = 0;
+    sum[0] = 0;
+    while (pc < length)
+    {
+        uint32_t operand = word_operand(code[pc]);
+        switch (word_op(code[pc]))
+        {
+        case SG_PROG_OP_EMIT:
+            sum[depth] = add_saturate(sum[depth], operand);
+            break;
+        case SG_PROG_OP_REPEAT:
+            depth++;
+            sum[depth] = 0;
+            repeat[depth] = operand;
+            break;
+        case SG_PROG_OP_END:
+            sum[depth - 1] = add_saturate(sum[depth - 1], mul_saturate(sum[depth], repeat[depth]));
+            depth--;
+            break;
+        case SG_PROG_OP_JUMP:
+            if (operand <= pc)
+            {
+                return SG_PROG_INFINITE;
+            }
+            pc = operand;
+            continue;
+        default:
+            // HALT di dalam loop: semua loop luar masih di iterasi pertama
+            for (uint d = depth; d > 0; --d)
+            {
+                sum[d - 1] = add_saturate(sum[d - 1], sum[d]);
+            }
+            return sum[0];
+        }
+        pc += instruction_length(code, pc);
+    }
+    return sum[0];
+}
+
+/**
+ * @brief Mengeksekusi satu opcode kontrol.
+ */
+static void step_control(sg_prog_state *state)
+{
+    if (state->pc >= state->length)
+    {
+        state->halted = true;
+        return;
+    }
+    uint32_t word = state->code[state->pc++];
+    uint32_t operand = word_operand(word);
+    switch (word_op(word))
+    {
+    case SG_PROG_OP_EMIT:
+        state->emit_left = operand;
+        break;
+    case SG_PROG_OP_REPEAT:
+        state->loops[state->depth].body = state->pc;
+        state->loops[state->depth].left = operand;
+        state->depth++;
+        break;
+    case SG_PROG_OP_END:
+        if (--state->loops[state->depth - 1].left > 0)
+        {
+            state->pc = state->loops[state->depth - 1].body;
+        }
+        else
+        {
+            state->depth--;
+        }
+        break;
+    case SG_PROG_OP_JUMP:
+        state->pc = operand;
+        break;
+    default:
+        state->halted = true;
+        break;
+    }
+}
+
+/**
+ * @brief Memulai program pada instance sequencer yang berhenti.
+ *
+ * FIFO diisi penuh sebelum state machine diaktifkan, sehingga edge pertama
+ * muncul SG_START_LATENCY_CYCLES siklus PIO setelah enable seperti
+ * sg_seq_start(). Panggil sg_prog_service() atau sg_prog_run() setelahnya.
+ *
+ * @param inst Instance sequencer
+ * @param state State interpreter; harus tetap valid selama program berjalan
+ * @param code Word program; tidak boleh berubah selama berjalan
+ * @param length Panjang program (word)
+ * @param pio_clk_div Clock divider state machine
+ * @param idle_mask Level pin sebelum start dan setelah stop
+ * @return false jika program tidak valid, tidak menghasilkan event, atau
+ *         instance sedang berjalan
+ */
+bool sg_prog_start(sg_seq_instance *inst, sg_prog_state *state, const uint32_t *code, uint length,
+                   float pio_clk_div, uint32_t idle_mask)
+{
+    if (!sg_prog_validate(code, length) || sg_prog_expanded_events(code, length) == 0 ||
+        !sg_seq_prepare_feed(inst, pio_clk_div, idle_mask))
+    {
+        return false;
+    }
+
+    state->code = code;
+    state->length = length;
+    state->pc = 0;
+    state->emit_left = 0;
+    state->depth = 0;
+    state->events = 0;
+    state->halted = false;
+
+    sg_prog_service(inst, state);
+    inst->state = SG_STATE_RUNNING;
+    pio_sm_set_enabled(inst->pio, inst->sm, true);
+    return true;
+}
+
+/**
+ * @brief Mengisi FIFO TX dari program sebanyak ruang yang tersedia tanpa blocking.
+ *
+ * @param inst Instance yang menjalankan program
+ * @param state State interpreter dari sg_prog_start()
+ * @return Jumlah event yang dikirim ke FIFO
+ */
+uint __time_critical_func(sg_prog_service)(sg_seq_instance *inst, sg_prog_state *state)
+{
+    uint pushed = 0;
+    while (!state->halted && !pio_sm_is_tx_fifo_full(inst->pio, inst->sm))
+    {
+        // Opcode kontrol diproses sampai event berikutnya tersedia
+        while (state->emit_left == 0 && !state->halted)
+        {
+            step_control(state);
+        }
+        if (state->halted)
+        {
+            break;
+        }
+        pio_sm_put(inst->pio, inst->sm, state->code[state->pc++]);
+        state->emit_left--;
+        state->events++;
+        pushed++;
+    }
+    return pushed;
+}
+
+/**
+ * @brief Menjalankan program sampai HALT sambil mengisi FIFO terus-menerus.
+ *
+ * Dimaksudkan sebagai badan loop core 1. Kembali setelah word event terakhir
+ * ditarik state machine; event terakhir masih berjalan dan levelnya bertahan
+ * sampai sg_seq_stop(). Program tanpa akhir (JUMP mundur) tidak pernah
+ * kembali kecuali state->halted di-set dari core lain.
+ *
+ * @param inst Instance yang menjalankan program
+ * @param state State interpreter dari sg_prog_start()
+ */
+void __time_critical_func(sg_prog_run)(sg_seq_instance *inst, sg_prog_state *state)
+{
+    while (!state->halted)
+    {
+        sg_prog_service(inst, state);
+    }
+    while (!pio_sm_is_tx_fifo_empty(inst->pio, inst->sm))
+    {
+        tight_loop_contents();
+    }
+}
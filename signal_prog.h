@@ -0,0 +1,84 @@
+/**
+ * Program sequence hierarkis untuk sequencer: loop bersarang tanpa ekspansi.
+ *
+ * Pola uji yang panjang umumnya berupa pengulangan (N pulsa, jeda, lalu
+ * semuanya diulang M kali). Alih-alih mengekspansi pola menjadi daftar event
+ * datar, pola disimpan sebagai program word 32-bit dengan opcode di 4 bit
+ * teratas:
+ *
+ *   SG_PROG_EMIT(n)    n word event (SG_SEQ_EVENT) berikutnya dikirim apa adanya
+ *   SG_PROG_REPEAT(n)  badan sampai SG_PROG_END diulang n kali (bersarang
+ *                      sampai SG_PROG_MAX_DEPTH)
+ *   SG_PROG_END        akhir badan REPEAT
+ *   SG_PROG_JUMP(a)    lompat ke word a (hanya di luar REPEAT), misalnya
+ *                      untuk pola tanpa akhir
+ *   SG_PROG_HALT       akhir program (word nol juga berarti HALT)
+ *
+ * Contoh 10^9 periode pulsa 1 MHz dalam 7 word (28 byte):
+ *
+ *   SG_PROG_REPEAT(1000), SG_PROG_REPEAT(1000000), SG_PROG_EMIT(2),
+ *   SG_SEQ_EVENT(1, 63), SG_SEQ_EVENT(0, 62), SG_PROG_END, SG_PROG_END
+ *
+ * Interpreter mengisi FIFO TX sequencer secara real time: opcode kontrol
+ * diproses di antara push tanpa menghasilkan event, sehingga batas
+ * pengulangan tidak menambah jeda pada output selama FIFO tidak kosong.
+ * sg_prog_run() dirancang sebagai badan loop core 1 (multicore_launch_core1)
+ * agar core 0 tetap bebas.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef SIGNAL_PROG_H
+#define SIGNAL_PROG_H
+
+#include "signal_seq.h"
+
+// -- Format Word Program --
+#define SG_PROG_OP_SHIFT 28
+#define SG_PROG_OPERAND_MASK ((1u << SG_PROG_OP_SHIFT) - 1u)
+#define SG_PROG_MAX_DEPTH 8
+
+#define SG_PROG_OP_HALT 0u
+#define SG_PROG_OP_EMIT 1u
+#define SG_PROG_OP_REPEAT 2u
+#define SG_PROG_OP_END 3u
+#define SG_PROG_OP_JUMP 4u
+
+#define SG_PROG_WORD(op, operand) (((uint32_t)(op) << SG_PROG_OP_SHIFT) | ((uint32_t)(operand) & SG_PROG_OPERAND_MASK))
+#define SG_PROG_HALT SG_PROG_WORD(SG_PROG_OP_HALT, 0)
+#define SG_PROG_EMIT(n) SG_PROG_WORD(SG_PROG_OP_EMIT, n)
+#define SG_PROG_REPEAT(n) SG_PROG_WORD(SG_PROG_OP_REPEAT, n)
+#define SG_PROG_END SG_PROG_WORD(SG_PROG_OP_END, 0)
+#define SG_PROG_JUMP(addr) SG_PROG_WORD(SG_PROG_OP_JUMP, addr)
+
+// Jumlah event hasil ekspansi untuk program yang tidak pernah berhenti
+#define SG_PROG_INFINITE UINT64_MAX
+
+/**
+ * @brief State interpreter satu program.
+ */
+typedef struct
+{
+    const uint32_t *code;
+    uint length;    // Panjang program (word)
+    uint pc;        // Word berikutnya
+    uint emit_left; // Sisa word event pada blok EMIT yang sedang berjalan
+    uint depth;     // Kedalaman REPEAT aktif
+    struct
+    {
+        uint body;     // Word pertama badan loop
+        uint32_t left; // Sisa iterasi termasuk yang sedang berjalan
+    } loops[SG_PROG_MAX_DEPTH];
+    uint64_t events; // Event yang sudah dikirim ke FIFO
+    volatile bool halted;
+} sg_prog_state;
+
+// -- API --
+bool sg_prog_validate(const uint32_t *code, uint length);
+uint64_t sg_prog_expanded_events(const uint32_t *code, uint length);
+bool sg_prog_start(sg_seq_instance *inst, sg_prog_state *state, const uint32_t *code, uint length,
+                   float pio_clk_div, uint32_t idle_mask);
+uint sg_prog_service(sg_seq_instance *inst, sg_prog_state *state);
+void sg_prog_run(sg_seq_instance *inst, sg_prog_state *state);
+
+#endif
@@ -0,0 +1,147 @@
+/**
+ * Implementasi PWM komplementer dengan dead time.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "signal_pwm.h"
+#include "hardware/clocks.h"
+
+/**
+ * @brief Menghitung dead time konfigurasi dalam siklus PIO.
+ */
+static uint32_t deadtime_cycles(float sys_clk_hz, const sg_pwm_config *config)
+{
+    return (uint32_t)(config->deadtime_us * 1e-6f * sys_clk_hz / config->pio_clk_div);
+}
+
+/**
+ * @brief Membangun daftar event satu periode PWM komplementer.
+ *
+ * Urutan event: sisi A, dead time, sisi B, dead time. Sisi yang waktu
+ * aktifnya lebih pendek dari SG_EVENT_OVERHEAD_CYCLES dihilangkan dan
+ * waktunya digabung ke jeda, sehingga duty 0 dan 1 tetap valid. Periode
+ * selalu diakhiri jeda semua-mati minimal satu dead time.
+ *
+ * @param sys_clk_hz Frekuensi clock sistem (Hz)
+ * @param config Parameter PWM
+ * @param out Daftar event hasil kompilasi
+ * @return false jika parameter tidak valid atau dead time lebih pendek dari
+ *         SG_EVENT_OVERHEAD_CYCLES
+ */
+bool sg_pwm_compile(float sys_clk_hz, const sg_pwm_config *config, sg_event_list *out)
+{
+    if (config->frequency_hz <= 0.0f || config->pio_clk_div < 1.0f || config->duty < 0.0f ||
+        config->duty > 1.0f)
+    {
+        return false;
+    }
+
+    float pio_clk_hz = sys_clk_hz / config->pio_clk_div;
+    uint32_t period = (uint32_t)(pio_clk_hz / config->frequency_hz);
+    uint32_t deadtime = deadtime_cycles(sys_clk_hz, config);
+    if (deadtime < SG_EVENT_OVERHEAD_CYCLES || period > SG_SEQ_MAX_EVENT_CYCLES ||
+        period < 2 * deadtime + SG_EVENT_OVERHEAD_CYCLES)
+    {
+        return false;
+    }
+
+    // Waktu aktif masing-masing sisi setelah dikurangi dead time
+    int32_t a_on = (int32_t)(config->duty * (float)period + 0.5f);
+    int32_t side_a = a_on - (int32_t)deadtime;
+    int32_t side_b = (int32_t)period - a_on - (int32_t)deadtime;
+    if (side_a < SG_EVENT_OVERHEAD_CYCLES)
+    {
+        side_a = 0;
+    }
+    if (side_b < SG_EVENT_OVERHEAD_CYCLES)
+    {
+        side_b = 0;
+    }
+
+    out->count = 0;
+    out->has_lead_in = false;
+    out->period_cycles = period;
+    out->idle_mask = 0;
+    if (side_a && side_b)
+    {
+        out->events[out->count++] = SG_SEQ_EVENT(SG_PWM_SIDE_A_MASK, side_a);
+        out->events[out->count++] = SG_SEQ_EVENT(0, deadtime);
+        out->events[out->count++] = SG_SEQ_EVENT(SG_PWM_SIDE_B_MASK, side_b);
+        out->events[out->count++] = SG_SEQ_EVENT(0, period - side_a - side_b - deadtime);
+    }
+    else if (side_a)
+    {
+        out->events[out->count++] = SG_SEQ_EVENT(SG_PWM_SIDE_A_MASK, side_a);
+        out->events[out->count++] = SG_SEQ_EVENT(0, period - side_a);
+    }
+    else if (side_b && (uint32_t)a_on < SG_EVENT_OVERHEAD_CYCLES)
+    {
+        // Jeda di awal terlalu pendek untuk satu event: sisi B dimajukan
+        out->events[out->count++] = SG_SEQ_EVENT(SG_PWM_SIDE_B_MASK, side_b);
+        out->events[out->count++] = SG_SEQ_EVENT(0, period - side_b);
+    }
+    else if (side_b)
+    {
+        out->events[out->count++] = SG_SEQ_EVENT(0, a_on);
+        out->events[out->count++] = SG_SEQ_EVENT(SG_PWM_SIDE_B_MASK, side_b);
+        out->events[out->count++] = SG_SEQ_EVENT(0, deadtime);
+    }
+    else
+    {
+        out->events[out->count++] = SG_SEQ_EVENT(0, period);
+    }
+    return true;
+}
+
+/**
+ * @brief Memasang PWM komplementer ke instance sequencer yang berhenti.
+ *
+ * @param inst Instance sequencer dengan minimal 2 pin output
+ * @param config Parameter PWM
+ * @return false jika parameter tidak valid atau pemeriksaan interlock gagal
+ */
+bool sg_pwm_configure(sg_seq_instance *inst, const sg_pwm_config *config)
+{
+    if (inst->pin_count < 2)
+    {
+        return false;
+    }
+
+    float sys_clk_hz = (float)clock_get_hz(clk_sys);
+    sg_event_list list;
+    if (!sg_pwm_compile(sys_clk_hz, config, &list) ||
+        !sg_seq_check_interlock(&list, SG_PWM_SIDE_A_MASK, SG_PWM_SIDE_B_MASK, deadtime_cycles(sys_clk_hz, config)))
+    {
+        return false;
+    }
+    return sg_seq_load(inst, &list, config->pio_clk_div);
+}
+
+/**
+ * @brief Mengubah duty/frekuensi/dead time tanpa menghentikan state machine.
+ *
+ * Daftar event baru dipakai mulai batas periode berikutnya. Clock divider
+ * tidak bisa diubah saat berjalan.
+ *
+ * @param inst Instance sequencer yang sudah dikonfigurasi dengan sg_pwm_configure()
+ * @param config Parameter PWM baru
+ * @return false jika parameter tidak valid, interlock gagal, atau pembaruan
+ *         sebelumnya belum dipakai (coba lagi pada periode berikutnya)
+ */
+bool sg_pwm_update(sg_seq_instance *inst, const sg_pwm_config *config)
+{
+    if (config->pio_clk_div != inst->pio_clk_div)
+    {
+        return false;
+    }
+
+    float sys_clk_hz = (float)inst->sys_clk_hz;
+    sg_event_list list;
+    if (!sg_pwm_compile(sys_clk_hz, config, &list) ||
+        !sg_seq_check_interlock(&list, SG_PWM_SIDE_A_MASK, SG_PWM_SIDE_B_MASK, deadtime_cycles(sys_clk_hz, config)))
+    {
+        return false;
+    }
+    return sg_seq_update(inst, &list);
+}
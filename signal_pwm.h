@@ -0,0 +1,40 @@
+/**
+ * PWM komplementer dengan dead time untuk pola gate-drive H-bridge.
+ *
+ * Dibangun di atas sequencer signal_seq. Satu periode terdiri dari sisi A
+ * (CH1 + CH4, diagonal high-left/low-right), jeda dead time, sisi B (CH2 +
+ * CH3) dan jeda dead time kedua. Pasangan per leg adalah CH1/CH2 dan CH4/CH3;
+ * untuk half-bridge cukup memakai CH1/CH2. Setiap daftar event diperiksa
+ * dengan sg_seq_check_interlock() sebelum dipasang, sehingga kedua sisi tidak
+ * pernah aktif bersamaan, termasuk saat duty diubah di tengah jalan atau stop.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef SIGNAL_PWM_H
+#define SIGNAL_PWM_H
+
+#include "signal_seq.h"
+
+// -- Pemetaan Pin --
+#define SG_PWM_NUM_PINS 4
+#define SG_PWM_SIDE_A_MASK 0x9u // CH1 + CH4
+#define SG_PWM_SIDE_B_MASK 0x6u // CH2 + CH3
+
+/**
+ * @brief Parameter PWM komplementer.
+ */
+typedef struct
+{
+    float frequency_hz; // Frekuensi PWM (Hz)
+    float duty;         // Porsi periode untuk sisi A sebelum dead time (0.0 .. 1.0)
+    float deadtime_us;  // Dead time di setiap pergantian sisi (us)
+    float pio_clk_div;  // Clock divider state machine PIO
+} sg_pwm_config;
+
+// -- API --
+bool sg_pwm_compile(float sys_clk_hz, const sg_pwm_config *config, sg_event_list *out);
+bool sg_pwm_configure(sg_seq_instance *inst, const sg_pwm_config *config);
+bool sg_pwm_update(sg_seq_instance *inst, const sg_pwm_config *config);
+
+#endif
@@ -0,0 +1,1454 @@
+/**
+ * Implementasi parser perintah SCPI.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "signal_scpi.h"
+#include "hardware/dma.h"
+#include "hardware/sync.h"
+
+#define RING_MASK (SG_SCPI_RING_SIZE - 1)
+#define HEADER_MAX 48 // Header lengkap setelah path ditambahkan
+
+// Digit setelah mantissa mencapai batas ini hanya menggeser eksponen
+#define MANTISSA_LIMIT 100000000000000000ull
+
+// Nilai SCPI untuk INFinity pada query
+#define SCPI_INFINITY "9.9E37"
+
+// -- Flag Perintah --
+#define CMD_SET 0x01   // Bentuk perintah ada
+#define CMD_QUERY 0x02 // Bentuk query ada
+#define CMD_PARAM 0x04 // Bentuk perintah butuh satu parameter
+#define CMD_QUERY_PARAM 0x08 // Bentuk query butuh satu parameter (MEM:STAT:NAME? <n>)
+
+typedef int (*command_fn)(sg_scpi_instance *s, bool query, const char *param, const char *end);
+
+/**
+ * @brief Satu baris tabel perintah.
+ *
+ * Pola ditulis sebagai node `:NODe`, node opsional dalam `[...]`; bagian
+ * huruf besar adalah bentuk pendek.
+ */
+typedef struct
+{
+    const char *pattern;
+    command_fn fn;
+    uint8_t flags;
+} command;
+
+/**
+ * @brief Satuan yang boleh mengikuti angka beserta pengalinya.
+ */
+typedef struct
+{
+    const char *suffix;
+    double scale;
+} unit;
+
+static const unit frequency_units[] = {{"HZ", 1.0}, {"KHZ", 1e3}, {"MHZ", 1e6}, {NULL, 0.0}};
+static const unit time_units[] = {{"S", 1.0}, {"MS", 1e-3}, {"US", 1e-6}, {"NS", 1e-9}, {NULL, 0.0}};
+
+static const double powers_of_ten[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                       1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+// -- Helper Karakter --
+
+static bool is_space(char c)
+{
+    return c == ' ' || c == '\t';
+}
+
+static bool is_digit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+static char to_upper(char c)
+{
+    return (c >= 'a' && c <= 'z') ? (char)(c - 'a' + 'A') : c;
+}
+
+/**
+ * @brief Membandingkan satu node header dengan mnemonic pola.
+ *
+ * Node cocok jika sama (tanpa memperhatikan huruf besar/kecil) dengan bentuk
+ * pendek (awalan huruf besar pola) atau bentuk panjang (seluruh pola).
+ */
+static bool mnemonic_equal(const char *pattern, size_t pattern_len, const char *node, size_t node_len)
+{
+    size_t short_len = 0;
+    while (short_len < pattern_len && !(pattern[short_len] >= 'a' && pattern[short_len] <= 'z'))
+    {
+        short_len++;
+    }
+    if (node_len != short_len && node_len != pattern_len)
+    {
+        return false;
+    }
+    for (size_t i = 0; i < node_len; ++i)
+    {
+        if (to_upper(node[i]) != to_upper(pattern[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Mencocokkan header lengkap (diawali ':') dengan pola tabel.
+ */
+static bool match_nodes(const char *pattern, const char *header, const char *end)
+{
+    if (*pattern == '\0')
+    {
+        return header == end;
+    }
+    bool optional = *pattern == '[';
+    if (optional)
+    {
+        pattern++;
+    }
+    pattern++; // ':'
+    const char *name = pattern;
+    while (*pattern && *pattern != ':' && *pattern != '[' && *pattern != ']')
+    {
+        pattern++;
+    }
+    size_t name_len = (size_t)(pattern - name);
+    if (optional)
+    {
+        pattern++; // ']'
+        if (match_nodes(pattern, header, end))
+        {
+            return true;
+        }
+    }
+    if (header == end || *header != ':')
+    {
+        return false;
+    }
+    const char *node = header + 1;
+    const char *node_end = node;
+    while (node_end < end && *node_end != ':')
+    {
+        node_end++;
+    }
+    return mnemonic_equal(name, name_len, node, (size_t)(node_end - node)) && match_nodes(pattern, node_end, end);
+}
+
+/**
+ * @brief Parameter karakter (ON, IMMediate, ...) sama dengan mnemonic pola.
+ */
+static bool word_equal(const char *param, const char *end, const char *pattern)
+{
+    return mnemonic_equal(pattern, strlen(pattern), param, (size_t)(end - param));
+}
+
+// -- Angka --
+
+/**
+ * @brief Mengurai angka desimal SCPI (<NRf>) tanpa strtod.
+ *
+ * @param cursor Awal angka; digeser ke karakter pertama setelah angka
+ * @return false jika tidak ada digit
+ */
+static bool parse_number(const char **cursor, const char *end, double *value)
+{
+    const char *p = *cursor;
+    bool negative = false;
+    if (p < end && (*p == '+' || *p == '-'))
+    {
+        negative = *p == '-';
+        p++;
+    }
+    uint64_t mantissa = 0;
+    int exponent = 0;
+    bool digits = false;
+    for (; p < end && is_digit(*p); ++p)
+    {
+        digits = true;
+        if (mantissa < MANTISSA_LIMIT)
+        {
+            mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+        }
+        else
+        {
+            exponent++;
+        }
+    }
+    if (p < end && *p == '.')
+    {
+        for (++p; p < end && is_digit(*p); ++p)
+        {
+            digits = true;
+            if (mantissa < MANTISSA_LIMIT)
+            {
+                mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+                exponent--;
+            }
+        }
+    }
+    if (!digits)
+    {
+        return false;
+    }
+
+    // Eksponen hanya jika diikuti digit; "5E" tanpa digit bukan angka valid
+    if (p < end && (*p == 'e' || *p == 'E'))
+    {
+        const char *q = p + 1;
+        bool exp_negative = false;
+        if (q < end && (*q == '+' || *q == '-'))
+        {
+            exp_negative = *q == '-';
+            q++;
+        }
+        if (q < end && is_digit(*q))
+        {
+            int e = 0;
+            for (; q < end && is_digit(*q); ++q)
+            {
+                if (e < 1000)
+                {
+                    e = e * 10 + (*q - '0');
+                }
+            }
+            exponent += exp_negative ? -e : e;
+            p = q;
+        }
+    }
+
+    // Pengali pangkat sepuluh dari tabel: tepat untuk mantissa < 2^53
+    double v = (double)mantissa;
+    const int max_step = (int)count_of(powers_of_ten) - 1;
+    while (exponent > 0 && v != 0.0)
+    {
+        int step = exponent < max_step ? exponent : max_step;
+        v *= powers_of_ten[step];
+        exponent -= step;
+    }
+    while (exponent < 0 && v != 0.0)
+    {
+        int step = -exponent < max_step ? -exponent : max_step;
+        v /= powers_of_ten[step];
+        exponent += step;
+    }
+    *value = negative ? -v : v;
+    *cursor = p;
+    return true;
+}
+
+/**
+ * @brief Mengurai angka dengan satuan opsional.
+ *
+ * @return SG_SCPI_ERR_NONE, SG_SCPI_ERR_DATA_TYPE jika bukan angka, atau
+ *         SG_SCPI_ERR_INVALID_SUFFIX jika satuan tidak dikenal
+ */
+static int parse_quantity(const char *param, const char *end, const unit *units, double *value)
+{
+    const char *p = param;
+    if (!parse_number(&p, end, value))
+    {
+        return SG_SCPI_ERR_DATA_TYPE;
+    }
+    while (p < end && is_space(*p))
+    {
+        p++;
+    }
+    if (p == end)
+    {
+        return SG_SCPI_ERR_NONE;
+    }
+    size_t len = (size_t)(end - p);
+    for (const unit *u = units; u->suffix; ++u)
+    {
+        if (strlen(u->suffix) == len)
+        {
+            bool same = true;
+            for (size_t i = 0; i < len && same; ++i)
+            {
+                same = to_upper(p[i]) == u->suffix[i];
+            }
+            if (same)
+            {
+                *value *= u->scale;
+                return SG_SCPI_ERR_NONE;
+            }
+        }
+    }
+    return SG_SCPI_ERR_INVALID_SUFFIX;
+}
+
+/**
+ * @brief Parameter boolean SCPI: ON, OFF, 1 atau 0.
+ */
+static int parse_boolean(const char *param, const char *end, bool *value)
+{
+    if (word_equal(param, end, "ON") || word_equal(param, end, "1"))
+    {
+        *value = true;
+    }
+    else if (word_equal(param, end, "OFF") || word_equal(param, end, "0"))
+    {
+        *value = false;
+    }
+    else
+    {
+        return SG_SCPI_ERR_DATA_TYPE;
+    }
+    return SG_SCPI_ERR_NONE;
+}
+
+/**
+ * @brief Nomor slot preset <n> (0..SG_PRESET_COUNT-1).
+ */
+static int parse_slot(const char *param, const char *end, uint *slot)
+{
+    double value;
+    const char *p = param;
+    if (!parse_number(&p, end, &value) || p != end)
+    {
+        return SG_SCPI_ERR_DATA_TYPE;
+    }
+    if (value < 0.0 || value >= SG_PRESET_COUNT || value != (double)(uint)value)
+    {
+        return SG_SCPI_ERR_OUT_OF_RANGE;
+    }
+    *slot = (uint)value;
+    return SG_SCPI_ERR_NONE;
+}
+
+// -- Antrean Error dan Jawaban --
+
+static void push_error(sg_scpi_instance *s, int code)
+{
+    if (s->error_count == SG_SCPI_ERROR_QUEUE)
+    {
+        // Antrean penuh: error terakhir diganti Queue overflow
+        s->errors[(s->error_first + SG_SCPI_ERROR_QUEUE - 1) % SG_SCPI_ERROR_QUEUE] = SG_SCPI_ERR_QUEUE_OVERFLOW;
+        return;
+    }
+    s->errors[(s->error_first + s->error_count) % SG_SCPI_ERROR_QUEUE] = (int16_t)code;
+    s->error_count++;
+}
+
+static int pop_error(sg_scpi_instance *s)
+{
+    if (s->error_count == 0)
+    {
+        return SG_SCPI_ERR_NONE;
+    }
+    int code = s->errors[s->error_first];
+    s->error_first = (s->error_first + 1) % SG_SCPI_ERROR_QUEUE;
+    s->error_count--;
+    return code;
+}
+
+/**
+ * @brief Menambahkan satu jawaban query ke baris jawaban (dipisah ';').
+ */
+static void respond(sg_scpi_instance *s, const char *fmt, ...)
+{
+    // Sisakan satu byte untuk newline penutup; jawaban yang tidak muat dipotong
+    size_t room = SG_SCPI_RESPONSE_MAX - 1 - s->response_len;
+    if (s->response_len > 0)
+    {
+        if (room < 2)
+        {
+            return;
+        }
+        s->response[s->response_len++] = ';';
+        room--;
+    }
+    va_list args;
+    va_start(args, fmt);
+    int n = vsnprintf(&s->response[s->response_len], room, fmt, args);
+    va_end(args);
+    if (n > 0)
+    {
+        s->response_len += (size_t)n < room ? (uint)n : (uint)(room - 1);
+    }
+}
+
+// -- Generator --
+
+static uint set_index(const sg_scpi_instance *s, uintptr_t addr)
+{
+    uintptr_t base = (uintptr_t)s->sets;
+    return addr < base ? SG_SCPI_NUM_SETS : (uint)((addr - base) / sizeof(s->sets[0]));
+}
+
+/**
+ * @brief Memilih set yang bukan set aktif dan bukan set yang sedang dibaca
+ *        channel data (lihat free_set() di signal_spi.c).
+ */
+static uint free_set(const sg_scpi_instance *s)
+{
+    uint reading = set_index(s, (uintptr_t)dma_channel_hw_addr((uint)s->dma_data)->read_addr);
+    uint active = set_index(s, (uintptr_t)s->active);
+    uint i = 0;
+    while (i == reading || i == active)
+    {
+        i++;
+    }
+    return i;
+}
+
+/**
+ * @brief Memeriksa apakah rantai stop BURS:NCYC sempat mengalihkan channel
+ *        kontrol antara push token (event D) dan pull event A berikutnya.
+ */
+static bool ncycle_stop_fits(const sg_timing_config *timing, uint32_t cycles, uint32_t delay_d)
+{
+    return cycles < 2 || (float)(delay_d + 1) * timing->pio_clk_div >= SG_SCPI_NCYCLE_STOP_CYCLES;
+}
+
+static inline uint32_t txstall_mask(const sg_instance *gen)
+{
+    return 1u << (PIO_FDEBUG_TXSTALL_LSB + gen->sm);
+}
+
+static void release_channels(sg_scpi_instance *s)
+{
+    int *chan[3] = {&s->dma_ctrl, &s->dma_data, &s->dma_stop};
+    for (uint i = 0; i < 3; ++i)
+    {
+        if (*chan[i] >= 0)
+        {
+            dma_channel_unclaim((uint)*chan[i]);
+            *chan[i] = -1;
+        }
+    }
+}
+
+/**
+ * @brief Mengkonfigurasi channel DMA burst berikutnya lalu menjalankannya.
+ *
+ * Tanpa BURS:NCYC channel kontrol dan data saling chain tanpa akhir. Dengan
+ * n periode, channel hitung menguras n - 1 token periode lalu chain ke
+ * channel stop, yang menulis &ctrl_sink ke WRITE_ADDR channel kontrol;
+ * untuk n = 1 channel kontrol langsung menulis ke ctrl_sink.
+ *
+ * @param s Instance parser, generator sudah di-restart
+ * @param prefilled true jika periode pertama sudah di FIFO TX (sg_arm()),
+ *        false jika channel data mengisinya dari set aktif
+ */
+static void start_feed(sg_scpi_instance *s, bool prefilled)
+{
+    sg_instance *gen = s->gen;
+    PIO pio = gen->pio;
+    uint sm = gen->sm;
+    uint ctrl = (uint)s->dma_ctrl;
+    uint data = (uint)s->dma_data;
+    uint32_t cycles = s->burst_cycles;
+
+    dma_channel_config dc = dma_channel_get_default_config(data);
+    channel_config_set_transfer_data_size(&dc, DMA_SIZE_32);
+    channel_config_set_read_increment(&dc, true);
+    channel_config_set_write_increment(&dc, false);
+    channel_config_set_dreq(&dc, pio_get_dreq(pio, sm, true));
+    channel_config_set_chain_to(&dc, ctrl);
+    channel_config_set_irq_quiet(&dc, true);
+    dma_channel_configure(data, &dc, &pio->txf[sm], s->active, SG_NUM_EVENTS, false);
+
+    // Seperti signal_spi, DREQ TX menahan pembacaan pointer sampai PIO
+    // menarik delay event A periode berjalan
+    dma_channel_config cc = dma_channel_get_default_config(ctrl);
+    channel_config_set_transfer_data_size(&cc, DMA_SIZE_32);
+    channel_config_set_read_increment(&cc, false);
+    channel_config_set_write_increment(&cc, false);
+    channel_config_set_dreq(&cc, pio_get_dreq(pio, sm, true));
+    channel_config_set_irq_quiet(&cc, true);
+    volatile void *next = cycles == 1 ? (volatile void *)&s->ctrl_sink
+                                      : (volatile void *)&dma_channel_hw_addr(data)->al3_read_addr_trig;
+    dma_channel_configure(ctrl, &cc, next, &s->active, 1, false);
+
+    if (cycles > 1)
+    {
+        // Token periode ke-(n - 1) didorong di event D, sebelum pointer periode n + 1 dibaca
+        sg_count_set_compare(s->counter, cycles - 1, (uint)s->dma_stop, &dma_channel_hw_addr(ctrl)->write_addr,
+                             &s->ctrl_sink_addr);
+    }
+    s->feeding = true;
+    dma_channel_start(prefilled ? ctrl : data);
+}
+
+/**
+ * @brief Menghentikan generator dan semua channel DMA pemberi data.
+ */
+static void stop_feed(sg_scpi_instance *s)
+{
+    sg_stop(s->gen);
+    if (!s->feeding)
+    {
+        return;
+    }
+    // Penghitung melepas channel stop dulu; chain data diputus agar abort
+    // channel kontrol tidak memicu pasangannya
+    sg_count_clear_compare(s->counter);
+    uint data = (uint)s->dma_data;
+    dma_channel_config c = dma_get_channel_config(data);
+    channel_config_set_chain_to(&c, data);
+    dma_channel_set_config(data, &c, false);
+    dma_channel_abort((uint)s->dma_ctrl);
+    dma_channel_abort(data);
+    dma_channel_abort((uint)s->dma_stop);
+    pio_sm_clear_fifos(s->gen->pio, s->gen->sm);
+    s->feeding = false;
+}
+
+/**
+ * @brief Memulai burst IMM/BUS: channel data mengisi periode pertama dari
+ *        set aktif sebelum state machine diaktifkan.
+ */
+static void start_burst(sg_scpi_instance *s)
+{
+    sg_instance *gen = s->gen;
+    PIO pio = gen->pio;
+    uint sm = gen->sm;
+    pio_sm_clear_fifos(pio, sm);
+    pio_sm_restart(pio, sm);
+    pio_sm_exec(pio, sm, pio_encode_jmp(gen->offset));
+    pio->fdebug = txstall_mask(gen);
+    start_feed(s, false);
+    gen->next_event = 0;
+    gen->state = SG_STATE_RUNNING;
+    pio_sm_set_enabled(pio, sm, true);
+}
+
+/**
+ * @brief Meng-arm burst EXT. sg_arm() mengisi pre-event dan periode pertama
+ *        dari konfigurasi yang sama dengan set aktif; DMA mulai dari periode
+ *        kedua.
+ */
+static void arm_burst(sg_scpi_instance *s)
+{
+    sg_instance *gen = s->gen;
+    if (sg_arm(gen, s->trigger_pin, s->trigger_active_high))
+    {
+        gen->pio->fdebug = txstall_mask(gen);
+        start_feed(s, true);
+    }
+}
+
+static void output_off(sg_scpi_instance *s)
+{
+    stop_feed(s);
+    s->output = false;
+}
+
+static void output_on(sg_scpi_instance *s)
+{
+    if (s->output)
+    {
+        return;
+    }
+    // EXT di-arm oleh poll, BUS menunggu *TRG
+    s->output = true;
+    if (s->trigger_source == SG_SCPI_TRIG_IMMEDIATE)
+    {
+        start_burst(s);
+    }
+}
+
+/**
+ * @brief Menutup burst BURS:NCYC yang sudah berhenti sendiri dan meng-arm
+ *        ulang trigger eksternal. Dipanggil di awal setiap sg_scpi_poll();
+ *        periode tidak bergantung pada seberapa sering.
+ */
+static void service_generator(sg_scpi_instance *s)
+{
+    sg_instance *gen = s->gen;
+
+    // Burst selesai: kedua channel pemberi data diam dan state machine stall
+    // di pull event A dengan FIFO kosong. Tanpa BURS:NCYC channel kontrol
+    // atau data selalu sibuk, dan sg_arm() tidak stall pada FIFO TX.
+    if (s->feeding && !dma_channel_is_busy((uint)s->dma_ctrl) && !dma_channel_is_busy((uint)s->dma_data) &&
+        (gen->pio->fdebug & txstall_mask(gen)))
+    {
+        stop_feed(s);
+        if (s->trigger_source == SG_SCPI_TRIG_IMMEDIATE)
+        {
+            s->output = false;
+        }
+    }
+
+    // Arm gagal selama pin trigger masih aktif; dicoba lagi di poll berikutnya
+    if (s->output && s->trigger_source == SG_SCPI_TRIG_EXTERNAL && gen->state == SG_STATE_IDLE)
+    {
+        arm_burst(s);
+    }
+}
+
+/**
+ * @brief Menghitung konfigurasi dengan sg_stage() lalu menerbitkannya
+ *        sebagai set delay baru untuk channel kontrol.
+ *
+ * Set generator yang di-stage tetap dipakai sg_arm() untuk periode pertama
+ * burst EXT.
+ */
+static int stage_timing(sg_scpi_instance *s, const sg_timing_config *timing)
+{
+    sg_instance *gen = s->gen;
+    uint32_t delays[SG_NUM_EVENTS];
+    if (!sg_calculate_delays((float)gen->sys_clk_hz, timing, delays) ||
+        !ncycle_stop_fits(timing, s->burst_cycles, delays[SG_NUM_EVENTS - 1]) || !sg_stage(gen, timing))
+    {
+        return SG_SCPI_ERR_OUT_OF_RANGE;
+    }
+    uint32_t *set = s->sets[free_set(s)];
+    for (uint i = 0; i < SG_NUM_EVENTS; ++i)
+    {
+        set[i] = gen->staged_delays[i];
+    }
+    // Isi set terlihat sebelum pointer baru
+    __dmb();
+    s->active = set;
+    s->timing = *timing;
+    return SG_SCPI_ERR_NONE;
+}
+
+// -- Perintah --
+
+static int cmd_idn(sg_scpi_instance *s, bool query, const char *param, const char *end)
+{
+    (void)query, (void)param, (void)end;
+    respond(s, "%s", SG_SCPI_IDN);
+    return SG_SCPI_ERR_NONE;
+}
+
+static int cmd_rst(sg_scpi_instance *s, bool query, const char *param, const char *end)
+{
+    (void)query, (void)param, (void)end;
+    output_off(s);
+    s->burst_cycles = 0;
+    s->trigger_source = SG_SCPI_TRIG_IMMEDIATE;
+    return stage_timing(s, &s->reset_timing);
+}
+
+static int cmd_cls(sg_scpi_instance *s, bool query, const char *param, const char *end)
+{
+    (void)query, (void)param, (void)end;
+    s->error_first = 0;
+    s->error_count = 0;
+    return SG_SCPI_ERR_NONE;
+}
+
+static int cmd_opc(sg_scpi_instance *s, bool query, const char *param, const char *end)
+{
+    (void)query, (void)param, (void)end;
+    // Perintah dieksekusi berurutan, jadi semuanya sudah selesai di sini
+    respond(s, "1");
+    return SG_SCPI_ERR_NONE;
+}
+
+static int cmd_trg(sg_scpi_instance *s, bool query, const char *param, const char *end)
+{
+    (void)query, (void)param, (void)end;
+    if (!s->output || s->trigger_source != SG_SCPI_TRIG_BUS || s->gen->state != SG_STATE_IDLE)
+    {
+        return SG_SCPI_ERR_TRIGGER_IGNORED;
+    }
+    start_burst(s);
+    return SG_SCPI_ERR_NONE;
+}
+
+static int cmd_frequency(sg_scpi_instance *s, bool query, const char *param, const char *end)
+{
+    if (query)
+    {
+        respond(s, "%.7g", (double)s->timing.frequency_hz);
+        return SG_SCPI_ERR_NONE;
+    }
+    double hz;
+    int err = parse_quantity(param, end, frequency_units, &hz);
+    if (err != SG_SCPI_ERR_NONE)
+    {
+        return err;
+    }
+    if (!(hz > 0.0) || hz > 1e9)
+    {
+        return SG_SCPI_ERR_OUT_OF_RANGE;
+    }
+    sg_timing_config timing = s->timing;
+    timing.frequency_hz = (float)hz;
+    return stage_timing(s, &timing);
+}
+
+/**
+ * @brief Parameter waktu PULS:WIDT dan PHAS: detik di SCPI, us di timing.
+ */
+static int parse_time_us(const char *param, const char *end, float *us)
+{
+    double seconds;
+    int err = parse_quantity(param, end, time_units, &seconds);
+    if (err != SG_SCPI_ERR_NONE)
+    {
+        return err;
+    }
+    if (seconds < 0.0 || seconds > 1e3)
+    {
+        return SG_SCPI_ERR_OUT_OF_RANGE;
+    }
+    *us = (float)(seconds * 1e6);
+    return SG_SCPI_ERR_NONE;
+}
+
+static int cmd_pulse_width(sg_scpi_instance *s, bool query, const char *param, const char *end)
+{
+    if (query)
+    {
+        respond(s, "%.7g", (double)s->timing.pulse_width_us * 1e-6);
+        return SG_SCPI_ERR_NONE;
+    }
+    sg_timing_config timing = s->timing;
+    int err = parse_time_us(param, end, &timing.pulse_width_us);
+    return err != SG_SCPI_ERR_NONE ? err : stage_timing(s, &timing);
+}
+
+static int cmd_phase(sg_scpi_instance *s, bool query, const char *param, const char *end)
+{
+    if (query)
+    {
+        respond(s, "%.7g", (double)s->timing.phase_shift_us * 1e-6);
+        return SG_SCPI_ERR_NONE;
+    }
+    sg_timing_config timing = s->timing;
+    int err = parse_time_us(param, end, &timing.phase_shift_us);
+    return err != SG_SCPI_ERR_NONE ? err : stage_timing(s, &timing);
+}
+
+static int cmd_burst_cycles(sg_scpi_instance *s, bool query, const char *param, const char *end)
+{
+    if (query)
+    {
+        if (s->burst_cycles == 0)
+        {
+            respond(s, SCPI_INFINITY);
+        }
+        else
+        {
+            respond(s, "%lu", (unsigned long)s->burst_cycles);
+        }
+        return SG_SCPI_ERR_NONE;
+    }
+    if (word_equal(param, end, "INFinity"))
+    {
+        s->burst_cycles = 0;
+        return SG_SCPI_ERR_NONE;
+    }
+    double cycles;
+    const char *p = param;
+    if (!parse_number(&p, end, &cycles) || p != end)
+    {
+        return SG_SCPI_ERR_DATA_TYPE;
+    }
+    if (cycles < 1.0 || cycles > 1e9 || cycles != (double)(uint32_t)cycles)
+    {
+        return SG_SCPI_ERR_OUT_OF_RANGE;
+    }
+    if (!ncycle_stop_fits(&s->timing, (uint32_t)cycles, s->active[SG_NUM_EVENTS - 1]))
+    {
+        return SG_SCPI_ERR_SETTINGS_CONFLICT;
+    }
+    // Berlaku mulai burst berikutnya
+    s->burst_cycles = (uint32_t)cycles;
+    return SG_SCPI_ERR_NONE;
+}
+
+static int cmd_trigger_source(sg_scpi_instance *s, bool query, const char *param, const char *end)
+{
+    static const char *const names[] = {"IMM", "EXT", "BUS"};
+    if (query)
+    {
+        respond(s, "%s", names[s->trigger_source]);
+        return SG_SCPI_ERR_NONE;
+    }
+    sg_scpi_trigger_source source;
+    if (word_equal(param, end, "IMMediate"))
+    {
+        source = SG_SCPI_TRIG_IMMEDIATE;
+    }
+    else if (word_equal(param, end, "EXTernal"))
+    {
+        source = SG_SCPI_TRIG_EXTERNAL;
+    }
+    else if (word_equal(param, end, "BUS"))
+    {
+        source = SG_SCPI_TRIG_BUS;
+    }
+    else
+    {
+        return SG_SCPI_ERR_DATA_TYPE;
+    }
+    if (s->output && source != s->trigger_source)
+    {
+        return SG_SCPI_ERR_SETTINGS_CONFLICT;
+    }
+    s->trigger_source = source;
+    return SG_SCPI_ERR_NONE;
+}
+
+static int cmd_output(sg_scpi_instance *s, bool query, const char *param, const char *end)
+{
+    if (query)
+    {
+        respond(s, "%d", s->output ? 1 : 0);
+        return SG_SCPI_ERR_NONE;
+    }
+    bool on;
+    int err = parse_boolean(param, end, &on);
+    if (err != SG_SCPI_ERR_NONE)
+    {
+        return err;
+    }
+    if (on)
+    {
+        output_on(s);
+    }
+    else
+    {
+        output_off(s);
+    }
+    return SG_SCPI_ERR_NONE;
+}
+
+static int cmd_system_error(sg_scpi_instance *s, bool query, const char *param, const char *end)
+{
+    (void)query, (void)param, (void)end;
+    int code = pop_error(s);
+    respond(s, "%d,\"%s\"", code, sg_scpi_error_message(code));
+    return SG_SCPI_ERR_NONE;
+}
+
+static int cmd_system_version(sg_scpi_instance *s, bool query, const char *param, const char *end)
+{
+    (void)query, (void)param, (void)end;
+    respond(s, "1999.0");
+    return SG_SCPI_ERR_NONE;
+}
+
+// -- Perintah Preset --
+
+/**
+ * @brief Perintah yang menulis flash butuh region preset dan generator berhenti.
+ */
+static int presets_writable(const sg_scpi_instance *s)
+{
+    if (!s->presets)
+    {
+        return SG_SCPI_ERR_HARDWARE_MISSING;
+    }
+    // Erase/program memblok CPU puluhan milidetik: trigger EXT tidak di-arm
+    // ulang dan OUTP OFF tidak dilayani selama itu
+    if (s->gen->state != SG_STATE_IDLE)
+    {
+        return SG_SCPI_ERR_SETTINGS_CONFLICT;
+    }
+    return SG_SCPI_ERR_NONE;
+}
+
+/**
+ * @brief Memanggil preset: output berhenti, konfigurasi diganti, lalu output
+ *        dinyalakan lagi jika diminta.
+ */
+static int recall(sg_scpi_instance *s, uint slot, bool output)
+{
+    sg_preset preset;
+    if (!s->presets)
+    {
+        return SG_SCPI_ERR_HARDWARE_MISSING;
+    }
+    if (!sg_preset_load(s->presets, slot, &preset))
+    {
+        return SG_SCPI_ERR_ILLEGAL_VALUE;
+    }
+    // Pembagi clock PIO dan delay trigger milik build, tidak diatur lewat SCPI
+    preset.timing.pio_clk_div = s->timing.pio_clk_div;
+    preset.timing.trigger_delay_ns = s->timing.trigger_delay_ns;
+    output_off(s);
+    int err = stage_timing(s, &preset.timing);
+    if (err != SG_SCPI_ERR_NONE)
+    {
+        return err;
+    }
+    s->burst_cycles = preset.burst_cycles;
+    s->trigger_source = preset.trigger_source <= SG_SCPI_TRIG_BUS ? (sg_scpi_trigger_source)preset.trigger_source
+                                                                  : SG_SCPI_TRIG_IMMEDIATE;
+    if (output)
+    {
+        output_on(s);
+    }
+    return SG_SCPI_ERR_NONE;
+}
+
+static int cmd_sav(sg_scpi_instance *s, bool query, const char *param, const char *end)
+{
+    (void)query;
+    uint slot;
+    int err = presets_writable(s);
+    if (err == SG_SCPI_ERR_NONE)
+    {
+        err = parse_slot(param, end, &slot);
+    }
+    if (err != SG_SCPI_ERR_NONE)
+    {
+        return err;
+    }
+    // Nama slot yang sudah ada dipertahankan
+    sg_preset preset;
+    if (!sg_preset_load(s->presets, slot, &preset))
+    {
+        memset(&preset, 0, sizeof(preset));
+    }
+    preset.timing = s->timing;
+    preset.burst_cycles = s->burst_cycles;
+    preset.trigger_source = (uint8_t)s->trigger_source;
+    return sg_preset_save(s->presets, slot, &preset) ? SG_SCPI_ERR_NONE : SG_SCPI_ERR_MASS_STORAGE;
+}
+
+static int cmd_rcl(sg_scpi_instance *s, bool query, const char *param, const char *end)
+{
+    (void)query;
+    uint slot;
+    int err = parse_slot(param, end, &slot);
+    return err != SG_SCPI_ERR_NONE ? err : recall(s, slot, s->output);
+}
+
+static int cmd_memory_name(sg_scpi_instance *s, bool query, const char *param, const char *end)
+{
+    if (!s->presets)
+    {
+        return SG_SCPI_ERR_HARDWARE_MISSING;
+    }
+    const char *comma = memchr(param, ',', (size_t)(end - param));
+    const char *slot_end = comma ? comma : end;
+    while (slot_end > param && is_space(slot_end[-1]))
+    {
+        slot_end--;
+    }
+    uint slot;
+    int err = parse_slot(param, slot_end, &slot);
+    if (err != SG_SCPI_ERR_NONE)
+    {
+        return err;
+    }
+    sg_preset preset;
+    if (query)
+    {
+        if (comma)
+        {
+            return SG_SCPI_ERR_PARAM_NOT_ALLOWED;
+        }
+        respond(s, "\"%s\"", sg_preset_load(s->presets, slot, &preset) ? preset.name : "");
+        return SG_SCPI_ERR_NONE;
+    }
+    if (!comma)
+    {
+        return SG_SCPI_ERR_MISSING_PARAM;
+    }
+
+    // Nama boleh dikutip '...' atau "..."
+    const char *name = comma + 1;
+    while (name < end && is_space(*name))
+    {
+        name++;
+    }
+    const char *name_end = end;
+    if (name_end - name >= 2 && (*name == '"' || *name == '\'') && name_end[-1] == *name)
+    {
+        name++;
+        name_end--;
+    }
+    size_t len = (size_t)(name_end - name);
+    if (len > SG_PRESET_NAME_MAX || memchr(name, '"', len) || memchr(name, '\'', len))
+    {
+        return SG_SCPI_ERR_ILLEGAL_VALUE;
+    }
+    err = presets_writable(s);
+    if (err != SG_SCPI_ERR_NONE)
+    {
+        return err;
+    }
+    if (!sg_preset_load(s->presets, slot, &preset))
+    {
+        return SG_SCPI_ERR_ILLEGAL_VALUE;
+    }
+    memset(preset.name, 0, sizeof(preset.name));
+    memcpy(preset.name, name, len);
+    return sg_preset_save(s->presets, slot, &preset) ? SG_SCPI_ERR_NONE : SG_SCPI_ERR_MASS_STORAGE;
+}
+
+static int cmd_memory_delete(sg_scpi_instance *s, bool query, const char *param, const char *end)
+{
+    (void)query;
+    uint slot;
+    int err = presets_writable(s);
+    if (err == SG_SCPI_ERR_NONE)
+    {
+        err = parse_slot(param, end, &slot);
+    }
+    if (err != SG_SCPI_ERR_NONE)
+    {
+        return err;
+    }
+    return sg_preset_delete(s->presets, slot) ? SG_SCPI_ERR_NONE : SG_SCPI_ERR_MASS_STORAGE;
+}
+
+static int cmd_memory_valid(sg_scpi_instance *s, bool query, const char *param, const char *end)
+{
+    (void)query;
+    uint slot;
+    int err = parse_slot(param, end, &slot);
+    if (err != SG_SCPI_ERR_NONE)
+    {
+        return err;
+    }
+    sg_preset preset;
+    respond(s, "%d", s->presets && sg_preset_load(s->presets, slot, &preset) ? 1 : 0);
+    return SG_SCPI_ERR_NONE;
+}
+
+static int cmd_memory_recall_auto(sg_scpi_instance *s, bool query, const char *param, const char *end)
+{
+    if (!s->presets)
+    {
+        return SG_SCPI_ERR_HARDWARE_MISSING;
+    }
+    uint current = sg_preset_power_on(s->presets);
+    if (query)
+    {
+        if (current == SG_PRESET_NONE)
+        {
+            respond(s, "OFF");
+        }
+        else
+        {
+            respond(s, "%u", current);
+        }
+        return SG_SCPI_ERR_NONE;
+    }
+    uint slot = SG_PRESET_NONE;
+    int err = SG_SCPI_ERR_NONE;
+    if (!word_equal(param, end, "OFF"))
+    {
+        err = parse_slot(param, end, &slot);
+    }
+    if (err == SG_SCPI_ERR_NONE)
+    {
+        err = presets_writable(s);
+    }
+    if (err != SG_SCPI_ERR_NONE)
+    {
+        return err;
+    }
+    sg_preset preset;
+    if (slot != SG_PRESET_NONE && !sg_preset_load(s->presets, slot, &preset))
+    {
+        return SG_SCPI_ERR_ILLEGAL_VALUE;
+    }
+    return sg_preset_set_power_on(s->presets, slot, s->presets->power_on_output) ? SG_SCPI_ERR_NONE
+                                                                                : SG_SCPI_ERR_MASS_STORAGE;
+}
+
+static int cmd_memory_recall_output(sg_scpi_instance *s, bool query, const char *param, const char *end)
+{
+    if (!s->presets)
+    {
+        return SG_SCPI_ERR_HARDWARE_MISSING;
+    }
+    if (query)
+    {
+        respond(s, "%d", s->presets->power_on_output ? 1 : 0);
+        return SG_SCPI_ERR_NONE;
+    }
+    bool on;
+    int err = parse_boolean(param, end, &on);
+    if (err == SG_SCPI_ERR_NONE)
+    {
+        err = presets_writable(s);
+    }
+    if (err != SG_SCPI_ERR_NONE)
+    {
+        return err;
+    }
+    uint slot = sg_preset_power_on(s->presets);
+    if (slot == SG_PRESET_NONE && on)
+    {
+        return SG_SCPI_ERR_SETTINGS_CONFLICT;
+    }
+    return sg_preset_set_power_on(s->presets, slot, on) ? SG_SCPI_ERR_NONE : SG_SCPI_ERR_MASS_STORAGE;
+}
+
+static const command commands[] = {
+    {":*IDN", cmd_idn, CMD_QUERY},
+    {":*RST", cmd_rst, CMD_SET},
+    {":*CLS", cmd_cls, CMD_SET},
+    {":*OPC", cmd_opc, CMD_QUERY},
+    {":*TRG", cmd_trg, CMD_SET},
+    {"[:SOURce]:FREQuency[:CW]", cmd_frequency, CMD_SET | CMD_QUERY | CMD_PARAM},
+    {"[:SOURce]:PULSe:WIDTh", cmd_pulse_width, CMD_SET | CMD_QUERY | CMD_PARAM},
+    {"[:SOURce]:PHASe", cmd_phase, CMD_SET | CMD_QUERY | CMD_PARAM},
+    {"[:SOURce]:BURSt:NCYCles", cmd_burst_cycles, CMD_SET | CMD_QUERY | CMD_PARAM},
+    {":TRIGger[:SEQuence]:SOURce", cmd_trigger_source, CMD_SET | CMD_QUERY | CMD_PARAM},
+    {":OUTPut[:STATe]", cmd_output, CMD_SET | CMD_QUERY | CMD_PARAM},
+    {":SYSTem:ERRor[:NEXT]", cmd_system_error, CMD_QUERY},
+    {":SYSTem:VERSion", cmd_system_version, CMD_QUERY},
+    {":*SAV", cmd_sav, CMD_SET | CMD_PARAM},
+    {":*RCL", cmd_rcl, CMD_SET | CMD_PARAM},
+    {":MEMory:STATe:NAME", cmd_memory_name, CMD_SET | CMD_QUERY | CMD_PARAM | CMD_QUERY_PARAM},
+    {":MEMory:STATe:DELete", cmd_memory_delete, CMD_SET | CMD_PARAM},
+    {":MEMory:STATe:VALid", cmd_memory_valid, CMD_QUERY | CMD_QUERY_PARAM},
+    {":MEMory:STATe:RECall:AUTO", cmd_memory_recall_auto, CMD_SET | CMD_QUERY | CMD_PARAM},
+    {":MEMory:STATe:RECall:OUTPut", cmd_memory_recall_output, CMD_SET | CMD_QUERY | CMD_PARAM},
+};
+
+// -- Eksekusi Baris --
+
+/**
+ * @brief Mengeksekusi satu perintah dari baris (di antara ';').
+ *
+ * @param path Path aktif (diawali dan diakhiri ':'), diperbarui untuk
+ *             perintah berikutnya di baris yang sama
+ * @return true jika ada perintah (bukan unit kosong)
+ */
+static bool execute_command(sg_scpi_instance *s, const char *p, const char *end, char *path, size_t *path_len)
+{
+    while (p < end && is_space(*p))
+    {
+        p++;
+    }
+    while (end > p && is_space(end[-1]))
+    {
+        end--;
+    }
+    if (p == end)
+    {
+        return false;
+    }
+    const char *header_end = p;
+    while (header_end < end && !is_space(*header_end))
+    {
+        header_end++;
+    }
+    const char *param = header_end;
+    while (param < end && is_space(*param))
+    {
+        param++;
+    }
+    bool query = header_end[-1] == '?';
+    size_t header_len = (size_t)(header_end - p) - (query ? 1 : 0);
+
+    // Header lengkap: perintah umum dan header absolut tidak memakai path
+    char header[HEADER_MAX];
+    size_t len = 0;
+    bool common = *p == '*';
+    if (common)
+    {
+        header[len++] = ':';
+    }
+    else if (*p != ':')
+    {
+        if (*path_len > HEADER_MAX)
+        {
+            push_error(s, SG_SCPI_ERR_UNDEFINED_HEADER);
+            return true;
+        }
+        memcpy(header, path, *path_len);
+        len = *path_len;
+    }
+    if (len + header_len > HEADER_MAX || header_len == 0)
+    {
+        push_error(s, header_len == 0 ? SG_SCPI_ERR_SYNTAX : SG_SCPI_ERR_UNDEFINED_HEADER);
+        return true;
+    }
+    memcpy(&header[len], p, header_len);
+    len += header_len;
+    if (!common)
+    {
+        size_t last = len;
+        while (header[last - 1] != ':')
+        {
+            last--;
+        }
+        memcpy(path, header, last);
+        *path_len = last;
+    }
+
+    const command *cmd = NULL;
+    for (size_t i = 0; i < count_of(commands) && !cmd; ++i)
+    {
+        if (match_nodes(commands[i].pattern, header, header + len))
+        {
+            cmd = &commands[i];
+        }
+    }
+    bool has_param = param < end;
+    int err;
+    if (!cmd || !(cmd->flags & (query ? CMD_QUERY : CMD_SET)))
+    {
+        err = SG_SCPI_ERR_UNDEFINED_HEADER;
+    }
+    else if (has_param && !(cmd->flags & (query ? CMD_QUERY_PARAM : CMD_PARAM)))
+    {
+        err = SG_SCPI_ERR_PARAM_NOT_ALLOWED;
+    }
+    else if (!has_param && (cmd->flags & (query ? CMD_QUERY_PARAM : CMD_PARAM)))
+    {
+        err = SG_SCPI_ERR_MISSING_PARAM;
+    }
+    else
+    {
+        err = cmd->fn(s, query, param, end);
+    }
+    if (err != SG_SCPI_ERR_NONE)
+    {
+        push_error(s, err);
+    }
+    return true;
+}
+
+/**
+ * @brief Mengeksekusi baris yang terkumpul dan mengirim jawabannya.
+ *
+ * @return Jumlah perintah di baris
+ */
+static uint execute_line(sg_scpi_instance *s)
+{
+    uint executed = 0;
+    s->response_len = 0;
+    if (s->overrun || s->line_overrun)
+    {
+        // Sebagian baris hilang: dibuang utuh daripada dieksekusi terpotong
+        s->overrun = false;
+        s->line_overrun = false;
+        push_error(s, SG_SCPI_ERR_INPUT_OVERRUN);
+    }
+    else
+    {
+        char path[HEADER_MAX] = ":";
+        size_t path_len = 1;
+        const char *p = s->line;
+        const char *end = s->line + s->line_len;
+        while (p < end)
+        {
+            const char *unit_end = memchr(p, ';', (size_t)(end - p));
+            if (!unit_end)
+            {
+                unit_end = end;
+            }
+            if (execute_command(s, p, unit_end, path, &path_len))
+            {
+                executed++;
+            }
+            p = unit_end + 1;
+        }
+    }
+    s->line_len = 0;
+    if (s->response_len > 0)
+    {
+        s->response[s->response_len++] = '\n';
+        s->write(s->write_ctx, s->response, s->response_len);
+    }
+    s->commands += executed;
+    return executed;
+}
+
+// -- API --
+
+/**
+ * @brief Menyiapkan parser untuk generator yang sudah dikonfigurasi.
+ *
+ * Konfigurasi generator saat ini menjadi nilai awal dan nilai *RST.
+ * Selanjutnya hanya sg_scpi_poll() yang boleh memulai atau menghentikan
+ * generator; FIFO-nya diisi channel DMA milik parser.
+ *
+ * @param s Instance parser
+ * @param gen Generator yang dikontrol, terkonfigurasi dan berhenti
+ * @param counter Penghitung periode gen yang berjalan; menghitung BURS:NCYC
+ *        (sg_count_set_compare()) dan harus tetap berjalan
+ * @param trigger_pin Pin trigger untuk TRIG:SOUR EXT (lihat sg_arm())
+ * @param trigger_active_high Polaritas trigger
+ * @param write Fungsi pengirim jawaban
+ * @param write_ctx Argumen pertama untuk write
+ * @return false jika generator belum dikonfigurasi atau tidak berhenti,
+ *         penghitung tidak berjalan, atau tiga channel DMA tidak tersedia
+ */
+bool sg_scpi_init(sg_scpi_instance *s, sg_instance *gen, sg_count_instance *counter, uint trigger_pin,
+                  bool trigger_active_high, sg_scpi_write_fn write, void *write_ctx)
+{
+    if (gen->state != SG_STATE_IDLE || !sg_count_is_running(counter))
+    {
+        return false;
+    }
+    memset(s, 0, sizeof(*s));
+    s->dma_ctrl = dma_claim_unused_channel(false);
+    s->dma_data = dma_claim_unused_channel(false);
+    s->dma_stop = dma_claim_unused_channel(false);
+    if (s->dma_ctrl < 0 || s->dma_data < 0 || s->dma_stop < 0)
+    {
+        release_channels(s);
+        return false;
+    }
+    for (uint i = 0; i < SG_NUM_EVENTS; ++i)
+    {
+        s->sets[0][i] = gen->delays[i];
+    }
+    s->active = s->sets[0];
+    s->ctrl_sink_addr = &s->ctrl_sink;
+    s->gen = gen;
+    s->counter = counter;
+    s->trigger_pin = trigger_pin;
+    s->trigger_active_high = trigger_active_high;
+    s->write = write;
+    s->write_ctx = write_ctx;
+    s->timing = gen->timing;
+    s->reset_timing = gen->timing;
+    s->trigger_source = SG_SCPI_TRIG_IMMEDIATE;
+    return true;
+}
+
+/**
+ * @brief Menghubungkan region preset flash (*SAV, *RCL, MEM:STAT).
+ *
+ * Tanpa region preset, perintah preset dijawab Hardware missing (-241).
+ *
+ * @param s Instance parser
+ * @param presets Indeks preset yang sudah di-sg_preset_init()
+ */
+void sg_scpi_attach_presets(sg_scpi_instance *s, sg_preset_store *presets)
+{
+    s->presets = presets;
+}
+
+/**
+ * @brief Memanggil preset seperti *RCL, misalnya preset power-on saat boot.
+ *
+ * @param s Instance parser dengan region preset
+ * @param slot Nomor slot
+ * @param output true untuk menjalankan output setelah konfigurasi diganti
+ * @return false jika slot kosong atau preset tidak valid
+ */
+bool sg_scpi_recall(sg_scpi_instance *s, uint slot, bool output)
+{
+    return slot < SG_PRESET_COUNT && recall(s, slot, output) == SG_SCPI_ERR_NONE;
+}
+
+/**
+ * @brief Memasukkan byte dari host ke ring buffer.
+ *
+ * Aman dipanggil dari interrupt atau callback stdio selama hanya ada satu
+ * pemanggil. Byte yang tidak muat dibuang dan baris yang terkena dilaporkan
+ * sebagai Input buffer overrun (-363).
+ *
+ * @return Jumlah byte yang masuk
+ */
+size_t sg_scpi_receive(sg_scpi_instance *s, const uint8_t *data, size_t len)
+{
+    uint32_t head = s->head;
+    uint32_t tail = s->tail;
+    size_t n = 0;
+    while (n < len && head - tail < SG_SCPI_RING_SIZE)
+    {
+        s->ring[head & RING_MASK] = data[n++];
+        head++;
+    }
+    // Isi ring terlihat sebelum head baru
+    __dmb();
+    s->head = head;
+    if (n < len)
+    {
+        s->overrun = true;
+    }
+    return n;
+}
+
+/**
+ * @brief Menutup burst yang selesai lalu mengurai input yang tersedia.
+ *
+ * Panggil dari loop utama; generator diberi data DMA, jadi jawaban yang
+ * lambat (fungsi write memblok) tidak memengaruhi output. Paling banyak
+ * SG_SCPI_POLL_BUDGET byte diambil dan paling banyak satu baris dieksekusi
+ * per panggilan. Non-blocking.
+ *
+ * @param s Instance parser
+ * @return Jumlah perintah yang dieksekusi
+ */
+uint __time_critical_func(sg_scpi_poll)(sg_scpi_instance *s)
+{
+    service_generator(s);
+
+    uint32_t head = s->head;
+    __dmb();
+    for (uint budget = SG_SCPI_POLL_BUDGET; budget > 0 && s->tail != head; --budget)
+    {
+        char c = (char)s->ring[s->tail & RING_MASK];
+        s->tail++;
+        if (c == '\n')
+        {
+            return execute_line(s);
+        }
+        if (c == '\r')
+        {
+            continue;
+        }
+        if (s->line_len < SG_SCPI_LINE_MAX)
+        {
+            s->line[s->line_len++] = c;
+        }
+        else
+        {
+            s->line_overrun = true;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Teks standar SCPI untuk kode error.
+ */
+const char *sg_scpi_error_message(int code)
+{
+    switch (code)
+    {
+    case SG_SCPI_ERR_NONE:
+        return "No error";
+    case SG_SCPI_ERR_SYNTAX:
+        return "Syntax error";
+    case SG_SCPI_ERR_DATA_TYPE:
+        return "Data type error";
+    case SG_SCPI_ERR_PARAM_NOT_ALLOWED:
+        return "Parameter not allowed";
+    case SG_SCPI_ERR_MISSING_PARAM:
+        return "Missing parameter";
+    case SG_SCPI_ERR_UNDEFINED_HEADER:
+        return "Undefined header";
+    case SG_SCPI_ERR_INVALID_SUFFIX:
+        return "Invalid suffix";
+    case SG_SCPI_ERR_TRIGGER_IGNORED:
+        return "Trigger ignored";
+    case SG_SCPI_ERR_SETTINGS_CONFLICT:
+        return "Settings conflict";
+    case SG_SCPI_ERR_OUT_OF_RANGE:
+        return "Data out of range";
+    case SG_SCPI_ERR_ILLEGAL_VALUE:
+        return "Illegal parameter value";
+    case SG_SCPI_ERR_HARDWARE_MISSING:
+        return "Hardware missing";
+    case SG_SCPI_ERR_MASS_STORAGE:
+        return "Mass storage error";
+    case SG_SCPI_ERR_QUEUE_OVERFLOW:
+        return "Queue overflow";
+    case SG_SCPI_ERR_INPUT_OVERRUN:
+        return "Input buffer overrun";
+    default:
+        return "Unknown error";
+    }
+}
@@ -0,0 +1,172 @@
+/**
+ * Parser perintah SCPI untuk otomasi instrumen lewat konsol USB CDC.
+ *
+ * Perintah (bentuk pendek huruf besar, node [..] opsional, `?` = query):
+ *
+ *   *IDN?  *RST  *CLS  *OPC?  *TRG
+ *   [SOURce:]FREQuency[:CW] <Hz>          satuan HZ, KHZ, MHZ
+ *   [SOURce:]PULSe:WIDTh <s>              satuan S, MS, US, NS
+ *   [SOURce:]PHASe <s>                    jeda antar pasangan kanal (waktu,
+ *                                         bukan derajat), satuan seperti WIDTh
+ *   [SOURce:]BURSt:NCYCles <n>|INFinity   periode per burst, INF = kontinu
+ *   TRIGger[:SEQuence]:SOURce IMMediate|EXTernal|BUS
+ *   OUTPut[:STATe] ON|OFF|1|0
+ *   SYSTem:ERRor[:NEXT]?  SYSTem:VERSion?
+ *
+ * Preset di flash (signal_preset.h, setelah sg_scpi_attach_presets()):
+ *
+ *   *SAV <n>  *RCL <n>                    simpan/panggil FREQ, PULS:WIDT,
+ *                                         PHAS, BURS:NCYC dan TRIG:SOUR
+ *   MEMory:STATe:NAME <n>,"<nama>"        query: MEM:STAT:NAME? <n>
+ *   MEMory:STATe:DELete <n>
+ *   MEMory:STATe:VALid? <n>
+ *   MEMory:STATe:RECall:AUTO <n>|OFF      preset yang dipanggil saat boot
+ *   MEMory:STATe:RECall:OUTPut ON|OFF     output langsung aktif setelahnya
+ *
+ * Penulisan flash memblok sampai puluhan milidetik, jadi perintah yang
+ * menulis preset ditolak (Settings conflict) selama generator berjalan atau
+ * di-arm. Nama preset tidak boleh berisi `;`.
+ *
+ * Semua perintah punya bentuk query kecuali *RST, *CLS, *TRG, *SAV, *RCL dan
+ * MEM:STAT:DEL; MEM:STAT:VAL hanya query. Beberapa
+ * perintah dalam satu baris dipisah `;` dengan aturan path SCPI (perintah
+ * tanpa `:` di depan relatif terhadap node induk perintah sebelumnya);
+ * jawaban query satu baris digabung dengan `;` dan diakhiri newline.
+ *
+ * FREQ, PULS:WIDT dan PHAS menggantikan FREQUENCY_HZ, PULSE_WIDTH_US dan
+ * PHASE_SHIFT_US: dihitung dengan sg_stage() lalu diterbitkan sebagai set
+ * delay baru, sehingga berlaku utuh di batas periode, berjalan atau tidak.
+ * Trim sg_trim_clock() ikut dihitung, dither event D tidak.
+ *
+ * Generator diberi data DMA seperti signal_spi: channel kontrol membaca
+ * pointer set aktif sekali per periode ke READ_ADDR_TRIG channel data, yang
+ * memindahkan keempat delay ke FIFO TX. Parsing, snprintf dan fungsi write
+ * (misalnya fwrite/fflush ke USB CDC yang bisa memblok) tidak pernah berada
+ * di jalur itu, jadi jawaban yang lambat tidak meregangkan periode.
+ *
+ * BURS:NCYC menggantikan SIGNAL_DURATION_US dan dihitung hardware oleh
+ * penghitung periode signal_count, satu-satunya pembaca FIFO RX generator:
+ * sg_count_set_compare() membuat channel stop milik parser mengalihkan
+ * tulisan channel kontrol ke memori kosong tepat setelah token ke-(n - 1)
+ * (push di event D), dan penghitung tetap menghitung setiap periode burst.
+ * Pointer periode n + 1 tidak pernah sampai ke channel data,
+ * sehingga state machine stall di pull event A tepat setelah periode ke-n
+ * dengan output LOW. Rantai itu harus selesai sebelum event D berakhir, jadi
+ * event D burst minimal SG_SCPI_NCYCLE_STOP_CYCLES siklus clk_sys. OUTP ON
+ * dengan TRIG:SOUR IMM langsung memulai burst, EXT meng-arm pin trigger
+ * (sg_arm()) dan meng-arm ulang setelah setiap burst, BUS menunggu *TRG.
+ * Burst IMM yang selesai mengembalikan OUTP ke 0.
+ *
+ * Tanpa alokasi: byte masuk ke ring buffer di instance (sg_scpi_receive(),
+ * boleh dari callback stdio/interrupt, satu produsen), sg_scpi_poll() di loop
+ * utama mengambil paling banyak SG_SCPI_POLL_BUDGET byte per panggilan dan
+ * mengeksekusi paling banyak satu baris. Angka diurai sendiri tanpa strtod
+ * (strtod newlib memakai malloc untuk mantissa panjang); jawaban diformat
+ * dengan snprintf ke buffer tetap (pico_printf tidak mengalokasi). Poll hanya
+ * mendeteksi akhir burst dan meng-arm ulang trigger EXT, tanpa batas waktu.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef SIGNAL_SCPI_H
+#define SIGNAL_SCPI_H
+
+#include "signal_gen.h"
+#include "signal_count.h"
+#include "signal_preset.h"
+
+#define SG_SCPI_IDN "PIO-SIGGEN,SG4CH,0,1.0"
+
+#define SG_SCPI_RING_SIZE 256    // Harus pangkat dua
+#define SG_SCPI_LINE_MAX 128     // Termasuk beberapa perintah yang dipisah ';'
+#define SG_SCPI_RESPONSE_MAX 128 // Jawaban satu baris
+#define SG_SCPI_ERROR_QUEUE 8
+#define SG_SCPI_POLL_BUDGET 64   // Byte maksimum per sg_scpi_poll()
+
+// Set delay: satu dibaca channel data, satu aktif, satu ditulis sg_stage()
+#define SG_SCPI_NUM_SETS 3
+
+// Token periode -> compare penghitung -> channel stop mengalihkan channel
+// kontrol (siklus clk_sys), harus muat di sisa event D setelah push
+#define SG_SCPI_NCYCLE_STOP_CYCLES 16
+
+// -- Kode Error SCPI (SYSTem:ERRor?) --
+#define SG_SCPI_ERR_NONE 0
+#define SG_SCPI_ERR_SYNTAX -102
+#define SG_SCPI_ERR_DATA_TYPE -104
+#define SG_SCPI_ERR_PARAM_NOT_ALLOWED -108
+#define SG_SCPI_ERR_MISSING_PARAM -109
+#define SG_SCPI_ERR_UNDEFINED_HEADER -113
+#define SG_SCPI_ERR_INVALID_SUFFIX -131
+#define SG_SCPI_ERR_TRIGGER_IGNORED -211
+#define SG_SCPI_ERR_SETTINGS_CONFLICT -221
+#define SG_SCPI_ERR_OUT_OF_RANGE -222
+#define SG_SCPI_ERR_ILLEGAL_VALUE -224
+#define SG_SCPI_ERR_HARDWARE_MISSING -241
+#define SG_SCPI_ERR_MASS_STORAGE -250
+#define SG_SCPI_ERR_QUEUE_OVERFLOW -350
+#define SG_SCPI_ERR_INPUT_OVERRUN -363
+
+/**
+ * @brief Sumber trigger burst (TRIGger:SOURce).
+ */
+typedef enum
+{
+    SG_SCPI_TRIG_IMMEDIATE = 0, // OUTP ON langsung memulai
+    SG_SCPI_TRIG_EXTERNAL,      // Edge pin trigger (sg_arm)
+    SG_SCPI_TRIG_BUS,           // *TRG
+} sg_scpi_trigger_source;
+
+// Menulis jawaban ke host (misalnya fwrite ke stdout USB CDC)
+typedef void (*sg_scpi_write_fn)(void *ctx, const char *data, size_t len);
+
+/**
+ * @brief Parser SCPI untuk satu generator klasik.
+ */
+typedef struct
+{
+    sg_instance *gen;                       // Generator yang dikontrol
+    sg_count_instance *counter;             // Penghitung periode gen, juga menghitung BURS:NCYC
+    uint trigger_pin;                       // Pin trigger TRIG:SOUR EXT
+    bool trigger_active_high;
+    sg_scpi_write_fn write;
+    void *write_ctx;
+    uint8_t ring[SG_SCPI_RING_SIZE];        // Byte dari host
+    volatile uint32_t head;                 // Ditulis sg_scpi_receive()
+    volatile uint32_t tail;                 // Ditulis sg_scpi_poll()
+    volatile bool overrun;                  // Ring penuh, byte dibuang
+    char line[SG_SCPI_LINE_MAX];            // Baris yang sedang dikumpulkan
+    uint line_len;
+    bool line_overrun;                      // Baris lebih panjang dari buffer
+    char response[SG_SCPI_RESPONSE_MAX];    // Jawaban baris yang sedang dieksekusi
+    uint response_len;
+    int16_t errors[SG_SCPI_ERROR_QUEUE];    // Antrean error FIFO
+    uint error_first;
+    uint error_count;
+    sg_timing_config timing;                // Konfigurasi terakhir yang diterima
+    sg_timing_config reset_timing;          // Konfigurasi untuk *RST
+    uint32_t burst_cycles;                  // 0 = kontinu (INFinity)
+    sg_scpi_trigger_source trigger_source;
+    bool output;                            // OUTPut:STATe
+    bool feeding;                           // Channel DMA generator berjalan
+    int dma_ctrl;                           // Pointer set aktif -> READ_ADDR_TRIG dma_data
+    int dma_data;                           // Set aktif -> FIFO TX generator
+    int dma_stop;                           // ctrl_sink_addr -> WRITE_ADDR dma_ctrl (compare counter)
+    uint32_t sets[SG_SCPI_NUM_SETS][SG_NUM_EVENTS];
+    const uint32_t *volatile active;        // Delay set yang dibaca channel kontrol
+    const uint32_t *volatile ctrl_sink;     // Tujuan channel kontrol setelah periode ke-n
+    volatile void *ctrl_sink_addr;          // &ctrl_sink, dibaca channel stop
+    sg_preset_store *presets;               // NULL = perintah MEMory tidak tersedia
+    uint32_t commands;                      // Perintah yang sudah dieksekusi
+} sg_scpi_instance;
+
+// -- API --
+bool sg_scpi_init(sg_scpi_instance *s, sg_instance *gen, sg_count_instance *counter, uint trigger_pin,
+                  bool trigger_active_high, sg_scpi_write_fn write, void *write_ctx);
+size_t sg_scpi_receive(sg_scpi_instance *s, const uint8_t *data, size_t len);
+uint sg_scpi_poll(sg_scpi_instance *s);
+void sg_scpi_attach_presets(sg_scpi_instance *s, sg_preset_store *presets);
+bool sg_scpi_recall(sg_scpi_instance *s, uint slot, bool output);
+const char *sg_scpi_error_message(int code);
+
+#endif
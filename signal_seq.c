@@ -0,0 +1,713 @@
+/**
+ * Implementasi sequencer generik dan compiler edge per kanal.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <string.h>
+
+#include "signal_seq.h"
+#include "hardware/clocks.h"
+#include "hardware/sync.h"
+#include "signal_sequencer.pio.h" // Header yang di-generate otomatis
+
+// Kapasitas edge mentah sebelum digabung (dua edge per pulsa)
+#define MAX_RAW_EDGES (2 * SG_SEQ_MAX_EVENTS)
+
+// -- Program PIO yang Dimuat per Blok PIO --
+static struct
+{
+    uint offset;
+    uint users;
+} loaded_program[NUM_PIOS];
+
+/**
+ * @brief Timing satu kanal dalam siklus PIO.
+ */
+typedef struct
+{
+    uint32_t period;
+    uint32_t delay;
+    uint32_t width;
+    bool inverted;
+} channel_cycles;
+
+/**
+ * @brief Menginisialisasi instance sequencer: memuat program PIO, mengklaim
+ *        state machine, dan mengkonfigurasi pin output.
+ *
+ * @param inst Instance yang akan diinisialisasi
+ * @param pio Instance PIO yang akan digunakan (pio0 atau pio1)
+ * @param pin_base Pin pertama dari pin output berurutan
+ * @param pin_count Jumlah pin output (1..SG_SEQ_MAX_CHANNELS)
+ * @return true jika berhasil
+ */
+bool sg_seq_init(sg_seq_instance *inst, PIO pio, uint pin_base, uint pin_count)
+{
+    if (pin_count == 0 || pin_count > SG_SEQ_MAX_CHANNELS)
+    {
+        return false;
+    }
+
+    int sm = pio_claim_unused_sm(pio, false);
+    if (sm < 0)
+    {
+        return false;
+    }
+
+    uint pio_index = pio_get_index(pio);
+    if (loaded_program[pio_index].users == 0)
+    {
+        if (!pio_can_add_program(pio, &signal_sequencer_program))
+        {
+            pio_sm_unclaim(pio, (uint)sm);
+            return false;
+        }
+        loaded_program[pio_index].offset = pio_add_program(pio, &signal_sequencer_program);
+    }
+    loaded_program[pio_index].users++;
+
+    inst->pio = pio;
+    inst->sm = (uint)sm;
+    inst->offset = loaded_program[pio_index].offset;
+    inst->pin_base = pin_base;
+    inst->pin_count = pin_count;
+    inst->sys_clk_hz = 0;
+    inst->pio_clk_div = 1.0f;
+    inst->next_event = 0;
+    inst->active = 0;
+    inst->update_pending = false;
+    inst->dma_chan[0] = -1;
+    inst->dma_chan[1] = -1;
+    inst->dma_running = false;
+    memset(inst->lists, 0, sizeof(inst->lists));
+
+    pio_sm_config c = signal_sequencer_program_get_default_config(inst->offset);
+
+    // Mask event ditulis dengan `out pins`; shift ke kanan tanpa autopull
+    sm_config_set_out_pins(&c, pin_base, pin_count);
+    sm_config_set_out_shift(&c, true, false, 32);
+    for (uint i = 0; i < pin_count; ++i)
+    {
+        pio_gpio_init(pio, pin_base + i);
+    }
+    pio_sm_set_consecutive_pindirs(pio, inst->sm, pin_base, pin_count, true);
+
+    pio_sm_init(pio, inst->sm, inst->offset, &c);
+
+    inst->state = SG_STATE_READY;
+    return true;
+}
+
+/**
+ * @brief Menghentikan instance dan melepaskan state machine serta program PIO.
+ *
+ * @param inst Instance yang akan dilepas
+ */
+void sg_seq_deinit(sg_seq_instance *inst)
+{
+    if (inst->state == SG_STATE_UNINIT)
+    {
+        return;
+    }
+    sg_seq_stop(inst);
+    pio_sm_unclaim(inst->pio, inst->sm);
+    for (uint i = 0; i < 2; ++i)
+    {
+        if (inst->dma_chan[i] >= 0)
+        {
+            dma_channel_unclaim((uint)inst->dma_chan[i]);
+            inst->dma_chan[i] = -1;
+        }
+    }
+
+    uint pio_index = pio_get_index(inst->pio);
+    if (--loaded_program[pio_index].users == 0)
+    {
+        pio_remove_program(inst->pio, &signal_sequencer_program, inst->offset);
+    }
+    inst->state = SG_STATE_UNINIT;
+}
+
+/**
+ * @brief Mengkompilasi dan menerapkan konfigurasi kanal ke instance yang berhenti.
+ *
+ * @param inst Instance sequencer
+ * @param config Konfigurasi frame dan kanal
+ * @return true jika konfigurasi valid dan diterapkan
+ */
+bool sg_seq_configure(sg_seq_instance *inst, const sg_seq_config *config)
+{
+    if (config->num_channels > inst->pin_count)
+    {
+        return false;
+    }
+
+    sg_event_list list;
+    if (!sg_seq_compile((float)clock_get_hz(clk_sys), config, &list))
+    {
+        return false;
+    }
+    return sg_seq_load(inst, &list, config->pio_clk_div);
+}
+
+/**
+ * @brief Memasang daftar event yang sudah jadi ke instance yang berhenti.
+ *
+ * Dipakai oleh mode yang membangun daftar event sendiri (misalnya PWM
+ * komplementer). Pin langsung diatur ke idle_mask.
+ *
+ * @param inst Instance sequencer
+ * @param list Daftar event (durasi dalam siklus PIO untuk pio_clk_div)
+ * @param pio_clk_div Clock divider state machine
+ * @return false jika instance sedang berjalan atau daftar kosong
+ */
+bool sg_seq_load(sg_seq_instance *inst, const sg_event_list *list, float pio_clk_div)
+{
+    if (inst->state == SG_STATE_UNINIT || inst->state == SG_STATE_RUNNING || list->count == 0)
+    {
+        return false;
+    }
+
+    inst->active = 0;
+    inst->update_pending = false;
+    inst->lists[0] = *list;
+    inst->pio_clk_div = pio_clk_div;
+    inst->sys_clk_hz = clock_get_hz(clk_sys);
+    pio_sm_set_clkdiv(inst->pio, inst->sm, pio_clk_div);
+
+    uint32_t pin_mask = ((1u << inst->pin_count) - 1u) << inst->pin_base;
+    pio_sm_set_pins_with_mask(inst->pio, inst->sm, list->idle_mask << inst->pin_base, pin_mask);
+    inst->state = SG_STATE_IDLE;
+    return true;
+}
+
+/**
+ * @brief Mengganti daftar event tanpa menghentikan state machine.
+ *
+ * Saat berjalan, daftar baru ditulis ke buffer yang tidak aktif dan dipakai
+ * feed mulai periode berikutnya; lead-in daftar baru diabaikan. Boleh
+ * dipanggil dari core atau interrupt lain selama hanya ada satu penulis.
+ *
+ * @param inst Instance sequencer
+ * @param list Daftar event baru dengan clock divider yang sama
+ * @return false jika pembaruan sebelumnya belum dipakai feed
+ */
+bool sg_seq_update(sg_seq_instance *inst, const sg_event_list *list)
+{
+    if (inst->state != SG_STATE_RUNNING)
+    {
+        return sg_seq_load(inst, list, inst->pio_clk_div);
+    }
+    if (inst->update_pending || inst->dma_running || list->count == 0)
+    {
+        return false;
+    }
+    inst->lists[inst->active ^ 1u] = *list;
+    __dmb();
+    inst->update_pending = true;
+    return true;
+}
+
+/**
+ * @brief Memulai state machine dari awal program.
+ *
+ * Lead-in (jika ada) dan event pertama dimasukkan ke FIFO sebelum state
+ * machine diaktifkan; edge pertama muncul SG_START_LATENCY_CYCLES siklus PIO
+ * setelah enable, sama seperti signal_gen.
+ *
+ * @param inst Instance sequencer yang sudah dikonfigurasi
+ */
+void __time_critical_func(sg_seq_start)(sg_seq_instance *inst)
+{
+    PIO pio = inst->pio;
+    uint sm = inst->sm;
+
+    pio_sm_clear_fifos(pio, sm);
+    pio_sm_restart(pio, sm);
+    pio_sm_exec(pio, sm, pio_encode_jmp(inst->offset));
+    inst->next_event = 0;
+    if (inst->update_pending)
+    {
+        inst->active ^= 1u;
+        inst->update_pending = false;
+    }
+    const sg_event_list *list = sg_seq_active_list(inst);
+    if (list->has_lead_in)
+    {
+        pio_sm_put(pio, sm, list->lead_in);
+    }
+    sg_seq_service(inst);
+    inst->state = SG_STATE_RUNNING;
+
+    pio_sm_set_enabled(pio, sm, true);
+}
+
+/**
+ * @brief Menyiapkan instance untuk feed di luar daftar event (DMA atau
+ *        interpreter program).
+ *
+ * Clock divider dan pin idle dipasang, lalu state machine dikembalikan ke awal
+ * program dengan FIFO kosong tetapi belum diaktifkan. Daftar event aktif
+ * dikosongkan sehingga sg_seq_service() tidak ikut mengisi FIFO; idle_mask
+ * tetap dipakai sg_seq_stop().
+ *
+ * @param inst Instance sequencer yang berhenti
+ * @param pio_clk_div Clock divider state machine
+ * @param idle_mask Level pin sebelum start dan setelah stop
+ * @return false jika instance belum diinisialisasi atau sedang berjalan
+ */
+bool sg_seq_prepare_feed(sg_seq_instance *inst, float pio_clk_div, uint32_t idle_mask)
+{
+    if (inst->state == SG_STATE_UNINIT || inst->state == SG_STATE_RUNNING)
+    {
+        return false;
+    }
+
+    inst->active = 0;
+    inst->update_pending = false;
+    inst->next_event = 0;
+    inst->lists[0].count = 0;
+    inst->lists[0].has_lead_in = false;
+    inst->lists[0].idle_mask = idle_mask;
+    inst->pio_clk_div = pio_clk_div;
+    inst->sys_clk_hz = clock_get_hz(clk_sys);
+    pio_sm_set_clkdiv(inst->pio, inst->sm, pio_clk_div);
+    uint32_t pin_mask = ((1u << inst->pin_count) - 1u) << inst->pin_base;
+    pio_sm_set_pins_with_mask(inst->pio, inst->sm, idle_mask << inst->pin_base, pin_mask);
+
+    pio_sm_clear_fifos(inst->pio, inst->sm);
+    pio_sm_restart(inst->pio, inst->sm);
+    pio_sm_exec(inst->pio, inst->sm, pio_encode_jmp(inst->offset));
+    inst->state = SG_STATE_IDLE;
+    return true;
+}
+
+/**
+ * @brief Memutar tabel event tanpa henti lewat DMA, tanpa keterlibatan CPU.
+ *
+ * Dua channel DMA membaca tabel dengan ring baca seukuran tabel dan saling
+ * memicu (chain) setiap selesai satu putaran, sehingga alamat baca selalu
+ * kembali ke awal tabel dan TRANS_COUNT dimuat ulang oleh trigger. Feed dipacu
+ * DREQ TX state machine. Tabel tidak boleh berubah selama berjalan; hentikan
+ * dengan sg_seq_stop().
+ *
+ * @param inst Instance sequencer yang berhenti
+ * @param table Word event (SG_SEQ_EVENT), rata ke words * 4 byte
+ * @param words Jumlah word, pangkat dua 1..SG_SEQ_DMA_MAX_WORDS
+ * @param pio_clk_div Clock divider state machine
+ * @param idle_mask Level pin sebelum start dan setelah stop
+ * @return false jika instance berjalan, tabel tidak memenuhi syarat ring,
+ *         atau channel DMA tidak tersedia
+ */
+bool sg_seq_start_dma(sg_seq_instance *inst, const uint32_t *table, uint words, float pio_clk_div,
+                      uint32_t idle_mask)
+{
+    if (inst->state == SG_STATE_UNINIT || inst->state == SG_STATE_RUNNING || words == 0 ||
+        words > SG_SEQ_DMA_MAX_WORDS || (words & (words - 1u)) != 0 ||
+        ((uintptr_t)table & (words * sizeof(uint32_t) - 1u)) != 0)
+    {
+        return false;
+    }
+    for (uint i = 0; i < 2; ++i)
+    {
+        if (inst->dma_chan[i] < 0)
+        {
+            inst->dma_chan[i] = dma_claim_unused_channel(false);
+            if (inst->dma_chan[i] < 0)
+            {
+                return false;
+            }
+        }
+    }
+    if (!sg_seq_prepare_feed(inst, pio_clk_div, idle_mask))
+    {
+        return false;
+    }
+
+    PIO pio = inst->pio;
+    uint sm = inst->sm;
+    uint ring_bits = 0;
+    while ((1u << ring_bits) < words * sizeof(uint32_t))
+    {
+        ring_bits++;
+    }
+    for (uint i = 0; i < 2; ++i)
+    {
+        uint chan = (uint)inst->dma_chan[i];
+        dma_channel_config c = dma_channel_get_default_config(chan);
+        channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+        channel_config_set_read_increment(&c, true);
+        channel_config_set_write_increment(&c, false);
+        channel_config_set_ring(&c, false, ring_bits);
+        channel_config_set_dreq(&c, pio_get_dreq(pio, sm, true));
+        channel_config_set_chain_to(&c, (uint)inst->dma_chan[i ^ 1u]);
+        dma_channel_configure(chan, &c, &pio->txf[sm], table, words, false);
+    }
+
+    // Channel pertama langsung mengisi FIFO sebelum state machine diaktifkan
+    inst->dma_running = true;
+    dma_channel_start((uint)inst->dma_chan[0]);
+    inst->state = SG_STATE_RUNNING;
+    pio_sm_set_enabled(pio, sm, true);
+    return true;
+}
+
+/**
+ * @brief Mengisi FIFO TX sebanyak ruang yang tersedia tanpa blocking.
+ *
+ * @param inst Instance yang sedang berjalan
+ * @return Jumlah event yang dikirim ke FIFO
+ */
+uint __time_critical_func(sg_seq_service)(sg_seq_instance *inst)
+{
+    uint pushed = 0;
+    if (inst->dma_running || sg_seq_active_list(inst)->count == 0)
+    {
+        return 0;
+    }
+    while (!pio_sm_is_tx_fifo_full(inst->pio, inst->sm))
+    {
+        // Daftar baru hanya dipakai di batas periode
+        if (inst->next_event == 0 && inst->update_pending)
+        {
+            inst->active ^= 1u;
+            inst->update_pending = false;
+        }
+        const sg_event_list *list = sg_seq_active_list(inst);
+        pio_sm_put(inst->pio, inst->sm, list->events[inst->next_event]);
+        if (++inst->next_event == list->count)
+        {
+            inst->next_event = 0;
+        }
+        pushed++;
+    }
+    return pushed;
+}
+
+/**
+ * @brief Menjalankan satu burst: start, memberi event ke FIFO, lalu stop.
+ *
+ * Sama seperti sg_run_burst(): loop berjalan dari SRAM, durasi dicek sekali
+ * per periode sehingga burst selalu berakhir pada batas periode. Pembaruan
+ * dari sg_seq_update() juga diambil di batas periode.
+ *
+ * @param inst Instance sequencer yang sudah dikonfigurasi
+ * @param duration_us Durasi burst dalam mikrodetik (maksimal ~71 menit)
+ * @return Waktu saat state machine diaktifkan
+ */
+absolute_time_t __time_critical_func(sg_seq_run_burst)(sg_seq_instance *inst, uint64_t duration_us)
+{
+    PIO pio = inst->pio;
+    uint sm = inst->sm;
+    uint32_t duration = (uint32_t)duration_us;
+
+    sg_seq_start(inst);
+    uint32_t start_us = time_us_32();
+
+    const sg_event_list *list = sg_seq_active_list(inst);
+    uint i = inst->next_event;
+    do
+    {
+        for (; i < list->count; ++i)
+        {
+            pio_sm_put_blocking(pio, sm, list->events[i]);
+        }
+        i = 0;
+        if (inst->update_pending)
+        {
+            inst->active ^= 1u;
+            inst->update_pending = false;
+            list = sg_seq_active_list(inst);
+        }
+    } while (time_us_32() - start_us < duration);
+    inst->next_event = 0;
+
+    sg_seq_stop(inst);
+
+    uint64_t now_us = time_us_64();
+    return from_us_since_boot(now_us - (uint32_t)((uint32_t)now_us - start_us));
+}
+
+/**
+ * @brief Menghentikan state machine dan mengembalikan pin ke idle_mask.
+ *
+ * Setiap pin hanya berpindah ke level tidak aktif, sehingga stop di tengah
+ * periode tidak pernah mengaktifkan pasangan komplementer.
+ *
+ * @param inst Instance sequencer
+ */
+void __time_critical_func(sg_seq_stop)(sg_seq_instance *inst)
+{
+    pio_sm_set_enabled(inst->pio, inst->sm, false);
+    if (inst->dma_running)
+    {
+        // Putus chain dulu agar abort satu channel tidak memicu pasangannya
+        for (uint i = 0; i < 2; ++i)
+        {
+            dma_channel_config c = dma_get_channel_config((uint)inst->dma_chan[i]);
+            channel_config_set_chain_to(&c, (uint)inst->dma_chan[i]);
+            dma_channel_set_config((uint)inst->dma_chan[i], &c, false);
+        }
+        dma_channel_abort((uint)inst->dma_chan[0]);
+        dma_channel_abort((uint)inst->dma_chan[1]);
+        pio_sm_clear_fifos(inst->pio, inst->sm);
+        inst->dma_running = false;
+    }
+    uint32_t pin_mask = ((1u << inst->pin_count) - 1u) << inst->pin_base;
+    pio_sm_set_pins_with_mask(inst->pio, inst->sm, sg_seq_active_list(inst)->idle_mask << inst->pin_base, pin_mask);
+    if (inst->state == SG_STATE_RUNNING)
+    {
+        inst->state = SG_STATE_IDLE;
+    }
+}
+
+// -- Compiler Edge --
+
+static bool channel_level(const channel_cycles *ch, uint32_t t)
+{
+    uint32_t phase = (t % ch->period + ch->period - ch->delay) % ch->period;
+    return (phase < ch->width) != ch->inverted;
+}
+
+static uint32_t mask_at(const channel_cycles *channels, uint count, uint32_t t)
+{
+    uint32_t mask = 0;
+    for (uint i = 0; i < count; ++i)
+    {
+        if (channel_level(&channels[i], t))
+        {
+            mask |= 1u << i;
+        }
+    }
+    return mask;
+}
+
+/**
+ * @brief Menambahkan satu segmen level ke daftar event, dipecah jika melebihi
+ *        durasi maksimal satu event.
+ */
+static bool append_segment(sg_event_list *out, uint32_t mask, uint32_t cycles)
+{
+    while (cycles > SG_SEQ_MAX_EVENT_CYCLES)
+    {
+        // Sisa tidak boleh lebih pendek dari overhead satu event
+        uint32_t chunk = cycles - SG_SEQ_MAX_EVENT_CYCLES < SG_EVENT_OVERHEAD_CYCLES
+                             ? SG_SEQ_MAX_EVENT_CYCLES - SG_EVENT_OVERHEAD_CYCLES
+                             : SG_SEQ_MAX_EVENT_CYCLES;
+        if (out->count == SG_SEQ_MAX_EVENTS)
+        {
+            return false;
+        }
+        out->events[out->count++] = SG_SEQ_EVENT(mask, chunk);
+        cycles -= chunk;
+    }
+    if (out->count == SG_SEQ_MAX_EVENTS)
+    {
+        return false;
+    }
+    out->events[out->count++] = SG_SEQ_EVENT(mask, cycles);
+    return true;
+}
+
+/**
+ * @brief Mengkompilasi timing per kanal menjadi daftar event (mask, durasi).
+ *
+ * Semua edge kanal dalam satu frame dikuantisasi ke siklus PIO, diurutkan,
+ * lalu edge yang tidak mengubah mask (edge bersamaan yang saling meniadakan)
+ * dibuang. Setiap edge tersisa memulai satu event, sehingga satu frame berisi
+ * paling banyak dua event per pulsa kanal.
+ *
+ * @param sys_clk_hz Frekuensi clock sistem (Hz)
+ * @param config Konfigurasi frame dan kanal
+ * @param out Daftar event hasil kompilasi
+ * @return false jika konfigurasi tidak valid, ada segmen yang lebih pendek
+ *         dari SG_EVENT_OVERHEAD_CYCLES, atau event tidak muat
+ */
+bool sg_seq_compile(float sys_clk_hz, const sg_seq_config *config, sg_event_list *out)
+{
+    if (config->frequency_hz <= 0.0f || config->pio_clk_div < 1.0f || config->num_channels == 0 ||
+        config->num_channels > SG_SEQ_MAX_CHANNELS)
+    {
+        return false;
+    }
+
+    float pio_clk_hz = sys_clk_hz / config->pio_clk_div;
+    uint32_t frame = (uint32_t)(pio_clk_hz / config->frequency_hz);
+    if (frame < SG_EVENT_OVERHEAD_CYCLES)
+    {
+        return false;
+    }
+
+    // Konversi timing kanal ke siklus PIO dan kumpulkan semua edge
+    channel_cycles channels[SG_SEQ_MAX_CHANNELS];
+    uint32_t edges[MAX_RAW_EDGES];
+    uint edge_count = 0;
+    for (uint i = 0; i < config->num_channels; ++i)
+    {
+        const sg_channel_timing *t = &config->channels[i];
+        channel_cycles *ch = &channels[i];
+        ch->period = t->period_us > 0.0f ? (uint32_t)(t->period_us * 1e-6f * pio_clk_hz) : frame;
+        ch->delay = (uint32_t)(t->delay_us * 1e-6f * pio_clk_hz);
+        ch->width = (uint32_t)(t->width_us * 1e-6f * pio_clk_hz);
+        ch->inverted = t->inverted;
+        if (ch->period == 0 || frame % ch->period != 0 || ch->delay >= ch->period || ch->width > ch->period)
+        {
+            return false;
+        }
+        if (ch->width == 0 || ch->width == ch->period)
+        {
+            continue; // Level konstan, tidak ada edge
+        }
+        for (uint32_t start = ch->delay; start < frame; start += ch->period)
+        {
+            if (edge_count + 2 > MAX_RAW_EDGES)
+            {
+                return false;
+            }
+            edges[edge_count++] = start;
+            edges[edge_count++] = (start + ch->width) % frame;
+        }
+    }
+
+    // Urutkan (insertion sort, jumlah edge kecil) dan buang duplikat
+    for (uint i = 1; i < edge_count; ++i)
+    {
+        uint32_t v = edges[i];
+        uint j = i;
+        while (j > 0 && edges[j - 1] > v)
+        {
+            edges[j] = edges[j - 1];
+            j--;
+        }
+        edges[j] = v;
+    }
+    uint unique = 0;
+    for (uint i = 0; i < edge_count; ++i)
+    {
+        if (unique == 0 || edges[unique - 1] != edges[i])
+        {
+            edges[unique++] = edges[i];
+        }
+    }
+
+    // Pertahankan hanya edge yang benar-benar mengubah mask (melingkar)
+    uint32_t masks[MAX_RAW_EDGES];
+    for (uint i = 0; i < unique; ++i)
+    {
+        masks[i] = mask_at(channels, config->num_channels, edges[i]);
+    }
+    uint kept = 0;
+    for (uint i = 0; i < unique; ++i)
+    {
+        uint32_t prev = masks[i == 0 ? unique - 1 : i - 1];
+        if (masks[i] != prev)
+        {
+            edges[kept] = edges[i];
+            masks[kept] = masks[i];
+            kept++;
+        }
+    }
+
+    out->count = 0;
+    out->period_cycles = frame;
+    out->has_lead_in = false;
+    out->idle_mask = 0;
+    for (uint i = 0; i < config->num_channels; ++i)
+    {
+        if (channels[i].inverted)
+        {
+            out->idle_mask |= 1u << i;
+        }
+    }
+    if (kept == 0)
+    {
+        // Semua kanal konstan: satu segmen sepanjang frame
+        return append_segment(out, mask_at(channels, config->num_channels, 0), frame);
+    }
+
+    // Lead-in: bagian frame sebelum edge pertama, hanya dikirim saat start
+    if (edges[0] > 0)
+    {
+        if (edges[0] < SG_EVENT_OVERHEAD_CYCLES || edges[0] > SG_SEQ_MAX_EVENT_CYCLES)
+        {
+            return false;
+        }
+        out->has_lead_in = true;
+        out->lead_in = SG_SEQ_EVENT(mask_at(channels, config->num_channels, 0), edges[0]);
+    }
+
+    // Event steady-state: dari edge ke edge berikutnya, edge terakhir membungkus
+    for (uint i = 0; i < kept; ++i)
+    {
+        uint32_t end = i + 1 < kept ? edges[i + 1] : edges[0] + frame;
+        uint32_t cycles = end - edges[i];
+        if (cycles < SG_EVENT_OVERHEAD_CYCLES || !append_segment(out, masks[i], cycles))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Memeriksa bahwa daftar event aman untuk pasangan komplementer.
+ *
+ * Syarat yang diperiksa:
+ * - tidak ada event yang mengaktifkan pin sisi A dan sisi B bersamaan;
+ * - di antara akhir sisi mana pun dan awal sisi lawannya ada jeda semua-mati
+ *   minimal deadtime_cycles, termasuk melingkar dari akhir ke awal periode;
+ * - event terakhir periode adalah jeda semua-mati minimal deadtime_cycles,
+ *   sehingga daftar ini aman disambung dengan daftar lain yang juga lolos
+ *   pemeriksaan (pembaruan di batas periode).
+ *
+ * @param list Daftar event (lead-in diperiksa sebagai awal sambungan)
+ * @param side_a_mask Pin sisi A (misalnya high-side)
+ * @param side_b_mask Pin sisi B (komplemen sisi A)
+ * @param deadtime_cycles Jeda minimal (siklus PIO)
+ * @return true jika semua syarat terpenuhi
+ */
+bool sg_seq_check_interlock(const sg_event_list *list, uint32_t side_a_mask, uint32_t side_b_mask,
+                            uint32_t deadtime_cycles)
+{
+    if (list->count == 0)
+    {
+        return false;
+    }
+    uint32_t last = list->events[list->count - 1];
+    if ((SG_SEQ_EVENT_MASK(last) & (side_a_mask | side_b_mask)) || SG_SEQ_EVENT_CYCLES(last) < deadtime_cycles)
+    {
+        return false;
+    }
+
+    // Telusuri dua periode agar transisi yang melingkar ikut diperiksa
+    uint32_t prev_side = 0; // Sisi aktif terakhir (0 = belum ada)
+    uint32_t off_cycles = 0;
+    for (uint n = 0; n < 2 * list->count; ++n)
+    {
+        uint32_t event = list->events[n % list->count];
+        uint32_t mask = SG_SEQ_EVENT_MASK(event);
+        bool a = mask & side_a_mask;
+        bool b = mask & side_b_mask;
+        if (a && b)
+        {
+            return false;
+        }
+        if (!a && !b)
+        {
+            off_cycles += SG_SEQ_EVENT_CYCLES(event);
+            continue;
+        }
+        uint32_t side = a ? side_a_mask : side_b_mask;
+        if (prev_side && side != prev_side && off_cycles < deadtime_cycles)
+        {
+            return false;
+        }
+        prev_side = side;
+        off_cycles = 0;
+    }
+
+    // Lead-in dimulai dari pin idle; cukup tidak boleh mengaktifkan kedua sisi
+    uint32_t lead_mask = list->has_lead_in ? SG_SEQ_EVENT_MASK(list->lead_in) : 0;
+    return !((lead_mask & side_a_mask) && (lead_mask & side_b_mask));
+}
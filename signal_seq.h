@@ -0,0 +1,133 @@
+/**
+ * Sequencer generik berbasis PIO dengan compiler edge per kanal.
+ *
+ * Setiap kanal output didefinisikan sendiri-sendiri (periode, delay, lebar
+ * pulsa, polaritas). sg_seq_compile() mengurutkan dan menggabungkan semua
+ * edge kanal menjadi daftar event (mask, durasi) minimum untuk program
+ * signal_sequencer.pio. Untuk N kanal yang memakai periode frame, satu periode
+ * berisi paling banyak 2N event sehingga bandwidth feed tumbuh linier.
+ *
+ * Pola yang panjang (misalnya tabel PWM tiga fasa satu periode fundamental)
+ * dapat diputar oleh dua channel DMA ping-pong lewat sg_seq_start_dma(),
+ * sehingga CPU tidak terlibat sama sekali selama output berjalan.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef SIGNAL_SEQ_H
+#define SIGNAL_SEQ_H
+
+#include "signal_gen.h"
+#include "hardware/dma.h"
+
+// -- Konstanta Sequencer --
+#define SG_SEQ_MAX_CHANNELS 8  // Lebar mask pada word event
+#define SG_SEQ_MAX_EVENTS 64   // Kapasitas daftar event per periode
+#define SG_SEQ_DURATION_BITS 24
+
+// Batas tabel untuk sg_seq_start_dma(): ring baca DMA maksimal 2^15 byte
+#define SG_SEQ_DMA_MAX_RING_BITS 15
+#define SG_SEQ_DMA_MAX_WORDS (1u << (SG_SEQ_DMA_MAX_RING_BITS - 2))
+
+// Durasi maksimal satu event (siklus PIO); segmen yang lebih panjang dipecah
+#define SG_SEQ_MAX_EVENT_CYCLES ((1u << SG_SEQ_DURATION_BITS) - 1u + SG_EVENT_OVERHEAD_CYCLES)
+
+// Menyusun word event: level pin `mask` selama `cycles` siklus PIO (>= 4)
+#define SG_SEQ_EVENT(mask, cycles) \
+    (((uint32_t)(mask) << SG_SEQ_DURATION_BITS) | ((uint32_t)(cycles) - SG_EVENT_OVERHEAD_CYCLES))
+#define SG_SEQ_EVENT_MASK(event) ((uint32_t)(event) >> SG_SEQ_DURATION_BITS)
+#define SG_SEQ_EVENT_CYCLES(event) \
+    (((uint32_t)(event) & ((1u << SG_SEQ_DURATION_BITS) - 1u)) + SG_EVENT_OVERHEAD_CYCLES)
+
+/**
+ * @brief Timing satu kanal output.
+ */
+typedef struct
+{
+    float period_us; // Periode kanal (us); 0 = periode frame. Harus membagi periode frame
+    float delay_us;  // Jarak dari awal periode kanal ke edge aktif (us)
+    float width_us;  // Lebar pulsa aktif (us)
+    bool inverted;   // true = aktif LOW
+} sg_channel_timing;
+
+/**
+ * @brief Konfigurasi sequencer: periode frame dan timing setiap kanal.
+ */
+typedef struct
+{
+    float frequency_hz; // Frekuensi frame (Hz)
+    float pio_clk_div;  // Clock divider state machine PIO
+    uint num_channels;  // Jumlah kanal (pin berurutan mulai dari pin_base)
+    sg_channel_timing channels[SG_SEQ_MAX_CHANNELS];
+} sg_seq_config;
+
+/**
+ * @brief Daftar event hasil kompilasi.
+ *
+ * Event steady-state dimulai pada edge pertama di dalam frame dan berulang
+ * terus. Bagian frame sebelum edge pertama dikirim sekali sebagai lead-in
+ * saat start sehingga delay kanal relatif terhadap start tetap benar.
+ */
+typedef struct
+{
+    bool has_lead_in;
+    uint32_t lead_in;                    // Event pembuka (hanya jika has_lead_in)
+    uint count;                          // Jumlah event steady-state per periode
+    uint32_t events[SG_SEQ_MAX_EVENTS];  // Word event steady-state
+    uint32_t period_cycles;              // Periode frame (siklus PIO)
+    uint32_t idle_mask;                  // Level pin saat semua kanal tidak aktif
+} sg_event_list;
+
+/**
+ * @brief Satu instance sequencer.
+ *
+ * Daftar event disimpan ganda: feed membaca lists[active], sedangkan
+ * sg_seq_update() menulis daftar berikutnya ke buffer lainnya. Pertukaran
+ * dilakukan oleh feed tepat di batas periode sehingga setiap periode
+ * seluruhnya berasal dari satu daftar.
+ */
+typedef struct
+{
+    PIO pio;                      // Blok PIO yang digunakan
+    uint sm;                      // Nomor state machine
+    uint offset;                  // Offset program di instruction memory
+    uint pin_base;                // Pin pertama
+    uint pin_count;               // Jumlah pin output (<= SG_SEQ_MAX_CHANNELS)
+    float pio_clk_div;            // Clock divider aktif
+    uint32_t sys_clk_hz;          // clk_sys yang dipakai saat kompilasi
+    sg_event_list lists[2];       // Daftar event aktif dan berikutnya
+    volatile uint active;         // Indeks daftar yang sedang dipakai feed
+    volatile bool update_pending; // lists[active ^ 1] menunggu batas periode
+    uint next_event;              // Event berikutnya untuk sg_seq_service()
+    int dma_chan[2];              // Channel DMA ping-pong, -1 jika belum diklaim
+    bool dma_running;             // FIFO diisi DMA, bukan sg_seq_service()
+    sg_state state;
+} sg_seq_instance;
+
+// -- API --
+bool sg_seq_init(sg_seq_instance *inst, PIO pio, uint pin_base, uint pin_count);
+void sg_seq_deinit(sg_seq_instance *inst);
+bool sg_seq_configure(sg_seq_instance *inst, const sg_seq_config *config);
+void sg_seq_start(sg_seq_instance *inst);
+uint sg_seq_service(sg_seq_instance *inst);
+absolute_time_t sg_seq_run_burst(sg_seq_instance *inst, uint64_t duration_us);
+void sg_seq_stop(sg_seq_instance *inst);
+bool sg_seq_load(sg_seq_instance *inst, const sg_event_list *list, float pio_clk_div);
+bool sg_seq_update(sg_seq_instance *inst, const sg_event_list *list);
+bool sg_seq_prepare_feed(sg_seq_instance *inst, float pio_clk_div, uint32_t idle_mask);
+bool sg_seq_start_dma(sg_seq_instance *inst, const uint32_t *table, uint words, float pio_clk_div,
+                      uint32_t idle_mask);
+
+bool sg_seq_compile(float sys_clk_hz, const sg_seq_config *config, sg_event_list *out);
+bool sg_seq_check_interlock(const sg_event_list *list, uint32_t side_a_mask, uint32_t side_b_mask,
+                            uint32_t deadtime_cycles);
+
+/**
+ * @brief Daftar event yang sedang dipakai feed.
+ */
+static inline const sg_event_list *sg_seq_active_list(const sg_seq_instance *inst)
+{
+    return &inst->lists[inst->active];
+}
+
+#endif
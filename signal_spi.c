@@ -0,0 +1,408 @@
+/**
+ * Implementasi kontrol SPI target dengan frame yang di-DMA langsung ke set
+ * delay generator.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "signal_spi.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "signal_spi.pio.h" // Header yang di-generate otomatis
+
+#define MAX_TARGETS (NUM_DMA_CHANNELS / 3)
+
+// -- Target Aktif yang Dilayani Handler DMA_IRQ_0 --
+// Handler dipasang oleh target pertama dan dilepas oleh yang terakhir
+static sg_spi_instance *active_targets[MAX_TARGETS];
+static uint active_count;
+
+// -- Program PIO yang Dimuat per Blok PIO --
+static struct
+{
+    uint offset;
+    uint users;
+} loaded_program[NUM_PIOS];
+
+// -- Helper Frame --
+
+static uint32_t frame_checksum(const uint32_t words[SG_SPI_FRAME_WORDS])
+{
+    uint32_t sum = 0;
+    for (uint i = 0; i < SG_SPI_FRAME_WORDS - 1; ++i)
+    {
+        sum += words[i];
+    }
+    return ~sum;
+}
+
+static bool __time_critical_func(frame_valid)(const uint32_t words[SG_SPI_FRAME_WORDS])
+{
+    return (words[0] >> 16) == SG_SPI_MAGIC && words[SG_SPI_FRAME_WORDS - 1] == frame_checksum(words);
+}
+
+static uint set_index(const sg_spi_instance *t, uintptr_t addr)
+{
+    uintptr_t base = (uintptr_t)t->sets;
+    return addr < base ? SG_SPI_NUM_SETS : (uint)((addr - base) / sizeof(t->sets[0]));
+}
+
+/**
+ * @brief Memilih set yang bukan set aktif dan bukan set yang sedang dibaca
+ *        channel data.
+ *
+ * Channel kontrol hanya pernah memuat pointer aktif, jadi set yang dipilih
+ * tetap bebas walaupun channel data berpindah set tepat setelah pemeriksaan.
+ */
+static uint __time_critical_func(free_set)(const sg_spi_instance *t)
+{
+    uint reading = set_index(t, (uintptr_t)dma_channel_hw_addr((uint)t->dma_data)->read_addr);
+    uint active = set_index(t, (uintptr_t)t->active);
+    uint i = 0;
+    while (i == reading || i == active)
+    {
+        i++;
+    }
+    return i;
+}
+
+/**
+ * @brief Me-restart penerima agar bit berikutnya menunggu CS dilepas.
+ */
+static void __time_critical_func(resync_receiver)(sg_spi_instance *t)
+{
+    pio_sm_set_enabled(t->pio, t->sm, false);
+    pio_sm_clear_fifos(t->pio, t->sm);
+    pio_sm_restart(t->pio, t->sm);
+    pio_sm_exec(t->pio, t->sm, pio_encode_jmp(t->offset + signal_spi_target_offset_resync));
+    pio_sm_set_enabled(t->pio, t->sm, true);
+}
+
+/**
+ * @brief Menerapkan frame yang baru selesai di-DMA dan mengarahkan DMA
+ *        penerima ke set berikutnya.
+ */
+static void __time_critical_func(receive_frame)(sg_spi_instance *t)
+{
+    const uint32_t *frame = t->sets[t->fill];
+    if (frame_valid(frame))
+    {
+        // Satu tulisan word: channel kontrol membaca pointer lama atau baru,
+        // tidak pernah campuran
+        t->active = &frame[SG_SPI_WORD_DELAYS];
+        t->last_sequence = (uint16_t)frame[0];
+        t->frames++;
+        t->fill = free_set(t);
+    }
+    else
+    {
+        t->rejected++;
+        resync_receiver(t);
+    }
+    dma_channel_set_write_addr((uint)t->dma_rx, t->sets[t->fill], true);
+}
+
+/**
+ * @brief Handler shared DMA_IRQ_0: satu frame per channel penerima yang selesai.
+ */
+static void __isr __time_critical_func(spi_irq_handler)(void)
+{
+    for (uint i = 0; i < MAX_TARGETS; ++i)
+    {
+        sg_spi_instance *t = active_targets[i];
+        if (!t || !dma_channel_get_irq0_status((uint)t->dma_rx))
+        {
+            continue;
+        }
+        dma_channel_acknowledge_irq0((uint)t->dma_rx);
+        receive_frame(t);
+    }
+}
+
+static void release_channels(sg_spi_instance *t)
+{
+    int *chan[3] = {&t->dma_rx, &t->dma_ctrl, &t->dma_data};
+    for (uint i = 0; i < 3; ++i)
+    {
+        if (*chan[i] >= 0)
+        {
+            dma_channel_unclaim((uint)*chan[i]);
+            *chan[i] = -1;
+        }
+    }
+}
+
+// -- API --
+
+/**
+ * @brief Menjalankan penerima SPI target untuk satu generator.
+ *
+ * Set aktif awal berisi delay generator saat ini. Penerima langsung aktif:
+ * frame yang masuk sebelum sg_spi_start() menentukan periode pertama.
+ * Selama instance hidup, generator hanya boleh dijalankan dan dihentikan
+ * lewat sg_spi_start()/sg_spi_stop().
+ *
+ * @param t Instance target
+ * @param pio Blok PIO untuk state machine penerima
+ * @param pin_base Pin MOSI; SCK = pin_base + 1, CS = pin_base + 2
+ * @param gen Generator yang sudah dikonfigurasi dan berhenti
+ * @return false jika generator belum siap, atau state machine, instruction
+ *         memory maupun channel DMA tidak cukup
+ */
+bool sg_spi_init(sg_spi_instance *t, PIO pio, uint pin_base, sg_instance *gen)
+{
+    if (gen->state != SG_STATE_IDLE)
+    {
+        return false;
+    }
+    uint slot = MAX_TARGETS;
+    for (uint i = 0; i < MAX_TARGETS && slot == MAX_TARGETS; ++i)
+    {
+        if (!active_targets[i])
+        {
+            slot = i;
+        }
+    }
+    if (slot == MAX_TARGETS)
+    {
+        return false;
+    }
+
+    t->dma_rx = dma_claim_unused_channel(false);
+    t->dma_ctrl = dma_claim_unused_channel(false);
+    t->dma_data = dma_claim_unused_channel(false);
+    if (t->dma_rx < 0 || t->dma_ctrl < 0 || t->dma_data < 0)
+    {
+        release_channels(t);
+        return false;
+    }
+    int sm = pio_claim_unused_sm(pio, false);
+    if (sm < 0)
+    {
+        release_channels(t);
+        return false;
+    }
+    uint pio_index = pio_get_index(pio);
+    if (loaded_program[pio_index].users == 0)
+    {
+        if (!pio_can_add_program(pio, &signal_spi_target_program))
+        {
+            pio_sm_unclaim(pio, (uint)sm);
+            release_channels(t);
+            return false;
+        }
+        loaded_program[pio_index].offset = pio_add_program(pio, &signal_spi_target_program);
+    }
+    loaded_program[pio_index].users++;
+
+    t->gen = gen;
+    t->pio = pio;
+    t->sm = (uint)sm;
+    t->offset = loaded_program[pio_index].offset;
+    t->pin_base = pin_base;
+    t->last_sequence = 0;
+    t->frames = 0;
+    t->rejected = 0;
+
+    // Set 0 = konfigurasi generator saat ini, dalam format frame yang valid
+    uint32_t *initial = t->sets[0];
+    initial[0] = SG_SPI_MAGIC << 16;
+    for (uint i = 0; i < SG_NUM_EVENTS; ++i)
+    {
+        initial[SG_SPI_WORD_DELAYS + i] = gen->delays[i];
+    }
+    initial[SG_SPI_FRAME_WORDS - 1] = frame_checksum(initial);
+    t->active = &initial[SG_SPI_WORD_DELAYS];
+    t->fill = 1;
+
+    // Penerima: clk_sys penuh, word MSB dulu, FIFO RX 8 word
+    pio_sm_config c = signal_spi_target_program_get_default_config(t->offset);
+    sm_config_set_in_pins(&c, pin_base);
+    sm_config_set_in_shift(&c, false, true, 32);
+    sm_config_set_fifo_join(&c, PIO_FIFO_JOIN_RX);
+    for (uint i = 0; i < SG_SPI_NUM_PINS; ++i)
+    {
+        pio_gpio_init(pio, pin_base + i);
+    }
+    gpio_pull_up(pin_base + 2); // CS tidak aktif saat controller belum terhubung
+    pio_sm_set_consecutive_pindirs(pio, t->sm, pin_base, SG_SPI_NUM_PINS, false);
+    pio_sm_init(pio, t->sm, t->offset + signal_spi_target_offset_resync, &c);
+
+    uint rx = (uint)t->dma_rx;
+    dma_channel_config rc = dma_channel_get_default_config(rx);
+    channel_config_set_transfer_data_size(&rc, DMA_SIZE_32);
+    channel_config_set_read_increment(&rc, false);
+    channel_config_set_write_increment(&rc, true);
+    channel_config_set_dreq(&rc, pio_get_dreq(pio, t->sm, false));
+    dma_channel_configure(rx, &rc, t->sets[t->fill], &pio->rxf[t->sm], SG_SPI_FRAME_WORDS, false);
+    dma_channel_acknowledge_irq0(rx);
+
+    active_targets[slot] = t;
+    if (active_count++ == 0)
+    {
+        irq_add_shared_handler(DMA_IRQ_0, spi_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+        irq_set_enabled(DMA_IRQ_0, true);
+    }
+    dma_channel_set_irq0_enabled(rx, true);
+    dma_channel_start(rx);
+
+    t->state = SG_STATE_IDLE;
+    pio_sm_set_enabled(pio, t->sm, true);
+    return true;
+}
+
+/**
+ * @brief Menghentikan generator dan penerima, lalu melepaskan state machine,
+ *        channel DMA, program PIO dan handler interrupt.
+ *
+ * @param t Instance target
+ */
+void sg_spi_deinit(sg_spi_instance *t)
+{
+    if (t->state == SG_STATE_UNINIT)
+    {
+        return;
+    }
+    sg_spi_stop(t);
+
+    uint32_t status = save_and_disable_interrupts();
+    pio_sm_set_enabled(t->pio, t->sm, false);
+    dma_channel_set_irq0_enabled((uint)t->dma_rx, false);
+    dma_channel_abort((uint)t->dma_rx);
+    dma_channel_acknowledge_irq0((uint)t->dma_rx);
+    for (uint i = 0; i < MAX_TARGETS; ++i)
+    {
+        if (active_targets[i] == t)
+        {
+            active_targets[i] = NULL;
+        }
+    }
+    if (--active_count == 0)
+    {
+        irq_remove_handler(DMA_IRQ_0, spi_irq_handler);
+    }
+    restore_interrupts(status);
+
+    uint pio_index = pio_get_index(t->pio);
+    if (--loaded_program[pio_index].users == 0)
+    {
+        pio_remove_program(t->pio, &signal_spi_target_program, t->offset);
+    }
+    pio_sm_unclaim(t->pio, t->sm);
+    release_channels(t);
+    t->state = SG_STATE_UNINIT;
+}
+
+/**
+ * @brief Menjalankan generator dengan delay dari set aktif; setelah ini PIO
+ *        dan DMA berjalan sendiri.
+ *
+ * @param t Instance target dalam state SG_STATE_IDLE
+ * @return false jika target atau generator tidak dalam state SG_STATE_IDLE
+ */
+bool sg_spi_start(sg_spi_instance *t)
+{
+    sg_instance *gen = t->gen;
+    if (t->state != SG_STATE_IDLE || gen->state != SG_STATE_IDLE)
+    {
+        return false;
+    }
+    PIO pio = gen->pio;
+    uint sm = gen->sm;
+    pio_sm_clear_fifos(pio, sm);
+    pio_sm_restart(pio, sm);
+    pio_sm_exec(pio, sm, pio_encode_jmp(gen->offset));
+
+    // Channel data: satu periode dari set yang dimuat channel kontrol
+    uint data = (uint)t->dma_data;
+    uint ctrl = (uint)t->dma_ctrl;
+    dma_channel_config dc = dma_channel_get_default_config(data);
+    channel_config_set_transfer_data_size(&dc, DMA_SIZE_32);
+    channel_config_set_read_increment(&dc, true);
+    channel_config_set_write_increment(&dc, false);
+    channel_config_set_dreq(&dc, pio_get_dreq(pio, sm, true));
+    channel_config_set_chain_to(&dc, ctrl);
+    channel_config_set_irq_quiet(&dc, true);
+    dma_channel_configure(data, &dc, &pio->txf[sm], t->active, SG_NUM_EVENTS, false);
+
+    // Channel kontrol: satu pointer per periode ke alias READ_ADDR_TRIG.
+    // DREQ TX yang sama menahan pembacaan pointer sampai PIO menarik delay
+    // event A periode berjalan; tanpa itu pointer sudah dibaca saat event D
+    // ditarik dan lookahead bertambah hampir satu periode.
+    dma_channel_config cc = dma_channel_get_default_config(ctrl);
+    channel_config_set_transfer_data_size(&cc, DMA_SIZE_32);
+    channel_config_set_read_increment(&cc, false);
+    channel_config_set_write_increment(&cc, false);
+    channel_config_set_dreq(&cc, pio_get_dreq(pio, sm, true));
+    channel_config_set_irq_quiet(&cc, true);
+    dma_channel_configure(ctrl, &cc, &dma_channel_hw_addr(data)->al3_read_addr_trig, &t->active, 1, false);
+
+    // FIFO terisi satu periode sebelum state machine diaktifkan
+    dma_channel_start(ctrl);
+    gen->next_event = 0;
+    gen->state = SG_STATE_RUNNING;
+    t->state = SG_STATE_RUNNING;
+    pio_sm_set_enabled(pio, sm, true);
+    return true;
+}
+
+/**
+ * @brief Menghentikan generator seketika dan menahan output LOW.
+ *
+ * Penerima tetap aktif; delay generator (sg_instance.delays) tidak diubah
+ * oleh frame SPI.
+ *
+ * @param t Instance target
+ */
+void sg_spi_stop(sg_spi_instance *t)
+{
+    if (t->state != SG_STATE_RUNNING)
+    {
+        return;
+    }
+    sg_stop(t->gen);
+
+    // Putus chain dulu agar abort channel data tidak memicu channel kontrol
+    uint data = (uint)t->dma_data;
+    dma_channel_config c = dma_get_channel_config(data);
+    channel_config_set_chain_to(&c, data);
+    dma_channel_set_config(data, &c, false);
+    dma_channel_abort((uint)t->dma_ctrl);
+    dma_channel_abort(data);
+    pio_sm_clear_fifos(t->gen->pio, t->gen->sm);
+    t->state = SG_STATE_IDLE;
+}
+
+/**
+ * @brief Menyusun frame SPI untuk konfigurasi timing generator.
+ *
+ * Dapat dipakai controller yang menjalankan kode yang sama; clk_sys dan
+ * clock divider diambil dari generator tujuan.
+ *
+ * @param gen Generator tujuan (sys_clk_hz dan pio_clk_div)
+ * @param timing Konfigurasi baru; pio_clk_div harus sama dengan generator
+ * @param sequence Nomor urut frame
+ * @param frame Buffer SG_SPI_FRAME_BYTES byte
+ * @return false jika parameter tidak valid atau clock divider berbeda
+ */
+bool sg_spi_encode_frame(const sg_instance *gen, const sg_timing_config *timing, uint16_t sequence,
+                         uint8_t frame[SG_SPI_FRAME_BYTES])
+{
+    uint32_t words[SG_SPI_FRAME_WORDS];
+    if (timing->pio_clk_div != gen->timing.pio_clk_div ||
+        !sg_calculate_delays((float)gen->sys_clk_hz, timing, &words[SG_SPI_WORD_DELAYS]))
+    {
+        return false;
+    }
+    words[0] = SG_SPI_MAGIC << 16 | sequence;
+    words[SG_SPI_FRAME_WORDS - 1] = frame_checksum(words);
+    for (uint i = 0; i < SG_SPI_FRAME_WORDS; ++i)
+    {
+        for (uint b = 0; b < 4; ++b)
+        {
+            frame[4 * i + b] = (uint8_t)(words[i] >> (24 - 8 * b));
+        }
+    }
+    return true;
+}
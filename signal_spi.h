@@ -0,0 +1,83 @@
+/**
+ * Antarmuka kontrol SPI target berlatensi rendah untuk update parameter.
+ *
+ * Controller eksternal mengirim frame tetap SG_SPI_FRAME_BYTES byte (SPI
+ * mode 0, MSB dulu, word big-endian) berisi delay event langsung dalam
+ * siklus PIO, sama dengan hasil sg_calculate_delays():
+ *
+ *   word 0     SG_SPI_MAGIC << 16 | nomor urut 16 bit
+ *   word 1..4  delay event A, B, C, D
+ *   word 5     ~(jumlah word 0..4)
+ *
+ * sg_spi_encode_frame() menyusun frame dari sg_timing_config.
+ *
+ * Jalur data tanpa CPU: state machine signal_spi_target menggeser bit ke
+ * FIFO RX dan DMA menyalin frame langsung ke salah satu dari tiga set di
+ * instance. Generator juga diberi data DMA: channel kontrol membaca pointer
+ * set aktif sekali per periode (control block ke READ_ADDR_TRIG) lalu
+ * channel data memindahkan keempat delay ke FIFO TX. CPU hanya menjalankan
+ * handler DMA_IRQ_0 di akhir frame: memeriksa magic dan checksum, mengganti
+ * pointer set aktif (satu tulisan word) dan mengarahkan DMA penerima ke set
+ * yang tidak sedang dibaca.
+ *
+ * Pointer dibaca saat channel data mulai mengisi periode berikutnya, yaitu
+ * ketika PIO menarik delay event A periode berjalan. FIFO TX selalu berisi
+ * tepat satu periode di depan (itulah yang membuat edge bebas jitter), jadi
+ * frame berlaku utuh mulai batas periode pertama yang belum diantrekan:
+ * latensi akhir frame -> edge pertama dengan delay baru antara satu dan dua
+ * periode, ditambah latensi handler (sekitar 1-2 us). Tidak pernah ada
+ * periode campuran.
+ *
+ * Frame yang terpotong (CS naik lebih awal) menggeser word berikutnya;
+ * checksum menolak frame gabungan itu, state machine di-restart di `resync`
+ * dan menunggu CS dilepas, sehingga paling banyak satu frame sesudahnya ikut
+ * hilang. Trim sg_trim_clock() dan dither tidak berlaku di mode ini.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef SIGNAL_SPI_H
+#define SIGNAL_SPI_H
+
+#include "signal_gen.h"
+
+#define SG_SPI_NUM_PINS 3 // MOSI, SCK, CS berurutan mulai pin_base
+#define SG_SPI_MAGIC 0x5347u
+#define SG_SPI_FRAME_WORDS 6
+#define SG_SPI_FRAME_BYTES (SG_SPI_FRAME_WORDS * 4)
+#define SG_SPI_WORD_DELAYS 1 // Indeks word delay event A di dalam frame
+
+// Set frame: satu dibaca generator, satu aktif, satu diisi DMA penerima
+#define SG_SPI_NUM_SETS 3
+
+/**
+ * @brief Target SPI yang mengatur satu generator klasik.
+ */
+typedef struct
+{
+    sg_instance *gen;                  // Generator yang diberi data DMA
+    PIO pio;                           // Blok PIO penerima SPI
+    uint sm;                           // State machine penerima
+    uint offset;                       // Offset program signal_spi_target
+    uint pin_base;                     // Pin MOSI (SCK = +1, CS = +2)
+    int dma_rx;                        // FIFO RX penerima -> set frame
+    int dma_ctrl;                      // Pointer set aktif -> READ_ADDR_TRIG dma_data
+    int dma_data;                      // Set aktif -> FIFO TX generator
+    uint32_t sets[SG_SPI_NUM_SETS][SG_SPI_FRAME_WORDS];
+    const uint32_t *volatile active;   // Delay set yang dibaca channel kontrol
+    uint fill;                         // Set tujuan DMA penerima
+    volatile uint16_t last_sequence;   // Nomor urut frame terakhir yang diterima
+    volatile uint32_t frames;          // Frame yang diterima
+    volatile uint32_t rejected;        // Frame yang ditolak (magic/checksum)
+    sg_state state;
+} sg_spi_instance;
+
+// -- API --
+bool sg_spi_init(sg_spi_instance *t, PIO pio, uint pin_base, sg_instance *gen);
+void sg_spi_deinit(sg_spi_instance *t);
+bool sg_spi_start(sg_spi_instance *t);
+void sg_spi_stop(sg_spi_instance *t);
+bool sg_spi_encode_frame(const sg_instance *gen, const sg_timing_config *timing, uint16_t sequence,
+                         uint8_t frame[SG_SPI_FRAME_BYTES]);
+
+#endif
@@ -0,0 +1,337 @@
+/**
+ * Implementasi sinkronisasi master/slave antar board generator.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "signal_sync.h"
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "signal_sync.pio.h" // Header yang di-generate otomatis
+
+// Siklus tambahan di batas periode per peran, dikurangkan dari delay event D
+// Master: delay [3] pada mov. Slave re-align: wait 0 dan wait 1 yang lolos,
+// ditambah margin drift yang dihitung per konfigurasi.
+#define MASTER_BOUNDARY_CYCLES (SG_SYNC_LEAD_CYCLES - 1)
+#define ALIGN_BOUNDARY_CYCLES 2
+
+// -- Program PIO yang Dimuat per Blok PIO --
+// Indeks 0 = master, 1 = slave (start-only dan re-align memakai program sama)
+static struct
+{
+    uint offset;
+    uint users;
+} loaded_program[NUM_PIOS][2];
+
+static inline bool is_master(const sg_sync_instance *s)
+{
+    return s->role == SG_SYNC_MASTER;
+}
+
+static inline const pio_program_t *program_of(sg_sync_role role)
+{
+    return role == SG_SYNC_MASTER ? &signal_sync_master_program : &signal_sync_slave_program;
+}
+
+/**
+ * @brief Menginisialisasi instance: memuat program peran, mengklaim state
+ *        machine, dan mengkonfigurasi pin output serta pin sync.
+ *
+ * Di slave pin sync hanya dibaca, jadi fungsinya tidak diubah dan harus
+ * sudah dikonfigurasi sebagai input oleh pemanggil.
+ *
+ * @param s Instance yang akan diinisialisasi
+ * @param pio Instance PIO yang akan digunakan (pio0 atau pio1)
+ * @param pin_base Pin pertama dari SG_NUM_PINS pin output berurutan
+ * @param sync_pin GPIO sync-out (master) atau sync-in (slave)
+ * @param role Peran board
+ * @return false jika peran tidak valid, atau tidak ada state machine atau
+ *         instruction memory yang tersisa
+ */
+bool sg_sync_init(sg_sync_instance *s, PIO pio, uint pin_base, uint sync_pin, sg_sync_role role)
+{
+    if ((uint)role >= SG_SYNC_NUM_ROLES)
+    {
+        return false;
+    }
+    int sm = pio_claim_unused_sm(pio, false);
+    if (sm < 0)
+    {
+        return false;
+    }
+
+    uint pio_index = pio_get_index(pio);
+    uint kind = role == SG_SYNC_MASTER ? 0 : 1;
+    const pio_program_t *program = program_of(role);
+    if (loaded_program[pio_index][kind].users == 0)
+    {
+        if (!pio_can_add_program(pio, program))
+        {
+            pio_sm_unclaim(pio, (uint)sm);
+            return false;
+        }
+        loaded_program[pio_index][kind].offset = pio_add_program(pio, program);
+    }
+    loaded_program[pio_index][kind].users++;
+
+    s->pio = pio;
+    s->sm = (uint)sm;
+    s->offset = loaded_program[pio_index][kind].offset;
+    s->pin_base = pin_base;
+    s->sync_pin = sync_pin;
+    s->role = role;
+    s->sys_clk_hz = 0;
+    s->dma_chan[0] = -1;
+    s->dma_chan[1] = -1;
+    for (uint i = 0; i < SG_NUM_EVENTS; ++i)
+    {
+        s->ring[i] = 0;
+    }
+
+    pio_sm_config c;
+    if (is_master(s))
+    {
+        c = signal_sync_master_program_get_default_config(s->offset);
+        sm_config_set_sideset_pins(&c, sync_pin);
+        pio_gpio_init(pio, sync_pin);
+        pio_sm_set_consecutive_pindirs(pio, s->sm, sync_pin, 1, true);
+    }
+    else
+    {
+        c = signal_sync_slave_program_get_default_config(s->offset);
+        sm_config_set_in_pins(&c, sync_pin);
+    }
+    sm_config_set_set_pins(&c, pin_base, SG_NUM_PINS);
+    for (uint i = 0; i < SG_NUM_PINS; ++i)
+    {
+        pio_gpio_init(pio, pin_base + i);
+    }
+    pio_sm_set_consecutive_pindirs(pio, s->sm, pin_base, SG_NUM_PINS, true);
+    pio_sm_init(pio, s->sm, s->offset, &c);
+
+    s->state = SG_STATE_READY;
+    return true;
+}
+
+/**
+ * @brief Menghentikan instance dan melepaskan state machine, channel DMA,
+ *        dan program PIO.
+ *
+ * @param s Instance yang akan dilepas
+ */
+void sg_sync_deinit(sg_sync_instance *s)
+{
+    if (s->state == SG_STATE_UNINIT)
+    {
+        return;
+    }
+    sg_sync_stop(s);
+    pio_sm_unclaim(s->pio, s->sm);
+    for (uint i = 0; i < 2; ++i)
+    {
+        if (s->dma_chan[i] >= 0)
+        {
+            dma_channel_unclaim((uint)s->dma_chan[i]);
+            s->dma_chan[i] = -1;
+        }
+    }
+
+    uint pio_index = pio_get_index(s->pio);
+    uint kind = is_master(s) ? 0 : 1;
+    if (--loaded_program[pio_index][kind].users == 0)
+    {
+        pio_remove_program(s->pio, program_of(s->role), s->offset);
+    }
+    s->state = SG_STATE_UNINIT;
+}
+
+/**
+ * @brief Menerapkan konfigurasi timing ke instance yang sedang berhenti.
+ *
+ * Semua board dalam satu grup harus memakai timing yang sama.
+ *
+ * @param s Instance sinkron
+ * @param timing Parameter timing (sama dengan generator klasik)
+ * @return false jika instance berjalan, parameter tidak valid, atau delay
+ *         event D terlalu pendek untuk overhead batas periode peran
+ */
+bool sg_sync_configure(sg_sync_instance *s, const sg_timing_config *timing)
+{
+    if (s->state == SG_STATE_UNINIT || s->state == SG_STATE_RUNNING)
+    {
+        return false;
+    }
+    uint32_t sys_clk_hz = clock_get_hz(clk_sys);
+    uint32_t delays[SG_NUM_EVENTS];
+    if (!sg_calculate_delays((float)sys_clk_hz, timing, delays))
+    {
+        return false;
+    }
+
+    uint32_t boundary = 0;
+    if (s->role == SG_SYNC_MASTER)
+    {
+        boundary = MASTER_BOUNDARY_CYCLES;
+    }
+    else if (s->role == SG_SYNC_SLAVE_ALIGN)
+    {
+        // Slave harus selesai sebelum edge sync berikutnya walaupun clock-nya
+        // lebih lambat dari master
+        double period_cycles = (double)sys_clk_hz / timing->pio_clk_div / timing->frequency_hz;
+        boundary = ALIGN_BOUNDARY_CYCLES + (uint32_t)(period_cycles * SG_SYNC_DRIFT_PPM * 1e-6) + 1;
+    }
+    if (delays[3] < boundary)
+    {
+        return false;
+    }
+
+    s->timing = *timing;
+    s->sys_clk_hz = sys_clk_hz;
+    for (uint i = 0; i < SG_NUM_EVENTS; ++i)
+    {
+        s->ring[i] = delays[i];
+    }
+    s->ring[3] -= boundary;
+    pio_sm_set_clkdiv(s->pio, s->sm, timing->pio_clk_div);
+    s->state = SG_STATE_IDLE;
+    return true;
+}
+
+/**
+ * @brief Menjalankan instance; setelah ini PIO dan DMA berjalan sendiri.
+ *
+ * Master langsung mengeluarkan periode pertama beserta pulsa sync; slave
+ * menunggu edge naik sync.
+ *
+ * @param s Instance dalam state SG_STATE_IDLE
+ * @return false jika belum dikonfigurasi, sedang berjalan, atau tidak ada
+ *         channel DMA yang tersisa
+ */
+bool sg_sync_start(sg_sync_instance *s)
+{
+    if (s->state != SG_STATE_IDLE)
+    {
+        return false;
+    }
+    for (uint i = 0; i < 2; ++i)
+    {
+        if (s->dma_chan[i] < 0)
+        {
+            s->dma_chan[i] = dma_claim_unused_channel(false);
+            if (s->dma_chan[i] < 0)
+            {
+                return false;
+            }
+        }
+    }
+
+    PIO pio = s->pio;
+    uint entry;
+    uint wrap_target;
+    uint wrap;
+    if (is_master(s))
+    {
+        entry = signal_sync_master_offset_period_start;
+        wrap_target = signal_sync_master_offset_period_start;
+        wrap = signal_sync_master_wrap;
+    }
+    else
+    {
+        entry = signal_sync_slave_offset_align;
+        wrap_target = s->role == SG_SYNC_SLAVE_ALIGN ? signal_sync_slave_offset_align
+                                                     : signal_sync_slave_offset_period_start;
+        wrap = signal_sync_slave_wrap;
+    }
+    pio_sm_clear_fifos(pio, s->sm);
+    pio_sm_restart(pio, s->sm);
+    pio_sm_set_wrap(pio, s->sm, s->offset + wrap_target, s->offset + wrap);
+    pio_sm_exec(pio, s->sm, pio_encode_jmp(s->offset + entry));
+
+    // Satu periode per channel; ring baca 16 byte memutar keempat delay
+    for (uint i = 0; i < 2; ++i)
+    {
+        uint chan = (uint)s->dma_chan[i];
+        dma_channel_config c = dma_channel_get_default_config(chan);
+        channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+        channel_config_set_read_increment(&c, true);
+        channel_config_set_write_increment(&c, false);
+        channel_config_set_ring(&c, false, 4);
+        channel_config_set_dreq(&c, pio_get_dreq(pio, s->sm, true));
+        channel_config_set_chain_to(&c, (uint)s->dma_chan[i ^ 1u]);
+        dma_channel_configure(chan, &c, &pio->txf[s->sm], s->ring, SG_NUM_EVENTS, false);
+    }
+
+    // FIFO terisi satu periode sebelum state machine diaktifkan
+    dma_channel_start((uint)s->dma_chan[0]);
+    s->state = SG_STATE_RUNNING;
+    pio_sm_set_enabled(pio, s->sm, true);
+    return true;
+}
+
+/**
+ * @brief Menghentikan instance dan menahan output LOW.
+ *
+ * Master menyelesaikan periode yang sedang berjalan lebih dulu (paling lama
+ * satu periode) sehingga slave re-align juga berakhir dengan periode utuh
+ * dan berhenti sendiri di `wait` berikutnya. Slave berhenti seketika.
+ *
+ * @param s Instance sinkron
+ */
+void sg_sync_stop(sg_sync_instance *s)
+{
+    if (s->state != SG_STATE_RUNNING)
+    {
+        return;
+    }
+    PIO pio = s->pio;
+    if (is_master(s))
+    {
+        // wrap_target = halt: akhir event D melompat ke loop diam dengan sync LOW
+        uint halt = s->offset + signal_sync_master_offset_halt;
+        pio_sm_set_wrap(pio, s->sm, halt, s->offset + signal_sync_master_wrap);
+        uint64_t timeout_us = (uint64_t)(2e6f / s->timing.frequency_hz) + 10;
+        uint64_t start_us = time_us_64();
+        while (pio_sm_get_pc(pio, s->sm) != halt && time_us_64() - start_us < timeout_us)
+        {
+            tight_loop_contents();
+        }
+    }
+    pio_sm_set_enabled(pio, s->sm, false);
+
+    // Putus chain dulu agar abort satu channel tidak memicu pasangannya
+    for (uint i = 0; i < 2; ++i)
+    {
+        dma_channel_config c = dma_get_channel_config((uint)s->dma_chan[i]);
+        channel_config_set_chain_to(&c, (uint)s->dma_chan[i]);
+        dma_channel_set_config((uint)s->dma_chan[i], &c, false);
+    }
+    dma_channel_abort((uint)s->dma_chan[0]);
+    dma_channel_abort((uint)s->dma_chan[1]);
+    pio_sm_clear_fifos(pio, s->sm);
+
+    uint32_t pin_mask = ((1u << SG_NUM_PINS) - 1u) << s->pin_base;
+    if (is_master(s))
+    {
+        pin_mask |= 1u << s->sync_pin;
+    }
+    pio_sm_set_pins_with_mask(pio, s->sm, 0, pin_mask);
+    s->state = SG_STATE_IDLE;
+}
+
+/**
+ * @brief Mengeluarkan clk_sys / div ke pin GPOUT sebagai clock referensi
+ *        untuk board lain.
+ *
+ * @param gpio Pin GPOUT (21, 23, 24 atau 25)
+ * @param div Pembagi clk_sys (>= 1)
+ * @return false jika gpio bukan pin GPOUT atau div tidak valid
+ */
+bool sg_sync_ref_clock_out(uint gpio, float div)
+{
+    if ((gpio != 21 && gpio != 23 && gpio != 24 && gpio != 25) || div < 1.0f)
+    {
+        return false;
+    }
+    clock_gpio_init(gpio, CLOCKS_CLK_GPOUT0_CTRL_AUXSRC_VALUE_CLK_SYS, div);
+    return true;
+}
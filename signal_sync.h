@@ -0,0 +1,79 @@
+/**
+ * Sinkronisasi beberapa board generator lewat pin sync-in/sync-out.
+ *
+ *   SG_SYNC_MASTER        mengeluarkan pulsa sync di awal burst dan di setiap
+ *                         periode (HIGH selama event A), opsional juga clock
+ *                         referensi lewat sg_sync_ref_clock_out()
+ *   SG_SYNC_SLAVE_START   menunggu edge sync pertama dengan `wait`, lalu
+ *                         berjalan bebas dengan clock sendiri
+ *   SG_SYNC_SLAVE_ALIGN   menunggu edge sync di setiap periode, sehingga
+ *                         drift clock antar board tidak terakumulasi dan
+ *                         burst slave berakhir bersama master
+ *
+ * Master menaikkan sync SG_SYNC_LEAD_CYCLES siklus PIO sebelum edge CH1-nya
+ * sendiri, sama dengan latensi slave dari sampling pertama yang melihat sync.
+ * Karena slave baru mengambil sampel pada siklus PIO berikutnya, edge CH1
+ * slave jatuh kurang dari satu siklus PIO slave sebelum edge master (tepat
+ * bersamaan jika clock PIO keduanya sejalan), ditambah sinkronisasi input
+ * GPIO (sekitar 2 siklus clk_sys) dan delay kabel. Pada mode re-align
+ * event D slave diperpendek SG_SYNC_DRIFT_PPM dari periode agar slave selalu
+ * sudah menunggu sebelum edge sync berikutnya.
+ *
+ * Delay diputar DMA dari ring 4 word seperti signal_burst, sehingga master
+ * maupun slave tidak membutuhkan CPU selama berjalan. Token periode tetap
+ * didorong ke FIFO RX (lihat sg_count_start_sm()).
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef SIGNAL_SYNC_H
+#define SIGNAL_SYNC_H
+
+#include "signal_gen.h"
+
+/**
+ * @brief Peran board dalam grup sinkron.
+ */
+typedef enum
+{
+    SG_SYNC_MASTER = 0,
+    SG_SYNC_SLAVE_START,
+    SG_SYNC_SLAVE_ALIGN,
+    SG_SYNC_NUM_ROLES,
+} sg_sync_role;
+
+// Jarak edge sync -> edge CH1 dalam siklus PIO, untuk master (mov [3], set)
+// maupun slave (wait, pull, mov, set)
+#define SG_SYNC_LEAD_CYCLES 4
+
+// Toleransi selisih clock antar board untuk mode re-align (dua kristal
+// +-100 ppm)
+#define SG_SYNC_DRIFT_PPM 200
+
+/**
+ * @brief Satu generator yang tergabung dalam grup sinkron.
+ */
+typedef struct
+{
+    PIO pio;                          // Blok PIO yang digunakan
+    uint sm;                          // Nomor state machine
+    uint offset;                      // Offset program master/slave
+    uint pin_base;                    // Pin pertama dari SG_NUM_PINS pin output
+    uint sync_pin;                    // Pin sync: output di master, input di slave
+    sg_sync_role role;
+    sg_timing_config timing;          // Konfigurasi timing aktif
+    uint32_t sys_clk_hz;              // clk_sys yang dipakai untuk menghitung delay
+    uint32_t ring[SG_NUM_EVENTS] __attribute__((aligned(SG_NUM_EVENTS * sizeof(uint32_t))));
+    int dma_chan[2];                  // Channel DMA ping-pong untuk ring delay
+    sg_state state;
+} sg_sync_instance;
+
+// -- API --
+bool sg_sync_init(sg_sync_instance *s, PIO pio, uint pin_base, uint sync_pin, sg_sync_role role);
+void sg_sync_deinit(sg_sync_instance *s);
+bool sg_sync_configure(sg_sync_instance *s, const sg_timing_config *timing);
+bool sg_sync_start(sg_sync_instance *s);
+void sg_sync_stop(sg_sync_instance *s);
+bool sg_sync_ref_clock_out(uint gpio, float div);
+
+#endif
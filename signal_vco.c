@@ -0,0 +1,286 @@
+/**
+ * Implementasi mode VCO: ring sampel ADC lewat DMA dan tabel event D per kode.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <math.h>
+
+#include "signal_vco.h"
+#include "hardware/adc.h"
+#include "hardware/clocks.h"
+
+#define ADC_GPIO_BASE 26 // AIN0
+
+// Transfer per channel sebelum chain ke pasangannya; kelipatan SG_VCO_WINDOW
+// agar penulisan selalu berlanjut di awal ring (~36 menit pada 500 kS/s)
+#define VCO_DMA_COUNT (1u << 30)
+
+/**
+ * @brief Frekuensi hasil pemetaan untuk satu kode ADC dan kalibrasi tertentu.
+ */
+static float map_frequency(const sg_vco_config *config, uint code)
+{
+    float x = ((float)code - (float)config->code_min) / (float)(config->code_max - config->code_min);
+    x = x < 0.0f ? 0.0f : x > 1.0f ? 1.0f : x;
+    if (config->curve == SG_VCO_EXPONENTIAL)
+    {
+        return config->f_min_hz * powf(config->f_max_hz / config->f_min_hz, x);
+    }
+    return config->f_min_hz + x * (config->f_max_hz - config->f_min_hz);
+}
+
+/**
+ * @brief Mengisi tabel event D untuk konfigurasi baru.
+ *
+ * Kedua ujung rentang diperiksa lebih dulu sehingga tabel lama tetap utuh
+ * jika pulsa tidak muat. Frekuensi monoton terhadap kode, jadi ujung yang
+ * lolos menjamin semua kode di antaranya lolos.
+ *
+ * @return false jika pulsa dan jeda tidak muat pada salah satu ujung
+ */
+static bool build_table(sg_vco_instance *vco, const sg_vco_config *config)
+{
+    sg_instance *gen = vco->gen;
+    float sys_clk_hz = (float)((double)gen->sys_clk_hz * (1.0 + gen->clock_ppm * 1e-6));
+    sg_timing_config timing = gen->timing;
+    uint32_t delays[SG_NUM_EVENTS];
+    const uint ends[2] = {config->code_min, config->code_max};
+    for (uint i = 0; i < 2; ++i)
+    {
+        timing.frequency_hz = map_frequency(config, ends[i]);
+        if (!sg_calculate_delays(sys_clk_hz, &timing, delays))
+        {
+            return false;
+        }
+    }
+
+    for (uint code = 0; code < SG_VCO_CODES; ++code)
+    {
+        timing.frequency_hz = map_frequency(config, code);
+        sg_calculate_delays(sys_clk_hz, &timing, delays);
+        vco->delay_d[code] = delays[SG_NUM_EVENTS - 1];
+    }
+    vco->config = *config;
+    return true;
+}
+
+/**
+ * @brief Kode rata-rata jendela ring sampel.
+ *
+ * Di-inline paksa agar jalur sg_vco_service() di SRAM tidak memanggil ke flash.
+ */
+static __force_inline uint window_code(const sg_vco_instance *vco)
+{
+    uint32_t sum = 0;
+    for (uint i = 0; i < SG_VCO_WINDOW; ++i)
+    {
+        sum += vco->samples[i];
+    }
+    return sum >> SG_VCO_WINDOW_BITS;
+}
+
+/**
+ * @brief Menyiapkan VCO untuk generator yang sudah dikonfigurasi.
+ *
+ * Lebar pulsa, jeda dan clock divider diambil dari konfigurasi generator;
+ * hanya frekuensinya yang dikendalikan input. Pin input dialihkan ke ADC.
+ *
+ * @param vco Instance VCO
+ * @param gen Generator klasik yang sudah sg_configure() dan berhenti
+ * @param config Input, laju sampel, pemetaan dan kalibrasi
+ * @return false jika konfigurasi tidak valid atau pulsa tidak muat pada
+ *         frekuensi tertinggi
+ */
+bool sg_vco_init(sg_vco_instance *vco, sg_instance *gen, const sg_vco_config *config)
+{
+    if (gen->state == SG_STATE_UNINIT || gen->state == SG_STATE_READY || config->adc_input >= 4 ||
+        config->sample_rate_hz == 0 || config->sample_rate_hz > SG_VCO_MAX_SAMPLE_RATE_HZ ||
+        config->f_min_hz <= 0.0f || config->f_max_hz <= 0.0f || config->code_min >= config->code_max ||
+        config->code_max >= SG_VCO_CODES)
+    {
+        return false;
+    }
+    vco->gen = gen;
+    vco->dma_chan[0] = -1;
+    vco->dma_chan[1] = -1;
+    vco->current_d = 0;
+    vco->code = 0;
+    vco->updates = 0;
+    for (uint i = 0; i < SG_VCO_WINDOW; ++i)
+    {
+        vco->samples[i] = 0;
+    }
+    if (!build_table(vco, config))
+    {
+        return false;
+    }
+
+    adc_init();
+    adc_gpio_init(ADC_GPIO_BASE + config->adc_input);
+    return true;
+}
+
+/**
+ * @brief Mengganti kalibrasi kode minimum/maksimum dan membangun ulang tabel.
+ *
+ * Boleh dipanggil saat berjalan: setiap entri ditulis utuh, jadi pembacaan
+ * di tengah pembangunan ulang memakai nilai lama atau baru, tidak pernah
+ * campuran. Tidak untuk jalur real-time (float per kode).
+ *
+ * @param vco Instance VCO yang sudah di-init
+ * @param code_min Kode rata-rata pada tegangan minimum (sg_vco_code())
+ * @param code_max Kode rata-rata pada tegangan maksimum
+ * @return false jika code_min >= code_max atau pulsa tidak muat
+ */
+bool sg_vco_set_calibration(sg_vco_instance *vco, uint16_t code_min, uint16_t code_max)
+{
+    if (code_min >= code_max || code_max >= SG_VCO_CODES)
+    {
+        return false;
+    }
+    sg_vco_config config = vco->config;
+    config.code_min = code_min;
+    config.code_max = code_max;
+    return build_table(vco, &config);
+}
+
+/**
+ * @brief Menjalankan ADC, DMA ring dan generator.
+ *
+ * Ring diisi lebih dulu dari satu konversi tunggal sehingga periode pertama
+ * sudah mengikuti tegangan input.
+ *
+ * @param vco Instance VCO yang sudah di-init
+ * @return false jika sudah berjalan, generator tidak berhenti, atau tidak
+ *         ada channel DMA yang tersisa
+ */
+bool sg_vco_start(sg_vco_instance *vco)
+{
+    if (sg_vco_is_running(vco) || vco->gen->state != SG_STATE_IDLE)
+    {
+        return false;
+    }
+    int chan[2];
+    chan[0] = dma_claim_unused_channel(false);
+    chan[1] = chan[0] < 0 ? -1 : dma_claim_unused_channel(false);
+    if (chan[1] < 0)
+    {
+        if (chan[0] >= 0)
+        {
+            dma_channel_unclaim((uint)chan[0]);
+        }
+        return false;
+    }
+
+    // Konversi tunggal untuk ring awal, sebelum FIFO ADC diaktifkan
+    adc_run(false);
+    adc_fifo_setup(false, false, 0, false, false);
+    adc_select_input(vco->config.adc_input);
+    adc_set_round_robin(1u << vco->config.adc_input);
+    float div = (float)clock_get_hz(clk_adc) / (float)vco->config.sample_rate_hz - 1.0f;
+    adc_set_clkdiv(div > 0.0f ? div : 0.0f);
+    uint16_t first = adc_read();
+    for (uint i = 0; i < SG_VCO_WINDOW; ++i)
+    {
+        vco->samples[i] = first;
+    }
+    adc_fifo_drain();
+    adc_fifo_setup(true, true, 1, false, false);
+
+    for (uint k = 0; k < 2; ++k)
+    {
+        dma_channel_config c = dma_channel_get_default_config((uint)chan[k]);
+        channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+        channel_config_set_read_increment(&c, false);
+        channel_config_set_write_increment(&c, true);
+        // Ring SG_VCO_WINDOW x 16 bit
+        channel_config_set_ring(&c, true, SG_VCO_WINDOW_BITS + 1);
+        channel_config_set_dreq(&c, DREQ_ADC);
+        channel_config_set_chain_to(&c, (uint)chan[k ^ 1u]);
+        dma_channel_configure((uint)chan[k], &c, vco->samples, &adc_hw->fifo, VCO_DMA_COUNT, false);
+    }
+    vco->dma_chan[0] = chan[0];
+    vco->dma_chan[1] = chan[1];
+    dma_channel_start((uint)chan[0]);
+    adc_run(true);
+
+    vco->code = window_code(vco);
+    vco->current_d = vco->delay_d[vco->code];
+    sg_stage_delay_d(vco->gen, vco->current_d);
+    sg_start(vco->gen);
+    return true;
+}
+
+/**
+ * @brief Memperbarui event D dari input lalu mengisi FIFO generator.
+ *
+ * Tidak blocking dan tanpa float: rata-rata ring, satu lookup tabel dan,
+ * jika nilainya berubah, sg_stage_delay_d(). Panggil dari loop utama
+ * setidaknya sekali per periode pada f_max.
+ *
+ * @param vco Instance VCO yang sedang berjalan
+ * @return Jumlah event yang dikirim ke FIFO (lihat sg_service())
+ */
+uint __time_critical_func(sg_vco_service)(sg_vco_instance *vco)
+{
+    uint code = window_code(vco);
+    uint32_t delay_d = vco->delay_d[code];
+    vco->code = code;
+    if (delay_d != vco->current_d)
+    {
+        sg_stage_delay_d(vco->gen, delay_d);
+        vco->current_d = delay_d;
+        vco->updates++;
+    }
+    return sg_service(vco->gen);
+}
+
+/**
+ * @brief Menghentikan generator, ADC dan DMA ring.
+ *
+ * @param vco Instance VCO
+ */
+void sg_vco_stop(sg_vco_instance *vco)
+{
+    if (!sg_vco_is_running(vco))
+    {
+        return;
+    }
+    sg_stop(vco->gen);
+    adc_run(false);
+    for (uint k = 0; k < 2; ++k)
+    {
+        dma_channel_abort((uint)vco->dma_chan[k]);
+        dma_channel_unclaim((uint)vco->dma_chan[k]);
+        vco->dma_chan[k] = -1;
+    }
+    adc_fifo_setup(false, false, 0, false, false);
+    adc_fifo_drain();
+}
+
+/**
+ * @brief Kode ADC rata-rata saat ini, untuk kalibrasi.
+ *
+ * @param vco Instance VCO yang sedang berjalan
+ * @return Rata-rata SG_VCO_WINDOW sampel terakhir (0..4095)
+ */
+uint sg_vco_code(const sg_vco_instance *vco)
+{
+    return window_code(vco);
+}
+
+/**
+ * @brief Frekuensi nominal untuk sebuah kode ADC menurut pemetaan aktif.
+ *
+ * Frekuensi yang benar-benar keluar adalah periode bilangan bulat siklus PIO
+ * dari tabel, jadi bisa berbeda sedikit dari nilai ini.
+ *
+ * @param vco Instance VCO yang sudah di-init
+ * @param code Kode ADC 0..4095
+ * @return Frekuensi (Hz)
+ */
+float sg_vco_frequency(const sg_vco_instance *vco, uint code)
+{
+    return map_frequency(&vco->config, code);
+}
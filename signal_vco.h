@@ -0,0 +1,93 @@
+/**
+ * Mode VCO: tegangan di input ADC mengatur frekuensi generator secara real time.
+ *
+ * ADC berjalan free-running (round robin satu input) pada sample_rate_hz dan
+ * dua channel DMA ping-pong (saling chain, DREQ_ADC) menulis setiap sampel ke
+ * ring SG_VCO_WINDOW sampel tanpa pernah membangunkan CPU. sg_vco_service()
+ * merata-rata ring itu, mengambil nilai N event D dari tabel per kode ADC, dan
+ * jika berubah menyerahkannya ke sg_stage_delay_d() sebelum mengisi FIFO
+ * lewat sg_service(). Tidak ada perhitungan float maupun blocking di jalur
+ * ini, jadi loop yang sama tetap menjaga FIFO generator terisi.
+ *
+ * Tabel dibangun sekali dengan sg_calculate_delays() (termasuk trim
+ * sg_trim_clock() yang aktif) untuk setiap kode 0..4095: kode dipetakan ke
+ * x = (kode - code_min) / (code_max - code_min), dibatasi ke 0..1, lalu ke
+ * frekuensi linear f_min + x (f_max - f_min) atau eksponensial
+ * f_min (f_max / f_min)^x (1 V/oktaf bila rentangnya dipilih sesuai). Event
+ * A..C tetap, jadi lebar pulsa dan jeda tidak ikut berubah.
+ *
+ * Latensi: rata-rata jendela SG_VCO_WINDOW / sample_rate_hz, ditambah satu
+ * sampai dua periode karena FIFO TX sudah berisi hingga satu periode saat
+ * event D baru di-stage. Loop pemanggil harus memanggil sg_vco_service()
+ * setidaknya sekali per periode pada f_max.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef SIGNAL_VCO_H
+#define SIGNAL_VCO_H
+
+#include "signal_gen.h"
+#include "hardware/dma.h"
+
+#define SG_VCO_CODES 4096     // Kode ADC 12 bit
+#define SG_VCO_WINDOW_BITS 4  // Sampel dirata-rata per pembacaan = 2^bits
+#define SG_VCO_WINDOW (1u << SG_VCO_WINDOW_BITS)
+#define SG_VCO_MAX_SAMPLE_RATE_HZ 500000u
+
+/**
+ * @brief Pemetaan posisi input ke frekuensi.
+ */
+typedef enum
+{
+    SG_VCO_LINEAR = 0,  // f = f_min + x (f_max - f_min)
+    SG_VCO_EXPONENTIAL, // f = f_min (f_max / f_min)^x
+} sg_vco_curve;
+
+/**
+ * @brief Konfigurasi input dan pemetaan VCO.
+ */
+typedef struct
+{
+    uint adc_input;          // Input ADC 0..3 (GPIO 26..29)
+    uint32_t sample_rate_hz; // Laju sampel ADC, maksimum SG_VCO_MAX_SAMPLE_RATE_HZ
+    sg_vco_curve curve;
+    float f_min_hz;          // Frekuensi pada code_min
+    float f_max_hz;          // Frekuensi pada code_max
+    uint16_t code_min;       // Kalibrasi: kode rata-rata pada tegangan minimum
+    uint16_t code_max;       // Kalibrasi: kode rata-rata pada tegangan maksimum
+} sg_vco_config;
+
+/**
+ * @brief Satu instance VCO yang mengendalikan satu generator klasik.
+ */
+typedef struct
+{
+    sg_instance *gen;
+    sg_vco_config config;
+    int dma_chan[2];                  // Channel ADC -> ring, -1 jika tidak berjalan
+    uint32_t current_d;               // Nilai event D terakhir yang di-stage
+    uint code;                        // Kode rata-rata terakhir
+    uint32_t updates;                 // Jumlah perubahan event D yang di-stage
+    uint32_t delay_d[SG_VCO_CODES];   // Nilai N event D per kode ADC
+    volatile uint16_t samples[SG_VCO_WINDOW] __attribute__((aligned(SG_VCO_WINDOW * sizeof(uint16_t))));
+} sg_vco_instance;
+
+// -- API --
+bool sg_vco_init(sg_vco_instance *vco, sg_instance *gen, const sg_vco_config *config);
+bool sg_vco_set_calibration(sg_vco_instance *vco, uint16_t code_min, uint16_t code_max);
+bool sg_vco_start(sg_vco_instance *vco);
+uint sg_vco_service(sg_vco_instance *vco);
+void sg_vco_stop(sg_vco_instance *vco);
+uint sg_vco_code(const sg_vco_instance *vco);
+float sg_vco_frequency(const sg_vco_instance *vco, uint code);
+
+/**
+ * @brief Memeriksa apakah VCO sedang berjalan.
+ */
+static inline bool sg_vco_is_running(const sg_vco_instance *vco)
+{
+    return vco->dma_chan[0] >= 0;
+}
+
+#endif
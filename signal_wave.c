@@ -0,0 +1,705 @@
+/**
+ * Implementasi library tabel event di flash dan player stream XIP.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "signal_wave.h"
+#include "hardware/flash.h"
+#include "hardware/irq.h"
+#include "hardware/structs/xip_ctrl.h"
+#include "hardware/sync.h"
+#include "pico/flash.h"
+
+#define ENTRY_MAGIC 0x31574753u // "SGW1"
+#define FLASH_TIMEOUT_MS 100    // Batas tunggu core 1 masuk lockout
+#define MAX_PLAYERS (NUM_DMA_CHANNELS / 3)
+
+/**
+ * @brief Satu entri direktori; slot kosong tetap 0xFF.
+ */
+typedef struct
+{
+    uint32_t magic;
+    uint32_t offset; // Relatif terhadap awal region, kelipatan sektor
+    uint32_t words;
+    uint32_t data_crc;
+    char name[SG_WAVE_NAME_MAX];
+    uint32_t crc; // CRC-32 semua byte sebelumnya
+} entry;
+
+_Static_assert(sizeof(entry) == 32, "entri direktori harus 32 byte");
+_Static_assert(SG_WAVE_MAX_TABLES * sizeof(entry) <= FLASH_SECTOR_SIZE, "direktori harus muat satu sektor");
+_Static_assert(SG_WAVE_FLASH_SIZE % FLASH_SECTOR_SIZE == 0, "region harus kelipatan sektor");
+
+/**
+ * @brief Operasi flash yang dijalankan flash_safe_execute().
+ */
+typedef struct
+{
+    uint32_t offset;
+    const uint8_t *data; // NULL = erase satu sektor
+} flash_op;
+
+// -- Player Aktif yang Dilayani Handler DMA_IRQ_0 --
+// Handler dipasang oleh player pertama dan dilepas oleh yang terakhir
+static sg_wave_player *active_players[MAX_PLAYERS];
+static uint active_count;
+
+// -- Helper --
+
+/**
+ * @brief Langkah CRC-32 (polinom 0xEDB88320) dengan tabel per nibble, tanpa
+ *        inversi awal/akhir sehingga bisa dilanjutkan per potongan.
+ */
+static uint32_t crc32_update(uint32_t crc, const void *data, size_t len)
+{
+    static const uint32_t table[16] = {
+        0x00000000u, 0x1DB71064u, 0x3B6E20C8u, 0x26D930ACu, 0x76DC4190u, 0x6B6B51F4u, 0x4DB26158u, 0x5005713Cu,
+        0xEDB88320u, 0xF00F9344u, 0xD6D6A3E8u, 0xCB61B38Cu, 0x9B64C2B0u, 0x86D3D2D4u, 0xA00AE278u, 0xBDBDF21Cu,
+    };
+    const uint8_t *p = data;
+    for (size_t i = 0; i < len; ++i)
+    {
+        crc ^= p[i];
+        crc = (crc >> 4) ^ table[crc & 0xFu];
+        crc = (crc >> 4) ^ table[crc & 0xFu];
+    }
+    return crc;
+}
+
+static uint32_t crc32(const void *data, size_t len)
+{
+    return ~crc32_update(0xFFFFFFFFu, data, len);
+}
+
+static const entry *entry_at(uint index)
+{
+    return (const entry *)(XIP_BASE + SG_WAVE_FLASH_OFFSET + index * sizeof(entry));
+}
+
+static uint32_t sector_align_up(uint32_t offset)
+{
+    return (offset + FLASH_SECTOR_SIZE - 1u) & ~(FLASH_SECTOR_SIZE - 1u);
+}
+
+static bool is_blank(const void *data, size_t len)
+{
+    const uint8_t *p = data;
+    for (size_t i = 0; i < len; ++i)
+    {
+        if (p[i] != 0xFFu)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool entry_valid(const entry *e)
+{
+    return e->magic == ENTRY_MAGIC && e->crc == crc32(e, offsetof(entry, crc)) && e->offset >= FLASH_SECTOR_SIZE &&
+           e->offset % FLASH_SECTOR_SIZE == 0 && e->words > 0 && e->words <= SG_WAVE_MAX_WORDS &&
+           e->offset + e->words * sizeof(uint32_t) <= SG_WAVE_FLASH_SIZE;
+}
+
+static void table_from_entry(const entry *e, sg_wave_table *table, char *name)
+{
+    table->offset = e->offset;
+    table->words = e->words;
+    table->crc = e->data_crc;
+    if (name)
+    {
+        memcpy(name, e->name, SG_WAVE_NAME_MAX);
+        name[SG_WAVE_NAME_MAX] = '\0';
+    }
+}
+
+// -- Akses Flash --
+
+static void __no_inline_not_in_flash_func(run_flash_op)(void *param)
+{
+    const flash_op *op = param;
+    if (op->data)
+    {
+        flash_range_program(op->offset, op->data, FLASH_PAGE_SIZE);
+    }
+    else
+    {
+        flash_range_erase(op->offset, FLASH_SECTOR_SIZE);
+    }
+}
+
+/**
+ * @brief Erase (data NULL) atau program satu halaman di region library.
+ *
+ * @return false jika flash_safe_execute() gagal atau ada player yang sedang
+ *         membaca stream XIP
+ */
+static bool flash_write(sg_wave_library *lib, uint32_t offset, const uint8_t *data)
+{
+    if (active_count > 0)
+    {
+        return false;
+    }
+    flash_op op = {.offset = SG_WAVE_FLASH_OFFSET + offset, .data = data};
+    if (flash_safe_execute(run_flash_op, &op, FLASH_TIMEOUT_MS) != PICO_OK)
+    {
+        return false;
+    }
+    if (data)
+    {
+        lib->writes++;
+    }
+    else
+    {
+        lib->erases++;
+    }
+    return true;
+}
+
+/**
+ * @brief Memprogram halaman penulisan yang berisi word terakhir yang diterima;
+ *        sektor di-erase dulu jika halaman itu yang pertama di sektornya.
+ */
+static bool flush_page(sg_wave_library *lib)
+{
+    uint32_t used = (((lib->written - 1u) * sizeof(uint32_t)) % FLASH_PAGE_SIZE) + sizeof(uint32_t);
+    memset(&lib->page[used], 0xFF, FLASH_PAGE_SIZE - used);
+    uint32_t offset = lib->next_offset + ((lib->written - 1u) * sizeof(uint32_t)) / FLASH_PAGE_SIZE * FLASH_PAGE_SIZE;
+    if (offset % FLASH_SECTOR_SIZE == 0 && !flash_write(lib, offset, NULL))
+    {
+        return false;
+    }
+    return flash_write(lib, offset, lib->page);
+}
+
+// -- API Library --
+
+/**
+ * @brief Membangun indeks library dari direktori di flash (hanya baca XIP).
+ *
+ * @param lib Library yang akan diisi
+ */
+void sg_wave_library_init(sg_wave_library *lib)
+{
+    lib->tables = 0;
+    lib->entries = 0;
+    lib->corrupt = 0;
+    lib->next_offset = FLASH_SECTOR_SIZE;
+    lib->writes = 0;
+    lib->erases = 0;
+    lib->writing = false;
+
+    // Entri ditulis berurutan, slot kosong pertama menandai akhir direktori
+    for (uint i = 0; i < SG_WAVE_MAX_TABLES; ++i)
+    {
+        const entry *e = entry_at(i);
+        if (is_blank(e, sizeof(*e)))
+        {
+            break;
+        }
+        lib->entries++;
+        if (!entry_valid(e))
+        {
+            // Listrik padam saat commit: data tabelnya ditimpa penulisan berikutnya
+            lib->corrupt++;
+            continue;
+        }
+        lib->tables++;
+        uint32_t end = sector_align_up(e->offset + e->words * sizeof(uint32_t));
+        if (end > lib->next_offset)
+        {
+            lib->next_offset = end;
+        }
+    }
+}
+
+/**
+ * @brief Mengosongkan library dengan meng-erase sektor direktori.
+ *
+ * Sektor data di-erase nanti saat tabel baru ditulis ke sana.
+ *
+ * @param lib Library
+ * @return false jika operasi flash gagal
+ */
+bool sg_wave_library_format(sg_wave_library *lib)
+{
+    if (!flash_write(lib, 0, NULL))
+    {
+        return false;
+    }
+    uint32_t writes = lib->writes;
+    uint32_t erases = lib->erases;
+    sg_wave_library_init(lib);
+    lib->writes = writes;
+    lib->erases = erases;
+    return true;
+}
+
+/**
+ * @brief Memulai penulisan tabel baru.
+ *
+ * @param lib Library
+ * @param name Nama unik, 1..SG_WAVE_NAME_MAX karakter
+ * @param words Jumlah word event yang akan dikirim lewat sg_wave_library_write()
+ * @return false jika penulisan lain berjalan, nama tidak valid atau sudah
+ *         dipakai, direktori penuh, atau ruang flash tidak cukup
+ */
+bool sg_wave_library_begin(sg_wave_library *lib, const char *name, uint32_t words)
+{
+    size_t len = strlen(name);
+    sg_wave_table existing;
+    if (lib->writing || len == 0 || len > SG_WAVE_NAME_MAX || lib->entries == SG_WAVE_MAX_TABLES || words == 0 ||
+        words > (SG_WAVE_FLASH_SIZE - lib->next_offset) / sizeof(uint32_t) ||
+        sg_wave_library_find(lib, name, &existing))
+    {
+        return false;
+    }
+    memset(lib->name, 0, sizeof(lib->name));
+    memcpy(lib->name, name, len);
+    lib->words = words;
+    lib->written = 0;
+    lib->crc = 0xFFFFFFFFu;
+    lib->writing = true;
+    return true;
+}
+
+/**
+ * @brief Menambahkan potongan word event ke tabel yang sedang ditulis.
+ *
+ * Setiap halaman diprogram begitu penuh, sehingga potongan boleh berukuran
+ * berapa saja dan sumbernya tidak perlu bertahan setelah fungsi kembali.
+ *
+ * @param lib Library dengan penulisan yang berjalan
+ * @param events Word event (SG_SEQ_EVENT)
+ * @param count Jumlah word
+ * @return false jika melebihi jumlah dari begin atau operasi flash gagal
+ *         (penulisan dibatalkan)
+ */
+bool sg_wave_library_write(sg_wave_library *lib, const uint32_t *events, uint32_t count)
+{
+    if (!lib->writing || count > lib->words - lib->written)
+    {
+        return false;
+    }
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        uint32_t pos = (lib->written * sizeof(uint32_t)) % FLASH_PAGE_SIZE;
+        memcpy(&lib->page[pos], &events[i], sizeof(uint32_t));
+        lib->crc = crc32_update(lib->crc, &events[i], sizeof(uint32_t));
+        lib->written++;
+        if ((pos + sizeof(uint32_t) == FLASH_PAGE_SIZE || lib->written == lib->words) && !flush_page(lib))
+        {
+            lib->writing = false;
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Menyelesaikan tabel: entri direktori diprogram ke slot kosong
+ *        berikutnya (tanpa erase). Sebelum entri ini tertulis utuh, tabel
+ *        tidak terlihat oleh sg_wave_library_init().
+ *
+ * @param lib Library dengan penulisan yang semua word-nya sudah diterima
+ * @return false jika word belum lengkap atau operasi flash gagal
+ */
+bool sg_wave_library_commit(sg_wave_library *lib)
+{
+    if (!lib->writing || lib->written != lib->words)
+    {
+        return false;
+    }
+    lib->writing = false;
+
+    entry e = {
+        .magic = ENTRY_MAGIC,
+        .offset = lib->next_offset,
+        .words = lib->words,
+        .data_crc = ~lib->crc,
+    };
+    memcpy(e.name, lib->name, SG_WAVE_NAME_MAX);
+    e.crc = crc32(&e, offsetof(entry, crc));
+
+    // Halaman berisi 0xFF kecuali slot entri baru: entri lain tidak berubah
+    uint32_t pos = lib->entries * sizeof(entry);
+    memset(lib->page, 0xFF, sizeof(lib->page));
+    memcpy(&lib->page[pos % FLASH_PAGE_SIZE], &e, sizeof(e));
+    if (!flash_write(lib, pos / FLASH_PAGE_SIZE * FLASH_PAGE_SIZE, lib->page))
+    {
+        return false;
+    }
+    lib->entries++;
+    lib->tables++;
+    lib->next_offset = sector_align_up(e.offset + e.words * sizeof(uint32_t));
+    return true;
+}
+
+/**
+ * @brief Tabel valid ke-`index` dalam urutan penulisan.
+ *
+ * @param lib Library
+ * @param index 0..lib->tables-1
+ * @param table Hasil
+ * @param name Buffer SG_WAVE_NAME_MAX + 1 untuk nama, boleh NULL
+ * @return false jika index di luar jangkauan
+ */
+bool sg_wave_library_get(const sg_wave_library *lib, uint index, sg_wave_table *table, char *name)
+{
+    for (uint i = 0; i < lib->entries; ++i)
+    {
+        const entry *e = entry_at(i);
+        if (entry_valid(e) && index-- == 0)
+        {
+            table_from_entry(e, table, name);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Mencari tabel berdasarkan nama.
+ *
+ * @return false jika tidak ada
+ */
+bool sg_wave_library_find(const sg_wave_library *lib, const char *name, sg_wave_table *table)
+{
+    size_t len = strlen(name);
+    if (len > SG_WAVE_NAME_MAX)
+    {
+        return false;
+    }
+    for (uint i = 0; i < lib->entries; ++i)
+    {
+        const entry *e = entry_at(i);
+        if (entry_valid(e) && strncmp(e->name, name, SG_WAVE_NAME_MAX) == 0)
+        {
+            table_from_entry(e, table, NULL);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Memeriksa CRC data tabel lewat XIP (membaca seluruh tabel).
+ */
+bool sg_wave_table_verify(const sg_wave_table *table)
+{
+    return crc32(sg_wave_table_data(table), table->words * sizeof(uint32_t)) == table->crc;
+}
+
+// -- Player --
+
+/**
+ * @brief Potongan tabel berikutnya untuk fill, tidak pernah melewati akhir
+ *        tabel; dengan loop dimulai lagi dari word pertama.
+ *
+ * @return Jumlah word, 0 jika tabel habis
+ */
+static uint32_t __time_critical_func(next_chunk)(sg_wave_player *player, uint32_t *start)
+{
+    if (player->fill_pos == player->table.words)
+    {
+        if (!player->loop)
+        {
+            return 0;
+        }
+        player->fill_pos = 0;
+    }
+    uint32_t n = player->table.words - player->fill_pos;
+    if (n > SG_WAVE_CHUNK_WORDS)
+    {
+        n = SG_WAVE_CHUNK_WORDS;
+    }
+    *start = player->fill_pos;
+    player->fill_pos += n;
+    return n;
+}
+
+/**
+ * @brief Memprogram stream XIP untuk satu potongan dan memicu DMA fill ke
+ *        bounce[k]. Stream harus sudah kosong (fill sebelumnya selesai).
+ */
+static void __time_critical_func(start_fill)(sg_wave_player *player, uint k, uint32_t start, uint32_t n)
+{
+    xip_ctrl_hw->stream_addr =
+        XIP_NOCACHE_NOALLOC_BASE + SG_WAVE_FLASH_OFFSET + player->table.offset + start * sizeof(uint32_t);
+    xip_ctrl_hw->stream_ctr = n;
+    dma_channel_set_write_addr((uint)player->fill_chan, player->bounce[k], false);
+    dma_channel_set_trans_count((uint)player->fill_chan, n, true);
+}
+
+/**
+ * @brief Feed k selesai (dan sudah memicu feed k^1 lewat chain): bounce[k]
+ *        diisi potongan berikutnya untuk putaran feed k selanjutnya.
+ */
+static void __time_critical_func(refill)(sg_wave_player *player, uint k)
+{
+    player->queued[k] = 0;
+    if (player->queued[k ^ 1u] == 0)
+    {
+        // Feed k^1 dinonaktifkan: word terakhir tabel sudah di FIFO
+        player->finished = true;
+        player->streaming = false;
+        return;
+    }
+    if (dma_channel_is_busy((uint)player->fill_chan))
+    {
+        // Feed k^1 sudah membaca bagian yang belum selesai diisi
+        sg_seq_stop(player->seq);
+        player->underruns++;
+        player->streaming = false;
+        return;
+    }
+
+    uint32_t start = 0;
+    uint32_t n = next_chunk(player, &start);
+    uint chan = (uint)player->seq->dma_chan[k];
+    dma_channel_config c = dma_get_channel_config(chan);
+    channel_config_set_enable(&c, n > 0);
+    dma_channel_set_config(chan, &c, false);
+    if (n == 0)
+    {
+        return;
+    }
+    start_fill(player, k, start, n);
+    dma_channel_set_read_addr(chan, player->bounce[k], false);
+    dma_channel_set_trans_count(chan, n, false);
+    player->queued[k] = n;
+    player->chunks++;
+}
+
+/**
+ * @brief Handler shared DMA_IRQ_0: satu refill per channel feed yang selesai.
+ */
+static void __isr __time_critical_func(wave_irq_handler)(void)
+{
+    for (uint i = 0; i < MAX_PLAYERS; ++i)
+    {
+        sg_wave_player *player = active_players[i];
+        if (!player)
+        {
+            continue;
+        }
+        for (uint k = 0; k < 2; ++k)
+        {
+            uint chan = (uint)player->seq->dma_chan[k];
+            if (!dma_channel_get_irq0_status(chan))
+            {
+                continue;
+            }
+            dma_channel_acknowledge_irq0(chan);
+            if (player->streaming)
+            {
+                refill(player, k);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Menyiapkan player untuk satu sequencer dan mengklaim channel DMA.
+ *
+ * Channel feed disimpan di seq->dma_chan (dilepas sg_seq_deinit()) agar
+ * sg_seq_stop() ikut menghentikannya; channel fill milik player.
+ *
+ * @param player Player yang akan diinisialisasi
+ * @param seq Sequencer yang sudah di-init
+ * @return false jika sequencer belum di-init atau channel DMA tidak tersedia
+ */
+bool sg_wave_player_init(sg_wave_player *player, sg_seq_instance *seq)
+{
+    player->seq = seq;
+    player->fill_chan = -1;
+    player->loop = false;
+    player->registered = false;
+    player->streaming = false;
+    player->finished = false;
+    player->fill_pos = 0;
+    player->queued[0] = 0;
+    player->queued[1] = 0;
+    player->chunks = 0;
+    player->underruns = 0;
+    if (seq->state == SG_STATE_UNINIT)
+    {
+        return false;
+    }
+    for (uint i = 0; i < 2; ++i)
+    {
+        if (seq->dma_chan[i] < 0)
+        {
+            seq->dma_chan[i] = dma_claim_unused_channel(false);
+            if (seq->dma_chan[i] < 0)
+            {
+                return false;
+            }
+        }
+    }
+    player->fill_chan = dma_claim_unused_channel(false);
+    if (player->fill_chan < 0)
+    {
+        return false;
+    }
+
+    // FIFO stream -> bounce, dipacu DREQ stream; alamat tulis dan jumlah per potongan
+    dma_channel_config c = dma_channel_get_default_config((uint)player->fill_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_dreq(&c, DREQ_XIP_STREAM);
+    dma_channel_configure((uint)player->fill_chan, &c, player->bounce[0], (const volatile void *)XIP_AUX_BASE, 0,
+                          false);
+    return true;
+}
+
+/**
+ * @brief Menghentikan player dan melepaskan channel fill.
+ */
+void sg_wave_player_deinit(sg_wave_player *player)
+{
+    sg_wave_stop(player);
+    if (player->fill_chan >= 0)
+    {
+        dma_channel_unclaim((uint)player->fill_chan);
+        player->fill_chan = -1;
+    }
+}
+
+/**
+ * @brief Mulai memutar tabel dari flash ke sequencer.
+ *
+ * Kedua bagian bounce buffer diisi dulu (blocking, paling lama dua potongan
+ * pada laju stream), lalu feed dimulai sebelum state machine diaktifkan.
+ *
+ * @param player Player yang sudah di-init dan berhenti
+ * @param table Tabel dari sg_wave_library_get()/sg_wave_library_find()
+ * @param pio_clk_div Clock divider state machine
+ * @param idle_mask Level pin sebelum start dan setelah stop/underrun
+ * @param loop true = tabel diulang terus sampai sg_wave_stop()
+ * @return false jika player berjalan, tabel tidak valid, atau sequencer
+ *         tidak bisa disiapkan
+ */
+bool sg_wave_start(sg_wave_player *player, const sg_wave_table *table, float pio_clk_div, uint32_t idle_mask,
+                   bool loop)
+{
+    sg_seq_instance *seq = player->seq;
+    if (player->fill_chan < 0 || player->registered || active_count == MAX_PLAYERS || table->words == 0 ||
+        table->words > SG_WAVE_MAX_WORDS)
+    {
+        return false;
+    }
+    // Fill yang tertinggal dari underrun harus selesai sebelum stream dipakai lagi
+    dma_channel_wait_for_finish_blocking((uint)player->fill_chan);
+    if (!sg_seq_prepare_feed(seq, pio_clk_div, idle_mask))
+    {
+        return false;
+    }
+
+    player->table = *table;
+    player->loop = loop;
+    player->fill_pos = 0;
+    player->finished = false;
+    player->chunks = 0;
+    player->underruns = 0;
+    for (uint k = 0; k < 2; ++k)
+    {
+        uint32_t start = 0;
+        uint32_t n = next_chunk(player, &start);
+        if (n > 0)
+        {
+            start_fill(player, k, start, n);
+            dma_channel_wait_for_finish_blocking((uint)player->fill_chan);
+        }
+        player->queued[k] = n;
+    }
+
+    PIO pio = seq->pio;
+    uint sm = seq->sm;
+    for (uint k = 0; k < 2; ++k)
+    {
+        uint chan = (uint)seq->dma_chan[k];
+        dma_channel_config c = dma_channel_get_default_config(chan);
+        channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+        channel_config_set_read_increment(&c, true);
+        channel_config_set_write_increment(&c, false);
+        channel_config_set_dreq(&c, pio_get_dreq(pio, sm, true));
+        channel_config_set_chain_to(&c, (uint)seq->dma_chan[k ^ 1u]);
+        channel_config_set_enable(&c, player->queued[k] > 0);
+        dma_channel_configure(chan, &c, &pio->txf[sm], player->bounce[k], player->queued[k], false);
+        dma_channel_acknowledge_irq0(chan);
+    }
+
+    for (uint i = 0; i < MAX_PLAYERS; ++i)
+    {
+        if (!active_players[i])
+        {
+            active_players[i] = player;
+            break;
+        }
+    }
+    if (active_count++ == 0)
+    {
+        irq_add_shared_handler(DMA_IRQ_0, wave_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+        irq_set_enabled(DMA_IRQ_0, true);
+    }
+    dma_set_irq0_channel_mask_enabled((1u << seq->dma_chan[0]) | (1u << seq->dma_chan[1]), true);
+    player->registered = true;
+    player->streaming = true;
+
+    // Channel feed pertama langsung mengisi FIFO sebelum state machine diaktifkan
+    seq->dma_running = true;
+    dma_channel_start((uint)seq->dma_chan[0]);
+    seq->state = SG_STATE_RUNNING;
+    pio_sm_set_enabled(pio, sm, true);
+    return true;
+}
+
+/**
+ * @brief Menghentikan output ke idle_mask dan melepaskan handler.
+ *
+ * Juga dipakai setelah tabel habis atau underrun. Fill yang masih berjalan
+ * ditunggu selesai (paling lama satu potongan) agar stream kosong untuk
+ * sg_wave_start() atau penulisan flash berikutnya.
+ *
+ * @param player Player
+ */
+void sg_wave_stop(sg_wave_player *player)
+{
+    if (!player->registered)
+    {
+        return;
+    }
+    sg_seq_instance *seq = player->seq;
+    uint32_t mask = (1u << seq->dma_chan[0]) | (1u << seq->dma_chan[1]);
+    uint32_t status = save_and_disable_interrupts();
+    player->streaming = false;
+    dma_set_irq0_channel_mask_enabled(mask, false);
+    sg_seq_stop(seq);
+    for (uint k = 0; k < 2; ++k)
+    {
+        // Abort bisa menyetel status IRQ (RP2040-E13)
+        dma_channel_acknowledge_irq0((uint)seq->dma_chan[k]);
+    }
+    for (uint i = 0; i < MAX_PLAYERS; ++i)
+    {
+        if (active_players[i] == player)
+        {
+            active_players[i] = NULL;
+        }
+    }
+    if (--active_count == 0)
+    {
+        irq_clear(DMA_IRQ_0);
+        irq_remove_handler(DMA_IRQ_0, wave_irq_handler);
+    }
+    player->registered = false;
+    restore_interrupts(status);
+    dma_channel_wait_for_finish_blocking((uint)player->fill_chan);
+}
@@ -0,0 +1,133 @@
+/**
+ * Library tabel event di flash yang diputar lewat stream XIP dan DMA.
+ *
+ * Tabel event precomputed yang besar (sweep, pola rekaman) tidak muat di SRAM
+ * di samping firmware, jadi disimpan di region flash SG_WAVE_FLASH_OFFSET
+ * (tepat di bawah region preset). Sektor pertama region adalah direktori:
+ * satu entri 32 byte per tabel (nama, offset, jumlah word, CRC data, CRC
+ * entri) yang diprogram ke slot kosong berikutnya tanpa erase. Data tabel
+ * mulai di batas sektor setelah tabel terakhir; sektor di-erase saat
+ * penulisan memasukinya. Tabel hanya bisa ditambah, sg_wave_library_format()
+ * mengosongkan seluruh library.
+ *
+ * Penulisan tabel bertahap (begin/write/commit) sehingga tabel bisa dibangun
+ * per potongan tanpa pernah utuh di SRAM. Erase dan program dijalankan lewat
+ * flash_safe_execute() dengan syarat yang sama seperti signal_preset.h; tidak
+ * boleh ada player yang berjalan selama penulisan.
+ *
+ * Player memutar satu tabel ke sequencer (signal_sequencer.pio) lewat bounce
+ * buffer SRAM dua bagian. Channel DMA fill membaca FIFO stream XIP
+ * (XIP_AUX_BASE, DREQ_XIP_STREAM): stream mengambil word dari flash di latar
+ * belakang tanpa lewat cache, jadi kode yang dieksekusi dari cache XIP tidak
+ * berebut dengan pembacaan tabel. Dua channel feed (dma_chan sequencer)
+ * saling chain dan dipacu DREQ TX state machine. Setiap kali satu bagian
+ * habis, handler DMA_IRQ_0 memprogram ulang stream untuk potongan berikutnya
+ * dan mengisi bagian itu lagi selagi feed membaca bagian lainnya.
+ *
+ * Laju stream: satu word per ~352 ns (continuous read quad, SCK 62,5 MHz),
+ * yaitu ~2,8 juta event/s atau ~11 MB/s. Pada clk_sys 125 MHz dan divider 1,
+ * rata-rata durasi event per potongan harus di atas ~44 siklus ditambah
+ * latensi interrupt; tabel yang lebih rapat menyebabkan underrun. Underrun
+ * dideteksi handler (fill bagian berikutnya belum selesai saat feed
+ * memasukinya): output dihentikan ke idle_mask dan dicatat di `underruns`,
+ * bukan memutar data basi.
+ *
+ * Tanpa loop, event terakhir ditahan sampai sg_wave_stop() (state machine
+ * menunggu pull), jadi tabel sebaiknya diakhiri event idle.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef SIGNAL_WAVE_H
+#define SIGNAL_WAVE_H
+
+#include "signal_preset.h"
+#include "signal_seq.h"
+
+#define SG_WAVE_FLASH_SIZE (512u * 1024u)
+#define SG_WAVE_FLASH_OFFSET (SG_PRESET_FLASH_OFFSET - SG_WAVE_FLASH_SIZE)
+#define SG_WAVE_NAME_MAX 12      // Karakter, tanpa terminator
+#define SG_WAVE_MAX_TABLES 128   // Entri direktori per sektor
+#define SG_WAVE_CHUNK_WORDS 256  // Word per bagian bounce buffer
+
+// Word terbanyak satu tabel: seluruh region di luar direktori
+#define SG_WAVE_MAX_WORDS ((SG_WAVE_FLASH_SIZE - FLASH_SECTOR_SIZE) / sizeof(uint32_t))
+
+/**
+ * @brief Tabel yang tersimpan; offset relatif terhadap awal region.
+ */
+typedef struct
+{
+    uint32_t offset;
+    uint32_t words;
+    uint32_t crc;
+} sg_wave_table;
+
+/**
+ * @brief Indeks RAM atas library dan penulisan tabel yang sedang berjalan.
+ */
+typedef struct
+{
+    uint tables;          // Entri valid
+    uint entries;         // Slot direktori terpakai (termasuk yang rusak)
+    uint32_t corrupt;     // Entri terisi dengan CRC salah saat scan
+    uint32_t next_offset; // Offset data tabel berikutnya (batas sektor)
+    uint32_t writes;      // Halaman yang diprogram sejak init
+    uint32_t erases;      // Sektor yang di-erase sejak init
+
+    // Penulisan yang sedang berjalan (begin .. commit)
+    bool writing;
+    char name[SG_WAVE_NAME_MAX];
+    uint32_t words;   // Jumlah word yang dijanjikan begin
+    uint32_t written; // Word yang sudah diterima
+    uint32_t crc;     // CRC berjalan (belum di-invert)
+    uint8_t page[FLASH_PAGE_SIZE];
+} sg_wave_library;
+
+/**
+ * @brief Player satu tabel ke satu instance sequencer.
+ *
+ * Field volatile ditulis handler DMA_IRQ_0.
+ */
+typedef struct
+{
+    sg_seq_instance *seq;
+    int fill_chan;                   // Channel stream XIP -> bounce, -1 jika belum diklaim
+    sg_wave_table table;
+    bool loop;
+    bool registered;                 // Terdaftar di handler DMA_IRQ_0
+    volatile bool streaming;         // Feed berjalan dan handler mengisi ulang
+    volatile bool finished;          // Tabel habis (tanpa loop), event terakhir ditahan
+    volatile uint32_t fill_pos;      // Word tabel berikutnya untuk fill
+    volatile uint32_t queued[2];     // Word di bounce[k] untuk feed berikutnya, 0 = tidak ada
+    volatile uint32_t chunks;        // Potongan yang diisi ulang handler
+    volatile uint32_t underruns;
+    uint32_t bounce[2][SG_WAVE_CHUNK_WORDS];
+} sg_wave_player;
+
+// -- API Library --
+void sg_wave_library_init(sg_wave_library *lib);
+bool sg_wave_library_format(sg_wave_library *lib);
+bool sg_wave_library_begin(sg_wave_library *lib, const char *name, uint32_t words);
+bool sg_wave_library_write(sg_wave_library *lib, const uint32_t *events, uint32_t count);
+bool sg_wave_library_commit(sg_wave_library *lib);
+bool sg_wave_library_get(const sg_wave_library *lib, uint index, sg_wave_table *table, char *name);
+bool sg_wave_library_find(const sg_wave_library *lib, const char *name, sg_wave_table *table);
+bool sg_wave_table_verify(const sg_wave_table *table);
+
+// -- API Player --
+bool sg_wave_player_init(sg_wave_player *player, sg_seq_instance *seq);
+void sg_wave_player_deinit(sg_wave_player *player);
+bool sg_wave_start(sg_wave_player *player, const sg_wave_table *table, float pio_clk_div, uint32_t idle_mask,
+                   bool loop);
+void sg_wave_stop(sg_wave_player *player);
+
+/**
+ * @brief Alamat XIP word pertama tabel (hanya untuk dibaca CPU, lewat cache).
+ */
+static inline const uint32_t *sg_wave_table_data(const sg_wave_table *table)
+{
+    return (const uint32_t *)(XIP_BASE + SG_WAVE_FLASH_OFFSET + table->offset);
+}
+
+#endif